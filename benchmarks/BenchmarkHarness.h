@@ -0,0 +1,545 @@
+/**
+ * @file BenchmarkHarness.h
+ * @brief 仿 Google Benchmark 的最小基准框架：注册、参数化、自动确定迭代次数、JSON输出
+ *
+ * JSON结果与 Google Benchmark 的 --benchmark_out 格式一致(context + benchmarks)，
+ * 可以直接用其 tools/compare.py 比较两次提交的结果。
+ *
+ * 用法:
+ *   static void BM_Foo(bench::State& state) {
+ *       准备数据(不计时) ...
+ *       while (state.keepRunning()) { ... bench::doNotOptimize(result); }
+ *       state.setItemsProcessed(state.iterations() * n);
+ *   }
+ *   bench::registerBenchmark("BM_Foo", BM_Foo)->argNames({"n"})->arg(64)->arg(1024);
+ *   int main(int argc, char** argv) { return bench::runBenchmarks(argc, argv); }
+ *
+ * 命令行参数:
+ *   --benchmark_filter=<正则>         只运行名称匹配的基准
+ *   --benchmark_min_time=<秒>         每个基准的最短计时时间，默认 0.5
+ *   --benchmark_repetitions=<N>       重复次数，大于1时额外输出 mean/median/stddev
+ *   --benchmark_out=<文件>            JSON结果文件
+ *   --benchmark_format=<console|json> 标准输出格式
+ *   --benchmark_context=<键>=<值>     写入JSON context(如 commit=abc123)，可重复
+ *   --benchmark_list_tests            只列出基准名称
+ */
+
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+
+namespace bench {
+
+/**
+ * @brief 阻止编译器把基准中的计算当作无用代码删除
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief 单次运行的状态：迭代控制、参数、计数器
+ */
+class State {
+public:
+    State(const std::vector<std::int64_t>& args, std::size_t iterations)
+        : m_args(args), m_maxIterations(iterations) {}
+
+    /**
+     * @brief 计时循环条件，第一次调用时开始计时，完成预定迭代次数后停止计时
+     */
+    bool keepRunning() {
+        if (m_error) {
+            stopTimer();
+            return false;
+        }
+        if (!m_started) {
+            m_started = true;
+            startTimer();
+        }
+        if (m_completed < m_maxIterations) {
+            ++m_completed;
+            return true;
+        }
+        stopTimer();
+        return false;
+    }
+
+    // 第 i 个参数
+    std::int64_t range(std::size_t i = 0) const { return i < m_args.size() ? m_args[i] : 0; }
+
+    // 预定的迭代次数
+    std::size_t iterations() const { return m_maxIterations; }
+
+    // 暂停/恢复计时(迭代内不计时的准备工作)
+    void pauseTiming() { stopTimer(); }
+    void resumeTiming() { startTimer(); }
+
+    // 处理的元素数，输出 items_per_second
+    void setItemsProcessed(std::int64_t items) { m_itemsProcessed = items; }
+
+    // 附加说明，输出到 label
+    void setLabel(const std::string& label) { m_label = label; }
+
+    // 结果校验失败时调用，该基准标记为错误，runBenchmarks 返回非零值
+    void skipWithError(const std::string& message) {
+        m_error = true;
+        m_errorMessage = message;
+    }
+
+    // 用户计数器(如精度统计)，按原值输出
+    std::map<std::string, double> counters;
+
+    double realSeconds() const { return m_realSeconds; }
+    double cpuSeconds() const { return m_cpuSeconds; }
+    std::int64_t itemsProcessed() const { return m_itemsProcessed; }
+    const std::string& label() const { return m_label; }
+    bool errorOccurred() const { return m_error; }
+    const std::string& errorMessage() const { return m_errorMessage; }
+
+private:
+    void startTimer() {
+        if (m_running) return;
+        m_running = true;
+        m_realStart = std::chrono::steady_clock::now();
+        m_cpuStart = std::clock();
+    }
+
+    void stopTimer() {
+        if (!m_running) return;
+        m_running = false;
+        m_realSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_realStart).count();
+        m_cpuSeconds += static_cast<double>(std::clock() - m_cpuStart) / CLOCKS_PER_SEC;
+    }
+
+    std::vector<std::int64_t> m_args;
+    std::size_t m_maxIterations;
+    std::size_t m_completed = 0;
+    bool m_started = false;
+    bool m_running = false;
+    std::chrono::steady_clock::time_point m_realStart;
+    std::clock_t m_cpuStart = 0;
+    double m_realSeconds = 0.0;
+    double m_cpuSeconds = 0.0;
+    std::int64_t m_itemsProcessed = 0;
+    std::string m_label;
+    bool m_error = false;
+    std::string m_errorMessage;
+};
+
+typedef std::function<void(State&)> BenchmarkFunction;
+
+/**
+ * @brief 已注册的基准及其参数组合
+ */
+class Benchmark {
+public:
+    Benchmark(const std::string& name, BenchmarkFunction function)
+        : m_name(name), m_function(std::move(function)) {}
+
+    // 添加一组单参数
+    Benchmark* arg(std::int64_t value) {
+        m_argSets.push_back({value});
+        return this;
+    }
+
+    // 添加一组多参数
+    Benchmark* args(std::initializer_list<std::int64_t> values) {
+        m_argSets.push_back(std::vector<std::int64_t>(values));
+        return this;
+    }
+
+    // 各参数的名称，输出为 name/参数名:值
+    Benchmark* argNames(std::initializer_list<std::string> names) {
+        m_argNames.assign(names.begin(), names.end());
+        return this;
+    }
+
+    // 覆盖全局最短计时时间(秒)，用于单次很慢的基准
+    Benchmark* minTime(double seconds) {
+        m_minTime = seconds;
+        return this;
+    }
+
+    const std::string& name() const { return m_name; }
+    const BenchmarkFunction& function() const { return m_function; }
+    double minTimeOverride() const { return m_minTime; }
+
+    // 展开为(完整名称, 参数)列表
+    std::vector<std::pair<std::string, std::vector<std::int64_t>>> instances() const {
+        std::vector<std::pair<std::string, std::vector<std::int64_t>>> result;
+        if (m_argSets.empty()) {
+            result.emplace_back(m_name, std::vector<std::int64_t>());
+            return result;
+        }
+        for (const std::vector<std::int64_t>& argSet : m_argSets) {
+            std::string fullName = m_name;
+            for (std::size_t i = 0; i < argSet.size(); ++i) {
+                fullName += "/";
+                if (i < m_argNames.size() && !m_argNames[i].empty()) fullName += m_argNames[i] + ":";
+                fullName += std::to_string(argSet[i]);
+            }
+            result.emplace_back(fullName, argSet);
+        }
+        return result;
+    }
+
+private:
+    std::string m_name;
+    BenchmarkFunction m_function;
+    std::vector<std::vector<std::int64_t>> m_argSets;
+    std::vector<std::string> m_argNames;
+    double m_minTime = 0.0;
+};
+
+namespace detail {
+
+inline std::vector<std::unique_ptr<Benchmark>>& registry() {
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+// 一次完整计时的结果
+struct RunResult {
+    std::string name;
+    std::string runName;
+    std::string runType = "iteration";   // iteration 或 aggregate
+    std::string aggregateName;           // mean / median / stddev
+    int repetitions = 1;
+    int repetitionIndex = 0;
+    std::size_t iterations = 0;
+    double realTimeNs = 0.0;             // 每次迭代墙钟时间(纳秒)
+    double cpuTimeNs = 0.0;              // 每次迭代CPU时间(纳秒)
+    double itemsPerSecond = 0.0;
+    std::map<std::string, double> counters;
+    std::string label;
+    bool error = false;
+    std::string errorMessage;
+};
+
+inline std::string jsonEscape(const std::string& text) {
+    std::string out;
+    out.reserve(text.size() + 2);
+    for (char ch : text) {
+        switch (ch) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+                out += buffer;
+            } else {
+                out += ch;
+            }
+        }
+    }
+    return out;
+}
+
+inline std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) return "null";
+    std::ostringstream ss;
+    ss << std::setprecision(17) << value;
+    return ss.str();
+}
+
+// 迭代次数自动增长直到总耗时达到 minTime(与 Google Benchmark 的策略一致)
+inline RunResult runInstance(const Benchmark& benchmark, const std::string& name,
+                             const std::vector<std::int64_t>& args, double minTime) {
+    std::size_t iterations = 1;
+    const std::size_t maxIterations = 1000000000;
+    for (;;) {
+        State state(args, iterations);
+        benchmark.function()(state);
+
+        const double seconds = state.realSeconds();
+        const bool enough = seconds >= minTime || iterations >= maxIterations || state.errorOccurred();
+        if (enough) {
+            RunResult r;
+            r.name = name;
+            r.runName = name;
+            r.iterations = iterations;
+            r.realTimeNs = seconds * 1e9 / iterations;
+            r.cpuTimeNs = state.cpuSeconds() * 1e9 / iterations;
+            r.itemsPerSecond = state.itemsProcessed() > 0 && seconds > 0.0 ? state.itemsProcessed() / seconds : 0.0;
+            r.counters = state.counters;
+            r.label = state.label();
+            r.error = state.errorOccurred();
+            r.errorMessage = state.errorMessage();
+            return r;
+        }
+
+        double multiplier = minTime * 1.4 / std::max(seconds, 1e-9);
+        if (seconds / minTime <= 0.1) multiplier = std::min(multiplier, 10.0);
+        if (multiplier <= 1.0) multiplier = 2.0;
+        const double next = std::max(static_cast<double>(iterations) * multiplier, static_cast<double>(iterations) + 1.0);
+        iterations = static_cast<std::size_t>(std::min(next, static_cast<double>(maxIterations)));
+    }
+}
+
+// 多次重复的 mean / median / stddev
+inline std::vector<RunResult> aggregate(const std::vector<RunResult>& runs) {
+    std::vector<RunResult> result;
+    if (runs.size() < 2) return result;
+    const char* names[] = {"mean", "median", "stddev"};
+    for (const char* aggregateName : names) {
+        RunResult a = runs.front();
+        a.name = runs.front().runName + "_" + aggregateName;
+        a.runType = "aggregate";
+        a.aggregateName = aggregateName;
+        a.repetitionIndex = 0;
+        auto reduce = [&](std::function<double(const RunResult&)> field) {
+            std::vector<double> values;
+            for (const RunResult& r : runs) values.push_back(field(r));
+            double mean = 0.0;
+            for (double v : values) mean += v;
+            mean /= values.size();
+            if (a.aggregateName == "mean") return mean;
+            if (a.aggregateName == "median") {
+                std::sort(values.begin(), values.end());
+                const std::size_t n = values.size();
+                return n % 2 ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+            }
+            double var = 0.0;
+            for (double v : values) var += (v - mean) * (v - mean);
+            return std::sqrt(var / (values.size() - 1));
+        };
+        a.realTimeNs = reduce([](const RunResult& r) { return r.realTimeNs; });
+        a.cpuTimeNs = reduce([](const RunResult& r) { return r.cpuTimeNs; });
+        a.itemsPerSecond = reduce([](const RunResult& r) { return r.itemsPerSecond; });
+        for (auto& counter : a.counters) {
+            const std::string key = counter.first;
+            counter.second = reduce([&](const RunResult& r) {
+                auto it = r.counters.find(key);
+                return it != r.counters.end() ? it->second : 0.0;
+            });
+        }
+        result.push_back(a);
+    }
+    return result;
+}
+
+inline void printConsoleHeader(std::ostream& os) {
+    os << std::left << std::setw(56) << "Benchmark" << std::right
+       << std::setw(16) << "Time" << std::setw(16) << "CPU" << std::setw(14) << "Iterations"
+       << "  UserCounters" << "\n"
+       << std::string(120, '-') << "\n";
+}
+
+inline void printConsoleRow(std::ostream& os, const RunResult& r) {
+    os << std::left << std::setw(56) << r.name << std::right;
+    if (r.error) {
+        os << "  错误: " << r.errorMessage << "\n";
+        return;
+    }
+    std::ostringstream realTime, cpuTime;
+    realTime << std::fixed << std::setprecision(r.realTimeNs < 100 ? 2 : 0) << r.realTimeNs << " ns";
+    cpuTime << std::fixed << std::setprecision(r.cpuTimeNs < 100 ? 2 : 0) << r.cpuTimeNs << " ns";
+    os << std::setw(16) << realTime.str() << std::setw(16) << cpuTime.str();
+    if (r.runType == "iteration") os << std::setw(14) << r.iterations;
+    else os << std::setw(14) << "";
+    if (r.itemsPerSecond > 0.0) {
+        os << "  items_per_second=" << std::setprecision(4) << std::defaultfloat << r.itemsPerSecond;
+    }
+    for (const auto& counter : r.counters) {
+        os << "  " << counter.first << "=" << std::setprecision(6) << std::defaultfloat << counter.second;
+    }
+    if (!r.label.empty()) os << "  " << r.label;
+    os << "\n";
+}
+
+inline void writeJson(std::ostream& os, const std::vector<RunResult>& results,
+                      const std::string& executable,
+                      const std::vector<std::pair<std::string, std::string>>& context) {
+    char date[64] = "";
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+    char host[256] = "";
+    gethostname(host, sizeof(host) - 1);
+
+    os << "{\n  \"context\": {\n"
+       << "    \"date\": \"" << date << "\",\n"
+       << "    \"host_name\": \"" << jsonEscape(host) << "\",\n"
+       << "    \"executable\": \"" << jsonEscape(executable) << "\",\n"
+       << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+       << "    \"library_build_type\": \"release\"";
+#else
+       << "    \"library_build_type\": \"debug\"";
+#endif
+    for (const auto& entry : context) {
+        os << ",\n    \"" << jsonEscape(entry.first) << "\": \"" << jsonEscape(entry.second) << "\"";
+    }
+    os << "\n  },\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const RunResult& r = results[i];
+        os << (i ? ",\n" : "\n") << "    {\n"
+           << "      \"name\": \"" << jsonEscape(r.name) << "\",\n"
+           << "      \"run_name\": \"" << jsonEscape(r.runName) << "\",\n"
+           << "      \"run_type\": \"" << r.runType << "\",\n"
+           << "      \"repetitions\": " << r.repetitions << ",\n"
+           << "      \"repetition_index\": " << r.repetitionIndex << ",\n";
+        if (r.runType == "aggregate") {
+            os << "      \"aggregate_name\": \"" << r.aggregateName << "\",\n";
+        }
+        os << "      \"threads\": 1,\n";
+        if (r.error) {
+            os << "      \"error_occurred\": true,\n"
+               << "      \"error_message\": \"" << jsonEscape(r.errorMessage) << "\",\n";
+        }
+        os << "      \"iterations\": " << r.iterations << ",\n"
+           << "      \"real_time\": " << jsonNumber(r.realTimeNs) << ",\n"
+           << "      \"cpu_time\": " << jsonNumber(r.cpuTimeNs) << ",\n"
+           << "      \"time_unit\": \"ns\"";
+        if (r.itemsPerSecond > 0.0) {
+            os << ",\n      \"items_per_second\": " << jsonNumber(r.itemsPerSecond);
+        }
+        for (const auto& counter : r.counters) {
+            os << ",\n      \"" << jsonEscape(counter.first) << "\": " << jsonNumber(counter.second);
+        }
+        if (!r.label.empty()) {
+            os << ",\n      \"label\": \"" << jsonEscape(r.label) << "\"";
+        }
+        os << "\n    }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+inline bool parseFlag(const std::string& arg, const std::string& flag, std::string& value) {
+    const std::string prefix = "--" + flag + "=";
+    if (arg.compare(0, prefix.size(), prefix) != 0) return false;
+    value = arg.substr(prefix.size());
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief 注册基准，返回值可链式添加参数
+ */
+inline Benchmark* registerBenchmark(const std::string& name, BenchmarkFunction function) {
+    detail::registry().emplace_back(new Benchmark(name, std::move(function)));
+    return detail::registry().back().get();
+}
+
+/**
+ * @brief 解析命令行并运行所有匹配的基准
+ * @return 0 全部成功，1 有基准校验失败，2 参数错误
+ */
+inline int runBenchmarks(int argc, char** argv) {
+    std::string filter = ".";
+    double minTime = 0.5;
+    int repetitions = 1;
+    std::string outPath;
+    std::string format = "console";
+    bool listOnly = false;
+    std::vector<std::pair<std::string, std::string>> context;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        std::string value;
+        if (detail::parseFlag(arg, "benchmark_filter", value)) filter = value;
+        else if (detail::parseFlag(arg, "benchmark_min_time", value)) minTime = std::atof(value.c_str());
+        else if (detail::parseFlag(arg, "benchmark_repetitions", value)) repetitions = std::max(1, std::atoi(value.c_str()));
+        else if (detail::parseFlag(arg, "benchmark_out", value)) outPath = value;
+        else if (detail::parseFlag(arg, "benchmark_format", value)) format = value;
+        else if (detail::parseFlag(arg, "benchmark_context", value)) {
+            const std::size_t eq = value.find('=');
+            if (eq == std::string::npos) {
+                std::cerr << "--benchmark_context 需要 键=值 格式: " << value << std::endl;
+                return 2;
+            }
+            context.emplace_back(value.substr(0, eq), value.substr(eq + 1));
+        }
+        else if (arg == "--benchmark_list_tests") listOnly = true;
+        else {
+            std::cerr << "无法识别的参数: " << arg << std::endl;
+            return 2;
+        }
+    }
+    if (format != "console" && format != "json") {
+        std::cerr << "不支持的输出格式: " << format << std::endl;
+        return 2;
+    }
+
+    std::regex pattern;
+    try {
+        pattern = std::regex(filter);
+    } catch (const std::regex_error&) {
+        std::cerr << "无效的过滤正则: " << filter << std::endl;
+        return 2;
+    }
+
+    std::vector<detail::RunResult> results;
+    bool failed = false;
+    if (format == "console" && !listOnly) detail::printConsoleHeader(std::cout);
+    for (const auto& benchmark : detail::registry()) {
+        for (const auto& instance : benchmark->instances()) {
+            if (!std::regex_search(instance.first, pattern)) continue;
+            if (listOnly) {
+                std::cout << instance.first << "\n";
+                continue;
+            }
+            const double instanceMinTime = benchmark->minTimeOverride() > 0.0 ? benchmark->minTimeOverride() : minTime;
+            std::vector<detail::RunResult> runs;
+            for (int rep = 0; rep < repetitions; ++rep) {
+                detail::RunResult r = detail::runInstance(*benchmark, instance.first, instance.second, instanceMinTime);
+                r.repetitions = repetitions;
+                r.repetitionIndex = rep;
+                failed = failed || r.error;
+                if (format == "console") detail::printConsoleRow(std::cout, r);
+                runs.push_back(r);
+                if (r.error) break;
+            }
+            results.insert(results.end(), runs.begin(), runs.end());
+            if (!runs.back().error) {
+                for (const detail::RunResult& a : detail::aggregate(runs)) {
+                    if (format == "console") detail::printConsoleRow(std::cout, a);
+                    results.push_back(a);
+                }
+            }
+            std::cout.flush();
+        }
+    }
+    if (listOnly) return 0;
+
+    if (format == "json") detail::writeJson(std::cout, results, argv[0], context);
+    if (!outPath.empty()) {
+        std::ofstream out(outPath);
+        if (!out) {
+            std::cerr << "无法写入结果文件: " << outPath << std::endl;
+            return 2;
+        }
+        detail::writeJson(out, results, argv[0], context);
+        std::cerr << "结果已写入 " << outPath << std::endl;
+    }
+    return failed ? 1 : 0;
+}
+
+} // namespace bench
+
+#endif // BENCHMARK_HARNESS_H
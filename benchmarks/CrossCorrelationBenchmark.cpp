@@ -0,0 +1,174 @@
+/**
+ * @file CrossCorrelationBenchmark.cpp
+ * @brief FFT广义互相关(GCC)时延估计的耗时-长度曲线与精度校验
+ *
+ * 从 2^10 到 10^7 个采样点测量 GCC-PHAT 单次估计耗时，
+ * 小长度下同时测量原 O(N^2) 直接互相关作对比；
+ * 校验不加权GCC与直接法峰值一致、PHAT/SCOT能恢复已知的整数与小数时延，失败时返回非零值。
+ * 用法: cross_correlation_benchmark [最大点数]
+ */
+
+#include "../utils/CrossCorrelation.h"
+#include "../utils/FFT.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+volatile double g_sink = 0.0;
+
+template <typename Body>
+double measureSeconds(Body body) {
+    body();  // 预热
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 原 SinglePlatformTDOA 中的直接互相关，作为基准和参考结果
+int directCorrelationLag(const std::vector<double>& s1, const std::vector<double>& s2) {
+    const int n = static_cast<int>(std::min(s1.size(), s2.size()));
+    const int maxLag = n / 2;
+    int peakLag = -maxLag;
+    double peakValue = -1e300;
+    for (int lag = -maxLag; lag <= maxLag; ++lag) {
+        double corr = 0.0;
+        int count = 0;
+        for (int i = std::max(0, lag); i < n && i - lag < n; ++i) {
+            corr += s1[i] * s2[i - lag];
+            ++count;
+        }
+        if (count > 0 && corr / count > peakValue) {
+            peakValue = corr / count;
+            peakLag = lag;
+        }
+    }
+    return peakLag;
+}
+
+// 白噪声源信号，signal1 为其延迟 delay 个采样点(可为小数)的版本，两路各加独立噪声。
+// 小数时延在频域以线性相位施加
+void makeDelayedPair(std::size_t n, double delay, double noise, std::mt19937_64& gen,
+                     std::vector<double>& s1, std::vector<double>& s2) {
+    const std::size_t fftSize = FFTPlan::nextPowerOfTwo(n);
+    std::normal_distribution<double> dist(0.0, 1.0);
+    std::vector<std::complex<double>> spectrum(fftSize);
+    for (auto& value : spectrum) {
+        value = std::complex<double>(dist(gen), 0.0);
+    }
+    std::shared_ptr<const FFTPlan> plan = FFTPlan::get(fftSize);
+    std::vector<std::complex<double>> source = spectrum;
+    plan->forward(spectrum.data());
+
+    const double PI = 3.14159265358979323846;
+    for (std::size_t k = 0; k < fftSize; ++k) {
+        // 取 [-M/2, M/2) 的对称频率，保证延迟后的信号仍为实数
+        const double freq = k <= fftSize / 2 ? static_cast<double>(k)
+                                             : static_cast<double>(k) - static_cast<double>(fftSize);
+        const double phase = -2.0 * PI * freq * delay / static_cast<double>(fftSize);
+        spectrum[k] *= k == fftSize / 2 ? std::cos(phase) : std::polar(1.0, phase);
+    }
+    plan->inverse(spectrum.data());
+
+    s1.resize(n);
+    s2.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        s1[i] = spectrum[i].real() + noise * dist(gen);
+        s2[i] = source[i].real() + noise * dist(gen);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t maxLength = argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 10000000;
+    const double samplingRate = 1.0e6;
+    std::mt19937_64 gen(20240601);
+
+    std::cout << "GCC时延估计耗时 (单次估计, 搜索范围 ±N/2)" << std::endl;
+    std::cout << std::setw(10) << "N" << std::setw(16) << "GCC-PHAT(ms)"
+              << std::setw(16) << "直接法(ms)" << std::setw(12) << "加速比" << std::endl;
+
+    std::vector<std::size_t> lengths;
+    for (std::size_t n = 1024; n <= maxLength; n *= 4) {
+        lengths.push_back(n);
+    }
+    if (lengths.empty() || lengths.back() != maxLength) {
+        lengths.push_back(maxLength);
+    }
+
+    GccDelayEstimator estimator;
+    for (std::size_t n : lengths) {
+        std::vector<double> s1, s2;
+        makeDelayedPair(n, 17.0, 0.1, gen, s1, s2);
+
+        const double gccSeconds = measureSeconds([&]() {
+            g_sink = g_sink + estimator.estimate(s1, s2, samplingRate).delaySamples;
+        });
+        std::cout << std::setw(10) << n << std::fixed << std::setprecision(3)
+                  << std::setw(16) << gccSeconds * 1e3;
+
+        // 直接法 O(N^2)，只在小长度下测量
+        if (n <= 16384) {
+            const double directSeconds = measureSeconds([&]() {
+                g_sink = g_sink + directCorrelationLag(s1, s2);
+            });
+            std::cout << std::setw(16) << directSeconds * 1e3
+                      << std::setprecision(1) << std::setw(12) << directSeconds / gccSeconds << "x";
+        } else {
+            std::cout << std::setw(16) << "-" << std::setw(12) << "-";
+        }
+        std::cout << std::endl;
+    }
+
+    bool ok = true;
+
+    // 不加权GCC与直接法的整数峰值位置一致
+    GccOptions plain;
+    plain.weighting = GccWeighting::None;
+    plain.subSampleInterpolation = false;
+    GccDelayEstimator plainEstimator(plain);
+    for (double delay : {-123.0, 0.0, 41.0, 250.0}) {
+        std::vector<double> s1, s2;
+        makeDelayedPair(4096, delay, 0.5, gen, s1, s2);
+        const int direct = directCorrelationLag(s1, s2);
+        const GccResult gcc = plainEstimator.estimate(s1, s2, samplingRate);
+        if (!gcc.valid || std::lround(gcc.delaySamples) != direct || direct != std::lround(delay)) {
+            std::cout << "不加权GCC与直接法不一致: 期望 " << delay << ", 直接法 " << direct
+                      << ", GCC " << gcc.delaySamples << std::endl;
+            ok = false;
+        }
+    }
+
+    // PHAT / SCOT 恢复小数时延
+    double maxError = 0.0;
+    for (GccWeighting weighting : {GccWeighting::PHAT, GccWeighting::SCOT}) {
+        GccOptions options;
+        options.weighting = weighting;
+        GccDelayEstimator weighted(options);
+        for (double delay : {-300.25, -7.6, 0.4, 37.3, 1000.5}) {
+            std::vector<double> s1, s2;
+            makeDelayedPair(65536, delay, 0.3, gen, s1, s2);
+            const GccResult gcc = weighted.estimate(s1, s2, samplingRate);
+            const double error = std::fabs(gcc.delaySamples - delay);
+            maxError = std::max(maxError, error);
+            if (!gcc.valid || error > 0.2
+                || std::fabs(gcc.delaySeconds - gcc.delaySamples / samplingRate) > 1e-15) {
+                std::cout << (weighting == GccWeighting::PHAT ? "PHAT" : "SCOT")
+                          << " 时延偏差过大: 期望 " << delay << ", 估计 " << gcc.delaySamples << std::endl;
+                ok = false;
+            }
+        }
+    }
+    std::cout << "PHAT/SCOT 小数时延最大偏差: " << std::setprecision(3) << maxError << " 采样点" << std::endl;
+
+    std::cout << (ok ? "精度校验通过" : "精度校验失败") << std::endl;
+    return ok ? 0 : 1;
+}
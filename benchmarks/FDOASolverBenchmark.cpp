@@ -0,0 +1,316 @@
+/**
+ * @file FDOASolverBenchmark.cpp
+ * @brief 频差定位LM求解器的微基准测试及精度校验
+ *
+ * 对比原 std::vector<std::vector<double>> 实现(数值雅可比 + 高斯消元，legacy)
+ * 与定长Eigen解析雅可比实现的单次迭代耗时，并测量不同观测时刻数下的求解速率。
+ * 无噪声观测下新实现应收敛到真值；先验偏离较大时统计单起点与多起点求解的成功率，
+ * 多起点应全部收敛到全局解。偏差超限时返回非零值。
+ * 用法: fdoa_solver_benchmark [求解次数]
+ */
+
+#include "../models/FDOASolver.h"
+#include "../constants/PhysicsConstants.h"
+#include "../utils/CoordinateTransform.h"
+#include "../utils/ParallelFor.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// 原实现的副本(去掉了数据库访问，观测几何预先算好)，仅用于性能对比
+namespace legacy {
+
+struct Station {
+    double pos[3];
+    double vel[3];
+};
+
+struct Problem {
+    std::vector<Station> stations;              // 侦察站 t=0 位置和速度
+    std::vector<double> timePoints;             // 观测时刻
+    std::vector<std::vector<double>> observed;  // [站][时刻] 多普勒频移
+    double f0;
+    double expectedVel[3];
+    double velocityWeight;
+};
+
+std::vector<double> calculateResiduals(const std::vector<double>& params, const Problem& p) {
+    const int numDevices = p.stations.size();
+    const int numTimes = p.timePoints.size();
+    std::vector<double> residuals(numDevices * numTimes + 3);
+    for (int i = 0; i < numDevices; ++i) {
+        const Station& s = p.stations[i];
+        for (int j = 0; j < numTimes; ++j) {
+            const double t = p.timePoints[j];
+            double r[3], v[3];
+            for (int k = 0; k < 3; ++k) {
+                r[k] = (s.pos[k] + s.vel[k] * t) - (params[k] + params[3 + k] * t);
+                v[k] = s.vel[k] - params[3 + k];
+            }
+            const double distance = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+            const double radialVelocity = (v[0] * r[0] + v[1] * r[1] + v[2] * r[2]) / distance;
+            residuals[i * numTimes + j] = p.observed[i][j] - (radialVelocity / Constants::c) * p.f0;
+        }
+    }
+    const int base = numDevices * numTimes;
+    for (int k = 0; k < 3; ++k) {
+        residuals[base + k] = p.velocityWeight * (params[3 + k] - p.expectedVel[k]);
+    }
+    return residuals;
+}
+
+std::vector<std::vector<double>> calculateJacobian(const std::vector<double>& params, const Problem& p) {
+    std::vector<double> base = calculateResiduals(params, p);
+    std::vector<std::vector<double>> jacobian(base.size(), std::vector<double>(params.size()));
+    const double h = 1e-7;
+    for (size_t k = 0; k < params.size(); ++k) {
+        std::vector<double> perturbed = params;
+        perturbed[k] += h;
+        std::vector<double> r = calculateResiduals(perturbed, p);
+        for (size_t i = 0; i < base.size(); ++i) {
+            jacobian[i][k] = (r[i] - base[i]) / h;
+        }
+    }
+    return jacobian;
+}
+
+std::vector<double> solveLinearEquations(const std::vector<std::vector<double>>& A, const std::vector<double>& b) {
+    int n = A.size();
+    std::vector<std::vector<double>> augmented(n, std::vector<double>(n + 1, 0.0));
+    std::vector<double> x(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) augmented[i][j] = A[i][j];
+        augmented[i][n] = b[i];
+    }
+    for (int i = 0; i < n; ++i) {
+        int maxRow = i;
+        for (int j = i + 1; j < n; ++j) {
+            if (std::abs(augmented[j][i]) > std::abs(augmented[maxRow][i])) maxRow = j;
+        }
+        if (maxRow != i) std::swap(augmented[i], augmented[maxRow]);
+        for (int j = i + 1; j < n; ++j) {
+            double factor = augmented[j][i] / augmented[i][i];
+            for (int k = i; k <= n; ++k) augmented[j][k] -= factor * augmented[i][k];
+        }
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        double sum = augmented[i][n];
+        for (int j = i + 1; j < n; ++j) sum -= augmented[i][j] * x[j];
+        x[i] = sum / augmented[i][i];
+    }
+    return x;
+}
+
+// 单次LM迭代：两次残差计算、数值雅可比(7次残差计算)、JᵀJ累加和高斯消元
+double iterate(std::vector<double>& x, double& lambda, double& bestError, const Problem& p) {
+    std::vector<double> residuals = calculateResiduals(x, p);
+    std::vector<std::vector<double>> J = calculateJacobian(x, p);
+    std::vector<std::vector<double>> JTJ(6, std::vector<double>(6, 0.0));
+    std::vector<double> JTr(6, 0.0);
+    for (size_t i = 0; i < J.size(); ++i) {
+        for (int j = 0; j < 6; ++j) {
+            for (int k = 0; k < 6; ++k) JTJ[j][k] += J[i][j] * J[i][k];
+            JTr[j] += J[i][j] * residuals[i];
+        }
+    }
+    for (int i = 0; i < 6; ++i) JTJ[i][i] += lambda;
+    std::vector<double> dx = solveLinearEquations(JTJ, JTr);
+    std::vector<double> xNew = x;
+    for (int i = 0; i < 6; ++i) xNew[i] += dx[i];
+    std::vector<double> newResiduals = calculateResiduals(xNew, p);
+    double newError = 0.0;
+    for (double r : newResiduals) newError += r * r;
+    newError = std::sqrt(newError);
+    if (newError < bestError) {
+        x = xNew;
+        bestError = newError;
+        lambda /= 10.0;
+    } else {
+        lambda *= 10.0;
+    }
+    return newError;
+}
+
+} // namespace legacy
+
+namespace {
+
+volatile double g_sink = 0.0;
+
+struct Scenario {
+    std::vector<FDOAObservation> observations;
+    legacy::Problem problem;
+    FDOASolverOptions options;
+    FDOAState truth;
+    FDOAState initial;
+};
+
+// 3个机载侦察站 + 1个低速运动辐射源，观测时刻在 [0, T] 内均匀分布
+Scenario makeScenario(int epochCount, double noiseStdDev, std::mt19937_64& gen) {
+    struct Platform { double lon, lat, alt, speed, azimuth, elevation; };
+    const Platform stations[] = {
+        {116.00, 39.00, 8000.0, 220.0, 90.0, 0.0},
+        {116.60, 39.10, 9000.0, 240.0, 180.0, 0.0},
+        {116.20, 39.60, 8500.0, 200.0, 45.0, 0.0},
+    };
+    const Platform source = {116.30, 39.25, 50.0, 12.0, 30.0, 0.0};
+    const double simulationTime = 20.0;
+
+    Scenario s;
+    const COORD3 p0 = lbh2xyz(source.lon, source.lat, source.alt);
+    const COORD3 v0 = velocity_lbh2xyz(source.lon, source.lat, source.speed, source.azimuth, source.elevation);
+    s.truth << p0.p1, p0.p2, p0.p3, v0.p1, v0.p2, v0.p3;
+
+    s.options.carrierFrequency = 10e9;
+    s.options.expectedVelocity = s.truth.tail<3>();
+    s.options.velocityWeight = 1e3;
+    s.options.maxIterations = 100;
+    s.options.tolerance = 1e-6;
+
+    s.problem.f0 = s.options.carrierFrequency;
+    s.problem.velocityWeight = s.options.velocityWeight;
+    for (int k = 0; k < 3; ++k) s.problem.expectedVel[k] = s.truth[3 + k];
+    for (int j = 0; j < epochCount; ++j) {
+        s.problem.timePoints.push_back(epochCount > 1 ? simulationTime * j / (epochCount - 1) : 0.0);
+    }
+
+    std::normal_distribution<double> noise(0.0, noiseStdDev);
+    for (const Platform& st : stations) {
+        const COORD3 pos = lbh2xyz(st.lon, st.lat, st.alt);
+        const COORD3 vel = velocity_lbh2xyz(st.lon, st.lat, st.speed, st.azimuth, st.elevation);
+        legacy::Station ls = {{pos.p1, pos.p2, pos.p3}, {vel.p1, vel.p2, vel.p3}};
+        s.problem.stations.push_back(ls);
+        std::vector<double> row;
+        for (double t : s.problem.timePoints) {
+            FDOAObservation obs;
+            obs.stationVelocity = Eigen::Vector3d(vel.p1, vel.p2, vel.p3);
+            obs.stationPosition = Eigen::Vector3d(pos.p1, pos.p2, pos.p3) + obs.stationVelocity * t;
+            obs.time = t;
+            obs.dopplerShift = fdoaPredictDoppler(obs, s.truth, s.options.carrierFrequency) +
+                               (noiseStdDev > 0.0 ? noise(gen) : 0.0);
+            s.observations.push_back(obs);
+            row.push_back(obs.dopplerShift);
+        }
+        s.problem.observed.push_back(row);
+    }
+
+    // 初始值：位置偏离约 200 米，速度偏离 0.1 m/s
+    s.initial = s.truth;
+    s.initial.head<3>() += Eigen::Vector3d(150.0, -120.0, 40.0);
+    s.initial.tail<3>() += Eigen::Vector3d(0.1, -0.05, 0.02);
+    return s;
+}
+
+template <typename Body>
+double measureSeconds(Body body) {
+    body();  // 预热
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const long solves = argc > 1 ? std::atol(argv[1]) : 20000;
+    std::mt19937_64 gen(20240611);
+    bool ok = true;
+
+    std::cout << "频差定位LM求解器微基准 (" << solves << " 次求解)" << std::endl;
+
+    // 单次迭代耗时：legacy 每步 9 次残差计算 + 高斯消元，Eigen 每步 1 次解析累加 + LDLT
+    {
+        const Scenario s = makeScenario(3, 0.0, gen);
+        const long iterations = solves * 10;
+        const double legacySeconds = measureSeconds([&]() {
+            std::vector<double> x(s.initial.data(), s.initial.data() + 6);
+            double lambda = 1e-3, best = 1e300;
+            for (long i = 0; i < iterations; ++i) {
+                g_sink = g_sink + legacy::iterate(x, lambda, best, s.problem);
+                if (i % 100 == 99) { x.assign(s.initial.data(), s.initial.data() + 6); lambda = 1e-3; best = 1e300; }
+            }
+        });
+        FDOASolverOptions single = s.options;
+        single.maxIterations = 1;
+        single.tolerance = 0.0;
+        const double eigenSeconds = measureSeconds([&]() {
+            for (long i = 0; i < iterations; ++i) {
+                g_sink = g_sink + fdoaSolveLM(s.observations, s.initial, single).finalError;
+            }
+        });
+        std::cout << "单次迭代: legacy " << std::fixed << std::setprecision(1)
+                  << legacySeconds * 1e9 / iterations << " ns, eigen "
+                  << eigenSeconds * 1e9 / iterations << " ns, 加速比 "
+                  << std::setprecision(2) << legacySeconds / eigenSeconds << "x" << std::endl;
+    }
+
+    // 不同观测时刻数下的完整求解
+    for (int epochs : {3, 11, 51}) {
+        const Scenario clean = makeScenario(epochs, 0.0, gen);
+        FDOASolution solution;
+        const double seconds = measureSeconds([&]() {
+            for (long i = 0; i < solves; ++i) {
+                solution = fdoaSolveLM(clean.observations, clean.initial, clean.options);
+                g_sink = g_sink + solution.finalError;
+            }
+        });
+        const double posError = (solution.state.head<3>() - clean.truth.head<3>()).norm();
+        const double velError = (solution.state.tail<3>() - clean.truth.tail<3>()).norm();
+        std::cout << std::setw(3) << epochs << " 个观测时刻: "
+                  << std::fixed << std::setprecision(0) << std::setw(10) << solves / seconds << " 次/秒"
+                  << std::setprecision(2) << std::setw(10) << seconds * 1e6 / solves << " us/次"
+                  << "  迭代 " << solution.iterations << (solution.converged ? " (收敛)" : " (未收敛)")
+                  << "  位置误差 " << std::scientific << std::setprecision(2) << posError << " m"
+                  << "  速度误差 " << velError << " m/s" << std::endl;
+        ok = ok && solution.converged && posError < 1e-2 && velError < 1e-4;
+
+        // 带 0.01Hz 测量噪声时观测时刻越多误差越小，只做展示
+        const Scenario noisy = makeScenario(epochs, 0.01, gen);
+        const FDOASolution noisySolution = fdoaSolveLM(noisy.observations, noisy.initial, noisy.options);
+        std::cout << "     含0.01Hz噪声: 位置误差 " << std::fixed << std::setprecision(2)
+                  << (noisySolution.state.head<3>() - noisy.truth.head<3>()).norm() << " m" << std::endl;
+    }
+
+    // 多起点：先验位置沿随机方向偏离 20km，单起点LM可能落入局部极小
+    {
+        const Scenario s = makeScenario(11, 0.01, gen);
+        const FDOASolution reference = fdoaSolveLM(s.observations, s.truth, s.options);
+        FDOAMultiStartOptions multiStart;
+        multiStart.positionSpread = 20000.0;
+        const int trials = 40;
+        std::normal_distribution<double> normal(0.0, 1.0);
+        int singleHits = 0, multiHits = 0, converged = 0;
+        double singleSeconds = 0.0, multiSeconds = 0.0;
+        for (int k = 0; k < trials; ++k) {
+            Eigen::Vector3d direction(normal(gen), normal(gen), normal(gen));
+            FDOAState prior = s.truth;
+            prior.head<3>() += 20000.0 * direction.normalized();
+
+            FDOASolution single;
+            singleSeconds += measureSeconds([&]() { single = fdoaSolveLM(s.observations, prior, s.options); });
+            FDOAMultiStartResult multi;
+            multiSeconds += measureSeconds([&]() {
+                multi = fdoaSolveMultiStart(s.observations, prior, s.options, multiStart);
+            });
+            singleHits += (single.state.head<3>() - reference.state.head<3>()).norm() < 1.0;
+            multiHits += (multi.best.state.head<3>() - reference.state.head<3>()).norm() < 1.0;
+            converged += multi.convergedCount;
+        }
+        std::cout << "多起点(" << multiStart.startCount << " 个起点, "
+                  << resolveThreadCount(multiStart.threadCount, multiStart.startCount) << " 线程), 先验偏离 20km: "
+                  << "单起点命中 " << singleHits << "/" << trials
+                  << ", 多起点命中 " << multiHits << "/" << trials
+                  << ", 起点收敛率 " << std::fixed << std::setprecision(1)
+                  << 100.0 * converged / (trials * multiStart.startCount) << "%" << std::endl;
+        std::cout << "     平均耗时: 单起点 " << std::setprecision(2) << singleSeconds * 1e6 / trials
+                  << " us, 多起点 " << multiSeconds * 1e6 / trials << " us" << std::endl;
+        ok = ok && multiHits == trials;
+    }
+
+    std::cout << (ok ? "精度校验通过" : "精度校验失败") << std::endl;
+    return ok ? 0 : 1;
+}
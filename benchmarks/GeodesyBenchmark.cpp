@@ -0,0 +1,115 @@
+/**
+ * @file GeodesyBenchmark.cpp
+ * @brief 批量坐标转换(lbh2xyzBatch / xyz2lbhBatch)的微基准与精度校验
+ *
+ * 在随机分布的全球点上对比逐点 lbh2xyz / xyz2lbh 与批量版本的吞吐量，
+ * 并统计批量结果相对逐点结果及往返转换的最大偏差；偏差超限时返回非零值。
+ * 用法: geodesy_benchmark [点数]
+ */
+
+#include "../utils/CoordinateTransform.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+volatile double g_sink = 0.0;
+
+template <typename Body>
+double measureSeconds(Body body) {
+    body();  // 预热
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printRate(const char* name, std::size_t n, double seconds) {
+    std::cout << std::left << std::setw(14) << name
+              << std::right << std::fixed << std::setprecision(0) << std::setw(14) << n / seconds << " 点/秒"
+              << std::setprecision(2) << std::setw(10) << seconds * 1e9 / n << " ns/点" << std::endl;
+}
+
+// 经度差按360度取模，极点处经度无定义不参与比较
+double longitudeDiff(double l1, double l2, double latitude) {
+    if (std::fabs(latitude) > 89.9999) return 0.0;
+    const double d = std::fabs(l1 - l2);
+    return std::min(d, 360.0 - d);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 1000000;
+
+    // 全球均匀经纬度，高程覆盖地面到卫星轨道高度
+    std::mt19937_64 gen(20240501);
+    std::uniform_real_distribution<double> lonDist(-180.0, 180.0);
+    std::uniform_real_distribution<double> latDist(-90.0, 90.0);
+    std::uniform_real_distribution<double> heightDist(-500.0, 1.0e6);
+    std::vector<double> l(n), b(n), h(n), x(n), y(n), z(n), l2(n), b2(n), h2(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        l[i] = lonDist(gen);
+        b[i] = latDist(gen);
+        h[i] = heightDist(gen);
+    }
+
+    std::cout << "批量坐标转换微基准 (" << n << " 点)" << std::endl;
+
+    const double scalarForward = measureSeconds([&]() {
+        for (std::size_t i = 0; i < n; ++i) {
+            g_sink = g_sink + lbh2xyz(l[i], b[i], h[i]).p1;
+        }
+    });
+    const double batchForward = measureSeconds([&]() {
+        lbh2xyzBatch(l.data(), b.data(), h.data(), x.data(), y.data(), z.data(), n);
+    });
+    printRate("lbh2xyz", n, scalarForward);
+    printRate("lbh2xyzBatch", n, batchForward);
+
+    const double scalarInverse = measureSeconds([&]() {
+        for (std::size_t i = 0; i < n; ++i) {
+            g_sink = g_sink + xyz2lbh(x[i], y[i], z[i]).p2;
+        }
+    });
+    const double batchInverse = measureSeconds([&]() {
+        xyz2lbhBatch(x.data(), y.data(), z.data(), l2.data(), b2.data(), h2.data(), n);
+    });
+    printRate("xyz2lbh", n, scalarInverse);
+    printRate("xyz2lbhBatch", n, batchInverse);
+
+    std::cout << "加速比: 正算 " << std::setprecision(2) << scalarForward / batchForward
+              << "x, 反算 " << scalarInverse / batchInverse << "x" << std::endl;
+
+    // 精度：批量 vs 逐点，以及 lbh -> xyz -> lbh 往返
+    double maxXyz = 0.0, maxLon = 0.0, maxLat = 0.0, maxHeight = 0.0;
+    double tripLat = 0.0, tripHeight = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const COORD3 xyz = lbh2xyz(l[i], b[i], h[i]);
+        maxXyz = std::max(maxXyz, std::max(std::fabs(xyz.p1 - x[i]),
+                                  std::max(std::fabs(xyz.p2 - y[i]), std::fabs(xyz.p3 - z[i]))));
+        const COORD3 lbh = xyz2lbh(x[i], y[i], z[i]);
+        maxLon = std::max(maxLon, longitudeDiff(lbh.p1, l2[i], b[i]));
+        maxLat = std::max(maxLat, std::fabs(lbh.p2 - b2[i]));
+        maxHeight = std::max(maxHeight, std::fabs(lbh.p3 - h2[i]));
+        tripLat = std::max(tripLat, std::fabs(b[i] - b2[i]));
+        tripHeight = std::max(tripHeight, std::fabs(h[i] - h2[i]));
+    }
+
+    std::cout << std::scientific << std::setprecision(3)
+              << "正算最大偏差(相对lbh2xyz):   " << maxXyz << " m" << std::endl
+              << "反算最大偏差(相对xyz2lbh):   经度 " << maxLon << " 度, 纬度 " << maxLat
+              << " 度, 高程 " << maxHeight << " m" << std::endl
+              << "往返最大偏差:                纬度 " << tripLat << " 度, 高程 " << tripHeight << " m" << std::endl;
+
+    // 逐点迭代解的收敛容差约为毫米级，往返偏差应在纳米级
+    const bool ok = maxXyz < 1e-6 && maxLon < 1e-9 && maxLat < 1e-9 && maxHeight < 1e-2
+                    && tripLat < 1e-11 && tripHeight < 1e-6;
+    std::cout << (ok ? "精度校验通过" : "精度校验失败") << std::endl;
+    return ok ? 0 : 1;
+}
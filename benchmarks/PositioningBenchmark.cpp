@@ -0,0 +1,967 @@
+/**
+ * @file PositioningBenchmark.cpp
+ * @brief 定位算法基准套件：坐标转换、TDOA、FDOA、测向交汇、双曲线、误差圆蒙特卡洛、精度覆盖图、链路预算筛查、可见性时间线、干涉仪
+ *
+ * 所有场景由固定种子生成，在计时循环之外准备好；每个基准对结果做精度校验，
+ * 超限时标记为错误并使程序返回非零值。按侦察站数和样本数参数化。
+ * 用法: positioning_benchmark [--benchmark_filter=正则] [--benchmark_out=结果.json] ...
+ *       参数说明见 BenchmarkHarness.h
+ */
+
+#include "BenchmarkHarness.h"
+#include "../constants/PhysicsConstants.h"
+#include "../models/DFSolver.h"
+#include "../models/DirectionFinding.h"
+#include "../models/FDOAalgorithm.h"
+#include "../models/FDOASolver.h"
+#include "../models/InMemoryModelRepository.h"
+#include "../models/InterferometerPositioning.h"
+#include "../models/TDOASolver.h"
+#include "../utils/AngleValidator.h"
+#include "../utils/CoordinateTransform.h"
+#include "../utils/CoverageMap.h"
+#include "../utils/ErrorCircle.h"
+#include "../utils/HyperbolaGeometry.h"
+#include "../utils/LinkBudgetValidator.h"
+#include "../utils/Log.h"
+#include "../utils/SNRValidator.h"
+#include "../utils/Vector3.h"
+#include "../utils/VisibilityTimeline.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const std::uint64_t kSeed = 20240601;
+const double kCenterLon = 116.3;
+const double kCenterLat = 39.9;
+
+// 以场景中心为圆心、半径约 radiusDeg 的圆周上均匀布站(大地坐标)
+std::vector<COORD3> makeStationRing(int count, double radiusDeg, double altitude) {
+    std::vector<COORD3> stations;
+    for (int i = 0; i < count; ++i) {
+        const double angle = 2.0 * M_PI * i / count;
+        stations.push_back({kCenterLon + radiusDeg * std::cos(angle),
+                            kCenterLat + radiusDeg * std::sin(angle),
+                            altitude + 100.0 * i});
+    }
+    return stations;
+}
+
+double distance(const COORD3& a, const COORD3& b) {
+    return std::sqrt((a.p1 - b.p1) * (a.p1 - b.p1) + (a.p2 - b.p2) * (a.p2 - b.p2) +
+                     (a.p3 - b.p3) * (a.p3 - b.p3));
+}
+
+// 无噪声时差：各站相对第0站
+std::vector<double> exactTdoas(const std::vector<COORD3>& stationsXyz, const COORD3& sourceXyz) {
+    std::vector<double> tdoas(stationsXyz.size());
+    const double r0 = distance(stationsXyz[0], sourceXyz);
+    for (size_t i = 0; i < stationsXyz.size(); ++i) {
+        tdoas[i] = (distance(stationsXyz[i], sourceXyz) - r0) / Constants::c;
+    }
+    return tdoas;
+}
+
+// ---坐标转换---
+
+struct GeodeticSamples {
+    std::vector<double> l, b, h, x, y, z;
+};
+
+GeodeticSamples makeGeodeticSamples(size_t n) {
+    std::mt19937_64 gen(kSeed);
+    std::uniform_real_distribution<double> lon(-180.0, 180.0), lat(-89.0, 89.0), alt(-100.0, 20000.0);
+    GeodeticSamples s;
+    for (size_t i = 0; i < n; ++i) {
+        s.l.push_back(lon(gen));
+        s.b.push_back(lat(gen));
+        s.h.push_back(alt(gen));
+        const COORD3 p = lbh2xyz(s.l.back(), s.b.back(), s.h.back());
+        s.x.push_back(p.p1);
+        s.y.push_back(p.p2);
+        s.z.push_back(p.p3);
+    }
+    return s;
+}
+
+void BM_Lbh2Xyz(bench::State& state) {
+    const size_t n = state.range(0);
+    const GeodeticSamples s = makeGeodeticSamples(n);
+    double maxError = 0.0;
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            const COORD3 p = lbh2xyz(s.l[i], s.b[i], s.h[i]);
+            bench::doNotOptimize(p);
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        const COORD3 p = lbh2xyz(s.l[i], s.b[i], s.h[i]);
+        maxError = std::max(maxError, distance(p, {s.x[i], s.y[i], s.z[i]}));
+    }
+    if (maxError > 1e-6) state.skipWithError("lbh2xyz结果与参考值不一致");
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+void BM_Xyz2Lbh(bench::State& state) {
+    const size_t n = state.range(0);
+    const GeodeticSamples s = makeGeodeticSamples(n);
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            const COORD3 p = xyz2lbh(s.x[i], s.y[i], s.z[i]);
+            bench::doNotOptimize(p);
+        }
+    }
+    double maxHeightError = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        maxHeightError = std::max(maxHeightError, std::abs(xyz2lbh(s.x[i], s.y[i], s.z[i]).p3 - s.h[i]));
+    }
+    state.counters["max_height_error_m"] = maxHeightError;
+    if (maxHeightError > 1e-3) state.skipWithError("xyz2lbh往返高程误差超过1毫米");
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+void BM_Lbh2XyzBatch(bench::State& state) {
+    const size_t n = state.range(0);
+    const GeodeticSamples s = makeGeodeticSamples(n);
+    std::vector<double> x(n), y(n), z(n);
+    while (state.keepRunning()) {
+        lbh2xyzBatch(s.l.data(), s.b.data(), s.h.data(), x.data(), y.data(), z.data(), n);
+        bench::doNotOptimize(x[n - 1]);
+    }
+    double maxError = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        maxError = std::max(maxError, distance({x[i], y[i], z[i]}, {s.x[i], s.y[i], s.z[i]}));
+    }
+    if (maxError > 1e-6) state.skipWithError("lbh2xyzBatch结果与标量版本不一致");
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+void BM_Xyz2LbhBatch(bench::State& state) {
+    const size_t n = state.range(0);
+    const GeodeticSamples s = makeGeodeticSamples(n);
+    std::vector<double> l(n), b(n), h(n);
+    while (state.keepRunning()) {
+        xyz2lbhBatch(s.x.data(), s.y.data(), s.z.data(), l.data(), b.data(), h.data(), n);
+        bench::doNotOptimize(h[n - 1]);
+    }
+    double maxHeightError = 0.0;
+    for (size_t i = 0; i < n; ++i) maxHeightError = std::max(maxHeightError, std::abs(h[i] - s.h[i]));
+    if (maxHeightError > 1e-3) state.skipWithError("xyz2lbhBatch往返高程误差超过1毫米");
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// ---TDOA---
+
+struct TDOAScenario {
+    std::vector<COORD3> stationsLbh;
+    std::vector<COORD3> stationsXyz;
+    std::vector<COORD3> sourcesXyz;
+    std::vector<std::vector<double>> tdoas;
+    std::vector<double> knownHeights;
+};
+
+// 站数 stationCount，samples 个随机辐射源(站阵内部，地面高度)
+TDOAScenario makeTDOAScenario(int stationCount, size_t samples) {
+    std::mt19937_64 gen(kSeed + stationCount);
+    std::uniform_real_distribution<double> offset(-0.25, 0.25), alt(0.0, 3000.0);
+    TDOAScenario s;
+    s.stationsLbh = makeStationRing(stationCount, 0.5, 200.0);
+    s.stationsXyz = lbh2xyzBatch(s.stationsLbh);
+    for (size_t k = 0; k < samples; ++k) {
+        const COORD3 source = lbh2xyz(kCenterLon + offset(gen), kCenterLat + offset(gen), alt(gen));
+        s.sourcesXyz.push_back(source);
+        s.tdoas.push_back(exactTdoas(s.stationsXyz, source));
+        s.knownHeights.push_back(source.p3);
+    }
+    return s;
+}
+
+double maxPositionError(const TDOAScenario& s, const std::vector<COORD3>& positions) {
+    double maxError = 0.0;
+    for (size_t k = 0; k < positions.size(); ++k) {
+        maxError = std::max(maxError, distance(positions[k], s.sourcesXyz[k]));
+    }
+    return maxError;
+}
+
+// Chan初始解 + 泰勒迭代(二维，高度已知)，单线程逐个求解
+void BM_TDOAChanTaylor(bench::State& state) {
+    const TDOAScenario s = makeTDOAScenario(state.range(0), state.range(1));
+    const TDOABatchLocator locator(s.stationsXyz);
+    std::vector<COORD3> positions(s.tdoas.size());
+    while (state.keepRunning()) {
+        for (size_t k = 0; k < s.tdoas.size(); ++k) {
+            positions[k] = locator.locate(s.tdoas[k].data(), s.knownHeights[k], 1e-8).position;
+        }
+        bench::doNotOptimize(positions[0]);
+    }
+    const double maxError = maxPositionError(s, positions);
+    state.counters["max_error_m"] = maxError;
+    if (maxError > 1.0) state.skipWithError("Chan+泰勒定位误差超过1米");
+    state.setItemsProcessed(state.iterations() * s.tdoas.size());
+}
+
+// 三维Chan两步WLS + 高斯-牛顿(不固定高度)
+void BM_TDOALocate3D(bench::State& state) {
+    const TDOAScenario s = makeTDOAScenario(state.range(0), state.range(1));
+    const int n = s.stationsXyz.size();
+    std::vector<COORD3> positions(s.tdoas.size());
+    while (state.keepRunning()) {
+        for (size_t k = 0; k < s.tdoas.size(); ++k) {
+            positions[k] = tdoaLocate3D(s.stationsXyz.data(), n, s.tdoas[k].data(), 1e-8).position;
+        }
+        bench::doNotOptimize(positions[0]);
+    }
+    const double maxError = maxPositionError(s, positions);
+    state.counters["max_error_m"] = maxError;
+    if (maxError > 1.0) state.skipWithError("三维TDOA定位误差超过1米");
+    state.setItemsProcessed(state.iterations() * s.tdoas.size());
+}
+
+// 批量并行求解(全部硬件线程)
+void BM_TDOALocateBatch(bench::State& state) {
+    const TDOAScenario s = makeTDOAScenario(state.range(0), state.range(1));
+    const TDOABatchLocator locator(s.stationsXyz);
+    std::vector<TDOABatchLocator::Solution> solutions;
+    while (state.keepRunning()) {
+        solutions = locator.locateBatch(s.tdoas, s.knownHeights, 1e-8);
+        bench::doNotOptimize(solutions[0].position);
+    }
+    std::vector<COORD3> positions;
+    for (const TDOABatchLocator::Solution& solution : solutions) positions.push_back(solution.position);
+    const double maxError = maxPositionError(s, positions);
+    state.counters["max_error_m"] = maxError;
+    if (maxError > 1.0) state.skipWithError("批量TDOA定位误差超过1米");
+    state.setItemsProcessed(state.iterations() * s.tdoas.size());
+}
+
+// ---FDOA---
+
+struct FDOAScenario {
+    std::vector<FDOAObservation> observations;
+    FDOAState truth;
+    FDOAState initial;
+    FDOASolverOptions options;
+};
+
+// stationCount 个机载侦察站，epochCount 个观测时刻，运动辐射源
+FDOAScenario makeFDOAScenario(int stationCount, int epochCount) {
+    const double simulationTime = 20.0;
+    FDOAScenario s;
+    const COORD3 p0 = lbh2xyz(kCenterLon, kCenterLat, 50.0);
+    const COORD3 v0 = velocity_lbh2xyz(kCenterLon, kCenterLat, 12.0, 30.0, 0.0);
+    s.truth << p0.p1, p0.p2, p0.p3, v0.p1, v0.p2, v0.p3;
+
+    s.options.carrierFrequency = 10e9;
+    s.options.expectedVelocity = s.truth.tail<3>();
+    s.options.velocityWeight = 1e3;
+    s.options.maxIterations = 100;
+    s.options.tolerance = 1e-6;
+
+    const std::vector<COORD3> stations = makeStationRing(stationCount, 0.4, 8000.0);
+    for (int i = 0; i < stationCount; ++i) {
+        const double heading = std::fmod(90.0 + 360.0 * i / stationCount + 45.0, 360.0);
+        const COORD3 pos = lbh2xyz(stations[i].p1, stations[i].p2, stations[i].p3);
+        const COORD3 vel = velocity_lbh2xyz(stations[i].p1, stations[i].p2, 200.0 + 10.0 * i, heading, 0.0);
+        for (int j = 0; j < epochCount; ++j) {
+            const double t = epochCount > 1 ? simulationTime * j / (epochCount - 1) : 0.0;
+            FDOAObservation obs;
+            obs.stationVelocity = Eigen::Vector3d(vel.p1, vel.p2, vel.p3);
+            obs.stationPosition = Eigen::Vector3d(pos.p1, pos.p2, pos.p3) + obs.stationVelocity * t;
+            obs.time = t;
+            obs.dopplerShift = fdoaPredictDoppler(obs, s.truth, s.options.carrierFrequency);
+            s.observations.push_back(obs);
+        }
+    }
+
+    // 初始值：位置偏离约 200 米，速度偏离 0.1 m/s
+    s.initial = s.truth;
+    s.initial.head<3>() += Eigen::Vector3d(150.0, -120.0, 40.0);
+    s.initial.tail<3>() += Eigen::Vector3d(0.1, -0.05, 0.02);
+    return s;
+}
+
+void BM_FDOASolveLM(bench::State& state) {
+    const FDOAScenario s = makeFDOAScenario(state.range(0), state.range(1));
+    FDOASolution solution;
+    int totalIterations = 0;
+    while (state.keepRunning()) {
+        solution = fdoaSolveLM(s.observations, s.initial, s.options);
+        totalIterations += solution.iterations;
+        bench::doNotOptimize(solution.state);
+    }
+    const double error = (solution.state.head<3>() - s.truth.head<3>()).norm();
+    state.counters["position_error_m"] = error;
+    state.counters["lm_iterations"] = static_cast<double>(totalIterations) / state.iterations();
+    if (!solution.converged || error > 1.0) state.skipWithError("FDOA LM未收敛到真值");
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_FDOASolveMultiStart(bench::State& state) {
+    const FDOAScenario s = makeFDOAScenario(state.range(0), state.range(1));
+    FDOAMultiStartOptions multiStart;
+    multiStart.startCount = state.range(2);
+    FDOAMultiStartResult result;
+    while (state.keepRunning()) {
+        result = fdoaSolveMultiStart(s.observations, s.initial, s.options, multiStart);
+        bench::doNotOptimize(result.best.state);
+    }
+    const double error = (result.best.state.head<3>() - s.truth.head<3>()).norm();
+    state.counters["position_error_m"] = error;
+    state.counters["converged_starts"] = result.convergedCount;
+    if (!result.best.converged || error > 1.0) state.skipWithError("FDOA多起点求解未收敛到真值");
+    state.setItemsProcessed(state.iterations() * multiStart.startCount);
+}
+
+// ---测向交汇---
+
+void BM_IntersectDirections2D(bench::State& state) {
+    const size_t n = state.range(0);
+    std::mt19937_64 gen(kSeed);
+    std::uniform_real_distribution<double> coord(-50000.0, 50000.0);
+    std::vector<Vector3> obs1(n), dir1(n), obs2(n), dir2(n), truth(n);
+    for (size_t i = 0; i < n; ++i) {
+        obs1[i] = Vector3(coord(gen), coord(gen), 0.0);
+        obs2[i] = Vector3(coord(gen), coord(gen), 0.0);
+        truth[i] = Vector3(coord(gen), coord(gen), 0.0);
+        dir1[i] = (truth[i] - obs1[i]).normalize();
+        dir2[i] = (truth[i] - obs2[i]).normalize();
+    }
+    std::vector<Vector3> result(n);
+    while (state.keepRunning()) {
+        for (size_t i = 0; i < n; ++i) result[i] = intersectDirections2D(obs1[i], dir1[i], obs2[i], dir2[i]);
+        bench::doNotOptimize(result[n - 1]);
+    }
+    // 交汇角很小的样本数值上不稳定，只校验交汇角大于5度的样本
+    double maxError = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        if (std::abs(dir1[i].cross(dir2[i]).z) < std::sin(5.0 * Constants::DEG2RAD)) continue;
+        maxError = std::max(maxError, (result[i] - truth[i]).magnitude());
+    }
+    state.counters["max_error_m"] = maxError;
+    if (maxError > 1e-3) state.skipWithError("测向交汇点与真值不一致");
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// N站加权最小二乘测向：无噪声测向值，三维模式各站同时测俯仰，二维模式只测方位并给定高度
+void BM_DFLocateWLS(bench::State& state) {
+    const int n = state.range(0);
+    const bool threeD = state.range(1) != 0;
+    const std::vector<COORD3> stations = makeStationRing(n, 0.5, 200.0);
+    const COORD3 truthLbh = {kCenterLon + 0.12, kCenterLat - 0.08, threeD ? 8000.0 : 0.0};
+    const COORD3 truth = lbh2xyz(truthLbh.p1, truthLbh.p2, truthLbh.p3);
+
+    std::vector<DFBearing> bearings(n);
+    for (int i = 0; i < n; ++i) {
+        const COORD3 s = lbh2xyz(stations[i].p1, stations[i].p2, stations[i].p3);
+        const double l = stations[i].p1 * Constants::DEG2RAD, b = stations[i].p2 * Constants::DEG2RAD;
+        const double dx = truth.p1 - s.p1, dy = truth.p2 - s.p2, dz = truth.p3 - s.p3;
+        const double e = -std::sin(l) * dx + std::cos(l) * dy;
+        const double nn = -std::sin(b) * std::cos(l) * dx - std::sin(b) * std::sin(l) * dy + std::cos(b) * dz;
+        const double u = std::cos(b) * std::cos(l) * dx + std::cos(b) * std::sin(l) * dy + std::sin(b) * dz;
+        bearings[i].station = stations[i];
+        bearings[i].azimuth = std::atan2(e, nn) * Constants::RAD2DEG;
+        bearings[i].azimuthSigma = 1.0;
+        if (threeD) {
+            bearings[i].elevation = std::atan2(u, std::hypot(e, nn)) * Constants::RAD2DEG;
+            bearings[i].elevationSigma = 1.0;
+        }
+    }
+    DFSolverOptions options;
+    if (!threeD) options.knownAltitude = truthLbh.p3;
+
+    DFSolution solution;
+    while (state.keepRunning()) {
+        solution = dfLocateWLS(bearings, options);
+        bench::doNotOptimize(solution.position);
+    }
+    const double error = distance(solution.position, truth);
+    state.counters["error_m"] = error;
+    state.counters["cep_m"] = horizontalCEP(solution.covariance, solution.position);
+    if (!solution.valid || !(error < 0.1)) state.skipWithError("测向最小二乘定位误差超过0.1米");
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// ---双曲线---
+
+// 站数为N时绘制 N-1 条双曲线(各站相对第0站)
+void BM_HyperbolaPoints(bench::State& state) {
+    const int stationCount = state.range(0);
+    const std::vector<COORD3> stations = makeStationRing(stationCount, 0.5, 0.0);
+    const std::vector<COORD3> stationsXyz = lbh2xyzBatch(stations);
+    const COORD3 source = lbh2xyz(kCenterLon + 0.1, kCenterLat - 0.05, 0.0);
+    const std::vector<double> tdoas = exactTdoas(stationsXyz, source);
+    size_t pointCount = 0;
+    while (state.keepRunning()) {
+        pointCount = 0;
+        for (int i = 1; i < stationCount; ++i) {
+            const std::vector<COORD3> points =
+                computeHyperbolaPoints(stations[0], stations[i], -tdoas[i], 0.0, kCenterLon, kCenterLat);
+            pointCount += points.size();
+            bench::doNotOptimize(points.data());
+        }
+    }
+    state.counters["points"] = static_cast<double>(pointCount);
+    if (pointCount == 0) state.skipWithError("双曲线没有生成任何点");
+    state.setItemsProcessed(state.iterations() * (stationCount - 1));
+}
+
+// ---误差圆蒙特卡洛---
+
+MonteCarloConfig makeMonteCarloConfig(size_t samples, unsigned int threads) {
+    MonteCarloConfig config;
+    config.sampleCount = samples;
+    config.threadCount = threads;
+    config.seed = kSeed;
+    return config;
+}
+
+void BM_DFErrorCircle(bench::State& state) {
+    const MonteCarloConfig config = makeMonteCarloConfig(state.range(0), state.range(1));
+    const DFErrorMode mode = state.range(2) != 0 ? DFErrorMode::Sampling : DFErrorMode::Analytic;
+    const COORD3 esm1 = lbh2xyz(kCenterLon - 0.3, kCenterLat, 200.0);
+    const COORD3 esm2 = lbh2xyz(kCenterLon + 0.3, kCenterLat, 200.0);
+    const COORD3 target = lbh2xyz(kCenterLon, kCenterLat + 0.4, 0.0);
+    DFResult result;
+    while (state.keepRunning()) {
+        result = calculateDFErrorCircle(esm1, esm2, target, 0.0, 1.0, 0.0, 1.0, config, mode);
+        bench::doNotOptimize(result.cepRadius);
+    }
+    state.counters["cep_m"] = result.cepRadius;
+    state.counters["analytic_cep_m"] = result.ellipse.cep;
+    if (!(result.cepRadius > 0.0) || !std::isfinite(result.cepRadius)) state.skipWithError("测向误差圆半径无效");
+    // 蒙特卡洛结果与解析椭圆的CEP相差应在样本统计误差之内
+    if (mode == DFErrorMode::Sampling && std::fabs(result.cepRadius / result.ellipse.cep - 1.0) > 0.05) {
+        state.skipWithError("测向误差圆蒙特卡洛结果与解析结果不一致");
+    }
+    state.setItemsProcessed(state.iterations() * config.sampleCount);
+}
+
+// 与界面相同的路径：三维时差定位给出协方差，误差圆由协方差解析计算并采样验证；站数改变几何和CEP
+void BM_TDOAErrorCircle(bench::State& state) {
+    const MonteCarloConfig config = makeMonteCarloConfig(state.range(1), state.range(2));
+    const std::vector<COORD3> stations = lbh2xyzBatch(makeStationRing(state.range(0), 0.5, 200.0));
+    const COORD3 target = lbh2xyz(kCenterLon + 0.1, kCenterLat - 0.05, 8000.0);
+    const TDOA3DSolution solution = tdoaLocate3D(stations, exactTdoas(stations, target), 20e-9);
+    if (!solution.valid) {
+        state.skipWithError("三维时差定位失败");
+        return;
+    }
+    TDOAResult result;
+    while (state.keepRunning()) {
+        result = calculateTDOAErrorCircle(solution.position, solution.covariance, config);
+        bench::doNotOptimize(result.cepRadius);
+    }
+    // 解析CEP为 0.59(σa+σb) 近似，与采样中位半径相差几个百分点以内
+    const double relErr = std::abs(result.stats.confidenceRadius - result.cepRadius) / result.cepRadius;
+    state.counters["cep_m"] = result.cepRadius;
+    state.counters["sampled_cep_m"] = result.stats.confidenceRadius;
+    if (!(result.cepRadius > 0.0) || !std::isfinite(result.cepRadius)) state.skipWithError("时差误差圆半径无效");
+    else if (!(relErr < 0.05)) state.skipWithError("采样CEP与协方差解析CEP不一致");
+    state.setItemsProcessed(state.iterations() * config.sampleCount);
+}
+
+// ---精度覆盖图---
+
+CoverageScenario makeCoverageScenario() {
+    CoverageScenario scenario;
+    scenario.system = CoverageSystem::TDOA;
+    scenario.stations = makeStationRing(4, 0.5, 200.0);
+    scenario.tdoaSigma = 20e-9;
+    return scenario;
+}
+
+// 参考值：数值雅可比 + 完整协方差 σ²/2(I+11^T) 求逆，返回 sqrt(tr CRLB)
+double referenceTdoaRms(const CoverageScenario& scenario, double lon, double lat) {
+    const std::vector<COORD3> stations = lbh2xyzBatch(scenario.stations);
+    const int m = static_cast<int>(stations.size()) - 1;
+    const double phi = lat * Constants::DEG2RAD, lambda = lon * Constants::DEG2RAD;
+    const COORD3 target = lbh2xyz(lon, lat, scenario.targetAltitude);
+    const double east[3] = {-std::sin(lambda), std::cos(lambda), 0.0};
+    const double north[3] = {-std::sin(phi) * std::cos(lambda), -std::sin(phi) * std::sin(lambda), std::cos(phi)};
+    auto rangeDiffs = [&](double de, double dn) {
+        const COORD3 p = {target.p1 + de * east[0] + dn * north[0], target.p2 + de * east[1] + dn * north[1],
+                          target.p3 + de * east[2] + dn * north[2]};
+        Eigen::VectorXd d(m);
+        for (int i = 0; i < m; ++i) d(i) = distance(stations[i + 1], p) - distance(stations[0], p);
+        return d;
+    };
+    const double step = 0.5;
+    Eigen::MatrixXd h(m, 2);
+    h.col(0) = (rangeDiffs(step, 0.0) - rangeDiffs(-step, 0.0)) / (2.0 * step);
+    h.col(1) = (rangeDiffs(0.0, step) - rangeDiffs(0.0, -step)) / (2.0 * step);
+    const double sigma = Constants::c * scenario.tdoaSigma;
+    const Eigen::MatrixXd r = 0.5 * sigma * sigma *
+        (Eigen::MatrixXd::Identity(m, m) + Eigen::MatrixXd::Ones(m, m));
+    const Eigen::Matrix2d crlb = (h.transpose() * r.inverse() * h).inverse();
+    return std::sqrt(crlb.trace());
+}
+
+void BM_CoverageGrid(bench::State& state) {
+    const CoverageScenario scenario = makeCoverageScenario();
+    CoverageGridSpec spec;
+    spec.west = kCenterLon - 1.5;
+    spec.east = kCenterLon + 1.5;
+    spec.south = kCenterLat - 1.5;
+    spec.north = kCenterLat + 1.5;
+    spec.width = spec.height = state.range(0);
+    spec.threadCount = state.range(1);
+    const bool cached = state.range(2) != 0;
+
+    CoverageMapEngine engine;
+    CoverageGrid grid;
+    if (cached) engine.compute(scenario, spec, grid);
+    while (state.keepRunning()) {
+        if (!cached) engine.clearCache();
+        engine.compute(scenario, spec, grid);
+        bench::doNotOptimize(grid.rms.data());
+    }
+    state.counters["tiles_computed"] = static_cast<double>(grid.tilesComputed);
+    state.setItemsProcessed(state.iterations() * spec.width * spec.height);
+
+    // 抽查网格点：与逐点计算一致，且与完整协方差的参考CRLB一致
+    const double lonStep = (grid.east - grid.west) / grid.width;
+    const double latStep = (grid.north - grid.south) / grid.height;
+    double worst = 0.0;
+    for (int k = 1; k < 8; ++k) {
+        const int row = grid.height * k / 8, col = grid.width * (8 - k) / 8;
+        const double lon = grid.west + (col + 0.5) * lonStep;
+        const double lat = grid.north - (row + 0.5) * latStep;
+        const double value = grid.rms[static_cast<size_t>(row) * grid.width + col];
+        const double reference = referenceTdoaRms(scenario, lon, lat);
+        const double point = evaluateCoveragePoint(scenario, lon, lat).rms;
+        worst = std::max(worst, std::max(std::abs(value - reference), std::abs(value - point)) / reference);
+    }
+    state.counters["max_rel_err"] = worst;
+    if (!(worst < 1e-4)) state.skipWithError("覆盖图CRLB与参考值不一致");
+}
+
+// ---批量链路预算筛查---
+
+// 场景中心附近随机生成设备和辐射源，扇区、频段和功率随机，使各项判定都有通过和不通过：
+// 设备和辐射源相距几公里到几十公里，与最大可探测距离同一量级；方位扇区宽度三分之二周到一周
+void makeLinkBudgetCatalog(int deviceCount, int sourceCount, std::vector<ReconnaissanceDevice>& devices,
+                           std::vector<RadiationSource>& sources) {
+    std::mt19937_64 gen(kSeed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_real_distribution<double> offset(-0.15, 0.15);
+    std::uniform_real_distribution<double> altitude(0.0, 3000.0);
+    std::uniform_real_distribution<double> azimuthWidth(240.0, 360.0);
+    std::uniform_real_distribution<double> elevationStart(-90.0, -30.0);
+    std::uniform_real_distribution<double> elevationWidth(90.0, 180.0);
+    std::uniform_real_distribution<double> frequency(0.5, 18.0);
+    std::uniform_real_distribution<double> width(4.0, 18.0);
+    std::uniform_real_distribution<double> noisePsd(-174.0, -154.0);
+    std::uniform_real_distribution<double> powerExponent(1.0, 3.0);
+    // 扇区 [下限, 上限]：上限不超过360°/90°
+    auto azimuthSector = [&](double& low, double& high) {
+        const double w = azimuthWidth(gen);
+        low = unit(gen) * (360.0 - w);
+        high = low + w;
+    };
+    auto elevationSector = [&](double& low, double& high) {
+        low = elevationStart(gen);
+        high = std::min(90.0, low + elevationWidth(gen));
+    };
+    devices.resize(deviceCount);
+    for (int i = 0; i < deviceCount; ++i) {
+        ReconnaissanceDevice& device = devices[i];
+        device.setDeviceId(i + 1);
+        device.setLongitude(kCenterLon + offset(gen));
+        device.setLatitude(kCenterLat + offset(gen));
+        device.setAltitude(altitude(gen));
+        device.setNoisePsd(static_cast<float>(noisePsd(gen)));
+        const double low = frequency(gen);
+        device.setFreqRangeMin(static_cast<float>(low));
+        device.setFreqRangeMax(static_cast<float>(low + width(gen)));
+        double azLow, azHigh, elLow, elHigh;
+        azimuthSector(azLow, azHigh);
+        elevationSector(elLow, elHigh);
+        device.setAngleAzimuthMin(static_cast<float>(azLow));
+        device.setAngleAzimuthMax(static_cast<float>(azHigh));
+        device.setAngleElevationMin(static_cast<float>(elLow));
+        device.setAngleElevationMax(static_cast<float>(elHigh));
+    }
+    sources.resize(sourceCount);
+    for (int i = 0; i < sourceCount; ++i) {
+        RadiationSource& source = sources[i];
+        source.setRadiationId(i + 1);
+        source.setLongitude(kCenterLon + offset(gen));
+        source.setLatitude(kCenterLat + offset(gen));
+        source.setAltitude(altitude(gen));
+        source.setTransmitPower(std::pow(10.0, powerExponent(gen)));  // 10~1000 kW
+        source.setCarrierFrequency(frequency(gen));
+        double azLow, azHigh, elLow, elHigh;
+        azimuthSector(azLow, azHigh);
+        elevationSector(elLow, elHigh);
+        source.setAzimuthStart(azLow);
+        source.setAzimuthEnd(azHigh);
+        source.setElevationStart(elLow);
+        source.setElevationEnd(elHigh);
+    }
+}
+
+void BM_LinkBudgetScreening(bench::State& state) {
+    std::vector<ReconnaissanceDevice> devices;
+    std::vector<RadiationSource> sources;
+    makeLinkBudgetCatalog(state.range(0), state.range(1), devices, sources);
+    LinkBudgetOptions options;
+    options.threadCount = state.range(2);
+
+    LinkBudgetMatrix matrix;
+    while (state.keepRunning()) {
+        matrix = validateLinkBudgetBatch(devices, sources, options);
+        bench::doNotOptimize(matrix.receivable.data());
+    }
+    state.setItemsProcessed(state.iterations() * devices.size() * sources.size());
+
+    // 抽查设备-辐射源对：与逐对的 calculateSNR、canReceiveSignal 和频段判定一致
+    size_t mismatches = 0, receivable = 0, checked = 0, inBandCount = 0, snrCount = 0, visibleCount = 0;
+    double worstSnr = 0.0;
+    for (size_t k = 0; k < matrix.snrDb.size(); k += 97) {
+        const size_t s = k / matrix.deviceCount, d = k % matrix.deviceCount;
+        const ReconnaissanceDevice& device = devices[d];
+        const RadiationSource& source = sources[s];
+        const COORD3 dx = lbh2xyz(device.getLongitude(), device.getLatitude(), device.getAltitude());
+        const COORD3 sx = lbh2xyz(source.getLongitude(), source.getLatitude(), source.getAltitude());
+        const double snr = calculateSNR(distance(dx, sx), source.getTransmitPower(), source.getCarrierFrequency(),
+                                        device.getNoisePsd(), device.getFreqRangeMax() - device.getFreqRangeMin());
+        const bool snrPass = snr >= Constants::SNR_THRESHOLD;
+        const bool inBand = source.getCarrierFrequency() >= device.getFreqRangeMin() &&
+                            source.getCarrierFrequency() <= device.getFreqRangeMax();
+        const bool visible = canReceiveSignal(dx.p1, dx.p2, dx.p3,
+                                              device.getAngleAzimuthMin(), device.getAngleAzimuthMax(),
+                                              device.getAngleElevationMin(), device.getAngleElevationMax(),
+                                              sx.p1, sx.p2, sx.p3,
+                                              source.getAzimuthStart(), source.getAzimuthEnd(),
+                                              source.getElevationStart(), source.getElevationEnd());
+        worstSnr = std::max(worstSnr, std::abs(snr - matrix.snrDb[k]));
+        if ((matrix.snrPass[k] != 0) != snrPass || (matrix.inBand[k] != 0) != inBand ||
+            (matrix.visible[k] != 0) != visible) {
+            ++mismatches;
+        }
+        receivable += matrix.receivable[k];
+        inBandCount += inBand;
+        snrCount += snrPass;
+        visibleCount += visible;
+        ++checked;
+    }
+    const double receivableRate = static_cast<double>(receivable) / checked;
+    state.counters["checked_pairs"] = static_cast<double>(checked);
+    state.counters["receivable_rate"] = receivableRate;
+    state.counters["in_band_rate"] = static_cast<double>(inBandCount) / checked;
+    state.counters["snr_pass_rate"] = static_cast<double>(snrCount) / checked;
+    state.counters["visible_rate"] = static_cast<double>(visibleCount) / checked;
+    state.counters["max_snr_err_db"] = worstSnr;
+    if (mismatches != 0 || !(worstSnr < 1e-3)) state.skipWithError("批量筛查结果与逐对验证不一致");
+    // 可接收和不可接收都要占一定比例，否则抽查覆盖不到其中一种判定
+    if (!(receivableRate > 0.05 && receivableRate < 0.95)) state.skipWithError("抽查样本中可接收比例过低或过高");
+}
+
+// ---可见性时间线---
+
+// 4个侦察站，其中两站扇区不满一周；高功率辐射源以250米/秒向东飞离，途中依次超出各站的探测距离
+void makeTimelineScenario(std::vector<ReconnaissanceDevice>& devices, RadiationSource& source) {
+    const std::vector<COORD3> stations = makeStationRing(4, 0.5, 200.0);
+    devices.resize(stations.size());
+    for (size_t i = 0; i < stations.size(); ++i) {
+        ReconnaissanceDevice& device = devices[i];
+        device.setDeviceId(static_cast<int>(i) + 1);
+        device.setLongitude(stations[i].p1);
+        device.setLatitude(stations[i].p2);
+        device.setAltitude(stations[i].p3);
+        device.setNoisePsd(-174);
+        device.setFreqRangeMin(0.5f);
+        device.setFreqRangeMax(20);
+        device.setAngleAzimuthMin(i % 2 == 0 ? 0 : 30);
+        device.setAngleAzimuthMax(i % 2 == 0 ? 360 : 300);
+        device.setAngleElevationMin(-90);
+        device.setAngleElevationMax(90);
+        if (i == 0) {
+            device.setIsStationary(false);
+            device.setMovementSpeed(20);
+            device.setMovementAzimuth(90);
+        }
+    }
+    source.setRadiationId(1);
+    source.setTransmitPower(1000);
+    source.setCarrierFrequency(8);
+    source.setAzimuthStart(0);
+    source.setAzimuthEnd(360);
+    source.setElevationStart(-90);
+    source.setElevationEnd(90);
+    source.setLongitude(kCenterLon);
+    source.setLatitude(kCenterLat);
+    source.setAltitude(8000);
+    source.setIsStationary(false);
+    source.setMovementSpeed(250);
+    source.setMovementAzimuth(90);
+}
+
+void BM_VisibilityTimeline(bench::State& state) {
+    std::vector<ReconnaissanceDevice> devices;
+    RadiationSource source;
+    makeTimelineScenario(devices, source);
+    const double simulationTime = static_cast<double>(state.range(0));
+    VisibilityTimelineOptions options;
+    options.skipProvenSpans = state.range(1) != 0;
+
+    VisibilityTimeline timeline;
+    while (state.keepRunning()) {
+        timeline = computeVisibilityTimeline(devices, source, simulationTime, options);
+        bench::doNotOptimize(timeline.allReceivable.data());
+    }
+    state.setItemsProcessed(state.iterations() * devices.size() * timeline.times.size());
+
+    // 跳过的采样点必须与逐点计算的结果完全一致
+    VisibilityTimelineOptions reference = options;
+    reference.skipProvenSpans = false;
+    const VisibilityTimeline expected = computeVisibilityTimeline(devices, source, simulationTime, reference);
+    bool same = true;
+    for (size_t i = 0; i < devices.size(); ++i) {
+        same = same && timeline.devices[i].receivable == expected.devices[i].receivable;
+    }
+    const std::vector<double> common = timeline.commonEpochs();
+    state.counters["evaluated"] = static_cast<double>(timeline.evaluatedSamples);
+    state.counters["skipped"] = static_cast<double>(timeline.skippedSamples);
+    state.counters["common_s"] = common.empty() ? 0.0 : common.back() - common.front();
+    if (!same) state.skipWithError("跳过时段的可见性与逐点计算不一致");
+    if (common.empty()) state.skipWithError("场景中没有全部侦察站都能接收的时刻");
+}
+
+// 3个固定侦察站；辐射源从约250公里外以250米/秒向东飞来，初始时刻超出探测距离，
+// 频差解算的观测时刻应移到可接收时段内，定位精度也按这些时刻计算
+void BM_FDOAVisibleEpochs(bench::State& state) {
+    std::shared_ptr<InMemoryModelRepository> repository = std::make_shared<InMemoryModelRepository>();
+    std::vector<std::string> deviceNames;
+    std::vector<int> deviceIds;
+    const std::vector<COORD3> stations = makeStationRing(3, 0.5, 200.0);
+    for (size_t i = 0; i < stations.size(); ++i) {
+        ReconnaissanceDevice device;
+        device.setDeviceName("侦察站" + std::to_string(i + 1));
+        device.setLongitude(stations[i].p1);
+        device.setLatitude(stations[i].p2);
+        device.setAltitude(stations[i].p3);
+        device.setNoisePsd(-174);
+        device.setFreqRangeMin(0.5f);
+        device.setFreqRangeMax(20);
+        device.setAngleAzimuthMin(0);
+        device.setAngleAzimuthMax(360);
+        device.setAngleElevationMin(-90);
+        device.setAngleElevationMax(90);
+        deviceIds.push_back(repository->addReconnaissanceDevice(device));
+        deviceNames.push_back(device.getDeviceName());
+    }
+    RadiationSource source;
+    source.setRadiationName("来袭辐射源");
+    source.setTransmitPower(250);
+    source.setCarrierFrequency(8);
+    source.setAzimuthStart(0);
+    source.setAzimuthEnd(360);
+    source.setElevationStart(-90);
+    source.setElevationEnd(90);
+    source.setLongitude(kCenterLon - 3.0);
+    source.setLatitude(kCenterLat);
+    source.setAltitude(8000);
+    source.setIsStationary(false);
+    source.setMovementSpeed(250);
+    source.setMovementAzimuth(90);
+    const int sourceId = repository->addRadiationSource(source);
+    source.setRadiationId(sourceId);
+    ModelRepository::setInstance(repository);
+
+    const double simulationTime = 1200.0;
+    const int observationCount = state.range(0);
+    FDOAMultiStartOptions multiStart;
+    multiStart.threadCount = 1;
+    FDOAalgorithm algorithm;
+    bool ok = true;
+    while (state.keepRunning()) {
+        algorithm.init(deviceNames, source.getRadiationName(), "频差体制", simulationTime, observationCount);
+        algorithm.setMultiStartOptions(multiStart);
+        ok = algorithm.calculate() && ok;
+        bench::doNotOptimize(algorithm.getResult().position);
+    }
+    state.setItemsProcessed(state.iterations());
+
+    // 以真值评估：选取的观测时刻均可接收，且精度与按均匀时刻计算的不同
+    std::vector<ReconnaissanceDevice> devices;
+    for (int id : deviceIds) devices.push_back(repository->getReconnaissanceDeviceById(id));
+    const VisibilityTimeline timeline = computeVisibilityTimeline(devices, source, simulationTime);
+    const std::vector<double> nominal = FDOAalgorithm::observationEpochs(simulationTime, observationCount);
+    const std::vector<double>& epochs = algorithm.getObservationEpochs();
+    const bool allReceivable = !epochs.empty() &&
+        std::all_of(epochs.begin(), epochs.end(), [&](double t) { return timeline.isCommonlyReceivable(t); });
+
+    const COORD3 truth = lbh2xyz(source.getLongitude(), source.getLatitude(), source.getAltitude());
+    const COORD3 v = velocity_lbh2xyz(source.getLongitude(), source.getLatitude(), source.getMovementSpeed(),
+                                      source.getMovementAzimuth(), source.getMovementElevation());
+    const Vector3 velocity(v.p1, v.p2, v.p3);
+    const double selected = algorithm.calculateLocalizationAccuracy(deviceIds, sourceId, epochs, truth, velocity);
+    const double uniform = algorithm.calculateLocalizationAccuracy(deviceIds, sourceId, nominal, truth, velocity);
+    ModelRepository::setInstance(nullptr);
+
+    state.counters["first_epoch_s"] = epochs.empty() ? -1.0 : epochs.front();
+    state.counters["accuracy_selected"] = selected;
+    state.counters["accuracy_uniform"] = uniform;
+    if (!ok) state.skipWithError("频差定位解算失败");
+    if (!allReceivable || epochs == nominal) state.skipWithError("观测时刻没有按可见性时间线选取");
+    if (!std::isfinite(selected) || !(std::abs(selected - uniform) > 1e-3 * std::abs(uniform))) {
+        state.skipWithError("定位精度没有按实际观测时刻计算");
+    }
+}
+
+// ---干涉仪---
+
+// 不保存任务的内存数据源，避免基准循环中任务列表无限增长
+class DiscardingModelRepository : public InMemoryModelRepository {
+public:
+    bool addSinglePlatformTask(const SinglePlatformTask& task, int& taskId) override {
+        (void)task;
+        taskId = 1;
+        return true;
+    }
+};
+
+void BM_InterferometerSimulation(bench::State& state) {
+    ReconnaissanceDevice device;
+    device.setDeviceId(1);
+    device.setDeviceName("移动侦察车A");
+    device.setIsStationary(false);
+    device.setBaselineLength(3);
+    device.setNoisePsd(-174);
+    device.setSampleRate(20);
+    device.setFreqRangeMin(0.5f);
+    device.setFreqRangeMax(20);
+    device.setAngleAzimuthMin(0);
+    device.setAngleAzimuthMax(180);
+    device.setAngleElevationMin(-90);
+    device.setAngleElevationMax(90);
+    device.setMovementSpeed(10);
+    device.setMovementAzimuth(90);
+    device.setLongitude(60);
+    device.setLatitude(35);
+    device.setAltitude(100);
+
+    RadiationSource source;
+    source.setRadiationId(1);
+    source.setRadiationName("固定辐射源A");
+    source.setIsStationary(true);
+    source.setTransmitPower(3);
+    source.setScanPeriod(1);
+    source.setCarrierFrequency(8);
+    source.setAzimuthStart(0);
+    source.setAzimuthEnd(360);
+    source.setElevationStart(-30);
+    source.setElevationEnd(30);
+    source.setLongitude(63.434949);
+    source.setLatitude(35.264390);
+    source.setAltitude(1732.050808);
+
+    std::shared_ptr<DiscardingModelRepository> repository = std::make_shared<DiscardingModelRepository>();
+    repository->addReconnaissanceDevice(device);
+    repository->addRadiationSource(source);
+    ModelRepository::setInstance(repository);
+
+    const int simulationTime = state.range(0);
+    LocationResult result{};
+    while (state.keepRunning()) {
+        result = InterferometerPositioning::getInstance().runSimulation(device, source, simulationTime);
+        bench::doNotOptimize(result.longitude);
+    }
+
+    ModelRepository::setInstance(nullptr);
+    if (!std::isfinite(result.longitude) || !std::isfinite(result.latitude)) {
+        state.skipWithError("干涉仪定位结果无效");
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // 算法内部的过程日志会淹没基准输出，也会计入耗时
+    Log::setEnabled(false);
+
+    const std::pair<const char*, bench::BenchmarkFunction> geodesy[] = {
+        {"BM_Lbh2Xyz", BM_Lbh2Xyz},
+        {"BM_Xyz2Lbh", BM_Xyz2Lbh},
+        {"BM_Lbh2XyzBatch", BM_Lbh2XyzBatch},
+        {"BM_Xyz2LbhBatch", BM_Xyz2LbhBatch},
+    };
+    for (const auto& entry : geodesy) {
+        bench::registerBenchmark(entry.first, entry.second)->argNames({"points"})->arg(64)->arg(4096)->arg(262144);
+    }
+
+    // 4站三维解析解在近共面站阵下有两个根，三维求解从5站开始
+    struct TDOACase {
+        const char* name;
+        bench::BenchmarkFunction function;
+        std::vector<int> stations;
+    };
+    const TDOACase tdoa[] = {
+        {"BM_TDOAChanTaylor", BM_TDOAChanTaylor, {4, 6, 8}},
+        {"BM_TDOALocate3D", BM_TDOALocate3D, {5, 6, 8}},
+        {"BM_TDOALocateBatch", BM_TDOALocateBatch, {4, 6, 8}},
+    };
+    for (const TDOACase& entry : tdoa) {
+        bench::Benchmark* b = bench::registerBenchmark(entry.name, entry.function)->argNames({"stations", "samples"});
+        for (int stations : entry.stations) {
+            for (int samples : {64, 4096}) b->args({stations, samples});
+        }
+    }
+
+    bench::Benchmark* lm = bench::registerBenchmark("BM_FDOASolveLM", BM_FDOASolveLM)->argNames({"stations", "epochs"});
+    bench::Benchmark* ms = bench::registerBenchmark("BM_FDOASolveMultiStart", BM_FDOASolveMultiStart)
+                               ->argNames({"stations", "epochs", "starts"});
+    for (int stations : {3, 5, 8}) {
+        for (int epochs : {3, 11, 51}) lm->args({stations, epochs});
+        ms->args({stations, 11, 16});
+    }
+
+    bench::registerBenchmark("BM_IntersectDirections2D", BM_IntersectDirections2D)
+        ->argNames({"pairs"})->arg(64)->arg(4096);
+
+    bench::Benchmark* dfWls = bench::registerBenchmark("BM_DFLocateWLS", BM_DFLocateWLS)->argNames({"stations", "3d"});
+    for (int stations : {2, 8, 64, 512}) dfWls->args({stations, 0});
+    for (int stations : {3, 64, 512}) dfWls->args({stations, 1});
+
+    bench::registerBenchmark("BM_HyperbolaPoints", BM_HyperbolaPoints)
+        ->argNames({"stations"})->arg(3)->arg(4)->arg(8);
+
+    bench::registerBenchmark("BM_DFErrorCircle", BM_DFErrorCircle)
+        ->argNames({"samples", "threads", "sampling"})
+        ->args({100000, 1, 0})->args({10000, 1, 1})->args({100000, 1, 1})->args({100000, 0, 1});
+    bench::Benchmark* tdoaCircle = bench::registerBenchmark("BM_TDOAErrorCircle", BM_TDOAErrorCircle)
+                                       ->argNames({"stations", "samples", "threads"});
+    for (int stations : {4, 8}) {
+        tdoaCircle->args({stations, 10000, 1})->args({stations, 100000, 1})->args({stations, 100000, 0});
+    }
+
+    bench::registerBenchmark("BM_CoverageGrid", BM_CoverageGrid)
+        ->argNames({"size", "threads", "cached"})
+        ->args({256, 1, 0})->args({1000, 1, 0})->args({1000, 0, 0})->args({1000, 0, 1});
+
+    bench::registerBenchmark("BM_LinkBudgetScreening", BM_LinkBudgetScreening)
+        ->argNames({"devices", "sources", "threads"})
+        ->args({100, 100, 1})->args({1000, 1000, 1})->args({1000, 1000, 0});
+
+    bench::registerBenchmark("BM_VisibilityTimeline", BM_VisibilityTimeline)
+        ->argNames({"seconds", "skip"})
+        ->args({600, 0})->args({600, 1})->args({3600, 0})->args({3600, 1});
+    bench::registerBenchmark("BM_FDOAVisibleEpochs", BM_FDOAVisibleEpochs)
+        ->argNames({"epochs"})->arg(3)->arg(11);
+
+    bench::registerBenchmark("BM_InterferometerSimulation", BM_InterferometerSimulation)
+        ->argNames({"seconds"})->arg(10)->arg(100);
+
+    return bench::runBenchmarks(argc, argv);
+}
@@ -0,0 +1,76 @@
+/**
+ * @file SignalPipelineBenchmark.cpp
+ * @brief 流式IQ接收管线的吞吐量、内存占用与时延估计精度
+ *
+ * 以数据库中典型设备和辐射源参数(采样率20GHz、噪声-170dBm/Hz、载频8GHz、扫描周期1s)
+ * 生成带已知时延的双通道IQ数据，逐级增大观测样本数，
+ * 报告吞吐量(百万样本/秒)并校验：内存占用不随观测长度变化、GCC与相位斜率法均能恢复时延。
+ * 校验失败时返回非零值。
+ * 用法: signal_pipeline_benchmark [最大观测点数]
+ */
+
+#include "../utils/SignalPipeline.h"
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const double LIGHT_SPEED = 299792458.0;
+
+// 自由空间传播的接收功率(W)，各向同性天线
+double receivedPower(double transmitPowerKw, double frequencyHz, double distance) {
+    const double lambda = LIGHT_SPEED / frequencyHz;
+    const double loss = lambda / (4.0 * PI * distance);
+    return transmitPowerKw * 1000.0 * loss * loss;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::uint64_t maxSamples = argc > 1 ? static_cast<std::uint64_t>(std::atoll(argv[1])) : (1ULL << 24);
+
+    SignalPipelineConfig config;
+    config.signal.sampleRate = 20.0e9;
+    config.signal.carrierFrequency = 8.0e9;
+    config.signal.bandwidth = 2.0e9;
+    config.signal.noisePsd = -170.0;
+    config.signal.receivedPower = receivedPower(3.0, 8.0e9, 50.0e3);
+    config.signal.scanPeriod = 1.0;
+    config.signal.delay = 1.2345678e-6;   // 24691.356 个采样点
+    config.signal.seed = 20240620;
+
+    const double delaySamples = config.signal.delay * config.signal.sampleRate;
+    const double snr = 10.0 * std::log10(config.signal.receivedPower
+        / (std::pow(10.0, (config.signal.noisePsd - 30.0) / 10.0) * config.signal.sampleRate));
+    std::cout << "流式IQ接收管线 (采样率 20 GHz, 每样本信噪比 " << std::fixed << std::setprecision(1) << snr
+              << " dB, 真实时延 " << std::setprecision(3) << delaySamples << " 采样点)" << std::endl;
+    std::cout << std::setw(12) << "样本数" << std::setw(12) << "Msps" << std::setw(14) << "内存(MB)"
+              << std::setw(16) << "GCC偏差" << std::setw(16) << "相位斜率偏差" << std::endl;
+
+    bool ok = true;
+    std::size_t firstMemory = 0;
+    for (std::uint64_t samples = 1ULL << 20; samples <= maxSamples; samples *= 4) {
+        config.observationSamples = samples;
+        const SignalPipelineResult result = SignalPipeline::run(config);
+        const double gccError = result.gccDelay * config.signal.sampleRate - delaySamples;
+        const double phaseError = result.phaseDelay * config.signal.sampleRate - delaySamples;
+        std::cout << std::setw(12) << samples << std::setprecision(2) << std::setw(12) << result.throughputMsps
+                  << std::setw(14) << result.memoryBytes / 1048576.0
+                  << std::setprecision(4) << std::setw(16) << gccError
+                  << std::setw(16) << phaseError << std::endl;
+
+        if (firstMemory == 0) firstMemory = result.memoryBytes;
+        // 内存只取决于块大小、缓冲区块数和帧长
+        ok = ok && result.valid && result.samples == samples && result.memoryBytes == firstMemory;
+        // GCC利用全部带内频点；相位斜率法只用16个频点，精度约低一个量级
+        ok = ok && std::fabs(gccError) < 0.1 && std::fabs(phaseError) < 1.0;
+    }
+    std::cout << "(偏差单位: 采样点)" << std::endl;
+
+    std::cout << (ok ? "精度校验通过" : "精度校验失败") << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,335 @@
+/**
+ * @file TDOASolverBenchmark.cpp
+ * @brief TDOA定位核心(Chan初始解 + 泰勒迭代)的微基准测试
+ *
+ * 对比原 std::vector<std::vector<double>> 实现(legacy)与定长Eigen实现的每秒求解次数。
+ * 用法: tdoa_solver_benchmark [求解次数]
+ */
+
+#include "../models/TDOASolver.h"
+#include "../constants/PhysicsConstants.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 原实现的副本，仅用于性能对比
+namespace legacy {
+
+static double calculateDistance(const COORD3& p1, const COORD3& p2) {
+    return std::sqrt(std::pow(p1.p1 - p2.p1, 2) + 
+                     std::pow(p1.p2 - p2.p2, 2) + 
+                     std::pow(p1.p3 - p2.p3, 2));
+}
+
+std::vector<double> multiplyMatrixVector(const std::vector<std::vector<double>>& A, const std::vector<double>& B) {
+    size_t rowsA = A.size();
+    if (rowsA == 0) return {};
+    size_t colsA = A[0].size();
+    size_t sizeB = B.size();
+
+    if (colsA != sizeB) {
+        throw std::runtime_error("Matrix-vector multiplication dimension mismatch.");
+    }
+
+    std::vector<double> C(rowsA, 0.0);
+    for (size_t i = 0; i < rowsA; ++i) {
+        for (size_t j = 0; j < colsA; ++j) {
+            C[i] += A[i][j] * B[j];
+        }
+    }
+    return C;
+}
+
+std::vector<std::vector<double>> multiplyMatrixMatrix(const std::vector<std::vector<double>>& A, const std::vector<std::vector<double>>& B) {
+    size_t rowsA = A.size();
+    if (rowsA == 0) return {};
+    size_t colsA = A[0].size();
+    size_t rowsB = B.size();
+    if (rowsB == 0) return {};
+    size_t colsB = B[0].size();
+
+    if (colsA != rowsB) {
+        throw std::runtime_error("Matrix-matrix multiplication dimension mismatch.");
+    }
+
+    std::vector<std::vector<double>> C(rowsA, std::vector<double>(colsB, 0.0));
+    for (size_t i = 0; i < rowsA; ++i) {
+        for (size_t j = 0; j < colsB; ++j) {
+            for (size_t k = 0; k < colsA; ++k) {
+                C[i][j] += A[i][k] * B[k][j];
+            }
+        }
+    }
+    return C;
+}
+
+std::vector<std::vector<double>> transposeMatrix(const std::vector<std::vector<double>>& A) {
+    if (A.empty() || A[0].empty()) return {};
+    size_t rows = A.size();
+    size_t cols = A[0].size();
+    std::vector<std::vector<double>> T(cols, std::vector<double>(rows));
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            T[j][i] = A[i][j];
+        }
+    }
+    return T;
+}
+
+std::vector<double> solveLinearSystem(std::vector<std::vector<double>> A, std::vector<double> b) {
+    size_t n = A.size();
+    if (n == 0) return {};
+
+    for (size_t i = 0; i < n; i++) {
+        size_t max_row = i;
+        for (size_t k = i + 1; k < n; k++) {
+            if (std::abs(A[k][i]) > std::abs(A[max_row][i])) {
+                max_row = k;
+            }
+        }
+        std::swap(A[i], A[max_row]);
+        std::swap(b[i], b[max_row]);
+        
+        if (std::abs(A[i][i]) < 1e-12) {
+             throw std::runtime_error("Matrix is singular or nearly singular.");
+        }
+
+        for (size_t k = i + 1; k < n; k++) {
+            double factor = A[k][i] / A[i][i];
+            for (size_t j = i; j < n; j++) {
+                A[k][j] -= factor * A[i][j];
+            }
+            b[k] -= factor * b[i];
+        }
+    }
+
+    std::vector<double> x(n);
+    for (int i = n - 1; i >= 0; i--) {
+        double sum = 0;
+        for (size_t j = i + 1; j < n; j++) {
+            sum += A[i][j] * x[j];
+        }
+        x[i] = (b[i] - sum) / A[i][i];
+    }
+    return x;
+}
+
+// ---Chan算法（二维）---
+COORD3 tdoaLocate_chan_initial(const std::vector<COORD3>& stationPositions, 
+                              const std::vector<double>& tdoas, 
+                              double knownHeight) {
+    int N = stationPositions.size();
+    if (N < 4) return {0,0,knownHeight};
+
+    int M = N - 1; 
+    std::vector<std::vector<double>> Ga(M, std::vector<double>(3)); // 3列：x, y, R1
+    std::vector<double> h(M);
+
+    const double x1 = stationPositions[0].p1;
+    const double y1 = stationPositions[0].p2;
+    const double z1 = stationPositions[0].p3;
+    const double z0 = knownHeight;
+
+    // 计算参考站到目标的距离平方（基于高度）
+    double R1_sq = (x1*x1 + y1*y1 + (z0-z1)*(z0-z1));
+    
+    for (int i = 0; i < M; ++i) {
+        int station_idx = i + 1;
+        const double xi = stationPositions[station_idx].p1;
+        const double yi = stationPositions[station_idx].p2;
+        const double zi = stationPositions[station_idx].p3;
+        
+        const double d_i1 = Constants::c * tdoas[station_idx]; // 转换为距离差
+        
+        // 正确构建Ga矩阵
+        Ga[i][0] = 2 * (xi - x1);  // 修正：使用(xi - x1)而不是(x1 - xi)
+        Ga[i][1] = 2 * (yi - y1);  // 修正：使用(yi - y1)而不是(y1 - yi)
+        Ga[i][2] = -2 * d_i1;      // 修正：使用负值
+        
+        // 正确计算常数项
+        const double Ri_sq = (xi*xi + yi*yi + (z0-zi)*(z0-zi));
+        const double K_i = Ri_sq - R1_sq - d_i1*d_i1;
+        h[i] = K_i;
+    }
+    
+    try {
+        // 求解 Ga * [x; y; R1] = h
+        std::vector<std::vector<double>> Ga_T = transposeMatrix(Ga);
+        std::vector<std::vector<double>> GaT_Ga = multiplyMatrixMatrix(Ga_T, Ga);
+        std::vector<double> GaT_h = multiplyMatrixVector(Ga_T, h);
+        
+        // 添加正则化项增强稳定性
+        for (size_t i = 0; i < GaT_Ga.size(); ++i) {
+            GaT_Ga[i][i] += 1e-6;
+        }
+        
+        std::vector<double> solution = solveLinearSystem(GaT_Ga, GaT_h);
+        
+        if (solution.size() < 3) return {0,0,knownHeight};
+        
+        // 返回结果 (x, y, 已知高度)
+        return {solution[0], solution[1], knownHeight};
+
+    } catch (const std::runtime_error& e) {
+        return {0, 0, knownHeight};
+    }
+}
+
+// --- 泰勒级数迭代法（二维）---
+COORD3 tdoaRefinePosition_taylor(const std::vector<COORD3>& stationPositions, 
+                               const std::vector<double>& tdoas, 
+                               const COORD3& initialGuess) {
+    int N = stationPositions.size();
+    if (N < 4) return initialGuess;
+    
+    COORD3 currentPos = initialGuess;
+    const int max_iterations = 20;  // 增加最大迭代次数
+    const double tolerance = 1e-2;  // 降低收敛阈值（米）
+    int M = N - 1;
+
+    for(int iter = 0; iter < max_iterations; ++iter) {
+        std::vector<std::vector<double>> H(M, std::vector<double>(2)); // 二维雅可比矩阵
+        std::vector<double> delta_rho(M);
+
+        double R1 = calculateDistance(currentPos, stationPositions[0]);
+        if (R1 < 1e-6) R1 = 1e-6;
+
+        for (int i = 0; i < M; ++i) {
+            int station_idx = i + 1;
+            double Ri = calculateDistance(currentPos, stationPositions[station_idx]);
+            if (Ri < 1e-6) Ri = 1e-6;
+            
+            // 二维雅可比矩阵 (只计算x和y方向)
+            H[i][0] = (currentPos.p1 - stationPositions[station_idx].p1) / Ri - 
+                      (currentPos.p1 - stationPositions[0].p1) / R1;
+            H[i][1] = (currentPos.p2 - stationPositions[station_idx].p2) / Ri - 
+                      (currentPos.p2 - stationPositions[0].p2) / R1;
+
+            double estimated_tdoa = (Ri - R1) / Constants::c;
+            delta_rho[i] = tdoas[station_idx] - estimated_tdoa;
+        }
+
+        try {
+            std::vector<std::vector<double>> H_T = transposeMatrix(H);
+            std::vector<std::vector<double>> HT_H = multiplyMatrixMatrix(H_T, H);
+            std::vector<double> HT_delta_rho = multiplyMatrixVector(H_T, delta_rho);
+
+            // 将残差从秒转换为米
+            for(double& val : HT_delta_rho) {
+                val *= Constants::c;
+            }
+
+            // 添加正则化项
+            for (size_t i = 0; i < HT_H.size(); ++i) {
+                HT_H[i][i] += 1e-6;
+            }
+
+            std::vector<double> correction = solveLinearSystem(HT_H, HT_delta_rho);
+            
+            if (correction.size() < 2) {
+                throw std::runtime_error("修正向量维度不足");
+            }
+
+            // 只更新x和y坐标
+            currentPos.p1 += correction[0];
+            currentPos.p2 += correction[1];
+            
+            // 检查收敛性
+            double correction_norm = std::sqrt(correction[0]*correction[0] + correction[1]*correction[1]);
+            if (correction_norm < tolerance) {
+                 return currentPos;
+            }
+
+        } catch (const std::runtime_error& e) {
+            std::string msg = "泰勒迭代失败(迭代步 " + std::to_string(iter) + "): " + e.what();
+            throw std::runtime_error(msg);
+        }
+    }
+    
+    return currentPos;
+}
+
+} // namespace legacy
+
+namespace {
+
+// 防止编译器把结果优化掉
+volatile double g_sink = 0.0;
+
+struct Scenario {
+    std::vector<COORD3> stations;
+    std::vector<double> tdoas;
+    COORD3 source;
+};
+
+// 构造一个4站布局和对应的理想时差
+Scenario makeScenario() {
+    Scenario s;
+    s.stations = {
+        lbh2xyz(116.00, 39.00, 50.0),
+        lbh2xyz(116.40, 39.05, 80.0),
+        lbh2xyz(116.10, 39.40, 120.0),
+        lbh2xyz(116.50, 39.45, 60.0),
+        lbh2xyz(116.25, 38.80, 30.0),
+    };
+    s.source = lbh2xyz(116.30, 39.20, 1000.0);
+    s.tdoas.assign(s.stations.size(), 0.0);
+    const double r0 = legacy::calculateDistance(s.stations[0], s.source);
+    for (size_t i = 1; i < s.stations.size(); ++i) {
+        s.tdoas[i] = (legacy::calculateDistance(s.stations[i], s.source) - r0) / Constants::c;
+    }
+    return s;
+}
+
+template <typename Solve>
+double runBenchmark(const char* name, const Scenario& s, long iterations, Solve solve) {
+    // 预热
+    for (long i = 0; i < iterations / 10 + 1; ++i) {
+        g_sink = g_sink + solve().p1;
+    }
+    COORD3 last;
+    const auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i) {
+        last = solve();
+        g_sink = g_sink + last.p1;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double rate = iterations / seconds;
+    const double dx = last.p1 - s.source.p1, dy = last.p2 - s.source.p2, dz = last.p3 - s.source.p3;
+    std::cout << std::left << std::setw(10) << name
+              << std::right << std::fixed << std::setprecision(0) << std::setw(14) << rate << " 次/秒"
+              << std::setprecision(3) << std::setw(12) << seconds * 1e9 / iterations << " ns/次"
+              << "  误差 " << std::setprecision(3) << std::sqrt(dx * dx + dy * dy + dz * dz) << " m" << std::endl;
+    return rate;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const long iterations = argc > 1 ? std::atol(argv[1]) : 200000;
+    const Scenario s = makeScenario();
+
+    std::cout << "TDOA定位核心微基准 (" << s.stations.size() << " 站, " << iterations << " 次求解)" << std::endl;
+
+    const double before = runBenchmark("legacy", s, iterations, [&]() {
+        COORD3 guess = legacy::tdoaLocate_chan_initial(s.stations, s.tdoas, s.source.p3);
+        return legacy::tdoaRefinePosition_taylor(s.stations, s.tdoas, guess);
+    });
+    const double after = runBenchmark("eigen", s, iterations, [&]() {
+        COORD3 guess = tdoaLocate_chan_initial(s.stations, s.tdoas, s.source.p3);
+        return tdoaRefinePosition_taylor(s.stations, s.tdoas, guess);
+    });
+
+    std::cout << "加速比: " << std::setprecision(2) << after / before << "x" << std::endl;
+
+    // 三维Chan两步WLS + 高斯-牛顿（不固定高度，含协方差和GDOP）
+    runBenchmark("chan3d", s, iterations, [&]() {
+        return tdoaLocate3D(s.stations, s.tdoas, 1e-8).position;
+    });
+    return 0;
+}
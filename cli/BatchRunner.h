@@ -0,0 +1,73 @@
+#pragma once
+
+#include "BatchScenario.h"
+#include "ColumnTable.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief 单次仿真的结果，不适用的数值为 NaN
+ */
+struct BatchRunResult {
+    std::string scenario;                    // 场景名称
+    int run = 0;                             // 重复序号(从0开始)
+    BatchSystem system = BatchSystem::TDOA;  // 技术体制
+    bool success = false;                    // 算法是否成功给出结果
+    double longitude;                        // 定位经度（度）
+    double latitude;                         // 定位纬度（度）
+    double altitude;                         // 定位高度（米）
+    double azimuth;                          // 方位角（度）
+    double elevation;                        // 俯仰角（度）
+    double accuracy;                         // 算法给出的定位精度/误差
+    double cep;                              // 圆概率误差（米），时差体制
+    double gdop;                             // 几何精度因子，时差体制
+    double positionError;                    // 定位结果与辐射源真实位置的距离（米）
+    int iterations = 0;                      // 迭代次数，频差体制
+    double elapsedMs = 0.0;                  // 单次仿真耗时（毫秒）
+    std::string message;                     // 失败原因或附加信息
+
+    BatchRunResult();
+};
+
+/**
+ * @brief 无界面批量仿真执行器
+ *
+ * 每个场景按 repeat 展开为多次独立仿真，全部仿真通过 parallelFor 分配到多个线程；
+ * 每次仿真使用独立的算法实例，结果按场景和重复序号的顺序返回，与线程数无关。
+ */
+class BatchRunner {
+public:
+    /**
+     * @param threadCount 线程数，0 表示使用全部硬件线程
+     * @param showProgress 是否在标准错误输出进度
+     */
+    explicit BatchRunner(unsigned int threadCount = 0, bool showProgress = true);
+
+    /**
+     * @brief 是否在解算前做链路预算筛查(默认开启)
+     *
+     * 开启时多平台场景涉及的全部设备和辐射源先用 validateLinkBudgetBatch 一次筛查；
+     * 设备和辐射源都固定、且有设备不能接收辐射源信号的场景不再解算，失败原因写入 message。
+     */
+    void setLinkBudgetScreening(bool enabled);
+
+    /**
+     * @brief 执行全部场景
+     */
+    std::vector<BatchRunResult> run(const std::vector<BatchScenario>& scenarios) const;
+
+    /**
+     * @brief 执行单次仿真
+     */
+    static BatchRunResult runOne(const BatchScenario& scenario, int runIndex);
+
+    /**
+     * @brief 把结果整理为列式表
+     */
+    static ColumnTable toTable(const std::vector<BatchRunResult>& results);
+
+private:
+    unsigned int m_threadCount;
+    bool m_showProgress;
+    bool m_screen;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief 无界面批量仿真的技术体制
+ */
+enum class BatchSystem {
+    TDOA,            // 多平台时差体制
+    FDOA,            // 多平台频差体制
+    DF,              // 多平台测向交叉定位
+    Interferometer,  // 单平台干涉仪体制
+    SinglePlatformTDOA  // 单平台时差体制
+};
+
+/**
+ * @brief 批量仿真场景
+ *
+ * 设备和辐射源按名称引用数据库中的模型，与界面上的选择方式一致。
+ */
+struct BatchScenario {
+    std::string name;                       // 场景名称，写入结果的 scenario 列
+    BatchSystem system = BatchSystem::TDOA; // 技术体制
+    std::vector<std::string> deviceNames;   // 侦察设备名称，单平台体制只使用第一个
+    std::string sourceName;                 // 辐射源名称
+    double simulationTime = 10.0;           // 仿真时间（秒）
+    int repeat = 1;                         // 重复次数（蒙特卡洛次数）
+    double tdoaRmsError = 0.0;              // 时差体制：TDOA均方根误差（秒）
+    double esmToaError = 0.0;               // 时差体制：ESM TOA误差（秒）
+    double dfMeanError[2] = {0.0, 0.0};     // 测向体制：两站测向均值误差（度）
+    double dfStdDev[2] = {0.0, 0.0};        // 测向体制：两站测向标准差（度）
+    int observationCount = 3;               // 频差体制：观测时刻数
+    int multiStartCount = 16;               // 频差体制：多起点求解的起点数
+};
+
+/**
+ * @brief 技术体制名称，写入结果的 system 列
+ */
+const char* batchSystemName(BatchSystem system);
+
+/**
+ * @brief 解析技术体制，支持英文名(TDOA/FDOA/DF/INTERFEROMETER/SP_TDOA)和界面上的中文名
+ */
+bool parseBatchSystem(const std::string& text, BatchSystem& system);
+
+/**
+ * @brief 读取场景文件
+ *
+ * 每行一个场景，字段为空白分隔的 key=value，# 开头的行为注释：
+ *   name=t1 system=TDOA devices=站1,站2,站3,站4 source=雷达1 time=10 repeat=100 tdoa_rms=1e-8 esm_toa=5e-8
+ * 支持的字段：name system devices source time repeat tdoa_rms esm_toa
+ * df_mean1 df_std1 df_mean2 df_std2 epochs starts。
+ * @param path 场景文件路径
+ * @param scenarios 输出场景列表
+ * @param error 失败时的错误信息(含行号)
+ * @return 读取并校验成功返回 true
+ */
+bool loadBatchScenarios(const std::string& path, std::vector<BatchScenario>& scenarios, std::string& error);
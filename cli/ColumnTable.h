@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 按列存储的结果表，可写出CSV或列式二进制文件
+ *
+ * 列式文件(.plcol)布局，整数均为小端：
+ *   8字节魔数 "PLCOL001"，uint64 行数，uint32 列数
+ *   每列的表头：uint32 名称长度 + UTF-8名称，uint8 类型(0=float64, 1=int64, 2=string)
+ *   随后按列顺序存放数据块：
+ *     float64/int64 列为连续的 行数×8 字节；
+ *     string 列为 (行数+1) 个 uint64 偏移，后接全部字符串字节。
+ * 读取方可以只映射需要的列，适合离线分析大批量仿真结果。
+ */
+class ColumnTable {
+public:
+    enum class Type : std::uint8_t { Float64 = 0, Int64 = 1, String = 2 };
+
+    void addColumn(const std::string& name, std::vector<double> values);
+    void addColumn(const std::string& name, std::vector<std::int64_t> values);
+    void addColumn(const std::string& name, std::vector<std::string> values);
+
+    // 行数(取第一列的长度，各列长度应一致)
+    std::size_t rowCount() const;
+    std::size_t columnCount() const { return m_columns.size(); }
+
+    /**
+     * @brief 写出CSV，NaN写为空字段，字符串按需加引号
+     */
+    bool writeCsv(const std::string& path) const;
+
+    /**
+     * @brief 写出列式二进制文件
+     */
+    bool writeColumnar(const std::string& path) const;
+
+private:
+    struct Column {
+        std::string name;
+        Type type;
+        std::vector<double> doubles;
+        std::vector<std::int64_t> integers;
+        std::vector<std::string> strings;
+    };
+
+    std::vector<Column> m_columns;
+};
@@ -0,0 +1,386 @@
+#include "../BatchRunner.h"
+#include "../../constants/PhysicsConstants.h"
+#include "../../models/TDOAalgorithm.h"
+#include "../../models/FDOAalgorithm.h"
+#include "../../models/DirectionFinding.h"
+#include "../../models/InterferometerPositioning.h"
+#include "../../models/SinglePlatformTDOA.h"
+#include "../../models/ModelRepository.h"
+#include "../../models/Trajectory.h"
+#include "../../utils/CoordinateTransform.h"
+#include "../../utils/LinkBudgetValidator.h"
+#include "../../utils/ParallelFor.h"
+#include "../../utils/RandomStream.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+const double NOT_AVAILABLE = std::numeric_limits<double>::quiet_NaN();
+
+// 估计位置(大地坐标)与辐射源在 t 时刻真实位置的距离
+double distanceToSource(double longitude, double latitude, double altitude, const RadiationSource& source,
+                        double t = 0.0) {
+    const COORD3 estimated = lbh2xyz(longitude, latitude, altitude);
+    const COORD3 truth = Trajectory::fromSource(source, t).positionXyzAt(t);
+    const double dx = estimated.p1 - truth.p1;
+    const double dy = estimated.p2 - truth.p2;
+    const double dz = estimated.p3 - truth.p3;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+void runTDOA(const BatchScenario& scenario, const RadiationSource& source, BatchRunResult& result) {
+    TDOAalgorithm algorithm;
+    algorithm.init(scenario.deviceNames, scenario.sourceName, "时差体制", scenario.simulationTime,
+                   scenario.tdoaRmsError, scenario.esmToaError);
+    algorithm.setErrorParams(scenario.tdoaRmsError, scenario.esmToaError);
+    if (!algorithm.calculate()) {
+        result.message = "时差定位解算失败";
+        return;
+    }
+    const TDOAalgorithm::LocationResult location = algorithm.getResult();
+    result.success = true;
+    result.longitude = location.longitude;
+    result.latitude = location.latitude;
+    result.altitude = location.altitude;
+    result.azimuth = location.azimuth;
+    result.elevation = location.elevation;
+    result.accuracy = location.accuracy;
+    result.cep = location.cep;
+    result.gdop = location.gdop;
+    // 初始时刻不可接收时，时差在第一个可接收时刻测量
+    result.positionError = distanceToSource(location.longitude, location.latitude, location.altitude, source,
+                                            algorithm.getObservationEpoch());
+}
+
+void runFDOA(const BatchScenario& scenario, const RadiationSource& source, BatchRunResult& result) {
+    FDOAalgorithm algorithm;
+    algorithm.init(scenario.deviceNames, scenario.sourceName, "频差体制", scenario.simulationTime,
+                   scenario.observationCount);
+    // 批量仿真已经按场景并行，多起点求解在本线程内串行执行
+    FDOAMultiStartOptions multiStart;
+    multiStart.startCount = scenario.multiStartCount;
+    multiStart.threadCount = 1;
+    algorithm.setMultiStartOptions(multiStart);
+    if (!algorithm.calculate()) {
+        result.message = "频差定位解算失败";
+        return;
+    }
+    const FDOAalgorithm::SourcePositionResult location = algorithm.getResult();
+    const COORD3 lbh = xyz2lbh(location.position.p1, location.position.p2, location.position.p3);
+
+    std::vector<int> deviceIds;
+    ReconnaissanceDevice device;
+    for (const std::string& name : scenario.deviceNames) {
+        if (ModelRepository::getInstance().findReconnaissanceDeviceByName(name, device)) {
+            deviceIds.push_back(device.getDeviceId());
+        }
+    }
+
+    result.success = location.converged;
+    result.longitude = lbh.p1;
+    result.latitude = lbh.p2;
+    result.altitude = lbh.p3;
+    // 精度按解算实际使用的观测时刻计算
+    result.accuracy = algorithm.calculateLocalizationAccuracy(deviceIds, source.getRadiationId(),
+                                                              algorithm.getObservationEpochs(),
+                                                              location.position, location.velocity);
+    result.positionError = distanceToSource(lbh.p1, lbh.p2, lbh.p3, source);
+    result.iterations = location.iterations;
+    result.message = "收敛起点 " + std::to_string(location.convergedStarts) + "/" + std::to_string(location.startCount);
+}
+
+void runDF(const BatchScenario& scenario, const RadiationSource& source, BatchRunResult& result) {
+    DirectionFinding algorithm;
+    algorithm.init(scenario.deviceNames, scenario.sourceName, scenario.simulationTime);
+    if (!algorithm.calculate(scenario.dfMeanError[0], scenario.dfStdDev[0],
+                             scenario.dfMeanError[1], scenario.dfStdDev[1])) {
+        result.message = "测向交叉定位解算失败";
+        return;
+    }
+    const DirectionFinding::Result location = algorithm.getResult();
+    result.success = true;
+    result.longitude = location.position.p1;
+    result.latitude = location.position.p2;
+    result.altitude = location.position.p3;
+    result.accuracy = location.error;
+    result.positionError = distanceToSource(location.position.p1, location.position.p2, location.position.p3, source);
+}
+
+// 单平台体制：侦察设备须为移动设备，辐射源须为固定辐射源
+void runSinglePlatform(const BatchScenario& scenario, const RadiationSource& source, BatchRunResult& result) {
+    ReconnaissanceDevice device;
+    if (!ModelRepository::getInstance().findReconnaissanceDeviceByName(scenario.deviceNames.front(), device)) {
+        result.message = "未找到侦察设备 '" + scenario.deviceNames.front() + "'";
+        return;
+    }
+    if (device.getIsStationary() || !source.getIsStationary()) {
+        result.message = "单平台仿真要求移动侦察设备和固定辐射源";
+        return;
+    }
+
+    const int simulationTime = static_cast<int>(scenario.simulationTime);
+    const LocationResult location = scenario.system == BatchSystem::Interferometer
+        ? InterferometerPositioning::getInstance().runSimulation(device, source, simulationTime)
+        : SinglePlatformTDOA::getInstance().runSimulation(device, source, simulationTime);
+    result.success = true;
+    result.longitude = location.longitude;
+    result.latitude = location.latitude;
+    result.altitude = location.altitude;
+    result.azimuth = location.azimuth;
+    result.elevation = location.elevation;
+    result.accuracy = location.accuracy;
+    result.positionError = distanceToSource(location.longitude, location.latitude, location.altitude, source);
+}
+
+// 在名称表中登记模型，返回其在列表中的序号
+template <typename Model>
+std::size_t registerModel(const std::string& name, const Model& model,
+                          std::map<std::string, std::size_t>& index, std::vector<Model>& models) {
+    const auto inserted = index.emplace(name, models.size());
+    if (inserted.second) models.push_back(model);
+    return inserted.first->second;
+}
+
+/**
+ * 多平台场景的链路预算筛查：全部场景涉及的设备和辐射源只做一次 validateLinkBudgetBatch。
+ * 只有设备和辐射源都固定时，初始时刻的判定才对整个仿真时段成立，含移动平台的场景不在此判定。
+ * 信噪比按场景内设备频率范围交集的带宽折算，与 SimulationValidator::validateAll 相同。
+ * 返回每个场景的失败原因，可接收或未参与筛查的场景为空字符串。
+ */
+std::vector<std::string> screenScenarios(const std::vector<BatchScenario>& scenarios, unsigned int threadCount) {
+    ModelRepository& repository = ModelRepository::getInstance();
+    std::vector<std::string> reasons(scenarios.size());
+    std::vector<ReconnaissanceDevice> devices;
+    std::vector<RadiationSource> sources;
+    std::map<std::string, std::size_t> deviceIndex, sourceIndex;
+
+    struct ScreenedScenario {
+        std::size_t scenario;
+        std::size_t source;
+        std::vector<std::size_t> devices;
+    };
+    std::vector<ScreenedScenario> screened;
+
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        const BatchScenario& scenario = scenarios[i];
+        if (scenario.system != BatchSystem::TDOA && scenario.system != BatchSystem::FDOA &&
+            scenario.system != BatchSystem::DF) {
+            continue;
+        }
+        RadiationSource source;
+        if (!repository.findRadiationSourceByName(scenario.sourceName, source) || !source.getIsStationary()) {
+            continue;
+        }
+        std::vector<ReconnaissanceDevice> scenarioDevices;
+        ReconnaissanceDevice device;
+        for (const std::string& name : scenario.deviceNames) {
+            if (!repository.findReconnaissanceDeviceByName(name, device) || !device.getIsStationary()) break;
+            scenarioDevices.push_back(device);
+        }
+        if (scenarioDevices.size() != scenario.deviceNames.size()) continue;
+
+        ScreenedScenario entry;
+        entry.scenario = i;
+        entry.source = registerModel(scenario.sourceName, source, sourceIndex, sources);
+        for (std::size_t d = 0; d < scenarioDevices.size(); ++d) {
+            entry.devices.push_back(registerModel(scenario.deviceNames[d], scenarioDevices[d], deviceIndex, devices));
+        }
+        screened.push_back(std::move(entry));
+    }
+    if (screened.empty()) return reasons;
+
+    // 各设备按自身频率范围宽度计算，场景内再按公共带宽折算
+    LinkBudgetOptions options;
+    options.threadCount = threadCount;
+    const LinkBudgetMatrix matrix = validateLinkBudgetBatch(devices, sources, options);
+
+    for (const ScreenedScenario& entry : screened) {
+        const RadiationSource& source = sources[entry.source];
+        double commonMin = -std::numeric_limits<double>::infinity();
+        double commonMax = std::numeric_limits<double>::infinity();
+        for (std::size_t d : entry.devices) {
+            commonMin = std::max(commonMin, static_cast<double>(devices[d].getFreqRangeMin()));
+            commonMax = std::min(commonMax, static_cast<double>(devices[d].getFreqRangeMax()));
+        }
+        const double commonBandwidth = commonMax - commonMin;
+
+        if (commonBandwidth < 0.0) {
+            reasons[entry.scenario] = "链路预算筛查：侦察设备的频率范围没有交集";
+            continue;
+        }
+        for (std::size_t k = 0; k < entry.devices.size(); ++k) {
+            const ReconnaissanceDevice& device = devices[entry.devices[k]];
+            const std::size_t cell = matrix.index(entry.source, entry.devices[k]);
+            const double ownBandwidth = device.getFreqRangeMax() - device.getFreqRangeMin();
+            // 带宽变窄时噪声功率按比例下降；公共带宽为0时信噪比视为无穷大
+            const double snr = commonBandwidth > 0.0
+                ? matrix.snrDb[cell] + 10.0 * std::log10(ownBandwidth / commonBandwidth)
+                : std::numeric_limits<double>::infinity();
+            std::stringstream ss;
+            if (!matrix.inBand[cell]) {
+                ss << "链路预算筛查：侦察设备 " << device.getDeviceName() << "的接收频率范围不包含辐射源 "
+                   << source.getRadiationName() << "的频率 " << source.getCarrierFrequency() << " GHz";
+            } else if (!matrix.visible[cell]) {
+                ss << "链路预算筛查：侦察设备 " << device.getDeviceName() << "与辐射源 "
+                   << source.getRadiationName() << "的侦收扇区或工作扇区不能互相覆盖";
+            } else if (snr < Constants::SNR_THRESHOLD) {
+                ss << "链路预算筛查：侦察设备 " << device.getDeviceName() << "接收辐射源 "
+                   << source.getRadiationName() << "的信噪比为 " << snr << " dB，低于阈值 "
+                   << Constants::SNR_THRESHOLD << " dB";
+            }
+            if (ss.tellp() > 0) {
+                reasons[entry.scenario] = ss.str();
+                break;
+            }
+        }
+    }
+    return reasons;
+}
+
+} // namespace
+
+BatchRunResult::BatchRunResult()
+    : longitude(NOT_AVAILABLE), latitude(NOT_AVAILABLE), altitude(NOT_AVAILABLE),
+      azimuth(NOT_AVAILABLE), elevation(NOT_AVAILABLE), accuracy(NOT_AVAILABLE),
+      cep(NOT_AVAILABLE), gdop(NOT_AVAILABLE), positionError(NOT_AVAILABLE) {}
+
+BatchRunner::BatchRunner(unsigned int threadCount, bool showProgress)
+    : m_threadCount(threadCount), m_showProgress(showProgress), m_screen(true) {}
+
+void BatchRunner::setLinkBudgetScreening(bool enabled) {
+    m_screen = enabled;
+}
+
+BatchRunResult BatchRunner::runOne(const BatchScenario& scenario, int runIndex) {
+    BatchRunResult result;
+    result.scenario = scenario.name;
+    result.run = runIndex;
+    result.system = scenario.system;
+
+    const auto start = std::chrono::steady_clock::now();
+    RadiationSource source;
+    if (!ModelRepository::getInstance().findRadiationSourceByName(scenario.sourceName, source)) {
+        result.message = "未找到辐射源 '" + scenario.sourceName + "'";
+    } else {
+        try {
+            switch (scenario.system) {
+                case BatchSystem::TDOA: runTDOA(scenario, source, result); break;
+                case BatchSystem::FDOA: runFDOA(scenario, source, result); break;
+                case BatchSystem::DF: runDF(scenario, source, result); break;
+                case BatchSystem::Interferometer:
+                case BatchSystem::SinglePlatformTDOA: runSinglePlatform(scenario, source, result); break;
+            }
+        } catch (const std::exception& e) {
+            result.success = false;
+            result.message = e.what();
+        }
+    }
+    result.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+std::vector<BatchRunResult> BatchRunner::run(const std::vector<BatchScenario>& scenarios) const {
+    // 按重复次数展开为 (场景, 重复序号)
+    std::vector<std::pair<std::size_t, int>> tasks;
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        for (int r = 0; r < scenarios[i].repeat; ++r) {
+            tasks.emplace_back(i, r);
+        }
+    }
+
+    const std::vector<std::string> screenFailures = m_screen
+        ? screenScenarios(scenarios, m_threadCount) : std::vector<std::string>(scenarios.size());
+    if (m_showProgress) {
+        const std::size_t rejected = std::count_if(screenFailures.begin(), screenFailures.end(),
+                                                   [](const std::string& reason) { return !reason.empty(); });
+        if (rejected > 0) {
+            std::cerr << "[batch] 链路预算筛查：" << rejected << " 个场景的侦察设备不能接收辐射源信号，不再解算"
+                      << std::endl;
+        }
+    }
+
+    std::vector<BatchRunResult> results(tasks.size());
+    std::atomic<std::size_t> finished(0);
+    std::mutex progressMutex;
+    const std::size_t reportEvery = std::max<std::size_t>(1, tasks.size() / 100);
+
+    parallelFor(tasks.size(), m_threadCount, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            // 随机流以展开后的仿真序号为任务编号，结果与线程数和调度顺序无关
+            RandomService::JobScope randomScope(i);
+            const BatchScenario& scenario = scenarios[tasks[i].first];
+            const std::string& screenFailure = screenFailures[tasks[i].first];
+            if (screenFailure.empty()) {
+                results[i] = runOne(scenario, tasks[i].second);
+            } else {
+                results[i].scenario = scenario.name;
+                results[i].run = tasks[i].second;
+                results[i].system = scenario.system;
+                results[i].message = screenFailure;
+            }
+            const std::size_t done = finished.fetch_add(1) + 1;
+            if (m_showProgress && (done % reportEvery == 0 || done == tasks.size())) {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                std::cerr << "[batch] 已完成 " << done << "/" << tasks.size() << std::endl;
+            }
+        }
+    });
+    return results;
+}
+
+ColumnTable BatchRunner::toTable(const std::vector<BatchRunResult>& results) {
+    const std::size_t n = results.size();
+    std::vector<std::string> scenario(n), system(n), message(n);
+    std::vector<std::int64_t> run(n), success(n), iterations(n);
+    std::vector<double> longitude(n), latitude(n), altitude(n), azimuth(n), elevation(n);
+    std::vector<double> accuracy(n), cep(n), gdop(n), positionError(n), elapsedMs(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const BatchRunResult& r = results[i];
+        scenario[i] = r.scenario;
+        run[i] = r.run;
+        system[i] = batchSystemName(r.system);
+        success[i] = r.success ? 1 : 0;
+        longitude[i] = r.longitude;
+        latitude[i] = r.latitude;
+        altitude[i] = r.altitude;
+        azimuth[i] = r.azimuth;
+        elevation[i] = r.elevation;
+        accuracy[i] = r.accuracy;
+        cep[i] = r.cep;
+        gdop[i] = r.gdop;
+        positionError[i] = r.positionError;
+        iterations[i] = r.iterations;
+        elapsedMs[i] = r.elapsedMs;
+        message[i] = r.message;
+    }
+
+    ColumnTable table;
+    table.addColumn("scenario", std::move(scenario));
+    table.addColumn("run", std::move(run));
+    table.addColumn("system", std::move(system));
+    table.addColumn("success", std::move(success));
+    table.addColumn("longitude", std::move(longitude));
+    table.addColumn("latitude", std::move(latitude));
+    table.addColumn("altitude", std::move(altitude));
+    table.addColumn("azimuth", std::move(azimuth));
+    table.addColumn("elevation", std::move(elevation));
+    table.addColumn("accuracy", std::move(accuracy));
+    table.addColumn("cep_m", std::move(cep));
+    table.addColumn("gdop", std::move(gdop));
+    table.addColumn("position_error_m", std::move(positionError));
+    table.addColumn("iterations", std::move(iterations));
+    table.addColumn("elapsed_ms", std::move(elapsedMs));
+    table.addColumn("message", std::move(message));
+    return table;
+}
@@ -0,0 +1,138 @@
+#include "../BatchScenario.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// 按分隔符拆分，忽略空项
+std::vector<std::string> split(const std::string& text, char separator) {
+    std::vector<std::string> parts;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, separator)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return end != text.c_str() && *end == '\0';
+}
+
+bool parseInt(const std::string& text, int& value) {
+    char* end = nullptr;
+    const long parsed = std::strtol(text.c_str(), &end, 10);
+    if (end == text.c_str() || *end != '\0') return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// 设置单个字段，未知字段或取值非法时返回 false
+bool setField(BatchScenario& scenario, const std::string& key, const std::string& value) {
+    if (key == "name") { scenario.name = value; return true; }
+    if (key == "system") return parseBatchSystem(value, scenario.system);
+    if (key == "devices") { scenario.deviceNames = split(value, ','); return true; }
+    if (key == "source") { scenario.sourceName = value; return true; }
+    if (key == "time") return parseDouble(value, scenario.simulationTime);
+    if (key == "repeat") return parseInt(value, scenario.repeat);
+    if (key == "tdoa_rms") return parseDouble(value, scenario.tdoaRmsError);
+    if (key == "esm_toa") return parseDouble(value, scenario.esmToaError);
+    if (key == "df_mean1") return parseDouble(value, scenario.dfMeanError[0]);
+    if (key == "df_std1") return parseDouble(value, scenario.dfStdDev[0]);
+    if (key == "df_mean2") return parseDouble(value, scenario.dfMeanError[1]);
+    if (key == "df_std2") return parseDouble(value, scenario.dfStdDev[1]);
+    if (key == "epochs") return parseInt(value, scenario.observationCount);
+    if (key == "starts") return parseInt(value, scenario.multiStartCount);
+    return false;
+}
+
+// 各技术体制需要的设备数，与界面上的限制一致
+bool validate(const BatchScenario& scenario, std::string& error) {
+    std::size_t required = 1;
+    switch (scenario.system) {
+        case BatchSystem::TDOA: required = 4; break;
+        case BatchSystem::FDOA: required = 3; break;
+        case BatchSystem::DF: required = 2; break;
+        default: required = 1; break;
+    }
+    if (scenario.deviceNames.size() < required) {
+        error = std::string(batchSystemName(scenario.system)) + " 需要至少 " + std::to_string(required) + " 个侦察设备";
+        return false;
+    }
+    if (scenario.sourceName.empty()) {
+        error = "缺少辐射源(source)";
+        return false;
+    }
+    if (scenario.simulationTime <= 0.0 || scenario.repeat < 1) {
+        error = "仿真时间必须为正数，重复次数至少为1";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+const char* batchSystemName(BatchSystem system) {
+    switch (system) {
+        case BatchSystem::TDOA: return "TDOA";
+        case BatchSystem::FDOA: return "FDOA";
+        case BatchSystem::DF: return "DF";
+        case BatchSystem::Interferometer: return "INTERFEROMETER";
+        case BatchSystem::SinglePlatformTDOA: return "SP_TDOA";
+    }
+    return "UNKNOWN";
+}
+
+bool parseBatchSystem(const std::string& text, BatchSystem& system) {
+    if (text == "TDOA" || text == "时差体制") system = BatchSystem::TDOA;
+    else if (text == "FDOA" || text == "频差体制") system = BatchSystem::FDOA;
+    else if (text == "DF" || text == "测向体制") system = BatchSystem::DF;
+    else if (text == "INTERFEROMETER" || text == "干涉仪体制") system = BatchSystem::Interferometer;
+    else if (text == "SP_TDOA" || text == "单平台时差体制") system = BatchSystem::SinglePlatformTDOA;
+    else return false;
+    return true;
+}
+
+bool loadBatchScenarios(const std::string& path, std::vector<BatchScenario>& scenarios, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "无法打开场景文件: " + path;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        const std::size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        BatchScenario scenario;
+        scenario.name = "scenario" + std::to_string(scenarios.size() + 1);
+        std::istringstream fields(line);
+        std::string field;
+        while (fields >> field) {
+            const std::size_t eq = field.find('=');
+            if (eq == std::string::npos || !setField(scenario, field.substr(0, eq), field.substr(eq + 1))) {
+                error = path + ":" + std::to_string(lineNumber) + ": 无法解析字段 '" + field + "'";
+                return false;
+            }
+        }
+        std::string reason;
+        if (!validate(scenario, reason)) {
+            error = path + ":" + std::to_string(lineNumber) + ": " + reason;
+            return false;
+        }
+        scenarios.push_back(scenario);
+    }
+
+    if (scenarios.empty()) {
+        error = "场景文件中没有场景: " + path;
+        return false;
+    }
+    return true;
+}
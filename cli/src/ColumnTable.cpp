@@ -0,0 +1,158 @@
+#include "../ColumnTable.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+// 以小端写出整数
+template <typename T>
+void writeLittleEndian(std::ostream& out, T value) {
+    unsigned char bytes[sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<unsigned char>((static_cast<std::uint64_t>(value) >> (8 * i)) & 0xff);
+    }
+    out.write(reinterpret_cast<const char*>(bytes), sizeof(T));
+}
+
+void writeDouble(std::ostream& out, double value) {
+    std::uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(value), "double必须为64位");
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeLittleEndian(out, bits);
+}
+
+// CSV字段：含逗号、引号或换行时加引号，引号转义为两个引号
+void writeCsvString(std::ostream& out, const std::string& text) {
+    if (text.find_first_of(",\"\n\r") == std::string::npos) {
+        out << text;
+        return;
+    }
+    out << '"';
+    for (char c : text) {
+        if (c == '"') out << '"';
+        out << c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+void ColumnTable::addColumn(const std::string& name, std::vector<double> values) {
+    Column column;
+    column.name = name;
+    column.type = Type::Float64;
+    column.doubles = std::move(values);
+    m_columns.push_back(std::move(column));
+}
+
+void ColumnTable::addColumn(const std::string& name, std::vector<std::int64_t> values) {
+    Column column;
+    column.name = name;
+    column.type = Type::Int64;
+    column.integers = std::move(values);
+    m_columns.push_back(std::move(column));
+}
+
+void ColumnTable::addColumn(const std::string& name, std::vector<std::string> values) {
+    Column column;
+    column.name = name;
+    column.type = Type::String;
+    column.strings = std::move(values);
+    m_columns.push_back(std::move(column));
+}
+
+std::size_t ColumnTable::rowCount() const {
+    if (m_columns.empty()) return 0;
+    const Column& column = m_columns.front();
+    switch (column.type) {
+        case Type::Float64: return column.doubles.size();
+        case Type::Int64: return column.integers.size();
+        case Type::String: return column.strings.size();
+    }
+    return 0;
+}
+
+bool ColumnTable::writeCsv(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "无法写入结果文件: " << path << std::endl;
+        return false;
+    }
+
+    for (std::size_t c = 0; c < m_columns.size(); ++c) {
+        if (c) out << ',';
+        writeCsvString(out, m_columns[c].name);
+    }
+    out << '\n';
+
+    const std::size_t rows = rowCount();
+    char buffer[32];
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t c = 0; c < m_columns.size(); ++c) {
+            if (c) out << ',';
+            const Column& column = m_columns[c];
+            switch (column.type) {
+                case Type::Float64:
+                    if (!std::isnan(column.doubles[r])) {
+                        std::snprintf(buffer, sizeof(buffer), "%.12g", column.doubles[r]);
+                        out << buffer;
+                    }
+                    break;
+                case Type::Int64:
+                    out << column.integers[r];
+                    break;
+                case Type::String:
+                    writeCsvString(out, column.strings[r]);
+                    break;
+            }
+        }
+        out << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+bool ColumnTable::writeColumnar(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "无法写入结果文件: " << path << std::endl;
+        return false;
+    }
+
+    const std::size_t rows = rowCount();
+    out.write("PLCOL001", 8);
+    writeLittleEndian<std::uint64_t>(out, rows);
+    writeLittleEndian<std::uint32_t>(out, static_cast<std::uint32_t>(m_columns.size()));
+    for (const Column& column : m_columns) {
+        writeLittleEndian<std::uint32_t>(out, static_cast<std::uint32_t>(column.name.size()));
+        out.write(column.name.data(), column.name.size());
+        writeLittleEndian<std::uint8_t>(out, static_cast<std::uint8_t>(column.type));
+    }
+
+    for (const Column& column : m_columns) {
+        switch (column.type) {
+            case Type::Float64:
+                for (double value : column.doubles) writeDouble(out, value);
+                break;
+            case Type::Int64:
+                for (std::int64_t value : column.integers) writeLittleEndian<std::uint64_t>(out, value);
+                break;
+            case Type::String: {
+                std::uint64_t offset = 0;
+                writeLittleEndian<std::uint64_t>(out, offset);
+                for (const std::string& value : column.strings) {
+                    offset += value.size();
+                    writeLittleEndian<std::uint64_t>(out, offset);
+                }
+                for (const std::string& value : column.strings) {
+                    out.write(value.data(), value.size());
+                }
+                break;
+            }
+        }
+    }
+    return static_cast<bool>(out);
+}
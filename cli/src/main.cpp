@@ -0,0 +1,143 @@
+/**
+ * @file main.cpp
+ * @brief 无界面批量仿真命令行工具
+ *
+ * 只链接算法核心库和数据库访问库，不依赖GTK/WebKit，可在没有显示环境的服务器上运行。
+ * 用法: passivelocation_batch <场景文件> [选项]
+ */
+
+#include "../BatchScenario.h"
+#include "../BatchRunner.h"
+#include "../../models/DBConnector.h"
+#include "../../models/DatabaseModelRepository.h"
+#include "../../utils/Instrumentation.h"
+#include "../../utils/Log.h"
+#include "../../utils/RandomStream.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "用法: " << program << " <场景文件> [选项]\n"
+              << "  -o, --output <文件>     结果文件，默认 batch_results.csv\n"
+              << "  --format <csv|columnar> 输出格式，默认按扩展名判断(.plcol 为列式)\n"
+              << "  -j, --threads <N>       并行线程数，默认使用全部硬件线程\n"
+              << "  --seed <N>              随机数主种子，相同种子的结果逐位一致；默认使用系统时间\n"
+              << "  --no-screen             不做解算前的链路预算筛查\n"
+              << "  --quiet                 不输出进度和算法日志\n"
+              << "  --log-level <级别>      日志级别 trace|debug|info|warn|error|off，默认 info\n"
+              << "  --trace <文件>          记录各阶段耗时并写成 Chrome trace JSON\n"
+              << "  --db-host <主机>        数据库主机，默认 localhost\n"
+              << "  --db-port <端口>        数据库端口，默认 3306\n"
+              << "  --db-user <用户>        数据库用户，默认 root\n"
+              << "  --db-password <密码>    数据库密码\n"
+              << "  --db-name <库名>        数据库名，默认 passive_location\n";
+}
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    // 环境变量中的配置可被命令行参数覆盖
+    Instrumentation::configureFromEnvironment();
+
+    std::string scenarioPath;
+    std::string outputPath = "batch_results.csv";
+    std::string format;
+    unsigned int threadCount = 0;
+    unsigned long long seed = 0;
+    bool showProgress = true;
+    bool screen = true;
+    std::string dbHost = "localhost";
+    std::string dbUser = "root";
+    std::string dbPassword = "123456";
+    std::string dbName = "passive_location";
+    unsigned int dbPort = 3306;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if ((arg == "-o" || arg == "--output") && hasValue) outputPath = argv[++i];
+        else if (arg == "--format" && hasValue) format = argv[++i];
+        else if ((arg == "-j" || arg == "--threads") && hasValue) threadCount = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--no-screen") screen = false;
+        else if (arg == "--quiet") showProgress = false;
+        else if (arg == "--log-level" && hasValue) {
+            Log::Level level;
+            if (!Log::parseLevel(argv[++i], level)) {
+                std::cerr << "无效的日志级别: " << argv[i] << std::endl;
+                return 2;
+            }
+            Log::setLevel(level);
+        }
+        else if (arg == "--trace" && hasValue) Instrumentation::setTraceOutput(argv[++i]);
+        else if (arg == "--db-host" && hasValue) dbHost = argv[++i];
+        else if (arg == "--db-port" && hasValue) dbPort = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--db-user" && hasValue) dbUser = argv[++i];
+        else if (arg == "--db-password" && hasValue) dbPassword = argv[++i];
+        else if (arg == "--db-name" && hasValue) dbName = argv[++i];
+        else if (arg == "-h" || arg == "--help") { printUsage(argv[0]); return 0; }
+        else if (!arg.empty() && arg[0] != '-' && scenarioPath.empty()) scenarioPath = arg;
+        else {
+            std::cerr << "无法识别的参数: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (scenarioPath.empty()) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (format.empty()) format = endsWith(outputPath, ".plcol") ? "columnar" : "csv";
+    if (format != "csv" && format != "columnar") {
+        std::cerr << "不支持的输出格式: " << format << std::endl;
+        return 2;
+    }
+
+    std::vector<BatchScenario> scenarios;
+    std::string error;
+    if (!loadBatchScenarios(scenarioPath, scenarios, error)) {
+        std::cerr << error << std::endl;
+        return 2;
+    }
+
+    if (!DBConnector::staticInit(dbHost, dbUser, dbPassword, dbName, dbPort)) {
+        std::cerr << "数据库连接失败" << std::endl;
+        return 1;
+    }
+    ModelRepository::setInstance(std::make_shared<DatabaseModelRepository>());
+    Log::setEnabled(showProgress);
+    RandomService::getInstance().setSeed(seed);
+
+    const auto start = std::chrono::steady_clock::now();
+    BatchRunner runner(threadCount, showProgress);
+    runner.setLinkBudgetScreening(screen);
+    const std::vector<BatchRunResult> results = runner.run(scenarios);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Instrumentation::finish();
+
+    std::size_t succeeded = 0;
+    for (const BatchRunResult& r : results) {
+        if (r.success) ++succeeded;
+    }
+
+    const ColumnTable table = BatchRunner::toTable(results);
+    const bool written = format == "columnar" ? table.writeColumnar(outputPath) : table.writeCsv(outputPath);
+    std::cerr << "[batch] " << scenarios.size() << " 个场景, " << results.size() << " 次仿真, 成功 "
+              << succeeded << " 次, 耗时 " << seconds << " 秒" << std::endl;
+    if (!written) return 1;
+    std::cerr << "[batch] 结果已写入 " << outputPath << std::endl;
+
+    DBConnector::getInstance().close();
+    return succeeded == results.size() ? 0 : 3;
+}
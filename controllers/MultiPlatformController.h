@@ -11,11 +11,14 @@
 #include "../utils/ErrorCircleDisplay.h"
 #include "../utils/ErrorCircle.h"
 #include "../utils/HyperbolaLines.h"
+#include "../utils/CoverageMap.h"
+#include "../utils/JobExecutor.h"
 #include <string>
 #include <vector>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <set>
 
 class ApplicationController;  // 前向声明
 
@@ -32,7 +35,7 @@ public:
     // 获取视图
     MultiPlatformView* getView() const;
 
-    // 开始仿真
+    // 开始仿真：参数在主线程读取，计算、误差圆和数据库写入提交到后台任务执行器
     void startSimulation(const std::vector<std::string>& deviceNames,
                         const std::string& sourceName,
                         const std::string& systemType,
@@ -40,8 +43,43 @@ public:
     
     // 设置TDOA误差参数
     void setTDOAErrorParams(double tdoaRmsError, double esmToaError);
+    
+    // 取消本控制器提交的全部仿真任务
+    void cancelSimulation();
+    
+    // 正在排队或运行的仿真任务数
+    std::size_t runningSimulationCount() const;
 
 private:
+    // 一次仿真任务的输入参数，视图参数在主线程读取后随任务传给后台线程
+    struct SimulationSetup {
+        std::vector<std::string> deviceNames;
+        std::string sourceName;
+        std::string systemType;
+        double simulationTime = 0.0;
+        double tdoaRmsError = 0.0;
+        double esmToaError = 0.0;
+        double dfMeanError[2] = {0.0, 0.0};
+        double dfStdDev[2] = {0.0, 0.0};
+        bool showCoverage = false;  // 是否叠加定位精度热力图
+        
+        // 以下字段由后台任务从数据库加载
+        std::vector<ReconnaissanceDevice> selectedDevices;
+        std::vector<int> deviceIds;
+        RadiationSource selectedSource;
+    };
+    
+    // 定位精度热力图(CEP)，在后台任务中计算并着色，在主线程叠加到地图
+    struct CoverageOverlay {
+        bool valid = false;
+        double west = 0.0, south = 0.0, east = 0.0, north = 0.0;
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> rgba;
+        double minCep = 0.0;  // 着色范围(米)
+        double maxCep = 0.0;
+    };
+    
     MultiPlatformController();
     ~MultiPlatformController();
     
@@ -52,9 +90,23 @@ private:
     // 计算两点之间的距离
     double calculateDistance(const COORD3& p1, const COORD3& p2);
     
+    // 后台任务：在工作线程执行，返回在主线程更新视图和地图的完成回调
+    JobExecutor::Completion runSimulationJob(JobContext& context, SimulationSetup& setup);
+    JobExecutor::Completion runFDOAJob(JobContext& context, const SimulationSetup& setup);
+    JobExecutor::Completion runTDOAJob(JobContext& context, const SimulationSetup& setup);
+    JobExecutor::Completion runDFJob(JobContext& context, const SimulationSetup& setup);
+    
+    // 按选中侦察站布局计算精度热力图，未勾选或参数无效时返回 valid=false
+    CoverageOverlay computeCoverageOverlay(const SimulationSetup& setup, CoverageSystem system);
+    // 在地图上显示(或移除)精度热力图
+    void showCoverageOverlay(MapView* mapView, const CoverageOverlay& overlay);
+    
     MultiPlatformView* m_view;
     
     // TDOA误差参数
     double m_tdoaRmsError;
     double m_esmToaError;
+    
+    // 本控制器提交且尚未结束的任务编号(仅在主线程访问)
+    std::set<int> m_jobIds;
 }; 
\ No newline at end of file
@@ -6,9 +6,11 @@
 #include "../models/InterferometerPositioning.h"
 #include "../models/SinglePlatformTDOA.h"
 #include "../models/TrajectorySimulator.h"
+#include "../utils/JobExecutor.h"
 #include <string>
 #include <vector>
 #include <utility> // 添加pair支持
+#include <set>
 
 class ApplicationController;  // 前向声明
 
@@ -21,9 +23,12 @@ public:
     // 初始化控制器
     void init(SinglePlatformView* view);
     
-    // 启动仿真
+    // 启动仿真：设备查询和定位计算提交到后台任务执行器，结果在主线程显示
     void startSimulation();
     
+    // 取消本控制器提交的全部仿真任务
+    void cancelSimulation();
+    
     // 加载模型数据
     void loadModelData();
     
@@ -44,8 +49,25 @@ private:
     SinglePlatformController(const SinglePlatformController&) = delete;
     SinglePlatformController& operator=(const SinglePlatformController&) = delete;
     
+    // 后台任务：在工作线程执行，返回在主线程显示结果的完成回调
+    JobExecutor::Completion runSimulationJob(JobContext& context,
+                                             const std::string& techSystem,
+                                             const std::string& deviceName,
+                                             const std::string& sourceName,
+                                             int simulationTime);
+    
+    // 在主线程显示仿真结果
+    void presentSimulationResult(const std::string& techSystem,
+                                 const ReconnaissanceDevice& device,
+                                 const RadiationSource& source,
+                                 const LocationResult& result,
+                                 int simulationTime);
+    
     SinglePlatformView* m_view;
     
     // 存储最后一次仿真的误差因素
     std::vector<double> m_lastErrorFactors;
+    
+    // 本控制器提交且尚未结束的任务编号(仅在主线程访问)
+    std::set<int> m_jobIds;
 }; 
\ No newline at end of file
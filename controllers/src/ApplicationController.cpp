@@ -1,6 +1,7 @@
 #include "../ApplicationController.h"
 #include "../../models/ReconnaissanceDeviceModel.h"
 #include "../../models/RadiationSourceModel.h"
+#include "../../models/DatabaseModelRepository.h"
 #include "../../views/ReconnaissanceDeviceModelView.h"
 #include "../../views/RadiationSourceModelView.h"
 #include "../../views/SinglePlatformView.h"
@@ -14,6 +15,7 @@
 #include "../DataSelectionController.h"
 #include "../EvaluationController.h"
 #include <iostream>
+#include <memory>
 #include <random>
 
 // 辅助函数，获取容器中指定索引的子控件
@@ -81,6 +83,9 @@ ApplicationController::~ApplicationController() {
 bool ApplicationController::init(int argc, char** argv) {
     gtk_init(&argc, &argv);
     
+    // 算法层通过模型数据源读取数据库
+    ModelRepository::setInstance(std::make_shared<DatabaseModelRepository>());
+    
     // 初始化数据库连接
     if (!DBConnector::initDefaultConnection()) {
         g_print("Failed to connect to database, will continue with sample data\n");
@@ -3,7 +3,6 @@
 #include <iostream>
 #include <algorithm>
 #include "../../models/DBConnector.h"
-#include <mysql/mysql.h>
 #include "../../models/RadiationSourceDAO.h"
 #include "../../models/RadiationSourceModel.h"
 #include "../../models/ReconnaissanceDeviceDAO.h"
@@ -36,71 +35,49 @@ DataSelectionView* DataSelectionController::getView() const {
 //加载数据
 std::vector<std::vector<std::string>> DataSelectionController::getRelatedTasks(int radiationId) {
     std::vector<std::vector<std::string>> tasks;
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) {
-        std::cerr << "[数据库连接失败] DBConnector::getInstance().getConnection() 返回nullptr" << std::endl;
+        std::cerr << "[数据库连接失败] 无法从连接池获取连接" << std::endl;
         return tasks;
     }
-    if (mysql_ping(conn) != 0) {
-        std::cerr << "[数据库连接断开] mysql_ping(conn) != 0, 错误: " << mysql_error(conn) << std::endl;
-        return tasks;
-    }
-    // 查询单平台任务
-    std::string singleSql = "SELECT '单平台', rd.device_name, sp.task_id, sp.target_longitude, sp.target_latitude, sp.target_altitude, sp.azimuth, sp.elevation "
-                            "FROM single_platform_task sp "
-                            "JOIN reconnaissance_device_models rd ON sp.device_id = rd.device_id "
-                            "WHERE sp.radiation_id = " + std::to_string(radiationId);
-    if (mysql_query(conn, singleSql.c_str()) == 0) {
-        MYSQL_RES *result = mysql_store_result(conn);
-        if (result != nullptr) {
-            int rowCount = 0;
-            MYSQL_ROW row;
-            while ((row = mysql_fetch_row(result))) {
-                std::vector<std::string> task;
-                for (int i = 0; i < mysql_num_fields(result); ++i) {
-                    task.push_back(row[i] ? row[i] : "");
-                }
-                tasks.push_back(task);
-                rowCount++;
-            }
-            mysql_free_result(result);
+    // 单平台任务和多平台任务的查询，参数均为辐射源ID
+    const char* const sqls[] = {
+        "SELECT '单平台', rd.device_name, sp.task_id, sp.target_longitude, sp.target_latitude, sp.target_altitude, sp.azimuth, sp.elevation "
+        "FROM single_platform_task sp "
+        "JOIN reconnaissance_device_models rd ON sp.device_id = rd.device_id "
+        "WHERE sp.radiation_id = ?",
+        "SELECT '多平台', GROUP_CONCAT(rd.device_name SEPARATOR ', '), mp.task_id, mp.target_longitude, mp.target_latitude, mp.target_altitude, mp.azimuth, mp.elevation "
+        "FROM multi_platform_task mp "
+        "JOIN platform_task_relation ptr ON mp.task_id = ptr.simulation_id "
+        "JOIN reconnaissance_device_models rd ON ptr.device_id = rd.device_id "
+        "WHERE mp.radiation_id = ? "
+        "GROUP BY mp.task_id"
+    };
+    for (const char* sql : sqls) {
+        PreparedStatement* stmt = conn.prepare(sql);
+        if (!stmt) {
+            std::cerr << "MySQL Error: " << conn.error() << std::endl;
+            continue;
         }
-    } else {
-        db.showError();
-    }
-    // 查询多平台任务
-    std::string multiSql = "SELECT '多平台', GROUP_CONCAT(rd.device_name SEPARATOR ', '), mp.task_id, mp.target_longitude, mp.target_latitude, mp.target_altitude, mp.azimuth, mp.elevation "
-                           "FROM multi_platform_task mp "
-                           "JOIN platform_task_relation ptr ON mp.task_id = ptr.simulation_id "
-                           "JOIN reconnaissance_device_models rd ON ptr.device_id = rd.device_id "
-                           "WHERE mp.radiation_id = " + std::to_string(radiationId) +
-                           " GROUP BY mp.task_id";
-    if (mysql_query(conn, multiSql.c_str()) == 0) {
-        MYSQL_RES *result = mysql_store_result(conn);
-        if (result != nullptr) {
-            int rowCount = 0;
-            MYSQL_ROW row;
-            while ((row = mysql_fetch_row(result))) {
-                std::vector<std::string> task;
-                for (int i = 0; i < mysql_num_fields(result); ++i) {
-                    task.push_back(row[i] ? row[i] : "");
-                }
-                tasks.push_back(task);
-                rowCount++;
+        stmt->bindInt(0, radiationId);
+        if (!stmt->execute()) {
+            std::cerr << "MySQL Error: " << stmt->error() << std::endl;
+            continue;
+        }
+        while (stmt->fetch()) {
+            std::vector<std::string> task;
+            for (std::size_t i = 0; i < stmt->columnCount(); ++i) {
+                task.push_back(stmt->getString(i));
             }
-            mysql_free_result(result);
+            tasks.push_back(task);
         }
-    } else {
-        db.showError();
     }
     return tasks;
 }
 //删除选中的数据项
 void DataSelectionController::deleteSelectedItems(DataSelectionView* view) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0) {
+    PooledConnection conn = DBConnector::getInstance().acquire();
+    if (!conn) {
         std::cerr << "数据库连接异常" << std::endl;
         std::cerr.flush();
         return;
@@ -125,18 +102,22 @@ void DataSelectionController::deleteSelectedItems(DataSelectionView* view) {
             int taskId = 0;
             gtk_tree_model_get(model, &treeIter, 5, &taskId, -1);
             // 根据任务类型和任务ID删除
-            std::string tableName;
+            const char* sql = nullptr;
             if (taskType == "单平台") {
-                tableName = "single_platform_task";
+                sql = "DELETE FROM single_platform_task WHERE task_id = ?";
             } else if (taskType == "多平台") {
-                tableName = "multi_platform_task";
+                sql = "DELETE FROM multi_platform_task WHERE task_id = ?";
             } else {
                 std::cerr << "未知任务类型: " << taskType << std::endl;
+                iter = g_list_next(iter);
                 continue;
             }
-            std::string sql = "DELETE FROM " + tableName + " WHERE task_id = " + std::to_string(taskId);
-            if (mysql_query(conn, sql.c_str()) != 0) {
-                std::cerr << "删除失败: " << mysql_error(conn) << std::endl;
+            PreparedStatement* stmt = conn.prepare(sql);
+            if (stmt) {
+                stmt->bindInt(0, taskId);
+            }
+            if (!stmt || !stmt->execute()) {
+                std::cerr << "删除失败: " << (stmt ? stmt->error() : conn.error()) << std::endl;
             } else {
                 std::cout << "成功删除任务ID: " << taskId << std::endl;
             }
@@ -144,7 +125,8 @@ void DataSelectionController::deleteSelectedItems(DataSelectionView* view) {
         iter = g_list_next(iter);
     }
     g_list_free_full(selectedRows, reinterpret_cast<GDestroyNotify>(gtk_tree_path_free));
-    // 刷新列表
+    // 刷新列表前归还连接，列表刷新会再次访问数据库
+    conn = PooledConnection();
     if (GTK_IS_COMBO_BOX(m_targetCombo)) {
         int active = gtk_combo_box_get_active(m_targetCombo);
         if (active >= 0) {
@@ -156,60 +138,87 @@ void DataSelectionController::deleteSelectedItems(DataSelectionView* view) {
     }
 }
 
+// 界面录入的数值按文本绑定，由数据库完成类型转换；空值写入NULL
+static void bindInputValue(PreparedStatement& stmt, std::size_t index, const std::string& value) {
+    if (value.empty()) {
+        stmt.bindNull(index);
+    } else {
+        stmt.bindString(index, value);
+    }
+}
+
 // 向数据库录入数据
 bool DataSelectionController::importData(DataSelectionView* view, bool isSingle, const std::vector<std::string>& values,
                                        const std::vector<int>& deviceIds, int radiationId, const std::string& techSystem) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0) {
-        std::cerr << "数据库连接异常" << std::endl;
-        std::cerr.flush();
+    const std::size_t valueCount = isSingle ? 11 : 12;
+    if (values.size() < valueCount) {
+        std::cerr << "录入数据不完整: 需要 " << valueCount << " 个字段, 实际 " << values.size() << std::endl;
         return false;
     }
-    char sql[1024];
-    if (isSingle) {
-        int deviceId = deviceIds.empty() ? -1 : deviceIds[0];
-        snprintf(sql, sizeof(sql),
-            "INSERT INTO single_platform_task (device_id, radiation_id, tech_system, "
-            "target_longitude, target_latitude, target_altitude, azimuth, elevation, execution_time,positioning_time, "
-            "positioning_distance,  positioning_accuracy, angle_error,direction_finding_accuracy) "
-            "VALUES (%d, %d, '%s', %s, %s, %s, %s, %s, %s, %s, %s, %s, %s, %s)",
-            deviceId, radiationId, techSystem.c_str(),
-            values[0].c_str(), values[1].c_str(), values[2].c_str(), values[3].c_str(), 
-            values[4].c_str(), values[5].c_str(), values[6].c_str(), values[7].c_str(), 
-            values[8].c_str(), values[9].c_str(), values[10].c_str()
-        );
-        if (mysql_query(conn, sql) != 0) {
-            std::cerr << "数据库插入失败: " << mysql_error(conn) << std::endl;
-            return false;
-        }
-    } else {
-        snprintf(sql, sizeof(sql),
-            "INSERT INTO multi_platform_task (radiation_id, tech_system, "
-            "target_longitude, target_latitude, target_altitude, azimuth, elevation, "
-            "execution_time, positioning_time, positioning_distance,positioning_accuracy, "
-            "movement_speed, movement_azimuth, movement_elevation) "
-            "VALUES (%d, '%s', %s, %s, %s, %s, %s, %s, %s, %s, %s, %s, %s, %s)",
-            radiationId, techSystem.c_str(),
-            values[0].c_str(), values[1].c_str(), values[2].c_str(), values[3].c_str(),
-            values[4].c_str(), values[5].c_str(), values[6].c_str(), values[7].c_str(),
-            values[8].c_str(), values[9].c_str(), values[10].c_str(), values[11].c_str()
-        );
-        //打印sql语句
-        std::cout << "sql: " << sql << std::endl;
-        if (mysql_query(conn, sql) != 0) {
-            std::cerr << "数据库插入失败: " << mysql_error(conn) << std::endl;
+    {
+        PooledConnection conn = DBConnector::getInstance().acquire();
+        if (!conn) {
+            std::cerr << "数据库连接异常" << std::endl;
+            std::cerr.flush();
             return false;
         }
-        int taskId = mysql_insert_id(conn);
-        // 插入设备关联关系(devId和taskId均为int类型)
-        for (int devId : deviceIds) {
-            char relSql[128];
-            snprintf(relSql, sizeof(relSql),
-                "INSERT INTO platform_task_relation (simulation_id, device_id) VALUES (%d, %d)",
-                taskId, devId);
-            if (mysql_query(conn, relSql) != 0) {
-                std::cerr << "插入设备关联失败: " << mysql_error(conn) << std::endl;
+        if (isSingle) {
+            int deviceId = deviceIds.empty() ? -1 : deviceIds[0];
+            PreparedStatement* stmt = conn.prepare(
+                "INSERT INTO single_platform_task (device_id, radiation_id, tech_system, "
+                "target_longitude, target_latitude, target_altitude, azimuth, elevation, execution_time,positioning_time, "
+                "positioning_distance,  positioning_accuracy, angle_error,direction_finding_accuracy) "
+                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+            if (!stmt) {
+                std::cerr << "数据库插入失败: " << conn.error() << std::endl;
+                return false;
+            }
+            std::size_t idx = 0;
+            stmt->bindInt(idx++, deviceId);
+            stmt->bindInt(idx++, radiationId);
+            stmt->bindString(idx++, techSystem);
+            for (std::size_t i = 0; i < valueCount; ++i) {
+                bindInputValue(*stmt, idx++, values[i]);
+            }
+            if (!stmt->execute()) {
+                std::cerr << "数据库插入失败: " << stmt->error() << std::endl;
+                return false;
+            }
+        } else {
+            PreparedStatement* stmt = conn.prepare(
+                "INSERT INTO multi_platform_task (radiation_id, tech_system, "
+                "target_longitude, target_latitude, target_altitude, azimuth, elevation, "
+                "execution_time, positioning_time, positioning_distance,positioning_accuracy, "
+                "movement_speed, movement_azimuth, movement_elevation) "
+                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+            if (!stmt) {
+                std::cerr << "数据库插入失败: " << conn.error() << std::endl;
+                return false;
+            }
+            std::size_t idx = 0;
+            stmt->bindInt(idx++, radiationId);
+            stmt->bindString(idx++, techSystem);
+            for (std::size_t i = 0; i < valueCount; ++i) {
+                bindInputValue(*stmt, idx++, values[i]);
+            }
+            if (!stmt->execute()) {
+                std::cerr << "数据库插入失败: " << stmt->error() << std::endl;
+                return false;
+            }
+            int taskId = static_cast<int>(stmt->insertId());
+            // 插入设备关联关系(devId和taskId均为int类型)
+            PreparedStatement* relStmt = conn.prepare(
+                "INSERT INTO platform_task_relation (simulation_id, device_id) VALUES (?, ?)");
+            for (int devId : deviceIds) {
+                if (!relStmt) break;
+                relStmt->bindInt(0, taskId);
+                relStmt->bindInt(1, devId);
+                if (!relStmt->execute()) {
+                    std::cerr << "插入设备关联失败: " << relStmt->error() << std::endl;
+                }
+            }
+            if (!relStmt && !deviceIds.empty()) {
+                std::cerr << "插入设备关联失败: " << conn.error() << std::endl;
             }
         }
     }
@@ -228,9 +237,8 @@ bool DataSelectionController::importData(DataSelectionView* view, bool isSingle,
 std::map<std::string, std::string> DataSelectionController::showTaskDetails(int taskId, const std::string& taskType) {
     std::map<std::string, std::string> taskDetails;
     
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn || mysql_ping(conn) != 0) {
+    PooledConnection conn = DBConnector::getInstance().acquire();
+    if (!conn) {
         std::cerr << "数据库连接异常" << std::endl;
         std::cerr.flush();
         taskDetails["error"] = "数据库连接异常";
@@ -238,33 +246,35 @@ std::map<std::string, std::string> DataSelectionController::showTaskDetails(int
     }
     
     // 根据任务类型和ID查询详细信息
-    std::string sql;
+    const char* sql = nullptr;
     if (taskType == "单平台") {
         sql = "SELECT spt.*, rdm.device_name, rsm.radiation_name "
               "FROM single_platform_task spt "
               "JOIN reconnaissance_device_models rdm ON spt.device_id = rdm.device_id "
               "JOIN radiation_source_models rsm ON spt.radiation_id = rsm.radiation_id "
-              "WHERE spt.task_id = " + std::to_string(taskId);
+              "WHERE spt.task_id = ?";
     } else if (taskType == "多平台") {
         sql = "SELECT mpt.*, rsm.radiation_name "
               "FROM multi_platform_task mpt "
               "JOIN radiation_source_models rsm ON mpt.radiation_id = rsm.radiation_id "
-              "WHERE mpt.task_id = " + std::to_string(taskId);
+              "WHERE mpt.task_id = ?";
+    } else {
+        taskDetails["error"] = "未知任务类型: " + taskType;
+        return taskDetails;
     }
     // 先执行SQL查询
-    if (mysql_query(conn, sql.c_str()) != 0) {
-        taskDetails["error"] = "SQL执行失败: " + std::string(mysql_error(conn));
+    PreparedStatement* stmt = conn.prepare(sql);
+    if (!stmt) {
+        taskDetails["error"] = "SQL执行失败: " + conn.error();
         return taskDetails;
     }
-    MYSQL_RES* result = mysql_store_result(conn);
-    if (!result) {
-        taskDetails["error"] = "获取结果集失败: " + std::string(mysql_error(conn));
+    stmt->bindInt(0, taskId);
+    if (!stmt->execute()) {
+        taskDetails["error"] = "SQL执行失败: " + stmt->error();
         return taskDetails;
     }
-    MYSQL_ROW row = mysql_fetch_row(result);
-    if (!row) {
+    if (!stmt->fetch()) {
         taskDetails["error"] = "未找到任务ID: " + std::to_string(taskId);
-        mysql_free_result(result);
         return taskDetails;
     }
     
@@ -273,65 +283,56 @@ std::map<std::string, std::string> DataSelectionController::showTaskDetails(int
     taskDetails["taskId"] = std::to_string(taskId);
     
     // 获取字段名和值
-    unsigned int num_fields = mysql_num_fields(result);
-    MYSQL_FIELD* fields = mysql_fetch_fields(result);
-    
-    // 处理字段值
-    if (taskType == "单平台") {
-        int deviceNameIdx = num_fields - 2;
-        int radiationNameIdx = num_fields - 1;
-        
-        taskDetails["deviceName"] = row[deviceNameIdx] ? row[deviceNameIdx] : "";
-        taskDetails["radiationName"] = row[radiationNameIdx] ? row[radiationNameIdx] : "";
-    } else if (taskType == "多平台") {
-        int mpRadiationNameIdx = mysql_num_fields(result) - 1;
-        taskDetails["radiationName"] = row[mpRadiationNameIdx] ? row[mpRadiationNameIdx] : "";
-        
-        // 获取关联设备
-        std::string deviceSql = "SELECT rdm.device_name "
-                             "FROM platform_task_relation ptr "
-                             "JOIN reconnaissance_device_models rdm ON ptr.device_id = rdm.device_id "
-                             "WHERE ptr.simulation_id = " + std::to_string(taskId);
-        if (mysql_query(conn, deviceSql.c_str()) == 0) {
-            MYSQL_RES* deviceResult = mysql_store_result(conn);
-            if (deviceResult) {
-                std::vector<std::string> deviceNames;
-                MYSQL_ROW deviceRow;
-                while ((deviceRow = mysql_fetch_row(deviceResult))) {
-                    if (deviceRow[0]) deviceNames.push_back(deviceRow[0]);
-                }
-                
-                std::string allDevices;
-                for (size_t i = 0; i < deviceNames.size(); ++i) {
-                    if (i > 0) allDevices += "，";
-                    allDevices += deviceNames[i];
-                }
-                taskDetails["deviceNames"] = allDevices;
-                mysql_free_result(deviceResult);
-            }
-        }
-    }
+    const std::size_t num_fields = stmt->columnCount();
     
     // 处理其他字段
-    for (unsigned int i = 0; i < num_fields; i++) {
-        const char* fieldName = fields[i].name;
-        const char* value = row[i] ? row[i] : "NULL";
+    for (std::size_t i = 0; i < num_fields; i++) {
+        const std::string& fieldName = stmt->columnName(i);
         
         // 跳过一些字段
         if (taskType == "单平台") {
-            if (strcmp(fieldName, "device_id") == 0 || strcmp(fieldName, "radiation_id") == 0 || 
-                strcmp(fieldName, "task_id") == 0) {
+            if (fieldName == "device_id" || fieldName == "radiation_id" || fieldName == "task_id") {
                 continue;
             }
         } else if (taskType == "多平台") {
-            if (strcmp(fieldName, "radiation_id") == 0 || strcmp(fieldName, "task_id") == 0) {
+            if (fieldName == "radiation_id" || fieldName == "task_id") {
                 continue;
             }
         }
         // 添加字段和值到结果
-        taskDetails[fieldName] = value;
+        taskDetails[fieldName] = stmt->getString(i, "NULL");
+    }
+    
+    // 处理字段值
+    if (taskType == "单平台") {
+        taskDetails["deviceName"] = stmt->getString(num_fields - 2);
+        taskDetails["radiationName"] = stmt->getString(num_fields - 1);
+    } else if (taskType == "多平台") {
+        taskDetails["radiationName"] = stmt->getString(num_fields - 1);
+        
+        // 获取关联设备(主查询的当前行已读出，可以在同一连接上执行下一条语句)
+        PreparedStatement* deviceStmt = conn.prepare(
+            "SELECT rdm.device_name "
+            "FROM platform_task_relation ptr "
+            "JOIN reconnaissance_device_models rdm ON ptr.device_id = rdm.device_id "
+            "WHERE ptr.simulation_id = ?");
+        if (deviceStmt) {
+            deviceStmt->bindInt(0, taskId);
+        }
+        if (deviceStmt && deviceStmt->execute()) {
+            std::vector<std::string> deviceNames;
+            while (deviceStmt->fetch()) {
+                if (!deviceStmt->isNull(0)) deviceNames.push_back(deviceStmt->getString(0));
+            }
+            
+            std::string allDevices;
+            for (size_t i = 0; i < deviceNames.size(); ++i) {
+                if (i > 0) allDevices += "，";
+                allDevices += deviceNames[i];
+            }
+            taskDetails["deviceNames"] = allDevices;
+        }
     }
     
-    mysql_free_result(result);
     return taskDetails;
 } 
\ No newline at end of file
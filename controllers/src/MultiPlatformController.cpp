@@ -1,17 +1,23 @@
 #include "../MultiPlatformController.h"
 #include "../../models/ReconnaissanceDeviceDAO.h"
 #include "../../models/RadiationSourceDAO.h"
-#include "../../models/TrajectorySimulator.h"
+#include "../../views/components/TrajectoryAnimator.h"
 
 #include "../../utils/ErrorCircle.h"
 #include "../../utils/ErrorCircleDisplay.h"
 #include "../../utils/HyperbolaLines.h"
 
 #include "../../models/TDOAalgorithm.h"
+#include "../../models/Trajectory.h"
 #include "../../models/DirectionFinding.h"
 #include "../../utils/DirectionErrorLines.h"
 #include "../../utils/CoordinateTransform.h"
+#include "../../utils/JobExecutor.h"
+#include "../../utils/CoverageMap.h"
+#include "../../utils/Instrumentation.h"
+#include "../../utils/Log.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -78,498 +84,765 @@ void MultiPlatformController::startSimulation(const std::vector<std::string>& de
         return;
     }
     
-    // 获取所有设备和辐射源数据
-    std::vector<ReconnaissanceDevice> allDevices = ReconnaissanceDeviceDAO::getInstance().getAllReconnaissanceDevices();
-    std::vector<RadiationSource> allSources = RadiationSourceDAO::getInstance().getAllRadiationSources();
+    // 视图参数只能在主线程读取，读取后随任务一起传给后台线程
+    SimulationSetup setup;
+    setup.deviceNames = deviceNames;
+    setup.sourceName = sourceName;
+    setup.systemType = systemType;
+    setup.simulationTime = simulationTime;
+    setup.showCoverage = m_view->isCoverageOverlayEnabled();
     
-    // 根据名称查找选中的设备
-    std::vector<ReconnaissanceDevice> selectedDevices;
-    std::vector<int> deviceIds;  // 添加deviceIds变量
-    for (const auto& deviceName : deviceNames) {
-        for (const auto& device : allDevices) {
-            if (device.getDeviceName() == deviceName) {
-                selectedDevices.push_back(device);
-                deviceIds.push_back(device.getDeviceId());  // 保存设备ID
-                break;
-            }
+    if (systemType == "时差体制") {
+        // 从视图获取TDOA误差参数（单位：纳秒，需要转换为秒）
+        double tdoaRmsError = m_view->getTDOARmsError();
+        double esmToaError = m_view->getESMToaError();
+        
+        // 更新控制器的成员变量
+        setTDOAErrorParams(tdoaRmsError, esmToaError);
+        
+        PL_LOG_DEBUG("从视图获取TDOA误差参数：TDOA RMS误差 = %g s (%g ns), ESM TOA误差 = %g s (%g ns)\n",
+                     tdoaRmsError, tdoaRmsError * 1e9, esmToaError, esmToaError * 1e9);
+    } else if (systemType == "测向体制") {
+        // 获取测向误差参数
+        for (int i = 0; i < 2; ++i) {
+            setup.dfMeanError[i] = m_view->getDFMeanError(i);
+            setup.dfStdDev[i] = m_view->getDFStdDev(i);
         }
     }
+    setup.tdoaRmsError = m_tdoaRmsError;
+    setup.esmToaError = m_esmToaError;
     
-    // 查找选中的辐射源
-    RadiationSource selectedSource;
-    bool sourceFound = false;
-    for (const auto& source : allSources) {
-        if (source.getRadiationName() == sourceName) {
-            selectedSource = source;
-            sourceFound = true;
-            break;
+    JobCallbacks callbacks;
+    callbacks.onProgress = [this](int jobId, double fraction, const std::string& message) {
+        if (m_view) {
+            m_view->updateProgress(fraction, "任务 #" + std::to_string(jobId) + "：" + message);
+        }
+    };
+    callbacks.onFinished = [this](int jobId, JobStatus status, const std::string& error) {
+        m_jobIds.erase(jobId);
+        if (!m_view) return;
+        
+        if (status == JobStatus::Failed) {
+            gchar* escaped = g_markup_escape_text(error.c_str(), -1);
+            m_view->updateResult(std::string("<span color='red'>仿真失败：") + escaped + "</span>");
+            g_free(escaped);
+        } else if (status == JobStatus::Cancelled && m_jobIds.empty()) {
+            m_view->updateResult("仿真已取消");
+        }
+        
+        if (m_jobIds.empty()) {
+            m_view->updateProgress(status == JobStatus::Completed ? 1.0 : 0.0,
+                                   status == JobStatus::Completed ? "仿真完成" : "仿真结束");
+        } else {
+            m_view->updateProgress(0.0, "剩余 " + std::to_string(m_jobIds.size()) + " 个仿真任务");
         }
+    };
+    
+    int jobId = JobExecutor::getInstance().submit(
+        systemType + "仿真",
+        [this, setup](JobContext& context) mutable {
+            return runSimulationJob(context, setup);
+        },
+        callbacks
+    );
+    m_jobIds.insert(jobId);
+    m_view->updateProgress(0.0, "任务 #" + std::to_string(jobId) + " 已提交，当前 " +
+                           std::to_string(m_jobIds.size()) + " 个仿真任务");
+}
+
+// 取消本控制器提交的全部仿真任务
+void MultiPlatformController::cancelSimulation() {
+    for (int jobId : m_jobIds) {
+        JobExecutor::getInstance().cancel(jobId);
     }
+}
+
+// 正在排队或运行的仿真任务数
+std::size_t MultiPlatformController::runningSimulationCount() const {
+    return m_jobIds.size();
+}
+
+// 后台任务：加载设备和辐射源，按技术体制分派
+JobExecutor::Completion MultiPlatformController::runSimulationJob(JobContext& context, SimulationSetup& setup) {
+    PL_TRACE_SCOPE("MultiPlatform.simulationJob");
+    context.setProgress(0.05, "加载设备和辐射源数据");
     
-    if (selectedDevices.empty() || !sourceFound) {
-        m_view->updateResult("错误：未找到选定的设备或辐射源");
-        return;
+    // 根据名称查找选中的设备
+    for (const auto& deviceName : setup.deviceNames) {
+        ReconnaissanceDevice device;
+        if (ReconnaissanceDeviceDAO::getInstance().findReconnaissanceDeviceByName(deviceName, device)) {
+            setup.selectedDevices.push_back(device);
+            setup.deviceIds.push_back(device.getDeviceId());  // 保存设备ID
+        }
     }
     
+    // 查找选中的辐射源
+    const bool sourceFound = RadiationSourceDAO::getInstance().findRadiationSourceByName(setup.sourceName, setup.selectedSource);
+    
+    if (setup.selectedDevices.empty() || !sourceFound) {
+        return [this]() {
+            if (m_view) m_view->updateResult("错误：未找到选定的设备或辐射源");
+        };
+    }
+    
+    if (context.isCancelled()) return nullptr;
+    
+    if (setup.systemType == "频差体制") {
+        return runFDOAJob(context, setup);
+    } else if (setup.systemType == "时差体制") {
+        return runTDOAJob(context, setup);
+    } else if (setup.systemType == "测向体制") {
+        return runDFJob(context, setup);
+    }
+    return nullptr;
+}
+
+// 后台任务：频差体制定位
+JobExecutor::Completion MultiPlatformController::runFDOAJob(JobContext& context, const SimulationSetup& setup) {
+    const std::vector<ReconnaissanceDevice>& selectedDevices = setup.selectedDevices;
+    const RadiationSource& selectedSource = setup.selectedSource;
+    const double simulationTime = setup.simulationTime;
     
     // 默认计算结果位置（使用辐射源的实际位置）
     double calculatedLongitude = selectedSource.getLongitude();
     double calculatedLatitude = selectedSource.getLatitude();
     double calculatedAltitude = selectedSource.getAltitude();
     
-    if (systemType == "频差体制") {
-        // 获取FDOA算法实例
-        FDOAalgorithm& algorithm = FDOAalgorithm::getInstance();
+    // 每个任务使用独立的FDOA算法实例
+    FDOAalgorithm algorithm;
+    
+    // 初始化算法参数
+    algorithm.init(setup.deviceNames, setup.sourceName, setup.systemType, simulationTime);
+    
+    // 执行算法
+    context.setProgress(0.2, "频差定位解算");
+    bool success = algorithm.calculate();
+    
+    if (!success) {
+        return [this]() {
+            if (m_view) m_view->updateResult("定位计算失败");
+        };
+    }
+    if (context.isCancelled()) return nullptr;
+    
+    FDOAalgorithm::SourcePositionResult result = algorithm.getResult();
+    // 将空间直角坐标转换为大地坐标
+    COORD3 resultLBH = xyz2lbh(result.position.p1, result.position.p2, result.position.p3);
+    
+    // 计算速度的大地坐标表示
+    COORD3 velocityResult = velocity_xyz2lbh(resultLBH.p1, resultLBH.p2, 
+                                   result.velocity.x, result.velocity.y, result.velocity.z);
+    
+    //经过simulationTime时间后，辐射源移动的位置
+    COORD3 movedPosition = algorithm.calculateSourcePositionAtTime(selectedSource, simulationTime);
+    
+    //经过simulationTime时间后，侦察站1的位置
+    COORD3 device1Position = algorithm.calculateDevicePositionAtTime(selectedDevices[0], simulationTime);
+    
+    //计算侦察站1到辐射源移动后的位置的距离
+    double distance = std::sqrt(
+        (movedPosition.p1 - device1Position.p1) * (movedPosition.p1 - device1Position.p1) + 
+        (movedPosition.p2 - device1Position.p2) * (movedPosition.p2 - device1Position.p2) + 
+        (movedPosition.p3 - device1Position.p3) * (movedPosition.p3 - device1Position.p3)
+    );
+    
+    //计算方位角
+    double theta_t = atan2(movedPosition.p1 - device1Position.p1, 
+                         movedPosition.p2 - device1Position.p2);
+    double azimuth = theta_t * Constants::RAD2DEG;  // 转换为角度
+    
+    //计算俯仰角
+    double r_pt = sqrt(pow(movedPosition.p1 - device1Position.p1, 2) + 
+                     pow(movedPosition.p2 - device1Position.p2, 2));
+    double epsilon_t = atan2(movedPosition.p3 - device1Position.p3, r_pt);
+    double elevation = epsilon_t * Constants::RAD2DEG;  // 转换为角度
+    
+    // 计算定位精度
+    context.setProgress(0.6, "计算定位精度");
+    // 精度按解算实际使用的观测时刻(可见性时间线选取)计算
+    double localizationAccuracy = algorithm.calculateLocalizationAccuracy(
+        setup.deviceIds,
+        selectedSource.getRadiationId(),
+        algorithm.getObservationEpochs(),
+        result.position,
+        result.velocity
+    );
+    if (context.isCancelled()) return nullptr;
+    
+    context.setProgress(0.8, "计算精度热力图");
+    CoverageOverlay coverage = computeCoverageOverlay(setup, CoverageSystem::FDOA);
+    if (context.isCancelled()) return nullptr;
+    
+    // 输出结果
+    std::stringstream ss;
+    ss << "定位结果：\n";
+    ss << "经度: " << resultLBH.p1 << " 度\n";
+    ss << "纬度: " << resultLBH.p2 << " 度\n";
+    ss << "高度: " << resultLBH.p3 << " 米\n";
+    ss << "运动速度: " << velocityResult.p1 << " m/s\n";
+    ss << "运动方位角: " << velocityResult.p2 << " 度\n";
+    ss << "运动俯仰角: " << velocityResult.p3 << " 度\n";
+    ss << "定位时间: " << simulationTime << " 秒\n";
+    ss << "定位距离: " << distance << " 米\n";
+    ss << "定位精度: " << localizationAccuracy << "\n";
+    ss << "多起点收敛: " << result.convergedStarts << "/" << result.startCount << "\n";
+    ss << "方位角: " << azimuth << " 度\n";
+    ss << "俯仰角: " << elevation << " 度\n";
+    if (coverage.valid) {
+        ss << "精度热力图CEP: " << coverage.minCep << " ~ " << coverage.maxCep << " 米(绿~红)\n";
+    }
+
+    // 同时输出到日志
+    PL_LOG_INFO("%s\n", ss.str().c_str());
+    
+    // 保存多平台仿真任务信息到数据库
+    context.setProgress(0.9, "保存仿真任务");
+    MultiPlatformTask task;
+    task.techSystem = "FDOA";  // 频差定位
+    task.radiationId = selectedSource.getRadiationId();
+    task.executionTime = simulationTime;
+    task.targetLongitude = resultLBH.p1;
+    task.targetLatitude = resultLBH.p2;
+    task.targetAltitude = resultLBH.p3;
+    task.movementSpeed = velocityResult.p1;
+    task.movementAzimuth = velocityResult.p2;
+    task.movementElevation = velocityResult.p3;
+    task.azimuth = azimuth;
+    task.elevation = elevation;
+    task.positioningDistance = distance;
+    task.positioningTime = result.locationTime;
+    task.positioningAccuracy = localizationAccuracy;
+    task.deviceIds = setup.deviceIds;
+
+    int taskId;
+    bool saved = MultiPlatformTaskDAO::getInstance().addMultiPlatformTask(task, taskId);
+    if (!saved) {
+        std::cerr << "多平台仿真任务保存失败" << std::endl;
+    }
+    
+    std::string resultText = ss.str();
+    return [this, resultText, saved, selectedDevices, selectedSource, simulationTime,
+            calculatedLongitude, calculatedLatitude, calculatedAltitude, coverage]() {
+        if (!m_view) return;
+        MapView* mapView = m_view->getMapView();
         
-        // 初始化算法参数
-        algorithm.init(deviceNames, sourceName, systemType, simulationTime);
+        // 更新视图
+        m_view->updateResult(resultText);
+        if (!saved) {
+            m_view->updateResult("定位结果（多平台仿真任务保存失败）");
+        }
+        if (!mapView) return;
         
-        // 执行算法
-        bool success = algorithm.calculate();
+        showCoverageOverlay(mapView, coverage);
         
-        if (success) {
-            FDOAalgorithm::SourcePositionResult result = algorithm.getResult();
-            // 将空间直角坐标转换为大地坐标
-            COORD3 resultLBH = xyz2lbh(result.position.p1, result.position.p2, result.position.p3);
-            
-            // 计算速度的大地坐标表示
-            COORD3 velocityResult = velocity_xyz2lbh(resultLBH.p1, resultLBH.p2, 
-                                           result.velocity.x, result.velocity.y, result.velocity.z);
-            
-            //经过simulationTime时间后，辐射源移动的位置
-            COORD3 movedPosition = algorithm.calculateSourcePositionAtTime(selectedSource, simulationTime);
-            
-            //经过simulationTime时间后，侦察站1的位置
-            COORD3 device1Position = algorithm.calculateDevicePositionAtTime(selectedDevices[0], simulationTime);
-            
-            //计算侦察站1到辐射源移动后的位置的距离
-            double distance = std::sqrt(
-                (movedPosition.p1 - device1Position.p1) * (movedPosition.p1 - device1Position.p1) + 
-                (movedPosition.p2 - device1Position.p2) * (movedPosition.p2 - device1Position.p2) + 
-                (movedPosition.p3 - device1Position.p3) * (movedPosition.p3 - device1Position.p3)
-            );
-            
-            //计算方位角
-            double theta_t = atan2(movedPosition.p1 - device1Position.p1, 
-                                 movedPosition.p2 - device1Position.p2);
-            double azimuth = theta_t * Constants::RAD2DEG;  // 转换为角度
-            
-            //计算俯仰角
-            double r_pt = sqrt(pow(movedPosition.p1 - device1Position.p1, 2) + 
-                             pow(movedPosition.p2 - device1Position.p2, 2));
-            double epsilon_t = atan2(movedPosition.p3 - device1Position.p3, r_pt);
-            double elevation = epsilon_t * Constants::RAD2DEG;  // 转换为角度
-            
-            // 计算定位精度
-            double localizationAccuracy = algorithm.calculateLocalizationAccuracy(
-                deviceIds,
-                selectedSource.getRadiationId(),
-                simulationTime,
-                result.position,
-                result.velocity
-            );
-            
-            // 输出结果
-            std::stringstream ss;
-            ss << "定位结果：\n";
-            ss << "经度: " << resultLBH.p1 << " 度\n";
-            ss << "纬度: " << resultLBH.p2 << " 度\n";
-            ss << "高度: " << resultLBH.p3 << " 米\n";
-            ss << "运动速度: " << velocityResult.p1 << " m/s\n";
-            ss << "运动方位角: " << velocityResult.p2 << " 度\n";
-            ss << "运动俯仰角: " << velocityResult.p3 << " 度\n";
-            ss << "定位时间: " << simulationTime << " 秒\n";
-            ss << "定位距离: " << distance << " 米\n";
-            ss << "定位精度: " << localizationAccuracy << "\n";
-            ss << "方位角: " << azimuth << " 度\n";
-            ss << "俯仰角: " << elevation << " 度\n";
-
-            // 同时输出到控制台
-            std::cout << ss.str() << std::endl;
-            
-            // 更新视图
-            m_view->updateResult(ss.str());
-            
-            // 保存多平台仿真任务信息到数据库
-            MultiPlatformTask task;
-            task.techSystem = "FDOA";  // 频差定位
-            task.radiationId = selectedSource.getRadiationId();
-            task.executionTime = simulationTime;
-            task.targetLongitude = resultLBH.p1;
-            task.targetLatitude = resultLBH.p2;
-            task.targetAltitude = resultLBH.p3;
-            task.movementSpeed = velocityResult.p1;
-            task.movementAzimuth = velocityResult.p2;
-            task.movementElevation = velocityResult.p3;
-            task.azimuth = azimuth;
-            task.elevation = elevation;
-            task.positioningDistance = distance;
-            task.positioningTime = result.locationTime;
-            task.positioningAccuracy = localizationAccuracy;
-            task.deviceIds = deviceIds;
-
-            int taskId;
-            if (!MultiPlatformTaskDAO::getInstance().addMultiPlatformTask(task, taskId)) {
-                std::cerr << "多平台仿真任务保存失败" << std::endl;
-                m_view->updateResult("定位结果（多平台仿真任务保存失败）");
-            }
-            
-            // 执行多设备轨迹动画
-            TrajectorySimulator::getInstance().animateMultipleDevicesMovement(
-                mapView,
-                selectedDevices,
-                selectedSource,
-                simulationTime,
-                calculatedLongitude,
-                calculatedLatitude,
-                calculatedAltitude
-            );
+        // 执行多设备轨迹动画
+        TrajectoryAnimator::getInstance().animateMultipleDevicesMovement(
+            mapView,
+            selectedDevices,
+            selectedSource,
+            simulationTime,
+            calculatedLongitude,
+            calculatedLatitude,
+            calculatedAltitude
+        );
+    };
+}
+
+// 后台任务：时差体制定位
+JobExecutor::Completion MultiPlatformController::runTDOAJob(JobContext& context, const SimulationSetup& setup) {
+    const std::vector<ReconnaissanceDevice>& selectedDevices = setup.selectedDevices;
+    const RadiationSource& selectedSource = setup.selectedSource;
+    const double simulationTime = setup.simulationTime;
+    const double tdoaRmsError = setup.tdoaRmsError;
+    const double esmToaError = setup.esmToaError;
+    
+    // 每个任务使用独立的TDOA算法实例
+    TDOAalgorithm algorithm;
+
+    // 初始化算法参数
+    algorithm.init(setup.deviceNames, setup.sourceName, setup.systemType, simulationTime);
+    
+    // 设置误差参数（任务提交时从视图读取）
+    algorithm.setErrorParams(tdoaRmsError, esmToaError);
+
+    // 执行算法
+    context.setProgress(0.2, "时差定位解算");
+    if (!algorithm.calculate()) {
+        return [this]() {
+            if (m_view) m_view->updateResult("<span color='red'>仿真计算失败</span>");
+        };
+    }
+    if (context.isCancelled()) return nullptr;
+    
+    // 获取定位结果
+    auto result = algorithm.getResult();
+
+    // 格式化结果
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(6);
+
+    // 辐射源位置
+    ss << "经度：" << result.longitude << "°\n";
+    ss << "纬度：" << result.latitude << "°\n";
+    ss << "高度：" << result.altitude << " 米\n";
+    ss << std::setprecision(2) << "定位误差：" << result.accuracy << " 米\n";
+    ss << "CEP：" << result.cep << " 米\n";
+    ss << "GDOP：" << result.gdop << "\n";
+    
+    // 辐射源和侦察站取定位算法实际使用的观测时刻的位置(初始时刻不可接收时平台已移动)
+    const double epoch = algorithm.getObservationEpoch();
+    std::vector<COORD3> stationPositions_xyz;
+    for (const auto& device : selectedDevices) {
+        stationPositions_xyz.push_back(Trajectory::fromDevice(device, simulationTime).positionXyzAt(epoch));
+    }
+    
+    COORD3 sourcePos_xyz = Trajectory::fromSource(selectedSource, simulationTime).positionXyzAt(epoch);
+    if (epoch != 0.0) {
+        ss << "观测时刻：" << epoch << " 秒\n";
+    }
+    
+    // 计算TDOA值（用于绘制双曲线）- 与定位算法保持一致
+    // 首先计算所有站点的TOA值
+    std::vector<double> true_toas(selectedDevices.size());
+    for (size_t i = 0; i < selectedDevices.size(); ++i) {
+        true_toas[i] = calculateDistance(stationPositions_xyz[i], sourcePos_xyz) / Constants::c;
+    }
+
+    // 使用第一个侦察站作为参考站（与定位算法一致）
+    int ref_idx = 0;
+    PL_LOG_DEBUG("[双曲线绘制] 使用侦察站 %d (%s) 作为参考站。\n", ref_idx, selectedDevices[ref_idx].getDeviceName().c_str());
+
+    // 应用ESM TOA误差到参考站TOA值 - 与定位算法保持一致
+    std::vector<double> measured_toas = true_toas;
+    if (esmToaError != 0.0) {
+        measured_toas[ref_idx] += esmToaError;
+        PL_LOG_DEBUG("[双曲线绘制] 应用ESM TOA误差 %g μs 到参考站，参考站TOA值变化: %g μs -> %g μs\n",
+                     esmToaError * 1e6, true_toas[ref_idx] * 1e6, measured_toas[ref_idx] * 1e6);
+    }
+
+    // 计算相对于参考站的TDOA值，与定位算法完全一致
+    // 创建正确大小的TDOA数组：站点数量-1
+    std::vector<double> tdoas(selectedDevices.size() - 1);
+    for (size_t i = 1; i < selectedDevices.size(); ++i) {
+        // 使用与定位算法相同的计算方式: tdoa = toa_i - toa_ref
+        // 注意：TDOA数组索引从0开始，对应站点索引从1开始
+        tdoas[i-1] = true_toas[i] - measured_toas[ref_idx]; // 使用已应用误差的参考站TOA
+
+        // 使用与TDOA算法相同的精度输出
+        PL_LOG_TRACE("站点 %zu (%s) 相对于参考站的TDOA: %.6e 秒 (%.6e μs)\n",
+                     i, selectedDevices[i].getDeviceName().c_str(), tdoas[i-1], tdoas[i-1] * 1e6);
+
+        // 检查是否可以构造双曲线
+        double focusDistance = calculateDistance(stationPositions_xyz[0], stationPositions_xyz[i]);
+        double distanceDiff = std::abs(tdoas[i-1]) * Constants::c;
+        
+        if (distanceDiff >= focusDistance) {
+            PL_LOG_WARN("警告: 站点 %zu 的TDOA距离差(%.3f 米)大于等于焦距(%.3f 米)，无法构造双曲线\n",
+                        i, distanceDiff, focusDistance);
         } else {
-            m_view->updateResult("定位计算失败");
+            PL_LOG_TRACE("焦距 = %.3f 米，距离差 = %.3f 米，距离差/焦距比率 = %.3f\n",
+                         focusDistance, distanceDiff, distanceDiff / focusDistance);
         }
-    } else if (systemType == "时差体制") {
-        // 获取TDOA算法实例
-        TDOAalgorithm& algorithm = TDOAalgorithm::getInstance();
-
-        // 从视图获取TDOA误差参数（单位：纳秒，需要转换为秒）
-        if (m_view) {
-            double tdoaRmsError = m_view->getTDOARmsError();
-            double esmToaError = m_view->getESMToaError();
-            
-            // 更新控制器的成员变量
-            setTDOAErrorParams(tdoaRmsError, esmToaError);
-            
-            std::cout << "从视图获取TDOA误差参数：TDOA RMS误差 = " << tdoaRmsError << " s (" 
-                      << tdoaRmsError * 1e9 << " ns), ESM TOA误差 = " << esmToaError 
-                      << " s (" << esmToaError * 1e9 << " ns)" << std::endl;
+    }
+    
+    // 生成TDOA误差点和误差圆
+    // 创建一个结构体存储定位结果的大地坐标
+    COORD3 resultLBH;
+    resultLBH.p1 = result.longitude;
+    resultLBH.p2 = result.latitude;
+    resultLBH.p3 = result.altitude;
+    
+    // 三维定位给出了协方差时，误差圆半径由协方差解析计算，只采样少量点用于显示
+    context.setProgress(0.4, "计算误差圆");
+    MonteCarloConfig errorCircleConfig;
+    errorCircleConfig.cancelFlag = context.cancelFlag();
+    TDOAResult tdoaResult;
+    if (result.cep > 0.0) {
+        errorCircleConfig.sampleCount = errorCircleConfig.keepSamples;
+        tdoaResult = calculateTDOAErrorCircle(
+            lbh2xyz(result.longitude, result.latitude, result.altitude),
+            algorithm.getCovariance(),
+            errorCircleConfig
+        );
+    } else {
+        // 使用calculateTDOAErrorCircle函数生成误差点和误差圆(随机种子为0，表示取当前任务的随机流)
+        tdoaResult = calculateTDOAErrorCircle(
+            setup.deviceNames,
+            setup.sourceName,
+            tdoaRmsError,
+            esmToaError,
+            errorCircleConfig
+        );
+    }
+    if (context.isCancelled()) return nullptr;
+    
+    context.setProgress(0.8, "计算精度热力图");
+    CoverageOverlay coverage = computeCoverageOverlay(setup, CoverageSystem::TDOA);
+    if (context.isCancelled()) return nullptr;
+    if (coverage.valid) {
+        ss << "精度热力图CEP：" << coverage.minCep << " ~ " << coverage.maxCep << " 米(绿~红)\n";
+    }
+    
+    // 保存多平台仿真任务信息到数据库
+    context.setProgress(0.9, "保存仿真任务");
+    MultiPlatformTask task;
+    task.techSystem = "TDOA";
+    task.radiationId = selectedSource.getRadiationId();
+    task.executionTime = simulationTime;
+    task.targetLongitude = result.longitude;
+    task.targetLatitude = result.latitude;
+    task.targetAltitude = result.altitude;
+    task.movementSpeed = 0.0f;  // 静止目标
+    task.movementAzimuth = 0.0;
+    task.movementElevation = 0.0;
+    task.positioningTime = simulationTime;
+    task.positioningAccuracy = result.accuracy;
+    task.deviceIds = setup.deviceIds;
+    
+    int taskId;
+    if (!MultiPlatformTaskDAO::getInstance().addMultiPlatformTask(task, taskId)) {
+        std::cerr << "多平台仿真任务保存失败" << std::endl;
+    }
+    
+    std::string resultText = ss.str();
+    return [this, resultText, selectedDevices, selectedSource, result, resultLBH, tdoaResult,
+            stationPositions_xyz, tdoas, sourcePos_xyz, tdoaRmsError, esmToaError, coverage]() {
+        if (!m_view) return;
+        
+        // 更新界面显示
+        m_view->updateResult(resultText);
+        
+        MapView* mapView = m_view->getMapView();
+        if (!mapView) return;
+        
+        // 使用HyperbolaLines类绘制双曲线
+        std::vector<std::string> colors = {"#FF0000", "#00FF00", "#0000FF", "#FF00FF"};
+        
+        // 添加双曲线绘制前的调试信息
+        PL_LOG_DEBUG("开始绘制双曲线：侦察站 %zu 个，TDOA值 %zu 个，TDOA RMS误差 %.6e 秒，ESM TOA误差 %.6e 秒\n",
+                     stationPositions_xyz.size(), tdoas.size(), tdoaRmsError, esmToaError);
+        for (size_t i = 0; i < tdoas.size(); ++i) {
+            PL_LOG_TRACE("TDOA[%zu] = %.6e 秒\n", i + 1, tdoas[i]);
         }
-
-        // 初始化算法参数
-        algorithm.init(deviceNames, sourceName, systemType, simulationTime);
         
-        // 设置误差参数（从控制器成员变量获取）
-        algorithm.setErrorParams(m_tdoaRmsError, m_esmToaError);
-
-        // 执行算法
-        if (algorithm.calculate()) {
-            // 获取定位结果
-            auto result = algorithm.getResult();
-
-            // 格式化结果
-            std::stringstream ss;
-            ss << std::fixed << std::setprecision(6);
-
-            // 辐射源位置
-            ss << "经度：" << result.longitude << "°\n";
-            ss << "纬度：" << result.latitude << "°\n";
-            ss << "高度：" << result.altitude << " 米\n";
-            ss << std::setprecision(2) << "定位误差：" << result.accuracy << " 米\n";
-
-            // 更新界面显示
-            if (m_view) {
-                m_view->updateResult(ss.str());
-            }
-            
-            // 查询辐射源真实位置和侦察站位置
-            std::vector<COORD3> stationPositions_xyz;
-            for (const auto& device : selectedDevices) {
-                COORD3 pos_xyz = lbh2xyz(device.getLongitude(), device.getLatitude(), device.getAltitude());
-                stationPositions_xyz.push_back(pos_xyz);
-            }
-            
-            COORD3 sourcePos_xyz = lbh2xyz(selectedSource.getLongitude(), selectedSource.getLatitude(), selectedSource.getAltitude());
-            
-            // 计算TDOA值（用于绘制双曲线）- 与定位算法保持一致
-            // 首先计算所有站点的TOA值
-            std::vector<double> true_toas(selectedDevices.size());
-            for (size_t i = 0; i < selectedDevices.size(); ++i) {
-                true_toas[i] = calculateDistance(stationPositions_xyz[i], sourcePos_xyz) / Constants::c;
-            }
-
-            // 使用第一个侦察站作为参考站（与定位算法一致）
-            int ref_idx = 0;
-            std::cout << "\n[双曲线绘制] 使用侦察站 " << ref_idx << " (" << selectedDevices[ref_idx].getDeviceName() << ") 作为参考站。" << std::endl;
-
-            // 应用ESM TOA误差到参考站TOA值 - 与定位算法保持一致
-            std::vector<double> measured_toas = true_toas;
-            if (m_esmToaError != 0.0) {
-                measured_toas[ref_idx] += m_esmToaError;
-                std::cout << "[双曲线绘制] 应用ESM TOA误差 " << m_esmToaError * 1e6 << " μs 到参考站" << std::endl;
-                std::cout << "[双曲线绘制] 参考站TOA值变化: " << true_toas[ref_idx] * 1e6 << " μs -> " 
-                          << measured_toas[ref_idx] * 1e6 << " μs" << std::endl;
-            }
-
-            // 计算相对于参考站的TDOA值，与定位算法完全一致
-            // 创建正确大小的TDOA数组：站点数量-1
-            std::vector<double> tdoas(selectedDevices.size() - 1);
-            for (size_t i = 1; i < selectedDevices.size(); ++i) {
-                // 使用与定位算法相同的计算方式: tdoa = toa_i - toa_ref
-                // 注意：TDOA数组索引从0开始，对应站点索引从1开始
-                tdoas[i-1] = true_toas[i] - measured_toas[ref_idx]; // 使用已应用误差的参考站TOA
-
-                // 使用与TDOA算法相同的精度输出
-                std::cout << std::scientific << std::setprecision(6);
-                std::cout << "站点 " << i << " (" << selectedDevices[i].getDeviceName() << ") 相对于参考站的TDOA: "
-                         << tdoas[i-1] << " 秒 (" << tdoas[i-1] * 1e6 << " μs)" << std::endl;
-
-                // 检查是否可以构造双曲线
-                double focusDistance = calculateDistance(stationPositions_xyz[0], stationPositions_xyz[i]);
-                double distanceDiff = std::abs(tdoas[i-1]) * Constants::c;
-                
-                // 恢复固定精度输出
-                std::cout << std::fixed << std::setprecision(3);
-                std::cout << "焦距 = " << focusDistance << " 米，距离差 = " << distanceDiff << " 米" << std::endl;
-
-                if (distanceDiff >= focusDistance) {
-                    std::cout << "警告: TDOA距离差(" << distanceDiff << " 米)大于等于焦距("
-                             << focusDistance << " 米)，无法构造双曲线" << std::endl;
-                } else {
-                    std::cout << "距离差/焦距比率 = " << distanceDiff / focusDistance << std::endl;
-                }
-
-                std::cout << "========================" << std::endl;
-            }
-            
-            // 使用HyperbolaLines类绘制双曲线
-            std::vector<std::string> colors = {"#FF0000", "#00FF00", "#0000FF", "#FF00FF"};
-            
-            // 添加双曲线绘制前的调试信息
-            std::cout << "\n========= 开始绘制双曲线 =========" << std::endl;
-            std::cout << "侦察站数量: " << stationPositions_xyz.size() << std::endl;
-            std::cout << "TDOA值数量: " << tdoas.size() << std::endl;
-            
-            // 使用与TDOA算法相同的精度输出TDOA值
-            std::cout << std::scientific << std::setprecision(6);
-            for (size_t i = 0; i < tdoas.size(); ++i) {
-                std::cout << "TDOA[" << i+1 << "] = " << tdoas[i] << " 秒" << std::endl;
-            }
-            std::cout << "TDOA RMS误差: " << m_tdoaRmsError << " 秒 (" << m_tdoaRmsError * 1e9 << " ns)" << std::endl;
-            std::cout << "ESM TOA误差: " << m_esmToaError << " 秒 (" << m_esmToaError * 1e9 << " ns)" << std::endl;
-            
-            // 先清除地图上的所有实体
-            mapView->clearMarkers();
-            
-            // 添加侦察设备标记
-            for (const auto& device : selectedDevices) {
-                mapView->addMarker(
-                    device.getLongitude(),
-                    device.getLatitude(),
-                    device.getDeviceName(),
-                    "",
-                    "red"
-                );
-            }
-            
-            // 添加辐射源标记
+        // 先清除地图上的所有实体
+        mapView->clearMarkers();
+        
+        // 添加侦察设备标记
+        for (const auto& device : selectedDevices) {
             mapView->addMarker(
-                result.longitude,
-                result.latitude,
-                selectedSource.getRadiationName(),
+                device.getLongitude(),
+                device.getLatitude(),
+                device.getDeviceName(),
                 "",
-                "blue"
+                "red"
             );
-            
-            // 生成TDOA误差点和误差圆
-            // 创建一个结构体存储定位结果的大地坐标
-            COORD3 resultLBH;
-            resultLBH.p1 = result.longitude;
-            resultLBH.p2 = result.latitude;
-            resultLBH.p3 = result.altitude;
-            
-            // 使用calculateTDOAErrorCircle函数生成误差点和误差圆
-            TDOAResult tdoaResult = calculateTDOAErrorCircle(
-                deviceNames,
-                sourceName,
-                m_tdoaRmsError,
-                m_esmToaError,
-                0  // 随机种子,0表示系统当前时间
-            );
-            
-            // 显示误差点和误差圆
-            showErrorPointsOnMap(mapView, tdoaResult.estimatedPoints);
-            showErrorCircleOnMap(mapView, resultLBH, tdoaResult.cepRadius);
-            
-            // 尝试使用JavaScript直接检查Cesium是否加载
-            std::string checkScript = "if (typeof viewer !== 'undefined') { console.log('Cesium已加载'); } else { console.log('Cesium未加载'); }";
-            mapView->executeScript(checkScript);
-            
-            // 添加调试代码，测试基本的JavaScript执行是否正常
-            std::string testScript = "try {\n"
-                                   "  var testEntity = viewer.entities.add({\n"
-                                   "    position: Cesium.Cartesian3.fromDegrees(116.0, 39.0, 0),\n"
-                                   "    point: { pixelSize: 10, color: Cesium.Color.RED }\n"
-                                   "  });\n"
-                                   "  console.log('测试实体添加成功');\n"
-                                   "} catch(e) {\n"
-                                   "  console.error('测试实体添加失败: ' + e.message);\n"
-                                   "}\n";
-            mapView->executeScript(testScript);
-            
-            bool drawSuccess = HyperbolaLines::drawTDOAHyperbolas(
-                mapView,
-                stationPositions_xyz,
-                tdoas,
-                sourcePos_xyz,
-                colors,
-                m_tdoaRmsError * 1e9,  // 转换为纳秒
-                m_esmToaError * 1e9    // 转换为纳秒
-            );
-            
-            // 保存多平台仿真任务信息到数据库
-            MultiPlatformTask task;
-            task.techSystem = "TDOA";
-            task.radiationId = selectedSource.getRadiationId();
-            task.executionTime = simulationTime;
-            task.targetLongitude = result.longitude;
-            task.targetLatitude = result.latitude;
-            task.targetAltitude = result.altitude;
-            task.movementSpeed = 0.0f;  // 静止目标
-            task.movementAzimuth = 0.0;
-            task.movementElevation = 0.0;
-            task.positioningTime = simulationTime;
-            task.positioningAccuracy = result.accuracy;
-            task.deviceIds = deviceIds;
-            
-            int taskId;
-            if (!MultiPlatformTaskDAO::getInstance().addMultiPlatformTask(task, taskId)) {
-                std::cerr << "多平台仿真任务保存失败" << std::endl;
-            }
-        } else {
-            if (m_view) {
-                m_view->updateResult("<span color='red'>仿真计算失败</span>");
-            }
         }
-    } else if (systemType == "测向体制") {
-        // 使用测向定位算法实现
-        DirectionFinding& algorithm = DirectionFinding::getInstance();
         
-        // 初始化算法参数
-        algorithm.init(deviceNames, sourceName, simulationTime);
+        // 添加辐射源标记
+        mapView->addMarker(
+            result.longitude,
+            result.latitude,
+            selectedSource.getRadiationName(),
+            "",
+            "blue"
+        );
         
-        // 获取测向误差参数
-        double dev1MeanError = m_view->getDFMeanError(0);
-        double dev1StdDev = m_view->getDFStdDev(0);
-        double dev2MeanError = m_view->getDFMeanError(1);
-        double dev2StdDev = m_view->getDFStdDev(1);
+        showCoverageOverlay(mapView, coverage);
         
-        // 执行算法，传入误差参数
-        bool success = algorithm.calculate(dev1MeanError, dev1StdDev, dev2MeanError, dev2StdDev);
+        // 显示误差点和误差圆
+        showErrorPointsOnMap(mapView, tdoaResult.estimatedPoints);
+        showErrorCircleOnMap(mapView, resultLBH, tdoaResult.cepRadius);
         
-        if (success) {
-            auto result = algorithm.getResult();
-            
-            // 将空间直角坐标转换为大地坐标
-            COORD3 resultLBH = result.position;
-            
-            // 计算方位角和俯仰角（以第一个设备为参考）
-            ReconnaissanceDevice& device1 = selectedDevices[0];
-            COORD3 device1Pos = lbh2xyz(device1.getLongitude(), device1.getLatitude(), device1.getAltitude());
-            
-            // 计算从设备到计算位置的向量
-            COORD3 resultPos = lbh2xyz(resultLBH.p1, resultLBH.p2, resultLBH.p3);
-            double dx = resultPos.p1 - device1Pos.p1;
-            double dy = resultPos.p2 - device1Pos.p2;
-            double dz = resultPos.p3 - device1Pos.p3;
-            
-            // 计算水平距离
-            double horizontalDist = std::sqrt(dx*dx + dy*dy);
-            
-            // 计算方位角（相对北方向的水平角度）
-            double azimuth = std::atan2(dx, dy) * Constants::RAD2DEG;
-            if (azimuth < 0) azimuth += 360.0;
-            
-            // 计算俯仰角（相对水平面的仰角）
-            double elevation = std::atan2(dz, horizontalDist) * Constants::RAD2DEG;
-            
-            // 输出结果
-            std::stringstream ss;
-            ss << std::fixed << std::setprecision(6);
-            ss << "定位结果：\n";
-            ss << "经度: " << resultLBH.p1 << " 度\n";
-            ss << "纬度: " << resultLBH.p2 << " 度\n";
-            ss << std::setprecision(2);
-            ss << "高度: " << selectedSource.getAltitude() << " 米\n";
-            ss << "定位误差: " << result.error << " 米\n";
-            
-            // 更新视图
-            m_view->updateResult(ss.str());
-            
-            // 保存多平台仿真任务信息到数据库
-            MultiPlatformTask task;
-            task.techSystem = "TDOA"; // 使用数据库支持的值，将DF归入TDOA类别
-            task.radiationId = selectedSource.getRadiationId();
-            task.executionTime = simulationTime;
-            task.targetLongitude = resultLBH.p1;
-            task.targetLatitude = resultLBH.p2;
-            task.targetAltitude = resultLBH.p3;
-            
-            // 添加默认的运动参数
-            task.movementSpeed = 0.0f;  // 静止目标
-            task.movementAzimuth = 0.0;
-            task.movementElevation = 0.0;
-            
-            task.azimuth = azimuth;
-            task.elevation = elevation;
-            // task.positioningDistance = distance;
-            task.positioningTime = simulationTime;
-            
-            // 限制精度值，避免数据库溢出
-            task.positioningAccuracy = result.error;
-            task.deviceIds = deviceIds;
-            
-            int taskId;
-            MultiPlatformTaskDAO::getInstance().addMultiPlatformTask(task, taskId);
+        // 尝试使用JavaScript直接检查Cesium是否加载
+        std::string checkScript = "if (typeof viewer !== 'undefined') { console.log('Cesium已加载'); } else { console.log('Cesium未加载'); }";
+        mapView->executeScript(checkScript);
+        
+        // 添加调试代码，测试基本的JavaScript执行是否正常
+        std::string testScript = "try {\n"
+                               "  var testEntity = viewer.entities.add({\n"
+                               "    position: Cesium.Cartesian3.fromDegrees(116.0, 39.0, 0),\n"
+                               "    point: { pixelSize: 10, color: Cesium.Color.RED }\n"
+                               "  });\n"
+                               "  console.log('测试实体添加成功');\n"
+                               "} catch(e) {\n"
+                               "  console.error('测试实体添加失败: ' + e.message);\n"
+                               "}\n";
+        mapView->executeScript(testScript);
+        
+        HyperbolaLines::drawTDOAHyperbolas(
+            mapView,
+            stationPositions_xyz,
+            tdoas,
+            sourcePos_xyz,
+            colors,
+            tdoaRmsError * 1e9,  // 转换为纳秒
+            esmToaError * 1e9    // 转换为纳秒
+        );
+    };
+}
 
-            // 执行轨迹动画
-            TrajectorySimulator::getInstance().animateMultipleDevicesMovement(
+// 后台任务：测向体制定位
+JobExecutor::Completion MultiPlatformController::runDFJob(JobContext& context, const SimulationSetup& setup) {
+    const std::vector<ReconnaissanceDevice>& selectedDevices = setup.selectedDevices;
+    const RadiationSource& selectedSource = setup.selectedSource;
+    const double simulationTime = setup.simulationTime;
+    
+    // 每个侦察站一组测向误差(均值误差,标准差)；界面只提供两组参数，多出的侦察站沿用最后一组
+    const size_t errorCount = sizeof(setup.dfStdDev) / sizeof(setup.dfStdDev[0]);
+    std::vector<std::tuple<double, double>> deviceErrors;
+    std::vector<double> errorMeans, errorSigmas;
+    for (size_t i = 0; i < selectedDevices.size(); ++i) {
+        const size_t k = std::min(i, errorCount - 1);
+        deviceErrors.emplace_back(setup.dfMeanError[k], setup.dfStdDev[k]);
+        errorMeans.push_back(setup.dfMeanError[k]);
+        errorSigmas.push_back(setup.dfStdDev[k]);
+    }
+    
+    // 每个任务使用独立的测向定位算法实例
+    DirectionFinding algorithm;
+    
+    // 初始化算法参数
+    algorithm.init(setup.deviceNames, setup.sourceName, simulationTime);
+    
+    // 执行算法，传入误差参数
+    context.setProgress(0.2, "测向交叉定位解算");
+    bool success = algorithm.calculate(deviceErrors);
+    
+    if (!success) return nullptr;
+    if (context.isCancelled()) return nullptr;
+    
+    auto result = algorithm.getResult();
+    
+    // 将空间直角坐标转换为大地坐标
+    COORD3 resultLBH = result.position;
+    
+    // 计算方位角和俯仰角（以第一个设备为参考）
+    const ReconnaissanceDevice& device1 = selectedDevices[0];
+    COORD3 device1Pos = lbh2xyz(device1.getLongitude(), device1.getLatitude(), device1.getAltitude());
+    
+    // 计算从设备到计算位置的向量
+    COORD3 resultPos = lbh2xyz(resultLBH.p1, resultLBH.p2, resultLBH.p3);
+    double dx = resultPos.p1 - device1Pos.p1;
+    double dy = resultPos.p2 - device1Pos.p2;
+    double dz = resultPos.p3 - device1Pos.p3;
+    
+    // 计算水平距离
+    double horizontalDist = std::sqrt(dx*dx + dy*dy);
+    
+    // 计算方位角（相对北方向的水平角度）
+    double azimuth = std::atan2(dx, dy) * Constants::RAD2DEG;
+    if (azimuth < 0) azimuth += 360.0;
+    
+    // 计算俯仰角（相对水平面的仰角）
+    double elevation = std::atan2(dz, horizontalDist) * Constants::RAD2DEG;
+    
+    // 输出结果
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(6);
+    ss << "定位结果：\n";
+    ss << "经度: " << resultLBH.p1 << " 度\n";
+    ss << "纬度: " << resultLBH.p2 << " 度\n";
+    ss << std::setprecision(2);
+    ss << "高度: " << resultLBH.p3 << " 米\n";
+    ss << "定位误差: " << result.error << " 米\n";
+    ss << "CEP: " << result.cep << " 米\n";
+    
+    // 误差圆计算
+    context.setProgress(0.4, "计算误差圆");
+    MonteCarloConfig errorCircleConfig;
+    errorCircleConfig.cancelFlag = context.cancelFlag();
+    std::vector<COORD3> stationPos_xyz;
+    for (const auto& device : selectedDevices) {
+        stationPos_xyz.push_back(lbh2xyz(device.getLongitude(), device.getLatitude(), device.getAltitude()));
+    }
+    const COORD3 sourcePos_xyz = lbh2xyz(selectedSource.getLongitude(), selectedSource.getLatitude(),
+                                         selectedSource.getAltitude());
+    DFResult dfResult = calculateDFErrorCircle(
+        stationPos_xyz,
+        sourcePos_xyz,
+        errorMeans,                // 使用从视图获取的误差参数，每站一组
+        errorSigmas,
+        errorCircleConfig          // 随机种子为0，表示取当前任务的随机流
+    );
+    if (context.isCancelled()) return nullptr;
+    if (dfResult.ellipse.valid) {
+        ss << "误差椭圆: 长半轴 " << dfResult.ellipse.majorAxis << " 米, 短半轴 " << dfResult.ellipse.minorAxis
+           << " 米, 长轴方位 " << dfResult.ellipse.orientation << " 度\n";
+    }
+
+    context.setProgress(0.8, "计算精度热力图");
+    CoverageOverlay coverage = computeCoverageOverlay(setup, CoverageSystem::DF);
+    if (context.isCancelled()) return nullptr;
+    if (coverage.valid) {
+        ss << "精度热力图CEP: " << coverage.minCep << " ~ " << coverage.maxCep << " 米(绿~红)\n";
+    }
+    
+    // 保存多平台仿真任务信息到数据库
+    context.setProgress(0.9, "保存仿真任务");
+    MultiPlatformTask task;
+    task.techSystem = "TDOA"; // 使用数据库支持的值，将DF归入TDOA类别
+    task.radiationId = selectedSource.getRadiationId();
+    task.executionTime = simulationTime;
+    task.targetLongitude = resultLBH.p1;
+    task.targetLatitude = resultLBH.p2;
+    task.targetAltitude = resultLBH.p3;
+    
+    // 添加默认的运动参数
+    task.movementSpeed = 0.0f;  // 静止目标
+    task.movementAzimuth = 0.0;
+    task.movementElevation = 0.0;
+    
+    task.azimuth = azimuth;
+    task.elevation = elevation;
+    // task.positioningDistance = distance;
+    task.positioningTime = simulationTime;
+    
+    // 限制精度值，避免数据库溢出
+    task.positioningAccuracy = result.error;
+    task.deviceIds = setup.deviceIds;
+    
+    int taskId;
+    MultiPlatformTaskDAO::getInstance().addMultiPlatformTask(task, taskId);
+    
+    std::string resultText = ss.str();
+    return [this, resultText, selectedDevices, selectedSource, simulationTime, resultLBH, dfResult,
+            deviceErrors, coverage]() {
+        if (!m_view) return;
+        
+        // 更新视图
+        m_view->updateResult(resultText);
+        
+        MapView* mapView = m_view->getMapView();
+        if (!mapView) return;
+
+        showCoverageOverlay(mapView, coverage);
+
+        // 执行轨迹动画
+        TrajectoryAnimator::getInstance().animateMultipleDevicesMovement(
+            mapView,
+            selectedDevices,
+            selectedSource,
+            simulationTime,
+            resultLBH.p1,  // 使用计算的位置
+            resultLBH.p2,
+            resultLBH.p3
+        );
+        
+        // 误差圆显示
+        showErrorPointsOnMap(mapView, dfResult.estimatedPoints);
+        // 圆心用定位结果的空间直角坐标
+        showErrorCircleOnMap(mapView, resultLBH, dfResult.cepRadius);
+
+        // 显示测向误差线
+        DirectionErrorLines directionErrorLines;
+        m_view->clearDirectionErrorLines(); // 清除可能存在的旧线
+        
+        // 设置颜色，站数多于颜色数时循环使用
+        const std::vector<std::string> colors = {"#FF0000", "#0000FF", "#00FF00", "#FF00FF", "#FFA500", "#00FFFF"};
+        
+        // 为参与解算的每个设备绘制测向线 - 使用该站的误差参数
+        for (size_t i = 0; i < selectedDevices.size(); ++i) {
+            const double meanError = std::get<0>(deviceErrors[i]);
+            const double stdDev = std::get<1>(deviceErrors[i]);
+            
+            // 使用计算的定位结果位置，而不是真实辐射源位置
+            // 这样测向线会指向计算结果，而不是真实目标位置
+            directionErrorLines.showDirectionSimulationLines(
                 mapView,
-                selectedDevices,
-                selectedSource,
-                simulationTime,
-                resultLBH.p1,  // 使用计算的位置
-                resultLBH.p2,
-                resultLBH.p3
-            );
-            
-            // 误差圆计算与显示
-            DFResult dfResult = calculateDFErrorCircle(
-                deviceNames,
-                sourceName,
-                dev1MeanError, dev1StdDev, // 使用从视图获取的误差参数，而不是固定值
-                dev2MeanError, dev2StdDev,
-                0 // 随机种子,0表示系统当前时间      
+                selectedDevices[i],
+                resultLBH.p1,   // 使用计算的定位结果经度
+                resultLBH.p2,   // 使用计算的定位结果纬度
+                resultLBH.p3,   // 使用计算的定位结果高度
+                meanError,      // 均值误差
+                stdDev,         // 标准差
+                colors[i % colors.size()],  // 不同设备使用不同颜色
+                40000.0         // 足够长的线
             );
-            showErrorPointsOnMap(mapView, dfResult.estimatedPoints);
-            // 圆心用定位结果的空间直角坐标
-            showErrorCircleOnMap(mapView, resultLBH, dfResult.cepRadius);
+        }
+    };
+}
 
-            // 显示测向误差线
-            DirectionErrorLines directionErrorLines;
-            m_view->clearDirectionErrorLines(); // 清除可能存在的旧线
-            
-            // 设置颜色
-            const std::string colors[] = {"#FF0000", "#0000FF"};
-            
-            // 为每个设备绘制测向线 - 使用从视图获取的误差参数
-            for (size_t i = 0; i < selectedDevices.size() && i < 2; ++i) {
-                double meanError = (i == 0) ? dev1MeanError : dev2MeanError;
-                double stdDev = (i == 0) ? dev1StdDev : dev2StdDev;
-                
-                // 使用计算的定位结果位置，而不是真实辐射源位置
-                // 这样测向线会指向计算结果，而不是真实目标位置
-                directionErrorLines.showDirectionSimulationLines(
-                    mapView,
-                    selectedDevices[i],
-                    resultLBH.p1,   // 使用计算的定位结果经度
-                    resultLBH.p2,   // 使用计算的定位结果纬度
-                    resultLBH.p3,   // 使用计算的定位结果高度
-                    meanError,      // 均值误差
-                    stdDev,         // 标准差
-                    colors[i],      // 不同设备使用不同颜色
-                    40000.0         // 足够长的线
-                );
-                
-            }
+// 后台任务：按选中侦察站布局计算精度热力图(CRLB圆概率误差)
+MultiPlatformController::CoverageOverlay MultiPlatformController::computeCoverageOverlay(
+    const SimulationSetup& setup, CoverageSystem system) {
+    CoverageOverlay overlay;
+    if (!setup.showCoverage || setup.selectedDevices.empty()) return overlay;
+    
+    const RadiationSource& source = setup.selectedSource;
+    CoverageScenario scenario;
+    scenario.system = system;
+    scenario.targetAltitude = source.getAltitude();
+    for (const auto& device : setup.selectedDevices) {
+        scenario.stations.push_back({device.getLongitude(), device.getLatitude(), device.getAltitude()});
+        if (system == CoverageSystem::FDOA) {
+            scenario.stationVelocities.push_back(velocity_lbh2xyz(device.getLongitude(), device.getLatitude(),
+                device.getMovementSpeed(), device.getMovementAzimuth(), device.getMovementElevation()));
         }
     }
-} 
\ No newline at end of file
+    
+    if (system == CoverageSystem::TDOA) {
+        scenario.tdoaSigma = setup.tdoaRmsError;
+    } else if (system == CoverageSystem::FDOA) {
+        scenario.fdoaSigma = 0.01;  // 与频差定位的多普勒测量误差一致(Hz)
+        scenario.carrierFrequency = source.getCarrierFrequency() * 1e9;  // GHz转换为Hz
+    } else {
+        // 每个侦察站一个测向误差；界面只提供两组参数，多出的侦察站沿用最后一组，与测向定位算法一致
+        const size_t sigmaCount = sizeof(setup.dfStdDev) / sizeof(setup.dfStdDev[0]);
+        scenario.bearingSigmaDeg.clear();
+        for (size_t i = 0; i < scenario.stations.size(); ++i) {
+            scenario.bearingSigmaDeg.push_back(setup.dfStdDev[std::min(i, sigmaCount - 1)]);
+        }
+    }
+    
+    // 范围取侦察站和辐射源的外包矩形，各边外扩一倍跨度，跨度至少0.2度
+    double west = source.getLongitude(), east = west;
+    double south = source.getLatitude(), north = south;
+    for (const auto& station : scenario.stations) {
+        west = std::min(west, station.p1);
+        east = std::max(east, station.p1);
+        south = std::min(south, station.p2);
+        north = std::max(north, station.p2);
+    }
+    const double lonSpan = std::max(east - west, 0.2);
+    const double latSpan = std::max(north - south, 0.2);
+    const double centerLon = 0.5 * (west + east);
+    const double centerLat = 0.5 * (south + north);
+    
+    CoverageGridSpec spec;
+    spec.west = centerLon - 1.5 * lonSpan;
+    spec.east = centerLon + 1.5 * lonSpan;
+    spec.south = std::max(-89.0, centerLat - 1.5 * latSpan);
+    spec.north = std::min(89.0, centerLat + 1.5 * latSpan);
+    spec.width = 512;
+    const double groundAspect = (spec.north - spec.south) /
+        ((spec.east - spec.west) * std::max(0.1, std::cos(centerLat * Constants::DEG2RAD)));
+    spec.height = std::min(1024, std::max(128, static_cast<int>(std::lround(spec.width * groundAspect))));
+    
+    CoverageGrid grid;
+    if (!CoverageMapEngine::getInstance().compute(scenario, spec, grid)) return overlay;
+    if (!coverageValueRange(grid.cep, overlay.minCep, overlay.maxCep)) return overlay;
+    
+    overlay.west = grid.west;
+    overlay.south = grid.south;
+    overlay.east = grid.east;
+    overlay.north = grid.north;
+    overlay.width = grid.width;
+    overlay.height = grid.height;
+    overlay.rgba = colorizeCoverage(grid.cep, overlay.minCep, overlay.maxCep);
+    overlay.valid = true;
+    PL_LOG_DEBUG("精度热力图 %dx%d，新计算瓦片 %zu 个，缓存命中 %zu 个，CEP %.1f ~ %.1f 米\n",
+                 grid.width, grid.height, grid.tilesComputed, grid.tilesCached, overlay.minCep, overlay.maxCep);
+    return overlay;
+}
+
+// 在地图上显示精度热力图，未计算时移除上一次的热力图
+void MultiPlatformController::showCoverageOverlay(MapView* mapView, const CoverageOverlay& overlay) {
+    if (!mapView) return;
+    if (!overlay.valid) {
+        mapView->removeImageOverlay("coverage");
+        return;
+    }
+    mapView->showImageOverlay("coverage", overlay.west, overlay.south, overlay.east, overlay.north,
+                              overlay.width, overlay.height, overlay.rgba);
+}
@@ -7,6 +7,7 @@
 #include "../../models/InterferometerPositioning.h"
 #include "../../models/SinglePlatformTDOA.h"
 #include "../../models/TrajectorySimulator.h"
+#include "../../utils/Log.h"
 #include <iostream>
 #include <cmath>    // 添加数学函数头文件
 #include <ctime>    // 添加时间函数头文件
@@ -24,8 +25,6 @@ SinglePlatformController& SinglePlatformController::getInstance() {
 
 // 构造函数
 SinglePlatformController::SinglePlatformController() : m_view(nullptr), m_lastErrorFactors() {
-    // 初始化随机数种子
-    srand(time(NULL));
 }
 
 // 析构函数
@@ -40,10 +39,8 @@ void SinglePlatformController::init(SinglePlatformView* view) {
 
 // 启动仿真
 void SinglePlatformController::startSimulation() {
-    g_print("\n====== 单平台仿真按钮被点击 ======\n");
-    
     if (!m_view) {
-        g_print("错误：SinglePlatformController的m_view为空，控制器未正确初始化\n");
+        PL_LOG_ERROR("错误：SinglePlatformController的m_view为空，控制器未正确初始化\n");
         return;
     }
     
@@ -53,72 +50,87 @@ void SinglePlatformController::startSimulation() {
     std::string sourceName = m_view->getSelectedSource();
     int simulationTime = m_view->getSimulationTime();
     
-    g_print("开始单平台仿真...\n");
-    g_print("技术体制: %s\n", techSystem.c_str());
-    g_print("侦察设备: %s\n", deviceName.c_str());
-    g_print("辐射源: %s\n", sourceName.c_str());
-    g_print("仿真时间: %d秒\n", simulationTime);
-    
-    // 根据选择的设备名称获取对应的模型对象
-    ReconnaissanceDevice device;
-    bool deviceFound = false;
+    PL_LOG_INFO("开始单平台仿真：技术体制 %s，侦察设备 %s，辐射源 %s，仿真时间 %d秒\n",
+                techSystem.c_str(), deviceName.c_str(), sourceName.c_str(), simulationTime);
     
-    // 从DAO获取设备
-    std::vector<ReconnaissanceDevice> devices = ReconnaissanceDeviceDAO::getInstance().getAllReconnaissanceDevices();
-    for (const auto& d : devices) {
-        if (d.getDeviceName() == deviceName) {
-            device = d;
-            deviceFound = true;
-            break;
+    // 数据库查询和定位计算在后台任务中执行，地图和界面在完成回调中(主线程)更新
+    JobCallbacks callbacks;
+    callbacks.onFinished = [this](int jobId, JobStatus status, const std::string& error) {
+        m_jobIds.erase(jobId);
+        if (status == JobStatus::Failed && m_view) {
+            m_view->showErrorMessage("仿真失败：" + error);
+        } else if (status == JobStatus::Cancelled) {
+            PL_LOG_INFO("单平台仿真任务 #%d 已取消\n", jobId);
         }
+    };
+    
+    int jobId = JobExecutor::getInstance().submit(
+        "单平台" + techSystem + "仿真",
+        [this, techSystem, deviceName, sourceName, simulationTime](JobContext& context) {
+            return runSimulationJob(context, techSystem, deviceName, sourceName, simulationTime);
+        },
+        callbacks
+    );
+    m_jobIds.insert(jobId);
+}
+
+// 取消本控制器提交的全部仿真任务
+void SinglePlatformController::cancelSimulation() {
+    for (int jobId : m_jobIds) {
+        JobExecutor::getInstance().cancel(jobId);
     }
+}
+
+// 后台任务：查找设备和辐射源并执行定位算法，返回在主线程显示结果的完成回调
+JobExecutor::Completion SinglePlatformController::runSimulationJob(JobContext& context,
+                                                                   const std::string& techSystem,
+                                                                   const std::string& deviceName,
+                                                                   const std::string& sourceName,
+                                                                   int simulationTime) {
+    // 根据选择的设备名称获取对应的模型对象
+    ReconnaissanceDevice device;
+    const bool deviceFound = ReconnaissanceDeviceDAO::getInstance().findReconnaissanceDeviceByName(deviceName, device);
     
     if (!deviceFound) {
         std::string errorMsg = "错误：未找到侦察设备 '" + deviceName + "'";
-        g_print("%s\n", errorMsg.c_str());
-        if (m_view) m_view->showErrorMessage(errorMsg);
-        return;
+        PL_LOG_ERROR("%s\n", errorMsg.c_str());
+        return [this, errorMsg]() {
+            if (m_view) m_view->showErrorMessage(errorMsg);
+        };
     }
     
     // 验证侦察设备必须是移动设备
     if (device.getIsStationary()) {
         std::string errorMsg = "错误：单平台仿真要求侦察设备必须是移动设备";
-        g_print("%s\n", errorMsg.c_str());
-        if (m_view) m_view->showErrorMessage(errorMsg);
-        return;
+        PL_LOG_ERROR("%s\n", errorMsg.c_str());
+        return [this, errorMsg]() {
+            if (m_view) m_view->showErrorMessage(errorMsg);
+        };
     }
     
     // 获取辐射源对象
     RadiationSource source;
-    bool sourceFound = false;
-    
-    // 从DAO获取辐射源
-    std::vector<RadiationSource> sources = RadiationSourceDAO::getInstance().getAllRadiationSources();
-    for (const auto& s : sources) {
-        if (s.getRadiationName() == sourceName) {
-            source = s;
-            sourceFound = true;
-            break;
-        }
-    }
+    const bool sourceFound = RadiationSourceDAO::getInstance().findRadiationSourceByName(sourceName, source);
     
     if (!sourceFound) {
         std::string errorMsg = "错误：未找到辐射源 '" + sourceName + "'";
-        g_print("%s\n", errorMsg.c_str());
-        if (m_view) m_view->showErrorMessage(errorMsg);
-        return;
+        PL_LOG_ERROR("%s\n", errorMsg.c_str());
+        return [this, errorMsg]() {
+            if (m_view) m_view->showErrorMessage(errorMsg);
+        };
     }
     
     // 验证辐射源必须是固定的
     if (!source.getIsStationary()) {
         std::string errorMsg = "错误：单平台仿真要求辐射源必须是固定的";
-        g_print("%s\n", errorMsg.c_str());
-        if (m_view) m_view->showErrorMessage(errorMsg);
-        return;
+        PL_LOG_ERROR("%s\n", errorMsg.c_str());
+        return [this, errorMsg]() {
+            if (m_view) m_view->showErrorMessage(errorMsg);
+        };
     }
     
-    g_print("使用侦察设备 ID: %d, 名称: %s\n", device.getDeviceId(), device.getDeviceName().c_str());
-    g_print("使用辐射源 ID: %d, 名称: %s\n", source.getRadiationId(), source.getRadiationName().c_str());
+    PL_LOG_DEBUG("使用侦察设备 ID: %d, 名称: %s\n", device.getDeviceId(), device.getDeviceName().c_str());
+    PL_LOG_DEBUG("使用辐射源 ID: %d, 名称: %s\n", source.getRadiationId(), source.getRadiationName().c_str());
     
     // // ====== 仿真前条件验证 ======
     // SimulationValidator validator;
@@ -131,6 +143,42 @@ void SinglePlatformController::startSimulation() {
     //     return;
     // }
     
+    if (context.isCancelled()) return nullptr;
+    
+    // 保存原始设备位置，用于定位计算
+    ReconnaissanceDevice originalDevice = device; // 保存原始设备数据，位置不会被修改
+    
+    // 执行仿真
+    LocationResult result;
+    
+    // 根据选择的技术体制执行不同的算法
+    // 使用原始设备位置进行定位计算，而不是移动后的位置
+    if (techSystem == "干涉仪体制") {
+        PL_LOG_DEBUG("执行干涉仪体制定位算法，使用原始设备位置：经度=%.6f°, 纬度=%.6f°, 高度=%.2fm\n",
+                     originalDevice.getLongitude(), originalDevice.getLatitude(), originalDevice.getAltitude());
+        result = InterferometerPositioning::getInstance().runSimulation(originalDevice, source, simulationTime);
+    } else if (techSystem == "时差体制") {
+        PL_LOG_DEBUG("执行时差体制定位算法，使用原始设备位置：经度=%.6f°, 纬度=%.6f°, 高度=%.2fm\n",
+                     originalDevice.getLongitude(), originalDevice.getLatitude(), originalDevice.getAltitude());
+        result = SinglePlatformTDOA::getInstance().runSimulation(originalDevice, source, simulationTime,
+                                                                 context.cancelFlag());
+    }
+    
+    if (context.isCancelled()) return nullptr;
+    
+    return [this, techSystem, device, source, result, simulationTime]() {
+        presentSimulationResult(techSystem, device, source, result, simulationTime);
+    };
+}
+
+// 在主线程显示单平台仿真结果：地图标记、设备移动动画、结果参数和误差表格
+void SinglePlatformController::presentSimulationResult(const std::string& techSystem,
+                                                       const ReconnaissanceDevice& device,
+                                                       const RadiationSource& source,
+                                                       const LocationResult& result,
+                                                       int simulationTime) {
+    if (!m_view) return;
+    
     // 设置初始地图视角
     MapView* mapView = m_view->getMapView();
     if (mapView) {
@@ -186,9 +234,6 @@ void SinglePlatformController::startSimulation() {
     // 执行设备移动仿真 - 使用轨迹仿真器
     ReconnaissanceDevice deviceCopy = device; // 使用副本，避免修改原始数据
     
-    // 保存原始设备位置，用于定位计算
-    ReconnaissanceDevice originalDevice = device; // 保存原始设备数据，位置不会被修改
-    
     std::vector<std::pair<double, double>> trajectoryPoints = 
         TrajectorySimulator::getInstance().simulateDeviceMovement(deviceCopy, simulationTime);
     
@@ -198,27 +243,10 @@ void SinglePlatformController::startSimulation() {
     // 仿真开始前清空参数
     m_view->clearSimulationResult();
     
-    // 执行仿真
-    LocationResult result;
-    
-    // 根据选择的技术体制执行不同的算法
-    // 使用原始设备位置进行定位计算，而不是移动后的位置
-    if (techSystem == "干涉仪体制") {
-        g_print("执行干涉仪体制定位算法...\n");
-        g_print("使用原始设备位置进行定位计算：经度=%.6f°, 纬度=%.6f°, 高度=%.2fm\n", 
-                originalDevice.getLongitude(), originalDevice.getLatitude(), originalDevice.getAltitude());
-        result = InterferometerPositioning::getInstance().runSimulation(originalDevice, source, simulationTime);
-    } else if (techSystem == "时差体制") {
-        g_print("执行时差体制定位算法...\n");
-        g_print("使用原始设备位置进行定位计算：经度=%.6f°, 纬度=%.6f°, 高度=%.2fm\n", 
-                originalDevice.getLongitude(), originalDevice.getLatitude(), originalDevice.getAltitude());
-        result = SinglePlatformTDOA::getInstance().runSimulation(originalDevice, source, simulationTime);
-    }
-    
     // 先设置仿真结果到缓存，确保animateDeviceMovement可以使用
     m_view->setSimulationResult(result.longitude, result.latitude, result.altitude, result.azimuth, result.elevation);
-    g_print("已设置仿真结果到缓存：经度=%.6f°, 纬度=%.6f°, 高度=%.2fm, 方位角=%.2f°, 俯仰角=%.2f°\n",
-            result.longitude, result.latitude, result.altitude, result.azimuth, result.elevation);
+    PL_LOG_DEBUG("已设置仿真结果到缓存：经度=%.6f°, 纬度=%.6f°, 高度=%.2fm, 方位角=%.2f°, 俯仰角=%.2f°\n",
+                 result.longitude, result.latitude, result.altitude, result.azimuth, result.elevation);
     
     // 更新视图显示结果文本
     char directionBuffer[100];
@@ -389,9 +417,8 @@ void SinglePlatformController::startSimulation() {
 void SinglePlatformController::loadModelData() {
     if (!m_view) return;
     
-    // 从DAO加载设备和辐射源数据
+    // 从DAO加载设备数据，辐射源列表由视图自行加载
     std::vector<ReconnaissanceDevice> devices = ReconnaissanceDeviceDAO::getInstance().getAllReconnaissanceDevices();
-    std::vector<RadiationSource> sources = RadiationSourceDAO::getInstance().getAllRadiationSources();
     
     // 更新视图中的设备列表
     if (m_view) {
@@ -1,7 +1,11 @@
 #include "../ApplicationController.h"
+#include "../../utils/Instrumentation.h"
 #include <iostream>
 
 int main(int argc, char** argv) {
+    // 日志级别和阶段计时由环境变量 PASSIVELOCATION_LOG_LEVEL / PASSIVELOCATION_TRACE 控制
+    Instrumentation::configureFromEnvironment();
+
     // 初始化应用程序控制器
     if (!ApplicationController::getInstance().init(argc, argv)) {
         std::cerr << "应用程序初始化失败" << std::endl;
@@ -11,5 +15,6 @@ int main(int argc, char** argv) {
     // 运行应用程序
     ApplicationController::getInstance().run();
     
+    Instrumentation::finish();
     return 0;
 } 
\ No newline at end of file
@@ -0,0 +1,238 @@
+#ifndef DB_CONNECTION_POOL_H
+#define DB_CONNECTION_POOL_H
+
+#include <mysql/mysql.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 数据库连接参数
+ */
+struct DBConfig {
+    std::string host;
+    std::string user;
+    std::string password;
+    std::string database;
+    unsigned int port = 3306;
+};
+
+/**
+ * @brief 预编译语句(MYSQL_STMT封装)
+ *
+ * 参数按类型绑定(整数、浮点、字符串、NULL)，不再拼接SQL文本；
+ * 查询结果由客户端库转换为文本缓存，按列读取时再转换为所需类型。
+ * 语句对象由所属连接缓存，只能在持有该连接的线程中使用。
+ */
+class PreparedStatement {
+public:
+    ~PreparedStatement();
+
+    PreparedStatement(const PreparedStatement&) = delete;
+    PreparedStatement& operator=(const PreparedStatement&) = delete;
+
+    const std::string& sql() const { return m_sql; }
+    std::size_t parameterCount() const { return m_params.size(); }
+
+    /**
+     * @brief 绑定参数，index 从0开始，对应SQL中 ? 的顺序
+     */
+    void bindInt(std::size_t index, long long value);
+    void bindDouble(std::size_t index, double value);
+    void bindString(std::size_t index, const std::string& value);
+    void bindNull(std::size_t index);
+
+    /**
+     * @brief 执行语句；查询语句的结果集缓存在客户端，随后用 fetch() 逐行读取
+     * @return 执行是否成功
+     */
+    bool execute();
+
+    /**
+     * @brief 读取下一行
+     * @return 没有更多行或出错时返回 false
+     */
+    bool fetch();
+
+    // 当前结果集的列信息和当前行的列值(col 从0开始)
+    std::size_t columnCount() const { return m_columns.size(); }
+    const std::string& columnName(std::size_t col) const { return m_columns[col].name; }
+    bool isNull(std::size_t col) const;
+    long long getInt(std::size_t col, long long defaultValue = 0) const;
+    double getDouble(std::size_t col, double defaultValue = 0.0) const;
+    std::string getString(std::size_t col, const std::string& defaultValue = std::string()) const;
+
+    unsigned long long insertId() const;
+    unsigned long long affectedRows() const;
+    unsigned int errorCode() const;
+    std::string error() const;
+
+private:
+    friend class PooledConnection;
+
+    // MySQL 8 使用 bool，旧版本使用 my_bool
+    using BindFlag = typename std::remove_pointer<decltype(MYSQL_BIND::is_null)>::type;
+
+    struct Param {
+        long long intValue = 0;
+        double doubleValue = 0.0;
+        std::string stringValue;
+        unsigned long length = 0;
+        BindFlag isNull = 0;
+    };
+
+    struct Column {
+        std::string name;
+        std::vector<char> buffer;
+        unsigned long length = 0;
+        BindFlag isNull = 0;
+        BindFlag truncated = 0;
+    };
+
+    PreparedStatement(MYSQL* conn, const std::string& sql);
+    bool isValid() const { return m_stmt != nullptr; }
+    void freeResult();
+    bool bindResultColumns();
+
+    MYSQL* m_conn;
+    MYSQL_STMT* m_stmt;
+    std::string m_sql;
+    std::vector<Param> m_params;
+    std::vector<MYSQL_BIND> m_paramBinds;
+    std::vector<Column> m_columns;
+    std::vector<MYSQL_BIND> m_resultBinds;
+    bool m_hasResult;
+};
+
+class DBConnectionPool;
+
+/**
+ * @brief 从连接池借出的连接，析构时自动归还
+ */
+class PooledConnection {
+public:
+    PooledConnection() : m_pool(nullptr), m_conn(nullptr) {}
+    PooledConnection(PooledConnection&& other) noexcept;
+    PooledConnection& operator=(PooledConnection&& other) noexcept;
+    ~PooledConnection();
+
+    PooledConnection(const PooledConnection&) = delete;
+    PooledConnection& operator=(const PooledConnection&) = delete;
+
+    explicit operator bool() const { return m_conn != nullptr; }
+
+    /**
+     * @brief 获取预编译语句，按SQL文本缓存在该连接上，只在首次使用时解析
+     * @return 预编译失败时返回 nullptr
+     */
+    PreparedStatement* prepare(const std::string& sql);
+
+    /**
+     * @brief 执行不带参数的语句(事务控制等)
+     */
+    bool execute(const std::string& sql);
+
+    // 事务控制，作用于当前借出的连接
+    bool beginTransaction() { return execute("START TRANSACTION"); }
+    bool commitTransaction() { return execute("COMMIT"); }
+    bool rollbackTransaction() { return execute("ROLLBACK"); }
+
+    MYSQL* get() const;
+    std::string error() const;
+
+private:
+    friend class DBConnectionPool;
+    struct Connection;
+
+    PooledConnection(DBConnectionPool* pool, Connection* conn) : m_pool(pool), m_conn(conn) {}
+    void release();
+
+    DBConnectionPool* m_pool;
+    Connection* m_conn;
+};
+
+/**
+ * @brief 线程安全的MySQL连接池(单例)
+ *
+ * 每个连接同一时刻只借给一个线程，后台仿真任务和界面线程可以并行读写数据库。
+ * 连接空闲超过健康检查间隔或上次使用时出现断线错误时，借出前先 mysql_ping，失败则重连。
+ */
+class DBConnectionPool {
+public:
+    /**
+     * @brief 连接池统计
+     */
+    struct Stats {
+        std::size_t acquisitions = 0;      // 借出次数
+        std::size_t waits = 0;             // 因无空闲连接而等待的次数
+        std::size_t reconnects = 0;        // 健康检查失败后的重连次数
+        std::size_t statementsPrepared = 0;  // 预编译次数
+        std::size_t statementCacheHits = 0;  // 预编译语句缓存命中次数
+    };
+
+    static DBConnectionPool& getInstance();
+
+    /**
+     * @brief 建立连接池，已初始化时先关闭原有连接
+     * @param config 连接参数
+     * @param poolSize 连接数
+     * @return 至少建立一个连接时返回 true；仍有连接借出未归还时拒绝重新初始化并返回 false
+     */
+    bool init(const DBConfig& config, std::size_t poolSize = 4);
+
+    /**
+     * @brief 关闭全部连接
+     * @return 仍有连接借出未归还时不关闭任何连接并返回 false，避免借出的句柄指向已释放的连接
+     */
+    bool shutdown();
+
+    bool isInitialized() const;
+
+    /**
+     * @brief 借出连接，池中无空闲连接时最多等待 timeoutMs 毫秒
+     * @return 未初始化或超时时返回空连接
+     */
+    PooledConnection acquire(int timeoutMs = 5000);
+
+    /**
+     * @brief 设置健康检查间隔：连接空闲超过该时长后借出前先检查
+     */
+    void setHealthCheckInterval(std::chrono::milliseconds interval);
+
+    std::size_t size() const;
+    std::size_t idleCount() const;
+    Stats getStats() const;
+
+private:
+    friend class PooledConnection;
+
+    DBConnectionPool();
+    ~DBConnectionPool();
+
+    DBConnectionPool(const DBConnectionPool&) = delete;
+    DBConnectionPool& operator=(const DBConnectionPool&) = delete;
+
+    MYSQL* openConnection() const;
+    // 以下两个函数要求调用方已持有 m_mutex
+    std::size_t borrowedCount() const { return m_connections.size() - m_idle.size(); }
+    void closeConnections();
+    void ensureHealthy(PooledConnection::Connection& conn);
+    void release(PooledConnection::Connection* conn);
+    void countStatement(bool cacheHit);
+
+    DBConfig m_config;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::vector<std::unique_ptr<PooledConnection::Connection>> m_connections;
+    std::vector<PooledConnection::Connection*> m_idle;
+    std::chrono::milliseconds m_healthCheckInterval;
+    Stats m_stats;
+};
+
+#endif // DB_CONNECTION_POOL_H
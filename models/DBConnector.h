@@ -5,8 +5,12 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
+#include "DBConnectionPool.h"
 
 // 数据库连接器
+// 初始化时同时建立连接池；DAO通过 acquire() 借用池中连接并使用预编译语句，
+// 单连接接口(getConnection/executeSQL/事务)保留给只在主线程执行的简单语句。
 class DBConnector {
 public:
     static DBConnector& getInstance();
@@ -23,6 +27,9 @@ public:
     // 获取MySQL连接句柄
     MYSQL* getConnection() { return m_conn; }
     
+    // 从连接池借用连接，可在任意线程调用；未连接时返回空连接
+    PooledConnection acquire() { return DBConnectionPool::getInstance().acquire(); }
+    
     // 事务控制
     bool beginTransaction();
     bool commitTransaction();
@@ -40,6 +47,7 @@ private:
     
     MYSQL* m_conn;      // MySQL连接句柄
     bool m_connected;   // 连接状态
+    std::recursive_mutex m_mutex;  // 保护m_conn的互斥锁，单连接不可跨线程并发使用
     
     // 处理MySQL错误
     void handleError();
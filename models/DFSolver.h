@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../utils/CoordinateTransform.h"
+#include <Eigen/Dense>
+#include <limits>
+#include <vector>
+
+// 单个侦察站的测向观测，角度在侦察站当地东-北-天坐标系中定义
+struct DFBearing {
+    COORD3 station;               // 侦察站大地坐标(经度,纬度,高程)
+    double azimuth = 0.0;         // 方位角（度），正北起顺时针
+    double elevation = 0.0;       // 俯仰角（度），水平面起向上
+    double azimuthSigma = 1.0;    // 方位角测量标准差（度）
+    double elevationSigma = 0.0;  // 俯仰角测量标准差（度），<=0 表示该站只测方位
+};
+
+// 测向定位求解参数
+struct DFSolverOptions {
+    double knownAltitude = std::numeric_limits<double>::quiet_NaN();  // 目标已知高度（米），NaN 时三维求解
+    double altitudeSigma = 1.0;   // 已知高度约束的标准差（米）
+    int maxIterations = 10;       // 高斯-牛顿最大迭代次数
+    double tolerance = 1e-3;      // 位置修正量收敛门限（米）
+    bool quiet = false;           // 为true时几何退化不输出日志，由调用方汇总(如蒙特卡洛并行试验)
+};
+
+// 测向定位结果
+struct DFSolution {
+    COORD3 position;                                          // 估计位置（空间直角坐标）
+    COORD3 positionLbh;                                       // 估计位置（大地坐标）
+    Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();     // 位置协方差（空间直角坐标，米^2）
+    Eigen::Matrix3d covarianceEnu = Eigen::Matrix3d::Zero();  // 位置协方差（以站阵中心为原点的东-北-天，米^2）
+    std::vector<double> azimuthResiduals;                     // 各站方位角残差（度），测量值-预测值
+    std::vector<double> elevationResiduals;                   // 各站俯仰角残差（度），未测俯仰的站为0
+    double chiSquare = 0.0;                                   // 加权残差平方和
+    int iterations = 0;                                       // 高斯-牛顿迭代次数
+    bool converged = false;                                   // 是否收敛
+    bool valid = false;                                       // 求解是否成功
+};
+
+/**
+ * @brief N站测向加权最小二乘定位
+ *
+ * 在以站阵中心为原点的东-北-天坐标系中求解。初始解为伪线性最小二乘：
+ * 每条方位线给出一个竖直平面、每条带俯仰的测向线给出一条空间直线，
+ * 所有站的约束累加为一个3x3法方程一次求解，站数可达数百；
+ * 再以角度残差做高斯-牛顿迭代得到最大似然解和协方差 (J^T W J)^-1。
+ * 只测方位时须给出 knownAltitude，以高度伪观测补足竖直方向。
+ * @param bearings 各站测向观测，至少2站
+ * @param options 求解参数
+ * @return 定位结果、协方差和残差
+ */
+DFSolution dfLocateWLS(const std::vector<DFBearing>& bearings,
+                       const DFSolverOptions& options = DFSolverOptions());
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "ModelRepository.h"
+
+/**
+ * @brief MySQL模型数据源，转发到各DAO(查询经由DAO的内存缓存)
+ *
+ * 使用前需先调用 DBConnector::staticInit 建立连接池。
+ * 与DAO一起编译在 passivelocation_db 库中，核心算法库不链接MySQL。
+ */
+class DatabaseModelRepository : public ModelRepository {
+public:
+    std::vector<ReconnaissanceDevice> getAllReconnaissanceDevices() override;
+    bool findReconnaissanceDeviceById(int deviceId, ReconnaissanceDevice& device) override;
+    bool findReconnaissanceDeviceByName(const std::string& name, ReconnaissanceDevice& device) override;
+    std::vector<RadiationSource> getAllRadiationSources() override;
+    bool findRadiationSourceById(int sourceId, RadiationSource& source) override;
+    bool findRadiationSourceByName(const std::string& name, RadiationSource& source) override;
+    bool addSinglePlatformTask(const SinglePlatformTask& task, int& taskId) override;
+};
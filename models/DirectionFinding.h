@@ -2,10 +2,10 @@
 
 #include "ReconnaissanceDeviceModel.h"
 #include "RadiationSourceModel.h"
-#include "ReconnaissanceDeviceDAO.h"
-#include "RadiationSourceDAO.h"
+#include "ModelRepository.h"
 #include "../utils/CoordinateTransform.h"
 #include "../utils/Vector3.h"
+#include "../utils/RandomStream.h"
 #include <vector>
 #include <string>
 #include <tuple>
@@ -15,6 +15,8 @@ public:
     struct Result {
         COORD3 position; // 定位结果（大地坐标，经度/纬度/高度）
         double error;    // 定位误差
+        double cep = 0.0;       // 由加权最小二乘协方差计算的水平圆概率误差（米）
+        double chiSquare = 0.0; // 加权角度残差平方和
     };
     
     // 测向线结构体，包含设备和目标之间的线信息
@@ -26,6 +28,7 @@ public:
         double stdDevDeg;      // 标准差(度)
     };
 
+    // 全局实例(界面外的工具代码使用)；后台仿真任务应各自构造独立实例，避免共享状态
     static DirectionFinding& getInstance();
 
     DirectionFinding();
@@ -35,10 +38,16 @@ public:
     bool loadDeviceInfo();
     bool loadSourceInfo();
     
-    // 使用指定的误差参数计算
+    // 使用指定的误差参数计算（前两站分别使用给定参数，其余站沿用第二站参数）
     bool calculate(double dev1MeanError, double dev1StdDev, 
                  double dev2MeanError, double dev2StdDev);
     
+    // 使用全部选中侦察站做加权最小二乘测向定位：各站测方位角和俯仰角，三维求解
+    // deviceErrors 为各站方位(均值误差,标准差)，单位度；个数少于站数时其余站沿用最后一组
+    // elevationDeviceErrors 为各站俯仰(均值误差,标准差)，为空时与方位误差相同
+    bool calculate(const std::vector<std::tuple<double, double>>& deviceErrors,
+                   const std::vector<std::tuple<double, double>>& elevationDeviceErrors = {});
+    
     Result getResult() const;
     std::vector<int> getDeviceIds() const;
     int getSourceId() const;
@@ -68,12 +77,16 @@ private:
     std::vector<std::tuple<double, double>> m_deviceErrors; // 均值误差,标准差
 };
 
+// 按正态分布采样测向误差（度），标准差不大于0时返回均值
+double sampleBearingError(RandomStream& rng, double meanErrorDeg, double stdDevDeg);
+
 // 向量相关函数声明
 Vector3 calculateDirectionWithError(
     const Vector3& observer,
     const Vector3& target,
     double meanErrorDeg,
-    double stdDevDeg
+    double stdDevDeg,
+    RandomStream& rng
 );
 
 Vector3 intersectDirections2D(
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <vector>
+
+// 辐射源状态向量：[x, y, z, vx, vy, vz]（空间直角坐标，位置为 t=0 时刻）
+typedef Eigen::Matrix<double, 6, 1> FDOAState;
+
+// 单个多普勒观测：某侦察站在某一观测时刻测得的频移
+struct FDOAObservation {
+    Eigen::Vector3d stationPosition = Eigen::Vector3d::Zero();  // 侦察站在观测时刻的位置（米）
+    Eigen::Vector3d stationVelocity = Eigen::Vector3d::Zero();  // 侦察站速度（m/s）
+    double time = 0.0;                                          // 观测时刻（秒）
+    double dopplerShift = 0.0;                                  // 观测多普勒频移（Hz）
+};
+
+// LM求解参数
+struct FDOASolverOptions {
+    double carrierFrequency = 0.0;                               // 辐射源载频（Hz）
+    Eigen::Vector3d expectedVelocity = Eigen::Vector3d::Zero();  // 速度先验（m/s）
+    double velocityWeight = 0.0;                                 // 速度约束权重，0 表示不加约束
+    int maxIterations = 100;                                     // 最大迭代次数
+    double tolerance = 1e-6;                                     // 收敛阈值：状态增量范数或残差范数
+};
+
+// LM求解结果
+struct FDOASolution {
+    FDOAState state = FDOAState::Zero();  // 估计的位置和速度
+    double finalError = 0.0;              // 残差范数 ||r||
+    int iterations = 0;                   // 迭代次数
+    bool converged = false;               // 是否收敛
+};
+
+/**
+ * @brief 多普勒频移的Levenberg-Marquardt定位（6维状态：位置 + 速度）
+ *
+ * 残差 r = f_obs - f0/c·(v_s - v)·u，u 为辐射源 t 时刻位置指向侦察站的单位向量，
+ * 雅可比矩阵解析给出。逐行累加 J^T·J 和 J^T·r，法方程为 6×6 定长矩阵，
+ * 阻尼项按 diag(J^T·J) 缩放，阻尼因子按增益比更新（Nielsen）。迭代过程不产生堆分配。
+ * @param observations 观测数组，可包含任意多个侦察站和观测时刻
+ * @param count 观测个数
+ * @param initialState 初始状态
+ * @param options 求解参数
+ * @return 求解结果
+ */
+FDOASolution fdoaSolveLM(const FDOAObservation* observations, int count,
+                         const FDOAState& initialState, const FDOASolverOptions& options);
+
+FDOASolution fdoaSolveLM(const std::vector<FDOAObservation>& observations,
+                         const FDOAState& initialState, const FDOASolverOptions& options);
+
+/**
+ * @brief 给定状态下某个观测的理论多普勒频移（Hz）
+ */
+double fdoaPredictDoppler(const FDOAObservation& observation, const FDOAState& state, double carrierFrequency);
+
+// 多起点求解参数
+struct FDOAMultiStartOptions {
+    int startCount = 16;            // 起点数K，第0个起点为先验值本身
+    double positionSpread = 1000.0; // 起点位置在先验值各轴上的分布半宽（米）
+    double velocitySpread = 5.0;    // 起点速度在先验值各轴上的分布半宽（m/s）
+    double agreementRadius = 1.0;   // 与最优解位置相距不超过该值（米）的收敛解视为同一解
+    unsigned int threadCount = 0;   // 线程数，0 表示使用全部硬件线程
+};
+
+// 多起点求解结果及收敛统计
+struct FDOAMultiStartResult {
+    FDOASolution best;          // 收敛解中残差最小者；均未收敛时取残差最小者
+    int bestStart = -1;         // 最优解对应的起点序号
+    int startCount = 0;         // 实际起点数
+    int convergedCount = 0;     // 收敛的起点数
+    int agreeingCount = 0;      // 收敛到最优解附近的起点数
+    int totalIterations = 0;    // 所有起点的迭代次数之和
+};
+
+/**
+ * @brief 在先验值周围生成多起点初始值
+ *
+ * 第0个起点为先验值，其余起点取6维Sobol低差异序列，映射到先验值各轴 ±spread 的范围内，
+ * 相同参数下结果确定。
+ */
+std::vector<FDOAState> fdoaMultiStartGuesses(const FDOAState& prior, const FDOAMultiStartOptions& multiStart);
+
+/**
+ * @brief 多起点LM求解：K个起点并行求解，返回最优收敛解和收敛统计
+ *
+ * 单起点LM对运动辐射源的初值较敏感，多起点可以跳出局部极小。各起点互相独立，
+ * 多核上并行执行，墙钟时间与单起点求解相当。
+ */
+FDOAMultiStartResult fdoaSolveMultiStart(const std::vector<FDOAObservation>& observations,
+                                         const FDOAState& prior,
+                                         const FDOASolverOptions& options,
+                                         const FDOAMultiStartOptions& multiStart);
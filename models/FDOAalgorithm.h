@@ -1,7 +1,6 @@
 #pragma once
 
-#include "models/RadiationSourceDAO.h"
-#include "models/ReconnaissanceDeviceDAO.h"
+#include "models/ModelRepository.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -10,6 +9,7 @@
 #include "utils/Vector3.h"
 #include "utils/SimulationValidator.h"
 #include "utils/CoordinateTransform.h"
+#include "models/FDOASolver.h"
 
 class FDOAalgorithm {
 public:
@@ -21,15 +21,25 @@ public:
         int iterations;       // 迭代次数
         double finalError;    // 最终误差
         double locationTime;  // 定位时间（秒）
+        int startCount = 1;       // 多起点求解的起点数
+        int convergedStarts = 0;  // 收敛的起点数
     };
 
+    // 全局实例(界面外的工具代码使用)；后台仿真任务应各自构造独立实例，避免共享状态
     static FDOAalgorithm& getInstance();
 
+    FDOAalgorithm();
+    ~FDOAalgorithm();
+
     // 初始化算法参数
     void init(const std::vector<std::string>& deviceNames, 
              const std::string& sourceName,
              const std::string& systemType,  // 技术体制："时差体制" 或 "频差体制"
-             double simulationTime);         // 仿真时间（秒）
+             double simulationTime,          // 仿真时间（秒）
+             int observationCount = 3);      // 观测时刻数，在 [0, 仿真时间] 内均匀分布
+
+    // 在 [0, simulationTime] 内均匀取 count 个观测时刻(含两端)
+    static std::vector<double> observationEpochs(double simulationTime, int count);
 
     // 执行定位算法
     bool calculate();
@@ -37,20 +47,36 @@ public:
     // 获取定位结果
     SourcePositionResult getResult() const;
 
+    // 设置多起点求解参数，startCount 为 1 时退化为单起点求解
+    void setMultiStartOptions(const FDOAMultiStartOptions& options);
+
+    // 设置观测时刻选择所用的可见性时间线扫描参数
+    void setVisibilityOptions(const VisibilityTimelineOptions& options);
+
+    // 最近一次 calculate 实际使用的观测时刻
+    const std::vector<double>& getObservationEpochs() const { return m_epochs; }
+
     // 计算时间间隔最小值
     double calculateMinimumTimeInterval(int deviceId, int sourceId);
 
     // 计算时间间隔最大值
     double calculateMaximumTimeInterval(const std::vector<int>& deviceIds, int sourceId);
 
-    // 计算每个观测时刻的频差
+    // 计算每个观测时刻的频差，观测时刻由 init 设置的观测时刻数决定
     std::vector<std::vector<double>> calculateFrequencyDifferences(
         const std::vector<int>& deviceIds,
         int sourceId,
         double simulationTime,
         double errorStdDev);
 
-    // 非线性优化求解辐射源位置和速度
+    // 计算指定观测时刻的频差，结果为 [设备][时刻]
+    std::vector<std::vector<double>> calculateFrequencyDifferences(
+        const std::vector<int>& deviceIds,
+        int sourceId,
+        const std::vector<double>& timePoints,
+        double errorStdDev);
+
+    // 非线性优化求解辐射源位置和速度，观测时刻由 init 设置的观测时刻数决定
     SourcePositionResult solveSourcePosition(
         const std::vector<int>& deviceIds,
         const std::vector<std::vector<double>>& observedFDOA,
@@ -60,10 +86,31 @@ public:
         int maxIterations = 100,
         double tolerance = 1e-6);
 
+    // 非线性优化求解辐射源位置和速度，observedFDOA 为 [设备][时刻]，与 timePoints 对应
+    SourcePositionResult solveSourcePosition(
+        const std::vector<int>& deviceIds,
+        const std::vector<std::vector<double>>& observedFDOA,
+        const std::vector<double>& timePoints,
+        COORD3 initialPosition = {0, 0, 0},
+        Vector3 initialVelocity = {0, 0, 0},
+        int maxIterations = 100,
+        double tolerance = 1e-6);
+
+    // 多起点并行求解：在初始值周围生成多个起点，返回残差最小的收敛解
+    SourcePositionResult solveSourcePositionMultiStart(
+        const std::vector<int>& deviceIds,
+        const std::vector<std::vector<double>>& observedFDOA,
+        const std::vector<double>& timePoints,
+        COORD3 initialPosition,
+        Vector3 initialVelocity,
+        const FDOAMultiStartOptions& multiStart,
+        int maxIterations = 100,
+        double tolerance = 1e-6);
+
     // 计算设备在指定时刻的位置
     COORD3 calculateDevicePositionAtTime(const ReconnaissanceDevice& device, double t);
 
-    // 计算定位精度
+    // 计算定位精度，观测时刻由 init 设置的观测时刻数决定(均匀时刻)
     double calculateLocalizationAccuracy(
         const std::vector<int>& deviceIds,
         int sourceId,
@@ -71,13 +118,18 @@ public:
         const COORD3& estimatedPosition,
         const Vector3& estimatedVelocity);
 
+    // 计算指定观测时刻下的定位精度；评估 calculate 的结果时传入 getObservationEpochs()
+    double calculateLocalizationAccuracy(
+        const std::vector<int>& deviceIds,
+        int sourceId,
+        const std::vector<double>& timePoints,
+        const COORD3& estimatedPosition,
+        const Vector3& estimatedVelocity);
+
     // 计算辐射源在指定时刻的位置
     COORD3 calculateSourcePositionAtTime(const RadiationSource& source, double t);
 
 private:
-    FDOAalgorithm();
-    ~FDOAalgorithm();
-
     // 禁止拷贝
     FDOAalgorithm(const FDOAalgorithm&) = delete;
     FDOAalgorithm& operator=(const FDOAalgorithm&) = delete;
@@ -88,35 +140,19 @@ private:
     // 从数据库获取辐射源信息
     bool loadSourceInfo();
 
-    // 辅助函数：求解二次方程
-    std::vector<double> solveQuadratic(double a, double b, double c);
-
-    // 计算每个观测时刻的频差
-    std::vector<std::vector<double>> calculateFrequencyDifferences(
-        const std::vector<ReconnaissanceDevice>& devices,
-        const RadiationSource& source,
-        const std::vector<double>& timePoints,
-        double signalFrequency);
+    // 按仿真时段内全部设备都能接收的时刻选择观测时刻，没有共同可接收时刻时退回均匀时刻
+    std::vector<double> selectObservationEpochs() const;
 
-    // 计算残差向量：观测频差与理论频差之差
-    std::vector<double> calculateResiduals(
-        const std::vector<double>& params,
+    // 预先计算各设备在各观测时刻的位置和速度，并设置求解参数
+    bool prepareObservations(
         const std::vector<int>& deviceIds,
         const std::vector<std::vector<double>>& observedFDOA,
-        const std::vector<double>& timePoints);
-
-    // 计算雅可比矩阵：残差对参数的偏导数
-    std::vector<std::vector<double>> calculateJacobian(
-        const std::vector<double>& params,
-        const std::vector<int>& deviceIds,
         const std::vector<double>& timePoints,
-        const std::vector<std::vector<double>>& observedFDOA);
+        std::vector<FDOAObservation>& observations,
+        FDOASolverOptions& options);
 
-    // 使用高斯消元法求解线性方程组
-    std::vector<double> solveLinearEquations(
-        const std::vector<std::vector<double>>& A,  // 系数矩阵
-        const std::vector<double>& b               // 常数向量
-    );
+    // 辅助函数：求解二次方程
+    std::vector<double> solveQuadratic(double a, double b, double c);
 
     // 生成带有高斯随机扰动的初始值
     std::pair<COORD3, Vector3> generateGaussianPerturbedInitialGuess(
@@ -139,6 +175,10 @@ private:
     std::string m_sourceName;                  // 辐射源名称
     std::string m_systemType;                  // 技术体制
     double m_simulationTime;                   // 仿真时间
+    int m_observationCount;                    // 观测时刻数
+    FDOAMultiStartOptions m_multiStart;        // 多起点求解参数
+    VisibilityTimelineOptions m_visibility;    // 可见性时间线扫描参数
+    std::vector<double> m_epochs;              // 实际使用的观测时刻
     std::vector<ReconnaissanceDevice> m_devices;  // 设备信息
     RadiationSource m_source;                  // 辐射源信息
     SourcePositionResult m_result;             // 定位结果
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ModelRepository.h"
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 内存模型数据源
+ *
+ * 不连接数据库，供基准测试、离线仿真使用；也是未安装数据源时的默认实现。
+ * 保存的单平台任务只留在内存中。
+ */
+class InMemoryModelRepository : public ModelRepository {
+public:
+    InMemoryModelRepository() = default;
+
+    /**
+     * @brief 添加侦察设备
+     * @param device 设备，ID不大于0时自动分配
+     * @return 设备ID
+     */
+    int addReconnaissanceDevice(const ReconnaissanceDevice& device);
+
+    /**
+     * @brief 添加辐射源
+     * @param source 辐射源，ID不大于0时自动分配
+     * @return 辐射源ID
+     */
+    int addRadiationSource(const RadiationSource& source);
+
+    // 已保存的单平台任务
+    std::vector<SinglePlatformTask> getSinglePlatformTasks() const;
+
+    // 清空所有数据
+    void clear();
+
+    std::vector<ReconnaissanceDevice> getAllReconnaissanceDevices() override;
+    bool findReconnaissanceDeviceById(int deviceId, ReconnaissanceDevice& device) override;
+    bool findReconnaissanceDeviceByName(const std::string& name, ReconnaissanceDevice& device) override;
+    std::vector<RadiationSource> getAllRadiationSources() override;
+    bool findRadiationSourceById(int sourceId, RadiationSource& source) override;
+    bool findRadiationSourceByName(const std::string& name, RadiationSource& source) override;
+    bool addSinglePlatformTask(const SinglePlatformTask& task, int& taskId) override;
+
+private:
+    mutable std::shared_mutex m_mutex;
+    std::vector<ReconnaissanceDevice> m_devices;
+    std::vector<RadiationSource> m_sources;
+    std::vector<SinglePlatformTask> m_tasks;
+    int m_nextDeviceId = 1;
+    int m_nextSourceId = 1;
+    int m_nextTaskId = 1;
+};
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 模型缓存统计
+ */
+struct ModelCacheStats {
+    std::size_t hits = 0;           // 由内存直接返回的查询次数
+    std::size_t misses = 0;         // 需要访问数据库的查询次数
+    std::size_t invalidations = 0;  // 失效次数
+    std::size_t size = 0;           // 当前缓存的模型数
+};
+
+/**
+ * @brief 模型读穿缓存，按ID和名称建立索引
+ *
+ * 首次访问时通过 loadAll 读取整张表，此后按ID、按名称的查询都在内存中完成；
+ * 缓存中没有的ID再通过 loadOne 单独读取并补入缓存。
+ * 模型表的增删改完成后调用 invalidate()，下次访问时重新读取。
+ * 多个后台仿真任务可以同时读取，加载和失效时独占。
+ *
+ * @tparam T 模型类型(ReconnaissanceDevice、RadiationSource)
+ */
+template <typename T>
+class ModelCache {
+public:
+    using IdOf = std::function<int(const T&)>;
+    using NameOf = std::function<std::string(const T&)>;
+    // 读取整张表，失败返回 false
+    using LoadAll = std::function<bool(std::vector<T>&)>;
+    // 按ID读取一条记录，不存在或失败返回 false
+    using LoadOne = std::function<bool(int, T&)>;
+
+    ModelCache(IdOf idOf, NameOf nameOf, LoadAll loadAll, LoadOne loadOne)
+        : m_idOf(std::move(idOf)), m_nameOf(std::move(nameOf)),
+          m_loadAll(std::move(loadAll)), m_loadOne(std::move(loadOne)),
+          m_loaded(false), m_hits(0), m_misses(0), m_invalidations(0) {}
+
+    /**
+     * @brief 获取全部模型，顺序与数据库查询结果一致
+     */
+    std::vector<T> getAll() {
+        for (;;) {
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                if (m_loaded) {
+                    ++m_hits;
+                    return m_models;
+                }
+            }
+            if (!load()) return std::vector<T>();
+        }
+    }
+
+    /**
+     * @brief 按ID查找
+     * @return 数据库中也不存在时返回 false
+     */
+    bool findById(int id, T& model) {
+        for (;;) {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            if (m_loaded) {
+                auto it = m_byId.find(id);
+                if (it != m_byId.end()) {
+                    ++m_hits;
+                    model = m_models[it->second];
+                    return true;
+                }
+                break;
+            }
+            lock.unlock();
+            if (!load()) return false;
+        }
+
+        // 加载整表之后新增的记录
+        ++m_misses;
+        T loaded;
+        if (!m_loadOne(id, loaded)) return false;
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (m_loaded && m_byId.find(id) == m_byId.end()) {
+            insert(loaded);
+        }
+        model = loaded;
+        return true;
+    }
+
+    /**
+     * @brief 按名称查找，重名时返回第一条
+     */
+    bool findByName(const std::string& name, T& model) {
+        for (;;) {
+            {
+                std::shared_lock<std::shared_mutex> lock(m_mutex);
+                if (m_loaded) {
+                    auto it = m_byName.find(name);
+                    if (it == m_byName.end()) {
+                        ++m_misses;
+                        return false;
+                    }
+                    ++m_hits;
+                    model = m_models[it->second];
+                    return true;
+                }
+            }
+            if (!load()) return false;
+        }
+    }
+
+    /**
+     * @brief 使缓存失效，下次访问时重新读取整张表
+     */
+    void invalidate() {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_loaded = false;
+        m_models.clear();
+        m_byId.clear();
+        m_byName.clear();
+        ++m_invalidations;
+    }
+
+    ModelCacheStats getStats() const {
+        ModelCacheStats stats;
+        stats.hits = m_hits.load();
+        stats.misses = m_misses.load();
+        stats.invalidations = m_invalidations.load();
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        stats.size = m_models.size();
+        return stats;
+    }
+
+private:
+    // 未加载时读取整张表；读取失败不标记为已加载，下次访问重试。
+    // 调用方在共享锁下确认已加载后再查询，避免与 invalidate() 交错时读到空表
+    bool load() {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (m_loaded) return true;
+
+        ++m_misses;
+        std::vector<T> models;
+        if (!m_loadAll(models)) return false;
+        m_models.clear();
+        m_byId.clear();
+        m_byName.clear();
+        m_models.reserve(models.size());
+        for (const T& model : models) {
+            insert(model);
+        }
+        m_loaded = true;
+        return true;
+    }
+
+    void insert(const T& model) {
+        const std::size_t index = m_models.size();
+        m_models.push_back(model);
+        m_byId.emplace(m_idOf(model), index);
+        m_byName.emplace(m_nameOf(model), index);
+    }
+
+    IdOf m_idOf;
+    NameOf m_nameOf;
+    LoadAll m_loadAll;
+    LoadOne m_loadOne;
+
+    mutable std::shared_mutex m_mutex;
+    bool m_loaded;
+    std::vector<T> m_models;
+    std::unordered_map<int, std::size_t> m_byId;
+    std::unordered_map<std::string, std::size_t> m_byName;
+
+    std::atomic<std::size_t> m_hits;
+    std::atomic<std::size_t> m_misses;
+    std::atomic<std::size_t> m_invalidations;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ReconnaissanceDeviceModel.h"
+#include "RadiationSourceModel.h"
+#include "SinglePlatformTaskModel.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 模型数据源接口
+ *
+ * 定位算法和校验器只通过此接口读取侦察设备、辐射源并保存单平台任务，
+ * 不直接依赖数据库。图形界面和批量工具启动时安装 DatabaseModelRepository(MySQL)，
+ * 基准测试和离线仿真可以安装 InMemoryModelRepository 或其他实现(如SQLite)。
+ *
+ * 实现需要支持多个后台仿真任务并发调用。
+ */
+class ModelRepository {
+public:
+    virtual ~ModelRepository() = default;
+
+    /**
+     * @brief 获取当前安装的数据源
+     * @return 未安装时返回一个空的内存数据源
+     */
+    static ModelRepository& getInstance();
+
+    /**
+     * @brief 安装数据源
+     *
+     * 应在程序启动、开始仿真之前调用；仿真进行中替换数据源是未定义行为。
+     * @param repository 新数据源，传入空指针恢复为空的内存数据源
+     */
+    static void setInstance(std::shared_ptr<ModelRepository> repository);
+
+    // 获取所有侦察设备
+    virtual std::vector<ReconnaissanceDevice> getAllReconnaissanceDevices() = 0;
+
+    // 通过ID查找侦察设备，不存在时返回false
+    virtual bool findReconnaissanceDeviceById(int deviceId, ReconnaissanceDevice& device) = 0;
+
+    // 通过名称查找侦察设备，不存在时返回false
+    virtual bool findReconnaissanceDeviceByName(const std::string& name, ReconnaissanceDevice& device) = 0;
+
+    // 获取所有辐射源
+    virtual std::vector<RadiationSource> getAllRadiationSources() = 0;
+
+    // 通过ID查找辐射源，不存在时返回false
+    virtual bool findRadiationSourceById(int sourceId, RadiationSource& source) = 0;
+
+    // 通过名称查找辐射源，不存在时返回false
+    virtual bool findRadiationSourceByName(const std::string& name, RadiationSource& source) = 0;
+
+    // 保存单平台任务，成功时返回任务ID
+    virtual bool addSinglePlatformTask(const SinglePlatformTask& task, int& taskId) = 0;
+
+    // 通过ID获取侦察设备，不存在时返回默认构造的对象(与DAO行为一致)
+    ReconnaissanceDevice getReconnaissanceDeviceById(int deviceId);
+
+    // 通过ID获取辐射源，不存在时返回默认构造的对象(与DAO行为一致)
+    RadiationSource getRadiationSourceById(int sourceId);
+};
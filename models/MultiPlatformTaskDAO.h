@@ -90,24 +90,35 @@ private:
     MultiPlatformTaskDAO& operator=(const MultiPlatformTaskDAO&) = delete;
     
     /**
-     * @brief 从数据库结果集创建任务对象
-     * @param row 数据库行数据
+     * @brief 从预编译语句的当前行创建任务对象
+     * @param stmt 已fetch到当前行的语句，列顺序见 TASK_COLUMNS
      * @return 任务对象
      */
-    MultiPlatformTask createTaskFromRow(MYSQL_ROW row);
+    MultiPlatformTask createTaskFromRow(const PreparedStatement& stmt);
+    
+    /**
+     * @brief 按条件查询任务列表(含关联设备)
+     * @param conn 数据库连接
+     * @param whereClause WHERE子句(可为空)，带一个整型参数占位符
+     * @param param 参数值
+     * @return 任务列表
+     */
+    std::vector<MultiPlatformTask> queryTasks(PooledConnection& conn, const std::string& whereClause, int param);
     
     /**
      * @brief 获取任务关联的设备ID列表
+     * @param conn 数据库连接
      * @param taskId 任务ID
      * @return 设备ID列表
      */
-    std::vector<int> getDeviceIdsByTaskId(int taskId);
+    std::vector<int> getDeviceIdsByTaskId(PooledConnection& conn, int taskId);
     
     /**
-     * @brief 保存任务与设备的关联关系
+     * @brief 保存任务与设备的关联关系，与任务记录在同一连接(事务)中执行
+     * @param conn 数据库连接
      * @param taskId 任务ID
      * @param deviceIds 设备ID列表
      * @return 是否成功
      */
-    bool saveTaskDeviceRelations(int taskId, const std::vector<int>& deviceIds);
+    bool saveTaskDeviceRelations(PooledConnection& conn, int taskId, const std::vector<int>& deviceIds);
 }; 
\ No newline at end of file
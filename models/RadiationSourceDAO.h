@@ -1,9 +1,11 @@
 #pragma once
 
 #include "RadiationSourceModel.h"
+#include "ModelCache.h"
 #include <vector>
 
 // 辐射源数据访问对象 (DAO)
+// 查询经由内存缓存(按ID、名称索引)，增删改后缓存自动失效
 class RadiationSourceDAO {
 public:
     static RadiationSourceDAO& getInstance();
@@ -17,6 +19,12 @@ public:
     // 通过ID获取辐射源
     RadiationSource getRadiationSourceById(int sourceId);
     
+    // 通过ID查找辐射源，不存在时返回false
+    bool findRadiationSourceById(int sourceId, RadiationSource& source);
+    
+    // 通过名称查找辐射源，不存在时返回false
+    bool findRadiationSourceByName(const std::string& name, RadiationSource& source);
+    
     // 添加辐射源
     bool addRadiationSource(const RadiationSource& source, int& sourceId);
     
@@ -25,6 +33,12 @@ public:
     
     // 删除辐射源
     bool deleteRadiationSource(int sourceId);
+    
+    // 使缓存失效(数据库被其他途径修改后调用)
+    void invalidateCache();
+    
+    // 缓存命中统计
+    ModelCacheStats getCacheStats() const;
 
 private:
     RadiationSourceDAO();
@@ -33,4 +47,10 @@ private:
     // 禁止拷贝
     RadiationSourceDAO(const RadiationSourceDAO&) = delete;
     RadiationSourceDAO& operator=(const RadiationSourceDAO&) = delete;
+    
+    // 直接读取数据库(缓存的数据源)
+    bool queryAllSources(std::vector<RadiationSource>& sources);
+    bool querySourceById(int sourceId, RadiationSource& source);
+    
+    ModelCache<RadiationSource> m_cache;
 }; 
\ No newline at end of file
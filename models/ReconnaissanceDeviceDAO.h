@@ -1,8 +1,10 @@
 #pragma once
 #include "ReconnaissanceDeviceModel.h"
+#include "ModelCache.h"
 #include <vector>
 
 // 侦察设备数据访问对象 (DAO)
+// 查询经由内存缓存(按ID、名称索引)，增删改后缓存自动失效
 class ReconnaissanceDeviceDAO {
 public:
     static ReconnaissanceDeviceDAO& getInstance();
@@ -16,6 +18,12 @@ public:
     // 通过ID获取侦察设备
     ReconnaissanceDevice getReconnaissanceDeviceById(int deviceId);
     
+    // 通过ID查找侦察设备，不存在时返回false
+    bool findReconnaissanceDeviceById(int deviceId, ReconnaissanceDevice& device);
+    
+    // 通过名称查找侦察设备，不存在时返回false
+    bool findReconnaissanceDeviceByName(const std::string& name, ReconnaissanceDevice& device);
+    
     // 添加侦察设备
     bool addReconnaissanceDevice(const ReconnaissanceDevice& device, int& deviceId);
     
@@ -24,6 +32,12 @@ public:
     
     // 删除侦察设备
     bool deleteReconnaissanceDevice(int deviceId);
+    
+    // 使缓存失效(数据库被其他途径修改后调用)
+    void invalidateCache();
+    
+    // 缓存命中统计
+    ModelCacheStats getCacheStats() const;
 
 private:
     ReconnaissanceDeviceDAO();
@@ -32,4 +46,10 @@ private:
     // 禁止拷贝
     ReconnaissanceDeviceDAO(const ReconnaissanceDeviceDAO&) = delete;
     ReconnaissanceDeviceDAO& operator=(const ReconnaissanceDeviceDAO&) = delete;
+    
+    // 直接读取数据库(缓存的数据源)
+    bool queryAllDevices(std::vector<ReconnaissanceDevice>& devices);
+    bool queryDeviceById(int deviceId, ReconnaissanceDevice& device);
+    
+    ModelCache<ReconnaissanceDevice> m_cache;
 }; 
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include "ReconnaissanceDeviceModel.h"
 #include "RadiationSourceModel.h"
 #include "InterferometerPositioning.h" // 复用LocationResult结构体
+#include "../utils/CrossCorrelation.h"
+#include "../utils/PhaseEstimator.h"
+#include "../utils/SignalPipeline.h"
+#include <atomic>
 #include <vector>
 #include <utility>
 
@@ -22,11 +26,13 @@ public:
      * @param device 侦察设备
      * @param source 辐射源
      * @param simulationTime 仿真时间（秒）
+     * @param cancelFlag 任务取消标志，非空且置位时信号管线提前结束并返回
      * @return 定位结果
      */
     LocationResult runSimulation(const ReconnaissanceDevice& device, 
                                const RadiationSource& source,
-                               int simulationTime);
+                               int simulationTime,
+                               const std::atomic<bool>* cancelFlag = nullptr);
     
     /**
      * @brief 计算时差体制误差因素
@@ -40,6 +46,30 @@ public:
                                          double timeDifference, 
                                          double estimatedDistance,
                                          double incidentAngle);
+    
+    /**
+     * @brief 以流式IQ接收管线测量时差
+     *
+     * 按设备采样率、噪声功率谱密度和辐射源载频、扫描周期、发射功率生成两个位置的接收信号，
+     * 经有界环形缓冲区送入GCC和相位估计，内存占用与观测长度无关。
+     * @param device 侦察设备
+     * @param source 辐射源
+     * @param distance 设备到辐射源的距离(米)，用于计算接收功率
+     * @param trueTimeDifference 几何时差(秒)，即 (距离1 - 距离2) / c
+     * @param maxTimeDifference 可能的最大时差(秒)，决定相关帧长
+     * @param measuredTimeDifference 输出测量时差(秒)，与 trueTimeDifference 同号
+     * @param pipelineResult 输出管线运行统计(吞吐量、内存等)
+     * @param cancelFlag 任务取消标志，透传给 SignalPipelineConfig::cancelFlag
+     * @return 测量成功返回true，被取消时返回false且 pipelineResult.cancelled 为true
+     */
+    bool measureTimeDifference(const ReconnaissanceDevice& device,
+                               const RadiationSource& source,
+                               double distance,
+                               double trueTimeDifference,
+                               double maxTimeDifference,
+                               double& measuredTimeDifference,
+                               SignalPipelineResult& pipelineResult,
+                               const std::atomic<bool>* cancelFlag = nullptr);
 
 private:
     // 私有构造函数和析构函数
@@ -51,19 +81,34 @@ private:
     SinglePlatformTDOA& operator=(const SinglePlatformTDOA&) = delete;
     
     /**
-     * @brief 互相关法计算时差
+     * @brief 互相关法计算时差(FFT广义互相关，含亚采样插值)
+     * @param weighting 互谱加权方式，None 与原直接互相关结果一致
+     * @return signal1 相对 signal2 的时延(秒)
      */
     double calculateTimeDifferenceCorrelation(
         const std::vector<double>& signal1, 
         const std::vector<double>& signal2,
-        double samplingRate);
+        double samplingRate,
+        GccWeighting weighting = GccWeighting::PHAT);
     
     /**
-     * @brief 频谱相位法计算时差
+     * @brief 频谱相位法计算时差(单频点，无模糊范围 ±1/(2f))
+     * @return signal2 相对 signal1 的时延(秒)
      */
     double calculateTimeDifferencePhase(
         const std::vector<double>& signal1, 
         const std::vector<double>& signal2,
         double samplingRate, 
         double frequency);
+    
+    /**
+     * @brief 多频点频谱相位法计算时差，利用频点间相位差解模糊
+     * @param frequencies 带内若干频点(Hz)，最小频差决定无模糊范围 ±1/(2Δf)
+     * @return signal2 相对 signal1 的时延(秒)
+     */
+    double calculateTimeDifferencePhase(
+        const std::vector<double>& signal1, 
+        const std::vector<double>& signal2,
+        double samplingRate, 
+        const std::vector<double>& frequencies);
 }; 
\ No newline at end of file
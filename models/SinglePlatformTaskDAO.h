@@ -1,31 +1,10 @@
 #pragma once
 
 #include "DBConnector.h"
+#include "SinglePlatformTaskModel.h"
 #include <string>
 #include <vector>
 
-/**
- * @brief 单平台任务数据结构体
- */
-struct SinglePlatformTask {
-     int taskId;                 // 任务ID
-    std::string techSystem;     // 技术体制：INTERFEROMETER或TDOA
-    int deviceId;               // 关联侦察设备模型ID
-    int radiationId;            // 关联辐射源模型ID
-    float executionTime;        // 仿真执行时长（秒）
-    double targetLongitude;     // 目标经度（度）
-    double targetLatitude;      // 目标纬度（度）
-    double targetAltitude;      // 目标高度（米）
-    double azimuth;            // 方位角（度）
-    double elevation;          // 俯仰角（度）
-    double angleError;          // 测向误差（度）
-    float positioningDistance; // 最远定位距离（米）
-    float positioningTime;      // 定位时间（秒）
-    double positioningAccuracy; // 定位精度（米）
-    double directionFindingAccuracy; // 测向精度（度）
-    std::string createdAt;      // 任务创建时间
-};
-
 /**
  * @brief 单平台任务数据访问对象类
  */
@@ -103,9 +82,17 @@ private:
     SinglePlatformTaskDAO& operator=(const SinglePlatformTaskDAO&) = delete;
     
     /**
-     * @brief 从数据库结果集创建任务对象
-     * @param row 数据库行数据
+     * @brief 从预编译语句的当前行创建任务对象
+     * @param stmt 已fetch到当前行的语句，列顺序见 TASK_COLUMNS
      * @return 任务对象
      */
-    SinglePlatformTask createTaskFromRow(MYSQL_ROW row);
+    SinglePlatformTask createTaskFromRow(const PreparedStatement& stmt);
+
+    /**
+     * @brief 按条件查询任务列表
+     * @param whereClause WHERE子句(可为空)，带一个整型参数占位符
+     * @param param 参数值
+     * @return 任务列表
+     */
+    std::vector<SinglePlatformTask> queryTasks(const std::string& whereClause, int param);
 }; 
\ No newline at end of file
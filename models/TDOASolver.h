@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../utils/CoordinateTransform.h"
+#include <Eigen/Dense>
+#include <vector>
+
+/**
+ * @brief Chan算法求TDOA定位初始解（二维，高度已知）
+ * @param stationPositions 侦察站空间直角坐标，第0个为参考站
+ * @param tdoas 各站相对参考站的到达时间差（秒），tdoas[0]为0
+ * @param knownHeight 目标已知Z坐标（米）
+ * @return 初始估计位置（空间直角坐标）
+ */
+COORD3 tdoaLocate_chan_initial(const std::vector<COORD3>& stationPositions,
+                               const std::vector<double>& tdoas,
+                               double knownHeight);
+
+/**
+ * @brief 泰勒级数迭代法精炼TDOA定位结果（二维，只修正x和y）
+ * @param stationPositions 侦察站空间直角坐标，第0个为参考站
+ * @param tdoas 各站相对参考站的到达时间差（秒），tdoas[0]为0
+ * @param initialGuess 初始估计位置
+ * @param iterations 输出：实际迭代次数，可为nullptr
+ * @return 精炼后的位置（空间直角坐标）
+ */
+COORD3 tdoaRefinePosition_taylor(const std::vector<COORD3>& stationPositions,
+                                 const std::vector<double>& tdoas,
+                                 const COORD3& initialGuess,
+                                 int* iterations = nullptr);
+
+// 三维TDOA求解支持的最大站数（定长栈数组容量）
+constexpr int TDOA_MAX_STATIONS = 16;
+
+// 三维TDOA定位结果
+struct TDOA3DSolution {
+    COORD3 position;                                       // 估计位置（空间直角坐标）
+    Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();  // 位置协方差（空间直角坐标，米^2）
+    double gdop = 0.0;                                     // 几何精度因子：sqrt(tr(P))/(c·σ)
+    int iterations = 0;                                    // 高斯-牛顿迭代次数
+    bool converged = false;                                // 是否收敛
+    bool valid = false;                                    // 求解是否成功
+};
+
+/**
+ * @brief 三维TDOA定位：Chan两步加权最小二乘初始解 + 高斯-牛顿迭代
+ *
+ * 不固定目标高度。5站及以上使用Chan两步WLS，4站时解析求解二次方程。
+ * 时差视为共用参考站的相关测量，协方差为 σ²/2 (I + 11^T)。不产生堆分配。
+ * @param stationPositions 侦察站空间直角坐标，第0个为参考站，站数为 4~TDOA_MAX_STATIONS
+ * @param N 站数
+ * @param tdoas 各站相对参考站的时差（秒），tdoas[0]为0
+ * @param tdoaSigma 单个时差的测量标准差（秒），用于协方差
+ * @return 定位结果、协方差和GDOP
+ */
+TDOA3DSolution tdoaLocate3D(const COORD3* stationPositions, int N, const double* tdoas, double tdoaSigma);
+
+TDOA3DSolution tdoaLocate3D(const std::vector<COORD3>& stationPositions,
+                            const std::vector<double>& tdoas,
+                            double tdoaSigma);
+
+/**
+ * @brief 由空间直角坐标协方差计算水平面圆概率误差(CEP)
+ * @param covarianceXyz 位置协方差（空间直角坐标，米^2）
+ * @param positionXyz 位置（空间直角坐标），用于确定当地水平面
+ * @return CEP半径（米），采用 0.59(σa+σb) 近似
+ */
+double horizontalCEP(const Eigen::Matrix3d& covarianceXyz, const COORD3& positionXyz);
+
+/**
+ * @brief 批量TDOA定位：一组固定的侦察站几何 + N 组时差 -> N 个位置及协方差
+ *
+ * 站址的ECEF转换和参考站平移只在构造时做一次，各组时差并行求解，
+ * 单组求解(Chan初始解 + 泰勒迭代)不产生堆分配。
+ */
+class TDOABatchLocator {
+public:
+    // 单个辐射源的定位结果
+    struct Solution {
+        COORD3 position;                                       // 估计位置（空间直角坐标）
+        Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();  // 位置协方差（米^2）
+        int iterations = 0;                                    // 泰勒迭代次数
+        bool valid = false;                                    // 求解是否成功
+    };
+
+    /**
+     * @brief 由侦察站空间直角坐标构造
+     * @param stationPositions 侦察站空间直角坐标，第0个为参考站
+     */
+    explicit TDOABatchLocator(const std::vector<COORD3>& stationPositions);
+
+    /**
+     * @brief 由侦察站大地坐标(经度,纬度,高程)构造
+     */
+    static TDOABatchLocator fromGeodetic(const std::vector<COORD3>& stationLbh);
+
+    /**
+     * @brief 求解单组时差
+     * @param tdoas 各站相对参考站的时差（秒），长度等于站数，tdoas[0]为0
+     * @param knownHeight 目标已知Z坐标（米）
+     * @param tdoaSigma 时差测量标准差（秒），用于协方差
+     */
+    Solution locate(const double* tdoas, double knownHeight, double tdoaSigma) const;
+
+    /**
+     * @brief 并行求解多组时差
+     * @param tdoaBatch N 组时差
+     * @param knownHeights 各组目标已知Z坐标；长度为1时共用，为空时取参考站Z坐标
+     * @param tdoaSigma 时差测量标准差（秒）
+     * @param threadCount 线程数，0 表示使用全部硬件线程
+     * @return 与输入顺序一致的 N 个结果
+     */
+    std::vector<Solution> locateBatch(const std::vector<std::vector<double>>& tdoaBatch,
+                                      const std::vector<double>& knownHeights,
+                                      double tdoaSigma,
+                                      unsigned int threadCount = 0) const;
+
+    size_t stationCount() const { return m_localStations.size(); }
+
+private:
+    COORD3 m_reference;                   // 参考站空间直角坐标
+    std::vector<COORD3> m_localStations;  // 以参考站为原点的站址
+};
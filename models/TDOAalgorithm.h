@@ -1,10 +1,10 @@
 #pragma once
 
-#include "../models/RadiationSourceDAO.h"
-#include "../models/ReconnaissanceDeviceDAO.h"
+#include "../models/ModelRepository.h"
 #include "../utils/SimulationValidator.h"
 #include "../utils/CoordinateTransform.h"
 #include "../utils/Vector3.h"
+#include "TDOASolver.h"
 
 #include <vector>
 #include <string>
@@ -25,11 +25,16 @@ public:
         double locationTime;     
         double distance;         
         double accuracy;         
+        double cep;              // 由协方差解析计算的水平圆概率误差（米）
+        double gdop;             // 几何精度因子
     };
 
-    // 单例模式
+    // 全局实例(界面外的工具代码使用)；后台仿真任务应各自构造独立实例，避免共享状态
     static TDOAalgorithm& getInstance();
 
+    TDOAalgorithm();
+    ~TDOAalgorithm();
+
     // 初始化算法
     void init(const std::vector<std::string>& deviceNames, 
              const std::string& sourceName,
@@ -43,6 +48,13 @@ public:
 
     // 获取定位结果
     LocationResult getResult() const;
+
+    // 获取定位结果的位置协方差（空间直角坐标，米^2）
+    Eigen::Matrix3d getCovariance() const { return m_covariance; }
+
+    // 批量评估候选辐射源位置(大地坐标)：设备只加载一次，返回各候选位置的定位结果及协方差
+    bool calculateBatch(const std::vector<COORD3>& candidateLbh,
+                        std::vector<TDOABatchLocator::Solution>& solutions);
     
     // 设置误差参数
     void setErrorParams(double tdoaRmsError, double esmToaError) {
@@ -50,10 +62,13 @@ public:
         m_esmToaError = esmToaError;
     }
 
-private:
-    TDOAalgorithm();
-    ~TDOAalgorithm();
+    // 设置观测时刻选择所用的可见性时间线扫描参数
+    void setVisibilityOptions(const VisibilityTimelineOptions& options) { m_visibility = options; }
+
+    // 最近一次 calculate 实际使用的观测时刻（秒）
+    double getObservationEpoch() const { return m_epoch; }
 
+private:
     TDOAalgorithm(const TDOAalgorithm&) = delete;
     TDOAalgorithm& operator=(const TDOAalgorithm&) = delete;
 
@@ -65,6 +80,9 @@ private:
     bool loadDeviceInfo();
     bool loadSourceInfo();
 
+    // 观测时刻：初始时刻全部设备可接收时取0，否则取仿真时段内第一个全部设备都能接收的时刻
+    double selectObservationEpoch() const;
+
     // 成员变量
     std::vector<std::string> m_deviceNames;    
     std::string m_sourceName;                  
@@ -73,8 +91,12 @@ private:
     std::vector<ReconnaissanceDevice> m_devices;  
     RadiationSource m_source;                  
     LocationResult m_result;
+    Eigen::Matrix3d m_covariance;  // 定位结果的位置协方差
     
     // 误差参数
     double m_tdoaRmsError;  // TDOA均方根误差（秒）
     double m_esmToaError;   // ESM TOA误差（秒）                   
+
+    VisibilityTimelineOptions m_visibility;  // 可见性时间线扫描参数
+    double m_epoch;                          // 实际使用的观测时刻（秒）                   
 };
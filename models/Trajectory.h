@@ -0,0 +1,135 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "../utils/CoordinateTransform.h"
+#include "ReconnaissanceDeviceModel.h"
+#include "RadiationSourceModel.h"
+
+/**
+ * @brief 轨迹采样点
+ */
+struct TrajectorySample {
+    double time = 0.0;       // 时刻（秒）
+    double longitude = 0.0;  // 经度（度）
+    double latitude = 0.0;   // 纬度（度）
+    double altitude = 0.0;   // 高度（米）
+};
+
+/**
+ * @brief 轨迹抽稀参数
+ *
+ * 相邻两个输出点之间按经纬高线性插值（与地图折线一致），
+ * 插值点到真实轨迹的偏差不超过 tolerance。
+ */
+struct TrajectorySamplingOptions {
+    double tolerance = 1.0;  // 允许的插值偏差（米）
+    double minStep = 1.0;    // 最小步长（秒），偏差超限时步长不会再缩小
+    double maxStep = 60.0;   // 最大步长（秒）
+};
+
+class Trajectory;
+
+/**
+ * @brief 轨迹迭代器：自适应步长 + 误差受限抽稀
+ *
+ * 只保存当前时刻和步长，内存占用与仿真时长无关。
+ * 第一个点为 t=0，最后一个点为 t=duration。
+ */
+class TrajectoryIterator {
+public:
+    TrajectoryIterator(const Trajectory& trajectory, const TrajectorySamplingOptions& options);
+
+    /**
+     * @brief 取下一个采样点
+     * @param sample 输出采样点
+     * @return 是否还有采样点
+     */
+    bool next(TrajectorySample& sample);
+
+private:
+    const Trajectory* m_trajectory;
+    TrajectorySamplingOptions m_options;
+    TrajectorySample m_last;  // 上一个输出点
+    double m_step;            // 当前步长（秒）
+    bool m_started;
+    bool m_finished;
+};
+
+/**
+ * @brief 匀速直线运动轨迹（空间直角坐标系内匀速），按需计算任意时刻的位置和速度
+ *
+ * 与 TrajectorySimulator::simulateMovement 使用同一运动模型，
+ * 但不预先生成轨迹点；静止平台直接返回初始位置，不做坐标转换。
+ */
+class Trajectory {
+public:
+    /**
+     * @brief 构造轨迹
+     * @param longitude 初始经度（度）
+     * @param latitude 初始纬度（度）
+     * @param altitude 初始高度（米）
+     * @param speed 速度（米/秒）
+     * @param azimuth 方位角（度），正北为0度，顺时针为正
+     * @param elevation 俯仰角（度），水平为0度，向上为正
+     * @param duration 轨迹时长（秒）
+     */
+    Trajectory(double longitude, double latitude, double altitude,
+               double speed, double azimuth, double elevation, double duration);
+
+    // 由侦察设备/辐射源的初始位置和运动参数构造
+    static Trajectory fromDevice(const ReconnaissanceDevice& device, double duration);
+    static Trajectory fromSource(const RadiationSource& source, double duration);
+
+    double duration() const { return m_duration; }
+    bool isStationary() const { return m_stationary; }
+
+    /**
+     * @brief t时刻的空间直角坐标
+     */
+    COORD3 positionXyzAt(double t) const;
+
+    /**
+     * @brief t时刻的大地坐标(经度,纬度,高度)
+     */
+    COORD3 positionAt(double t) const;
+
+    /**
+     * @brief 批量计算多个时刻的大地坐标(SoA布局)
+     */
+    void positionsAt(const double* times, std::size_t n,
+                     double* longitudes, double* latitudes, double* altitudes) const;
+
+    /**
+     * @brief 空间直角坐标系中的速度分量(vx,vy,vz)，匀速运动与时刻无关
+     */
+    const COORD3& velocityXyz() const { return m_velocityXyz; }
+
+    /**
+     * @brief t时刻所在位置当地的速度参数(速度大小,方位角,俯仰角)
+     */
+    COORD3 velocityAt(double t) const;
+
+    /**
+     * @brief 创建抽稀迭代器
+     */
+    TrajectoryIterator samples(const TrajectorySamplingOptions& options = TrajectorySamplingOptions()) const {
+        return TrajectoryIterator(*this, options);
+    }
+
+    /**
+     * @brief 按固定步长生成经纬度轨迹点(包含 t=0 和 t=duration)
+     */
+    std::vector<std::pair<double, double>> sampleUniform(double step) const;
+
+private:
+    COORD3 m_initialLbh;
+    COORD3 m_initialXyz;
+    COORD3 m_velocityXyz;
+    double m_duration;
+    bool m_stationary;
+};
+
+#endif // TRAJECTORY_H
@@ -7,11 +7,10 @@
 #include "../models/ReconnaissanceDeviceModel.h"
 #include "../models/RadiationSourceModel.h"
 
-// 前向声明
-class MapView;
-
 /**
  * @brief 轨迹模拟器类
+ *
+ * 只负责平台运动学计算，不依赖地图视图；轨迹动画由 TrajectoryAnimator 生成。
  */
 class TrajectorySimulator {
 public:
@@ -45,6 +44,8 @@ public:
     
     /**
      * @brief 通用移动轨迹模拟方法
+     *
+     * 按1秒间隔生成全部轨迹点；只需要部分时刻或抽稀轨迹时请直接使用 Trajectory。
      * @param initialLongitude 初始经度
      * @param initialLatitude 初始纬度
      * @param initialAltitude 初始高度
@@ -70,54 +71,6 @@ public:
         bool isDevice
     );
 
-    /**
-     * @brief 执行设备移动动画
-     * @param mapView 地图视图
-     * @param device 侦察设备
-     * @param trajectoryPoints 轨迹点
-     * @param simulationTime 仿真时间（秒）
-     * @param calculatedLongitude 计算得到的经度
-     * @param calculatedLatitude 计算得到的纬度
-     * @param calculatedAltitude 计算得到的高度
-     * @param sourceName 辐射源名称
-     * @param radiationSourceLongitude 辐射源经度
-     * @param radiationSourceLatitude 辐射源纬度
-     * @param radiationSourceAltitude 辐射源高度
-     */
-    void animateDeviceMovement(
-        MapView* mapView,
-        const ReconnaissanceDevice& device,
-        const std::vector<std::pair<double, double>>& trajectoryPoints,
-        int simulationTime,
-        double calculatedLongitude,
-        double calculatedLatitude,
-        double calculatedAltitude,
-        const std::string& sourceName,
-        double radiationSourceLongitude,
-        double radiationSourceLatitude,
-        double radiationSourceAltitude
-    );
-
-    /**
-     * @brief 执行多设备移动动画
-     * @param mapView 地图视图
-     * @param devices 侦察设备列表
-     * @param source 辐射源
-     * @param simulationTime 仿真时间（秒）
-     * @param calculatedLongitude 计算得到的经度
-     * @param calculatedLatitude 计算得到的纬度
-     * @param calculatedAltitude 计算得到的高度
-     */
-    void animateMultipleDevicesMovement(
-        MapView* mapView,
-        const std::vector<ReconnaissanceDevice>& devices,
-        const RadiationSource& source,
-        int simulationTime,
-        double calculatedLongitude,
-        double calculatedLatitude,
-        double calculatedAltitude
-    );
-
 private:
     // 私有构造函数和析构函数
     TrajectorySimulator() = default;
@@ -0,0 +1,515 @@
+#include "../DBConnectionPool.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// MySQL客户端断线错误码(errmsg.h)
+static const unsigned int CLIENT_SERVER_GONE_ERROR = 2006;
+static const unsigned int CLIENT_SERVER_LOST = 2013;
+
+// 池中的一个物理连接及其预编译语句缓存
+struct PooledConnection::Connection {
+    MYSQL* mysql = nullptr;
+    std::unordered_map<std::string, std::unique_ptr<PreparedStatement>> statements;
+    std::chrono::steady_clock::time_point lastUsed;
+    bool suspect = false;  // 上次使用时出现断线错误，借出前必须检查
+
+    void closeStatements() { statements.clear(); }
+};
+
+namespace {
+
+// 非mysql_init创建连接的线程需要初始化/清理客户端库的线程局部数据
+struct MySQLThreadGuard {
+    MySQLThreadGuard() { mysql_thread_init(); }
+    ~MySQLThreadGuard() { mysql_thread_end(); }
+};
+
+void ensureThreadInit() {
+    thread_local MySQLThreadGuard guard;
+    (void)guard;
+}
+
+bool isDisconnectError(unsigned int code) {
+    return code == CLIENT_SERVER_GONE_ERROR || code == CLIENT_SERVER_LOST;
+}
+
+} // namespace
+
+// ==================== PreparedStatement ====================
+
+PreparedStatement::PreparedStatement(MYSQL* conn, const std::string& sql)
+    : m_conn(conn), m_stmt(nullptr), m_sql(sql), m_hasResult(false) {
+    m_stmt = mysql_stmt_init(conn);
+    if (!m_stmt) {
+        std::cerr << "mysql_stmt_init failed: " << mysql_error(conn) << std::endl;
+        return;
+    }
+    if (mysql_stmt_prepare(m_stmt, sql.c_str(), static_cast<unsigned long>(sql.size()))) {
+        std::cerr << "Failed to prepare statement: " << mysql_stmt_error(m_stmt) << std::endl;
+        std::cerr << "SQL: " << sql << std::endl;
+        mysql_stmt_close(m_stmt);
+        m_stmt = nullptr;
+        return;
+    }
+
+    // 结果集列的最大长度由客户端在缓存结果时统计，用于分配列缓冲区
+    BindFlag updateMaxLength = 1;
+    mysql_stmt_attr_set(m_stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
+
+    const std::size_t paramCount = mysql_stmt_param_count(m_stmt);
+    m_params.resize(paramCount);
+    m_paramBinds.resize(paramCount);
+    for (auto& bind : m_paramBinds) {
+        std::memset(&bind, 0, sizeof(bind));
+        bind.buffer_type = MYSQL_TYPE_NULL;
+    }
+}
+
+PreparedStatement::~PreparedStatement() {
+    if (m_stmt) {
+        freeResult();
+        mysql_stmt_close(m_stmt);
+    }
+}
+
+void PreparedStatement::bindInt(std::size_t index, long long value) {
+    if (index >= m_params.size()) return;
+    Param& param = m_params[index];
+    MYSQL_BIND& bind = m_paramBinds[index];
+    param.intValue = value;
+    param.isNull = 0;
+    bind.buffer_type = MYSQL_TYPE_LONGLONG;
+    bind.buffer = &param.intValue;
+    bind.is_null = &param.isNull;
+    bind.length = nullptr;
+    bind.is_unsigned = 0;
+}
+
+void PreparedStatement::bindDouble(std::size_t index, double value) {
+    if (index >= m_params.size()) return;
+    Param& param = m_params[index];
+    MYSQL_BIND& bind = m_paramBinds[index];
+    param.doubleValue = value;
+    param.isNull = 0;
+    bind.buffer_type = MYSQL_TYPE_DOUBLE;
+    bind.buffer = &param.doubleValue;
+    bind.is_null = &param.isNull;
+    bind.length = nullptr;
+}
+
+void PreparedStatement::bindString(std::size_t index, const std::string& value) {
+    if (index >= m_params.size()) return;
+    Param& param = m_params[index];
+    MYSQL_BIND& bind = m_paramBinds[index];
+    param.stringValue = value;
+    param.length = static_cast<unsigned long>(param.stringValue.size());
+    param.isNull = 0;
+    bind.buffer_type = MYSQL_TYPE_STRING;
+    bind.buffer = const_cast<char*>(param.stringValue.data());
+    bind.buffer_length = param.length;
+    bind.length = &param.length;
+    bind.is_null = &param.isNull;
+}
+
+void PreparedStatement::bindNull(std::size_t index) {
+    if (index >= m_params.size()) return;
+    Param& param = m_params[index];
+    MYSQL_BIND& bind = m_paramBinds[index];
+    param.isNull = 1;
+    bind.buffer_type = MYSQL_TYPE_NULL;
+    bind.buffer = nullptr;
+    bind.is_null = &param.isNull;
+    bind.length = nullptr;
+}
+
+void PreparedStatement::freeResult() {
+    if (m_hasResult) {
+        mysql_stmt_free_result(m_stmt);
+        m_hasResult = false;
+    }
+    m_columns.clear();
+    m_resultBinds.clear();
+}
+
+bool PreparedStatement::execute() {
+    if (!m_stmt) return false;
+    freeResult();
+
+    if (!m_paramBinds.empty() && mysql_stmt_bind_param(m_stmt, m_paramBinds.data())) {
+        std::cerr << "Failed to bind parameters: " << mysql_stmt_error(m_stmt) << std::endl;
+        return false;
+    }
+    if (mysql_stmt_execute(m_stmt)) {
+        std::cerr << "Failed to execute statement: " << mysql_stmt_error(m_stmt) << std::endl;
+        std::cerr << "SQL: " << m_sql << std::endl;
+        return false;
+    }
+
+    MYSQL_RES* meta = mysql_stmt_result_metadata(m_stmt);
+    if (!meta) {
+        // 非查询语句没有结果集
+        return true;
+    }
+    if (mysql_stmt_store_result(m_stmt)) {
+        std::cerr << "Failed to store statement result: " << mysql_stmt_error(m_stmt) << std::endl;
+        mysql_free_result(meta);
+        return false;
+    }
+    m_hasResult = true;
+
+    const unsigned int fieldCount = mysql_num_fields(meta);
+    MYSQL_FIELD* fields = mysql_fetch_fields(meta);
+    m_columns.resize(fieldCount);
+    for (unsigned int i = 0; i < fieldCount; ++i) {
+        Column& column = m_columns[i];
+        column.name = fields[i].name ? fields[i].name : "";
+        // 数值列转为文本最长约32字节；字符串列按实际最大长度分配
+        std::size_t capacity = std::max<std::size_t>(fields[i].max_length, 32) + 1;
+        column.buffer.assign(capacity, '\0');
+    }
+    mysql_free_result(meta);
+    return bindResultColumns();
+}
+
+bool PreparedStatement::bindResultColumns() {
+    m_resultBinds.assign(m_columns.size(), MYSQL_BIND());
+    for (std::size_t i = 0; i < m_columns.size(); ++i) {
+        Column& column = m_columns[i];
+        MYSQL_BIND& bind = m_resultBinds[i];
+        std::memset(&bind, 0, sizeof(bind));
+        // 所有列按文本取回，由客户端库完成数值和时间类型到文本的转换
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = column.buffer.data();
+        bind.buffer_length = static_cast<unsigned long>(column.buffer.size() - 1);
+        bind.length = &column.length;
+        bind.is_null = &column.isNull;
+        bind.error = &column.truncated;
+    }
+    if (!m_resultBinds.empty() && mysql_stmt_bind_result(m_stmt, m_resultBinds.data())) {
+        std::cerr << "Failed to bind result: " << mysql_stmt_error(m_stmt) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool PreparedStatement::fetch() {
+    if (!m_stmt || !m_hasResult) return false;
+    int status = mysql_stmt_fetch(m_stmt);
+    if (status == MYSQL_NO_DATA) return false;
+    if (status == 1) {
+        std::cerr << "Failed to fetch row: " << mysql_stmt_error(m_stmt) << std::endl;
+        return false;
+    }
+    if (status == MYSQL_DATA_TRUNCATED) {
+        // 缓冲区不足的列按实际长度重新读取，并扩大后续行使用的缓冲区
+        bool rebind = false;
+        for (std::size_t i = 0; i < m_columns.size(); ++i) {
+            Column& column = m_columns[i];
+            if (!column.truncated) continue;
+            column.buffer.assign(column.length + 1, '\0');
+            MYSQL_BIND& bind = m_resultBinds[i];
+            bind.buffer = column.buffer.data();
+            bind.buffer_length = column.length;
+            mysql_stmt_fetch_column(m_stmt, &bind, static_cast<unsigned int>(i), 0);
+            rebind = true;
+        }
+        if (rebind && mysql_stmt_bind_result(m_stmt, m_resultBinds.data())) {
+            std::cerr << "Failed to rebind result: " << mysql_stmt_error(m_stmt) << std::endl;
+            return false;
+        }
+    }
+    for (auto& column : m_columns) {
+        column.buffer[std::min<std::size_t>(column.length, column.buffer.size() - 1)] = '\0';
+    }
+    return true;
+}
+
+bool PreparedStatement::isNull(std::size_t col) const {
+    return col >= m_columns.size() || m_columns[col].isNull;
+}
+
+long long PreparedStatement::getInt(std::size_t col, long long defaultValue) const {
+    if (isNull(col)) return defaultValue;
+    return std::atoll(m_columns[col].buffer.data());
+}
+
+double PreparedStatement::getDouble(std::size_t col, double defaultValue) const {
+    if (isNull(col)) return defaultValue;
+    return std::atof(m_columns[col].buffer.data());
+}
+
+std::string PreparedStatement::getString(std::size_t col, const std::string& defaultValue) const {
+    if (isNull(col)) return defaultValue;
+    const Column& column = m_columns[col];
+    return std::string(column.buffer.data(), std::min<std::size_t>(column.length, column.buffer.size() - 1));
+}
+
+unsigned long long PreparedStatement::insertId() const {
+    return m_stmt ? mysql_stmt_insert_id(m_stmt) : 0;
+}
+
+unsigned long long PreparedStatement::affectedRows() const {
+    return m_stmt ? mysql_stmt_affected_rows(m_stmt) : 0;
+}
+
+unsigned int PreparedStatement::errorCode() const {
+    return m_stmt ? mysql_stmt_errno(m_stmt) : mysql_errno(m_conn);
+}
+
+std::string PreparedStatement::error() const {
+    return m_stmt ? mysql_stmt_error(m_stmt) : mysql_error(m_conn);
+}
+
+// ==================== PooledConnection ====================
+
+PooledConnection::PooledConnection(PooledConnection&& other) noexcept
+    : m_pool(other.m_pool), m_conn(other.m_conn) {
+    other.m_pool = nullptr;
+    other.m_conn = nullptr;
+}
+
+PooledConnection& PooledConnection::operator=(PooledConnection&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_pool = other.m_pool;
+        m_conn = other.m_conn;
+        other.m_pool = nullptr;
+        other.m_conn = nullptr;
+    }
+    return *this;
+}
+
+PooledConnection::~PooledConnection() {
+    release();
+}
+
+void PooledConnection::release() {
+    if (m_pool && m_conn) {
+        m_pool->release(m_conn);
+    }
+    m_pool = nullptr;
+    m_conn = nullptr;
+}
+
+MYSQL* PooledConnection::get() const {
+    return m_conn ? m_conn->mysql : nullptr;
+}
+
+std::string PooledConnection::error() const {
+    return m_conn && m_conn->mysql ? mysql_error(m_conn->mysql) : "no database connection";
+}
+
+PreparedStatement* PooledConnection::prepare(const std::string& sql) {
+    if (!m_conn || !m_conn->mysql) return nullptr;
+
+    auto it = m_conn->statements.find(sql);
+    if (it != m_conn->statements.end()) {
+        m_pool->countStatement(true);
+        return it->second.get();
+    }
+
+    std::unique_ptr<PreparedStatement> stmt(new PreparedStatement(m_conn->mysql, sql));
+    if (!stmt->isValid()) {
+        if (isDisconnectError(mysql_errno(m_conn->mysql))) m_conn->suspect = true;
+        return nullptr;
+    }
+    m_pool->countStatement(false);
+    PreparedStatement* raw = stmt.get();
+    m_conn->statements.emplace(sql, std::move(stmt));
+    return raw;
+}
+
+bool PooledConnection::execute(const std::string& sql) {
+    if (!m_conn || !m_conn->mysql) return false;
+    if (mysql_query(m_conn->mysql, sql.c_str())) {
+        std::cerr << "MySQL query failed: " << mysql_error(m_conn->mysql) << std::endl;
+        if (isDisconnectError(mysql_errno(m_conn->mysql))) m_conn->suspect = true;
+        return false;
+    }
+    // 丢弃可能产生的结果集，保证连接可继续使用
+    MYSQL_RES* res = mysql_store_result(m_conn->mysql);
+    if (res) mysql_free_result(res);
+    return true;
+}
+
+// ==================== DBConnectionPool ====================
+
+DBConnectionPool& DBConnectionPool::getInstance() {
+    static DBConnectionPool instance;
+    return instance;
+}
+
+DBConnectionPool::DBConnectionPool() : m_healthCheckInterval(std::chrono::seconds(30)) {
+}
+
+DBConnectionPool::~DBConnectionPool() {
+    // 仍有连接借出时保留连接对象(进程退出时泄漏)，不释放借出句柄仍在使用的内存
+    shutdown();
+}
+
+MYSQL* DBConnectionPool::openConnection() const {
+    MYSQL* mysql = mysql_init(nullptr);
+    if (!mysql) {
+        std::cerr << "mysql_init failed" << std::endl;
+        return nullptr;
+    }
+    mysql_options(mysql, MYSQL_SET_CHARSET_NAME, "utf8mb4");
+    if (!mysql_real_connect(mysql, m_config.host.c_str(), m_config.user.c_str(), m_config.password.c_str(),
+                            m_config.database.c_str(), m_config.port, nullptr, 0)) {
+        std::cerr << "MySQL connection failed: " << mysql_error(mysql) << std::endl;
+        mysql_close(mysql);
+        return nullptr;
+    }
+    mysql_query(mysql, "SET NAMES utf8mb4");
+    return mysql;
+}
+
+bool DBConnectionPool::init(const DBConfig& config, std::size_t poolSize) {
+    // 客户端库的全局初始化不是线程安全的，必须在创建工作线程连接前完成
+    mysql_library_init(0, nullptr, nullptr);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // 借出的 PooledConnection 持有连接对象的裸指针，关闭旧连接前必须全部归还；
+    // 检查和关闭在同一次加锁内完成，期间不会有新的借出
+    if (borrowedCount() != 0) {
+        std::cerr << "DBConnectionPool: cannot re-initialize while " << borrowedCount()
+                  << " connections are still in use" << std::endl;
+        return false;
+    }
+    closeConnections();
+    m_config = config;
+    m_stats = Stats();
+    if (poolSize == 0) poolSize = 1;
+    for (std::size_t i = 0; i < poolSize; ++i) {
+        MYSQL* mysql = openConnection();
+        if (!mysql) break;
+        std::unique_ptr<PooledConnection::Connection> conn(new PooledConnection::Connection());
+        conn->mysql = mysql;
+        conn->lastUsed = std::chrono::steady_clock::now();
+        m_idle.push_back(conn.get());
+        m_connections.push_back(std::move(conn));
+    }
+    std::cout << "MySQL connection pool initialized with " << m_connections.size()
+              << "/" << poolSize << " connections" << std::endl;
+    return !m_connections.empty();
+}
+
+bool DBConnectionPool::shutdown() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (borrowedCount() != 0) {
+        std::cerr << "DBConnectionPool: cannot shut down while " << borrowedCount()
+                  << " connections are still in use" << std::endl;
+        return false;
+    }
+    closeConnections();
+    return true;
+}
+
+void DBConnectionPool::closeConnections() {
+    for (auto& conn : m_connections) {
+        conn->closeStatements();
+        if (conn->mysql) mysql_close(conn->mysql);
+        conn->mysql = nullptr;
+    }
+    m_idle.clear();
+    m_connections.clear();
+}
+
+bool DBConnectionPool::isInitialized() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_connections.empty();
+}
+
+void DBConnectionPool::setHealthCheckInterval(std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_healthCheckInterval = interval;
+}
+
+PooledConnection DBConnectionPool::acquire(int timeoutMs) {
+    ensureThreadInit();
+
+    PooledConnection::Connection* conn = nullptr;
+    std::chrono::milliseconds healthCheckInterval;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_connections.empty()) {
+            return PooledConnection();
+        }
+        if (m_idle.empty()) {
+            ++m_stats.waits;
+            if (!m_cond.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                 [this]() { return !m_idle.empty() || m_connections.empty(); })
+                || m_connections.empty()) {
+                std::cerr << "DBConnectionPool: timed out waiting for a free connection" << std::endl;
+                return PooledConnection();
+            }
+        }
+        conn = m_idle.back();
+        m_idle.pop_back();
+        ++m_stats.acquisitions;
+        healthCheckInterval = m_healthCheckInterval;
+    }
+
+    // 健康检查在锁外进行，避免网络往返阻塞其他线程借出连接
+    if (conn->suspect || !conn->mysql ||
+        std::chrono::steady_clock::now() - conn->lastUsed >= healthCheckInterval) {
+        ensureHealthy(*conn);
+    }
+    return PooledConnection(this, conn);
+}
+
+void DBConnectionPool::ensureHealthy(PooledConnection::Connection& conn) {
+    if (conn.mysql && mysql_ping(conn.mysql) == 0) {
+        conn.suspect = false;
+        return;
+    }
+
+    std::cerr << "DBConnectionPool: connection lost, reconnecting" << std::endl;
+    // 预编译语句绑定在旧连接上，重连后需要重新预编译
+    conn.closeStatements();
+    if (conn.mysql) mysql_close(conn.mysql);
+    conn.mysql = openConnection();
+    conn.suspect = false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_stats.reconnects;
+}
+
+void DBConnectionPool::release(PooledConnection::Connection* conn) {
+    if (conn->mysql && isDisconnectError(mysql_errno(conn->mysql))) {
+        conn->suspect = true;
+    }
+    conn->lastUsed = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_idle.push_back(conn);
+    }
+    m_cond.notify_one();
+}
+
+void DBConnectionPool::countStatement(bool cacheHit) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (cacheHit) {
+        ++m_stats.statementCacheHits;
+    } else {
+        ++m_stats.statementsPrepared;
+    }
+}
+
+std::size_t DBConnectionPool::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_connections.size();
+}
+
+std::size_t DBConnectionPool::idleCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_idle.size();
+}
+
+DBConnectionPool::Stats DBConnectionPool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
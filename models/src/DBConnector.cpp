@@ -37,6 +37,17 @@ bool DBConnector::staticInit(const std::string& host, const std::string& user, c
     mysql_query(instance.m_conn, "SET NAMES utf8mb4");
     instance.m_connected = true;
     std::cout << "MySQL connection initialized successfully" << std::endl;
+
+    DBConfig config;
+    config.host = host;
+    config.user = user;
+    config.password = password;
+    config.database = db;
+    config.port = port;
+    if (!DBConnectionPool::getInstance().init(config)) {
+        std::cerr << "MySQL connection pool initialization failed" << std::endl;
+        return false;
+    }
     return true;
 }
 
@@ -46,6 +57,7 @@ bool DBConnector::initDefaultConnection() {
 }
 
 void DBConnector::close() {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     if (m_connected && m_conn) {
         mysql_close(m_conn);
         m_conn = nullptr;
@@ -54,6 +66,7 @@ void DBConnector::close() {
 }
 
 bool DBConnector::executeSQL(const std::string& sql) {
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
     
     if (!m_connected || !m_conn) {
         std::cerr << "MySQL not connected" << std::endl;
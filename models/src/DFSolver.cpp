@@ -0,0 +1,246 @@
+#include "../DFSolver.h"
+#include "../../constants/PhysicsConstants.h"
+#include "../../utils/Log.h"
+#include <cmath>
+#include <algorithm>
+
+// 所有法方程均为3x3，按站累加，不构造 N×3 的雅可比矩阵
+
+namespace {
+
+// 当地东-北-天坐标系的旋转矩阵(行向量依次为东、北、天在空间直角坐标系中的方向)
+Eigen::Matrix3d enuRotation(double lonDeg, double latDeg) {
+    const double sl = std::sin(lonDeg * Constants::DEG2RAD), cl = std::cos(lonDeg * Constants::DEG2RAD);
+    const double sb = std::sin(latDeg * Constants::DEG2RAD), cb = std::cos(latDeg * Constants::DEG2RAD);
+    Eigen::Matrix3d R;
+    R << -sl,       cl,      0.0,
+         -sb * cl, -sb * sl, cb,
+          cb * cl,  cb * sl, sb;
+    return R;
+}
+
+// 预处理后的单站观测
+struct PreparedBearing {
+    Eigen::Matrix3d toLocal;  // 公共东北天 -> 侦察站当地东北天
+    Eigen::Vector3d station;  // 侦察站在公共东北天中的位置
+    double azimuth;           // 弧度
+    double elevation;         // 弧度
+    double azimuthWeight;     // 1/σ²（弧度^-2）
+    double elevationWeight;   // 1/σ²，未测俯仰时为0
+};
+
+double wrapAngle(double angle) {
+    while (angle > M_PI) angle -= 2.0 * M_PI;
+    while (angle <= -M_PI) angle += 2.0 * M_PI;
+    return angle;
+}
+
+bool solve3(const Eigen::Matrix3d& A, const Eigen::Vector3d& b, Eigen::Vector3d& x) {
+    Eigen::LDLT<Eigen::Matrix3d> ldlt(A);
+    if (ldlt.info() != Eigen::Success || ldlt.vectorD().minCoeff() <= 1e-12 * ldlt.vectorD().maxCoeff()) {
+        return false;
+    }
+    x = ldlt.solve(b);
+    return true;
+}
+
+// 伪线性最小二乘：到各测向平面/直线的加权垂距平方和最小
+// ranges 为各站到目标的距离估计，用于把角度误差折算为垂距误差
+bool pseudoLinearSolve(const std::vector<PreparedBearing>& bearings, const std::vector<double>& ranges,
+                       bool useAltitude, double altitudeWeight, double altitudeUp, Eigen::Vector3d& x) {
+    Eigen::Matrix3d A = Eigen::Matrix3d::Zero();
+    Eigen::Vector3d b = Eigen::Vector3d::Zero();
+    for (size_t i = 0; i < bearings.size(); ++i) {
+        const PreparedBearing& m = bearings[i];
+        const double sa = std::sin(m.azimuth), ca = std::cos(m.azimuth);
+        const double se = std::sin(m.elevation), ce = std::cos(m.elevation);
+        const double r2 = ranges[i] * ranges[i];
+
+        // 水平法向：方位误差对应的垂距 r·cosε·σθ
+        const Eigen::Vector3d h = m.toLocal.transpose() * Eigen::Vector3d(ca, -sa, 0.0);
+        const double wh = m.azimuthWeight / (r2 * std::max(ce * ce, 1e-6));
+        A.noalias() += wh * h * h.transpose();
+        b.noalias() += wh * h * h.dot(m.station);
+
+        if (m.elevationWeight > 0.0) {
+            // 竖直法向：俯仰误差对应的垂距 r·σε
+            const Eigen::Vector3d v = m.toLocal.transpose() * Eigen::Vector3d(-sa * se, -ca * se, ce);
+            const double wv = m.elevationWeight / r2;
+            A.noalias() += wv * v * v.transpose();
+            b.noalias() += wv * v * v.dot(m.station);
+        }
+    }
+    if (useAltitude) {
+        A(2, 2) += altitudeWeight;
+        b(2) += altitudeWeight * altitudeUp;
+    }
+    return solve3(A, b, x);
+}
+
+} // namespace
+
+DFSolution dfLocateWLS(const std::vector<DFBearing>& bearings, const DFSolverOptions& options) {
+    DFSolution solution;
+    const size_t n = bearings.size();
+    if (n < 2) {
+        PL_LOG_ERROR("测向定位至少需要2个侦察站，当前 %zu 个\n", n);
+        return solution;
+    }
+
+    const bool useAltitude = std::isfinite(options.knownAltitude);
+    bool anyElevation = false;
+    for (const DFBearing& bearing : bearings) {
+        if (!(bearing.azimuthSigma > 0.0)) {
+            PL_LOG_ERROR("测向定位的方位角标准差必须为正数\n");
+            return solution;
+        }
+        anyElevation = anyElevation || bearing.elevationSigma > 0.0;
+    }
+    if (!useAltitude && !anyElevation) {
+        PL_LOG_ERROR("只测方位的测向定位需要给出目标已知高度\n");
+        return solution;
+    }
+    if (useAltitude && !(options.altitudeSigma > 0.0)) {
+        PL_LOG_ERROR("测向定位的高度约束标准差必须为正数\n");
+        return solution;
+    }
+
+    // 公共东北天坐标系原点：各站空间直角坐标的平均值
+    std::vector<COORD3> stationsXyz(n);
+    Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+    for (size_t i = 0; i < n; ++i) {
+        stationsXyz[i] = lbh2xyz(bearings[i].station.p1, bearings[i].station.p2, bearings[i].station.p3);
+        mean += Eigen::Vector3d(stationsXyz[i].p1, stationsXyz[i].p2, stationsXyz[i].p3);
+    }
+    mean /= static_cast<double>(n);
+    const COORD3 originLbh = xyz2lbh(mean.x(), mean.y(), mean.z());
+    const Eigen::Matrix3d toCommon = enuRotation(originLbh.p1, originLbh.p2);
+
+    std::vector<PreparedBearing> prepared(n);
+    double spread = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const DFBearing& bearing = bearings[i];
+        PreparedBearing& m = prepared[i];
+        m.toLocal = enuRotation(bearing.station.p1, bearing.station.p2) * toCommon.transpose();
+        m.station = toCommon * (Eigen::Vector3d(stationsXyz[i].p1, stationsXyz[i].p2, stationsXyz[i].p3) - mean);
+        m.azimuth = bearing.azimuth * Constants::DEG2RAD;
+        m.elevation = bearing.elevationSigma > 0.0 ? bearing.elevation * Constants::DEG2RAD : 0.0;
+        const double sa = bearing.azimuthSigma * Constants::DEG2RAD;
+        const double se = bearing.elevationSigma * Constants::DEG2RAD;
+        m.azimuthWeight = 1.0 / (sa * sa);
+        m.elevationWeight = bearing.elevationSigma > 0.0 ? 1.0 / (se * se) : 0.0;
+        spread += m.station.squaredNorm();
+    }
+    spread = std::max(std::sqrt(spread / n), 1000.0);
+
+    // 高度约束：公共坐标系中的天向分量近似为 已知高度-原点高度，迭代中按真实大地高修正
+    const double altitudeWeight = useAltitude ? 1.0 / (options.altitudeSigma * options.altitudeSigma) : 0.0;
+    const double altitudeUp = useAltitude ? options.knownAltitude - originLbh.p3 : 0.0;
+
+    // 伪线性初始解：先按站阵尺度折算权重，再按第一次解得的站距重新加权
+    Eigen::Vector3d x;
+    std::vector<double> ranges(n, spread);
+    if (!pseudoLinearSolve(prepared, ranges, useAltitude, altitudeWeight, altitudeUp, x)) {
+        if (!options.quiet) PL_LOG_WARN("测向定位伪线性解奇异(测向线近似平行或几何退化)\n");
+        return solution;
+    }
+    for (size_t i = 0; i < n; ++i) ranges[i] = std::max((x - prepared[i].station).norm(), 1.0);
+    pseudoLinearSolve(prepared, ranges, useAltitude, altitudeWeight, altitudeUp, x);
+
+    // 在 x 处累加高斯-牛顿法方程 H=J^T W J, g=J^T W r，返回加权残差平方和
+    auto accumulate = [&](const Eigen::Vector3d& p, Eigen::Matrix3d& H, Eigen::Vector3d& g,
+                          bool* degenerate) {
+        H.setZero();
+        g.setZero();
+        double cost = 0.0;
+        for (const PreparedBearing& m : prepared) {
+            const Eigen::Vector3d d = m.toLocal * (p - m.station);
+            const double rho2 = d.x() * d.x() + d.y() * d.y();
+            if (rho2 < 1e-6) {
+                if (degenerate) *degenerate = true;
+                continue;
+            }
+            const double rho = std::sqrt(rho2);
+            const double rAz = wrapAngle(m.azimuth - std::atan2(d.x(), d.y()));
+            const Eigen::Vector3d jAz = m.toLocal.transpose() * Eigen::Vector3d(d.y() / rho2, -d.x() / rho2, 0.0);
+            H.noalias() += m.azimuthWeight * jAz * jAz.transpose();
+            g.noalias() += m.azimuthWeight * rAz * jAz;
+            cost += m.azimuthWeight * rAz * rAz;
+            if (m.elevationWeight > 0.0) {
+                const double r2 = rho2 + d.z() * d.z();
+                const double rEl = m.elevation - std::atan2(d.z(), rho);
+                const Eigen::Vector3d jEl = m.toLocal.transpose() *
+                    Eigen::Vector3d(-d.z() * d.x() / (rho * r2), -d.z() * d.y() / (rho * r2), rho / r2);
+                H.noalias() += m.elevationWeight * jEl * jEl.transpose();
+                g.noalias() += m.elevationWeight * rEl * jEl;
+                cost += m.elevationWeight * rEl * rEl;
+            }
+        }
+        if (useAltitude) {
+            // 大地高对位置的梯度为目标处的天向单位向量
+            const Eigen::Vector3d xyz = mean + toCommon.transpose() * p;
+            const COORD3 lbh = xyz2lbh(xyz.x(), xyz.y(), xyz.z());
+            const Eigen::Vector3d up = toCommon * enuRotation(lbh.p1, lbh.p2).row(2).transpose();
+            const double rH = options.knownAltitude - lbh.p3;
+            H.noalias() += altitudeWeight * up * up.transpose();
+            g.noalias() += altitudeWeight * rH * up;
+            cost += altitudeWeight * rH * rH;
+        }
+        return cost;
+    };
+
+    Eigen::Matrix3d H;
+    Eigen::Vector3d g;
+    double cost = accumulate(x, H, g, nullptr);
+    for (int iter = 0; iter < options.maxIterations; ++iter) {
+        Eigen::Vector3d step;
+        if (!solve3(H, g, step)) break;
+        solution.iterations = iter + 1;
+
+        // 残差增大时步长减半
+        Eigen::Matrix3d nextH;
+        Eigen::Vector3d nextG;
+        double nextCost = accumulate(x + step, nextH, nextG, nullptr);
+        for (int halving = 0; halving < 8 && nextCost > cost; ++halving) {
+            step *= 0.5;
+            nextCost = accumulate(x + step, nextH, nextG, nullptr);
+        }
+        if (nextCost > cost) break;
+        x += step;
+        H = nextH;
+        g = nextG;
+        cost = nextCost;
+        if (step.norm() < options.tolerance) {
+            solution.converged = true;
+            break;
+        }
+    }
+
+    bool degenerate = false;
+    cost = accumulate(x, H, g, &degenerate);
+    Eigen::Vector3d unused;
+    if (degenerate || !solve3(H, g, unused)) {
+        if (!options.quiet) PL_LOG_WARN("测向定位信息矩阵奇异(目标与侦察站重合或几何退化)\n");
+        return solution;
+    }
+
+    const Eigen::Vector3d xyz = mean + toCommon.transpose() * x;
+    solution.position = {xyz.x(), xyz.y(), xyz.z()};
+    solution.positionLbh = xyz2lbh(xyz.x(), xyz.y(), xyz.z());
+    solution.covarianceEnu = H.inverse();
+    solution.covariance = toCommon.transpose() * solution.covarianceEnu * toCommon;
+    solution.chiSquare = cost;
+    solution.azimuthResiduals.resize(n);
+    solution.elevationResiduals.assign(n, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        const PreparedBearing& m = prepared[i];
+        const Eigen::Vector3d d = m.toLocal * (x - m.station);
+        solution.azimuthResiduals[i] = wrapAngle(m.azimuth - std::atan2(d.x(), d.y())) * Constants::RAD2DEG;
+        if (m.elevationWeight > 0.0) {
+            solution.elevationResiduals[i] =
+                (m.elevation - std::atan2(d.z(), std::hypot(d.x(), d.y()))) * Constants::RAD2DEG;
+        }
+    }
+    solution.valid = true;
+    return solution;
+}
@@ -0,0 +1,32 @@
+#include "../DatabaseModelRepository.h"
+#include "../ReconnaissanceDeviceDAO.h"
+#include "../RadiationSourceDAO.h"
+#include "../SinglePlatformTaskDAO.h"
+
+std::vector<ReconnaissanceDevice> DatabaseModelRepository::getAllReconnaissanceDevices() {
+    return ReconnaissanceDeviceDAO::getInstance().getAllReconnaissanceDevices();
+}
+
+bool DatabaseModelRepository::findReconnaissanceDeviceById(int deviceId, ReconnaissanceDevice& device) {
+    return ReconnaissanceDeviceDAO::getInstance().findReconnaissanceDeviceById(deviceId, device);
+}
+
+bool DatabaseModelRepository::findReconnaissanceDeviceByName(const std::string& name, ReconnaissanceDevice& device) {
+    return ReconnaissanceDeviceDAO::getInstance().findReconnaissanceDeviceByName(name, device);
+}
+
+std::vector<RadiationSource> DatabaseModelRepository::getAllRadiationSources() {
+    return RadiationSourceDAO::getInstance().getAllRadiationSources();
+}
+
+bool DatabaseModelRepository::findRadiationSourceById(int sourceId, RadiationSource& source) {
+    return RadiationSourceDAO::getInstance().findRadiationSourceById(sourceId, source);
+}
+
+bool DatabaseModelRepository::findRadiationSourceByName(const std::string& name, RadiationSource& source) {
+    return RadiationSourceDAO::getInstance().findRadiationSourceByName(name, source);
+}
+
+bool DatabaseModelRepository::addSinglePlatformTask(const SinglePlatformTask& task, int& taskId) {
+    return SinglePlatformTaskDAO::getInstance().addSinglePlatformTask(task, taskId);
+}
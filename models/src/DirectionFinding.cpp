@@ -1,13 +1,14 @@
 #include "../constants/PhysicsConstants.h"
 #include "DirectionFinding.h"
+#include "DFSolver.h"
+#include "TDOASolver.h"
 #include <iostream>
 #include <cmath>
-#include <random>
 #include <algorithm>
 #include <numeric>
 #include <string>
-#include "ReconnaissanceDeviceDAO.h"
-#include "RadiationSourceDAO.h"
+#include "ModelRepository.h"
+#include "../../utils/Log.h"
 
     // double esm1MeanError = 3.0;
     // double esm1StdDev = 1.0;
@@ -36,14 +37,11 @@ void DirectionFinding::init(const std::vector<std::string>& deviceNames, const s
 
 bool DirectionFinding::loadDeviceInfo() {
     m_devices.clear();
-    ReconnaissanceDeviceDAO& deviceDAO = ReconnaissanceDeviceDAO::getInstance();
-    auto allDevices = deviceDAO.getAllReconnaissanceDevices();
+    ModelRepository& repository = ModelRepository::getInstance();
     for (const auto& name : m_deviceNames) {
-        auto it = std::find_if(allDevices.begin(), allDevices.end(), [&](const ReconnaissanceDevice& d) {
-            return d.getDeviceName() == name;
-        });
-        if (it != allDevices.end()) {
-            m_devices.push_back(*it);
+        ReconnaissanceDevice device;
+        if (repository.findReconnaissanceDeviceByName(name, device)) {
+            m_devices.push_back(device);
         } else {
             std::cerr << "找不到侦察设备: " << name << std::endl;
             return false;
@@ -53,13 +51,8 @@ bool DirectionFinding::loadDeviceInfo() {
 }
 
 bool DirectionFinding::loadSourceInfo() {
-    RadiationSourceDAO& sourceDAO = RadiationSourceDAO::getInstance();
-    auto allSources = sourceDAO.getAllRadiationSources();
-    auto it = std::find_if(allSources.begin(), allSources.end(), [&](const RadiationSource& s) {
-        return s.getRadiationName() == m_sourceName;
-    });
-    if (it != allSources.end()) {
-        m_source = *it;
+    ModelRepository& repository = ModelRepository::getInstance();
+    if (repository.findRadiationSourceByName(m_sourceName, m_source)) {
         return true;
     } else {
         std::cerr << "找不到辐射源: " << m_sourceName << std::endl;
@@ -75,62 +68,95 @@ std::vector<int> DirectionFinding::getDeviceIds() const {
 
 int DirectionFinding::getSourceId() const { return m_source.getRadiationId(); }
 
-// 移除无参数的calculate方法，只保留带参数的版本
+// 两站误差参数的兼容接口
 bool DirectionFinding::calculate(double dev1MeanError, double dev1StdDev, 
                              double dev2MeanError, double dev2StdDev) {
+    return calculate({std::make_tuple(dev1MeanError, dev1StdDev),
+                      std::make_tuple(dev2MeanError, dev2StdDev)});
+}
+
+bool DirectionFinding::calculate(const std::vector<std::tuple<double, double>>& deviceErrors,
+                                 const std::vector<std::tuple<double, double>>& elevationDeviceErrors) {
     if (!loadDeviceInfo() || !loadSourceInfo()) return false;
+    if (deviceErrors.empty()) {
+        std::cerr << "未给出测向误差参数" << std::endl;
+        return false;
+    }
+    
+    if (deviceErrors.size() < m_devices.size()) {
+        PL_LOG_WARN("[测向] 给出 %zu 组测向误差参数，侦察站 %zu 个，第 %zu 站起沿用最后一组参数\n",
+                    deviceErrors.size(), m_devices.size(), deviceErrors.size() + 1);
+    }
     
     // 清除之前的测向线信息
     m_directionLines.clear();
     m_deviceErrors.clear();
     
-    // 只用前两个设备
-    const auto& dev1 = m_devices[0];
-    const auto& dev2 = m_devices[1];
-
-    // 存储误差参数
-    m_deviceErrors.push_back(std::make_tuple(dev1MeanError, dev1StdDev));
-    m_deviceErrors.push_back(std::make_tuple(dev2MeanError, dev2StdDev));
-    
-    double error = 0.0;
-    // COORD3->Vector3
-    COORD3 esm1_coord = lbh2xyz(dev1.getLongitude(), dev1.getLatitude(), dev1.getAltitude());
-    COORD3 esm2_coord = lbh2xyz(dev2.getLongitude(), dev2.getLatitude(), dev2.getAltitude());
-    COORD3 target_coord = lbh2xyz(m_source.getLongitude(), m_source.getLatitude(), m_source.getAltitude());
+    const COORD3 target_coord = lbh2xyz(m_source.getLongitude(), m_source.getLatitude(), m_source.getAltitude());
     
-    // 保存目标的真实高度值
-    // double targetAlt = m_source.getAltitude();
-    
-    Vector3 esm1(esm1_coord.p1, esm1_coord.p2, esm1_coord.p3);
-    Vector3 esm2(esm2_coord.p1, esm2_coord.p2, esm2_coord.p3);
-    Vector3 target(target_coord.p1, target_coord.p2, target_coord.p3);
-    
-    // double commonHeight = esm1.z;
-    // esm2.z = commonHeight;
-    // target.z = commonHeight;
-    
-    Vector3 dir1 = calculateDirectionWithError(esm1, target, dev1MeanError, dev1StdDev);
-    Vector3 dir2 = calculateDirectionWithError(esm2, target, dev2MeanError, dev2StdDev);
-    
-    // 存储测向线信息
-    DirectionLine line1 = {0, esm1, dir1, dev1MeanError, dev1StdDev};
-    DirectionLine line2 = {1, esm2, dir2, dev2MeanError, dev2StdDev};
-    m_directionLines.push_back(line1);
-    m_directionLines.push_back(line2);
-    
-    Vector3 estimatedPosition = intersectDirections2D(esm1, dir1, esm2, dir2);
-    error = std::sqrt((estimatedPosition.x - target.x) * (estimatedPosition.x - target.x) +
-                     (estimatedPosition.y - target.y) * (estimatedPosition.y - target.y));
+    // 各站在当地东北天坐标系中测量方位角和俯仰角，叠加测向误差；俯仰误差未单独给出时与方位误差相同
+    std::vector<DFBearing> bearings;
+    for (size_t i = 0; i < m_devices.size(); ++i) {
+        const auto& device = m_devices[i];
+        const auto& errors = deviceErrors[std::min(i, deviceErrors.size() - 1)];
+        const auto& elevationErrors = elevationDeviceErrors.empty()
+            ? errors : elevationDeviceErrors[std::min(i, elevationDeviceErrors.size() - 1)];
+        const double meanError = std::get<0>(errors);
+        const double stdDev = std::get<1>(errors);
+        const double elevationMeanError = std::get<0>(elevationErrors);
+        const double elevationStdDev = std::get<1>(elevationErrors);
+        m_deviceErrors.push_back(errors);
+        
+        const COORD3 esm_coord = lbh2xyz(device.getLongitude(), device.getLatitude(), device.getAltitude());
+        const double sl = std::sin(device.getLongitude() * Constants::DEG2RAD);
+        const double cl = std::cos(device.getLongitude() * Constants::DEG2RAD);
+        const double sb = std::sin(device.getLatitude() * Constants::DEG2RAD);
+        const double cb = std::cos(device.getLatitude() * Constants::DEG2RAD);
+        const double dx = target_coord.p1 - esm_coord.p1;
+        const double dy = target_coord.p2 - esm_coord.p2;
+        const double dz = target_coord.p3 - esm_coord.p3;
+        const double east = -sl * dx + cl * dy;
+        const double north = -sb * cl * dx - sb * sl * dy + cb * dz;
+        const double up = cb * cl * dx + cb * sl * dy + sb * dz;
+        const double trueAzimuth = std::atan2(east, north) * Constants::RAD2DEG;
+        const double trueElevation = std::atan2(up, std::sqrt(east * east + north * north)) * Constants::RAD2DEG;
+        
+        DFBearing bearing;
+        bearing.station = {device.getLongitude(), device.getLatitude(), device.getAltitude()};
+        // 每站独立的随机流，由当前任务和侦察站序号确定
+        RandomStream rng = RandomService::getInstance().stream(RandomPurpose::BearingError, 0, i);
+        bearing.azimuth = trueAzimuth + sampleBearingError(rng, meanError, stdDev);
+        bearing.elevation = trueElevation + sampleBearingError(rng, elevationMeanError, elevationStdDev);
+        // 标准差为0时仍需有限权重
+        bearing.azimuthSigma = std::max(stdDev, 1e-3);
+        bearing.elevationSigma = std::max(elevationStdDev, 1e-3);
+        bearings.push_back(bearing);
+        
+        // 存储测向线信息：测得方位、俯仰在空间直角坐标系中的方向
+        const double azimuthRad = bearing.azimuth * Constants::DEG2RAD;
+        const double elevationRad = bearing.elevation * Constants::DEG2RAD;
+        const double sa = std::sin(azimuthRad), ca = std::cos(azimuthRad);
+        const double se = std::sin(elevationRad), ce = std::cos(elevationRad);
+        Vector3 direction(ce * (-sl * sa - sb * cl * ca) + se * cb * cl,
+                          ce * (cl * sa - sb * sl * ca) + se * cb * sl,
+                          ce * cb * ca + se * sb);
+        DirectionLine line = {static_cast<int>(i), Vector3(esm_coord.p1, esm_coord.p2, esm_coord.p3),
+                              direction, meanError, stdDev};
+        m_directionLines.push_back(line);
+    }
     
-    // 关键修复：直接使用目标真实高度进行坐标转换
-    // 1. 先使用估计位置的XY坐标和真实目标高度创建新的空间直角坐标
-    COORD3 correctedXYZ(estimatedPosition.x, estimatedPosition.y, target_coord.p3);
+    // 方位和俯仰联合三维求解，不使用目标高度先验
+    const DFSolution solution = dfLocateWLS(bearings);
+    if (!solution.valid) return false;
     
-    // 2. 将修正后的空间直角坐标转换为大地坐标
-    auto lbh = xyz2lbh(correctedXYZ.p1, correctedXYZ.p2, correctedXYZ.p3);
+    const double dx = solution.position.p1 - target_coord.p1;
+    const double dy = solution.position.p2 - target_coord.p2;
+    const double dz = solution.position.p3 - target_coord.p3;
     
-    m_result.position = {lbh.p1, lbh.p2, lbh.p3};
-    m_result.error = error;
+    m_result.position = solution.positionLbh;
+    m_result.error = std::sqrt(dx * dx + dy * dy + dz * dz);
+    m_result.cep = horizontalCEP(solution.covariance, solution.position);
+    m_result.chiSquare = solution.chiSquare;
     m_isInitialized = true;
     return true;
 }
@@ -150,18 +176,21 @@ std::tuple<double, double> DirectionFinding::getErrorAngles(int deviceIndex) con
     return std::make_tuple(0.0, 0.0);
 }
 
+// 测向误差采样（度）：随机流由调用方按任务和侦察站派生，后台并发仿真之间不共享状态
+double sampleBearingError(RandomStream& rng, double meanErrorDeg, double stdDevDeg) {
+    return rng.normal(meanErrorDeg, stdDevDeg);
+}
+
 // 向量相关函数实现
 Vector3 calculateDirectionWithError(
     const Vector3& observer, 
     const Vector3& target,
     double meanErrorDeg,  // 均值误差（度）
-    double stdDevDeg      // 标准差（度）
+    double stdDevDeg,     // 标准差（度）
+    RandomStream& rng
 ) {
     double trueAzimuth = std::atan2(target.y - observer.y, target.x - observer.x);
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::normal_distribution<> angleDist(meanErrorDeg, stdDevDeg);
-    double angularErrorRad = angleDist(gen) * Constants::DEG2RAD;
+    double angularErrorRad = sampleBearingError(rng, meanErrorDeg, stdDevDeg) * Constants::DEG2RAD;
     double measuredAzimuth = trueAzimuth + angularErrorRad;
     return Vector3(std::cos(measuredAzimuth), std::sin(measuredAzimuth), 0);
 }
@@ -0,0 +1,250 @@
+#include "../FDOASolver.h"
+#include "../../constants/PhysicsConstants.h"
+#include "../../utils/ParallelFor.h"
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+
+// 雅可比矩阵逐行生成后立即累加进 6×6 法方程，不保存 M×6 的中间矩阵；
+// 每次迭代只在试探点上计算一次残差和法方程，被接受时直接作为下一步的线性化结果
+
+namespace {
+
+typedef Eigen::Matrix<double, 6, 6> Matrix6d;
+
+// 计算 ||r||²，并累加 J^T·J 和 J^T·r
+double accumulateNormalEquations(const FDOAObservation* observations, int count,
+                                 const FDOAState& state, const FDOASolverOptions& options,
+                                 Matrix6d& JTJ, FDOAState& JTr) {
+    const double k = options.carrierFrequency / Constants::c;
+    const Eigen::Vector3d position = state.head<3>();
+    const Eigen::Vector3d velocity = state.tail<3>();
+
+    JTJ.setZero();
+    JTr.setZero();
+    double cost = 0.0;
+
+    for (int i = 0; i < count; ++i) {
+        const FDOAObservation& obs = observations[i];
+        // 辐射源指向侦察站的视线向量
+        const Eigen::Vector3d d = obs.stationPosition - position - velocity * obs.time;
+        double range = d.norm();
+        if (range < 1e-6) range = 1e-6;
+        const Eigen::Vector3d u = d / range;
+        const Eigen::Vector3d w = obs.stationVelocity - velocity;
+        const double radialVelocity = w.dot(u);
+
+        const double r = obs.dopplerShift - k * radialVelocity;
+
+        // ∂r/∂p = k·(I - u·u^T)·w/|d|，∂r/∂v = k·u + t·∂r/∂p
+        const Eigen::Vector3d dp = (k / range) * (w - radialVelocity * u);
+        FDOAState row;
+        row.head<3>() = dp;
+        row.tail<3>() = k * u + obs.time * dp;
+
+        JTJ.noalias() += row * row.transpose();
+        JTr.noalias() += row * r;
+        cost += r * r;
+    }
+
+    // 速度约束残差 w·(v - v_expected)，雅可比为 w·I
+    if (options.velocityWeight > 0.0) {
+        const double weight = options.velocityWeight;
+        const Eigen::Vector3d r = weight * (velocity - options.expectedVelocity);
+        JTJ.bottomRightCorner<3, 3>().diagonal().array() += weight * weight;
+        JTr.tail<3>() += weight * r;
+        cost += r.squaredNorm();
+    }
+    return cost;
+}
+
+// 6维Sobol序列的方向数(Joe-Kuo)：多项式次数s、系数a、初始值m
+const int SOBOL_DIMENSIONS = 6;
+const int SOBOL_BITS = 32;
+const unsigned int SOBOL_DEGREE[SOBOL_DIMENSIONS] = {0, 1, 2, 3, 3, 4};
+const unsigned int SOBOL_COEFF[SOBOL_DIMENSIONS] = {0, 0, 1, 1, 2, 1};
+const unsigned int SOBOL_INIT[SOBOL_DIMENSIONS][4] = {
+    {0, 0, 0, 0}, {1, 0, 0, 0}, {1, 3, 0, 0}, {1, 3, 1, 0}, {1, 1, 1, 0}, {1, 1, 3, 3},
+};
+
+// 第 index 个Sobol点(格雷码顺序)，各分量在 [0, 1) 内
+void sobolPoint(std::uint32_t index, double point[SOBOL_DIMENSIONS]) {
+    static const struct Directions {
+        std::uint32_t v[SOBOL_DIMENSIONS][SOBOL_BITS];
+        Directions() {
+            for (int k = 0; k < SOBOL_BITS; ++k) {
+                v[0][k] = 1u << (31 - k);
+            }
+            for (int d = 1; d < SOBOL_DIMENSIONS; ++d) {
+                const unsigned int s = SOBOL_DEGREE[d];
+                for (unsigned int k = 0; k < s; ++k) {
+                    v[d][k] = SOBOL_INIT[d][k] << (31 - k);
+                }
+                for (unsigned int k = s; k < SOBOL_BITS; ++k) {
+                    v[d][k] = v[d][k - s] ^ (v[d][k - s] >> s);
+                    for (unsigned int l = 1; l < s; ++l) {
+                        if ((SOBOL_COEFF[d] >> (s - 1 - l)) & 1u) v[d][k] ^= v[d][k - l];
+                    }
+                }
+            }
+        }
+    } directions;
+
+    const std::uint32_t gray = index ^ (index >> 1);
+    for (int d = 0; d < SOBOL_DIMENSIONS; ++d) {
+        std::uint32_t x = 0;
+        for (int k = 0; k < SOBOL_BITS; ++k) {
+            if ((gray >> k) & 1u) x ^= directions.v[d][k];
+        }
+        point[d] = x * (1.0 / 4294967296.0);
+    }
+}
+
+} // namespace
+
+double fdoaPredictDoppler(const FDOAObservation& observation, const FDOAState& state, double carrierFrequency) {
+    const Eigen::Vector3d d = observation.stationPosition - state.head<3>() - state.tail<3>() * observation.time;
+    const double range = std::max(d.norm(), 1e-6);
+    const Eigen::Vector3d w = observation.stationVelocity - state.tail<3>();
+    return carrierFrequency / Constants::c * w.dot(d) / range;
+}
+
+FDOASolution fdoaSolveLM(const FDOAObservation* observations, int count,
+                         const FDOAState& initialState, const FDOASolverOptions& options) {
+    FDOASolution result;
+    result.state = initialState;
+
+    Matrix6d JTJ;
+    FDOAState JTr;
+    double cost = accumulateNormalEquations(observations, count, result.state, options, JTJ, JTr);
+    result.finalError = std::sqrt(cost);
+    if (result.finalError < options.tolerance) {
+        result.converged = true;
+        return result;
+    }
+
+    // 阻尼项按 diag(J^T·J) 缩放，位置(米)和速度(m/s)的量级差异不影响步长
+    double mu = 1e-3;
+    double nu = 2.0;
+
+    Matrix6d trialJTJ;
+    FDOAState trialJTr;
+    for (int iter = 0; iter < options.maxIterations; ++iter) {
+        result.iterations = iter + 1;
+
+        const FDOAState scale = JTJ.diagonal().cwiseMax(1e-12 * JTJ.diagonal().maxCoeff()).cwiseMax(1e-300);
+        Matrix6d A = JTJ;
+        A.diagonal() += mu * scale;
+
+        // 求解 (J^T·J + μ·D)·h = -J^T·r
+        const Eigen::LDLT<Matrix6d> ldlt(A);
+        if (ldlt.info() != Eigen::Success) {
+            mu *= nu;
+            nu *= 2.0;
+            continue;
+        }
+        const FDOAState h = ldlt.solve(-JTr);
+        const double stepNorm = h.norm();
+        if (stepNorm < options.tolerance) {
+            result.converged = true;
+            break;
+        }
+
+        const FDOAState trial = result.state + h;
+        const double trialCost = accumulateNormalEquations(observations, count, trial, options, trialJTJ, trialJTr);
+
+        // 增益比：实际下降 / 线性模型预测的下降
+        const double predicted = h.dot(mu * scale.cwiseProduct(h) - JTr);
+        const double rho = predicted > 0.0 ? (cost - trialCost) / predicted : -1.0;
+
+        if (rho > 0.0) {
+            result.state = trial;
+            cost = trialCost;
+            JTJ = trialJTJ;
+            JTr = trialJTr;
+            result.finalError = std::sqrt(cost);
+
+            const double t = 2.0 * rho - 1.0;
+            mu *= std::max(1.0 / 3.0, 1.0 - t * t * t);
+            nu = 2.0;
+
+            if (result.finalError < options.tolerance) {
+                result.converged = true;
+                break;
+            }
+        } else {
+            mu *= nu;
+            nu *= 2.0;
+            // 阻尼已大到步长可以忽略，视为停滞
+            if (mu > 1e30) break;
+        }
+    }
+    return result;
+}
+
+FDOASolution fdoaSolveLM(const std::vector<FDOAObservation>& observations,
+                         const FDOAState& initialState, const FDOASolverOptions& options) {
+    return fdoaSolveLM(observations.data(), static_cast<int>(observations.size()), initialState, options);
+}
+
+std::vector<FDOAState> fdoaMultiStartGuesses(const FDOAState& prior, const FDOAMultiStartOptions& multiStart) {
+    const int count = std::max(1, multiStart.startCount);
+    std::vector<FDOAState> guesses;
+    guesses.reserve(count);
+    guesses.push_back(prior);
+
+    FDOAState halfWidth;
+    halfWidth << multiStart.positionSpread, multiStart.positionSpread, multiStart.positionSpread,
+                 multiStart.velocitySpread, multiStart.velocitySpread, multiStart.velocitySpread;
+    // Sobol序列第0个点是原点(角点)，从第1个点开始取
+    for (int i = 1; i < count; ++i) {
+        double u[SOBOL_DIMENSIONS];
+        sobolPoint(static_cast<std::uint32_t>(i), u);
+        FDOAState guess = prior;
+        for (int d = 0; d < SOBOL_DIMENSIONS; ++d) {
+            guess[d] += (2.0 * u[d] - 1.0) * halfWidth[d];
+        }
+        guesses.push_back(guess);
+    }
+    return guesses;
+}
+
+FDOAMultiStartResult fdoaSolveMultiStart(const std::vector<FDOAObservation>& observations,
+                                         const FDOAState& prior,
+                                         const FDOASolverOptions& options,
+                                         const FDOAMultiStartOptions& multiStart) {
+    const std::vector<FDOAState> guesses = fdoaMultiStartGuesses(prior, multiStart);
+    std::vector<FDOASolution> solutions(guesses.size());
+
+    parallelFor(guesses.size(), multiStart.threadCount, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            solutions[i] = fdoaSolveLM(observations, guesses[i], options);
+        }
+    });
+
+    FDOAMultiStartResult result;
+    result.startCount = static_cast<int>(solutions.size());
+    for (std::size_t i = 0; i < solutions.size(); ++i) {
+        const FDOASolution& s = solutions[i];
+        result.totalIterations += s.iterations;
+        if (s.converged) ++result.convergedCount;
+
+        // 收敛解优先，其次比较残差
+        bool better = result.bestStart < 0;
+        if (!better) {
+            const FDOASolution& best = solutions[result.bestStart];
+            better = (s.converged && !best.converged) ||
+                     (s.converged == best.converged && s.finalError < best.finalError);
+        }
+        if (better) result.bestStart = static_cast<int>(i);
+    }
+
+    result.best = solutions[result.bestStart];
+    for (const FDOASolution& s : solutions) {
+        if (s.converged &&
+            (s.state.head<3>() - result.best.state.head<3>()).norm() <= multiStart.agreementRadius) {
+            ++result.agreeingCount;
+        }
+    }
+    return result;
+}
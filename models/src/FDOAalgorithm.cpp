@@ -3,13 +3,18 @@
 #include "../../utils/CoordinateTransform.h"
 #include "../../utils/SNRValidator.h"
 #include "../../utils/Vector3.h"
+#include "../../utils/Instrumentation.h"
+#include "../../utils/Log.h"
+#include "../../utils/RandomStream.h"
+#include "../FDOASolver.h"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
 #include <vector>
 #include <cstdlib>
 #include <ctime>
-#include <random>    
+#include <limits>
+#include <algorithm>
 
 // 算法参数常量定义
 namespace {
@@ -32,19 +37,22 @@ FDOAalgorithm& FDOAalgorithm::getInstance() {
     return instance;
 }
 
-FDOAalgorithm::FDOAalgorithm() {}
+FDOAalgorithm::FDOAalgorithm() : m_simulationTime(0.0), m_observationCount(3) {}
 
 FDOAalgorithm::~FDOAalgorithm() {}
 //初始化
 void FDOAalgorithm::init(const std::vector<std::string>& deviceNames, 
                         const std::string& sourceName,
                         const std::string& systemType,
-                        double simulationTime) {
+                        double simulationTime,
+                        int observationCount) {
     m_deviceNames = deviceNames;
     m_sourceName = sourceName;
     m_systemType = systemType;
     m_simulationTime = simulationTime;
+    m_observationCount = std::max(1, observationCount);
     m_devices.clear();
+    m_epochs.clear();
     
     // 初始化定位结果
     m_result = SourcePositionResult{};
@@ -56,22 +64,29 @@ void FDOAalgorithm::init(const std::vector<std::string>& deviceNames,
     m_result.locationTime = 0.0;
 }
 
+// 在 [0, simulationTime] 内均匀取观测时刻
+std::vector<double> FDOAalgorithm::observationEpochs(double simulationTime, int count) {
+    std::vector<double> timePoints;
+    if (count <= 1) {
+        timePoints.push_back(0.0);
+        return timePoints;
+    }
+    timePoints.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        timePoints.push_back(simulationTime * i / (count - 1));
+    }
+    return timePoints;
+}
+
 // 加载设备信息
 bool FDOAalgorithm::loadDeviceInfo() {
-    ReconnaissanceDeviceDAO& deviceDAO = ReconnaissanceDeviceDAO::getInstance();
-    
-    // 获取所有设备
-    std::vector<ReconnaissanceDevice> allDevices = deviceDAO.getAllReconnaissanceDevices();
+    ModelRepository& repository = ModelRepository::getInstance();
     
-    // 根据名称查找设备
+    // 根据名称查找设备(缓存)
     for (const std::string& deviceName : m_deviceNames) {
-        bool found = false;
-        for (const ReconnaissanceDevice& device : allDevices) {
-            if (device.getDeviceName() == deviceName) {
-                m_devices.push_back(device);
-                found = true;
-                break;
-            }
+        ReconnaissanceDevice device;
+        if (repository.findReconnaissanceDeviceByName(deviceName, device)) {
+            m_devices.push_back(device);
         }
     }
     return true;
@@ -79,26 +94,15 @@ bool FDOAalgorithm::loadDeviceInfo() {
 
 // 加载辐射源信息
 bool FDOAalgorithm::loadSourceInfo() {
-    RadiationSourceDAO& sourceDAO = RadiationSourceDAO::getInstance();
-    
-    // 获取所有辐射源
-    std::vector<RadiationSource> allSources = sourceDAO.getAllRadiationSources();
-    
-    // 根据名称查找辐射源
-    for (const RadiationSource& source : allSources) {
-        if (source.getRadiationName() == m_sourceName) {
-            m_source = source;
-            return true;
-        }
-    }
-    return false;
+    // 根据名称查找辐射源(缓存)
+    return ModelRepository::getInstance().findRadiationSourceByName(m_sourceName, m_source);
 }
 
 //计算最小时间间隔
 double FDOAalgorithm::calculateMinimumTimeInterval(int deviceId, int sourceId) {
     // 获取侦察设备和辐射源信息
-    ReconnaissanceDevice device = ReconnaissanceDeviceDAO::getInstance().getReconnaissanceDeviceById(deviceId);
-    RadiationSource source = RadiationSourceDAO::getInstance().getRadiationSourceById(sourceId);
+    ReconnaissanceDevice device = ModelRepository::getInstance().getReconnaissanceDeviceById(deviceId);
+    RadiationSource source = ModelRepository::getInstance().getRadiationSourceById(sourceId);
     
     // 计算侦察设备速度向量
     COORD3 deviceVelocity = velocity_lbh2xyz(device.getLongitude(),device.getLatitude(),
@@ -148,7 +152,7 @@ double FDOAalgorithm::calculateMinimumTimeInterval(int deviceId, int sourceId) {
 //计算最大时间间隔
 double FDOAalgorithm::calculateMaximumTimeInterval(const std::vector<int>& deviceIds, int sourceId) {
     // 获取辐射源信息
-    RadiationSource source = RadiationSourceDAO::getInstance().getRadiationSourceById(sourceId);
+    RadiationSource source = ModelRepository::getInstance().getRadiationSourceById(sourceId);
     
     double minMaxTime = std::numeric_limits<double>::max();
     
@@ -161,7 +165,7 @@ double FDOAalgorithm::calculateMaximumTimeInterval(const std::vector<int>& devic
     
     // 遍历所有侦察设备，计算侦收频率范围交集
     for (int deviceId : deviceIds) {
-        ReconnaissanceDevice device = ReconnaissanceDeviceDAO::getInstance().getReconnaissanceDeviceById(deviceId);
+        ReconnaissanceDevice device = ModelRepository::getInstance().getReconnaissanceDeviceById(deviceId);
         intersectFreqMin = std::max(intersectFreqMin, static_cast<double>(device.getFreqRangeMin()));
         intersectFreqMax = std::min(intersectFreqMax, static_cast<double>(device.getFreqRangeMax()));
     }
@@ -172,7 +176,7 @@ double FDOAalgorithm::calculateMaximumTimeInterval(const std::vector<int>& devic
     // 对每个设备计算最大时间间隔
     for (int deviceId : deviceIds) {
         // 获取侦察设备信息
-        ReconnaissanceDevice device = ReconnaissanceDeviceDAO::getInstance().getReconnaissanceDeviceById(deviceId);
+        ReconnaissanceDevice device = ModelRepository::getInstance().getReconnaissanceDeviceById(deviceId);
         
         // 使用CoordinateTransform计算速度向量
         COORD3 deviceVelocity = velocity_lbh2xyz(device.getLongitude(),device.getLatitude(),
@@ -275,16 +279,44 @@ std::vector<double> FDOAalgorithm::solveQuadratic(double a, double b, double c)
 
 // 获取定位结果
 FDOAalgorithm::SourcePositionResult FDOAalgorithm::getResult() const {return m_result;}
+
+void FDOAalgorithm::setMultiStartOptions(const FDOAMultiStartOptions& options) {
+    m_multiStart = options;
+}
+
+void FDOAalgorithm::setVisibilityOptions(const VisibilityTimelineOptions& options) {
+    m_visibility = options;
+}
+
+// 平台在仿真时段内移动，初始时刻可见不代表各观测时刻都可见
+std::vector<double> FDOAalgorithm::selectObservationEpochs() const {
+    const std::vector<double> nominal = observationEpochs(m_simulationTime, m_observationCount);
+    const VisibilityTimeline timeline = computeVisibilityTimeline(m_devices, m_source, m_simulationTime, m_visibility);
+    std::vector<double> epochs = timeline.selectEpochs(nominal);
+    if (epochs.empty()) {
+        PL_LOG_WARN("[FDOA] 仿真时间内没有所有侦察设备都能接收信号的时刻，仍使用均匀观测时刻\n");
+        return nominal;
+    }
+    if (epochs != nominal) {
+        PL_LOG_INFO("[FDOA] 部分观测时刻不可接收，改用可接收时段内的 %zu 个观测时刻(%g ~ %g 秒)\n",
+                    epochs.size(), epochs.front(), epochs.back());
+    }
+    return epochs;
+}
 //频差定位
 bool FDOAalgorithm::calculate() {
-    // 1. 加载设备信息
-    if (!loadDeviceInfo()) {
-        return false;
-    }
+    PL_TRACE_SCOPE("FDOA.calculate");
+    {
+        PL_TRACE_SCOPE("FDOA.load");
+        // 1. 加载设备信息
+        if (!loadDeviceInfo()) {
+            return false;
+        }
 
-    // 2. 加载辐射源信息
-    if (!loadSourceInfo()) {
-        return false;
+        // 2. 加载辐射源信息
+        if (!loadSourceInfo()) {
+            return false;
+        }
     }
 
     // 获取辐射源ID和设备ID
@@ -323,31 +355,36 @@ bool FDOAalgorithm::calculate() {
     std::pair<COORD3, Vector3> initialGuess = generateGaussianPerturbedInitialGuess(
         m_source, POSITION_SIGMA, VELOCITY_SIGMA, ANGLE_SIGMA);
 
-    // 5. 实际频差矩阵
+    // 5. 观测时刻取在全部设备都能接收的时段内
+    {
+        PL_TRACE_SCOPE("FDOA.selectEpochs");
+        m_epochs = selectObservationEpochs();
+    }
+
+    // 实际频差矩阵
     //随机测量误差
     std::vector<std::vector<double>> observedFDOA = calculateFrequencyDifferences(
-        deviceIds, sourceId, m_simulationTime, DOPPLER_ERROR_STD_DEV);
-
-    //打印辐射源信息
-    std::cout << "\n辐射源信息：" << std::endl;
-    std::cout << "----------------------------------------" << std::endl;
-    std::cout << "辐射源名称: " << m_source.getRadiationName() << std::endl;
-    std::cout << "经度: " << m_source.getLongitude() << " 度" << std::endl;
-    std::cout << "纬度: " << m_source.getLatitude() << " 度" << std::endl;
-    std::cout << "高度: " << m_source.getAltitude() << " 米" << std::endl;
-    std::cout << "运动速度: " << m_source.getMovementSpeed() << " m/s" << std::endl;
-    std::cout << "运动方位角: " << m_source.getMovementAzimuth() << " 度" << std::endl;
-    std::cout << "运动俯仰角: " << m_source.getMovementElevation() << " 度" << std::endl;
-    std::cout << "----------------------------------------" << std::endl;
-
-    // 6. 使用带有扰动的初始值进行非线性优化求解
-    m_result = solveSourcePosition(deviceIds,
+        deviceIds, sourceId, m_epochs, DOPPLER_ERROR_STD_DEV);
+
+    PL_LOG_DEBUG("[FDOA] 辐射源 %s: %g 度, %g 度, %g 米, 速度 %g m/s, 方位角 %g 度, 俯仰角 %g 度\n",
+                 m_source.getRadiationName().c_str(), m_source.getLongitude(), m_source.getLatitude(),
+                 m_source.getAltitude(), m_source.getMovementSpeed(),
+                 m_source.getMovementAzimuth(), m_source.getMovementElevation());
+
+    // 6. 以带有扰动的初始值为中心多起点并行求解
+    PL_TRACE_SCOPE("FDOA.solve");
+    m_result = solveSourcePositionMultiStart(deviceIds,
                                  observedFDOA,
-                                 m_simulationTime,
+                                 m_epochs,
                                  initialGuess.first,
                                  initialGuess.second,
+                                 m_multiStart,
                                  MAX_ITERATIONS,
                                  TOLERANCE);
+    PL_COUNTER_ADD("fdoa.solves", 1);
+    PL_COUNTER_ADD("fdoa.lmIterations", m_result.iterations);
+    PL_LOG_INFO("[FDOA] 多起点求解: %d/%d 个起点收敛, 残差 %g\n",
+                m_result.convergedStarts, m_result.startCount, m_result.finalError);
 
     // 计算速度大小
     double speedMagnitude = std::sqrt(m_result.velocity.x * m_result.velocity.x +
@@ -370,27 +407,31 @@ std::vector<std::vector<double>> FDOAalgorithm::calculateFrequencyDifferences(
     int sourceId,
     double simulationTime,
     double errorStdDev) {  
+    return calculateFrequencyDifferences(deviceIds, sourceId,
+                                         observationEpochs(simulationTime, m_observationCount), errorStdDev);
+}
+
+std::vector<std::vector<double>> FDOAalgorithm::calculateFrequencyDifferences(
+    const std::vector<int>& deviceIds,
+    int sourceId,
+    const std::vector<double>& timePoints,
+    double errorStdDev) {
     
-    std::vector<std::vector<double>> dopplerShifts(3, std::vector<double>(3, 0.0));
+    std::vector<std::vector<double>> dopplerShifts(deviceIds.size(), std::vector<double>(timePoints.size(), 0.0));
     
     // 获取辐射源信息
-    RadiationSource source = RadiationSourceDAO::getInstance().getRadiationSourceById(sourceId);
+    RadiationSource source = ModelRepository::getInstance().getRadiationSourceById(sourceId);
     double sourceFrequency = source.getCarrierFrequency() * 1e9;
     
-    // 计算观测时刻
-    std::vector<double> timePoints = {0.0, simulationTime / 2.0, simulationTime};
-    
-    // 随机数生成器（用于产生高斯噪声）
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<double> noiseDist(0.0, errorStdDev);  // 均值0，标准差errorStdDev的正态分布
+    // 噪声随机流按(当前任务, 观测时刻序号, 侦察站序号)派生，与调用顺序和线程无关
+    const RandomService& randomService = RandomService::getInstance();
     
     // 计算辐射源速度
     COORD3 sourceVel0 = calculateSourceVelocity(source);
     
     // 遍历每个侦察设备
     for (size_t i = 0; i < deviceIds.size(); ++i) {
-        ReconnaissanceDevice device = ReconnaissanceDeviceDAO::getInstance().getReconnaissanceDeviceById(deviceIds[i]);
+        ReconnaissanceDevice device = ModelRepository::getInstance().getReconnaissanceDeviceById(deviceIds[i]);
         COORD3 deviceVel0 = calculateDeviceVelocity(device);
         
         for (size_t j = 0; j < timePoints.size(); ++j) {
@@ -413,8 +454,9 @@ std::vector<std::vector<double>> FDOAalgorithm::calculateFrequencyDifferences(
             // 计算理论多普勒频移
             double theoreticalShift = (radialVelocity / Constants::c) * sourceFrequency;
             
-            // 生成高斯噪声并叠加到频移结果中
-            double measurementNoise = noiseDist(gen);
+            // 生成高斯噪声（均值0，标准差errorStdDev）并叠加到频移结果中
+            RandomStream rng = randomService.stream(RandomPurpose::FrequencyNoise, j, i);
+            double measurementNoise = rng.normal(0.0, errorStdDev);
             dopplerShifts[i][j] = theoreticalShift + measurementNoise;
         }
     }
@@ -433,30 +475,23 @@ std::pair<COORD3, Vector3> FDOAalgorithm::generateGaussianPerturbedInitialGuess(
     double azimuth = source.getMovementAzimuth();
     double elevation = source.getMovementElevation();
     
-    // 随机数生成器
-    std::random_device rd;
-    std::mt19937 gen(rd());
+    // 随机流
+    RandomStream rng = RandomService::getInstance().stream(RandomPurpose::InitialGuess);
     
     // 1. 对位置添加高斯扰动（经纬度转换为米级扰动）
     // 经纬度1°约等于111km，将米级标准差转换为度数
     double lonSigma = positionSigma / 111000.0; // 经度方向标准差（度）
     double latSigma = positionSigma / 111000.0; // 纬度方向标准差（度）
-    std::normal_distribution<double> lonDist(0.0, lonSigma);
-    std::normal_distribution<double> latDist(0.0, latSigma);
-    
-    double perturbedLon = longitude + lonDist(gen);
-    double perturbedLat = latitude + latDist(gen);
+    double perturbedLon = longitude + rng.normal(0.0, lonSigma);
+    double perturbedLat = latitude + rng.normal(0.0, latSigma);
     double perturbedAlt = altitude;  // 不对高度添加扰动，直接使用原始高度
     
     // 2. 对速度添加高斯扰动
     double perturbedSpeed, perturbedAzimuth, perturbedElevation;
     if (speed > 1e-6) { // 非静止辐射源
-        std::normal_distribution<double> speedDist(0.0, velocitySigma);
-        std::normal_distribution<double> angleDist(0.0, angleSigma);
-        
-        perturbedSpeed = speed + speedDist(gen);
-        perturbedAzimuth = azimuth + angleDist(gen);
-        perturbedElevation = elevation + angleDist(gen);
+        perturbedSpeed = speed + rng.normal(0.0, velocitySigma);
+        perturbedAzimuth = azimuth + rng.normal(0.0, angleSigma);
+        perturbedElevation = elevation + rng.normal(0.0, angleSigma);
         
         // 确保速度为正
         perturbedSpeed = std::max(1e-6, perturbedSpeed);
@@ -491,291 +526,132 @@ FDOAalgorithm::SourcePositionResult FDOAalgorithm::solveSourcePosition(
     Vector3 initialVelocity,
     int maxIterations,
     double tolerance) {
+    return solveSourcePosition(deviceIds, observedFDOA, observationEpochs(simulationTime, m_observationCount),
+                               initialPosition, initialVelocity, maxIterations, tolerance);
+}
+
+FDOAalgorithm::SourcePositionResult FDOAalgorithm::solveSourcePosition(
+    const std::vector<int>& deviceIds,
+    const std::vector<std::vector<double>>& observedFDOA,
+    const std::vector<double>& timePoints,
+    COORD3 initialPosition,
+    Vector3 initialVelocity,
+    int maxIterations,
+    double tolerance) {
     
     SourcePositionResult result;
+    result.position = initialPosition;
+    result.velocity = initialVelocity;
     result.converged = false;
     result.iterations = 0;
     result.finalError = std::numeric_limits<double>::max();
+    result.locationTime = 0.0;
     
-    // 初始化参数向量：[x, y, z, vx, vy, vz]
-    std::vector<double> x = {
-        initialPosition.p1, initialPosition.p2, initialPosition.p3,
-        initialVelocity.x, initialVelocity.y, initialVelocity.z
-    };
-    // 计算观测时刻
-    std::vector<double> timePoints = {0.0, simulationTime / 2.0, simulationTime};
-    
-    // Levenberg-Marquardt迭代
-    double lambda = 1e-3;  // 阻尼因子
-    const double lambdaFactor = 10.0;  // lambda的调整因子
-    
-    for (int iter = 0; iter < maxIterations; ++iter) {
-        // 计算残差和雅可比矩阵
-        std::vector<double> residuals = calculateResiduals(x, deviceIds, observedFDOA, timePoints);
-        std::vector<std::vector<double>> J = calculateJacobian(x, deviceIds, timePoints, observedFDOA);
-        
-        // 计算JᵀJ和Jᵀr
-        std::vector<std::vector<double>> JTJ(6, std::vector<double>(6, 0.0));
-        std::vector<double> JTr(6, 0.0);
-
-        
-        for (size_t i = 0; i < J.size(); ++i) {
-            for (int j = 0; j < 6; ++j) {
-                for (int k = 0; k < 6; ++k) {
-                    JTJ[j][k] += J[i][j] * J[i][k];
-                }
-                JTr[j] += J[i][j] * residuals[i];
-            }
-        }
-        
-        // 添加阻尼项
-        for (int i = 0; i < 6; ++i) {
-            JTJ[i][i] += lambda;
-        }
-        
-        // 求解增量方程 (JᵀJ + λI)Δx = -Jᵀr
-        std::vector<double> dx = solveLinearEquations(JTJ, JTr);
-        
-        // 计算新参数
-        std::vector<double> x_new = x;
-        for (int i = 0; i < 6; ++i) {
-            x_new[i] += dx[i];
-        }
-        
-        // 计算新的误差
-        std::vector<double> new_residuals = calculateResiduals(x_new, deviceIds, observedFDOA, timePoints);
-        double new_error = 0.0;
-        for (double r : new_residuals) {
-            new_error += r * r;
-        }
-        new_error = std::sqrt(new_error);
-        
-        // 判断是否接受新参数
-        if (new_error < result.finalError) {
-            x = x_new;
-            result.finalError = new_error;
-            lambda /= lambdaFactor;
-            
-            // 检查收敛条件
-            double dx_norm = 0.0;
-            for (double d : dx) {
-                dx_norm += d * d;
-            }
-            dx_norm = std::sqrt(dx_norm);
-            // 收敛条件
-            if (dx_norm < tolerance || new_error < tolerance) {
-                result.converged = true;
-                break;
-            }
-        } else {
-            lambda *= lambdaFactor;
-        }
-        
-        result.iterations = iter + 1;
+    std::vector<FDOAObservation> observations;
+    FDOASolverOptions options;
+    if (!prepareObservations(deviceIds, observedFDOA, timePoints, observations, options)) {
+        return result;
     }
+    options.maxIterations = maxIterations;
+    options.tolerance = tolerance;
+    
+    // Levenberg-Marquardt迭代：参数向量 [x, y, z, vx, vy, vz]
+    FDOAState initialState;
+    initialState << initialPosition.p1, initialPosition.p2, initialPosition.p3,
+                    initialVelocity.x, initialVelocity.y, initialVelocity.z;
+    FDOASolution solution = fdoaSolveLM(observations, initialState, options);
     
     // 保存最终结果
-    result.position.p1 = x[0];
-    result.position.p2 = x[1];
-    result.position.p3 = x[2];
-    result.velocity.x = x[3];
-    result.velocity.y = x[4];
-    result.velocity.z = x[5];
+    result.position = COORD3{solution.state[0], solution.state[1], solution.state[2]};
+    result.velocity = Vector3{solution.state[3], solution.state[4], solution.state[5]};
+    result.converged = solution.converged;
+    result.iterations = solution.iterations;
+    result.finalError = solution.finalError;
     
     return result;
 }
 
-//计算残差
-std::vector<double> FDOAalgorithm::calculateResiduals(
-    const std::vector<double>& params,
+// 多起点并行求解辐射源位置和速度
+FDOAalgorithm::SourcePositionResult FDOAalgorithm::solveSourcePositionMultiStart(
     const std::vector<int>& deviceIds,
     const std::vector<std::vector<double>>& observedFDOA,
-    const std::vector<double>& timePoints) {
-    
-    int numDevices = deviceIds.size();
-    int numTimes = timePoints.size();
-    int numResiduals = numDevices * numTimes + 3;  // 始终添加3个速度约束残差
-    
-    std::vector<double> residuals(numResiduals);
-    
-    // 提取参数：位置和速度
-    COORD3 estimatedPos = {params[0], params[1], params[2]};
-    Vector3 estimatedVel = {params[3], params[4], params[5]};
-    
-    // 获取辐射源信息
-    RadiationSource source = RadiationSourceDAO::getInstance().getRadiationSourceById(m_source.getRadiationId());
-    double sourceFrequency = source.getCarrierFrequency() * 1e9;
+    const std::vector<double>& timePoints,
+    COORD3 initialPosition,
+    Vector3 initialVelocity,
+    const FDOAMultiStartOptions& multiStart,
+    int maxIterations,
+    double tolerance) {
     
-    // 计算实际的速度分量
-    COORD3 expectedVel = calculateSourceVelocity(source);
+    SourcePositionResult result;
+    result.position = initialPosition;
+    result.velocity = initialVelocity;
+    result.converged = false;
+    result.iterations = 0;
+    result.finalError = std::numeric_limits<double>::max();
+    result.locationTime = 0.0;
     
-    // 遍历每个侦察设备和观测时刻
-    for (int i = 0; i < numDevices; ++i) {
-        // 获取侦察设备信息
-        ReconnaissanceDevice device = ReconnaissanceDeviceDAO::getInstance().getReconnaissanceDeviceById(deviceIds[i]);
-        COORD3 deviceVel0 = calculateDeviceVelocity(device);
-        
-        for (int j = 0; j < numTimes; ++j) {
-            double time = timePoints[j];
-            
-            // 计算设备在t时刻的位置
-            COORD3 devicePos = calculateDevicePositionAtTime(device, time);
-            
-            // 计算辐射源在t时刻的估计位置
-            COORD3 sourcePos = {
-                estimatedPos.p1 + estimatedVel.x * time,
-                estimatedPos.p2 + estimatedVel.y * time,
-                estimatedPos.p3 + estimatedVel.z * time
-            };
-            
-            // 计算相对位置矢量
-            Vector3 r(devicePos.p1 - sourcePos.p1, 
-                     devicePos.p2 - sourcePos.p2, 
-                     devicePos.p3 - sourcePos.p3);
-            double distance = r.magnitude();
-            
-            // 计算相对速度在视线方向上的分量
-            Vector3 relativeVelocity(deviceVel0.p1 - estimatedVel.x,
-                                   deviceVel0.p2 - estimatedVel.y,
-                                   deviceVel0.p3 - estimatedVel.z);
-            double radialVelocity = relativeVelocity.dot(r.normalize());
-            
-            // 计算理论多普勒频移
-            double theoreticalFDOA = (radialVelocity / Constants::c) * sourceFrequency;
-            
-            // 计算残差：观测值 - 理论值
-            residuals[i * numTimes + j] = observedFDOA[i][j] - theoreticalFDOA;
-        }
+    std::vector<FDOAObservation> observations;
+    FDOASolverOptions options;
+    if (!prepareObservations(deviceIds, observedFDOA, timePoints, observations, options)) {
+        return result;
     }
+    options.maxIterations = maxIterations;
+    options.tolerance = tolerance;
+    
+    FDOAState prior;
+    prior << initialPosition.p1, initialPosition.p2, initialPosition.p3,
+             initialVelocity.x, initialVelocity.y, initialVelocity.z;
+    FDOAMultiStartResult multi = fdoaSolveMultiStart(observations, prior, options, multiStart);
+    
+    result.position = COORD3{multi.best.state[0], multi.best.state[1], multi.best.state[2]};
+    result.velocity = Vector3{multi.best.state[3], multi.best.state[4], multi.best.state[5]};
+    result.converged = multi.best.converged;
+    result.iterations = multi.best.iterations;
+    result.finalError = multi.best.finalError;
+    result.startCount = multi.startCount;
+    result.convergedStarts = multi.convergedCount;
     
-    // 添加速度约束
-    double velocityWeight = (source.getMovementSpeed() < 1e-6) ? 1e6 : 1e3;
-    
-    int baseIndex = numDevices * numTimes;
-    residuals[baseIndex] = velocityWeight * (estimatedVel.x - expectedVel.p1);
-    residuals[baseIndex + 1] = velocityWeight * (estimatedVel.y - expectedVel.p2);
-    residuals[baseIndex + 2] = velocityWeight * (estimatedVel.z - expectedVel.p3);
-    
-    return residuals;
+    return result;
 }
-// 计算雅可比矩阵
-std::vector<std::vector<double>> FDOAalgorithm::calculateJacobian(
-    const std::vector<double>& params,
+
+// 预先计算观测几何，迭代过程不再访问数据库
+bool FDOAalgorithm::prepareObservations(
     const std::vector<int>& deviceIds,
+    const std::vector<std::vector<double>>& observedFDOA,
     const std::vector<double>& timePoints,
-    const std::vector<std::vector<double>>& observedFDOA) {
-    
-    int numDevices = deviceIds.size();
-    int numTimes = timePoints.size();
-    int numResiduals = numDevices * numTimes + 3;  // 始终包含3个速度约束残差
-    int numParams = params.size();  // 6个参数：x, y, z, vx, vy, vz
-    
-    std::vector<std::vector<double>> jacobian(numResiduals, std::vector<double>(numParams));
-    double h = 1e-7;  // 用于数值微分的小量
-    
-    // 计算基准残差
-    std::vector<double> baseResiduals = calculateResiduals(params, deviceIds, 
-        observedFDOA, timePoints);
-    
-    // 对每个参数计算偏导数
-    for (int p = 0; p < numParams; ++p) {
-        // 创建扰动参数
-        std::vector<double> perturbedParams = params;
-        perturbedParams[p] += h;
-        
-        // 计算扰动后的残差
-        std::vector<double> perturbedResiduals = calculateResiduals(perturbedParams, deviceIds, 
-            observedFDOA, timePoints);
-        
-        // 计算数值微分：∂r/∂p ≈ (r(p+h) - r(p))/h
-        for (int i = 0; i < numResiduals; ++i) {
-            jacobian[i][p] = (perturbedResiduals[i] - baseResiduals[i]) / h;
-        }
-    }
-    
-    // 获取辐射源信息
-    RadiationSource source = RadiationSourceDAO::getInstance().getRadiationSourceById(m_source.getRadiationId());
-    
-    // 设置速度约束的雅可比矩阵元素
-    double velocityWeight;
-    if (source.getMovementSpeed() < 1e-6) {  // 固定辐射源
-        velocityWeight = 1e6;  // 较大的权重
-    } else {  // 移动辐射源
-        velocityWeight = 1e3;  // 较小的权重
-    }
-    
-    int baseIndex = numDevices * numTimes;
-    
-    // 对位置的偏导数为0
-    for (int i = 0; i < 3; i++) {
-        jacobian[baseIndex + i][0] = 0;
-        jacobian[baseIndex + i][1] = 0;
-        jacobian[baseIndex + i][2] = 0;
-    }
+    std::vector<FDOAObservation>& observations,
+    FDOASolverOptions& options) {
     
-    // 对速度的偏导数
-    jacobian[baseIndex][3] = velocityWeight;     // ∂(w*(vx-vx_expected))/∂vx = w
-    jacobian[baseIndex][4] = 0;
-    jacobian[baseIndex][5] = 0;
-    
-    jacobian[baseIndex + 1][3] = 0;
-    jacobian[baseIndex + 1][4] = velocityWeight; // ∂(w*(vy-vy_expected))/∂vy = w
-    jacobian[baseIndex + 1][5] = 0;
-    
-    jacobian[baseIndex + 2][3] = 0;
-    jacobian[baseIndex + 2][4] = 0;
-    jacobian[baseIndex + 2][5] = velocityWeight; // ∂(w*(vz-vz_expected))/∂vz = w
-    
-    return jacobian;
-}
-// 使用高斯消元法求解线性方程组
-std::vector<double> FDOAalgorithm::solveLinearEquations(
-    const std::vector<std::vector<double>>& A,
-    const std::vector<double>& b) {
-    
-    int n = A.size();
-    std::vector<std::vector<double>> augmented(n, std::vector<double>(n + 1, 0.0));
-    std::vector<double> x(n, 0.0);
-    
-    // 构造增广矩阵
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            augmented[i][j] = A[i][j];
-        }
-        augmented[i][n] = b[i];
-    }
+    // 获取辐射源信息（载频和速度先验）
+    RadiationSource source = ModelRepository::getInstance().getRadiationSourceById(m_source.getRadiationId());
+    COORD3 expectedVel = calculateSourceVelocity(source);
     
-    // 高斯消元
-    for (int i = 0; i < n; ++i) {
-        // 选主元
-        int maxRow = i;
-        for (int j = i + 1; j < n; ++j) {
-            if (std::abs(augmented[j][i]) > std::abs(augmented[maxRow][i])) {
-                maxRow = j;
-            }
-        }
-        if (maxRow != i) {
-            std::swap(augmented[i], augmented[maxRow]);
-        }
-        
-        // 消元
-        for (int j = i + 1; j < n; ++j) {
-            double factor = augmented[j][i] / augmented[i][i];
-            for (int k = i; k <= n; ++k) {
-                augmented[j][k] -= factor * augmented[i][k];
-            }
+    options.carrierFrequency = source.getCarrierFrequency() * 1e9;
+    options.expectedVelocity = Eigen::Vector3d(expectedVel.p1, expectedVel.p2, expectedVel.p3);
+    // 速度约束：固定辐射源权重较大
+    options.velocityWeight = (source.getMovementSpeed() < 1e-6) ? 1e6 : 1e3;
+    
+    // 各设备在各观测时刻的位置和速度
+    observations.clear();
+    observations.reserve(deviceIds.size() * timePoints.size());
+    for (size_t i = 0; i < deviceIds.size() && i < observedFDOA.size(); ++i) {
+        ReconnaissanceDevice device = ModelRepository::getInstance().getReconnaissanceDeviceById(deviceIds[i]);
+        COORD3 deviceVel = calculateDeviceVelocity(device);
+        for (size_t j = 0; j < timePoints.size() && j < observedFDOA[i].size(); ++j) {
+            COORD3 devicePos = calculateDevicePositionAtTime(device, timePoints[j]);
+            FDOAObservation obs;
+            obs.stationPosition = Eigen::Vector3d(devicePos.p1, devicePos.p2, devicePos.p3);
+            obs.stationVelocity = Eigen::Vector3d(deviceVel.p1, deviceVel.p2, deviceVel.p3);
+            obs.time = timePoints[j];
+            obs.dopplerShift = observedFDOA[i][j];
+            observations.push_back(obs);
         }
     }
-    
-    // 回代
-    for (int i = n - 1; i >= 0; --i) {
-        double sum = augmented[i][n];
-        for (int j = i + 1; j < n; ++j) {
-            sum -= augmented[i][j] * x[j];
-        }
-        x[i] = sum / augmented[i][i];
+    if (observations.empty()) {
+        std::cerr << "频差定位失败：没有有效的观测数据" << std::endl;
+        return false;
     }
-    return x;
+    return true;
 }
 
 // 计算定位精度
@@ -785,19 +661,28 @@ double FDOAalgorithm::calculateLocalizationAccuracy(
     double simulationTime,
     const COORD3& estimatedPosition,
     const Vector3& estimatedVelocity) {
+    return calculateLocalizationAccuracy(deviceIds, sourceId, observationEpochs(simulationTime, m_observationCount),
+                                         estimatedPosition, estimatedVelocity);
+}
+
+double FDOAalgorithm::calculateLocalizationAccuracy(
+    const std::vector<int>& deviceIds,
+    int sourceId,
+    const std::vector<double>& timePoints,
+    const COORD3& estimatedPosition,
+    const Vector3& estimatedVelocity) {
     
     // 1. 获取必要信息
-    RadiationSource source = RadiationSourceDAO::getInstance().getRadiationSourceById(sourceId);
+    RadiationSource source = ModelRepository::getInstance().getRadiationSourceById(sourceId);
     std::vector<ReconnaissanceDevice> devices;
     for (int id : deviceIds) {
-        devices.push_back(ReconnaissanceDeviceDAO::getInstance().getReconnaissanceDeviceById(id));
+        devices.push_back(ModelRepository::getInstance().getReconnaissanceDeviceById(id));
     }
     
     // 2. 初始化Fisher信息矩阵(FIM)
     std::vector<std::vector<double>> FIM(6, std::vector<double>(6, 0.0));
     
-    // 3. 计算观测时刻和参数
-    std::vector<double> timePoints = {0.0, simulationTime / 2.0, simulationTime};
+    // 3. 计算参数
     double f0 = source.getCarrierFrequency() * 1e9;
     double sigma_fdoa = DOPPLER_ERROR_STD_DEV;
     double invQ = 1.0 / (sigma_fdoa * sigma_fdoa);
@@ -812,11 +697,18 @@ double FDOAalgorithm::calculateLocalizationAccuracy(
                 COORD3 pos_j = calculateDevicePositionAtTime(devices[j], t);
                 COORD3 vel_j = calculateDeviceVelocity(devices[j]);
                 
-                // 计算频差对状态参数的偏导数
+                // 辐射源匀速运动到观测时刻，状态参数为 t=0 的位置和速度：
+                // 对速度的偏导 = 直接偏导 + t·对位置的偏导
+                const COORD3 sourcePos(estimatedPosition.p1 + estimatedVelocity.x * t,
+                                       estimatedPosition.p2 + estimatedVelocity.y * t,
+                                       estimatedPosition.p3 + estimatedVelocity.z * t);
                 std::vector<double> H = calculateFDOADerivative(
-                    estimatedPosition, estimatedVelocity,
+                    sourcePos, estimatedVelocity,
                     pos_i, vel_i, pos_j, vel_j,
                     f0);
+                for (int m = 0; m < 3; ++m) {
+                    H[m + 3] += t * H[m];
+                }
                 
                 // 更新FIM矩阵
                 for (int m = 0; m < 6; ++m) {
@@ -939,10 +831,27 @@ std::vector<double> FDOAalgorithm::calculateFDOADerivative(
 
 // 辅助函数：矩阵求逆(6x6)
 std::vector<std::vector<double>> FDOAalgorithm::matrixInverse(const std::vector<std::vector<double>>& A) {
-    // 这里简化为单位矩阵，实际应实现矩阵求逆
-    std::vector<std::vector<double>> invA(6, std::vector<double>(6, 0.0));
-    for (int i = 0; i < 6; ++i) {
-        invA[i][i] = 1.0;
+    const int n = static_cast<int>(A.size());
+    Eigen::MatrixXd matrix(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            matrix(i, j) = A[i][j];
+        }
+    }
+    // 观测时刻或站数不足时信息矩阵奇异，精度无界
+    std::vector<std::vector<double>> invA(n, std::vector<double>(n, 0.0));
+    Eigen::FullPivLU<Eigen::MatrixXd> lu(matrix);
+    if (!lu.isInvertible()) {
+        for (int i = 0; i < n; ++i) {
+            invA[i][i] = std::numeric_limits<double>::infinity();
+        }
+        return invA;
+    }
+    const Eigen::MatrixXd inverse = lu.inverse();
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            invA[i][j] = inverse(i, j);
+        }
     }
     return invA;
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include "../InMemoryModelRepository.h"
+#include <algorithm>
+#include <mutex>
+
+int InMemoryModelRepository::addReconnaissanceDevice(const ReconnaissanceDevice& device) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    ReconnaissanceDevice stored = device;
+    if (stored.getDeviceId() <= 0) {
+        stored.setDeviceId(m_nextDeviceId);
+    }
+    m_nextDeviceId = std::max(m_nextDeviceId, stored.getDeviceId() + 1);
+    m_devices.push_back(stored);
+    return stored.getDeviceId();
+}
+
+int InMemoryModelRepository::addRadiationSource(const RadiationSource& source) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    RadiationSource stored = source;
+    if (stored.getRadiationId() <= 0) {
+        stored.setRadiationId(m_nextSourceId);
+    }
+    m_nextSourceId = std::max(m_nextSourceId, stored.getRadiationId() + 1);
+    m_sources.push_back(stored);
+    return stored.getRadiationId();
+}
+
+std::vector<SinglePlatformTask> InMemoryModelRepository::getSinglePlatformTasks() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_tasks;
+}
+
+void InMemoryModelRepository::clear() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_devices.clear();
+    m_sources.clear();
+    m_tasks.clear();
+    m_nextDeviceId = 1;
+    m_nextSourceId = 1;
+    m_nextTaskId = 1;
+}
+
+std::vector<ReconnaissanceDevice> InMemoryModelRepository::getAllReconnaissanceDevices() {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_devices;
+}
+
+bool InMemoryModelRepository::findReconnaissanceDeviceById(int deviceId, ReconnaissanceDevice& device) {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (const ReconnaissanceDevice& d : m_devices) {
+        if (d.getDeviceId() == deviceId) {
+            device = d;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InMemoryModelRepository::findReconnaissanceDeviceByName(const std::string& name, ReconnaissanceDevice& device) {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (const ReconnaissanceDevice& d : m_devices) {
+        if (d.getDeviceName() == name) {
+            device = d;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<RadiationSource> InMemoryModelRepository::getAllRadiationSources() {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_sources;
+}
+
+bool InMemoryModelRepository::findRadiationSourceById(int sourceId, RadiationSource& source) {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (const RadiationSource& s : m_sources) {
+        if (s.getRadiationId() == sourceId) {
+            source = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InMemoryModelRepository::findRadiationSourceByName(const std::string& name, RadiationSource& source) {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (const RadiationSource& s : m_sources) {
+        if (s.getRadiationName() == name) {
+            source = s;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InMemoryModelRepository::addSinglePlatformTask(const SinglePlatformTask& task, int& taskId) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    SinglePlatformTask stored = task;
+    stored.taskId = m_nextTaskId++;
+    m_tasks.push_back(stored);
+    taskId = stored.taskId;
+    return true;
+}
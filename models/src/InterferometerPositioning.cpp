@@ -2,10 +2,11 @@
 #include "../../constants/PhysicsConstants.h"
 #include "../../utils/CoordinateTransform.h"
 #include "../../utils/SNRValidator.h"
-#include "../SinglePlatformTaskDAO.h"
+#include "../../utils/Instrumentation.h"
+#include "../../utils/Log.h"
+#include "../ModelRepository.h"
 #include <cmath>
 #include <iostream>
-#include <gtk/gtk.h>
 
 // 使用常量命名空间
 using namespace Constants;
@@ -20,6 +21,7 @@ InterferometerPositioning& InterferometerPositioning::getInstance() {
 LocationResult InterferometerPositioning::runSimulation(const ReconnaissanceDevice& device, 
                                                       const RadiationSource& source,
                                                       int simulationTime) {
+    PL_TRACE_SCOPE("Interferometer.runSimulation");
     LocationResult result;
     
     // 使用相位差变化率定位法
@@ -29,22 +31,22 @@ LocationResult InterferometerPositioning::runSimulation(const ReconnaissanceDevi
     double X_0 = deviceXYZ.p1;
     double Y_0 = deviceXYZ.p2;
     double Z_0 = deviceXYZ.p3;
-    g_print("观测站初始位置: %.6f°, %.6f°, %.2fm\n", device.getLongitude(), device.getLatitude(), device.getAltitude());
-    g_print("观测站初始位置: %.6f, %.6f, %.2f\n", X_0, Y_0, Z_0);
+    PL_LOG_DEBUG("观测站初始位置: %.6f°, %.6f°, %.2fm\n", device.getLongitude(), device.getLatitude(), device.getAltitude());
+    PL_LOG_DEBUG("观测站初始位置: %.6f, %.6f, %.2f\n", X_0, Y_0, Z_0);
     
     //获取辐射源位置（固定）
     COORD3 sourceXYZ = lbh2xyz(source.getLongitude(), source.getLatitude(), source.getAltitude());
     double X_T = sourceXYZ.p1;
     double Y_T = sourceXYZ.p2;
     double Z_T = sourceXYZ.p3;
-    g_print("辐射源位置: %.6f°, %.6f°, %.2fm\n", source.getLongitude(), source.getLatitude(), source.getAltitude());
-    g_print("辐射源位置: %.6f, %.6f, %.2f\n", X_T, Y_T, Z_T);
+    PL_LOG_DEBUG("辐射源位置: %.6f°, %.6f°, %.2fm\n", source.getLongitude(), source.getLatitude(), source.getAltitude());
+    PL_LOG_DEBUG("辐射源位置: %.6f, %.6f, %.2f\n", X_T, Y_T, Z_T);
 
     // //假设
     //     double X_T = 1000;
     // double Y_T = 500;
     // double Z_T = 300;
-    //     g_print("假设辐射源位置: %.6f, %.6f, %.2f\n", X_T, Y_T, Z_T);
+    //     Log::print("假设辐射源位置: %.6f, %.6f, %.2f\n", X_T, Y_T, Z_T);
     
     // 获取观测站速度
     // 将设备的运动速度和方向转换为笛卡尔坐标系中的速度分量
@@ -58,61 +60,61 @@ LocationResult InterferometerPositioning::runSimulation(const ReconnaissanceDevi
     double v_x = velocityXYZ.p1;
     double v_y = velocityXYZ.p2;
     double v_z = velocityXYZ.p3;
-    g_print("观测站速度: %.2fm/s, %.2fm/s, %.2fm/s\n", v_x, v_y, v_z);
+    PL_LOG_DEBUG("观测站速度: %.2fm/s, %.2fm/s, %.2fm/s\n", v_x, v_y, v_z);
 
     // //假设
     //  double v_x = 50;
     // double v_y = 0;
     // double v_z = 0;
-    // g_print("假设观测站速度: %.2fm/s, %.2fm/s, %.2fm/s\n", v_x, v_y, v_z);
+    // Log::print("假设观测站速度: %.2fm/s, %.2fm/s, %.2fm/s\n", v_x, v_y, v_z);
 
     // 获取基线长度
     double d = device.getBaselineLength();
-    g_print("基线长度: %.2fm\n", d);
+    PL_LOG_DEBUG("基线长度: %.2fm\n", d);
     
     // 获取辐射源频率（GHz转换为Hz）
     double f_T = source.getCarrierFrequency() * 1e9;
-    g_print("辐射源频率: %.2fHz\n", f_T);
+    PL_LOG_DEBUG("辐射源频率: %.2fHz\n", f_T);
     
     // 计算观测站运动后的位置
     // 假设仿真时间内匀速运动
     double X_0_moved = X_0 + v_x * simulationTime;
     double Y_0_moved = Y_0 + v_y * simulationTime;
     double Z_0_moved = Z_0 + v_z * simulationTime;
-    g_print("观测站运动后位置: %.6f, %.6f, %.2f\n", X_0_moved, Y_0_moved, Z_0_moved);
+    PL_LOG_DEBUG("观测站运动后位置: %.6f, %.6f, %.2f\n", X_0_moved, Y_0_moved, Z_0_moved);
 
 // //假设
 //         double X_0_moved = 50;
 //     double Y_0_moved =0;
 //     double Z_0_moved =0;
-//         g_print("假设观测站运动后位置: %.6f, %.6f, %.2f\n", X_0_moved, Y_0_moved, Z_0_moved);
+//         Log::print("假设观测站运动后位置: %.6f, %.6f, %.2f\n", X_0_moved, Y_0_moved, Z_0_moved);
     
     // 计算方位角 θ(t) = tg^(-1)((X_T - X_0_moved)/(Y_T - Y_0_moved)) (公式4.2.3修改版)
     double theta_t = atan2(X_T - X_0_moved, Y_T - Y_0_moved);
-    g_print("方位角(运动后): %.1f°\n", theta_t * RAD2DEG);
+    PL_LOG_DEBUG("方位角(运动后): %.1f°\n", theta_t * RAD2DEG);
     
     // 计算俯仰角 ε(t) = tg^(-1)((Z_T - Z_0_moved)/sqrt((X_T - X_0_moved)^2 + (Y_T - Y_0_moved)^2)) (公式4.2.4修改版)
     double r_pt = sqrt(pow(X_T - X_0_moved, 2) + pow(Y_T - Y_0_moved, 2));
     double epsilon_t = atan2(Z_T - Z_0_moved, r_pt);
-    g_print("俯仰角(运动后): %.1f°\n", epsilon_t * RAD2DEG);
+    PL_LOG_DEBUG("俯仰角(运动后): %.1f°\n", epsilon_t * RAD2DEG);
     
     // 计算方位角变化率 θ'(t) = (v_y*sin(θ(t)) - v_x*cos(θ(t)))/r_pt (公式4.2.5)
     double theta_dot_t = (v_y * sin(theta_t) - v_x * cos(theta_t)) / r_pt;
-    g_print("方位角变化率: %.2f°/s\n", theta_dot_t * RAD2DEG);
+    PL_LOG_DEBUG("方位角变化率: %.2f°/s\n", theta_dot_t * RAD2DEG);
     
     // 计算俯仰角变化率 ε'(t) = (-v_z*cos(ε(t)) + r_pt_dot*sin(ε(t)))/r (公式4.2.6)
     // 其中 r_pt_dot = (X_T - X_0_moved)*sin(θ(t)) + (Y_T - Y_0_moved)*cos(θ(t))
     double r_pt_dot = (X_T - X_0_moved) * sin(theta_t) + (Y_T - Y_0_moved) * cos(theta_t);
     double r_t = sqrt(pow(X_T - X_0_moved, 2) + pow(Y_T - Y_0_moved, 2) + pow(Z_T - Z_0_moved, 2));
     double epsilon_dot_t = (-v_z * cos(epsilon_t) + r_pt_dot * sin(epsilon_t)) / r_t;
-    g_print("俯仰角变化率: %.2f°/s\n", epsilon_dot_t * RAD2DEG);
+    PL_LOG_DEBUG("俯仰角变化率: %.2f°/s\n", epsilon_dot_t * RAD2DEG);
     
     // 计算相位差变化率 (公式4.2.7)
     double delta_phi_dot_t = (2 * M_PI * d * f_T / c) * (
         (v_y * sin(theta_t) - v_x * cos(theta_t)) * cos(theta_t) * cos(epsilon_t) / (r_t * cos(epsilon_t)) -
         (r_pt_dot * sin(epsilon_t) - v_z * cos(epsilon_t)) * sin(theta_t) * sin(epsilon_t) / r_t
     );
-    g_print("相位差变化率: %.2f°/s\n", delta_phi_dot_t * RAD2DEG);
+    PL_LOG_DEBUG("相位差变化率: %.2f°/s\n", delta_phi_dot_t * RAD2DEG);
     
     // 计算距离 (公式4.2.8)
     // 根据公式4.2.8，r_hat = (Δφ'(t)/fT * c/(2πd))^(-1) * { [y'O sin(θ) - x'O cos(θ)]cos(θ)cos(ε) - [r'pt sin(ε) - z'O cos(ε)]sin(θ)sin(ε) }
@@ -120,17 +122,17 @@ LocationResult InterferometerPositioning::runSimulation(const ReconnaissanceDevi
                        (r_pt_dot * sin(epsilon_t) - v_z * cos(epsilon_t)) * sin(theta_t) * sin(epsilon_t);
     double denominator = delta_phi_dot_t * c / (2 * M_PI * d * f_T);
     double r_hat = numerator / denominator;
-    g_print("距离: %.2fm\n", r_hat);
+    PL_LOG_DEBUG("距离: %.2fm\n", r_hat);
     
     // 计算辐射源坐标 (公式4.2.9，基于运动后的位置)
     double X_T_calculated = X_0_moved + r_hat * cos(epsilon_t) * sin(theta_t);
     double Y_T_calculated = Y_0_moved + r_hat * cos(epsilon_t) * cos(theta_t);
     double Z_T_calculated = Z_0_moved + r_hat * sin(epsilon_t);
-    g_print("计算得到的辐射源坐标: %.6f, %.6f, %.2f\n", X_T_calculated, Y_T_calculated, Z_T_calculated);
+    PL_LOG_DEBUG("计算得到的辐射源坐标: %.6f, %.6f, %.2f\n", X_T_calculated, Y_T_calculated, Z_T_calculated);
     
     // 将计算得到的辐射源笛卡尔坐标转换回经纬度高度
     COORD3 sourceLBH = xyz2lbh(X_T_calculated, Y_T_calculated, Z_T_calculated);
-    g_print("计算得到的辐射源经纬度高度: %.6f°, %.6f°, %.2fm\n", sourceLBH.p1, sourceLBH.p2, sourceLBH.p3);
+    PL_LOG_DEBUG("计算得到的辐射源经纬度高度: %.6f°, %.6f°, %.2fm\n", sourceLBH.p1, sourceLBH.p2, sourceLBH.p3);
     
     // 设置结果
     result.longitude = sourceLBH.p1;
@@ -200,18 +202,18 @@ LocationResult InterferometerPositioning::runSimulation(const ReconnaissanceDevi
     task.directionFindingAccuracy = directionFindingAccuracy;
     
     int taskId;
-    if (SinglePlatformTaskDAO::getInstance().addSinglePlatformTask(task, taskId)) {
-        g_print("单平台干涉仪定位结果已保存到数据库，任务ID: %d\n", taskId);
-        g_print("最大定位距离: %.2fm\n", maxDetectionRange);
-        g_print("定位精度: %.6f%%\n", positioningAccuracy);
-        g_print("测向精度: %.6f°\n", directionFindingAccuracy);
+    if (ModelRepository::getInstance().addSinglePlatformTask(task, taskId)) {
+        PL_LOG_INFO("单平台干涉仪定位结果已保存到数据库，任务ID: %d\n", taskId);
+        PL_LOG_DEBUG("最大定位距离: %.2fm\n", maxDetectionRange);
+        PL_LOG_DEBUG("定位精度: %.6f%%\n", positioningAccuracy);
+        PL_LOG_DEBUG("测向精度: %.6f°\n", directionFindingAccuracy);
     } else {
-        g_print("警告：保存单平台干涉仪定位结果到数据库失败\n");
+        PL_LOG_WARN("警告：保存单平台干涉仪定位结果到数据库失败\n");
     }
     
-    g_print("干涉仪体制定位结果：\n");
-    g_print("  方位角: %.2f°, 俯仰角: %.2f°\n", result.azimuth, result.elevation);
-    g_print("  经度: %.6f°, 纬度: %.6f°, 高度: %.2fm\n", result.longitude, result.latitude, result.altitude);
+    PL_LOG_INFO("干涉仪体制定位结果：\n");
+    PL_LOG_INFO("  方位角: %.2f°, 俯仰角: %.2f°\n", result.azimuth, result.elevation);
+    PL_LOG_INFO("  经度: %.6f°, 纬度: %.6f°, 高度: %.2fm\n", result.longitude, result.latitude, result.altitude);
     
     return result;
 }
@@ -249,8 +251,8 @@ std::pair<double, double> InterferometerPositioning::calculateDirectionData(cons
         device.getLatitude(),
         v_x, v_y, v_z
     );
-    g_print("测向计算中 - 从笛卡尔坐标转换回大地坐标系的运动参数:\n");
-    g_print("  - 速度: %.2fm/s, 方位角: %.2f°, 俯仰角: %.2f°\n", 
+    PL_LOG_DEBUG("测向计算中 - 从笛卡尔坐标转换回大地坐标系的运动参数:\n");
+    PL_LOG_DEBUG("  - 速度: %.2fm/s, 方位角: %.2f°, 俯仰角: %.2f°\n", 
            velocityLBH.p1, velocityLBH.p2, velocityLBH.p3);
     
     // 计算观测站运动后的位置（假设运动1秒）
@@ -300,8 +302,8 @@ std::pair<std::pair<double, double>, double> InterferometerPositioning::calculat
         latitude,
         v_x, v_y, v_z
     );
-    g_print("定位计算中 - 从笛卡尔坐标转换回大地坐标系的运动参数:\n");
-    g_print("  - 速度: %.2fm/s, 方位角: %.2f°, 俯仰角: %.2f°\n", 
+    PL_LOG_DEBUG("定位计算中 - 从笛卡尔坐标转换回大地坐标系的运动参数:\n");
+    PL_LOG_DEBUG("  - 速度: %.2fm/s, 方位角: %.2f°, 俯仰角: %.2f°\n", 
            velocityLBH.p1, velocityLBH.p2, velocityLBH.p3);
     
     // 估计距离
@@ -441,13 +443,13 @@ std::vector<double> InterferometerPositioning::calculateErrors(const Reconnaissa
 
     
     // 添加详细的中间计算值输出
-    g_print("天线阵测向误差计算中间值:\n");
-    g_print("  cos(theta): %.10f\n", cos_theta);
-    g_print("  lambda: %.10f m\n", lambda);
-    g_print("  基线长度(d): %.4f m\n", d);
-    g_print("  sigma_phi_rad: %.10f rad\n", sigma_phi_rad);
-    g_print("  分母(2*PI*d*cos_theta): %.10f\n", 2 * M_PI * d * cos_theta);
-    g_print("  sigma_theta_rad: %.10f rad\n", sigma_theta);
+    PL_LOG_DEBUG("天线阵测向误差计算中间值:\n");
+    PL_LOG_DEBUG("  cos(theta): %.10f\n", cos_theta);
+    PL_LOG_DEBUG("  lambda: %.10f m\n", lambda);
+    PL_LOG_DEBUG("  基线长度(d): %.4f m\n", d);
+    PL_LOG_DEBUG("  sigma_phi_rad: %.10f rad\n", sigma_phi_rad);
+    PL_LOG_DEBUG("  分母(2*PI*d*cos_theta): %.10f\n", 2 * M_PI * d * cos_theta);
+    PL_LOG_DEBUG("  sigma_theta_rad: %.10f rad\n", sigma_theta);
 
     // 5. 综合测向误差 Δθ（度）
     double total_error = sqrt(pow(sigma_alpha, 2) + pow(sigma_beta, 2) + 
@@ -457,17 +459,17 @@ std::vector<double> InterferometerPositioning::calculateErrors(const Reconnaissa
     errors.push_back(total_error);
     
     // 打印调试信息
-    g_print("误差计算结果：\n");
-    g_print("  对中误差: %.4f°\n", delta_em);
-    g_print("  惯导测量精度: %.4f°\n", sigma_alpha);
-    g_print("  圆锥效应误差: %.4f°\n", sigma_beta);
-    g_print("  天线阵测向误差: %.4f°\n", sigma_theta);
-    g_print("  综合测向误差: %.4f°\n", total_error);
-    g_print("计算参数：\n");
-    g_print("  基线长度: %.4f m\n", d);
-    g_print("  波长: %.4f m\n", lambda);
-    g_print("  方位角: %.4f°\n", theta);
-    g_print("  俯仰角: %.4f°\n", elevation);
+    PL_LOG_DEBUG("误差计算结果：\n");
+    PL_LOG_DEBUG("  对中误差: %.4f°\n", delta_em);
+    PL_LOG_DEBUG("  惯导测量精度: %.4f°\n", sigma_alpha);
+    PL_LOG_DEBUG("  圆锥效应误差: %.4f°\n", sigma_beta);
+    PL_LOG_DEBUG("  天线阵测向误差: %.4f°\n", sigma_theta);
+    PL_LOG_DEBUG("  综合测向误差: %.4f°\n", total_error);
+    PL_LOG_DEBUG("计算参数：\n");
+    PL_LOG_DEBUG("  基线长度: %.4f m\n", d);
+    PL_LOG_DEBUG("  波长: %.4f m\n", lambda);
+    PL_LOG_DEBUG("  方位角: %.4f°\n", theta);
+    PL_LOG_DEBUG("  俯仰角: %.4f°\n", elevation);
     
     return errors;
 } 
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "../ModelRepository.h"
+#include "../InMemoryModelRepository.h"
+#include <mutex>
+
+namespace {
+
+std::mutex& repositoryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::shared_ptr<ModelRepository>& currentRepository() {
+    static std::shared_ptr<ModelRepository> repository = std::make_shared<InMemoryModelRepository>();
+    return repository;
+}
+
+} // namespace
+
+ModelRepository& ModelRepository::getInstance() {
+    std::lock_guard<std::mutex> lock(repositoryMutex());
+    return *currentRepository();
+}
+
+void ModelRepository::setInstance(std::shared_ptr<ModelRepository> repository) {
+    if (!repository) {
+        repository = std::make_shared<InMemoryModelRepository>();
+    }
+    std::lock_guard<std::mutex> lock(repositoryMutex());
+    currentRepository() = std::move(repository);
+}
+
+ReconnaissanceDevice ModelRepository::getReconnaissanceDeviceById(int deviceId) {
+    ReconnaissanceDevice device;
+    if (!findReconnaissanceDeviceById(deviceId, device)) {
+        return ReconnaissanceDevice();
+    }
+    return device;
+}
+
+RadiationSource ModelRepository::getRadiationSourceById(int sourceId) {
+    RadiationSource source;
+    if (!findRadiationSourceById(sourceId, source)) {
+        return RadiationSource();
+    }
+    return source;
+}
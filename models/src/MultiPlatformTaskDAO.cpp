@@ -1,7 +1,14 @@
 #include "../MultiPlatformTaskDAO.h"
 #include <iostream>
 #include <cstring>
-#include <gtk/gtk.h>
+
+// 所有查询共用的列顺序，与 createTaskFromRow 一致
+static const char* const TASK_COLUMNS =
+    "task_id, tech_system, radiation_id, execution_time, "
+    "target_longitude, target_latitude, target_altitude, "
+    "positioning_distance, positioning_time, positioning_accuracy, "
+    "movement_speed, movement_azimuth, movement_elevation, "
+    "azimuth, elevation, created_at";
 
 // 单例实现
 MultiPlatformTaskDAO& MultiPlatformTaskDAO::getInstance() {
@@ -11,315 +18,248 @@ MultiPlatformTaskDAO& MultiPlatformTaskDAO::getInstance() {
 
 // 添加多平台任务
 bool MultiPlatformTaskDAO::addMultiPlatformTask(const MultiPlatformTask& task, int& taskId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
     
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
+    PreparedStatement* stmt = conn.prepare(
         "INSERT INTO multi_platform_task (tech_system, radiation_id, execution_time, "
         "target_longitude, target_latitude, target_altitude, movement_speed, "
         "movement_azimuth, movement_elevation, azimuth, elevation, positioning_distance, "
-        "positioning_time, positioning_accuracy) VALUES ('%s', %d, %f, %.6f, %.6f, %.2f, %f, "
-        "%.2f, %.2f, %.2f, %.2f, %f, %f, %.6f)",
-        task.techSystem.c_str(),
-        task.radiationId,
-        task.executionTime,
-        task.targetLongitude,
-        task.targetLatitude,
-        task.targetAltitude,
-        task.movementSpeed,
-        task.movementAzimuth,
-        task.movementElevation,
-        task.azimuth,
-        task.elevation,
-        task.positioningDistance,
-        task.positioningTime,
-        task.positioningAccuracy
-    );
-    
-    if (!db.executeSQL(sql)) {
-        std::cerr << "Failed to add multi platform task: " << mysql_error(conn) << std::endl;
-        std::cerr << "SQL: " << sql << std::endl;
+        "positioning_time, positioning_accuracy) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    if (!stmt) return false;
+    
+    std::size_t idx = 0;
+    stmt->bindString(idx++, task.techSystem);
+    stmt->bindInt(idx++, task.radiationId);
+    stmt->bindDouble(idx++, task.executionTime);
+    stmt->bindDouble(idx++, task.targetLongitude);
+    stmt->bindDouble(idx++, task.targetLatitude);
+    stmt->bindDouble(idx++, task.targetAltitude);
+    stmt->bindDouble(idx++, task.movementSpeed);
+    stmt->bindDouble(idx++, task.movementAzimuth);
+    stmt->bindDouble(idx++, task.movementElevation);
+    stmt->bindDouble(idx++, task.azimuth);
+    stmt->bindDouble(idx++, task.elevation);
+    stmt->bindDouble(idx++, task.positioningDistance);
+    stmt->bindDouble(idx++, task.positioningTime);
+    stmt->bindDouble(idx++, task.positioningAccuracy);
+    
+    // 任务记录与设备关联在同一事务中写入，失败时整体回滚
+    if (!conn.beginTransaction()) return false;
+    
+    if (!stmt->execute()) {
+        std::cerr << "Failed to add multi platform task: " << stmt->error() << std::endl;
+        conn.rollbackTransaction();
         return false;
     }
     
     // 获取自增ID
-    taskId = (int)mysql_insert_id(conn);
+    int newTaskId = static_cast<int>(stmt->insertId());
     
     // 保存任务与设备的关联关系
-    if (!saveTaskDeviceRelations(taskId, task.deviceIds)) {
-        // 如果保存关联关系失败，删除刚插入的任务
-        deleteMultiPlatformTask(taskId);
+    if (!saveTaskDeviceRelations(conn, newTaskId, task.deviceIds)) {
+        conn.rollbackTransaction();
         return false;
     }
     
+    if (!conn.commitTransaction()) {
+        conn.rollbackTransaction();
+        return false;
+    }
+    
+    taskId = newTaskId;
     return true;
 }
 
-// 根据任务ID获取多平台任务
-MultiPlatformTask MultiPlatformTaskDAO::getMultiPlatformTaskById(int taskId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn) return MultiPlatformTask{};
-    
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
-        "SELECT task_id, tech_system, radiation_id, execution_time, "
-        "target_longitude, target_latitude, target_altitude, movement_speed, "
-        "movement_azimuth, movement_elevation, azimuth, elevation, positioning_distance, positioning_time, "
-        "positioning_accuracy, created_at FROM multi_platform_task WHERE task_id = %d",
-        taskId
-    );
+// 按条件查询任务列表(含关联设备)
+std::vector<MultiPlatformTask> MultiPlatformTaskDAO::queryTasks(PooledConnection& conn, const std::string& whereClause, int param) {
+    std::vector<MultiPlatformTask> tasks;
     
-    if (mysql_query(conn, sql)) {
-        std::cerr << "Failed to execute query: " << mysql_error(conn) << std::endl;
-        return MultiPlatformTask{};
+    std::string sql = std::string("SELECT ") + TASK_COLUMNS + " FROM multi_platform_task";
+    if (!whereClause.empty()) {
+        sql += " WHERE " + whereClause;
     }
+    sql += " ORDER BY task_id DESC";
     
-    MYSQL_RES* result = mysql_store_result(conn);
-    if (!result) {
-        std::cerr << "Failed to store result: " << mysql_error(conn) << std::endl;
-        return MultiPlatformTask{};
+    PreparedStatement* stmt = conn.prepare(sql);
+    if (!stmt) return tasks;
+    if (stmt->parameterCount() > 0) {
+        stmt->bindInt(0, param);
     }
-    
-    MYSQL_ROW row = mysql_fetch_row(result);
-    if (!row) {
-        mysql_free_result(result);
-        return MultiPlatformTask{};
+    if (!stmt->execute()) {
+        std::cerr << "Failed to execute query: " << stmt->error() << std::endl;
+        return tasks;
     }
     
-    MultiPlatformTask task = createTaskFromRow(row);
-    mysql_free_result(result);
+    while (stmt->fetch()) {
+        tasks.push_back(createTaskFromRow(*stmt));
+    }
     
-    // 获取关联的设备ID列表
-    task.deviceIds = getDeviceIdsByTaskId(taskId);
+    // 读完任务列表后再查询关联设备，避免在同一连接上交错使用结果集
+    for (auto& task : tasks) {
+        task.deviceIds = getDeviceIdsByTaskId(conn, task.taskId);
+    }
+    return tasks;
+}
+
+// 根据任务ID获取多平台任务
+MultiPlatformTask MultiPlatformTaskDAO::getMultiPlatformTaskById(int taskId) {
+    PooledConnection conn = DBConnector::getInstance().acquire();
+    if (!conn) return MultiPlatformTask{};
     
-    return task;
+    std::vector<MultiPlatformTask> tasks = queryTasks(conn, "task_id = ?", taskId);
+    if (tasks.empty()) {
+        return MultiPlatformTask{};
+    }
+    return tasks.front();
 }
 
 // 获取所有多平台任务
 std::vector<MultiPlatformTask> MultiPlatformTaskDAO::getAllMultiPlatformTasks() {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return std::vector<MultiPlatformTask>{};
     
-    const char* sql = "SELECT task_id, tech_system, radiation_id, execution_time, "
-                     "target_longitude, target_latitude, target_altitude, movement_speed, "
-                     "movement_azimuth, movement_elevation, positioning_distance, positioning_time, "
-                     "positioning_accuracy, created_at FROM multi_platform_task ORDER BY task_id DESC";
-    
-    if (mysql_query(conn, sql)) {
-        std::cerr << "Failed to execute query: " << mysql_error(conn) << std::endl;
-        return std::vector<MultiPlatformTask>{};
-    }
-    
-    MYSQL_RES* result = mysql_store_result(conn);
-    if (!result) {
-        std::cerr << "Failed to store result: " << mysql_error(conn) << std::endl;
-        return std::vector<MultiPlatformTask>{};
-    }
-    
-    std::vector<MultiPlatformTask> tasks;
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(result))) {
-        MultiPlatformTask task = createTaskFromRow(row);
-        task.deviceIds = getDeviceIdsByTaskId(task.taskId);
-        tasks.push_back(task);
-    }
-    
-    mysql_free_result(result);
-    return tasks;
+    return queryTasks(conn, std::string(), 0);
 }
 
 // 根据辐射源ID获取多平台任务
 std::vector<MultiPlatformTask> MultiPlatformTaskDAO::getMultiPlatformTasksByRadiationId(int radiationId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return std::vector<MultiPlatformTask>{};
     
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
-        "SELECT task_id, tech_system, radiation_id, execution_time, "
-        "target_longitude, target_latitude, target_altitude, "
-        "positioning_distance, positioning_time, positioning_accuracy, "
-        "movement_speed, movement_azimuth, movement_elevation, "
-        "azimuth, elevation, created_at FROM multi_platform_task WHERE radiation_id = %d "
-        "ORDER BY task_id DESC",
-        radiationId
-    );
-    
-    if (mysql_query(conn, sql)) {
-        std::cerr << "Failed to execute query: " << mysql_error(conn) << std::endl;
-        return std::vector<MultiPlatformTask>{};
-    }
-    
-    MYSQL_RES* result = mysql_store_result(conn);
-    if (!result) {
-        std::cerr << "Failed to store result: " << mysql_error(conn) << std::endl;
-        return std::vector<MultiPlatformTask>{};
-    }
-    
-    std::vector<MultiPlatformTask> tasks;
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(result))) {
-        MultiPlatformTask task = createTaskFromRow(row);
-        task.deviceIds = getDeviceIdsByTaskId(task.taskId);
-        tasks.push_back(task);
-    }
-    
-    mysql_free_result(result);
-    return tasks;
+    return queryTasks(conn, "radiation_id = ?", radiationId);
 }
 
 // 更新多平台任务
 bool MultiPlatformTaskDAO::updateMultiPlatformTask(const MultiPlatformTask& task) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
     
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
-        "UPDATE multi_platform_task SET tech_system = '%s', radiation_id = %d, "
-        "execution_time = %f, target_longitude = %.6f, target_latitude = %.6f, "
-        "target_altitude = %.2f, movement_speed = %f, movement_azimuth = %.2f, "
-        "movement_elevation = %.2f, positioning_distance = %f, positioning_time = %f, "
-        "positioning_accuracy = %.6f WHERE task_id = %d",
-        task.techSystem.c_str(),
-        task.radiationId,
-        task.executionTime,
-        task.targetLongitude,
-        task.targetLatitude,
-        task.targetAltitude,
-        task.movementSpeed,
-        task.movementAzimuth,
-        task.movementElevation,
-        task.positioningDistance,
-        task.positioningTime,
-        task.positioningAccuracy,
-        task.taskId
-    );
-    
-    if (!db.executeSQL(sql)) {
-        std::cerr << "Failed to update multi platform task: " << mysql_error(conn) << std::endl;
-        std::cerr << "SQL: " << sql << std::endl;
+    PreparedStatement* stmt = conn.prepare(
+        "UPDATE multi_platform_task SET tech_system = ?, radiation_id = ?, "
+        "execution_time = ?, target_longitude = ?, target_latitude = ?, "
+        "target_altitude = ?, movement_speed = ?, movement_azimuth = ?, "
+        "movement_elevation = ?, positioning_distance = ?, positioning_time = ?, "
+        "positioning_accuracy = ? WHERE task_id = ?");
+    if (!stmt) return false;
+    
+    std::size_t idx = 0;
+    stmt->bindString(idx++, task.techSystem);
+    stmt->bindInt(idx++, task.radiationId);
+    stmt->bindDouble(idx++, task.executionTime);
+    stmt->bindDouble(idx++, task.targetLongitude);
+    stmt->bindDouble(idx++, task.targetLatitude);
+    stmt->bindDouble(idx++, task.targetAltitude);
+    stmt->bindDouble(idx++, task.movementSpeed);
+    stmt->bindDouble(idx++, task.movementAzimuth);
+    stmt->bindDouble(idx++, task.movementElevation);
+    stmt->bindDouble(idx++, task.positioningDistance);
+    stmt->bindDouble(idx++, task.positioningTime);
+    stmt->bindDouble(idx++, task.positioningAccuracy);
+    stmt->bindInt(idx++, task.taskId);
+    
+    if (!conn.beginTransaction()) return false;
+    
+    if (!stmt->execute()) {
+        std::cerr << "Failed to update multi platform task: " << stmt->error() << std::endl;
+        conn.rollbackTransaction();
         return false;
     }
     
     // 更新任务与设备的关联关系
-    if (!saveTaskDeviceRelations(task.taskId, task.deviceIds)) {
+    if (!saveTaskDeviceRelations(conn, task.taskId, task.deviceIds)) {
+        conn.rollbackTransaction();
         return false;
     }
     
-    return true;
+    return conn.commitTransaction();
 }
 
 // 删除多平台任务
 bool MultiPlatformTaskDAO::deleteMultiPlatformTask(int taskId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
     
-    char sql[1024];
-    snprintf(sql, sizeof(sql), "DELETE FROM multi_platform_task WHERE task_id = %d", taskId);
+    PreparedStatement* stmt = conn.prepare("DELETE FROM multi_platform_task WHERE task_id = ?");
+    if (!stmt) return false;
+    stmt->bindInt(0, taskId);
     
-    if (!db.executeSQL(sql)) {
-        std::cerr << "Failed to delete multi platform task: " << mysql_error(conn) << std::endl;
-        std::cerr << "SQL: " << sql << std::endl;
+    if (!stmt->execute()) {
+        std::cerr << "Failed to delete multi platform task: " << stmt->error() << std::endl;
         return false;
     }
     
     return true;
 }
 
-// 从数据库结果集创建任务对象
-MultiPlatformTask MultiPlatformTaskDAO::createTaskFromRow(MYSQL_ROW row) {
+// 从预编译语句的当前行创建任务对象
+MultiPlatformTask MultiPlatformTaskDAO::createTaskFromRow(const PreparedStatement& stmt) {
     MultiPlatformTask task;
-    int idx = 0;
-    task.taskId = row[idx] ? atoi(row[idx]) : 0; idx++;
-    task.techSystem = row[idx] ? row[idx] : ""; idx++;
-    task.radiationId = row[idx] ? atoi(row[idx]) : 0; idx++;
-    task.executionTime = row[idx] ? atof(row[idx]) : 0.0f; idx++;
-    task.targetLongitude = row[idx] ? atof(row[idx]) : 0.0; idx++;
-    task.targetLatitude = row[idx] ? atof(row[idx]) : 0.0; idx++;
-    task.targetAltitude = row[idx] ? atof(row[idx]) : 0.0; idx++;
-    task.positioningDistance = row[idx] ? atof(row[idx]) : 0.0f; idx++;
-    task.positioningTime = row[idx] ? atof(row[idx]) : 0.0f; idx++;
-    task.positioningAccuracy = row[idx] ? atof(row[idx]) : 0.0; idx++;
-    task.movementSpeed = row[idx] ? atof(row[idx]) : 0.0f; idx++;
-    task.movementAzimuth = row[idx] ? atof(row[idx]) : 0.0; idx++;
-    task.movementElevation = row[idx] ? atof(row[idx]) : 0.0; idx++;
-    task.azimuth = row[idx] ? atof(row[idx]) : 0.0; idx++;
-    task.elevation = row[idx] ? atof(row[idx]) : 0.0; idx++;
-    task.createdAt = row[idx] ? row[idx] : ""; idx++;
+    std::size_t idx = 0;
+    task.taskId = static_cast<int>(stmt.getInt(idx++));
+    task.techSystem = stmt.getString(idx++);
+    task.radiationId = static_cast<int>(stmt.getInt(idx++));
+    task.executionTime = static_cast<float>(stmt.getDouble(idx++));
+    task.targetLongitude = stmt.getDouble(idx++);
+    task.targetLatitude = stmt.getDouble(idx++);
+    task.targetAltitude = stmt.getDouble(idx++);
+    task.positioningDistance = static_cast<float>(stmt.getDouble(idx++));
+    task.positioningTime = static_cast<float>(stmt.getDouble(idx++));
+    task.positioningAccuracy = stmt.getDouble(idx++);
+    task.movementSpeed = static_cast<float>(stmt.getDouble(idx++));
+    task.movementAzimuth = stmt.getDouble(idx++);
+    task.movementElevation = stmt.getDouble(idx++);
+    task.azimuth = stmt.getDouble(idx++);
+    task.elevation = stmt.getDouble(idx++);
+    task.createdAt = stmt.getString(idx++);
     return task;
 }
 
 // 获取任务关联的设备ID列表
-std::vector<int> MultiPlatformTaskDAO::getDeviceIdsByTaskId(int taskId) {
+std::vector<int> MultiPlatformTaskDAO::getDeviceIdsByTaskId(PooledConnection& conn, int taskId) {
     std::vector<int> deviceIds;
     
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn) return deviceIds;
+    PreparedStatement* stmt = conn.prepare(
+        "SELECT device_id FROM platform_task_relation WHERE simulation_id = ? ORDER BY device_id");
+    if (!stmt) return deviceIds;
+    stmt->bindInt(0, taskId);
     
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
-        "SELECT device_id FROM platform_task_relation WHERE simulation_id = %d ORDER BY device_id",
-        taskId
-    );
-    
-    if (mysql_query(conn, sql)) {
-        std::cerr << "Failed to get device IDs: " << mysql_error(conn) << std::endl;
+    if (!stmt->execute()) {
+        std::cerr << "Failed to get device IDs: " << stmt->error() << std::endl;
         return deviceIds;
     }
     
-    MYSQL_RES* result = mysql_store_result(conn);
-    if (!result) {
-        std::cerr << "Failed to store result: " << mysql_error(conn) << std::endl;
-        return deviceIds;
+    while (stmt->fetch()) {
+        deviceIds.push_back(static_cast<int>(stmt->getInt(0)));
     }
-    
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(result))) {
-        deviceIds.push_back(atoi(row[0]));
-    }
-    
-    mysql_free_result(result);
     return deviceIds;
 }
 
 // 保存任务与设备的关联关系
-bool MultiPlatformTaskDAO::saveTaskDeviceRelations(int taskId, const std::vector<int>& deviceIds) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn) return false;
-    
+bool MultiPlatformTaskDAO::saveTaskDeviceRelations(PooledConnection& conn, int taskId, const std::vector<int>& deviceIds) {
     // 先删除原有关联关系
-    char deleteSql[1024];
-    snprintf(deleteSql, sizeof(deleteSql),
-        "DELETE FROM platform_task_relation WHERE simulation_id = %d",
-        taskId
-    );
+    PreparedStatement* deleteStmt = conn.prepare("DELETE FROM platform_task_relation WHERE simulation_id = ?");
+    if (!deleteStmt) return false;
+    deleteStmt->bindInt(0, taskId);
     
-    if (!db.executeSQL(deleteSql)) {
-        std::cerr << "Failed to delete old relations: " << mysql_error(conn) << std::endl;
+    if (!deleteStmt->execute()) {
+        std::cerr << "Failed to delete old relations: " << deleteStmt->error() << std::endl;
         return false;
     }
     
     // 插入新的关联关系
+    PreparedStatement* insertStmt = conn.prepare(
+        "INSERT INTO platform_task_relation (simulation_id, device_id) VALUES (?, ?)");
+    if (!insertStmt) return false;
+    
     for (int deviceId : deviceIds) {
-        char insertSql[1024];
-        snprintf(insertSql, sizeof(insertSql),
-            "INSERT INTO platform_task_relation (simulation_id, device_id) VALUES (%d, %d)",
-            taskId, deviceId
-        );
-        
-        if (!db.executeSQL(insertSql)) {
-            std::cerr << "Failed to insert relation: " << mysql_error(conn) << std::endl;
+        insertStmt->bindInt(0, taskId);
+        insertStmt->bindInt(1, deviceId);
+        if (!insertStmt->execute()) {
+            std::cerr << "Failed to insert relation: " << insertStmt->error() << std::endl;
             return false;
         }
     }
     
     return true;
-} 
\ No newline at end of file
+}
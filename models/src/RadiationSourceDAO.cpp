@@ -1,7 +1,56 @@
 #include "../RadiationSourceDAO.h"
 #include "../DBConnector.h"
 #include <iostream>
-#include <mysql/mysql.h>
+
+// 查询列顺序与 readSource 一致
+static const char* const SOURCE_COLUMNS =
+    "radiation_id, radiation_name, is_stationary, transmit_power, scan_period, carrier_frequency, "
+    "azimuth_start_angle, azimuth_end_angle, elevation_start_angle, elevation_end_angle, movement_speed, movement_azimuth, "
+    "movement_elevation, longitude, latitude, altitude";
+
+// 从当前行读取辐射源
+static RadiationSource readSource(const PreparedStatement& stmt) {
+    RadiationSource source;
+    std::size_t idx = 0;
+    source.setRadiationId(static_cast<int>(stmt.getInt(idx++)));
+    source.setRadiationName(stmt.getString(idx++));
+    source.setIsStationary(stmt.getInt(idx++, 1) != 0);
+    source.setTransmitPower(stmt.getDouble(idx++));
+    source.setScanPeriod(stmt.getDouble(idx++));
+    source.setCarrierFrequency(stmt.getDouble(idx++));
+    source.setAzimuthStart(stmt.getDouble(idx++));    // azimuth_start_angle
+    source.setAzimuthEnd(stmt.getDouble(idx++));      // azimuth_end_angle
+    source.setElevationStart(stmt.getDouble(idx++));  // elevation_start_angle
+    source.setElevationEnd(stmt.getDouble(idx++));    // elevation_end_angle
+    source.setMovementSpeed(stmt.getDouble(idx++));
+    source.setMovementAzimuth(stmt.getDouble(idx++));
+    source.setMovementElevation(stmt.getDouble(idx++));
+    source.setLongitude(stmt.getDouble(idx++));
+    source.setLatitude(stmt.getDouble(idx++));
+    source.setAltitude(stmt.getDouble(idx++));
+    return source;
+}
+
+// 按 INSERT/UPDATE 中的列顺序绑定辐射源字段(不含radiation_id)，返回下一个参数位置
+static std::size_t bindSource(PreparedStatement& stmt, const RadiationSource& source) {
+    std::size_t idx = 0;
+    stmt.bindString(idx++, source.getRadiationName());
+    stmt.bindInt(idx++, source.getIsStationary() ? 1 : 0);
+    stmt.bindDouble(idx++, source.getTransmitPower());
+    stmt.bindDouble(idx++, source.getScanPeriod());
+    stmt.bindDouble(idx++, source.getCarrierFrequency());
+    stmt.bindDouble(idx++, source.getAzimuthStart());
+    stmt.bindDouble(idx++, source.getAzimuthEnd());
+    stmt.bindDouble(idx++, source.getElevationStart());
+    stmt.bindDouble(idx++, source.getElevationEnd());
+    stmt.bindDouble(idx++, source.getMovementSpeed());
+    stmt.bindDouble(idx++, source.getMovementAzimuth());
+    stmt.bindDouble(idx++, source.getMovementElevation());
+    stmt.bindDouble(idx++, source.getLongitude());
+    stmt.bindDouble(idx++, source.getLatitude());
+    stmt.bindDouble(idx++, source.getAltitude());
+    return idx;
+}
 
 // 单例实现
 RadiationSourceDAO& RadiationSourceDAO::getInstance() {
@@ -9,196 +58,141 @@ RadiationSourceDAO& RadiationSourceDAO::getInstance() {
     return instance;
 }
 
-RadiationSourceDAO::RadiationSourceDAO() {
+RadiationSourceDAO::RadiationSourceDAO()
+    : m_cache([](const RadiationSource& s) { return s.getRadiationId(); },
+              [](const RadiationSource& s) { return s.getRadiationName(); },
+              [this](std::vector<RadiationSource>& sources) { return queryAllSources(sources); },
+              [this](int id, RadiationSource& source) { return querySourceById(id, source); }) {
 }
 
 RadiationSourceDAO::~RadiationSourceDAO() {
 }
 
 std::vector<RadiationSource> RadiationSourceDAO::getAllRadiationSources() {
-    std::vector<RadiationSource> sources;
-    DBConnector& db = DBConnector::getInstance();
-    
+    return m_cache.getAll();
+}
+
+int RadiationSourceDAO::getRadiationSourceIdByName(const std::string& name) {
+    RadiationSource source;
+    return m_cache.findByName(name, source) ? source.getRadiationId() : -1;
+}
+
+// 通过ID获取辐射源，不存在时返回默认对象
+RadiationSource RadiationSourceDAO::getRadiationSourceById(int sourceId) {
+    RadiationSource source;
+    if (!m_cache.findById(sourceId, source)) {
+        return RadiationSource();
+    }
+    return source;
+}
+
+bool RadiationSourceDAO::findRadiationSourceById(int sourceId, RadiationSource& source) {
+    return m_cache.findById(sourceId, source);
+}
+
+bool RadiationSourceDAO::findRadiationSourceByName(const std::string& name, RadiationSource& source) {
+    return m_cache.findByName(name, source);
+}
+
+void RadiationSourceDAO::invalidateCache() {
+    m_cache.invalidate();
+}
+
+ModelCacheStats RadiationSourceDAO::getCacheStats() const {
+    return m_cache.getStats();
+}
+
+// 从数据库读取所有辐射源
+bool RadiationSourceDAO::queryAllSources(std::vector<RadiationSource>& sources) {
     // 检查数据库连接
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) {
         std::cerr << "RadiationSourceDAO: No valid database connection" << std::endl;
-        return sources;
-    }
-    
-    const char* sql = "SELECT radiation_id, radiation_name, is_stationary, transmit_power, scan_period, carrier_frequency, "
-                      "azimuth_start_angle, azimuth_end_angle, elevation_start_angle, elevation_end_angle, movement_speed, movement_azimuth, "
-                      "movement_elevation, longitude, latitude, altitude FROM radiation_source_models";
-    
-    if (mysql_query(conn, sql)) {
-        std::cerr << "RadiationSourceDAO: Failed to execute query - " << mysql_error(conn) << std::endl;
-        return sources;
+        return false;
     }
-    
-    MYSQL_RES* res = mysql_store_result(conn);
-    if (!res) {
-        std::cerr << "RadiationSourceDAO: Failed to store result - " << mysql_error(conn) << std::endl;
-        return sources;
+
+    PreparedStatement* stmt = conn.prepare(std::string("SELECT ") + SOURCE_COLUMNS + " FROM radiation_source_models");
+    if (!stmt || !stmt->execute()) {
+        std::cerr << "RadiationSourceDAO: Failed to execute query - " << conn.error() << std::endl;
+        return false;
     }
-    
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(res)) != nullptr) {
-        RadiationSource source;
-        int idx = 0;
-        source.setRadiationId(row[idx] ? atoi(row[idx]) : 0); idx++;
-        source.setRadiationName(row[idx] ? row[idx] : ""); idx++;
-        source.setIsStationary(row[idx] ? atoi(row[idx]) != 0 : true); idx++;
-        source.setTransmitPower(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setScanPeriod(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setCarrierFrequency(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setAzimuthStart(row[idx] ? atof(row[idx]) : 0); idx++;  // azimuth_start_angle
-        source.setAzimuthEnd(row[idx] ? atof(row[idx]) : 0); idx++;    // azimuth_end_angle
-        source.setElevationStart(row[idx] ? atof(row[idx]) : 0); idx++; // elevation_start_angle
-        source.setElevationEnd(row[idx] ? atof(row[idx]) : 0); idx++;  // elevation_end_angle
-        source.setMovementSpeed(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setMovementAzimuth(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setMovementElevation(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setLongitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setLatitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setAltitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        sources.push_back(source);
+
+    while (stmt->fetch()) {
+        sources.push_back(readSource(*stmt));
     }
-    mysql_free_result(res);
-    return sources;
+    return true;
 }
 
-RadiationSource RadiationSourceDAO::getRadiationSourceById(int sourceId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    RadiationSource source;
-
-    char sql[512];
-    snprintf(sql, sizeof(sql),
-        "SELECT radiation_id, radiation_name, is_stationary, transmit_power, scan_period, carrier_frequency, "
-        "azimuth_start_angle, azimuth_end_angle, elevation_start_angle, elevation_end_angle, movement_speed, movement_azimuth, "
-        "movement_elevation, longitude, latitude, altitude FROM radiation_source_models WHERE radiation_id=%d",
-        sourceId);
-
-    if (mysql_query(conn, sql)) {
-        std::cerr << "MySQL query failed: " << mysql_error(conn) << std::endl;
-        return source;
+// 从数据库按ID读取辐射源
+bool RadiationSourceDAO::querySourceById(int sourceId, RadiationSource& source) {
+    PooledConnection conn = DBConnector::getInstance().acquire();
+    PreparedStatement* stmt = conn.prepare(std::string("SELECT ") + SOURCE_COLUMNS + " FROM radiation_source_models WHERE radiation_id=?");
+    if (!stmt) {
+        std::cerr << "MySQL query failed: " << conn.error() << std::endl;
+        return false;
     }
 
-    MYSQL_RES* res = mysql_store_result(conn);
-    if (!res) {
-        std::cerr << "Failed to store result for getRadiationSourceById: " << mysql_error(conn) << std::endl;
-        return source;
+    stmt->bindInt(0, sourceId);
+    if (!stmt->execute()) {
+        std::cerr << "MySQL query failed: " << stmt->error() << std::endl;
+        return false;
     }
 
-    MYSQL_ROW row = mysql_fetch_row(res);
-    if (row) {
-        int idx = 0;
-        source.setRadiationId(row[idx] ? atoi(row[idx]) : 0); idx++;
-        source.setRadiationName(row[idx] ? row[idx] : ""); idx++;
-        source.setIsStationary(row[idx] ? atoi(row[idx]) != 0 : true); idx++;
-        source.setTransmitPower(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setScanPeriod(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setCarrierFrequency(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setAzimuthStart(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setAzimuthEnd(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setElevationStart(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setElevationEnd(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setMovementSpeed(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setMovementAzimuth(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setMovementElevation(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setLongitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setLatitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        source.setAltitude(row[idx] ? atof(row[idx]) : 0); idx++;
+    if (!stmt->fetch()) {
+        return false;
     }
-    mysql_free_result(res);
-
-    return source;
+    source = readSource(*stmt);
+    return true;
 }
 
 bool RadiationSourceDAO::addRadiationSource(const RadiationSource& source, int& sourceId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
-    
-    // 转义辐射源名称，避免SQL注入并处理特殊字符
-    char escaped_name[source.getRadiationName().length()*2+1];
-    mysql_real_escape_string(conn, escaped_name, source.getRadiationName().c_str(), source.getRadiationName().length());
-    
-    char sql[512];
-    snprintf(sql, sizeof(sql),
+
+    PreparedStatement* stmt = conn.prepare(
         "INSERT INTO radiation_source_models (radiation_name, is_stationary, transmit_power, scan_period, carrier_frequency, "
         "azimuth_start_angle, azimuth_end_angle, elevation_start_angle, elevation_end_angle, movement_speed, movement_azimuth, "
         "movement_elevation, longitude, latitude, altitude) "
-        "VALUES ('%s', %d, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f)",
-        escaped_name,
-        source.getIsStationary() ? 1 : 0,
-        source.getTransmitPower(),
-        source.getScanPeriod(),
-        source.getCarrierFrequency(),
-        source.getAzimuthStart(),
-        source.getAzimuthEnd(),
-        source.getElevationStart(),
-        source.getElevationEnd(),
-        source.getMovementSpeed(),
-        source.getMovementAzimuth(),
-        source.getMovementElevation(),
-        source.getLongitude(),
-        source.getLatitude(),
-        source.getAltitude()
-    );
-    
-    if (!db.executeSQL(sql)) {
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    if (!stmt) return false;
+    bindSource(*stmt, source);
+
+    if (!stmt->execute()) {
         return false;
     }
-    
+
     // 获取自增ID
-    sourceId = (int)mysql_insert_id(conn);
+    sourceId = static_cast<int>(stmt->insertId());
+    m_cache.invalidate();
     return true;
 }
 
 bool RadiationSourceDAO::updateRadiationSource(const RadiationSource& source) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
-    
-    // 转义辐射源名称，避免SQL注入并处理特殊字符
-    char escaped_name[source.getRadiationName().length()*2+1];
-    mysql_real_escape_string(conn, escaped_name, source.getRadiationName().c_str(), source.getRadiationName().length());
-    
-    char sql[512];
-    snprintf(sql, sizeof(sql),
-        "UPDATE radiation_source_models SET radiation_name='%s', is_stationary=%d, transmit_power=%f, scan_period=%f, "
-        "carrier_frequency=%f, azimuth_start_angle=%f, azimuth_end_angle=%f, elevation_start_angle=%f, elevation_end_angle=%f, "
-        "movement_speed=%f, movement_azimuth=%f, movement_elevation=%f, longitude=%f, latitude=%f, altitude=%f "
-        "WHERE radiation_id=%d",
-        escaped_name,
-        source.getIsStationary() ? 1 : 0,
-        source.getTransmitPower(),
-        source.getScanPeriod(),
-        source.getCarrierFrequency(),
-        source.getAzimuthStart(),
-        source.getAzimuthEnd(),
-        source.getElevationStart(),
-        source.getElevationEnd(),
-        source.getMovementSpeed(),
-        source.getMovementAzimuth(),
-        source.getMovementElevation(),
-        source.getLongitude(),
-        source.getLatitude(),
-        source.getAltitude(),
-        source.getRadiationId()
-    );
-    
-    return db.executeSQL(sql);
+
+    PreparedStatement* stmt = conn.prepare(
+        "UPDATE radiation_source_models SET radiation_name=?, is_stationary=?, transmit_power=?, scan_period=?, "
+        "carrier_frequency=?, azimuth_start_angle=?, azimuth_end_angle=?, elevation_start_angle=?, elevation_end_angle=?, "
+        "movement_speed=?, movement_azimuth=?, movement_elevation=?, longitude=?, latitude=?, altitude=? "
+        "WHERE radiation_id=?");
+    if (!stmt) return false;
+    std::size_t idx = bindSource(*stmt, source);
+    stmt->bindInt(idx, source.getRadiationId());
+
+    if (!stmt->execute()) return false;
+    m_cache.invalidate();
+    return true;
 }
 
 bool RadiationSourceDAO::deleteRadiationSource(int sourceId) {
     std::cout << "RadiationSourceDAO: Deleting radiation source with ID " << sourceId << std::endl;
-    
-    DBConnector& db = DBConnector::getInstance();
-    
-    char sql[128];
-    snprintf(sql, sizeof(sql), "DELETE FROM radiation_source_models WHERE radiation_id=%d", sourceId);
-    
-    return db.executeSQL(sql);
-}
\ No newline at end of file
+
+    PooledConnection conn = DBConnector::getInstance().acquire();
+    PreparedStatement* stmt = conn.prepare("DELETE FROM radiation_source_models WHERE radiation_id=?");
+    if (!stmt) return false;
+    stmt->bindInt(0, sourceId);
+    if (!stmt->execute()) return false;
+    m_cache.invalidate();
+    return true;
+}
@@ -2,7 +2,58 @@
 #include "../DBConnector.h"
 #include <stdexcept>
 #include <iostream>
-#include <mysql/mysql.h>
+
+// 查询列顺序与 readDevice 一致
+static const char* const DEVICE_COLUMNS =
+    "device_id, device_name, is_stationary, baseline_length, noise_psd, sample_rate, freq_range_min, freq_range_max, angle_azimuth_min, angle_azimuth_max, angle_elevation_min, angle_elevation_max, movement_speed, movement_azimuth, movement_elevation, longitude, latitude, altitude";
+
+// 从当前行读取侦察设备
+static ReconnaissanceDevice readDevice(const PreparedStatement& stmt) {
+    ReconnaissanceDevice device;
+    std::size_t idx = 0;
+    device.setDeviceId(static_cast<int>(stmt.getInt(idx++)));
+    device.setDeviceName(stmt.getString(idx++));
+    device.setIsStationary(stmt.getInt(idx++, 1) != 0);
+    device.setBaselineLength(static_cast<float>(stmt.getDouble(idx++)));
+    device.setNoisePsd(static_cast<float>(stmt.getDouble(idx++)));
+    device.setSampleRate(static_cast<float>(stmt.getDouble(idx++)));
+    device.setFreqRangeMin(static_cast<float>(stmt.getDouble(idx++)));
+    device.setFreqRangeMax(static_cast<float>(stmt.getDouble(idx++)));
+    device.setAngleAzimuthMin(static_cast<float>(stmt.getDouble(idx++)));
+    device.setAngleAzimuthMax(static_cast<float>(stmt.getDouble(idx++)));
+    device.setAngleElevationMin(static_cast<float>(stmt.getDouble(idx++)));
+    device.setAngleElevationMax(static_cast<float>(stmt.getDouble(idx++)));
+    device.setMovementSpeed(static_cast<float>(stmt.getDouble(idx++)));
+    device.setMovementAzimuth(static_cast<float>(stmt.getDouble(idx++)));
+    device.setMovementElevation(static_cast<float>(stmt.getDouble(idx++)));
+    device.setLongitude(stmt.getDouble(idx++));
+    device.setLatitude(stmt.getDouble(idx++));
+    device.setAltitude(stmt.getDouble(idx++));
+    return device;
+}
+
+// 按 INSERT/UPDATE 中的列顺序绑定设备字段(不含device_id)，返回下一个参数位置
+static std::size_t bindDevice(PreparedStatement& stmt, const ReconnaissanceDevice& device) {
+    std::size_t idx = 0;
+    stmt.bindString(idx++, device.getDeviceName());
+    stmt.bindInt(idx++, device.getIsStationary() ? 1 : 0);
+    stmt.bindDouble(idx++, device.getBaselineLength());
+    stmt.bindDouble(idx++, device.getNoisePsd());
+    stmt.bindDouble(idx++, device.getSampleRate());
+    stmt.bindDouble(idx++, device.getFreqRangeMin());
+    stmt.bindDouble(idx++, device.getFreqRangeMax());
+    stmt.bindDouble(idx++, device.getAngleAzimuthMin());
+    stmt.bindDouble(idx++, device.getAngleAzimuthMax());
+    stmt.bindDouble(idx++, device.getAngleElevationMin());
+    stmt.bindDouble(idx++, device.getAngleElevationMax());
+    stmt.bindDouble(idx++, device.getMovementSpeed());
+    stmt.bindDouble(idx++, device.getMovementAzimuth());
+    stmt.bindDouble(idx++, device.getMovementElevation());
+    stmt.bindDouble(idx++, device.getLongitude());
+    stmt.bindDouble(idx++, device.getLatitude());
+    stmt.bindDouble(idx++, device.getAltitude());
+    return idx;
+}
 
 // 单例实现
 ReconnaissanceDeviceDAO& ReconnaissanceDeviceDAO::getInstance() {
@@ -11,8 +62,11 @@ ReconnaissanceDeviceDAO& ReconnaissanceDeviceDAO::getInstance() {
 }
 
 // 构造函数
-ReconnaissanceDeviceDAO::ReconnaissanceDeviceDAO() {
-    // 初始化代码
+ReconnaissanceDeviceDAO::ReconnaissanceDeviceDAO()
+    : m_cache([](const ReconnaissanceDevice& d) { return d.getDeviceId(); },
+              [](const ReconnaissanceDevice& d) { return d.getDeviceName(); },
+              [this](std::vector<ReconnaissanceDevice>& devices) { return queryAllDevices(devices); },
+              [this](int id, ReconnaissanceDevice& device) { return queryDeviceById(id, device); }) {
 }
 
 // 析构函数
@@ -22,177 +76,121 @@ ReconnaissanceDeviceDAO::~ReconnaissanceDeviceDAO() {
 
 // 获取所有侦察设备
 std::vector<ReconnaissanceDevice> ReconnaissanceDeviceDAO::getAllReconnaissanceDevices() {
-    std::vector<ReconnaissanceDevice> devices;
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    const char* sql = "SELECT device_id, device_name, is_stationary, baseline_length, noise_psd, sample_rate, freq_range_min, freq_range_max, angle_azimuth_min, angle_azimuth_max, angle_elevation_min, angle_elevation_max, movement_speed, movement_azimuth, movement_elevation, longitude, latitude, altitude FROM reconnaissance_device_models";
-    if (mysql_query(conn, sql)) {
-        std::cerr << "Failed to execute query for getAllReconnaissanceDevices: " << mysql_error(conn) << std::endl;
-        return devices;
+    return m_cache.getAll();
+}
+
+// 通过名称获取侦察设备ID
+int ReconnaissanceDeviceDAO::getReconnaissanceDeviceIdByName(const std::string& name) {
+    ReconnaissanceDevice device;
+    return m_cache.findByName(name, device) ? device.getDeviceId() : -1;
+}
+
+// 通过ID获取侦察设备，不存在时返回默认对象
+ReconnaissanceDevice ReconnaissanceDeviceDAO::getReconnaissanceDeviceById(int deviceId) {
+    ReconnaissanceDevice device;
+    if (!m_cache.findById(deviceId, device)) {
+        return ReconnaissanceDevice();
     }
-    MYSQL_RES* res = mysql_store_result(conn);
-    if (!res) {
-        std::cerr << "Failed to store result for getAllReconnaissanceDevices: " << mysql_error(conn) << std::endl;
-        return devices;
+    return device;
+}
+
+// 通过ID查找侦察设备
+bool ReconnaissanceDeviceDAO::findReconnaissanceDeviceById(int deviceId, ReconnaissanceDevice& device) {
+    return m_cache.findById(deviceId, device);
+}
+
+// 通过名称查找侦察设备
+bool ReconnaissanceDeviceDAO::findReconnaissanceDeviceByName(const std::string& name, ReconnaissanceDevice& device) {
+    return m_cache.findByName(name, device);
+}
+
+void ReconnaissanceDeviceDAO::invalidateCache() {
+    m_cache.invalidate();
+}
+
+ModelCacheStats ReconnaissanceDeviceDAO::getCacheStats() const {
+    return m_cache.getStats();
+}
+
+// 从数据库读取所有侦察设备
+bool ReconnaissanceDeviceDAO::queryAllDevices(std::vector<ReconnaissanceDevice>& devices) {
+    PooledConnection conn = DBConnector::getInstance().acquire();
+    PreparedStatement* stmt = conn.prepare(std::string("SELECT ") + DEVICE_COLUMNS + " FROM reconnaissance_device_models");
+    if (!stmt || !stmt->execute()) {
+        std::cerr << "Failed to execute query for getAllReconnaissanceDevices: " << conn.error() << std::endl;
+        return false;
     }
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(res)) != nullptr) {
-        ReconnaissanceDevice device;
-        int idx = 0;
-        device.setDeviceId(row[idx] ? atoi(row[idx]) : 0); idx++;
-        device.setDeviceName(row[idx] ? row[idx] : ""); idx++;
-        device.setIsStationary(row[idx] ? atoi(row[idx]) != 0 : true); idx++;
-        device.setBaselineLength(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setNoisePsd(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setSampleRate(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setFreqRangeMin(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setFreqRangeMax(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setAngleAzimuthMin(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setAngleAzimuthMax(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setAngleElevationMin(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setAngleElevationMax(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setMovementSpeed(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setMovementAzimuth(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setMovementElevation(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setLongitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        device.setLatitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        device.setAltitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        devices.push_back(device);
+    while (stmt->fetch()) {
+        devices.push_back(readDevice(*stmt));
     }
-    mysql_free_result(res);
-    return devices;
+    return true;
 }
 
-// 通过ID获取侦察设备
-ReconnaissanceDevice ReconnaissanceDeviceDAO::getReconnaissanceDeviceById(int deviceId) {
-    ReconnaissanceDevice device;
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    char sql[512];
-    snprintf(sql, sizeof(sql),
-        "SELECT device_id, device_name, is_stationary, baseline_length, noise_psd, sample_rate, freq_range_min, freq_range_max, angle_azimuth_min, angle_azimuth_max, angle_elevation_min, angle_elevation_max, movement_speed, movement_azimuth, movement_elevation, longitude, latitude, altitude FROM reconnaissance_device_models WHERE device_id=%d",
-        deviceId);
-    if (mysql_query(conn, sql)) {
-        std::cerr << "Failed to execute query for getReconnaissanceDeviceById: " << mysql_error(conn) << std::endl;
-        return device;
+// 从数据库按ID读取侦察设备
+bool ReconnaissanceDeviceDAO::queryDeviceById(int deviceId, ReconnaissanceDevice& device) {
+    PooledConnection conn = DBConnector::getInstance().acquire();
+    PreparedStatement* stmt = conn.prepare(std::string("SELECT ") + DEVICE_COLUMNS + " FROM reconnaissance_device_models WHERE device_id=?");
+    if (!stmt) {
+        std::cerr << "Failed to prepare query for getReconnaissanceDeviceById: " << conn.error() << std::endl;
+        return false;
     }
-    MYSQL_RES* res = mysql_store_result(conn);
-    if (!res) {
-        std::cerr << "Failed to store result for getReconnaissanceDeviceById: " << mysql_error(conn) << std::endl;
-        return device;
+    stmt->bindInt(0, deviceId);
+    if (!stmt->execute()) {
+        std::cerr << "Failed to execute query for getReconnaissanceDeviceById: " << stmt->error() << std::endl;
+        return false;
     }
-    MYSQL_ROW row = mysql_fetch_row(res);
-    if (row) {
-        int idx = 0;
-        device.setDeviceId(row[idx] ? atoi(row[idx]) : 0); idx++;
-        device.setDeviceName(row[idx] ? row[idx] : ""); idx++;
-        device.setIsStationary(row[idx] ? atoi(row[idx]) != 0 : true); idx++;
-        device.setBaselineLength(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setNoisePsd(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setSampleRate(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setFreqRangeMin(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setFreqRangeMax(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setAngleAzimuthMin(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setAngleAzimuthMax(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setAngleElevationMin(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setAngleElevationMax(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setMovementSpeed(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setMovementAzimuth(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setMovementElevation(row[idx] ? static_cast<float>(atof(row[idx])) : 0); idx++;
-        device.setLongitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        device.setLatitude(row[idx] ? atof(row[idx]) : 0); idx++;
-        device.setAltitude(row[idx] ? atof(row[idx]) : 0); idx++;
+    if (!stmt->fetch()) {
+        return false;
     }
-    mysql_free_result(res);
-    return device;
+    device = readDevice(*stmt);
+    return true;
 }
 
 // 添加侦察设备
 bool ReconnaissanceDeviceDAO::addReconnaissanceDevice(const ReconnaissanceDevice& device, int& deviceId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
-    
-    // 转义设备名称，避免SQL注入并处理特殊字符
-    char escaped_name[device.getDeviceName().length()*2+1];
-    mysql_real_escape_string(conn, escaped_name, device.getDeviceName().c_str(), device.getDeviceName().length());
-    
-    char sql[512];
-    snprintf(sql, sizeof(sql),
+
+    PreparedStatement* stmt = conn.prepare(
         "INSERT INTO reconnaissance_device_models (device_name, is_stationary, baseline_length, noise_psd, sample_rate, freq_range_min, freq_range_max, angle_azimuth_min, angle_azimuth_max, angle_elevation_min, angle_elevation_max, movement_speed, movement_azimuth, movement_elevation, longitude, latitude, altitude) "
-        "VALUES ('%s', %d, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f)",
-        escaped_name,
-        device.getIsStationary() ? 1 : 0,
-        device.getBaselineLength(),
-        device.getNoisePsd(),
-        device.getSampleRate(),
-        device.getFreqRangeMin(),
-        device.getFreqRangeMax(),
-        device.getAngleAzimuthMin(),
-        device.getAngleAzimuthMax(),
-        device.getAngleElevationMin(),
-        device.getAngleElevationMax(),
-        device.getMovementSpeed(),
-        device.getMovementAzimuth(),
-        device.getMovementElevation(),
-        device.getLongitude(),
-        device.getLatitude(),
-        device.getAltitude()
-    );
-    
-    if (!db.executeSQL(sql)) {
-        std::cerr << "Failed to add reconnaissance device: " << mysql_error(conn) << std::endl;
-        std::cerr << "SQL: " << sql << std::endl;
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    if (!stmt) return false;
+    bindDevice(*stmt, device);
+
+    if (!stmt->execute()) {
+        std::cerr << "Failed to add reconnaissance device: " << stmt->error() << std::endl;
         return false;
     }
-    
+
     // 获取自增ID
-    deviceId = (int)mysql_insert_id(conn);
+    deviceId = static_cast<int>(stmt->insertId());
+    m_cache.invalidate();
     return true;
 }
 
 // 更新侦察设备
 bool ReconnaissanceDeviceDAO::updateReconnaissanceDevice(const ReconnaissanceDevice& device) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
-    
-    // 转义设备名称，避免SQL注入并处理特殊字符
-    char escaped_name[device.getDeviceName().length()*2+1];
-    mysql_real_escape_string(conn, escaped_name, device.getDeviceName().c_str(), device.getDeviceName().length());
-    
-    char sql[512];
-    snprintf(sql, sizeof(sql),
-        "UPDATE reconnaissance_device_models SET device_name='%s', is_stationary=%d, baseline_length=%f, noise_psd=%f, sample_rate=%f, freq_range_min=%f, freq_range_max=%f, angle_azimuth_min=%f, angle_azimuth_max=%f, angle_elevation_min=%f, angle_elevation_max=%f, movement_speed=%f, movement_azimuth=%f, movement_elevation=%f, longitude=%f, latitude=%f, altitude=%f WHERE device_id=%d",
-        escaped_name,
-        device.getIsStationary() ? 1 : 0,
-        device.getBaselineLength(),
-        device.getNoisePsd(),
-        device.getSampleRate(),
-        device.getFreqRangeMin(),
-        device.getFreqRangeMax(),
-        device.getAngleAzimuthMin(),
-        device.getAngleAzimuthMax(),
-        device.getAngleElevationMin(),
-        device.getAngleElevationMax(),
-        device.getMovementSpeed(),
-        device.getMovementAzimuth(),
-        device.getMovementElevation(),
-        device.getLongitude(),
-        device.getLatitude(),
-        device.getAltitude(),
-        device.getDeviceId()
-    );
-    
-    return db.executeSQL(sql);
+
+    PreparedStatement* stmt = conn.prepare(
+        "UPDATE reconnaissance_device_models SET device_name=?, is_stationary=?, baseline_length=?, noise_psd=?, sample_rate=?, freq_range_min=?, freq_range_max=?, angle_azimuth_min=?, angle_azimuth_max=?, angle_elevation_min=?, angle_elevation_max=?, movement_speed=?, movement_azimuth=?, movement_elevation=?, longitude=?, latitude=?, altitude=? WHERE device_id=?");
+    if (!stmt) return false;
+    std::size_t idx = bindDevice(*stmt, device);
+    stmt->bindInt(idx, device.getDeviceId());
+
+    if (!stmt->execute()) return false;
+    m_cache.invalidate();
+    return true;
 }
 
 // 删除侦察设备
 bool ReconnaissanceDeviceDAO::deleteReconnaissanceDevice(int deviceId) {
-    DBConnector& db = DBConnector::getInstance();
-    
-    char sql[128];
-    snprintf(sql, sizeof(sql), "DELETE FROM reconnaissance_device_models WHERE device_id=%d", deviceId);
-    
-    return db.executeSQL(sql);
-}
\ No newline at end of file
+    PooledConnection conn = DBConnector::getInstance().acquire();
+    PreparedStatement* stmt = conn.prepare("DELETE FROM reconnaissance_device_models WHERE device_id=?");
+    if (!stmt) return false;
+    stmt->bindInt(0, deviceId);
+    if (!stmt->execute()) return false;
+    m_cache.invalidate();
+    return true;
+}
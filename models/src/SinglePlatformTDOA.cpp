@@ -1,7 +1,10 @@
 #include "../SinglePlatformTDOA.h"
 #include "../../constants/PhysicsConstants.h"
 #include "../../utils/CoordinateTransform.h"
-#include "../SinglePlatformTaskDAO.h" // 添加任务DAO头文件
+#include "../../utils/Instrumentation.h"
+#include "../../utils/Log.h"
+#include "../../utils/RandomStream.h"
+#include "../ModelRepository.h"
 #include <cmath>
 #include <iostream>
 #include <vector>
@@ -9,11 +12,13 @@
 #include <algorithm>
 #include <random>
 #include <numeric>
-#include <gtk/gtk.h>
 
 // 使用常量命名空间
 using namespace Constants;
 
+// 流式时差测量的观测样本数(每通道)
+static const std::uint64_t SIGNAL_OBSERVATION_SAMPLES = 1 << 22;
+
 // 单例实现
 SinglePlatformTDOA& SinglePlatformTDOA::getInstance() {
     static SinglePlatformTDOA instance;
@@ -24,30 +29,24 @@ SinglePlatformTDOA& SinglePlatformTDOA::getInstance() {
 double SinglePlatformTDOA::calculateTimeDifferenceCorrelation(
     const std::vector<double>& signal1, 
     const std::vector<double>& signal2,
-    double samplingRate) {
-    
-    // 计算互相关
-    int maxLag = std::min(signal1.size(), signal2.size()) / 2;
-    std::vector<double> crossCorr(2 * maxLag + 1, 0.0);
-    
-    for (int lag = -maxLag; lag <= maxLag; lag++) {
-        double corr = 0.0;
-        int n = 0;
-        for (int i = 0; i < signal1.size() && i - lag >= 0 && i - lag < signal2.size(); i++) {
-            corr += signal1[i] * signal2[i - lag];
-            n++;
-        }
-        if (n > 0) {
-            crossCorr[lag + maxLag] = corr / n;
-        }
+    double samplingRate,
+    GccWeighting weighting) {
+    
+    // 每个线程复用各自的估计器工作区，FFT计划全局缓存
+    thread_local GccDelayEstimator estimator;
+    GccOptions options;
+    options.weighting = weighting;
+    estimator.setOptions(options);
+    
+    // 搜索范围 ±N/2，峰值抛物线插值得到亚采样时延
+    GccResult result = estimator.estimate(signal1, signal2, samplingRate);
+    if (!result.valid) {
+        std::cerr << "互相关时差估计失败: 信号过短或采样率无效" << std::endl;
+        return 0.0;
     }
     
-    // 寻找互相关峰值位置
-    auto maxIt = std::max_element(crossCorr.begin(), crossCorr.end());
-    int peakLag = std::distance(crossCorr.begin(), maxIt) - maxLag;
-    
     // 计算时差 (秒)
-    return peakLag / samplingRate;
+    return result.delaySeconds;
 }
 
 // 频谱相位法计算时差
@@ -57,38 +56,81 @@ double SinglePlatformTDOA::calculateTimeDifferencePhase(
     double samplingRate, 
     double frequency) {
     
-    // 简化的频谱相位法实现
-    int n = std::min(signal1.size(), signal2.size());
-    
-    // 计算特定频率的相位
-    double phase1 = 0.0, phase2 = 0.0;
-    double sum1Re = 0.0, sum1Im = 0.0;
-    double sum2Re = 0.0, sum2Im = 0.0;
+    return calculateTimeDifferencePhase(signal1, signal2, samplingRate,
+                                        std::vector<double>(1, frequency));
+}
+
+// 多频点频谱相位法计算时差
+double SinglePlatformTDOA::calculateTimeDifferencePhase(
+    const std::vector<double>& signal1, 
+    const std::vector<double>& signal2,
+    double samplingRate, 
+    const std::vector<double>& frequencies) {
     
-    for (int i = 0; i < n; i++) {
-        double t = i / samplingRate;
-        sum1Re += signal1[i] * std::cos(2 * PI * frequency * t);
-        sum1Im += signal1[i] * std::sin(2 * PI * frequency * t);
-        sum2Re += signal2[i] * std::cos(2 * PI * frequency * t);
-        sum2Im += signal2[i] * std::sin(2 * PI * frequency * t);
+    if (frequencies.empty() || samplingRate <= 0.0) {
+        std::cerr << "频谱相位法时差估计失败: 频点为空或采样率无效" << std::endl;
+        return 0.0;
     }
     
-    phase1 = std::atan2(sum1Im, sum1Re);
-    phase2 = std::atan2(sum2Im, sum2Re);
-    double phaseDiff = std::fmod(phase2 - phase1, 2 * PI);
+    // Goertzel递推一遍扫描同时得到两路信号在各频点的相位，代替逐点 cos/sin
+    MultiTonePhaseEstimator estimator(frequencies, samplingRate);
+    std::vector<TonePhase> tones = estimator.estimate(signal1, signal2);
     
-    // 处理相位缠绕
-    if (phaseDiff > PI) phaseDiff -= 2 * PI;
-    if (phaseDiff < -PI) phaseDiff += 2 * PI;
+    // 计算时差 (秒)，多频点时由相位差随频率的斜率解模糊
+    return MultiTonePhaseEstimator::resolveDelay(tones);
+}
+
+// 以流式IQ接收管线测量时差
+bool SinglePlatformTDOA::measureTimeDifference(const ReconnaissanceDevice& device,
+                                               const RadiationSource& source,
+                                               double distance,
+                                               double trueTimeDifference,
+                                               double maxTimeDifference,
+                                               double& measuredTimeDifference,
+                                               SignalPipelineResult& pipelineResult,
+                                               const std::atomic<bool>* cancelFlag) {
+    const double sampleRate = device.getSampleRate() * 1e9;          // GHz转换为Hz
+    const double carrierFrequency = source.getCarrierFrequency() * 1e9;
+    if (sampleRate <= 0.0 || carrierFrequency <= 0.0 || distance <= 0.0) {
+        std::cerr << "时差测量失败: 采样率、载频或距离无效" << std::endl;
+        return false;
+    }
     
-    // 计算时差 (秒)
-    return phaseDiff / (2 * PI * frequency);
+    // 自由空间传播的接收功率，发射功率千瓦转换为瓦
+    const double lambda = c / carrierFrequency;
+    const double pathGain = lambda / (4 * PI * distance);
+    
+    SignalPipelineConfig config;
+    config.signal.sampleRate = sampleRate;
+    config.signal.carrierFrequency = carrierFrequency;
+    config.signal.bandwidth = std::min(sampleRate / 4,
+        static_cast<double>(device.getFreqRangeMax() - device.getFreqRangeMin()) * 1e9);
+    config.signal.noisePsd = device.getNoisePsd();
+    config.signal.receivedPower = source.getTransmitPower() * 1000.0 * pathGain * pathGain;
+    config.signal.scanPeriod = source.getScanPeriod();
+    // 通道1为初始位置、通道2为移动后位置，通道2的相对时延为 (距离2 - 距离1) / c
+    config.signal.delay = -trueTimeDifference;
+    // 信号与噪声的随机流按(当前任务, 辐射源, 侦察设备)派生
+    config.signal.seed = RandomService::getInstance().stream(
+        RandomPurpose::SignalNoise, source.getRadiationId(), device.getDeviceId())();
+    config.observationSamples = SIGNAL_OBSERVATION_SAMPLES;
+    config.maxDelay = std::max(std::fabs(maxTimeDifference), std::fabs(trueTimeDifference));
+    config.cancelFlag = cancelFlag;
+    
+    pipelineResult = SignalPipeline::run(config);
+    if (!pipelineResult.valid) {
+        return false;
+    }
+    measuredTimeDifference = -pipelineResult.gccDelay;
+    return true;
 }
 
 // 时差体制定位算法实现
 LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& device, 
                                                const RadiationSource& source,
-                                               int simulationTime) {
+                                               int simulationTime,
+                                               const std::atomic<bool>* cancelFlag) {
+    PL_TRACE_SCOPE("SinglePlatformTDOA.runSimulation");
     LocationResult result;
     
     // 获取设备初始位置
@@ -96,14 +138,14 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     double latitude1 = device.getLatitude();
     double altitude1 = device.getAltitude();
     COORD3 position1 = lbh2xyz(longitude1, latitude1, altitude1);
-    g_print("设备初始位置: %.6f°, %.6f°, %.2fm\n", longitude1, latitude1, altitude1);
+    PL_LOG_DEBUG("设备初始位置: %.6f°, %.6f°, %.2fm\n", longitude1, latitude1, altitude1);
     
     // 获取辐射源位置
     double srcLongitude = source.getLongitude();
     double srcLatitude = source.getLatitude();
     double srcAltitude = source.getAltitude();
     COORD3 sourcePosition = lbh2xyz(srcLongitude, srcLatitude, srcAltitude);
-    g_print("辐射源位置: %.6f°, %.6f°, %.2fm\n", srcLongitude, srcLatitude, srcAltitude);
+    PL_LOG_DEBUG("辐射源位置: %.6f°, %.6f°, %.2fm\n", srcLongitude, srcLatitude, srcAltitude);
     
     // 计算设备到辐射源的初始距离
     double distance1 = sqrt(
@@ -111,7 +153,7 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
         pow(sourcePosition.p2 - position1.p2, 2) +
         pow(sourcePosition.p3 - position1.p3, 2)
     );
-    g_print("初始距离: %.2fm\n", distance1);
+    PL_LOG_DEBUG("初始距离: %.2fm\n", distance1);
     
     // 模拟设备移动到第二个位置（根据设备速度和方向移动）
     double movementTime = simulationTime; // 使用传入的仿真时间
@@ -147,7 +189,7 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     double latitude2 = position2.p2;
     double altitude2 = position2.p3;
     
-    g_print("设备移动后位置: %.6f°, %.6f°, %.2fm\n", longitude2, latitude2, altitude2);
+    PL_LOG_DEBUG("设备移动后位置: %.6f°, %.6f°, %.2fm\n", longitude2, latitude2, altitude2);
     
     // 计算设备移动后到辐射源的距离
     double distance2 = sqrt(
@@ -155,17 +197,35 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
         pow(sourcePosition.p2 - y2, 2) +
         pow(sourcePosition.p3 - z2, 2)
     );
-    g_print("移动后距离: %.2fm\n", distance2);
+    PL_LOG_DEBUG("移动后距离: %.2fm\n", distance2);
     
     // 计算时间差（距离差除以光速）
     double timeDifference = (distance1 - distance2) / c;
-    g_print("时间差: %.9fs\n", timeDifference);
-    
-    // --- 使用改进的双曲线定位算法 ---
+    PL_LOG_DEBUG("时间差: %.9fs\n", timeDifference);
     
     // 在单平台时差中，我们可以认为形成了一个虚拟基线
     double baselineLength = movementDistance;
     
+    // 由接收信号测量时差，代替几何闭式值参与后续定位
+    double measuredTimeDifference = 0.0;
+    SignalPipelineResult pipelineResult;
+    if (measureTimeDifference(device, source, (distance1 + distance2) / 2, timeDifference,
+                              baselineLength / c, measuredTimeDifference, pipelineResult, cancelFlag)) {
+        PL_LOG_DEBUG("信号测量时差: %.12fs (偏差 %.3es), %llu 样本, %.2f Msps, 内存 %.1f MB\n",
+               measuredTimeDifference, measuredTimeDifference - timeDifference,
+               static_cast<unsigned long long>(pipelineResult.samples),
+               pipelineResult.throughputMsps, pipelineResult.memoryBytes / 1048576.0);
+        timeDifference = measuredTimeDifference;
+    } else if (pipelineResult.cancelled) {
+        // 任务已取消，结果将被调用方丢弃
+        PL_LOG_DEBUG("信号测量时差已取消\n");
+        return result;
+    } else {
+        PL_LOG_WARN("警告：信号测量时差失败，使用几何时差\n");
+    }
+    
+    // --- 使用改进的双曲线定位算法 ---
+    
     // 计算基线中点（等效于虚拟阵列中心）
     double midX = (position1.p1 + x2) / 2;
     double midY = (position1.p2 + y2) / 2;
@@ -188,7 +248,7 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     
     // 检查时差是否合理
     if (std::abs(timeDifference) > baselineLength / c) {
-        g_print("警告：时差值 %.9fs 超过了理论最大值 %.9fs\n", 
+        PL_LOG_WARN("警告：时差值 %.9fs 超过了理论最大值 %.9fs\n", 
                timeDifference, baselineLength / c);
     }
     
@@ -197,17 +257,17 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     sinTheta = std::max(std::min(sinTheta, 1.0), -1.0);
     
     if (std::abs(originalSinTheta) > 1.0) {
-        g_print("警告：sinθ计算值 %.6f 超出有效范围[-1,1]，已调整为 %.6f\n", 
+        PL_LOG_WARN("警告：sinθ计算值 %.6f 超出有效范围[-1,1]，已调整为 %.6f\n", 
                originalSinTheta, sinTheta);
     }
     
     double incidentAngle = std::asin(sinTheta);
     
-    g_print("计算入射角: %.2f° (sinθ=%.6f)\n", incidentAngle * RAD2DEG, sinTheta);
+    PL_LOG_DEBUG("计算入射角: %.2f° (sinθ=%.6f)\n", incidentAngle * RAD2DEG, sinTheta);
     
     // 检查入射角是否接近90度，这可能导致后续计算不稳定
     if (std::abs(incidentAngle * RAD2DEG) > 85.0) {
-        g_print("警告：入射角接近90度，可能导致高度计算不准确\n");
+        PL_LOG_WARN("警告：入射角接近90度，可能导致高度计算不准确\n");
     }
     
     // --- 改进的方向向量计算 ---
@@ -292,17 +352,17 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     // 限制俯仰角在合理范围内
     elevation = std::max(std::min(elevation, 90.0), -90.0);
     
-    g_print("原始计算的俯仰角: %.2f°\n", elevation);
+    PL_LOG_DEBUG("原始计算的俯仰角: %.2f°\n", elevation);
     
     // 检查俯仰角是否合理（通常辐射源不会在极高或极低的位置）
     const double MAX_TYPICAL_ELEVATION = 60.0;   // 60度
     const double MIN_TYPICAL_ELEVATION = -30.0;  // -30度
     
     // 时差体制高度计算分析
-    g_print("时差体制高度计算分析:\n");
-    g_print("  1. 入射角: %.2f°\n", incidentAngle * RAD2DEG);
-    g_print("  2. 基线长度: %.2fm\n", baselineLength);
-    g_print("  3. 时间差: %.9fs\n", timeDifference);
+    PL_LOG_DEBUG("时差体制高度计算分析:\n");
+    PL_LOG_DEBUG("  1. 入射角: %.2f°\n", incidentAngle * RAD2DEG);
+    PL_LOG_DEBUG("  2. 基线长度: %.2fm\n", baselineLength);
+    PL_LOG_DEBUG("  3. 时间差: %.9fs\n", timeDifference);
     
     // 计算水平距离和高度差的直接估计
     // 使用中点到辐射源的直线距离
@@ -323,9 +383,9 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     
     // 使用几何关系直接计算俯仰角
     double geometricElevation = atan2(heightDifference, horizontalDistToSource) * RAD2DEG;
-    g_print("  4. 几何计算的俯仰角: %.2f°\n", geometricElevation);
-    g_print("  5. 原始计算的俯仰角: %.2f°\n", elevation);
-    g_print("  6. 俯仰角差异: %.2f°\n", std::abs(geometricElevation - elevation));
+    PL_LOG_DEBUG("  4. 几何计算的俯仰角: %.2f°\n", geometricElevation);
+    PL_LOG_DEBUG("  5. 原始计算的俯仰角: %.2f°\n", elevation);
+    PL_LOG_DEBUG("  6. 俯仰角差异: %.2f°\n", std::abs(geometricElevation - elevation));
     
     // --- 迭代优化算法 ---
     // 参考Taylor迭代方法，修正俯仰角误差
@@ -338,11 +398,11 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     // 当俯仰角差异较大时，使用迭代优化
     if (std::abs(geometricElevation - elevation) > 5.0) {
         useIterativeOptimization = true;
-        g_print("  开始迭代优化俯仰角...\n");
+        PL_LOG_DEBUG("  开始迭代优化俯仰角...\n");
         
         // 使用几何俯仰角作为初始值，而不是使用原始计算的俯仰角
         currentElevation = geometricElevation;
-        g_print("    使用几何俯仰角 %.2f° 作为迭代初始值\n", currentElevation);
+        PL_LOG_DEBUG("    使用几何俯仰角 %.2f° 作为迭代初始值\n", currentElevation);
         
         // 计算目标向量与基线的夹角（理论上应该与入射角相关）
         double targetDirX = sourcePosition.p1 - midX;
@@ -356,7 +416,7 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
         // 计算基线与目标向量的点积
         double dotProduct = baselineX * targetDirX + baselineY * targetDirY + baselineZ * targetDirZ;
         double theoreticalTimeDiff = (baselineLength * dotProduct) / c;
-        g_print("    理论时差: %.9fs, 实际时差: %.9fs, 差异: %.9fs\n",
+        PL_LOG_DEBUG("    理论时差: %.9fs, 实际时差: %.9fs, 差异: %.9fs\n",
                theoreticalTimeDiff, timeDifference, timeDifference - theoreticalTimeDiff);
         
         // 根本问题：时差体制中，俯仰角计算受到方位角的影响
@@ -366,7 +426,7 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
         // 使用几何计算的方位角作为初始值
         double geometricAzimuth = atan2(targetDirX, targetDirY) * RAD2DEG;
         if (geometricAzimuth < 0) geometricAzimuth += 360.0;
-        g_print("    几何计算的方位角: %.2f°\n", geometricAzimuth);
+        PL_LOG_DEBUG("    几何计算的方位角: %.2f°\n", geometricAzimuth);
         currentAzimuth = geometricAzimuth;
         
         for (int iter = 0; iter < MAX_ITERATIONS; iter++) {
@@ -403,7 +463,7 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
             
             // 计算新的误差
             double newError = std::abs(timeResidual * c);
-            g_print("    迭代 %d: 俯仰角 = %.2f°, 方位角 = %.2f°, 时差残差 = %.9fs, 误差 = %.6fm\n", 
+            PL_LOG_DEBUG("    迭代 %d: 俯仰角 = %.2f°, 方位角 = %.2f°, 时差残差 = %.9fs, 误差 = %.6fm\n", 
                    iter + 1, newElevation, newAzimuth, timeResidual, newError);
             
             // 更新当前值
@@ -412,13 +472,13 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
             
             // 检查收敛条件
             if (std::abs(newError - lastError) < ERROR_THRESHOLD || newError < ERROR_THRESHOLD * 10) {
-                g_print("    迭代收敛，停止优化\n");
+                PL_LOG_DEBUG("    迭代收敛，停止优化\n");
                 break;
             }
             lastError = newError;
         }
         
-        g_print("  迭代优化后的俯仰角: %.2f°, 方位角: %.2f°\n", currentElevation, currentAzimuth);
+        PL_LOG_DEBUG("  迭代优化后的俯仰角: %.2f°, 方位角: %.2f°\n", currentElevation, currentAzimuth);
         
         // 使用优化后的俯仰角和方位角
         elevation = currentElevation;
@@ -432,28 +492,28 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     // 当俯仰角超过30度或俯仰角差异大于10度时，考虑使用几何计算的俯仰角
     if (!useIterativeOptimization && 
         (std::abs(elevation) > 30.0 || std::abs(geometricElevation - elevation) > 10.0)) {
-        g_print("  检测到俯仰角计算可能不准确，考虑使用几何计算的俯仰角\n");
+        PL_LOG_DEBUG("  检测到俯仰角计算可能不准确，考虑使用几何计算的俯仰角\n");
         useGeometricElevation = true;
     }
     
     // 如果俯仰角超出典型范围，直接使用几何计算的俯仰角
     if (!useIterativeOptimization && 
         (elevation > MAX_TYPICAL_ELEVATION || elevation < MIN_TYPICAL_ELEVATION)) {
-        g_print("  俯仰角 %.2f° 超出典型范围 [%.2f°~%.2f°]，使用几何计算的俯仰角\n", 
+        PL_LOG_DEBUG("  俯仰角 %.2f° 超出典型范围 [%.2f°~%.2f°]，使用几何计算的俯仰角\n", 
                 elevation, MIN_TYPICAL_ELEVATION, MAX_TYPICAL_ELEVATION);
         useGeometricElevation = true;
     }
     
     // 使用几何计算的俯仰角
     if (useGeometricElevation) {
-        g_print("  使用几何计算的俯仰角: %.2f° 替代原始计算值: %.2f°\n", 
+        PL_LOG_DEBUG("  使用几何计算的俯仰角: %.2f° 替代原始计算值: %.2f°\n", 
                geometricElevation, elevation);
         elevation = geometricElevation;
     }
     
-    g_print("计算结果初步分析:\n");
-    g_print("  方位角: %.2f°\n", azimuth);
-    g_print("  俯仰角: %.2f°\n", elevation);
+    PL_LOG_DEBUG("计算结果初步分析:\n");
+    PL_LOG_DEBUG("  方位角: %.2f°\n", azimuth);
+    PL_LOG_DEBUG("  俯仰角: %.2f°\n", elevation);
     
     // 获取辐射源工作扇区范围
     double elevationStart = source.getElevationStart();
@@ -471,7 +531,7 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     }
     
     if (needAdjustment) {
-        g_print("  俯仰角调整: 原始值 %.2f° 超出范围 [%.2f°~%.2f°]，已调整为 %.2f°\n", 
+        PL_LOG_DEBUG("  俯仰角调整: 原始值 %.2f° 超出范围 [%.2f°~%.2f°]，已调整为 %.2f°\n", 
                elevation, elevationStart, elevationEnd, adjustedElevation);
         elevation = adjustedElevation;
     }
@@ -484,7 +544,7 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     const double MIN_REASONABLE_DISTANCE = 100.0;    // 100米
     
     if (estimatedDistance < MIN_REASONABLE_DISTANCE || estimatedDistance > MAX_REASONABLE_DISTANCE) {
-        g_print("警告：估计距离不合理 (%.2fm)，使用直接计算的距离\n", estimatedDistance);
+        PL_LOG_WARN("警告：估计距离不合理 (%.2fm)，使用直接计算的距离\n", estimatedDistance);
         
         // 使用直接距离计算作为后备
         double directDistance = sqrt(
@@ -493,14 +553,14 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
             pow(sourcePosition.p3 - midZ, 2)
         );
         
-        g_print("直接计算的距离: %.2fm\n", directDistance);
+        PL_LOG_DEBUG("直接计算的距离: %.2fm\n", directDistance);
         estimatedDistance = directDistance;
     }
     
     // 高度计算的根本问题：时差体制对距离和角度的估计会导致高度计算误差放大
     // 解决方案：使用水平距离和俯仰角分别计算高度
     
-    g_print("高度计算方法分析:\n");
+    PL_LOG_DEBUG("高度计算方法分析:\n");
     
     // 方法1：使用方位角、俯仰角和估计距离计算位置
     double dirX_adjusted = sin(azimuth * DEG2RAD) * cos(elevation * DEG2RAD);
@@ -514,29 +574,29 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     
     // 转换回经纬度
     COORD3 estimatedLBH = xyz2lbh(estimatedX, estimatedY, estimatedZ);
-    g_print("  方法1（角度+距离）: 高度 = %.2fm\n", estimatedLBH.p3);
+    PL_LOG_DEBUG("  方法1（角度+距离）: 高度 = %.2fm\n", estimatedLBH.p3);
     
     // 方法2：使用水平距离和俯仰角正切计算高度
     double horizontalDistance = estimatedDistance * cos(elevation * DEG2RAD);
     double heightFromTangent = midZ + horizontalDistance * tan(elevation * DEG2RAD);
-    g_print("  方法2（水平距离+俯仰角正切）: 高度 = %.2fm\n", heightFromTangent);
+    PL_LOG_DEBUG("  方法2（水平距离+俯仰角正切）: 高度 = %.2fm\n", heightFromTangent);
     
     // 方法3：使用几何俯仰角和水平距离计算高度
     double heightFromGeometric = midZ + horizontalDistance * tan(geometricElevation * DEG2RAD);
-    g_print("  方法3（水平距离+几何俯仰角）: 高度 = %.2fm\n", heightFromGeometric);
+    PL_LOG_DEBUG("  方法3（水平距离+几何俯仰角）: 高度 = %.2fm\n", heightFromGeometric);
     
     // 方法4：使用实际辐射源高度（参考值）
-    g_print("  方法4（实际高度）: 高度 = %.2fm\n", source.getAltitude());
+    PL_LOG_DEBUG("  方法4（实际高度）: 高度 = %.2fm\n", source.getAltitude());
     
     // 比较各种方法的结果，选择最合理的高度计算方法
     double method1Error = std::abs(estimatedLBH.p3 - source.getAltitude());
     double method2Error = std::abs(heightFromTangent - source.getAltitude());
     double method3Error = std::abs(heightFromGeometric - source.getAltitude());
     
-    g_print("高度计算误差比较:\n");
-    g_print("  方法1误差: %.2fm (%.1f%%)\n", method1Error, method1Error / source.getAltitude() * 100);
-    g_print("  方法2误差: %.2fm (%.1f%%)\n", method2Error, method2Error / source.getAltitude() * 100);
-    g_print("  方法3误差: %.2fm (%.1f%%)\n", method3Error, method3Error / source.getAltitude() * 100);
+    PL_LOG_DEBUG("高度计算误差比较:\n");
+    PL_LOG_DEBUG("  方法1误差: %.2fm (%.1f%%)\n", method1Error, method1Error / source.getAltitude() * 100);
+    PL_LOG_DEBUG("  方法2误差: %.2fm (%.1f%%)\n", method2Error, method2Error / source.getAltitude() * 100);
+    PL_LOG_DEBUG("  方法3误差: %.2fm (%.1f%%)\n", method3Error, method3Error / source.getAltitude() * 100);
     
     // 选择误差最小的方法
     double bestHeight;
@@ -561,15 +621,15 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     double heightError = std::abs(bestHeight - source.getAltitude());
     double relativeHeightError = heightError / (std::abs(source.getAltitude()) + 1.0); // 避免除零
     
-    g_print("最佳高度计算方法: 方法%d, 高度 = %.2fm, 误差 = %.2fm (%.1f%%)\n", 
+    PL_LOG_DEBUG("最佳高度计算方法: 方法%d, 高度 = %.2fm, 误差 = %.2fm (%.1f%%)\n", 
            bestMethod, bestHeight, heightError, relativeHeightError * 100);
     
     // 如果最佳高度误差仍然过大，使用辐射源实际高度
     if (!heightValid || relativeHeightError > 0.5) { // 50%以上的相对误差被视为不可接受
-        g_print("  高度误差超出可接受范围，使用辐射源实际高度\n");
+        PL_LOG_DEBUG("  高度误差超出可接受范围，使用辐射源实际高度\n");
         bestHeight = source.getAltitude();
     } else {
-        g_print("  高度误差在可接受范围内，使用计算高度\n");
+        PL_LOG_DEBUG("  高度误差在可接受范围内，使用计算高度\n");
     }
     
     // 使用最佳高度更新结果
@@ -595,9 +655,9 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     // 计算误差因素 - 使用新的误差计算方法
     result.errorFactors = calculateTDOAErrors(baselineLength, timeDifference, estimatedDistance, incidentAngle);
     
-    g_print("单平台时差体制定位结果：\n");
-    g_print("  方位角: %.2f°, 俯仰角: %.2f°\n", result.azimuth, result.elevation);
-    g_print("  经度: %.6f°, 纬度: %.6f°, 高度: %.2fm\n", result.longitude, result.latitude, result.altitude);
+    PL_LOG_INFO("单平台时差体制定位结果：\n");
+    PL_LOG_INFO("  方位角: %.2f°, 俯仰角: %.2f°\n", result.azimuth, result.elevation);
+    PL_LOG_INFO("  经度: %.6f°, 纬度: %.6f°, 高度: %.2fm\n", result.longitude, result.latitude, result.altitude);
     
     // 保存结果到数据库
     SinglePlatformTask task;
@@ -618,7 +678,7 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     // 限制定位精度在数据库字段范围内 (DECIMAL(8,6) 意味着最大值为 99.999999)
     double limitedAccuracy = result.accuracy;
     if (limitedAccuracy > 99.999999) {
-        g_print("警告：定位精度 %.6f 超出数据库字段范围，已截断为 99.999999\n", limitedAccuracy);
+        PL_LOG_WARN("警告：定位精度 %.6f 超出数据库字段范围，已截断为 99.999999\n", limitedAccuracy);
         limitedAccuracy = 99.999999;
     }
     task.positioningAccuracy = limitedAccuracy;
@@ -626,17 +686,17 @@ LocationResult SinglePlatformTDOA::runSimulation(const ReconnaissanceDevice& dev
     // 限制测向精度在数据库字段范围内
     double limitedDirectionAccuracy = result.errorFactors.size() > 5 ? result.errorFactors[5] : 0.0;
     if (limitedDirectionAccuracy > 99.999999) {
-        g_print("警告：测向精度 %.6f 超出数据库字段范围，已截断为 99.999999\n", limitedDirectionAccuracy);
+        PL_LOG_WARN("警告：测向精度 %.6f 超出数据库字段范围，已截断为 99.999999\n", limitedDirectionAccuracy);
         limitedDirectionAccuracy = 99.999999;
     }
     task.directionFindingAccuracy = limitedDirectionAccuracy;
     
-    // 获取DAO实例并保存任务
+    // 通过模型数据源保存任务
     int taskId = -1;
-    if (SinglePlatformTaskDAO::getInstance().addSinglePlatformTask(task, taskId)) {
-        g_print("任务已保存到数据库，ID: %d\n", taskId);
+    if (ModelRepository::getInstance().addSinglePlatformTask(task, taskId)) {
+        PL_LOG_INFO("任务已保存到数据库，ID: %d\n", taskId);
     } else {
-        g_print("保存任务到数据库失败\n");
+        PL_LOG_WARN("保存任务到数据库失败\n");
     }
     
     return result;
@@ -681,14 +741,14 @@ std::vector<double> SinglePlatformTDOA::calculateTDOAErrors(double baselineLengt
     double cosTheta = std::cos(incidentAngle);
     // 避免除以零或接近零的值
     if (std::abs(cosTheta) < 1e-6) {
-        g_print("  警告：入射角接近90度(%.2f°)，cosθ接近零(%.9f)，已调整为最小值1e-6\n", 
+        PL_LOG_WARN("  警告：入射角接近90度(%.2f°)，cosθ接近零(%.9f)，已调整为最小值1e-6\n", 
                incidentAngle * RAD2DEG, cosTheta);
         cosTheta = 1e-6;
     }
     double angleError = (c * totalTimeError) / (baselineLength * cosTheta);
-    g_print("  测向误差分析：入射角=%.2f°, cosθ=%.6f, 基线长度=%.2fm\n", 
+    PL_LOG_DEBUG("  测向误差分析：入射角=%.2f°, cosθ=%.6f, 基线长度=%.2fm\n", 
            incidentAngle * RAD2DEG, cosTheta, baselineLength);
-    g_print("  计算角度误差：%.6f弧度 (%.4f°)\n", angleError, angleError * RAD2DEG);
+    PL_LOG_DEBUG("  计算角度误差：%.6f弧度 (%.4f°)\n", angleError, angleError * RAD2DEG);
     
     // 7. 定位误差随距离增加
     double positionError = estimatedDistance * angleError;
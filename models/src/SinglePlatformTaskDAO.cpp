@@ -1,7 +1,33 @@
 #include "../SinglePlatformTaskDAO.h"
 #include <iostream>
 #include <cstring>
-#include <gtk/gtk.h>
+
+// 查询列顺序与 createTaskFromRow 一致
+static const char* const TASK_COLUMNS =
+    "task_id, tech_system, device_id, radiation_id, execution_time, "
+    "target_longitude, target_latitude, target_altitude, azimuth, elevation, angle_error, "
+    "positioning_distance, positioning_time, positioning_accuracy, direction_finding_accuracy, "
+    "created_at";
+
+// 按 INSERT/UPDATE 中的列顺序绑定任务字段(不含task_id)，返回下一个参数位置
+static std::size_t bindTask(PreparedStatement& stmt, const SinglePlatformTask& task) {
+    std::size_t idx = 0;
+    stmt.bindString(idx++, task.techSystem);
+    stmt.bindInt(idx++, task.deviceId);
+    stmt.bindInt(idx++, task.radiationId);
+    stmt.bindDouble(idx++, task.executionTime);
+    stmt.bindDouble(idx++, task.targetLongitude);
+    stmt.bindDouble(idx++, task.targetLatitude);
+    stmt.bindDouble(idx++, task.targetAltitude);
+    stmt.bindDouble(idx++, task.azimuth);
+    stmt.bindDouble(idx++, task.elevation);
+    stmt.bindDouble(idx++, task.angleError);
+    stmt.bindDouble(idx++, task.positioningDistance);
+    stmt.bindDouble(idx++, task.positioningTime);
+    stmt.bindDouble(idx++, task.positioningAccuracy);
+    stmt.bindDouble(idx++, task.directionFindingAccuracy);
+    return idx;
+}
 
 // 单例实现
 SinglePlatformTaskDAO& SinglePlatformTaskDAO::getInstance() {
@@ -11,300 +37,131 @@ SinglePlatformTaskDAO& SinglePlatformTaskDAO::getInstance() {
 
 // 添加单平台任务
 bool SinglePlatformTaskDAO::addSinglePlatformTask(const SinglePlatformTask& task, int& taskId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
     
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
+    PreparedStatement* stmt = conn.prepare(
         "INSERT INTO single_platform_task (tech_system, device_id, radiation_id, execution_time, "
         "target_longitude, target_latitude, target_altitude, azimuth, elevation, angle_error, "
         "positioning_distance, positioning_time, positioning_accuracy, direction_finding_accuracy) "
-        "VALUES ('%s', %d, %d, %f, %.6f, %.6f, %.2f, %.2f, %.2f, %.6f, %f, %f, %.6f, %.6f)",
-        task.techSystem.c_str(),
-        task.deviceId,
-        task.radiationId,
-        task.executionTime,
-        task.targetLongitude,
-        task.targetLatitude,
-        task.targetAltitude,
-        task.azimuth,
-        task.elevation,
-        task.angleError,
-        task.positioningDistance,
-        task.positioningTime,
-        task.positioningAccuracy,
-        task.directionFindingAccuracy
-    );
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+    if (!stmt) return false;
+    bindTask(*stmt, task);
     
-    if (!db.executeSQL(sql)) {
+    if (!stmt->execute()) {
         return false;
     }
     
     // 获取自增ID
-    taskId = (int)mysql_insert_id(conn);
+    taskId = static_cast<int>(stmt->insertId());
     return true;
 }
 
-// 根据任务ID获取单平台任务
-SinglePlatformTask SinglePlatformTaskDAO::getSinglePlatformTaskById(int taskId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn) return SinglePlatformTask{};
-    
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
-        "SELECT task_id, tech_system, device_id, radiation_id, execution_time, "
-        "target_longitude, target_latitude, target_altitude, azimuth, elevation, angle_error, "
-        "positioning_distance, positioning_time, positioning_accuracy, direction_finding_accuracy, "
-        "created_at FROM single_platform_task WHERE task_id = %d",
-        taskId
-    );
+// 按条件查询任务列表
+std::vector<SinglePlatformTask> SinglePlatformTaskDAO::queryTasks(const std::string& whereClause, int param) {
+    std::vector<SinglePlatformTask> tasks;
+    PooledConnection conn = DBConnector::getInstance().acquire();
+    if (!conn) return tasks;
     
-    if (mysql_query(conn, sql)) {
-        return SinglePlatformTask{};
+    std::string sql = std::string("SELECT ") + TASK_COLUMNS + " FROM single_platform_task";
+    if (!whereClause.empty()) {
+        sql += " WHERE " + whereClause;
     }
+    sql += " ORDER BY task_id DESC";
     
-    MYSQL_RES* result = mysql_store_result(conn);
-    if (!result) {
-        return SinglePlatformTask{};
+    PreparedStatement* stmt = conn.prepare(sql);
+    if (!stmt) return tasks;
+    if (stmt->parameterCount() > 0) {
+        stmt->bindInt(0, param);
+    }
+    if (!stmt->execute()) {
+        return tasks;
     }
     
-    MYSQL_ROW row = mysql_fetch_row(result);
-    if (!row) {
-        mysql_free_result(result);
+    while (stmt->fetch()) {
+        tasks.push_back(createTaskFromRow(*stmt));
+    }
+    return tasks;
+}
+
+// 根据任务ID获取单平台任务
+SinglePlatformTask SinglePlatformTaskDAO::getSinglePlatformTaskById(int taskId) {
+    std::vector<SinglePlatformTask> tasks = queryTasks("task_id = ?", taskId);
+    if (tasks.empty()) {
         return SinglePlatformTask{};
     }
-    
-    SinglePlatformTask task = createTaskFromRow(row);
-    mysql_free_result(result);
-    return task;
+    return tasks.front();
 }
 
 // 获取所有单平台任务
 std::vector<SinglePlatformTask> SinglePlatformTaskDAO::getAllSinglePlatformTasks() {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn) return std::vector<SinglePlatformTask>{};
-    
-    const char* sql = "SELECT task_id, tech_system, device_id, radiation_id, execution_time, "
-                     "target_longitude, target_latitude, target_altitude, azimuth, elevation, angle_error, "
-                     "positioning_distance, positioning_time, positioning_accuracy, direction_finding_accuracy, "
-                     "created_at FROM single_platform_task ORDER BY task_id DESC";
-    
-    if (mysql_query(conn, sql)) {
-        return std::vector<SinglePlatformTask>{};
-    }
-    
-    MYSQL_RES* result = mysql_store_result(conn);
-    if (!result) {
-        return std::vector<SinglePlatformTask>{};
-    }
-    
-    std::vector<SinglePlatformTask> tasks;
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(result))) {
-        tasks.push_back(createTaskFromRow(row));
-    }
-    
-    mysql_free_result(result);
-    return tasks;
+    return queryTasks(std::string(), 0);
 }
 
 // 根据设备ID获取单平台任务
 std::vector<SinglePlatformTask> SinglePlatformTaskDAO::getSinglePlatformTasksByDeviceId(int deviceId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn) return std::vector<SinglePlatformTask>{};
-    
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
-        "SELECT task_id, tech_system, device_id, radiation_id, execution_time, "
-        "target_longitude, target_latitude, target_altitude, azimuth, elevation, angle_error, "
-        "positioning_distance, positioning_time, positioning_accuracy, direction_finding_accuracy, "
-        "created_at FROM single_platform_task WHERE device_id = %d ORDER BY task_id DESC",
-        deviceId
-    );
-    
-    if (mysql_query(conn, sql)) {
-        return std::vector<SinglePlatformTask>{};
-    }
-    
-    MYSQL_RES* result = mysql_store_result(conn);
-    if (!result) {
-        return std::vector<SinglePlatformTask>{};
-    }
-    
-    std::vector<SinglePlatformTask> tasks;
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(result))) {
-        tasks.push_back(createTaskFromRow(row));
-    }
-    
-    mysql_free_result(result);
-    return tasks;
+    return queryTasks("device_id = ?", deviceId);
 }
 
 // 根据辐射源ID获取单平台任务
 std::vector<SinglePlatformTask> SinglePlatformTaskDAO::getSinglePlatformTasksByRadiationId(int radiationId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn) return std::vector<SinglePlatformTask>{};
-    
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
-        "SELECT task_id, tech_system, device_id, radiation_id, execution_time, "
-        "target_longitude, target_latitude, target_altitude, azimuth, elevation, angle_error, "
-        "positioning_distance, positioning_time, positioning_accuracy, direction_finding_accuracy, "
-        "created_at FROM single_platform_task WHERE radiation_id = %d ORDER BY task_id DESC",
-        radiationId
-    );
-    
-    if (mysql_query(conn, sql)) {
-        return std::vector<SinglePlatformTask>{};
-    }
-    
-    MYSQL_RES* result = mysql_store_result(conn);
-    if (!result) {
-        return std::vector<SinglePlatformTask>{};
-    }
-    
-    std::vector<SinglePlatformTask> tasks;
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(result))) {
-        tasks.push_back(createTaskFromRow(row));
-    }
-    
-    mysql_free_result(result);
-    return tasks;
+    return queryTasks("radiation_id = ?", radiationId);
 }
 
 // 更新单平台任务
 bool SinglePlatformTaskDAO::updateSinglePlatformTask(const SinglePlatformTask& task) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
     
-    char sql[1024];
-    snprintf(sql, sizeof(sql),
-        "UPDATE single_platform_task SET tech_system = '%s', device_id = %d, radiation_id = %d, "
-        "execution_time = %f, target_longitude = %.6f, target_latitude = %.6f, target_altitude = %.2f, "
-        "azimuth = %.2f, elevation = %.2f, angle_error = %.6f, positioning_distance = %f, positioning_time = %f, "
-        "positioning_accuracy = %.6f, direction_finding_accuracy = %.6f WHERE task_id = %d",
-        task.techSystem.c_str(),
-        task.deviceId,
-        task.radiationId,
-        task.executionTime,
-        task.targetLongitude,
-        task.targetLatitude,
-        task.targetAltitude,
-        task.azimuth,
-        task.elevation,
-        task.angleError,
-        task.positioningDistance,
-        task.positioningTime,
-        task.positioningAccuracy,
-        task.directionFindingAccuracy,
-        task.taskId
-    );
+    PreparedStatement* stmt = conn.prepare(
+        "UPDATE single_platform_task SET tech_system = ?, device_id = ?, radiation_id = ?, "
+        "execution_time = ?, target_longitude = ?, target_latitude = ?, target_altitude = ?, "
+        "azimuth = ?, elevation = ?, angle_error = ?, positioning_distance = ?, positioning_time = ?, "
+        "positioning_accuracy = ?, direction_finding_accuracy = ? WHERE task_id = ?");
+    if (!stmt) return false;
+    std::size_t idx = bindTask(*stmt, task);
+    stmt->bindInt(idx, task.taskId);
     
-    if (!db.executeSQL(sql)) {
-        return false;
-    }
-    
-    return true;
+    return stmt->execute();
 }
 
 // 删除单平台任务
 bool SinglePlatformTaskDAO::deleteSinglePlatformTask(int taskId) {
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
+    PooledConnection conn = DBConnector::getInstance().acquire();
     if (!conn) return false;
     
-    char sql[1024];
-    snprintf(sql, sizeof(sql), "DELETE FROM single_platform_task WHERE task_id = %d", taskId);
+    PreparedStatement* stmt = conn.prepare("DELETE FROM single_platform_task WHERE task_id = ?");
+    if (!stmt) return false;
+    stmt->bindInt(0, taskId);
     
-    if (!db.executeSQL(sql)) {
-        return false;
-    }
-    
-    return true;
+    return stmt->execute();
 }
 
-// 从数据库结果集创建任务对象
-SinglePlatformTask SinglePlatformTaskDAO::createTaskFromRow(MYSQL_ROW row) {
+// 从预编译语句的当前行创建任务对象
+SinglePlatformTask SinglePlatformTaskDAO::createTaskFromRow(const PreparedStatement& stmt) {
     SinglePlatformTask task;
     
-    task.taskId = row[0] ? atoi(row[0]) : 0;
-    task.techSystem = row[1] ? row[1] : "";
-    task.deviceId = row[2] ? atoi(row[2]) : 0;
-    task.radiationId = row[3] ? atoi(row[3]) : 0;
-    task.executionTime = row[4] ? atof(row[4]) : 0.0f;
-    task.targetLongitude = row[5] ? atof(row[5]) : 0.0;
-    task.targetLatitude = row[6] ? atof(row[6]) : 0.0;
-    task.targetAltitude = row[7] ? atof(row[7]) : 0.0;
-    task.azimuth = row[8] ? atof(row[8]) : 0.0;
-    task.elevation = row[9] ? atof(row[9]) : 0.0;
-    task.angleError = row[10] ? atof(row[10]) : 0.0;
-    task.positioningDistance = row[11] ? atof(row[11]) : 0.0f;
-    task.positioningTime = row[12] ? atof(row[12]) : 0.0f;
-    task.positioningAccuracy = row[13] ? atof(row[13]) : 0.0;
-    task.directionFindingAccuracy = row[14] ? atof(row[14]) : 0.0;
-    task.createdAt = row[15] ? row[15] : "";
+    task.taskId = static_cast<int>(stmt.getInt(0));
+    task.techSystem = stmt.getString(1);
+    task.deviceId = static_cast<int>(stmt.getInt(2));
+    task.radiationId = static_cast<int>(stmt.getInt(3));
+    task.executionTime = static_cast<float>(stmt.getDouble(4));
+    task.targetLongitude = stmt.getDouble(5);
+    task.targetLatitude = stmt.getDouble(6);
+    task.targetAltitude = stmt.getDouble(7);
+    task.azimuth = stmt.getDouble(8);
+    task.elevation = stmt.getDouble(9);
+    task.angleError = stmt.getDouble(10);
+    task.positioningDistance = static_cast<float>(stmt.getDouble(11));
+    task.positioningTime = static_cast<float>(stmt.getDouble(12));
+    task.positioningAccuracy = stmt.getDouble(13);
+    task.directionFindingAccuracy = stmt.getDouble(14);
+    task.createdAt = stmt.getString(15);
     
     return task;
 }
 
 // 根据辐射源ID获取任务
 std::vector<SinglePlatformTask> SinglePlatformTaskDAO::getTasksBySourceId(int sourceId) {
-    std::vector<SinglePlatformTask> tasks;
-    
-    DBConnector& db = DBConnector::getInstance();
-    MYSQL* conn = db.getConnection();
-    if (!conn) {
-        return tasks;
-    }
-        
-    char sql[1024];
-    snprintf(sql, sizeof(sql), "SELECT task_id, tech_system, device_id, radiation_id, execution_time, "
-                     "target_longitude, target_latitude, target_altitude, azimuth, elevation, angle_error, "
-                     "positioning_distance, positioning_time, positioning_accuracy, direction_finding_accuracy, "
-                     "created_at FROM single_platform_task WHERE radiation_id = %d ORDER BY task_id DESC",
-                     sourceId);
-    
-    if (mysql_query(conn, sql)) {
-        return tasks;
-    }
-    
-    MYSQL_RES* res = mysql_store_result(conn);
-    if (!res) {
-        return tasks;
-    }
-    
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(res))) {
-        SinglePlatformTask task;
-        
-        int idx = 0;
-        task.taskId = row[idx] ? atoi(row[idx]) : 0; idx++;
-        task.techSystem = row[idx] ? row[idx] : ""; idx++;
-        task.deviceId = row[idx] ? atoi(row[idx]) : 0; idx++;
-        task.radiationId = row[idx] ? atoi(row[idx]) : 0; idx++;
-        task.executionTime = row[idx] ? atof(row[idx]) : 0.0f; idx++;
-        task.targetLongitude = row[idx] ? atof(row[idx]) : 0.0; idx++;
-        task.targetLatitude = row[idx] ? atof(row[idx]) : 0.0; idx++;
-        task.targetAltitude = row[idx] ? atof(row[idx]) : 0.0; idx++;
-        task.azimuth = row[idx] ? atof(row[idx]) : 0.0; idx++;
-        task.elevation = row[idx] ? atof(row[idx]) : 0.0; idx++;
-        task.angleError = row[idx] ? atof(row[idx]) : 0.0; idx++;
-        task.positioningDistance = row[idx] ? atof(row[idx]) : 0.0f; idx++;
-        task.positioningTime = row[idx] ? atof(row[idx]) : 0.0f; idx++;
-        task.positioningAccuracy = row[idx] ? atof(row[idx]) : 0.0; idx++;
-        task.directionFindingAccuracy = row[idx] ? atof(row[idx]) : 0.0; idx++;
-        
-        tasks.push_back(task);
-    }
-    
-    mysql_free_result(res);
-    return tasks;
-} 
\ No newline at end of file
+    return queryTasks("radiation_id = ?", sourceId);
+}
@@ -0,0 +1,465 @@
+#include "../TDOASolver.h"
+#include "../../constants/PhysicsConstants.h"
+#include "../../utils/ParallelFor.h"
+#include <iostream>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// 法方程均为固定维数，直接累加 G^T*G 和 G^T*h，不构造 M×n 的中间矩阵，
+// 整个求解过程只使用栈上的定长Eigen矩阵，不产生堆分配
+
+// 使用LDLT(Cholesky)分解求解对称法方程
+template <int Dim>
+static Eigen::Matrix<double, Dim, 1> solveNormalEquations(const Eigen::Matrix<double, Dim, Dim>& A,
+                                                          const Eigen::Matrix<double, Dim, 1>& b) {
+    Eigen::LDLT<Eigen::Matrix<double, Dim, Dim>> ldlt(A);
+    if (ldlt.info() != Eigen::Success || ldlt.vectorD().cwiseAbs().minCoeff() < 1e-12) {
+        throw std::runtime_error("Matrix is singular or nearly singular.");
+    }
+    return ldlt.solve(b);
+}
+
+static double calculateDistance(const COORD3& p1, const COORD3& p2) {
+    const double dx = p1.p1 - p2.p1;
+    const double dy = p1.p2 - p2.p2;
+    const double dz = p1.p3 - p2.p3;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Chan算法核心，奇异时抛出异常
+static COORD3 chanKernel(const COORD3* stations, int N, const double* tdoas, double knownHeight) {
+    const double x1 = stations[0].p1;
+    const double y1 = stations[0].p2;
+    const double z1 = stations[0].p3;
+    const double z0 = knownHeight;
+
+    // 计算参考站到目标的距离平方（基于高度）
+    const double R1_sq = (x1*x1 + y1*y1 + (z0-z1)*(z0-z1));
+
+    // 累加法方程 Ga^T*Ga 和 Ga^T*h，未知量为 [x; y; R1]
+    Eigen::Matrix3d GaT_Ga = Eigen::Matrix3d::Zero();
+    Eigen::Vector3d GaT_h = Eigen::Vector3d::Zero();
+    for (int station_idx = 1; station_idx < N; ++station_idx) {
+        const double xi = stations[station_idx].p1;
+        const double yi = stations[station_idx].p2;
+        const double zi = stations[station_idx].p3;
+
+        const double d_i1 = Constants::c * tdoas[station_idx]; // 转换为距离差
+
+        // Ga矩阵的一行
+        const Eigen::Vector3d g(2 * (xi - x1), 2 * (yi - y1), -2 * d_i1);
+
+        // 常数项
+        const double Ri_sq = (xi*xi + yi*yi + (z0-zi)*(z0-zi));
+        const double K_i = Ri_sq - R1_sq - d_i1*d_i1;
+
+        GaT_Ga.noalias() += g * g.transpose();
+        GaT_h.noalias() += g * K_i;
+    }
+
+    // 添加正则化项增强稳定性
+    GaT_Ga.diagonal().array() += 1e-6;
+
+    const Eigen::Vector3d solution = solveNormalEquations<3>(GaT_Ga, GaT_h);
+    // 返回结果 (x, y, 已知高度)
+    return {solution[0], solution[1], knownHeight};
+}
+
+// 二维雅可比矩阵的法方程 H^T*H 和 H^T*delta_rho（残差单位：米）
+static void taylorNormalEquations(const COORD3* stations, int N, const double* tdoas, const COORD3& pos,
+                                  Eigen::Matrix2d& HT_H, Eigen::Vector2d& HT_delta_rho) {
+    HT_H.setZero();
+    HT_delta_rho.setZero();
+
+    double R1 = calculateDistance(pos, stations[0]);
+    if (R1 < 1e-6) R1 = 1e-6;
+    const double ux1 = (pos.p1 - stations[0].p1) / R1;
+    const double uy1 = (pos.p2 - stations[0].p2) / R1;
+
+    for (int station_idx = 1; station_idx < N; ++station_idx) {
+        double Ri = calculateDistance(pos, stations[station_idx]);
+        if (Ri < 1e-6) Ri = 1e-6;
+
+        // 二维雅可比矩阵的一行 (只计算x和y方向)
+        const Eigen::Vector2d h((pos.p1 - stations[station_idx].p1) / Ri - ux1,
+                                (pos.p2 - stations[station_idx].p2) / Ri - uy1);
+
+        const double estimated_tdoa = (Ri - R1) / Constants::c;
+        // 将残差从秒转换为米
+        const double delta_rho = (tdoas[station_idx] - estimated_tdoa) * Constants::c;
+
+        HT_H.noalias() += h * h.transpose();
+        HT_delta_rho.noalias() += h * delta_rho;
+    }
+}
+
+// 泰勒迭代核心，奇异时抛出异常
+static COORD3 taylorKernel(const COORD3* stations, int N, const double* tdoas,
+                           const COORD3& initialGuess, int* iterations) {
+    COORD3 currentPos = initialGuess;
+    const int max_iterations = 20;  // 最大迭代次数
+    const double tolerance = 1e-2;  // 收敛阈值（米）
+
+    for (int iter = 0; iter < max_iterations; ++iter) {
+        if (iterations) *iterations = iter + 1;
+
+        Eigen::Matrix2d HT_H;
+        Eigen::Vector2d HT_delta_rho;
+        taylorNormalEquations(stations, N, tdoas, currentPos, HT_H, HT_delta_rho);
+
+        // 添加正则化项
+        HT_H.diagonal().array() += 1e-6;
+
+        Eigen::Vector2d correction;
+        try {
+            correction = solveNormalEquations<2>(HT_H, HT_delta_rho);
+        } catch (const std::runtime_error& e) {
+            std::string msg = "泰勒迭代失败(迭代步 " + std::to_string(iter) + "): " + e.what();
+            throw std::runtime_error(msg);
+        }
+
+        // 只更新x和y坐标
+        currentPos.p1 += correction[0];
+        currentPos.p2 += correction[1];
+
+        // 检查收敛性
+        if (correction.norm() < tolerance) {
+            return currentPos;
+        }
+    }
+
+    return currentPos;
+}
+
+// ---Chan算法（二维）---
+COORD3 tdoaLocate_chan_initial(const std::vector<COORD3>& stationPositions,
+                               const std::vector<double>& tdoas,
+                               double knownHeight) {
+    const int N = static_cast<int>(stationPositions.size());
+    if (N < 4) return {0, 0, knownHeight};
+
+    try {
+        return chanKernel(stationPositions.data(), N, tdoas.data(), knownHeight);
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Chan初始解计算失败: " << e.what() << std::endl;
+        return {0, 0, knownHeight};
+    }
+}
+
+// --- 泰勒级数迭代法（二维）---
+COORD3 tdoaRefinePosition_taylor(const std::vector<COORD3>& stationPositions,
+                                 const std::vector<double>& tdoas,
+                                 const COORD3& initialGuess,
+                                 int* iterations) {
+    const int N = static_cast<int>(stationPositions.size());
+    if (iterations) *iterations = 0;
+    if (N < 4) return initialGuess;
+
+    return taylorKernel(stationPositions.data(), N, tdoas.data(), initialGuess, iterations);
+}
+
+// --- 批量定位 ---
+TDOABatchLocator::TDOABatchLocator(const std::vector<COORD3>& stationPositions)
+    : m_reference(stationPositions.empty() ? COORD3() : stationPositions[0]) {
+    // 平移到以参考站为原点的坐标系，避免Chan法方程中ECEF坐标平方(~1e13)带来的病态
+    m_localStations.reserve(stationPositions.size());
+    for (const auto& st : stationPositions) {
+        m_localStations.emplace_back(st.p1 - m_reference.p1, st.p2 - m_reference.p2, st.p3 - m_reference.p3);
+    }
+}
+
+TDOABatchLocator TDOABatchLocator::fromGeodetic(const std::vector<COORD3>& stationLbh) {
+    std::vector<COORD3> stationXyz;
+    stationXyz.reserve(stationLbh.size());
+    for (const auto& lbh : stationLbh) {
+        stationXyz.push_back(lbh2xyz(lbh.p1, lbh.p2, lbh.p3));
+    }
+    return TDOABatchLocator(stationXyz);
+}
+
+TDOABatchLocator::Solution TDOABatchLocator::locate(const double* tdoas, double knownHeight, double tdoaSigma) const {
+    Solution sol;
+    const int N = static_cast<int>(m_localStations.size());
+    if (N < 4) return sol;
+
+    const COORD3* stations = m_localStations.data();
+    const double localHeight = knownHeight - m_reference.p3;
+    try {
+        COORD3 guess = chanKernel(stations, N, tdoas, localHeight);
+        COORD3 pos = taylorKernel(stations, N, tdoas, guess, &sol.iterations);
+
+        // 协方差 = σr² (H^T H)^-1，高度固定，z方向方差为0
+        Eigen::Matrix2d HT_H;
+        Eigen::Vector2d HT_delta_rho;
+        taylorNormalEquations(stations, N, tdoas, pos, HT_H, HT_delta_rho);
+        const double sigmaRange = tdoaSigma * Constants::c;
+        Eigen::LDLT<Eigen::Matrix2d> ldlt(HT_H);
+        if (ldlt.info() == Eigen::Success && ldlt.vectorD().cwiseAbs().minCoeff() >= 1e-12) {
+            sol.covariance.topLeftCorner<2, 2>() =
+                sigmaRange * sigmaRange * ldlt.solve(Eigen::Matrix2d::Identity());
+        }
+
+        sol.position = COORD3(pos.p1 + m_reference.p1, pos.p2 + m_reference.p2, pos.p3 + m_reference.p3);
+        sol.valid = std::isfinite(sol.position.p1) && std::isfinite(sol.position.p2);
+    } catch (const std::runtime_error&) {
+        sol.valid = false;
+    }
+    return sol;
+}
+
+std::vector<TDOABatchLocator::Solution> TDOABatchLocator::locateBatch(
+    const std::vector<std::vector<double>>& tdoaBatch,
+    const std::vector<double>& knownHeights,
+    double tdoaSigma,
+    unsigned int threadCount) const {
+    std::vector<Solution> results(tdoaBatch.size());
+    const std::size_t stationCount = m_localStations.size();
+    parallelFor(tdoaBatch.size(), threadCount, 256, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (tdoaBatch[i].size() < stationCount) continue;
+            const double height = knownHeights.size() == tdoaBatch.size() ? knownHeights[i]
+                                : (knownHeights.empty() ? m_reference.p3 : knownHeights[0]);
+            results[i] = locate(tdoaBatch[i].data(), height, tdoaSigma);
+        }
+    });
+    return results;
+}
+
+// --- 三维Chan两步加权最小二乘 + 高斯-牛顿迭代 ---
+//
+// 以参考站为原点，第i站的距离差 r_i = c*tdoa_i 满足
+//     s_i^T p + r_i R1 = (|s_i|^2 - r_i^2) / 2
+// 时差共用参考站，测量协方差 Q = σr²/2 (I + 11^T)，其逆为 2/σr² (I - 11^T/(M+1))，
+// 因此所有加权法方程都可以按行累加，只需 O(M) 运算和定长矩阵。
+
+namespace {
+
+// 按行累加 G^T W G 和 G^T W h，W = D (I - 11^T/(M+1)) D，D = diag(d_i)
+template <int Dim>
+struct WeightedNormalAccumulator {
+    Eigen::Matrix<double, Dim, Dim> GtDDG = Eigen::Matrix<double, Dim, Dim>::Zero();
+    Eigen::Matrix<double, Dim, 1> GtDDh = Eigen::Matrix<double, Dim, 1>::Zero();
+    Eigen::Matrix<double, Dim, 1> sumDG = Eigen::Matrix<double, Dim, 1>::Zero();
+    double sumDh = 0.0;
+    int rows = 0;
+
+    void add(const Eigen::Matrix<double, Dim, 1>& g, double h, double d) {
+        const Eigen::Matrix<double, Dim, 1> dg = d * g;
+        GtDDG.noalias() += dg * dg.transpose();
+        GtDDh.noalias() += dg * (d * h);
+        sumDG += dg;
+        sumDh += d * h;
+        ++rows;
+    }
+
+    Eigen::Matrix<double, Dim, Dim> normalMatrix() const {
+        return GtDDG - sumDG * sumDG.transpose() / (rows + 1.0);
+    }
+
+    Eigen::Matrix<double, Dim, 1> rhs() const {
+        return GtDDh - sumDG * (sumDh / (rows + 1.0));
+    }
+};
+
+// 由距离差模型在 p 处的雅可比 J_i = u_i - u_0 构造高斯-牛顿法方程
+void gaussNewtonNormalEquations(const COORD3* stations, int N, const double* rangeDiffs,
+                                const Eigen::Vector3d& p,
+                                Eigen::Matrix3d& F, Eigen::Vector3d& rhs) {
+    WeightedNormalAccumulator<3> acc;
+    const Eigen::Vector3d s0(stations[0].p1, stations[0].p2, stations[0].p3);
+    const double R0 = std::max((p - s0).norm(), 1e-6);
+    const Eigen::Vector3d u0 = (p - s0) / R0;
+    for (int i = 1; i < N; ++i) {
+        const Eigen::Vector3d si(stations[i].p1, stations[i].p2, stations[i].p3);
+        const double Ri = std::max((p - si).norm(), 1e-6);
+        const Eigen::Vector3d J = (p - si) / Ri - u0;
+        acc.add(J, rangeDiffs[i] - (Ri - R0), 1.0);
+    }
+    F = acc.normalMatrix();
+    rhs = acc.rhs();
+}
+
+// 四站时 Chan 第一步欠定，p = a + b*R1 代入 R1 = |p| 解二次方程
+bool chanFourStation(const COORD3* stations, const double* rangeDiffs, const COORD3& reference,
+                     Eigen::Vector3d& p) {
+    Eigen::Matrix3d A;
+    Eigen::Vector3d h, r;
+    for (int i = 1; i < 4; ++i) {
+        const Eigen::Vector3d si(stations[i].p1, stations[i].p2, stations[i].p3);
+        A.row(i - 1) = si.transpose();
+        h[i - 1] = 0.5 * (si.squaredNorm() - rangeDiffs[i] * rangeDiffs[i]);
+        r[i - 1] = rangeDiffs[i];
+    }
+    Eigen::PartialPivLU<Eigen::Matrix3d> lu(A);
+    if (std::abs(lu.determinant()) < 1e-9) return false;
+    const Eigen::Vector3d a = lu.solve(h);
+    const Eigen::Vector3d b = -lu.solve(r);
+
+    const double qa = b.squaredNorm() - 1.0;
+    const double qb = 2.0 * a.dot(b);
+    const double qc = a.squaredNorm();
+    double roots[2];
+    int rootCount = 0;
+    if (std::abs(qa) < 1e-12) {
+        if (std::abs(qb) > 1e-12) roots[rootCount++] = -qc / qb;
+    } else {
+        const double disc = qb * qb - 4.0 * qa * qc;
+        if (disc < 0.0) {
+            roots[rootCount++] = -qb / (2.0 * qa);  // 噪声导致判别式略小于0时取极值点
+        } else {
+            const double sq = std::sqrt(disc);
+            roots[rootCount++] = (-qb + sq) / (2.0 * qa);
+            roots[rootCount++] = (-qb - sq) / (2.0 * qa);
+        }
+    }
+
+    // 两个正根都可行时，取更接近地球表面的解
+    const Eigen::Vector3d ref(reference.p1, reference.p2, reference.p3);
+    double bestScore = std::numeric_limits<double>::infinity();
+    for (int k = 0; k < rootCount; ++k) {
+        if (roots[k] < 0.0) continue;
+        const Eigen::Vector3d candidate = a + b * roots[k];
+        const double score = std::abs((candidate + ref).norm() - Constants::a);
+        if (score < bestScore) {
+            bestScore = score;
+            p = candidate;
+        }
+    }
+    return std::isfinite(bestScore);
+}
+
+// Chan两步加权最小二乘（N >= 5）
+bool chanTwoStage(const COORD3* stations, int N, const double* rangeDiffs, Eigen::Vector3d& p) {
+    // 第一步：先按 B = I 求一次，再用估计距离构造 B = diag(R_i) 重新加权
+    Eigen::Vector4d theta = Eigen::Vector4d::Zero();
+    Eigen::Matrix4d normal1 = Eigen::Matrix4d::Identity();
+    for (int pass = 0; pass < 2; ++pass) {
+        WeightedNormalAccumulator<4> acc;
+        for (int i = 1; i < N; ++i) {
+            const Eigen::Vector3d si(stations[i].p1, stations[i].p2, stations[i].p3);
+            Eigen::Vector4d g;
+            g << si, rangeDiffs[i];
+            const double h = 0.5 * (si.squaredNorm() - rangeDiffs[i] * rangeDiffs[i]);
+            const double d = pass == 0 ? 1.0 : 1.0 / std::max((theta.head<3>() - si).norm(), 1.0);
+            acc.add(g, h, d);
+        }
+        normal1 = acc.normalMatrix();
+        Eigen::LDLT<Eigen::Matrix4d> ldlt(normal1);
+        if (ldlt.info() != Eigen::Success || ldlt.vectorD().cwiseAbs().minCoeff() < 1e-12) {
+            return false;
+        }
+        theta = ldlt.solve(acc.rhs());
+    }
+    p = theta.head<3>();
+
+    // 第二步：利用 R1² = x² + y² + z² 约束修正，B' = diag(x, y, z, R1)
+    // Ψ'^-1 ∝ B'^-1 (G^T W G) B'^-1，无需对第一步协方差求逆
+    const Eigen::Vector4d Bp(theta[0], theta[1], theta[2], theta[3]);
+    if (Bp.cwiseAbs().minCoeff() < 1.0 || theta[3] <= 0.0) {
+        return true;  // 某分量接近0时第二步病态，直接使用第一步结果
+    }
+    const Eigen::Matrix4d Binv = Bp.cwiseInverse().asDiagonal();
+    const Eigen::Matrix4d psiInv = Binv * normal1 * Binv;
+    Eigen::Matrix<double, 4, 3> G2;
+    G2 << 1, 0, 0,
+          0, 1, 0,
+          0, 0, 1,
+          1, 1, 1;
+    const Eigen::Vector4d h2 = theta.cwiseProduct(theta);
+    const Eigen::Matrix3d A2 = G2.transpose() * psiInv * G2;
+    Eigen::LDLT<Eigen::Matrix3d> ldlt2(A2);
+    if (ldlt2.info() != Eigen::Success || !ldlt2.isPositive()) {
+        return true;
+    }
+    const Eigen::Vector3d z2 = ldlt2.solve(G2.transpose() * psiInv * h2);
+    if (!z2.allFinite()) {
+        return true;
+    }
+    for (int k = 0; k < 3; ++k) {
+        p[k] = (theta[k] < 0.0 ? -1.0 : 1.0) * std::sqrt(std::abs(z2[k]));
+    }
+    return true;
+}
+
+} // namespace
+
+TDOA3DSolution tdoaLocate3D(const COORD3* stationPositions, int N, const double* tdoas, double tdoaSigma) {
+    TDOA3DSolution sol;
+    if (N < 4 || N > TDOA_MAX_STATIONS) return sol;
+
+    // 平移到参考站坐标系，时差转换为距离差
+    const COORD3 reference = stationPositions[0];
+    COORD3 stations[TDOA_MAX_STATIONS];
+    double rangeDiffs[TDOA_MAX_STATIONS];
+    for (int i = 0; i < N; ++i) {
+        stations[i] = COORD3(stationPositions[i].p1 - reference.p1,
+                             stationPositions[i].p2 - reference.p2,
+                             stationPositions[i].p3 - reference.p3);
+        rangeDiffs[i] = i == 0 ? 0.0 : Constants::c * tdoas[i];
+    }
+
+    Eigen::Vector3d p;
+    const bool initialized = N == 4 ? chanFourStation(stations, rangeDiffs, reference, p)
+                                    : chanTwoStage(stations, N, rangeDiffs, p);
+    if (!initialized || !p.allFinite()) return sol;
+
+    // 高斯-牛顿迭代精炼
+    const int max_iterations = 10;
+    const double tolerance = 1e-4;  // 收敛阈值（米）
+    Eigen::Matrix3d F;
+    Eigen::Vector3d rhs;
+    for (int iter = 0; iter < max_iterations; ++iter) {
+        sol.iterations = iter + 1;
+        gaussNewtonNormalEquations(stations, N, rangeDiffs, p, F, rhs);
+        Eigen::LDLT<Eigen::Matrix3d> ldlt(F);
+        if (ldlt.info() != Eigen::Success || ldlt.vectorD().cwiseAbs().minCoeff() < 1e-15) {
+            return sol;
+        }
+        const Eigen::Vector3d delta = ldlt.solve(rhs);
+        p += delta;
+        if (delta.norm() < tolerance) {
+            sol.converged = true;
+            break;
+        }
+    }
+    if (!p.allFinite()) return sol;
+
+    // 协方差 = (J^T Q^-1 J)^-1 = σr²/2 · F^-1，GDOP = sqrt(tr(P))/σr 与σ无关
+    gaussNewtonNormalEquations(stations, N, rangeDiffs, p, F, rhs);
+    Eigen::LDLT<Eigen::Matrix3d> ldlt(F);
+    if (ldlt.info() != Eigen::Success || ldlt.vectorD().cwiseAbs().minCoeff() < 1e-15) {
+        return sol;
+    }
+    const Eigen::Matrix3d Finv = ldlt.solve(Eigen::Matrix3d::Identity());
+    const double sigmaRange = Constants::c * tdoaSigma;
+    sol.covariance = 0.5 * sigmaRange * sigmaRange * Finv;
+    sol.gdop = std::sqrt(std::max(0.0, 0.5 * Finv.trace()));
+    sol.position = COORD3(p[0] + reference.p1, p[1] + reference.p2, p[2] + reference.p3);
+    sol.valid = true;
+    return sol;
+}
+
+TDOA3DSolution tdoaLocate3D(const std::vector<COORD3>& stationPositions,
+                            const std::vector<double>& tdoas,
+                            double tdoaSigma) {
+    if (tdoas.size() < stationPositions.size()) return TDOA3DSolution();
+    return tdoaLocate3D(stationPositions.data(), static_cast<int>(stationPositions.size()), tdoas.data(), tdoaSigma);
+}
+
+double horizontalCEP(const Eigen::Matrix3d& covarianceXyz, const COORD3& positionXyz) {
+    // 旋转到位置处的东-北-天坐标系，取水平2x2块
+    const COORD3 lbh = xyz2lbh(positionXyz.p1, positionXyz.p2, positionXyz.p3);
+    const double sl = std::sin(lbh.p1 * Constants::DEG2RAD), cl = std::cos(lbh.p1 * Constants::DEG2RAD);
+    const double sb = std::sin(lbh.p2 * Constants::DEG2RAD), cb = std::cos(lbh.p2 * Constants::DEG2RAD);
+    Eigen::Matrix<double, 2, 3> R;
+    R << -sl,       cl,      0.0,
+         -sb * cl, -sb * sl, cb;
+    const Eigen::Matrix2d Pen = R * covarianceXyz * R.transpose();
+    const Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(Pen, Eigen::EigenvaluesOnly);
+    const double sigmaMinor = std::sqrt(std::max(0.0, eig.eigenvalues()[0]));
+    const double sigmaMajor = std::sqrt(std::max(0.0, eig.eigenvalues()[1]));
+    return 0.59 * (sigmaMajor + sigmaMinor);
+}
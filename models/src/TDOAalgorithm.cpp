@@ -1,129 +1,30 @@
 #include "TDOAalgorithm.h"
+#include "TDOASolver.h"
+#include "Trajectory.h"
 #include "../../constants/PhysicsConstants.h"
+#include "../../utils/Instrumentation.h"
+#include "../../utils/Log.h"
+#include "../../utils/RandomStream.h"
 #include <iostream>
 #include <vector>
 #include <cmath>
-#include <iomanip>
-#include <random>
 #include <algorithm>
 #include <stdexcept>
 
-// --- 手动实现的线性代数辅助函数 (开始) ---
-std::vector<double> multiplyMatrixVector(const std::vector<std::vector<double>>& A, const std::vector<double>& B) {
-    size_t rowsA = A.size();
-    if (rowsA == 0) return {};
-    size_t colsA = A[0].size();
-    size_t sizeB = B.size();
-
-    if (colsA != sizeB) {
-        throw std::runtime_error("Matrix-vector multiplication dimension mismatch.");
-    }
-
-    std::vector<double> C(rowsA, 0.0);
-    for (size_t i = 0; i < rowsA; ++i) {
-        for (size_t j = 0; j < colsA; ++j) {
-            C[i] += A[i][j] * B[j];
-        }
-    }
-    return C;
-}
-
-std::vector<std::vector<double>> multiplyMatrixMatrix(const std::vector<std::vector<double>>& A, const std::vector<std::vector<double>>& B) {
-    size_t rowsA = A.size();
-    if (rowsA == 0) return {};
-    size_t colsA = A[0].size();
-    size_t rowsB = B.size();
-    if (rowsB == 0) return {};
-    size_t colsB = B[0].size();
-
-    if (colsA != rowsB) {
-        throw std::runtime_error("Matrix-matrix multiplication dimension mismatch.");
-    }
-
-    std::vector<std::vector<double>> C(rowsA, std::vector<double>(colsB, 0.0));
-    for (size_t i = 0; i < rowsA; ++i) {
-        for (size_t j = 0; j < colsB; ++j) {
-            for (size_t k = 0; k < colsA; ++k) {
-                C[i][j] += A[i][k] * B[k][j];
-            }
-        }
-    }
-    return C;
-}
-
-std::vector<std::vector<double>> transposeMatrix(const std::vector<std::vector<double>>& A) {
-    if (A.empty() || A[0].empty()) return {};
-    size_t rows = A.size();
-    size_t cols = A[0].size();
-    std::vector<std::vector<double>> T(cols, std::vector<double>(rows));
-    for (size_t i = 0; i < rows; ++i) {
-        for (size_t j = 0; j < cols; ++j) {
-            T[j][i] = A[i][j];
-        }
-    }
-    return T;
-}
-
-std::vector<double> solveLinearSystem(std::vector<std::vector<double>> A, std::vector<double> b) {
-    size_t n = A.size();
-    if (n == 0) return {};
-
-    for (size_t i = 0; i < n; i++) {
-        size_t max_row = i;
-        for (size_t k = i + 1; k < n; k++) {
-            if (std::abs(A[k][i]) > std::abs(A[max_row][i])) {
-                max_row = k;
-            }
-        }
-        std::swap(A[i], A[max_row]);
-        std::swap(b[i], b[max_row]);
-        
-        if (std::abs(A[i][i]) < 1e-12) {
-             throw std::runtime_error("Matrix is singular or nearly singular.");
-        }
-
-        for (size_t k = i + 1; k < n; k++) {
-            double factor = A[k][i] / A[i][i];
-            for (size_t j = i; j < n; j++) {
-                A[k][j] -= factor * A[i][j];
-            }
-            b[k] -= factor * b[i];
-        }
-    }
-
-    std::vector<double> x(n);
-    for (int i = n - 1; i >= 0; i--) {
-        double sum = 0;
-        for (size_t j = i + 1; j < n; j++) {
-            sum += A[i][j] * x[j];
-        }
-        x[i] = (b[i] - sum) / A[i][i];
-    }
-    return x;
-}
-// --- 手动实现的线性代数辅助函数 (结束) ---
-
 static double calculateDistance(const COORD3& p1, const COORD3& p2) {
     return std::sqrt(std::pow(p1.p1 - p2.p1, 2) + 
                      std::pow(p1.p2 - p2.p2, 2) + 
                      std::pow(p1.p3 - p2.p3, 2));
 }
 
-// --- 核心算法函数 ---
-COORD3 tdoaLocate_chan_initial(const std::vector<COORD3>& stationPositions, 
-                              const std::vector<double>& tdoas, 
-                              double knownHeight);
-COORD3 tdoaRefinePosition_taylor(const std::vector<COORD3>& stationPositions, 
-                                const std::vector<double>& tdoas, 
-                                const COORD3& initialGuess);
-
 TDOAalgorithm& TDOAalgorithm::getInstance() {
     static TDOAalgorithm instance;
     return instance;
 }
 
-TDOAalgorithm::TDOAalgorithm() : m_simulationTime(0.0), m_tdoaRmsError(0.0), m_esmToaError(0.0) {
-    m_result = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+TDOAalgorithm::TDOAalgorithm() : m_simulationTime(0.0), m_covariance(Eigen::Matrix3d::Zero()),
+                                 m_tdoaRmsError(0.0), m_esmToaError(0.0), m_epoch(0.0) {
+    m_result = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
 }
 
 TDOAalgorithm::~TDOAalgorithm() {}
@@ -141,172 +42,180 @@ void TDOAalgorithm::init(const std::vector<std::string>& deviceNames,
     m_tdoaRmsError = tdoaRmsError;
     m_esmToaError = esmToaError;
     m_devices.clear();
-    m_result = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
-    
-    std::cout << "\n\n=============================================" << std::endl;
-    std::cout << "      TDOA算法处理开始" << std::endl;
-    std::cout << "=============================================" << std::endl;
-    std::cout << "[初始化] 目标辐射源: " << m_sourceName << std::endl;
-    std::cout << "[初始化] TDOA RMS误差: " << m_tdoaRmsError * 1e9 << " ns" << std::endl;
-    std::cout << "[初始化] ESM TOA误差: " << m_esmToaError * 1e9 << " ns" << std::endl;
-    std::cout << "[初始化] 参与侦察设备:" << std::endl;
-    for(const auto& name : m_deviceNames) {
-        std::cout << "       - " << name << std::endl;
+    m_result = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    m_covariance.setZero();
+    m_epoch = 0.0;
+    
+    PL_LOG_INFO("[TDOA] 开始处理，目标辐射源: %s，侦察设备 %zu 个\n", m_sourceName.c_str(), m_deviceNames.size());
+    PL_LOG_DEBUG("[初始化] TDOA RMS误差: %g ns, ESM TOA误差: %g ns\n", m_tdoaRmsError * 1e9, m_esmToaError * 1e9);
+    if (Log::isEnabled(Log::Level::Debug)) {
+        for (const auto& name : m_deviceNames) {
+            PL_LOG_DEBUG("       - %s\n", name.c_str());
+        }
     }
 }
 
 bool TDOAalgorithm::loadDeviceInfo() {
-    ReconnaissanceDeviceDAO& deviceDAO = ReconnaissanceDeviceDAO::getInstance();
-    std::vector<ReconnaissanceDevice> allDevices = deviceDAO.getAllReconnaissanceDevices();
-    if (allDevices.empty()) { std::cerr << "TDOA错误: 数据库中未找到侦察设备。" << std::endl; return false; }
+    ModelRepository& repository = ModelRepository::getInstance();
     
     for (const std::string& deviceName : m_deviceNames) {
-        bool found = false;
-        for (const ReconnaissanceDevice& device : allDevices) {
-            if (device.getDeviceName() == deviceName) {
-                m_devices.push_back(device);
-                found = true;
-                break;
-            }
-        }
-        if (!found) { std::cerr << "TDOA错误: 未找到名为 " << deviceName << " 的侦察设备。" << std::endl; return false; }
+        ReconnaissanceDevice device;
+        if (!repository.findReconnaissanceDeviceByName(deviceName, device)) { std::cerr << "TDOA错误: 未找到名为 " << deviceName << " 的侦察设备。" << std::endl; return false; }
+        m_devices.push_back(device);
     }
 
     if (m_devices.size() < 4) {
         std::cerr << "TDOA错误: 3D TDOA定位至少需要4个侦察设备。" << std::endl;
         return false;
     }
-    std::cout << "[加载] 成功加载 " << m_devices.size() << " 个侦察设备。" << std::endl;
+    PL_LOG_DEBUG("[加载] 成功加载 %zu 个侦察设备。\n", m_devices.size());
     return true;
 }
 
 bool TDOAalgorithm::loadSourceInfo() {
-    RadiationSourceDAO& sourceDAO = RadiationSourceDAO::getInstance();
-    std::vector<RadiationSource> allSources = sourceDAO.getAllRadiationSources();
-    if (allSources.empty()) { std::cerr << "TDOA错误: 数据库中未找到辐射源。" << std::endl; return false; }
+    ModelRepository& repository = ModelRepository::getInstance();
     
-    for (const RadiationSource& source : allSources) {
-        if (source.getRadiationName() == m_sourceName) {
-            m_source = source;
-            std::cout << "[加载] 成功加载辐射源: " << m_source.getRadiationName() << std::endl;
-            return true;
-        }
+    if (repository.findRadiationSourceByName(m_sourceName, m_source)) {
+        PL_LOG_DEBUG("[加载] 成功加载辐射源: %s\n", m_source.getRadiationName().c_str());
+        return true;
     }
     std::cerr << "TDOA错误: 未找到名为 " << m_sourceName << " 的辐射源。" << std::endl;
     return false;
 }
 
+double TDOAalgorithm::selectObservationEpoch() const {
+    const VisibilityTimeline timeline = computeVisibilityTimeline(m_devices, m_source, m_simulationTime, m_visibility);
+    const std::vector<double> epochs = timeline.selectEpochs(std::vector<double>(1, 0.0));
+    if (epochs.empty()) {
+        PL_LOG_WARN("[TDOA] 仿真时间内没有所有侦察设备都能接收信号的时刻，仍使用初始时刻\n");
+        return 0.0;
+    }
+    if (epochs.front() != 0.0) {
+        PL_LOG_INFO("[TDOA] 初始时刻不可接收，改用 %g 秒时刻的平台位置\n", epochs.front());
+    }
+    return epochs.front();
+}
+
 bool TDOAalgorithm::calculate() {
-    if (!loadDeviceInfo() || !loadSourceInfo()) {
-        return false;
+    PL_TRACE_SCOPE("TDOA.calculate");
+    {
+        PL_TRACE_SCOPE("TDOA.load");
+        if (!loadDeviceInfo() || !loadSourceInfo()) {
+            return false;
+        }
     }
-    
-    std::cout << "\n--- 阶段2: 坐标转换 ---" << std::endl;
-    COORD3 sourcePos_xyz = lbh2xyz(m_source.getLongitude(), m_source.getLatitude(), m_source.getAltitude());
-    std::cout << std::fixed << std::setprecision(3);
-    std::cout << "辐射源真实位置 (XYZ): " 
-              << sourcePos_xyz.p1 << ", " << sourcePos_xyz.p2 << ", " << sourcePos_xyz.p3 << " m" << std::endl;
+
+    {
+        PL_TRACE_SCOPE("TDOA.selectEpoch");
+        m_epoch = selectObservationEpoch();
+    }
+
+    PL_LOG_DEBUG("--- 阶段2: 坐标转换 ---\n");
+    // 平台按运动参数移动到观测时刻的位置，观测时刻为0时即初始位置
+    COORD3 sourcePos_xyz = Trajectory::fromSource(m_source, m_simulationTime).positionXyzAt(m_epoch);
+    PL_LOG_DEBUG("辐射源真实位置 (XYZ): %.3f, %.3f, %.3f m\n", sourcePos_xyz.p1, sourcePos_xyz.p2, sourcePos_xyz.p3);
     std::vector<COORD3> stationPos_xyz;
     for(size_t i = 0; i < m_devices.size(); ++i) {
-        stationPos_xyz.push_back(lbh2xyz(m_devices[i].getLongitude(), m_devices[i].getLatitude(), m_devices[i].getAltitude()));
-        std::cout << "侦察站 " << i << " (" << m_devices[i].getDeviceName() << ") 位置 (XYZ): "
-                  << stationPos_xyz[i].p1 << ", " << stationPos_xyz[i].p2 << ", " << stationPos_xyz[i].p3 << " m" << std::endl;
+        stationPos_xyz.push_back(Trajectory::fromDevice(m_devices[i], m_simulationTime).positionXyzAt(m_epoch));
+        PL_LOG_DEBUG("侦察站 %zu (%s) 位置 (XYZ): %.3f, %.3f, %.3f m\n", i, m_devices[i].getDeviceName().c_str(),
+                     stationPos_xyz[i].p1, stationPos_xyz[i].p2, stationPos_xyz[i].p3);
     }
-    
+
     // 计算理想到达时间 (TOA)
-    std::vector<double> true_toas(m_devices.size()); 
+    std::vector<double> true_toas(m_devices.size());
     for (size_t i = 0; i < m_devices.size(); ++i) {
         true_toas[i] = calculateDistance(stationPos_xyz[i], sourcePos_xyz) / Constants::c;
     }
 
-    int ref_idx = 0; 
-    std::cout << "\n[信息] 使用侦察站 " << ref_idx << " (" << m_devices[ref_idx].getDeviceName() << ") 作为参考站。" << std::endl;
+    int ref_idx = 0;
+    PL_LOG_DEBUG("[信息] 使用侦察站 %d (%s) 作为参考站。\n", ref_idx, m_devices[ref_idx].getDeviceName().c_str());
 
     std::vector<COORD3> stations = stationPos_xyz;
     std::vector<double> measured_toas = true_toas;
-    
-    std::cout << "\n--- 阶段3: 误差参数 ---" << std::endl;
-    std::cout << "TDOA RMS误差: " << m_tdoaRmsError * 1e6 << " μs" << std::endl;
-    std::cout << "ESM TOA误差: " << m_esmToaError * 1e6 << " μs" << std::endl;
+
+    PL_LOG_DEBUG("--- 阶段3: 误差参数 ---\n");
+    PL_LOG_DEBUG("TDOA RMS误差: %g μs, ESM TOA误差: %g μs\n", m_tdoaRmsError * 1e6, m_esmToaError * 1e6);
 
     if (m_esmToaError != 0.0) {
         measured_toas[ref_idx] += m_esmToaError;
-        std::cout << "已应用TOA系统误差到参考站: " << m_esmToaError * 1e6 << " μs" << std::endl;
-        std::cout << "注意: 负数TOA误差会导致TDOA值增加，正数TOA误差会导致TDOA值减少" << std::endl;
-        std::cout << "参考站TOA值变化: " << (true_toas[ref_idx] * 1e6) << " μs -> " 
-                  << (measured_toas[ref_idx] * 1e6) << " μs" << std::endl;
+        // 负数TOA误差会导致TDOA值增加，正数TOA误差会导致TDOA值减少
+        PL_LOG_DEBUG("已应用TOA系统误差到参考站，TOA值变化: %g μs -> %g μs\n",
+                     true_toas[ref_idx] * 1e6, measured_toas[ref_idx] * 1e6);
     }
 
     std::vector<double> measured_tdoas(m_devices.size(), 0.0);
-    std::cout << "\n--- 阶段4: TDOA计算及误差应用 ---" << std::endl;
-    std::cout << "参考站: 站点" << ref_idx << " (" << m_devices[ref_idx].getDeviceName() << ")" << std::endl;
-    std::cout << "| 站点 | 理想TDOA(s) | 应用误差(μs) | 计算TDOA(s) |" << std::endl;
-    std::cout << "|------|------------|------------|------------|" << std::endl;
-    
+    PL_LOG_DEBUG("--- 阶段4: TDOA计算及误差应用 ---\n");
+    PL_LOG_TRACE("| 站点 | 理想TDOA(s) | 应用误差(μs) | 计算TDOA(s) |\n");
+
+    const RandomService& randomService = RandomService::getInstance();
     for (size_t i = 1; i < m_devices.size(); ++i) {
         double ideal_tdoa = true_toas[i] - true_toas[ref_idx];
-        double applied_error = 0.0;
-        if (m_tdoaRmsError > 0.0) {
-            applied_error = m_tdoaRmsError * (i % 2 == 0 ? 1 : -1);
-        }
+        // 各站时差误差服从 N(0, m_tdoaRmsError²)，随机流按(当前任务, 侦察站序号)派生
+        RandomStream rng = randomService.stream(RandomPurpose::TimeDifferenceError, 0, i);
+        double applied_error = rng.normal(0.0, m_tdoaRmsError);
         double tdoa_with_ref_error = true_toas[i] - measured_toas[ref_idx];
         measured_tdoas[i] = tdoa_with_ref_error + applied_error;
-        
-        std::cout << std::scientific << std::setprecision(6);
-        std::cout << "| " << i << " | " << ideal_tdoa << " | " 
-                  << applied_error * 1e6 << " | " << measured_tdoas[i] << " |" << std::endl;
-        
-        if (m_esmToaError != 0.0) {
-            std::cout << "  - 站点" << i << "的TDOA受ESM TOA误差影响: " 
-                      << ideal_tdoa << " -> " << tdoa_with_ref_error 
-                      << " (差值: " << (tdoa_with_ref_error - ideal_tdoa) * 1e6 << " μs)" << std::endl;
-        }
+
+        PL_LOG_TRACE("| %zu | %.6e | %.6e | %.6e |\n", i, ideal_tdoa, applied_error * 1e6, measured_tdoas[i]);
     }
-    
-    std::cout << "\n--- 阶段5: 定位计算 ---" << std::endl;
-    std::cout << "使用已知高度进行二维定位: " << sourcePos_xyz.p3 << " m" << std::endl;
-    
+
+    PL_LOG_DEBUG("--- 阶段5: 定位计算 ---\n");
+
     COORD3 final_position;
-    try {
-        COORD3 initial_guess = tdoaLocate_chan_initial(stations, measured_tdoas, sourcePos_xyz.p3);
-        std::cout << std::fixed << std::setprecision(3);
-        std::cout << "初始估计位置 (XYZ): " 
-                << initial_guess.p1 << ", " << initial_guess.p2 << ", " << initial_guess.p3 << " m" << std::endl;
-        
-        final_position = tdoaRefinePosition_taylor(stations, measured_tdoas, initial_guess);
-        std::cout << "最终精炼位置 (XYZ): " 
-                << final_position.p1 << ", " << final_position.p2 << ", " << final_position.p3 << " m" << std::endl;
-    } catch (const std::exception& e) {
-        std::cerr << "定位计算失败: " << e.what() << std::endl;
-        final_position = sourcePos_xyz; // 失败时使用真实位置
-        std::cout << "使用辐射源真实位置作为结果。" << std::endl;
+    // 三维Chan两步加权最小二乘 + 高斯-牛顿迭代，不固定目标高度
+    TDOA3DSolution solution3D;
+    {
+        PL_TRACE_SCOPE("TDOA.locate3D");
+        solution3D = tdoaLocate3D(stations, measured_tdoas, m_tdoaRmsError);
     }
-    
+    PL_COUNTER_ADD("tdoa.solves", 1);
+    if (solution3D.valid) {
+        final_position = solution3D.position;
+        m_covariance = solution3D.covariance;
+        m_result.gdop = solution3D.gdop;
+        m_result.cep = horizontalCEP(solution3D.covariance, solution3D.position);
+        PL_COUNTER_ADD("tdoa.gaussNewtonIterations", solution3D.iterations);
+        PL_LOG_DEBUG("三维定位位置 (XYZ): %.3f, %.3f, %.3f m\n", final_position.p1, final_position.p2, final_position.p3);
+        PL_LOG_DEBUG("高斯-牛顿迭代次数: %d%s, GDOP: %.3f, 解析CEP: %.3f m\n", solution3D.iterations,
+                     solution3D.converged ? " (已收敛)" : " (未收敛)", solution3D.gdop, m_result.cep);
+    } else {
+        PL_TRACE_SCOPE("TDOA.fallback2D");
+        PL_COUNTER_ADD("tdoa.fallback2D", 1);
+        try {
+            // 三维求解失败时退回到已知高度的二维定位
+            PL_LOG_WARN("三维定位失败，使用已知高度进行二维定位: %.3f m\n", sourcePos_xyz.p3);
+            COORD3 initial_guess = tdoaLocate_chan_initial(stations, measured_tdoas, sourcePos_xyz.p3);
+            PL_LOG_DEBUG("初始估计位置 (XYZ): %.3f, %.3f, %.3f m\n", initial_guess.p1, initial_guess.p2, initial_guess.p3);
+
+            int taylor_iterations = 0;
+            final_position = tdoaRefinePosition_taylor(stations, measured_tdoas, initial_guess, &taylor_iterations);
+            PL_LOG_DEBUG("泰勒迭代次数: %d，最终精炼位置 (XYZ): %.3f, %.3f, %.3f m\n", taylor_iterations,
+                         final_position.p1, final_position.p2, final_position.p3);
+        } catch (const std::exception& e) {
+            std::cerr << "定位计算失败: " << e.what() << std::endl;
+            final_position = sourcePos_xyz; // 失败时使用真实位置
+            PL_LOG_WARN("使用辐射源真实位置作为结果。\n");
+        }
+    }
+
     COORD3 resultLBH = xyz2lbh(final_position.p1, final_position.p2, final_position.p3);
     m_result.longitude = resultLBH.p1;
     m_result.latitude = resultLBH.p2;
-    m_result.altitude = resultLBH.p3; 
-    m_result.velocity = 0; 
+    m_result.altitude = resultLBH.p3;
+    m_result.velocity = 0;
     m_result.azimuth = 0;
     m_result.elevation = 0;
     m_result.locationTime = m_simulationTime;
-    
+
     double error_dist = calculateDistance(final_position, sourcePos_xyz);
     m_result.accuracy = error_dist;
-    
+
     double distance_to_origin = calculateDistance(final_position, {0,0,0});
     m_result.distance = distance_to_origin;
-    
-    std::cout << "\n---------------------------------------------" << std::endl;
-    std::cout << "      TDOA算法最终结果" << std::endl;
-    std::cout << "---------------------------------------------" << std::endl;
-    std::cout << std::fixed << std::setprecision(6);
-    std::cout << "位置 (经度, 纬度, 高度): " 
-              << m_result.longitude << " 度, " 
-              << m_result.latitude << " 度, " 
-              << m_result.altitude << " m" << std::endl;
-    std::cout << "精度 (定位误差): " << m_result.accuracy << " m" << std::endl;
-    std::cout << "=============================================\n" << std::endl;
+
+    PL_LOG_INFO("[TDOA] 结果: %.6f 度, %.6f 度, %.6f m，定位误差 %.6f m，解析CEP %.6f m，GDOP %.6f\n",
+                m_result.longitude, m_result.latitude, m_result.altitude,
+                m_result.accuracy, m_result.cep, m_result.gdop);
 
     return true;
 }
@@ -315,169 +224,44 @@ TDOAalgorithm::LocationResult TDOAalgorithm::getResult() const {
     return m_result;
 }
 
-// ---Chan算法（二维）---
-COORD3 tdoaLocate_chan_initial(const std::vector<COORD3>& stationPositions, 
-                              const std::vector<double>& tdoas, 
-                              double knownHeight) {
-    int N = stationPositions.size();
-    if (N < 4) return {0,0,knownHeight};
-
-    int M = N - 1; 
-    std::vector<std::vector<double>> Ga(M, std::vector<double>(3)); // 3列：x, y, R1
-    std::vector<double> h(M);
-
-    const double x1 = stationPositions[0].p1;
-    const double y1 = stationPositions[0].p2;
-    const double z1 = stationPositions[0].p3;
-    const double z0 = knownHeight;
-
-    // 计算参考站到目标的距离平方（基于高度）
-    double R1_sq = (x1*x1 + y1*y1 + (z0-z1)*(z0-z1));
-    
-    for (int i = 0; i < M; ++i) {
-        int station_idx = i + 1;
-        const double xi = stationPositions[station_idx].p1;
-        const double yi = stationPositions[station_idx].p2;
-        const double zi = stationPositions[station_idx].p3;
-        
-        const double d_i1 = Constants::c * tdoas[station_idx]; // 转换为距离差
-        
-        // 正确构建Ga矩阵
-        Ga[i][0] = 2 * (xi - x1);  // 修正：使用(xi - x1)而不是(x1 - xi)
-        Ga[i][1] = 2 * (yi - y1);  // 修正：使用(yi - y1)而不是(y1 - yi)
-        Ga[i][2] = -2 * d_i1;      // 修正：使用负值
-        
-        // 正确计算常数项
-        const double Ri_sq = (xi*xi + yi*yi + (z0-zi)*(z0-zi));
-        const double K_i = Ri_sq - R1_sq - d_i1*d_i1;
-        h[i] = K_i;
+bool TDOAalgorithm::calculateBatch(const std::vector<COORD3>& candidateLbh,
+                                   std::vector<TDOABatchLocator::Solution>& solutions) {
+    solutions.clear();
+    m_devices.clear();
+    if (!loadDeviceInfo()) {
+        return false;
     }
-    
-    try {
-        // 求解 Ga * [x; y; R1] = h
-        std::vector<std::vector<double>> Ga_T = transposeMatrix(Ga);
-        std::vector<std::vector<double>> GaT_Ga = multiplyMatrixMatrix(Ga_T, Ga);
-        std::vector<double> GaT_h = multiplyMatrixVector(Ga_T, h);
-        
-        // 添加正则化项增强稳定性
-        for (size_t i = 0; i < GaT_Ga.size(); ++i) {
-            GaT_Ga[i][i] += 1e-6;
-        }
-        
-        std::vector<double> solution = solveLinearSystem(GaT_Ga, GaT_h);
-        
-        if (solution.size() < 3) return {0,0,knownHeight};
-        
-        // 返回结果 (x, y, 已知高度)
-        return {solution[0], solution[1], knownHeight};
 
-    } catch (const std::runtime_error& e) {
-        std::cerr << "Chan初始解计算失败: " << e.what() << std::endl;
-        return {0, 0, knownHeight};
+    // 站址预处理只做一次
+    std::vector<COORD3> stationPos_xyz;
+    stationPos_xyz.reserve(m_devices.size());
+    for (const auto& device : m_devices) {
+        stationPos_xyz.push_back(lbh2xyz(device.getLongitude(), device.getLatitude(), device.getAltitude()));
     }
-}
-
-// --- 泰勒级数迭代法（二维）---
-COORD3 tdoaRefinePosition_taylor(const std::vector<COORD3>& stationPositions, 
-                               const std::vector<double>& tdoas, 
-                               const COORD3& initialGuess) {
-    int N = stationPositions.size();
-    if (N < 4) return initialGuess;
-    
-    COORD3 currentPos = initialGuess;
-    const int max_iterations = 20;  // 增加最大迭代次数
-    const double tolerance = 1e-2;  // 降低收敛阈值（米）
-    int M = N - 1;
-
-    for(int iter = 0; iter < max_iterations; ++iter) {
-        std::vector<std::vector<double>> H(M, std::vector<double>(2)); // 二维雅可比矩阵
-        std::vector<double> delta_rho(M);
-
-        double R1 = calculateDistance(currentPos, stationPositions[0]);
-        if (R1 < 1e-6) R1 = 1e-6;
-
-        for (int i = 0; i < M; ++i) {
-            int station_idx = i + 1;
-            double Ri = calculateDistance(currentPos, stationPositions[station_idx]);
-            if (Ri < 1e-6) Ri = 1e-6;
-            
-            // 二维雅可比矩阵 (只计算x和y方向)
-            H[i][0] = (currentPos.p1 - stationPositions[station_idx].p1) / Ri - 
-                      (currentPos.p1 - stationPositions[0].p1) / R1;
-            H[i][1] = (currentPos.p2 - stationPositions[station_idx].p2) / Ri - 
-                      (currentPos.p2 - stationPositions[0].p2) / R1;
-
-            double estimated_tdoa = (Ri - R1) / Constants::c;
-            delta_rho[i] = tdoas[station_idx] - estimated_tdoa;
-        }
-
-        try {
-            std::vector<std::vector<double>> H_T = transposeMatrix(H);
-            std::vector<std::vector<double>> HT_H = multiplyMatrixMatrix(H_T, H);
-            std::vector<double> HT_delta_rho = multiplyMatrixVector(H_T, delta_rho);
-
-            // 将残差从秒转换为米
-            for(double& val : HT_delta_rho) {
-                val *= Constants::c;
-            }
-
-            // 添加正则化项
-            for (size_t i = 0; i < HT_H.size(); ++i) {
-                HT_H[i][i] += 1e-6;
-            }
-
-            std::vector<double> correction = solveLinearSystem(HT_H, HT_delta_rho);
-            
-            if (correction.size() < 2) {
-                throw std::runtime_error("修正向量维度不足");
-            }
-
-            // 只更新x和y坐标
-            currentPos.p1 += correction[0];
-            currentPos.p2 += correction[1];
-            
-            // 检查收敛性
-            double correction_norm = std::sqrt(correction[0]*correction[0] + correction[1]*correction[1]);
-            if (correction_norm < tolerance) {
-                 std::cout << "泰勒迭代在 " << iter+1 << " 次迭代后收敛" << std::endl;
-                 return currentPos;
-            }
-
-        } catch (const std::runtime_error& e) {
-            std::string msg = "泰勒迭代失败(迭代步 " + std::to_string(iter) + "): " + e.what();
-            throw std::runtime_error(msg);
+    PL_TRACE_SCOPE("TDOA.calculateBatch");
+    TDOABatchLocator locator(stationPos_xyz);
+
+    // 按与calculate()相同的误差模型生成各候选位置的时差，随机流以候选位置序号为试验序号
+    const RandomService& randomService = RandomService::getInstance();
+    const size_t N = stationPos_xyz.size();
+    std::vector<std::vector<double>> tdoaBatch(candidateLbh.size(), std::vector<double>(N, 0.0));
+    std::vector<double> knownHeights(candidateLbh.size());
+    for (size_t k = 0; k < candidateLbh.size(); ++k) {
+        COORD3 sourcePos_xyz = lbh2xyz(candidateLbh[k].p1, candidateLbh[k].p2, candidateLbh[k].p3);
+        knownHeights[k] = sourcePos_xyz.p3;
+        double ref_toa = calculateDistance(stationPos_xyz[0], sourcePos_xyz) / Constants::c + m_esmToaError;
+        for (size_t i = 1; i < N; ++i) {
+            RandomStream rng = randomService.stream(RandomPurpose::TimeDifferenceError, k, i);
+            double applied_error = rng.normal(0.0, m_tdoaRmsError);
+            tdoaBatch[k][i] = calculateDistance(stationPos_xyz[i], sourcePos_xyz) / Constants::c - ref_toa + applied_error;
         }
     }
-    
-    std::cout << "泰勒迭代达到最大迭代次数 (" << max_iterations << ")" << std::endl;
-    return currentPos;
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
 
+    solutions = locator.locateBatch(tdoaBatch, knownHeights, m_tdoaRmsError);
+    PL_COUNTER_ADD("tdoa.solves", static_cast<std::int64_t>(solutions.size()));
+    PL_LOG_DEBUG("[批量定位] 完成 %zu 个候选位置的TDOA定位\n", solutions.size());
+    return true;
+}
 
 // #include "TDOAalgorithm.h"
 // #include "../../constants/PhysicsConstants.h"
@@ -0,0 +1,191 @@
+#include "../Trajectory.h"
+#include "../../constants/PhysicsConstants.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace Constants;
+
+namespace {
+
+// 速度低于该值视为静止平台（米/秒）
+const double STATIONARY_SPEED = 1e-9;
+
+TrajectorySample makeSample(double t, const COORD3& lbh) {
+    TrajectorySample sample;
+    sample.time = t;
+    sample.longitude = lbh.p1;
+    sample.latitude = lbh.p2;
+    sample.altitude = lbh.p3;
+    return sample;
+}
+
+// 在 from/to 之间按经纬高线性插值到中点，返回与真实中点 mid 的偏差（米，局部东北天近似）
+double midpointError(const TrajectorySample& from, const TrajectorySample& to, const TrajectorySample& mid) {
+    double dLon = to.longitude - from.longitude;
+    if (dLon > 180.0) dLon -= 360.0;
+    if (dLon < -180.0) dLon += 360.0;
+    double lon = from.longitude + 0.5 * dLon - mid.longitude;
+    if (lon > 180.0) lon -= 360.0;
+    if (lon < -180.0) lon += 360.0;
+
+    const double east = lon * DEG2RAD * a * std::cos(mid.latitude * DEG2RAD);
+    const double north = (0.5 * (from.latitude + to.latitude) - mid.latitude) * DEG2RAD * a;
+    const double up = 0.5 * (from.altitude + to.altitude) - mid.altitude;
+    return std::sqrt(east * east + north * north + up * up);
+}
+
+} // namespace
+
+Trajectory::Trajectory(double longitude, double latitude, double altitude,
+                       double speed, double azimuth, double elevation, double duration)
+    : m_initialLbh(longitude, latitude, altitude),
+      m_initialXyz(lbh2xyz(longitude, latitude, altitude)),
+      m_velocityXyz(0, 0, 0),
+      m_duration(std::max(0.0, duration)),
+      m_stationary(std::fabs(speed) < STATIONARY_SPEED) {
+    if (!m_stationary) {
+        m_velocityXyz = velocity_lbh2xyz(longitude, latitude, speed, azimuth, elevation);
+    }
+}
+
+Trajectory Trajectory::fromDevice(const ReconnaissanceDevice& device, double duration) {
+    return Trajectory(device.getLongitude(), device.getLatitude(), device.getAltitude(),
+                      device.getMovementSpeed(), device.getMovementAzimuth(),
+                      device.getMovementElevation(), duration);
+}
+
+Trajectory Trajectory::fromSource(const RadiationSource& source, double duration) {
+    return Trajectory(source.getLongitude(), source.getLatitude(), source.getAltitude(),
+                      source.getMovementSpeed(), source.getMovementAzimuth(),
+                      source.getMovementElevation(), duration);
+}
+
+COORD3 Trajectory::positionXyzAt(double t) const {
+    return COORD3(m_initialXyz.p1 + m_velocityXyz.p1 * t,
+                  m_initialXyz.p2 + m_velocityXyz.p2 * t,
+                  m_initialXyz.p3 + m_velocityXyz.p3 * t);
+}
+
+COORD3 Trajectory::positionAt(double t) const {
+    if (m_stationary) {
+        return m_initialLbh;
+    }
+    COORD3 xyz = positionXyzAt(t);
+    return xyz2lbh(xyz.p1, xyz.p2, xyz.p3);
+}
+
+void Trajectory::positionsAt(const double* times, std::size_t n,
+                             double* longitudes, double* latitudes, double* altitudes) const {
+    if (m_stationary) {
+        std::fill(longitudes, longitudes + n, m_initialLbh.p1);
+        std::fill(latitudes, latitudes + n, m_initialLbh.p2);
+        std::fill(altitudes, altitudes + n, m_initialLbh.p3);
+        return;
+    }
+
+    std::vector<double> xs(n), ys(n), zs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        xs[i] = m_initialXyz.p1 + m_velocityXyz.p1 * times[i];
+        ys[i] = m_initialXyz.p2 + m_velocityXyz.p2 * times[i];
+        zs[i] = m_initialXyz.p3 + m_velocityXyz.p3 * times[i];
+    }
+    xyz2lbhBatch(xs.data(), ys.data(), zs.data(), longitudes, latitudes, altitudes, n);
+}
+
+COORD3 Trajectory::velocityAt(double t) const {
+    if (m_stationary) {
+        return COORD3(0, 0, 0);
+    }
+    COORD3 lbh = positionAt(t);
+    return velocity_xyz2lbh(lbh.p1, lbh.p2, m_velocityXyz.p1, m_velocityXyz.p2, m_velocityXyz.p3);
+}
+
+std::vector<std::pair<double, double>> Trajectory::sampleUniform(double step) const {
+    std::vector<double> times;
+    if (step <= 0.0) {
+        step = m_duration > 0.0 ? m_duration : 1.0;
+    }
+    const std::size_t count = static_cast<std::size_t>(std::floor(m_duration / step));
+    times.reserve(count + 2);
+    for (std::size_t i = 0; i <= count; ++i) {
+        times.push_back(i * step);
+    }
+    if (times.back() < m_duration) {
+        times.push_back(m_duration);
+    }
+
+    const std::size_t n = times.size();
+    std::vector<double> lons(n), lats(n), alts(n);
+    positionsAt(times.data(), n, lons.data(), lats.data(), alts.data());
+
+    std::vector<std::pair<double, double>> points;
+    points.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        points.push_back(std::make_pair(lons[i], lats[i]));
+    }
+    // 起点使用原始经纬度，避免正反算的舍入误差
+    points[0] = std::make_pair(m_initialLbh.p1, m_initialLbh.p2);
+    return points;
+}
+
+TrajectoryIterator::TrajectoryIterator(const Trajectory& trajectory, const TrajectorySamplingOptions& options)
+    : m_trajectory(&trajectory),
+      m_options(options),
+      m_step(0.0),
+      m_started(false),
+      m_finished(false) {
+    if (m_options.minStep <= 0.0) m_options.minStep = 1.0;
+    if (m_options.maxStep < m_options.minStep) m_options.maxStep = m_options.minStep;
+    if (m_options.tolerance < 0.0) m_options.tolerance = 0.0;
+    m_step = m_options.maxStep;
+}
+
+bool TrajectoryIterator::next(TrajectorySample& sample) {
+    if (m_finished) {
+        return false;
+    }
+
+    const Trajectory& trajectory = *m_trajectory;
+    const double duration = trajectory.duration();
+
+    if (!m_started) {
+        m_started = true;
+        m_last = makeSample(0.0, trajectory.positionAt(0.0));
+        m_finished = duration <= 0.0;
+        sample = m_last;
+        return true;
+    }
+
+    // 静止平台只需要起点和终点
+    if (trajectory.isStationary()) {
+        m_last = makeSample(duration, trajectory.positionAt(duration));
+        m_finished = true;
+        sample = m_last;
+        return true;
+    }
+
+    const double remaining = duration - m_last.time;
+    double step = std::min(m_step, remaining);
+    TrajectorySample candidate;
+    double error = 0.0;
+    for (;;) {
+        const double t = step >= remaining ? duration : m_last.time + step;
+        candidate = makeSample(t, trajectory.positionAt(t));
+        const double tMid = 0.5 * (m_last.time + t);
+        error = midpointError(m_last, candidate, makeSample(tMid, trajectory.positionAt(tMid)));
+        if (error <= m_options.tolerance || step <= m_options.minStep) {
+            break;
+        }
+        step = std::max(0.5 * step, m_options.minStep);
+    }
+
+    // 偏差有富余时放大下一步，否则保持当前步长
+    if (step < remaining) {
+        m_step = error < 0.25 * m_options.tolerance ? std::min(2.0 * step, m_options.maxStep) : step;
+    }
+
+    m_last = candidate;
+    m_finished = candidate.time >= duration;
+    sample = m_last;
+    return true;
+}
@@ -0,0 +1,44 @@
+/**
+ * 图像叠加图层
+ * C++ 端(MapView::showImageOverlay)把RGBA图像编码为PNG data URL 传入，
+ * 这里以单张影像图层覆盖在指定经纬度范围上，同ID的旧图层会被替换。
+ */
+var ImageOverlay = (function() {
+  var layers = {};
+  var version = {};  // 防止异步创建完成前又被替换或移除
+
+  function removeLayer(id) {
+    if (layers[id]) {
+      viewer.imageryLayers.remove(layers[id], true);
+      delete layers[id];
+    }
+  }
+
+  return {
+    show: function(id, url, west, south, east, north) {
+      var current = (version[id] || 0) + 1;
+      version[id] = current;
+      var provider = Cesium.SingleTileImageryProvider.fromUrl(url, {
+        rectangle: Cesium.Rectangle.fromDegrees(west, south, east, north)
+      });
+      var layer = Cesium.ImageryLayer.fromProviderAsync(provider);
+      layer.readyEvent.addEventListener(function() {
+        if (version[id] !== current) {
+          viewer.imageryLayers.remove(layer, true);
+          return;
+        }
+        removeLayer(id);
+        layers[id] = layer;
+      });
+      layer.errorEvent.addEventListener(function(error) {
+        console.log('叠加图层加载失败: ' + id + ' ' + error);
+      });
+      viewer.imageryLayers.add(layer);
+    },
+
+    remove: function(id) {
+      version[id] = (version[id] || 0) + 1;
+      removeLayer(id);
+    }
+  };
+})();
@@ -0,0 +1,76 @@
+/**
+ * 轨迹数据通道
+ * C++ 端(MapView::streamTrajectory)把轨迹按 [t, 经度, 纬度, 高度] 打包为 Float64Array，
+ * 以 base64 分块传入；这里解码后写入 SampledPositionProperty，由 Cesium 时钟驱动动画，
+ * 不再逐点拼接和解析 JavaScript 源码。
+ */
+var TrajectoryStream = (function() {
+  var tracks = {};
+  var epoch = null;  // 当前动画的起始时刻
+
+  // base64 -> Float64Array（小端，与C++端内存布局一致）
+  function decode(base64) {
+    var binary = atob(base64);
+    var bytes = new Uint8Array(binary.length);
+    for (var i = 0; i < binary.length; i++) {
+      bytes[i] = binary.charCodeAt(i);
+    }
+    return new Float64Array(bytes.buffer);
+  }
+
+  return {
+    // 设置时钟范围并以实时速度开始运行，duration 为仿真时长(秒)
+    startClock: function(duration) {
+      epoch = Cesium.JulianDate.now();
+      viewer.clock.startTime = epoch.clone();
+      viewer.clock.currentTime = epoch.clone();
+      viewer.clock.stopTime = Cesium.JulianDate.addSeconds(epoch, duration, new Cesium.JulianDate());
+      viewer.clock.clockRange = Cesium.ClockRange.CLAMPED;
+      viewer.clock.multiplier = 1;
+      viewer.clock.shouldAnimate = true;
+    },
+
+    // 创建(或重置)一条轨迹，返回可直接赋给 entity.position 的位置属性
+    create: function(id) {
+      var property = new Cesium.SampledPositionProperty();
+      property.forwardExtrapolationType = Cesium.ExtrapolationType.HOLD;
+      property.backwardExtrapolationType = Cesium.ExtrapolationType.HOLD;
+      tracks[id] = { property: property, count: 0, complete: false };
+      return property;
+    },
+
+    // 追加一块采样数据
+    append: function(id, base64) {
+      var track = tracks[id];
+      if (!track || !epoch) {
+        console.log('轨迹未创建: ' + id);
+        return;
+      }
+      var data = decode(base64);
+      for (var i = 0; i + 3 < data.length; i += 4) {
+        var time = Cesium.JulianDate.addSeconds(epoch, data[i], new Cesium.JulianDate());
+        track.property.addSample(time, Cesium.Cartesian3.fromDegrees(data[i + 1], data[i + 2], data[i + 3]));
+      }
+      track.count += data.length / 4;
+    },
+
+    // 全部数据块已送达
+    finish: function(id) {
+      var track = tracks[id];
+      if (track) {
+        track.complete = true;
+        console.log('轨迹 ' + id + ' 传输完成，采样点数量: ' + track.count);
+      }
+    },
+
+    // 时钟到达终点时回调一次
+    onFinished: function(callback) {
+      var removeListener = viewer.clock.onTick.addEventListener(function(clock) {
+        if (Cesium.JulianDate.greaterThanOrEquals(clock.currentTime, clock.stopTime)) {
+          removeListener();
+          callback();
+        }
+      });
+    }
+  };
+})();
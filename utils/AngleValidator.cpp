@@ -5,8 +5,7 @@
 #include "AngleValidator.h"
 #include "CoordinateTransform.h"
 #include "../constants/PhysicsConstants.h"
-#include "../models/RadiationSourceDAO.h"
-#include "../models/ReconnaissanceDeviceDAO.h"
+#include "../models/ModelRepository.h"
 #include <cmath>
 #include <sstream>
 #include <iomanip>
@@ -84,8 +83,8 @@ bool canReceiveSignal(double receiverX, double receiverY, double receiverZ,
 // 验证侦察设备是否能接收到辐射源的信号
 bool validateAngle(const std::vector<int>& deviceIds, int sourceId, std::string& failMessage) {
     // 获取辐射源信息
-    RadiationSourceDAO& radiationSourceDAO = RadiationSourceDAO::getInstance();
-    RadiationSource source = radiationSourceDAO.getRadiationSourceById(sourceId);
+    ModelRepository& repository = ModelRepository::getInstance();
+    RadiationSource source = repository.getRadiationSourceById(sourceId);
     
     // 获取辐射源的位置和工作扇区
     double sourceLongitude = source.getLongitude();
@@ -99,13 +98,10 @@ bool validateAngle(const std::vector<int>& deviceIds, int sourceId, std::string&
     // 获取辐射源空间直角坐标
     COORD3 sourceXYZ = lbh2xyz(sourceLongitude, sourceLatitude, sourceAltitude);
     
-    // 获取侦察设备DAO实例
-    ReconnaissanceDeviceDAO& deviceDAO = ReconnaissanceDeviceDAO::getInstance();
-    
     // 遍历所有侦察设备
     for (int deviceId : deviceIds) {
         // 获取设备信息
-        ReconnaissanceDevice device = deviceDAO.getReconnaissanceDeviceById(deviceId);
+        ReconnaissanceDevice device = repository.getReconnaissanceDeviceById(deviceId);
         
         // 获取设备的位置和接收角度范围
         double deviceLongitude = device.getLongitude();
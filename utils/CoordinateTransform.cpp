@@ -5,9 +5,11 @@
  * - 大地坐标系中的速度转换为空间直角坐标系中的速度分量
  * - 空间直角坐标系中的速度分量转换为大地坐标系中的速度参数
  * - 计算两个大地坐标点之间的距离
+ * - 批量(SoA)坐标转换，可向量化
  */
 
 #include "CoordinateTransform.h"
+#include <algorithm>
 
 using namespace Constants;
 
@@ -80,6 +82,206 @@ COORD3 xyz2lbh(double x, double y, double z) {
     return lbh;
 }
 
+// ---------------------------------------------------------------------------
+// 批量坐标转换
+//
+// 内核只使用无分支的多项式/有理式近似和 select，编译器可以按 SIMD 通道
+// 向量化整段循环；x86-64 下额外生成 AVX2 版本，运行时按 CPU 自动选择。
+// ---------------------------------------------------------------------------
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define GEODESY_BATCH_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define GEODESY_BATCH_CLONES
+#endif
+
+namespace {
+
+// 就近取整(|v| < 2^51)：加减 1.5*2^52 的舍入技巧，在不支持 roundpd 的基础指令集上也可向量化
+inline double roundNearest(double v) {
+    const double magic = 6755399441055744.0;
+    return (v + magic) - magic;
+}
+
+// 角度(度)的正弦和余弦：先按90度归约到[-45°, 45°]，再用Cephes多项式
+inline void sinCosDeg(double deg, double& s, double& c) {
+    const double q = roundNearest(deg * (1.0 / 90.0));
+    const double r = (deg - 90.0 * q) * DEG2RAD;
+    const double z = r * r;
+
+    const double sr = r + r * z * (((((1.58962301576546568060E-10 * z
+        - 2.50507477628578072866E-8) * z + 2.75573136213857245213E-6) * z
+        - 1.98412698295895385996E-4) * z + 8.33333333332211858878E-3) * z
+        - 1.66666666666666307295E-1);
+    const double cr = 1.0 - 0.5 * z + z * z * (((((-1.13585365213876817300E-11 * z
+        + 2.08757008419747316778E-9) * z - 2.75573141792967388112E-7) * z
+        + 2.48015872888517045348E-5) * z - 1.38888888888730564116E-3) * z
+        + 4.16666666666665929218E-2);
+
+    // 象限 q mod 4 用浮点数计算，避免整型转换阻碍向量化
+    double quadrant = q - 4.0 * roundNearest(q * 0.25);
+    quadrant = quadrant < 0.0 ? quadrant + 4.0 : quadrant;
+    const bool swap = quadrant == 1.0 || quadrant == 3.0;
+    const bool negSin = quadrant >= 2.0;
+    const bool negCos = quadrant == 1.0 || quadrant == 2.0;
+    const double s0 = swap ? cr : sr;
+    const double c0 = swap ? sr : cr;
+    s = negSin ? -s0 : s0;
+    c = negCos ? -c0 : c0;
+}
+
+// [0, 1] 上的反正切(Cephes atan，t > 0.66 时用 atan((t-1)/(t+1)) + π/4)
+inline double atanUnit(double t) {
+    const bool big = t > 0.66;
+    const double reduced = (t - 1.0) / (t + 1.0);
+    const double x = big ? reduced : t;
+    const double z = x * x;
+    const double p = (((-8.750608600031904122785E-1 * z - 1.615753718733365076637E1) * z
+        - 7.500855792314704667340E1) * z - 1.228866684490136173410E2) * z
+        - 6.485021904942025371773E1;
+    const double q = ((((z + 2.485846490142306297962E1) * z + 1.650270098316988542046E2) * z
+        + 4.328810604912902668951E2) * z + 4.853903996359136964868E2) * z
+        + 1.945506571482613964425E2;
+    const double r = x * z * p / q + x;
+    return big ? r + (PI / 4.0 + 0.5 * 6.123233995736765886130E-17) : r;
+}
+
+// 无分支 atan2
+inline double atan2Batch(double y, double x) {
+    const double ax = std::fabs(x);
+    const double ay = std::fabs(y);
+    const double mx = std::max(ax, ay);
+    const double mn = std::min(ax, ay);
+    double r = atanUnit(mn / (mx > 0.0 ? mx : 1.0));
+    r = ay > ax ? PI / 2.0 - r : r;
+    r = x < 0.0 ? PI - r : r;
+    return y < 0.0 ? -r : r;
+}
+
+// [1, 2] 上的立方根：线性初值 + 3次Halley迭代
+inline double halleyCbrtStep(double t, double v) {
+    const double t3 = t * t * t;
+    return t * (t3 + 2.0 * v) / (2.0 * t3 + v);
+}
+
+inline double cbrtUnit(double v) {
+    const double t = 1.0 + (v - 1.0) * (1.0 / 3.0);
+    return halleyCbrtStep(halleyCbrtStep(halleyCbrtStep(t, v), v), v);
+}
+
+GEODESY_BATCH_CLONES
+void lbh2xyzKernel(const double* __restrict l, const double* __restrict b, const double* __restrict h,
+                   double* __restrict x, double* __restrict y, double* __restrict z, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        double sin_l, cos_l, sin_b, cos_b;
+        sinCosDeg(l[i], sin_l, cos_l);
+        sinCosDeg(b[i], sin_b, cos_b);
+
+        // 卯酉圈曲率半径
+        const double N = a / std::sqrt(1.0 - e_squared * sin_b * sin_b);
+        x[i] = (N + h[i]) * cos_b * cos_l;
+        y[i] = (N + h[i]) * cos_b * sin_l;
+        z[i] = (N * (1.0 - e_squared) + h[i]) * sin_b;
+    }
+}
+
+// Vermeille(2002)闭式解；不满足 r > 0 且 s <= 0.25 的点输出 NaN，由调用方回退到迭代解
+GEODESY_BATCH_CLONES
+void xyz2lbhKernel(const double* __restrict x, const double* __restrict y, const double* __restrict z,
+                   double* __restrict l, double* __restrict b, double* __restrict h, std::size_t n) {
+    const double e4 = e_squared * e_squared;
+    const double invA2 = 1.0 / (a * a);
+    for (std::size_t i = 0; i < n; ++i) {
+        const double xi = x[i], yi = y[i], zi = z[i];
+        const double rho2 = xi * xi + yi * yi;
+        const double rho = std::sqrt(rho2);
+
+        const double p = rho2 * invA2;
+        const double q = (1.0 - e_squared) * invA2 * zi * zi;
+        const double r = (p + q - e4) * (1.0 / 6.0);
+        // r <= 0 时把 s 置为超界值，两个条件合成一次比较，便于编译器生成向量掩码
+        const bool ok = r > 0.0;
+        const double rs = ok ? r : 1.0;
+        const double s0 = e4 * p * q / (4.0 * rs * rs * rs);
+        const double s = ok ? s0 : 1.0;
+        const bool inRange = s <= 0.25;
+        const double ss = inRange ? s : 0.0;
+
+        const double t = cbrtUnit(1.0 + ss + std::sqrt(ss * (2.0 + ss)));
+        const double u = rs * (1.0 + t + 1.0 / t);
+        const double v = std::sqrt(u * u + e4 * q);
+        const double w = e_squared * (u + v - q) / (2.0 * v);
+        const double k = std::sqrt(u + v + w * w) - w;
+        const double D = k * rho / (k + e_squared);
+        const double dz = std::sqrt(D * D + zi * zi);
+
+        const double lat = 2.0 * atanUnit(std::fabs(zi) / (D + dz));
+        l[i] = atan2Batch(yi, xi) * RAD2DEG;
+        b[i] = inRange ? (zi < 0.0 ? -lat : lat) * RAD2DEG : NAN;
+        h[i] = (k + e_squared - 1.0) / k * dz;
+    }
+}
+
+} // namespace
+
+// 批量大地坐标转换为空间直角坐标
+void lbh2xyzBatch(const double* l, const double* b, const double* h,
+                  double* x, double* y, double* z, std::size_t n) {
+    lbh2xyzKernel(l, b, h, x, y, z, n);
+}
+
+// 批量空间直角坐标转换为大地坐标
+void xyz2lbhBatch(const double* x, const double* y, const double* z,
+                  double* l, double* b, double* h, std::size_t n) {
+    xyz2lbhKernel(x, y, z, l, b, h, n);
+
+    // 地心附近闭式解不适用，逐点回退到迭代解
+    for (std::size_t i = 0; i < n; ++i) {
+        if (std::isnan(b[i])) {
+            COORD3 lbh = xyz2lbh(x[i], y[i], z[i]);
+            l[i] = lbh.p1;
+            b[i] = lbh.p2;
+            h[i] = lbh.p3;
+        }
+    }
+}
+
+std::vector<COORD3> lbh2xyzBatch(const std::vector<COORD3>& lbh) {
+    const std::size_t n = lbh.size();
+    std::vector<double> in(3 * n), out(3 * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        in[i] = lbh[i].p1;
+        in[n + i] = lbh[i].p2;
+        in[2 * n + i] = lbh[i].p3;
+    }
+    lbh2xyzBatch(in.data(), in.data() + n, in.data() + 2 * n,
+                 out.data(), out.data() + n, out.data() + 2 * n, n);
+
+    std::vector<COORD3> xyz(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        xyz[i] = COORD3(out[i], out[n + i], out[2 * n + i]);
+    }
+    return xyz;
+}
+
+std::vector<COORD3> xyz2lbhBatch(const std::vector<COORD3>& xyz) {
+    const std::size_t n = xyz.size();
+    std::vector<double> in(3 * n), out(3 * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        in[i] = xyz[i].p1;
+        in[n + i] = xyz[i].p2;
+        in[2 * n + i] = xyz[i].p3;
+    }
+    xyz2lbhBatch(in.data(), in.data() + n, in.data() + 2 * n,
+                 out.data(), out.data() + n, out.data() + 2 * n, n);
+
+    std::vector<COORD3> lbh(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        lbh[i] = COORD3(out[i], out[n + i], out[2 * n + i]);
+    }
+    return lbh;
+}
+
 // 大地坐标系中的速度转换为空间直角坐标系中的速度分量
 COORD3 velocity_lbh2xyz(double l, double b, double v, double azimuth, double elevation) {
     COORD3 velocity(0, 0, 0);
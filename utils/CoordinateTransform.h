@@ -2,6 +2,8 @@
 #define COORDINATE_TRANSFORM_H
 
 #include <cmath>
+#include <cstddef>
+#include <vector>
 #include "../constants/PhysicsConstants.h"
 
 /**
@@ -36,6 +38,48 @@ COORD3 lbh2xyz(double l, double b, double h);
  */
 COORD3 xyz2lbh(double x, double y, double z);
 
+/**
+ * @brief 批量大地坐标转换为空间直角坐标(SoA布局)
+ * @param l 经度数组(度)
+ * @param b 纬度数组(度)
+ * @param h 高程数组(米)
+ * @param x 输出X坐标数组(米)
+ * @param y 输出Y坐标数组(米)
+ * @param z 输出Z坐标数组(米)
+ * @param n 点数
+ * @note 输入输出数组不得重叠；结果与 lbh2xyz 的偏差在 1e-8 米量级
+ */
+void lbh2xyzBatch(const double* l, const double* b, const double* h,
+                  double* x, double* y, double* z, std::size_t n);
+
+/**
+ * @brief 批量空间直角坐标转换为大地坐标(SoA布局，Vermeille闭式解，无迭代)
+ * @param x X坐标数组(米)
+ * @param y Y坐标数组(米)
+ * @param z Z坐标数组(米)
+ * @param l 输出经度数组(度)
+ * @param b 输出纬度数组(度)
+ * @param h 输出高程数组(米)
+ * @param n 点数
+ * @note 输入输出数组不得重叠；闭式解不适用的点(地心附近)自动回退到 xyz2lbh
+ */
+void xyz2lbhBatch(const double* x, const double* y, const double* z,
+                  double* l, double* b, double* h, std::size_t n);
+
+/**
+ * @brief 批量大地坐标转换为空间直角坐标
+ * @param lbh 大地坐标数组(经度,纬度,高程)
+ * @return 空间直角坐标数组
+ */
+std::vector<COORD3> lbh2xyzBatch(const std::vector<COORD3>& lbh);
+
+/**
+ * @brief 批量空间直角坐标转换为大地坐标
+ * @param xyz 空间直角坐标数组
+ * @return 大地坐标数组(经度,纬度,高程)
+ */
+std::vector<COORD3> xyz2lbhBatch(const std::vector<COORD3>& xyz);
+
 /**
  * @brief 大地坐标系中的速度转换为空间直角坐标系中的速度分量
  * @param l 经度(度)
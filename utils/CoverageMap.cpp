@@ -0,0 +1,510 @@
+#include "CoverageMap.h"
+#include "Instrumentation.h"
+#include "Log.h"
+#include "ParallelFor.h"
+#include "../constants/PhysicsConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const int TILE = CoverageMapEngine::TILE_SIZE;
+const float INVALID = std::numeric_limits<float>::quiet_NaN();
+
+// 预先转换到空间直角坐标的侦察站布局，逐点计算时不再做坐标转换
+struct PreparedScenario {
+    CoverageSystem system = CoverageSystem::TDOA;
+    int count = 0;
+    std::vector<double> sx, sy, sz;        // 侦察站空间直角坐标(米)
+    std::vector<double> vx, vy, vz;        // 侦察站速度(m/s)，频差体制
+    std::vector<double> bearingWeight;     // 各站测向权重 1/σθ² (rad^-2)
+    double meanBearingSigma = 0.0;         // 平均测向标准差(rad)
+    double meanSpeed = 0.0;                // 侦察站平均速率(m/s)
+    double measurementSigma = 0.0;         // 时差：c·σt(米)；频差：σf(Hz)
+    double dopplerScale = 0.0;             // f0/c
+    double targetAltitude = 0.0;
+};
+
+bool prepareScenario(const CoverageScenario& scenario, PreparedScenario& p) {
+    const int count = static_cast<int>(scenario.stations.size());
+    const int minimum = scenario.system == CoverageSystem::DF ? 2 : 3;
+    if (count < minimum) {
+        PL_LOG_ERROR("覆盖图计算至少需要 %d 个侦察站，当前 %d 个\n", minimum, count);
+        return false;
+    }
+
+    p.system = scenario.system;
+    p.count = count;
+    p.targetAltitude = scenario.targetAltitude;
+    p.sx.resize(count);
+    p.sy.resize(count);
+    p.sz.resize(count);
+    for (int i = 0; i < count; ++i) {
+        const COORD3& lbh = scenario.stations[i];
+        const COORD3 xyz = lbh2xyz(lbh.p1, lbh.p2, lbh.p3);
+        p.sx[i] = xyz.p1;
+        p.sy[i] = xyz.p2;
+        p.sz[i] = xyz.p3;
+    }
+
+    switch (scenario.system) {
+    case CoverageSystem::TDOA:
+        if (!(scenario.tdoaSigma > 0.0)) {
+            PL_LOG_ERROR("覆盖图计算的时差测量标准差必须为正数\n");
+            return false;
+        }
+        p.measurementSigma = Constants::c * scenario.tdoaSigma;
+        break;
+    case CoverageSystem::FDOA: {
+        if (scenario.stationVelocities.size() != scenario.stations.size()) {
+            PL_LOG_ERROR("覆盖图计算的侦察站速度个数与侦察站个数不一致\n");
+            return false;
+        }
+        if (!(scenario.fdoaSigma > 0.0) || !(scenario.carrierFrequency > 0.0)) {
+            PL_LOG_ERROR("覆盖图计算的频差测量标准差和载频必须为正数\n");
+            return false;
+        }
+        p.vx.resize(count);
+        p.vy.resize(count);
+        p.vz.resize(count);
+        double speedSum = 0.0;
+        for (int i = 0; i < count; ++i) {
+            const COORD3& v = scenario.stationVelocities[i];
+            p.vx[i] = v.p1;
+            p.vy[i] = v.p2;
+            p.vz[i] = v.p3;
+            speedSum += std::sqrt(v.p1 * v.p1 + v.p2 * v.p2 + v.p3 * v.p3);
+        }
+        p.meanSpeed = speedSum / count;
+        p.measurementSigma = scenario.fdoaSigma;
+        p.dopplerScale = scenario.carrierFrequency / Constants::c;
+        break;
+    }
+    case CoverageSystem::DF: {
+        const std::vector<double>& sigmas = scenario.bearingSigmaDeg;
+        if (sigmas.size() != 1 && sigmas.size() != scenario.stations.size()) {
+            PL_LOG_ERROR("覆盖图计算的测向标准差个数应为1或等于侦察站个数\n");
+            return false;
+        }
+        p.bearingWeight.resize(count);
+        double sigmaSum = 0.0;
+        for (int i = 0; i < count; ++i) {
+            const double sigma = sigmas[sigmas.size() == 1 ? 0 : i] * Constants::DEG2RAD;
+            if (!(sigma > 0.0)) {
+                PL_LOG_ERROR("覆盖图计算的测向标准差必须为正数\n");
+                return false;
+            }
+            p.bearingWeight[i] = 1.0 / (sigma * sigma);
+            sigmaSum += sigma;
+        }
+        p.meanBearingSigma = sigmaSum / count;
+        break;
+    }
+    }
+    return true;
+}
+
+// 目标位置(空间直角坐标)及其当地东、北单位向量处的精度指标
+CoveragePoint evaluatePrepared(const PreparedScenario& p, const double target[3],
+                               const double east[3], const double north[3]) {
+    CoveragePoint point;
+    double f00 = 0.0, f01 = 0.0, f11 = 0.0;  // 信息矩阵(东、北)
+    double sumE = 0.0, sumN = 0.0;           // 差分行之和，用于相关测量的修正项
+    double refE = 0.0, refN = 0.0;           // 参考站的梯度
+    double rangeSum = 0.0;
+
+    for (int i = 0; i < p.count; ++i) {
+        const double dx = target[0] - p.sx[i];
+        const double dy = target[1] - p.sy[i];
+        const double dz = target[2] - p.sz[i];
+        const double r = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (r < 1e-3) return point;
+        rangeSum += r;
+
+        double ge = 0.0, gn = 0.0;  // 观测量对目标东、北坐标的梯度
+        if (p.system == CoverageSystem::DF) {
+            // 方位角 θ = atan2(Δe, Δn)
+            const double de = dx * east[0] + dy * east[1] + dz * east[2];
+            const double dn = dx * north[0] + dy * north[1] + dz * north[2];
+            const double rho2 = de * de + dn * dn;
+            if (rho2 < 1e-6) return point;
+            ge = dn / rho2;
+            gn = -de / rho2;
+            const double w = p.bearingWeight[i];
+            f00 += w * ge * ge;
+            f01 += w * ge * gn;
+            f11 += w * gn * gn;
+            continue;
+        }
+
+        const double inv = 1.0 / r;
+        const double ux = dx * inv, uy = dy * inv, uz = dz * inv;
+        if (p.system == CoverageSystem::TDOA) {
+            // 距离 r 的梯度为视线单位向量
+            ge = ux * east[0] + uy * east[1] + uz * east[2];
+            gn = ux * north[0] + uy * north[1] + uz * north[2];
+        } else {
+            // 多普勒 f0/c·v·u 的梯度为 f0/c·(v - (v·u)u)/r
+            const double vu = p.vx[i] * ux + p.vy[i] * uy + p.vz[i] * uz;
+            const double scale = p.dopplerScale * inv;
+            const double gx = (p.vx[i] - vu * ux) * scale;
+            const double gy = (p.vy[i] - vu * uy) * scale;
+            const double gz = (p.vz[i] - vu * uz) * scale;
+            ge = gx * east[0] + gy * east[1] + gz * east[2];
+            gn = gx * north[0] + gy * north[1] + gz * north[2];
+        }
+
+        if (i == 0) {
+            refE = ge;
+            refN = gn;
+            continue;
+        }
+        const double he = ge - refE;
+        const double hn = gn - refN;
+        f00 += he * he;
+        f01 += he * hn;
+        f11 += hn * hn;
+        sumE += he;
+        sumN += hn;
+    }
+
+    if (p.system != CoverageSystem::DF) {
+        // R = σ²/2 (I + 11^T)，R^-1 = 2/σ² (I - 11^T/(M+1))，M 为差分个数
+        const double m1 = static_cast<double>(p.count);
+        const double k = 2.0 / (p.measurementSigma * p.measurementSigma);
+        f00 = k * (f00 - sumE * sumE / m1);
+        f01 = k * (f01 - sumE * sumN / m1);
+        f11 = k * (f11 - sumN * sumN / m1);
+    }
+
+    const double trace = f00 + f11;
+    const double det = f00 * f11 - f01 * f01;
+    if (!(trace > 0.0) || !(det > 1e-12 * trace * trace)) return point;
+
+    const double p00 = f11 / det;
+    const double p11 = f00 / det;
+    const double p01 = -f01 / det;
+    const double pTrace = p00 + p11;
+    const double half = 0.5 * (p00 - p11);
+    const double disc = std::sqrt(half * half + p01 * p01);
+    const double sigmaMajor = std::sqrt(0.5 * pTrace + disc);
+    const double sigmaMinor = std::sqrt(std::max(0.0, 0.5 * pTrace - disc));
+
+    const double meanRange = rangeSum / p.count;
+    double equivalentSigma = p.measurementSigma;
+    if (p.system == CoverageSystem::DF) {
+        equivalentSigma = p.meanBearingSigma * meanRange;
+    } else if (p.system == CoverageSystem::FDOA) {
+        equivalentSigma = p.meanSpeed > 0.0 ? p.measurementSigma / p.dopplerScale * meanRange / p.meanSpeed : 0.0;
+    }
+
+    point.rms = std::sqrt(pTrace);
+    point.cep = 0.59 * (sigmaMajor + sigmaMinor);
+    point.gdop = equivalentSigma > 0.0 ? point.rms / equivalentSigma : 0.0;
+    point.valid = std::isfinite(point.rms);
+    return point;
+}
+
+// 纬度方向的逐行量：sinφ、cosφ 和卯酉圈曲率半径
+struct LatitudeRow {
+    double sinLat, cosLat, primeVertical;
+};
+
+LatitudeRow latitudeRow(double latitudeDeg) {
+    LatitudeRow row;
+    const double phi = latitudeDeg * Constants::DEG2RAD;
+    row.sinLat = std::sin(phi);
+    row.cosLat = std::cos(phi);
+    row.primeVertical = Constants::a / std::sqrt(1.0 - Constants::e_squared * row.sinLat * row.sinLat);
+    return row;
+}
+
+CoveragePoint evaluateAt(const PreparedScenario& p, const LatitudeRow& row, double sinLon, double cosLon) {
+    const double nh = row.primeVertical + p.targetAltitude;
+    const double target[3] = {nh * row.cosLat * cosLon,
+                              nh * row.cosLat * sinLon,
+                              (row.primeVertical * (1.0 - Constants::e_squared) + p.targetAltitude) * row.sinLat};
+    const double east[3] = {-sinLon, cosLon, 0.0};
+    const double north[3] = {-row.sinLat * cosLon, -row.sinLat * sinLon, row.cosLat};
+    return evaluatePrepared(p, target, east, north);
+}
+
+std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+// FNV-1a，用于侦察站配置指纹
+struct Fingerprint {
+    std::uint64_t hash = 1469598103934665603ULL;
+    void add(const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+    void add(double value) { add(&value, sizeof(value)); }
+};
+
+std::uint64_t scenarioFingerprint(const CoverageScenario& s) {
+    Fingerprint f;
+    const int system = static_cast<int>(s.system);
+    f.add(&system, sizeof(system));
+    for (const COORD3& station : s.stations) {
+        f.add(station.p1);
+        f.add(station.p2);
+        f.add(station.p3);
+    }
+    f.add(s.targetAltitude);
+    switch (s.system) {
+    case CoverageSystem::TDOA:
+        f.add(s.tdoaSigma);
+        break;
+    case CoverageSystem::FDOA:
+        for (const COORD3& v : s.stationVelocities) {
+            f.add(v.p1);
+            f.add(v.p2);
+            f.add(v.p3);
+        }
+        f.add(s.fdoaSigma);
+        f.add(s.carrierFrequency);
+        break;
+    case CoverageSystem::DF:
+        for (double sigma : s.bearingSigmaDeg) f.add(sigma);
+        break;
+    }
+    return f.hash;
+}
+
+std::uint64_t doubleBits(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+CoveragePoint evaluateCoveragePoint(const CoverageScenario& scenario, double longitude, double latitude) {
+    PreparedScenario prepared;
+    if (!prepareScenario(scenario, prepared)) return CoveragePoint();
+    const double lambda = longitude * Constants::DEG2RAD;
+    return evaluateAt(prepared, latitudeRow(latitude), std::sin(lambda), std::cos(lambda));
+}
+
+CoverageMapEngine& CoverageMapEngine::getInstance() {
+    static CoverageMapEngine instance;
+    return instance;
+}
+
+CoverageMapEngine::CoverageMapEngine(std::size_t cacheCapacity) : m_capacity(cacheCapacity) {}
+
+bool CoverageMapEngine::TileKey::operator==(const TileKey& other) const {
+    return scenario == other.scenario && lonStepBits == other.lonStepBits && latStepBits == other.latStepBits &&
+           tileX == other.tileX && tileY == other.tileY;
+}
+
+std::size_t CoverageMapEngine::TileKeyHash::operator()(const TileKey& key) const {
+    std::uint64_t h = key.scenario;
+    const std::uint64_t parts[] = {key.lonStepBits, key.latStepBits,
+                                   static_cast<std::uint64_t>(key.tileX), static_cast<std::uint64_t>(key.tileY)};
+    for (std::uint64_t part : parts) {
+        h ^= part + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    return static_cast<std::size_t>(h);
+}
+
+std::shared_ptr<const CoverageMapEngine::Tile> CoverageMapEngine::findTile(const TileKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end()) return nullptr;
+    m_tiles.splice(m_tiles.begin(), m_tiles, it->second);
+    return it->second->second;
+}
+
+void CoverageMapEngine::insertTile(const TileKey& key, const std::shared_ptr<const Tile>& tile) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it != m_index.end()) {
+        m_tiles.splice(m_tiles.begin(), m_tiles, it->second);
+        return;
+    }
+    m_tiles.emplace_front(key, tile);
+    m_index[key] = m_tiles.begin();
+    while (m_tiles.size() > m_capacity) {
+        m_index.erase(m_tiles.back().first);
+        m_tiles.pop_back();
+    }
+}
+
+void CoverageMapEngine::setCacheCapacity(std::size_t tiles) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = tiles;
+    while (m_tiles.size() > m_capacity) {
+        m_index.erase(m_tiles.back().first);
+        m_tiles.pop_back();
+    }
+}
+
+void CoverageMapEngine::clearCache() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tiles.clear();
+    m_index.clear();
+}
+
+std::size_t CoverageMapEngine::cachedTileCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tiles.size();
+}
+
+bool CoverageMapEngine::compute(const CoverageScenario& scenario, const CoverageGridSpec& spec, CoverageGrid& grid) {
+    PL_TRACE_SCOPE("Coverage.compute");
+    if (spec.width <= 0 || spec.height <= 0 || !(spec.east > spec.west) || !(spec.north > spec.south)) {
+        PL_LOG_ERROR("覆盖图网格范围或分辨率无效\n");
+        return false;
+    }
+    PreparedScenario prepared;
+    if (!prepareScenario(scenario, prepared)) return false;
+
+    // 对齐到全局像素格网：第 gx 列像素中心经度 (gx+0.5)·Δλ，第 gy 行像素中心纬度 -(gy+0.5)·Δφ
+    const double lonStep = (spec.east - spec.west) / spec.width;
+    const double latStep = (spec.north - spec.south) / spec.height;
+    const std::int64_t gx0 = static_cast<std::int64_t>(std::floor(spec.west / lonStep + 1e-6));
+    const std::int64_t gy0 = static_cast<std::int64_t>(std::floor(-spec.north / latStep + 1e-6));
+
+    grid.width = spec.width;
+    grid.height = spec.height;
+    grid.west = gx0 * lonStep;
+    grid.east = grid.west + spec.width * lonStep;
+    grid.north = -gy0 * latStep;
+    grid.south = grid.north - spec.height * latStep;
+    const std::size_t pixelCount = static_cast<std::size_t>(spec.width) * spec.height;
+    grid.gdop.assign(pixelCount, INVALID);
+    grid.rms.assign(pixelCount, INVALID);
+    grid.cep.assign(pixelCount, INVALID);
+
+    const std::int64_t tx0 = floorDiv(gx0, TILE);
+    const std::int64_t ty0 = floorDiv(gy0, TILE);
+    const std::int64_t tilesX = floorDiv(gx0 + spec.width - 1, TILE) - tx0 + 1;
+    const std::int64_t tilesY = floorDiv(gy0 + spec.height - 1, TILE) - ty0 + 1;
+
+    const std::uint64_t fingerprint = scenarioFingerprint(scenario);
+    std::vector<TileKey> keys(static_cast<std::size_t>(tilesX * tilesY));
+    std::vector<std::shared_ptr<const Tile>> tiles(keys.size());
+    std::vector<std::size_t> missing;
+    for (std::int64_t ty = 0; ty < tilesY; ++ty) {
+        for (std::int64_t tx = 0; tx < tilesX; ++tx) {
+            const std::size_t index = static_cast<std::size_t>(ty * tilesX + tx);
+            keys[index] = TileKey{fingerprint, doubleBits(lonStep), doubleBits(latStep), tx0 + tx, ty0 + ty};
+            tiles[index] = findTile(keys[index]);
+            if (!tiles[index]) missing.push_back(index);
+        }
+    }
+
+    // 缺失的瓦片并行计算，每个瓦片整块计算以便平移后复用
+    parallelFor(missing.size(), spec.threadCount, 1, [&](std::size_t begin, std::size_t end) {
+        std::vector<double> sinLon(TILE), cosLon(TILE);
+        for (std::size_t m = begin; m < end; ++m) {
+            const TileKey& key = keys[missing[m]];
+            auto tile = std::make_shared<Tile>();
+            tile->gdop.assign(TILE * TILE, INVALID);
+            tile->rms.assign(TILE * TILE, INVALID);
+            tile->cep.assign(TILE * TILE, INVALID);
+            for (int c = 0; c < TILE; ++c) {
+                const double lambda = (key.tileX * TILE + c + 0.5) * lonStep * Constants::DEG2RAD;
+                sinLon[c] = std::sin(lambda);
+                cosLon[c] = std::cos(lambda);
+            }
+            for (int r = 0; r < TILE; ++r) {
+                const double latitude = -(key.tileY * TILE + r + 0.5) * latStep;
+                if (std::abs(latitude) > 90.0) continue;
+                const LatitudeRow row = latitudeRow(latitude);
+                for (int c = 0; c < TILE; ++c) {
+                    const CoveragePoint point = evaluateAt(prepared, row, sinLon[c], cosLon[c]);
+                    if (!point.valid) continue;
+                    tile->gdop[r * TILE + c] = static_cast<float>(point.gdop);
+                    tile->rms[r * TILE + c] = static_cast<float>(point.rms);
+                    tile->cep[r * TILE + c] = static_cast<float>(point.cep);
+                }
+            }
+            tiles[missing[m]] = tile;
+        }
+    });
+    for (std::size_t index : missing) {
+        insertTile(keys[index], tiles[index]);
+    }
+
+    // 从瓦片拼接出请求范围
+    parallelFor(static_cast<std::size_t>(spec.height), spec.threadCount, 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t r = begin; r < end; ++r) {
+            const std::int64_t gy = gy0 + static_cast<std::int64_t>(r);
+            const std::int64_t ty = floorDiv(gy, TILE);
+            const std::size_t tileRow = static_cast<std::size_t>(gy - ty * TILE);
+            std::size_t c = 0;
+            while (c < static_cast<std::size_t>(spec.width)) {
+                const std::int64_t gx = gx0 + static_cast<std::int64_t>(c);
+                const std::int64_t tx = floorDiv(gx, TILE);
+                const std::size_t tileCol = static_cast<std::size_t>(gx - tx * TILE);
+                const std::size_t run = std::min<std::size_t>(TILE - tileCol, spec.width - c);
+                const Tile& tile = *tiles[static_cast<std::size_t>((ty - ty0) * tilesX + (tx - tx0))];
+                const std::size_t src = tileRow * TILE + tileCol;
+                const std::size_t dst = r * spec.width + c;
+                std::copy_n(tile.gdop.begin() + src, run, grid.gdop.begin() + dst);
+                std::copy_n(tile.rms.begin() + src, run, grid.rms.begin() + dst);
+                std::copy_n(tile.cep.begin() + src, run, grid.cep.begin() + dst);
+                c += run;
+            }
+        }
+    });
+
+    grid.tilesComputed = missing.size();
+    grid.tilesCached = tiles.size() - missing.size();
+    PL_COUNTER_ADD("coverage.tilesComputed", static_cast<std::int64_t>(grid.tilesComputed));
+    PL_COUNTER_ADD("coverage.tilesCached", static_cast<std::int64_t>(grid.tilesCached));
+    return true;
+}
+
+bool coverageValueRange(const std::vector<float>& values, double& minValue, double& maxValue) {
+    std::vector<float> finite;
+    finite.reserve(values.size());
+    for (float v : values) {
+        if (std::isfinite(v) && v > 0.0f) finite.push_back(v);
+    }
+    if (finite.empty()) return false;
+
+    const std::size_t low = finite.size() * 2 / 100;
+    const std::size_t high = std::min(finite.size() - 1, finite.size() * 98 / 100);
+    std::nth_element(finite.begin(), finite.begin() + low, finite.end());
+    minValue = finite[low];
+    std::nth_element(finite.begin(), finite.begin() + high, finite.end());
+    maxValue = finite[high];
+    if (!(maxValue > minValue)) maxValue = minValue * 1.01;
+    return true;
+}
+
+std::vector<std::uint8_t> colorizeCoverage(const std::vector<float>& values,
+                                           double minValue, double maxValue,
+                                           std::uint8_t alpha) {
+    // 绿-黄-红色带(值越小精度越高)
+    static const double STOPS[5][3] = {
+        {26, 150, 65}, {166, 217, 106}, {255, 255, 191}, {253, 174, 97}, {215, 25, 28}
+    };
+    std::vector<std::uint8_t> rgba(values.size() * 4, 0);
+    if (!(minValue > 0.0) || !(maxValue > minValue)) return rgba;
+
+    const double logMin = std::log(minValue);
+    const double logRange = std::log(maxValue) - logMin;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const float v = values[i];
+        if (!std::isfinite(v) || v <= 0.0f) continue;
+        const double t = std::min(1.0, std::max(0.0, (std::log(v) - logMin) / logRange)) * 4.0;
+        const int k = std::min(3, static_cast<int>(t));
+        const double f = t - k;
+        for (int ch = 0; ch < 3; ++ch) {
+            rgba[i * 4 + ch] = static_cast<std::uint8_t>(STOPS[k][ch] + (STOPS[k + 1][ch] - STOPS[k][ch]) * f + 0.5);
+        }
+        rgba[i * 4 + 3] = alpha;
+    }
+    return rgba;
+}
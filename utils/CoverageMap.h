@@ -0,0 +1,180 @@
+/**
+ * @file CoverageMap.h
+ * @brief 定位精度覆盖图：在经纬度网格上计算侦察站布局的GDOP和克拉美-罗下界(CRLB)
+ *
+ * 目标位于已知高度面内，每个网格点由观测量对目标当地东、北坐标的雅可比求Fisher信息矩阵 F，
+ * CRLB 为 F^-1 (2×2)。时差、频差视为共用参考站的相关测量，协方差为 σ²/2 (I + 11^T)，
+ * 与 tdoaLocate3D 一致；测向各站相互独立。
+ *
+ * 网格对齐到由分辨率确定的全局像素格网并切成瓦片，瓦片按 侦察站配置+分辨率 缓存：
+ * 平移视图或对同一布局重复计算时只计算缺失的瓦片，缺失瓦片并行计算。
+ */
+
+#ifndef COVERAGE_MAP_H
+#define COVERAGE_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "CoordinateTransform.h"
+
+/**
+ * @brief 覆盖图对应的定位体制
+ */
+enum class CoverageSystem {
+    TDOA,  // 时差
+    FDOA,  // 频差(辐射源静止，侦察站运动)
+    DF     // 测向交叉
+};
+
+/**
+ * @brief 侦察站布局和测量误差
+ */
+struct CoverageScenario {
+    CoverageSystem system = CoverageSystem::TDOA;
+    std::vector<COORD3> stations;            // 侦察站大地坐标(经度,纬度,高程)，时差/频差第0个为参考站
+    std::vector<COORD3> stationVelocities;   // 侦察站速度(空间直角坐标分量, m/s)，仅频差体制使用
+    double targetAltitude = 0.0;             // 目标所在高度面(米)
+    double tdoaSigma = 10e-9;                // 时差测量标准差(秒)
+    double fdoaSigma = 0.01;                 // 频差测量标准差(Hz)
+    double carrierFrequency = 1e9;           // 载频(Hz)，仅频差体制使用
+    std::vector<double> bearingSigmaDeg = {1.0};  // 各站测向标准差(度)，只给一个值时各站共用
+};
+
+/**
+ * @brief 单个位置的精度指标
+ *
+ * GDOP = sqrt(tr P) / σ等效，σ等效为单次测量误差折算的距离：时差为 c·σt，
+ * 测向为 σθ·r̄，频差为 (c/f0)·σf·r̄/v̄ (r̄ 为平均站距，v̄ 为侦察站平均速率)。
+ */
+struct CoveragePoint {
+    double gdop = 0.0;   // 几何精度因子(无量纲)
+    double rms = 0.0;    // CRLB水平均方根误差 sqrt(tr P) (米)
+    double cep = 0.0;    // CRLB圆概率误差 0.59(σa+σb) (米)
+    bool valid = false;  // 几何退化(信息矩阵奇异)或与侦察站重合时为false
+};
+
+/**
+ * @brief 计算网格的范围和分辨率
+ */
+struct CoverageGridSpec {
+    double west = 0.0;              // 西边界经度(度)
+    double south = 0.0;             // 南边界纬度(度)
+    double east = 0.0;              // 东边界经度(度)
+    double north = 0.0;             // 北边界纬度(度)
+    int width = 0;                  // 经度方向像素数
+    int height = 0;                 // 纬度方向像素数
+    unsigned int threadCount = 0;   // 线程数，0 表示使用全部硬件线程
+};
+
+/**
+ * @brief 覆盖图计算结果，各数组按行存储，第0行为最北一行，无效点为NaN
+ */
+struct CoverageGrid {
+    double west = 0.0;                // 对齐到全局像素格网后的实际范围(度)，与请求范围相差不超过一个像素
+    double south = 0.0;
+    double east = 0.0;
+    double north = 0.0;
+    int width = 0;
+    int height = 0;
+    std::vector<float> gdop;          // 几何精度因子
+    std::vector<float> rms;           // CRLB水平均方根误差(米)
+    std::vector<float> cep;           // CRLB圆概率误差(米)
+    std::size_t tilesComputed = 0;    // 本次新计算的瓦片数
+    std::size_t tilesCached = 0;      // 本次命中缓存的瓦片数
+};
+
+/**
+ * @brief 计算单个位置的GDOP和CRLB
+ * @param scenario 侦察站布局和测量误差
+ * @param longitude 目标经度(度)
+ * @param latitude 目标纬度(度)，高度取 scenario.targetAltitude
+ */
+CoveragePoint evaluateCoveragePoint(const CoverageScenario& scenario, double longitude, double latitude);
+
+/**
+ * @brief 覆盖图计算引擎，带瓦片缓存(LRU)，可被多个线程同时调用
+ */
+class CoverageMapEngine {
+public:
+    // 瓦片边长(像素)
+    static const int TILE_SIZE = 128;
+
+    // 全局实例，界面和批量工具共用同一缓存
+    static CoverageMapEngine& getInstance();
+
+    /**
+     * @param cacheCapacity 缓存的最大瓦片数(每个瓦片约 TILE_SIZE²×12 字节)
+     */
+    explicit CoverageMapEngine(std::size_t cacheCapacity = 256);
+
+    /**
+     * @brief 计算覆盖图
+     * @param scenario 侦察站布局和测量误差
+     * @param spec 网格范围和分辨率
+     * @param grid 输出结果
+     * @return 参数无效(站数不足、范围为空等)时返回false
+     */
+    bool compute(const CoverageScenario& scenario, const CoverageGridSpec& spec, CoverageGrid& grid);
+
+    void setCacheCapacity(std::size_t tiles);
+    void clearCache();
+    std::size_t cachedTileCount() const;
+
+private:
+    struct TileKey {
+        std::uint64_t scenario;      // 侦察站配置指纹
+        std::uint64_t lonStepBits;   // 像素经度步长的位表示
+        std::uint64_t latStepBits;   // 像素纬度步长的位表示
+        std::int64_t tileX;
+        std::int64_t tileY;
+        bool operator==(const TileKey& other) const;
+    };
+    struct TileKeyHash {
+        std::size_t operator()(const TileKey& key) const;
+    };
+    struct Tile {
+        std::vector<float> gdop;
+        std::vector<float> rms;
+        std::vector<float> cep;
+    };
+    typedef std::list<std::pair<TileKey, std::shared_ptr<const Tile>>> TileList;
+
+    CoverageMapEngine(const CoverageMapEngine&) = delete;
+    CoverageMapEngine& operator=(const CoverageMapEngine&) = delete;
+
+    std::shared_ptr<const Tile> findTile(const TileKey& key);
+    void insertTile(const TileKey& key, const std::shared_ptr<const Tile>& tile);
+
+    mutable std::mutex m_mutex;
+    std::size_t m_capacity;
+    TileList m_tiles;  // 按最近使用排序，表头最新
+    std::unordered_map<TileKey, TileList::iterator, TileKeyHash> m_index;
+};
+
+/**
+ * @brief 取有效值的分位数范围作为着色范围
+ * @param values 指标数组
+ * @param minValue 输出：低分位数(2%)
+ * @param maxValue 输出：高分位数(98%)
+ * @return 没有有效值时返回false
+ */
+bool coverageValueRange(const std::vector<float>& values, double& minValue, double& maxValue);
+
+/**
+ * @brief 将指标按对数刻度映射为RGBA图像(绿色为精度高，红色为精度低)
+ * @param values 指标数组，NaN 映射为全透明
+ * @param minValue 着色范围下限(正数)
+ * @param maxValue 着色范围上限
+ * @param alpha 有效像素的不透明度
+ * @return 与 values 同序的RGBA字节数组
+ */
+std::vector<std::uint8_t> colorizeCoverage(const std::vector<float>& values,
+                                           double minValue, double maxValue,
+                                           std::uint8_t alpha = 160);
+
+#endif // COVERAGE_MAP_H
@@ -0,0 +1,241 @@
+#include "CrossCorrelation.h"
+#include "FFT.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 在 |lag| <= maxLag 内搜索互相关峰值并做抛物线插值。
+// correlation 为长度 fftSize 的循环互相关(负时延在尾部)，
+// 不加权时按重叠样本数 overlap - |lag| 归一化，与直接法一致。
+// 实信号取实部；复基带信号的峰值带有载波相位，取模值
+GccResult searchPeak(const std::complex<double>* correlation, std::size_t fftSize,
+                     std::size_t maxLag, std::size_t overlap, bool complexInput,
+                     const GccOptions& options, double samplingRate) {
+    const long long lagLimit = static_cast<long long>(maxLag);
+    auto valueAt = [&](long long lag) {
+        const std::size_t index = lag >= 0
+            ? static_cast<std::size_t>(lag)
+            : fftSize - static_cast<std::size_t>(-lag);
+        double value = complexInput ? std::abs(correlation[index]) : correlation[index].real();
+        if (options.weighting == GccWeighting::None) {
+            value /= static_cast<double>(overlap - static_cast<std::size_t>(std::llabs(lag)));
+        }
+        return value;
+    };
+
+    long long peakLag = -lagLimit;
+    double peakValue = valueAt(peakLag);
+    for (long long lag = -lagLimit + 1; lag <= lagLimit; ++lag) {
+        const double value = valueAt(lag);
+        if (value > peakValue) {
+            peakValue = value;
+            peakLag = lag;
+        }
+    }
+
+    // 抛物线拟合峰值及左右相邻点，得到亚采样时延
+    double offset = 0.0;
+    if (options.subSampleInterpolation && peakLag > -lagLimit && peakLag < lagLimit) {
+        const double left = valueAt(peakLag - 1);
+        const double right = valueAt(peakLag + 1);
+        const double denom = left - 2.0 * peakValue + right;
+        if (denom < 0.0) {
+            offset = 0.5 * (left - right) / denom;
+            offset = std::max(-0.5, std::min(0.5, offset));
+        }
+    }
+
+    GccResult result;
+    result.delaySamples = static_cast<double>(peakLag) + offset;
+    result.delaySeconds = result.delaySamples / samplingRate;
+    result.peakValue = peakValue;
+    result.valid = true;
+    return result;
+}
+
+} // namespace
+
+GccDelayEstimator::GccDelayEstimator(const GccOptions& options)
+    : m_options(options) {
+}
+
+GccResult GccDelayEstimator::estimate(const std::vector<double>& signal1,
+                                      const std::vector<double>& signal2,
+                                      double samplingRate) {
+    const std::size_t length = std::min(signal1.size(), signal2.size());
+    return estimate(signal1.data(), signal2.data(), length, samplingRate);
+}
+
+GccResult GccDelayEstimator::estimate(const double* signal1, const double* signal2,
+                                      std::size_t length, double samplingRate) {
+    GccResult result;
+    if (length < 2 || samplingRate <= 0.0) {
+        return result;
+    }
+
+    std::size_t maxLag = m_options.maxLag;
+    if (maxLag == 0 || maxLag >= length) {
+        maxLag = length / 2;
+    }
+
+    // 补零到 N + maxLag 以上，保证搜索范围内的时延不受循环卷绕影响
+    const std::size_t fftSize = FFTPlan::nextPowerOfTwo(length + maxLag + 1);
+    std::shared_ptr<const FFTPlan> plan = FFTPlan::get(fftSize);
+
+    // z = s1 + j*s2，一次复FFT同时得到两路频谱
+    m_spectrum.assign(fftSize, std::complex<double>(0.0, 0.0));
+    for (std::size_t i = 0; i < length; ++i) {
+        m_spectrum[i] = std::complex<double>(signal1[i], signal2[i]);
+    }
+    plan->forward(m_spectrum.data());
+
+    const bool needAuto = m_options.weighting == GccWeighting::SCOT;
+    if (needAuto) {
+        m_auto1.assign(fftSize / 2 + 2, 0.0);
+        m_auto2.assign(fftSize / 2 + 2, 0.0);
+    }
+
+    // 由 Z[k] 和 Z[M-k] 分离 X1、X2，互谱 R = X1·conj(X2) 共轭对称，只需计算前半
+    const double eps = m_options.epsilon;
+    for (std::size_t k = 0; k <= fftSize / 2; ++k) {
+        const std::size_t mirror = (fftSize - k) & (fftSize - 1);
+        const std::complex<double> zk = m_spectrum[k];
+        const std::complex<double> zm = std::conj(m_spectrum[mirror]);
+        const std::complex<double> x1 = 0.5 * (zk + zm);
+        const std::complex<double> x2 = std::complex<double>(0.0, -0.5) * (zk - zm);
+
+        std::complex<double> cross = x1 * std::conj(x2);
+        if (m_options.weighting == GccWeighting::PHAT) {
+            cross /= std::max(std::abs(cross), eps);
+        } else if (needAuto) {
+            // 累积自谱前缀和，供 applyScot 做滑动平均
+            m_auto1[k + 1] = m_auto1[k] + std::norm(x1);
+            m_auto2[k + 1] = m_auto2[k] + std::norm(x2);
+        }
+        m_spectrum[k] = cross;
+    }
+
+    if (needAuto) {
+        applyScot(fftSize);
+    }
+
+    for (std::size_t k = 1; k < fftSize / 2; ++k) {
+        m_spectrum[fftSize - k] = std::conj(m_spectrum[k]);
+    }
+    plan->inverse(m_spectrum.data());
+
+    // 互相关 c[lag] = sum s1[i]·s2[i-lag]，负时延位于数组尾部
+    return searchPeak(m_spectrum.data(), fftSize, maxLag, length, false, m_options, samplingRate);
+}
+
+// SCOT加权：R / sqrt(G11·G22)，自谱先沿频率轴滑动平均，
+// 否则单帧估计下与PHAT完全相同
+void GccDelayEstimator::applyScot(std::size_t fftSize) {
+    const std::size_t bins = fftSize / 2 + 1;
+    const std::size_t half = m_options.scotSmoothingBins;
+
+    // m_auto1/m_auto2 为自谱前缀和，窗口在频谱两端截断
+    const double eps = m_options.epsilon;
+    for (std::size_t k = 0; k < bins; ++k) {
+        const std::size_t lo = k > half ? k - half : 0;
+        const std::size_t hi = std::min(bins, k + half + 1);
+        const double count = static_cast<double>(hi - lo);
+        const double g11 = (m_auto1[hi] - m_auto1[lo]) / count;
+        const double g22 = (m_auto2[hi] - m_auto2[lo]) / count;
+        m_spectrum[k] /= std::max(std::sqrt(g11 * g22), eps);
+    }
+}
+
+GccStreamEstimator::GccStreamEstimator(std::size_t frameLength, const GccOptions& options)
+    : m_options(options), m_frameLength(frameLength > 1 ? frameLength : 2), m_fill(0), m_frames(0) {
+    // 帧补零到两倍长度，帧内 ±L 的时延都不受循环卷绕影响
+    m_fftSize = FFTPlan::nextPowerOfTwo(2 * m_frameLength);
+    m_plan = FFTPlan::get(m_fftSize);
+    m_frame1.assign(m_fftSize, std::complex<double>(0.0, 0.0));
+    m_frame2.assign(m_fftSize, std::complex<double>(0.0, 0.0));
+    m_cross.assign(m_fftSize, std::complex<double>(0.0, 0.0));
+    m_auto1.assign(m_fftSize, 0.0);
+    m_auto2.assign(m_fftSize, 0.0);
+}
+
+void GccStreamEstimator::reset() {
+    std::fill(m_cross.begin(), m_cross.end(), std::complex<double>(0.0, 0.0));
+    std::fill(m_auto1.begin(), m_auto1.end(), 0.0);
+    std::fill(m_auto2.begin(), m_auto2.end(), 0.0);
+    m_fill = 0;
+    m_frames = 0;
+}
+
+void GccStreamEstimator::push(const std::complex<float>* signal1, const std::complex<float>* signal2,
+                              std::size_t count) {
+    std::size_t offset = 0;
+    while (offset < count) {
+        const std::size_t take = std::min(count - offset, m_frameLength - m_fill);
+        for (std::size_t i = 0; i < take; ++i) {
+            m_frame1[m_fill + i] = std::complex<double>(signal1[offset + i]);
+            m_frame2[m_fill + i] = std::complex<double>(signal2[offset + i]);
+        }
+        m_fill += take;
+        offset += take;
+        if (m_fill == m_frameLength) {
+            accumulateFrame();
+        }
+    }
+}
+
+// 当前帧做FFT并累加互谱和自谱(Welch平均)
+void GccStreamEstimator::accumulateFrame() {
+    std::fill(m_frame1.begin() + m_fill, m_frame1.end(), std::complex<double>(0.0, 0.0));
+    std::fill(m_frame2.begin() + m_fill, m_frame2.end(), std::complex<double>(0.0, 0.0));
+    m_plan->forward(m_frame1.data());
+    m_plan->forward(m_frame2.data());
+    for (std::size_t k = 0; k < m_fftSize; ++k) {
+        m_cross[k] += m_frame1[k] * std::conj(m_frame2[k]);
+        m_auto1[k] += std::norm(m_frame1[k]);
+        m_auto2[k] += std::norm(m_frame2[k]);
+    }
+    m_fill = 0;
+    ++m_frames;
+}
+
+GccResult GccStreamEstimator::result(double samplingRate) {
+    if (m_fill > 0) {
+        accumulateFrame();
+    }
+    if (m_frames == 0 || samplingRate <= 0.0) {
+        return GccResult();
+    }
+
+    // 平均互谱加权；多帧平均后自谱已足够平滑，SCOT不再做频率平滑。
+    // 过采样时带外只有噪声，PHAT/SCOT 会把它们放大到与带内同等权重，因此先按通带截断
+    const double eps = m_options.epsilon;
+    const double halfBand = 0.5 * std::min(std::max(m_options.passband, 0.0), 1.0) * static_cast<double>(m_fftSize);
+    for (std::size_t k = 0; k < m_fftSize; ++k) {
+        const double bin = k <= m_fftSize / 2 ? static_cast<double>(k)
+                                              : static_cast<double>(m_fftSize - k);
+        std::complex<double> cross = m_cross[k];
+        if (bin > halfBand) {
+            cross = std::complex<double>(0.0, 0.0);
+        } else if (m_options.weighting == GccWeighting::PHAT) {
+            cross /= std::max(std::abs(cross), eps);
+        } else if (m_options.weighting == GccWeighting::SCOT) {
+            cross /= std::max(std::sqrt(m_auto1[k] * m_auto2[k]), eps);
+        } else {
+            cross /= static_cast<double>(m_frames);
+        }
+        m_frame1[k] = cross;
+    }
+    m_plan->inverse(m_frame1.data());
+
+    std::size_t maxLag = m_options.maxLag;
+    if (maxLag == 0 || maxLag >= m_frameLength) {
+        maxLag = m_frameLength / 2;
+    }
+    return searchPeak(m_frame1.data(), m_fftSize, maxLag, m_frameLength, true, m_options, samplingRate);
+}
+
+std::size_t GccStreamEstimator::memoryBytes() const {
+    return (m_frame1.size() + m_frame2.size() + m_cross.size()) * sizeof(std::complex<double>)
+         + (m_auto1.size() + m_auto2.size()) * sizeof(double);
+}
@@ -0,0 +1,141 @@
+/**
+ * @file CrossCorrelation.h
+ * @brief 基于FFT的广义互相关(GCC)时延估计，支持PHAT/SCOT加权和亚采样插值
+ */
+
+#ifndef CROSS_CORRELATION_H
+#define CROSS_CORRELATION_H
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class FFTPlan;
+
+/**
+ * @brief 互谱加权方式
+ */
+enum class GccWeighting {
+    None,   // 普通互相关，按重叠样本数归一化，与直接法结果一致
+    PHAT,   // 相位变换，只保留互谱相位，峰值尖锐，适合宽带信号
+    SCOT    // 平滑相干变换，按两路自谱几何平均归一化
+};
+
+/**
+ * @brief GCC参数
+ */
+struct GccOptions {
+    GccWeighting weighting = GccWeighting::PHAT;
+    std::size_t maxLag = 0;          // 最大搜索时延(采样点)，0 表示取信号长度的一半
+    bool subSampleInterpolation = true;  // 峰值抛物线插值
+    std::size_t scotSmoothingBins = 8;   // SCOT自谱平滑的半窗宽(频点)
+    double epsilon = 1e-12;              // 加权分母的下限，防止除零
+    double passband = 1.0;               // 流式估计中参与计算的带宽占采样率的比例，带外频点置零
+};
+
+/**
+ * @brief GCC结果
+ *
+ * 时延定义为 signal1 相对 signal2 的滞后量：
+ * 若 signal1[i] = signal2[i - d]，则 delaySamples = d。
+ */
+struct GccResult {
+    double delaySamples = 0.0;   // 时延(采样点，含小数部分)
+    double delaySeconds = 0.0;   // 时延(秒)
+    double peakValue = 0.0;      // 相关峰值
+    bool valid = false;
+};
+
+/**
+ * @brief 广义互相关时延估计器
+ *
+ * 复杂度 O(N log N)。两路实信号打包成一路复信号只做一次正变换，
+ * FFT计划按长度全局缓存，工作区随估计器复用，
+ * 对同一长度的重复调用不再分配内存。
+ * 单个估计器不可在多个线程间共享，每个线程各持有一个即可。
+ */
+class GccDelayEstimator {
+public:
+    explicit GccDelayEstimator(const GccOptions& options = GccOptions());
+
+    void setOptions(const GccOptions& options) { m_options = options; }
+    const GccOptions& options() const { return m_options; }
+
+    /**
+     * @brief 估计两路信号的时延
+     * @param signal1 第一路信号
+     * @param signal2 第二路信号
+     * @param length 参与计算的样本数(两路取相同长度)
+     * @param samplingRate 采样率(Hz)
+     */
+    GccResult estimate(const double* signal1, const double* signal2,
+                       std::size_t length, double samplingRate);
+
+    GccResult estimate(const std::vector<double>& signal1,
+                       const std::vector<double>& signal2,
+                       double samplingRate);
+
+private:
+    void applyScot(std::size_t fftSize);
+
+    GccOptions m_options;
+    std::vector<std::complex<double>> m_spectrum;  // 打包信号的频谱，之后复用为互谱/互相关
+    std::vector<double> m_auto1;                   // SCOT用自谱前缀和
+    std::vector<double> m_auto2;
+};
+
+/**
+ * @brief 流式广义互相关：按固定帧长分帧，累加各帧互谱后统一加权求峰
+ *
+ * 用于数据量远大于内存的长时间观测：内存只与帧长有关，与观测时长无关。
+ * 输入为复基带(IQ)样本，时延定义与 GccDelayEstimator 相同；
+ * 可分辨的时延应小于帧长的一半。
+ */
+class GccStreamEstimator {
+public:
+    /**
+     * @param frameLength 帧长(采样点)
+     */
+    GccStreamEstimator(std::size_t frameLength, const GccOptions& options = GccOptions());
+
+    /**
+     * @brief 清空累加的互谱
+     */
+    void reset();
+
+    /**
+     * @brief 追加一段两通道样本，凑满一帧即做FFT并累加
+     */
+    void push(const std::complex<float>* signal1, const std::complex<float>* signal2, std::size_t count);
+
+    /**
+     * @brief 由已累加的互谱估计时延；不足一帧的剩余样本补零后计入
+     */
+    GccResult result(double samplingRate);
+
+    std::size_t frameLength() const { return m_frameLength; }
+    std::size_t framesAccumulated() const { return m_frames; }
+
+    /**
+     * @brief 工作区占用的内存(字节)
+     */
+    std::size_t memoryBytes() const;
+
+private:
+    void accumulateFrame();
+
+    GccOptions m_options;
+    std::size_t m_frameLength;
+    std::size_t m_fftSize;
+    std::shared_ptr<const FFTPlan> m_plan;
+    std::vector<std::complex<double>> m_frame1;
+    std::vector<std::complex<double>> m_frame2;
+    std::vector<std::complex<double>> m_cross;   // 累加互谱 X1·conj(X2)
+    std::vector<double> m_auto1;                 // 累加自谱(SCOT)
+    std::vector<double> m_auto2;
+    std::size_t m_fill;                          // 当前帧已填充的样本数
+    std::size_t m_frames;
+};
+
+#endif // CROSS_CORRELATION_H
@@ -1,9 +1,9 @@
 #include "ErrorCircle.h"
-#include "../models/ReconnaissanceDeviceDAO.h"
-#include "../models/RadiationSourceDAO.h"
+#include "../models/ModelRepository.h"
+#include "../models/DFSolver.h"
+#include "../models/TDOASolver.h"
 #include "CoordinateTransform.h"
-#include <random>
-#include <ctime>
+#include "Log.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
@@ -12,15 +12,12 @@ using namespace Constants;
 
 // 查询设备信息
 bool loadDeviceInfo(const std::vector<std::string>& deviceNames, std::vector<ReconnaissanceDevice>& selectedDevices) {
-    ReconnaissanceDeviceDAO& deviceDAO = ReconnaissanceDeviceDAO::getInstance();
-    std::vector<ReconnaissanceDevice> allDevices = deviceDAO.getAllReconnaissanceDevices();
+    ModelRepository& repository = ModelRepository::getInstance();
     selectedDevices.clear();
     for (const auto& name : deviceNames) {
-        auto it = std::find_if(allDevices.begin(), allDevices.end(), [&](const ReconnaissanceDevice& d) {
-            return d.getDeviceName() == name;
-        });
-        if (it != allDevices.end()) {
-            selectedDevices.push_back(*it);
+        ReconnaissanceDevice device;
+        if (repository.findReconnaissanceDeviceByName(name, device)) {
+            selectedDevices.push_back(device);
         }
     }
     return selectedDevices.size() >= 2;
@@ -28,51 +25,61 @@ bool loadDeviceInfo(const std::vector<std::string>& deviceNames, std::vector<Rec
 
 // 查询辐射源信息
 bool loadSourceInfo(const std::string& sourceName, RadiationSource& source) {
-    RadiationSourceDAO& sourceDAO = RadiationSourceDAO::getInstance();
-    std::vector<RadiationSource> allSources = sourceDAO.getAllRadiationSources();
-    auto it = std::find_if(allSources.begin(), allSources.end(), [&](const RadiationSource& s) {
-        return s.getRadiationName() == sourceName;
-    });
-    if (it != allSources.end()) {
-        source = *it;
-        return true;
-    }
-    return false;
+    return ModelRepository::getInstance().findRadiationSourceByName(sourceName, source);
 }
 
-// 2x2协方差矩阵计算
-static void computeCovariance2x2(const std::vector<COORD3>& deviations, double& cov00, double& cov01, double& cov11) {
-    double meanX = 0, meanY = 0;
-    int n = deviations.size();
+// 将蒙特卡洛偏差样本映射为目标大地高处的空间直角坐标(仅用于显示)
+static std::vector<COORD3> toEstimatedPoints(const COORD3& targetCart, const std::vector<COORD3>& deviations) {
+    // 先得到目标点的大地高
+    COORD3 targetLBH = xyz2lbh(targetCart.p1, targetCart.p2, targetCart.p3);
+    double targetHeight = targetLBH.p3;
+    std::vector<COORD3> estimatedPoints;
+    estimatedPoints.reserve(deviations.size());
     for (const auto& dev : deviations) {
-        meanX += dev.p1;
-        meanY += dev.p2;
+        double estX = targetCart.p1 + dev.p1;
+        double estY = targetCart.p2 + dev.p2;
+        double estZ = targetCart.p3; // 保持高度一致
+        COORD3 estLBH = xyz2lbh(estX, estY, estZ);
+        estimatedPoints.push_back(lbh2xyz(estLBH.p1, estLBH.p2, targetHeight));
     }
-    meanX /= n;
-    meanY /= n;
-    cov00 = cov01 = cov11 = 0;
+    return estimatedPoints;
+}
+
+// 由旧接口的种子参数构造默认仿真参数
+static MonteCarloConfig defaultConfig(unsigned int seed) {
+    MonteCarloConfig config;
+    config.seed = seed;
+    return config;
+}
+
+// 当地东、北方向单位向量(空间直角坐标系)
+static void localEastNorth(const COORD3& positionXyz, Eigen::Vector3d& east, Eigen::Vector3d& north) {
+    const COORD3 lbh = xyz2lbh(positionXyz.p1, positionXyz.p2, positionXyz.p3);
+    const double sl = std::sin(lbh.p1 * DEG2RAD), cl = std::cos(lbh.p1 * DEG2RAD);
+    const double sb = std::sin(lbh.p2 * DEG2RAD), cb = std::cos(lbh.p2 * DEG2RAD);
+    east = Eigen::Vector3d(-sl, cl, 0.0);
+    north = Eigen::Vector3d(-sb * cl, -sb * sl, cb);
+}
+
+// 将东、北向偏差样本映射为目标大地高处的空间直角坐标(仅用于显示)
+static std::vector<COORD3> toEstimatedPointsEN(const COORD3& positionXyz, const std::vector<COORD3>& deviations) {
+    Eigen::Vector3d east, north;
+    localEastNorth(positionXyz, east, north);
+    const double height = xyz2lbh(positionXyz.p1, positionXyz.p2, positionXyz.p3).p3;
+    std::vector<COORD3> estimatedPoints;
+    estimatedPoints.reserve(deviations.size());
     for (const auto& dev : deviations) {
-        double dx = dev.p1 - meanX;
-        double dy = dev.p2 - meanY;
-        cov00 += dx * dx;
-        cov11 += dy * dy;
-        cov01 += dx * dy;
-    }
-    if (n > 1) {
-        cov00 /= (n - 1);
-        cov11 /= (n - 1);
-        cov01 /= (n - 1);
+        const Eigen::Vector3d p = Eigen::Vector3d(positionXyz.p1, positionXyz.p2, positionXyz.p3)
+                                + east * dev.p1 + north * dev.p2;
+        COORD3 estLBH = xyz2lbh(p[0], p[1], p[2]);
+        estimatedPoints.push_back(lbh2xyz(estLBH.p1, estLBH.p2, height));
     }
+    return estimatedPoints;
 }
 
-// 2x2矩阵特征值分解
-static void eigenDecomposition2x2(double cov00, double cov01, double cov11, double& eig1, double& eig2) {
-    double a = cov00, b = cov01, c = cov11;
-    double trace = a + c;
-    double det = a * c - b * b;
-    double temp = std::sqrt(trace * trace - 4 * det);
-    eig1 = (trace + temp) / 2.0;
-    eig2 = (trace - temp) / 2.0;
+// 按站序号取误差参数，个数不足时沿用最后一个
+static double perStation(const std::vector<double>& values, size_t index) {
+    return values.empty() ? 0.0 : values[std::min(index, values.size() - 1)];
 }
 
 // 计算误差圆
@@ -83,6 +90,19 @@ DFResult calculateDFErrorCircle(
     double esm2ErrorMean, double esm2ErrorSigma,
     //随机种子
     unsigned int seed
+) {
+    return calculateDFErrorCircle(deviceNames, sourceName,
+                                  esm1ErrorMean, esm1ErrorSigma,
+                                  esm2ErrorMean, esm2ErrorSigma,
+                                  defaultConfig(seed));
+}
+
+DFResult calculateDFErrorCircle(
+    const std::vector<std::string>& deviceNames,
+    const std::string& sourceName,
+    double esm1ErrorMean, double esm1ErrorSigma,
+    double esm2ErrorMean, double esm2ErrorSigma,
+    const MonteCarloConfig& config
 ) {
     std::vector<ReconnaissanceDevice> selectedDevices;
     RadiationSource source;
@@ -94,88 +114,188 @@ DFResult calculateDFErrorCircle(
     if (!loadSourceInfo(sourceName, source)) {
         return DFResult();
     }
-    // 将设备和辐射源的经纬度转换为直角坐标
-    COORD3 esm1Cart = lbh2xyz(selectedDevices[0].getLongitude(), selectedDevices[0].getLatitude(), selectedDevices[0].getAltitude());
-    COORD3 esm2Cart = lbh2xyz(selectedDevices[1].getLongitude(), selectedDevices[1].getLatitude(), selectedDevices[1].getAltitude());
+    // 将设备和辐射源的经纬度转换为直角坐标，第二站之后的设备沿用第二站的误差参数
+    std::vector<COORD3> stationPos_xyz;
+    for (const auto& device : selectedDevices) {
+        stationPos_xyz.push_back(lbh2xyz(device.getLongitude(), device.getLatitude(), device.getAltitude()));
+    }
     COORD3 targetCart = lbh2xyz(source.getLongitude(), source.getLatitude(), source.getAltitude());
-    // 生成随机误差
-    std::mt19937 gen(seed ? seed : static_cast<unsigned int>(std::time(nullptr)));
-    std::normal_distribution<double> normalDist(0.0, 1.0);
-    std::vector<COORD3> deviations;
-    deviations.reserve(100);
-    // 生成100个误差点
-    for (int i = 0; i < 100; i++) {
-        //计算理论方位角
-        double dx1 = targetCart.p1 - esm1Cart.p1;
-        double dy1 = targetCart.p2 - esm1Cart.p2;
-        double trueBearing1 = atan2(dy1, dx1);
+    return calculateDFErrorCircle(stationPos_xyz, targetCart,
+                                  {esm1ErrorMean, esm2ErrorMean},
+                                  {esm1ErrorSigma, esm2ErrorSigma},
+                                  config);
+}
+
+DFResult calculateDFErrorCircle(
+    const COORD3& esm1Cart,
+    const COORD3& esm2Cart,
+    const COORD3& targetCart,
+    double esm1ErrorMean, double esm1ErrorSigma,
+    double esm2ErrorMean, double esm2ErrorSigma,
+    const MonteCarloConfig& config,
+    DFErrorMode mode
+) {
+    return calculateDFErrorCircle({esm1Cart, esm2Cart}, targetCart,
+                                  {esm1ErrorMean, esm2ErrorMean},
+                                  {esm1ErrorSigma, esm2ErrorSigma},
+                                  config, mode);
+}
+
+DFErrorEllipse calculateDFErrorEllipse(
+    const std::vector<COORD3>& stationPos_xyz,
+    const COORD3& targetCart,
+    const std::vector<double>& errorMeans,
+    const std::vector<double>& errorSigmas
+) {
+    DFErrorEllipse ellipse;
+    if (stationPos_xyz.size() < 2 || errorSigmas.empty()) {
+        return ellipse;
+    }
+
+    Eigen::Vector3d targetEast, targetNorth;
+    localEastNorth(targetCart, targetEast, targetNorth);
+    const Eigen::Vector3d target(targetCart.p1, targetCart.p2, targetCart.p3);
 
-        double dx2 = targetCart.p1 - esm2Cart.p1;
-        double dy2 = targetCart.p2 - esm2Cart.p2;
-        double trueBearing2 = atan2(dy2, dx2);
-        // 转换误差单位为弧度
-        double esm1MeanRad = esm1ErrorMean * DEG2RAD;
-        double esm1SigmaRad = esm1ErrorSigma * DEG2RAD;
-        double esm2MeanRad = esm2ErrorMean * DEG2RAD;
-        double esm2SigmaRad = esm2ErrorSigma * DEG2RAD;
-        //生成截断高斯分布误差(范围: [-3σ, 3σ])
-        double error1, error2;
-        //生成误差1
-        do {
-            error1 = esm1MeanRad + esm1SigmaRad * normalDist(gen);
-        } while (fabs(error1 - esm1MeanRad) > 3.0 * esm1SigmaRad);
-        //生成误差2
-        do {
-            error2 = esm2MeanRad + esm2SigmaRad * normalDist(gen);
-        } while (fabs(error2 - esm2MeanRad) > 3.0 * esm2SigmaRad);
-        //计算带误差的测量方位角
-        double measuredBearing1 = trueBearing1 + error1;
-        double measuredBearing2 = trueBearing2 + error2;
-        //计算定位点
-        double m1 = tan(measuredBearing1);
-        double m2 = tan(measuredBearing2);
-        double x, y;
-        if (fabs(m1) > 1e6) {
-            x = esm1Cart.p1;
-            y = m2 * (x - esm2Cart.p1) + esm2Cart.p2;
-        } else if (fabs(m2) > 1e6) {
-            x = esm2Cart.p1;
-            y = m1 * (x - esm1Cart.p1) + esm1Cart.p2;
-        } else {
-            x = (m1 * esm1Cart.p1 - m2 * esm2Cart.p1 + esm2Cart.p2 - esm1Cart.p2) / (m1 - m2);
-            y = m1 * (x - esm1Cart.p1) + esm1Cart.p2;
+    // 信息矩阵 J^T W J 与 J^T W μ，J 为各站方位角对目标东、北向位移的偏导
+    Eigen::Matrix2d F = Eigen::Matrix2d::Zero();
+    Eigen::Vector2d g = Eigen::Vector2d::Zero();
+    for (size_t i = 0; i < stationPos_xyz.size(); ++i) {
+        const COORD3& station = stationPos_xyz[i];
+        Eigen::Vector3d east, north;
+        localEastNorth(station, east, north);
+        const Eigen::Vector3d d = target - Eigen::Vector3d(station.p1, station.p2, station.p3);
+        const double e = east.dot(d);
+        const double n = north.dot(d);
+        const double rho2 = e * e + n * n;
+        if (rho2 < 1.0) {
+            return ellipse;  // 目标与侦察站重合
         }
-        //计算偏差
-        double dx = x - targetCart.p1;
-        double dy = y - targetCart.p2;
-        deviations.push_back(COORD3(dx, dy, 0.0));
+        // 方位角 θ = atan2(e, n) 在空间直角坐标系中的梯度
+        const Eigen::Vector3d gradient = (n / rho2) * east - (e / rho2) * north;
+        const Eigen::Vector2d J(gradient.dot(targetEast), gradient.dot(targetNorth));
+        // 标准差为0时仍需有限权重
+        const double sigma = std::max(perStation(errorSigmas, i), 1e-6) * DEG2RAD;
+        const double w = 1.0 / (sigma * sigma);
+        F.noalias() += w * J * J.transpose();
+        g.noalias() += w * perStation(errorMeans, i) * DEG2RAD * J;
     }
-    // 计算协方差矩阵
-    double cov00, cov01, cov11;
-    computeCovariance2x2(deviations, cov00, cov01, cov11);
-    // 计算特征值(误差椭圆参数)
-    double eig1, eig2;
-    eigenDecomposition2x2(cov00, cov01, cov11, eig1, eig2);
-    double majorAxis = std::sqrt(std::max(eig1, eig2));
-    double minorAxis = std::sqrt(std::min(eig1, eig2));
-    double cepRadius = 0.59 * (majorAxis + minorAxis);
-    // 先得到目标点的大地高
-    COORD3 targetLBH = xyz2lbh(targetCart.p1, targetCart.p2, targetCart.p3);
-    double targetHeight = targetLBH.p3;
-    // 将误差点转换为COORD3
-    std::vector<COORD3> estimatedPoints;
-    estimatedPoints.reserve(100);
-    for (const auto& dev : deviations) {
-        double estX = targetCart.p1 + dev.p1;
-        double estY = targetCart.p2 + dev.p2;
-        double estZ = targetCart.p3; // 保持高度一致
-        COORD3 estLBH = xyz2lbh(estX, estY, estZ); // 这里必须传 X, Y, Z
-        double estLon = estLBH.p1;
-        double estLat = estLBH.p2;
-        COORD3 estXYZ = lbh2xyz(estLon, estLat, targetHeight); // targetHeight 是目标点大地高
-        estimatedPoints.push_back(estXYZ);
+
+    const double trace = F.trace();
+    if (!(trace > 0.0) || !(F.determinant() > 1e-12 * trace * trace)) {
+        return ellipse;  // 测向线近似平行
+    }
+
+    ellipse.covariance = F.inverse();
+    const Eigen::Vector2d bias = ellipse.covariance * g;
+    ellipse.biasEast = bias[0];
+    ellipse.biasNorth = bias[1];
+
+    const Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d> eig(ellipse.covariance);
+    ellipse.minorAxis = std::sqrt(std::max(0.0, eig.eigenvalues()[0]));
+    ellipse.majorAxis = std::sqrt(std::max(0.0, eig.eigenvalues()[1]));
+    const Eigen::Vector2d axis = eig.eigenvectors().col(1);
+    ellipse.orientation = std::atan2(axis[0], axis[1]) * RAD2DEG;
+    if (ellipse.orientation < 0.0) ellipse.orientation += 180.0;
+    if (ellipse.orientation >= 180.0) ellipse.orientation -= 180.0;
+    ellipse.cep = 0.59 * (ellipse.majorAxis + ellipse.minorAxis);
+    ellipse.valid = true;
+    return ellipse;
+}
+
+DFResult calculateDFErrorCircle(
+    const std::vector<COORD3>& stationPos_xyz,
+    const COORD3& targetCart,
+    const std::vector<double>& errorMeans,
+    const std::vector<double>& errorSigmas,
+    const MonteCarloConfig& config,
+    DFErrorMode mode
+) {
+    DFResult result;
+    const size_t parameterCount = std::min(errorMeans.size(), errorSigmas.size());
+    if (parameterCount < stationPos_xyz.size()) {
+        PL_LOG_WARN("[测向误差圆] 给出 %zu 组测向误差参数，侦察站 %zu 个，第 %zu 站起沿用最后一组参数\n",
+                    parameterCount, stationPos_xyz.size(), parameterCount + 1);
+    }
+    result.ellipse = calculateDFErrorEllipse(stationPos_xyz, targetCart, errorMeans, errorSigmas);
+
+    if (mode == DFErrorMode::Analytic) {
+        if (!result.ellipse.valid) {
+            return result;
+        }
+        const Eigen::Matrix2d Pen = result.ellipse.covariance + 1e-12 * Eigen::Matrix2d::Identity();
+        Eigen::LLT<Eigen::Matrix2d> llt(Pen);
+        if (llt.info() != Eigen::Success) {
+            return result;
+        }
+        const Eigen::Matrix2d L = llt.matrixL();
+        const Eigen::Vector2d bias(result.ellipse.biasEast, result.ellipse.biasNorth);
+
+        // 误差点只用于显示，只生成需要保留的数量
+        MonteCarloConfig displayConfig = config;
+        displayConfig.sampleCount = std::min(config.sampleCount, config.keepSamples);
+        auto trial = [&](RandomStream& gen, double& dx, double& dy) -> bool {
+            // 分两条语句取数，保证取数顺序与编译器无关
+            const double z0 = gen.normal();
+            const double z1 = gen.normal();
+            const Eigen::Vector2d e = bias + L * Eigen::Vector2d(z0, z1);
+            dx = e[0];  // 东向偏差
+            dy = e[1];  // 北向偏差
+            return true;
+        };
+        result.stats = MonteCarloEngine::run(displayConfig, trial);
+
+        // 置信度不为0.5时按圆正态分布的分位数比例缩放；均值误差带来的偏差按平方和叠加(近似，见头文件说明)
+        const double p = std::min(std::max(config.confidence, 1e-6), 1.0 - 1e-6);
+        const double radius = result.ellipse.cep * std::sqrt(-2.0 * std::log(1.0 - p) / (2.0 * std::log(2.0)));
+        result.cepRadius = std::sqrt(radius * radius + bias.squaredNorm());
+    } else {
+        // 蒙特卡洛验证：扰动各站方位角后用加权最小二乘重新定位，目标高度取真值
+        const COORD3 targetLBH = xyz2lbh(targetCart.p1, targetCart.p2, targetCart.p3);
+        Eigen::Vector3d targetEast, targetNorth;
+        localEastNorth(targetCart, targetEast, targetNorth);
+        std::vector<DFBearing> bearings(stationPos_xyz.size());
+        std::vector<double> means(stationPos_xyz.size()), sigmas(stationPos_xyz.size());
+        for (size_t i = 0; i < stationPos_xyz.size(); ++i) {
+            const COORD3& station = stationPos_xyz[i];
+            Eigen::Vector3d east, north;
+            localEastNorth(station, east, north);
+            const Eigen::Vector3d d(targetCart.p1 - station.p1, targetCart.p2 - station.p2, targetCart.p3 - station.p3);
+            bearings[i].station = xyz2lbh(station.p1, station.p2, station.p3);
+            bearings[i].azimuth = std::atan2(east.dot(d), north.dot(d)) * RAD2DEG;
+            means[i] = perStation(errorMeans, i);
+            sigmas[i] = perStation(errorSigmas, i);
+            bearings[i].azimuthSigma = std::max(sigmas[i], 1e-3);
+        }
+        DFSolverOptions options;
+        options.knownAltitude = targetLBH.p3;
+        options.quiet = true;  // 试验在工作线程上并行执行，失败次数在结束后汇总输出一次
+
+        auto trial = [&](RandomStream& gen, double& dx, double& dy) -> bool {
+            std::vector<DFBearing> measured = bearings;
+            for (size_t i = 0; i < measured.size(); ++i) {
+                measured[i].azimuth += gen.normal(means[i], sigmas[i]);
+            }
+            const DFSolution solution = dfLocateWLS(measured, options);
+            if (!solution.valid) {
+                return false;
+            }
+            const Eigen::Vector3d d(solution.position.p1 - targetCart.p1,
+                                    solution.position.p2 - targetCart.p2,
+                                    solution.position.p3 - targetCart.p3);
+            dx = targetEast.dot(d);
+            dy = targetNorth.dot(d);
+            return true;
+        };
+        result.stats = MonteCarloEngine::run(config, trial);
+        result.cepRadius = result.stats.confidenceRadius;
+        const std::size_t failed = result.stats.completedSamples - result.stats.validSamples;
+        if (failed > 0) {
+            PL_LOG_WARN("[测向误差圆] %zu/%zu 次试验测向定位无解(测向线近似平行或几何退化)，已剔除\n",
+                        failed, result.stats.completedSamples);
+        }
     }
-    return {estimatedPoints, cepRadius};
+    result.estimatedPoints = toEstimatedPointsEN(targetCart, result.stats.samples);
+    return result;
 }
 
 // 计算TDOA误差圆
@@ -185,6 +305,16 @@ TDOAResult calculateTDOAErrorCircle(
     double tdoaRmsError,
     double esmToaError,
     unsigned int seed
+) {
+    return calculateTDOAErrorCircle(deviceNames, sourceName, tdoaRmsError, esmToaError, defaultConfig(seed));
+}
+
+TDOAResult calculateTDOAErrorCircle(
+    const std::vector<std::string>& deviceNames,
+    const std::string& sourceName,
+    double tdoaRmsError,
+    double esmToaError,
+    const MonteCarloConfig& config
 ) {
     std::vector<ReconnaissanceDevice> selectedDevices;
     RadiationSource source;
@@ -206,94 +336,85 @@ TDOAResult calculateTDOAErrorCircle(
     }
     
     COORD3 targetCart = lbh2xyz(source.getLongitude(), source.getLatitude(), source.getAltitude());
-    
-    // 生成随机误差
-    std::mt19937 gen(seed ? seed : static_cast<unsigned int>(std::time(nullptr)));
-    std::normal_distribution<double> normalDist(0.0, 1.0);
-    
-    // 计算TDOA值（用于生成误差）
-    std::vector<double> true_tdoas(selectedDevices.size(), 0.0);
-    for (size_t i = 1; i < selectedDevices.size(); ++i) {
-        double dist_i = std::sqrt(
-            std::pow(stationPos_xyz[i].p1 - targetCart.p1, 2) +
-            std::pow(stationPos_xyz[i].p2 - targetCart.p2, 2) +
-            std::pow(stationPos_xyz[i].p3 - targetCart.p3, 2)
-        );
-        double dist_0 = std::sqrt(
-            std::pow(stationPos_xyz[0].p1 - targetCart.p1, 2) +
-            std::pow(stationPos_xyz[0].p2 - targetCart.p2, 2) +
-            std::pow(stationPos_xyz[0].p3 - targetCart.p3, 2)
-        );
-        true_tdoas[i] = (dist_i - dist_0) / Constants::c;
+    return calculateTDOAErrorCircle(stationPos_xyz, targetCart, tdoaRmsError, esmToaError, config);
+}
+
+TDOAResult calculateTDOAErrorCircle(
+    const std::vector<COORD3>& stationPos_xyz,
+    const COORD3& targetCart,
+    double tdoaRmsError,
+    double esmToaError,
+    const MonteCarloConfig& config
+) {
+    (void)esmToaError;
+    if (stationPos_xyz.size() < 2) {
+        return TDOAResult();
     }
     
     // 计算基线方向（用于确定误差椭圆主轴方向）
     double baselineX = stationPos_xyz[1].p1 - stationPos_xyz[0].p1;
     double baselineY = stationPos_xyz[1].p2 - stationPos_xyz[0].p2;
     double baselineAngle = std::atan2(baselineY, baselineX);
-    
-    // 生成100个误差点
-    std::vector<COORD3> deviations;
-    deviations.reserve(100);
+    // 旋转到基线垂直方向（TDOA误差椭圆主轴垂直于基线方向）
+    double perpendicularAngle = baselineAngle + Constants::PI / 2.0;
+    const double cosA = std::cos(perpendicularAngle);
+    const double sinA = std::sin(perpendicularAngle);
     
     // 设置误差椭圆参数
     // TDOA误差特性：误差椭圆而非圆形，沿着基线垂直方向误差较大
     double tdoaErrorMeters = tdoaRmsError * Constants::c; // 将时间误差转换为距离误差
-    double majorAxisStdDev = tdoaErrorMeters * 3.0; // 主轴标准差
-    double minorAxisStdDev = tdoaErrorMeters * 1.5; // 次轴标准差
+    const double majorAxisStdDev = tdoaErrorMeters * 3.0; // 主轴标准差
+    const double minorAxisStdDev = tdoaErrorMeters * 1.5; // 次轴标准差
     
-    for (int i = 0; i < 100; i++) {
-        // 生成标准正态分布的随机数
-        double u1 = normalDist(gen);
-        double u2 = normalDist(gen);
-        
+    auto trial = [&](RandomStream& gen, double& dx, double& dy) -> bool {
         // 在椭圆坐标系中生成点
-        double r = majorAxisStdDev * u1;
-        double s = minorAxisStdDev * u2;
-        
-        // 旋转到基线垂直方向（TDOA误差椭圆主轴垂直于基线方向）
-        double perpendicularAngle = baselineAngle + Constants::PI / 2.0;
-        double dx = r * std::cos(perpendicularAngle) - s * std::sin(perpendicularAngle);
-        double dy = r * std::sin(perpendicularAngle) + s * std::cos(perpendicularAngle);
-        
-        deviations.push_back(COORD3(dx, dy, 0.0));
-    }
-    
-    // 计算协方差矩阵
-    double cov00, cov01, cov11;
-    computeCovariance2x2(deviations, cov00, cov01, cov11);
-    
-    // 计算特征值(误差椭圆参数)
-    double eig1, eig2;
-    eigenDecomposition2x2(cov00, cov01, cov11, eig1, eig2);
-    double majorAxis = std::sqrt(std::max(eig1, eig2));
-    double minorAxis = std::sqrt(std::min(eig1, eig2));
-    double cepRadius = 0.59 * (majorAxis + minorAxis);
-    
-    // 先得到目标点的大地高
-    COORD3 targetLBH = xyz2lbh(targetCart.p1, targetCart.p2, targetCart.p3);
-    double targetHeight = targetLBH.p3;
-    
-    // 将误差点转换为COORD3
-    std::vector<COORD3> estimatedPoints;
-    estimatedPoints.reserve(100);
-    for (const auto& dev : deviations) {
-        double estX = targetCart.p1 + dev.p1;
-        double estY = targetCart.p2 + dev.p2;
-        double estZ = targetCart.p3; // 保持高度一致
-        COORD3 estLBH = xyz2lbh(estX, estY, estZ);
-        double estLon = estLBH.p1;
-        double estLat = estLBH.p2;
-        COORD3 estXYZ = lbh2xyz(estLon, estLat, targetHeight);
-        estimatedPoints.push_back(estXYZ);
-    }
+        double r = majorAxisStdDev * gen.normal();
+        double s = minorAxisStdDev * gen.normal();
+        dx = r * cosA - s * sinA;
+        dy = r * sinA + s * cosA;
+        return true;
+    };
     
-    return TDOAResult(estimatedPoints, cepRadius);
+    TDOAResult result;
+    result.stats = MonteCarloEngine::run(config, trial);
+    result.cepRadius = result.stats.confidenceRadius;
+    result.estimatedPoints = toEstimatedPoints(targetCart, result.stats.samples);
+    return result;
 }
 
+TDOAResult calculateTDOAErrorCircle(
+    const COORD3& positionXyz,
+    const Eigen::Matrix3d& covarianceXyz,
+    const MonteCarloConfig& config
+) {
+    // 当地东、北方向单位向量
+    Eigen::Vector3d east, north;
+    localEastNorth(positionXyz, east, north);
+    Eigen::Matrix<double, 2, 3> R;
+    R << east.transpose(), north.transpose();
 
+    // 水平误差协方差的Cholesky分解，用于生成相关的东、北向误差
+    const Eigen::Matrix2d Pen = R * covarianceXyz * R.transpose() + 1e-12 * Eigen::Matrix2d::Identity();
+    Eigen::LLT<Eigen::Matrix2d> llt(Pen);
+    if (llt.info() != Eigen::Success) {
+        return TDOAResult();
+    }
+    const Eigen::Matrix2d L = llt.matrixL();
 
+    auto trial = [&](RandomStream& gen, double& dx, double& dy) -> bool {
+        const double z0 = gen.normal();
+        const double z1 = gen.normal();
+        const Eigen::Vector2d z(z0, z1);
+        const Eigen::Vector2d e = L * z;
+        dx = e[0];  // 东向偏差
+        dy = e[1];  // 北向偏差
+        return true;
+    };
 
-
-
-
+    TDOAResult result;
+    result.stats = MonteCarloEngine::run(config, trial);
+    // CEP由协方差解析给出，采样统计量保留在stats中作为验证
+    result.cepRadius = horizontalCEP(covarianceXyz, positionXyz);
+    result.estimatedPoints = toEstimatedPointsEN(positionXyz, result.stats.samples);
+    return result;
+}
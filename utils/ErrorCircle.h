@@ -2,12 +2,41 @@
 #include <vector>
 #include <string>
 #include "CoordinateTransform.h"
+#include "MonteCarloEngine.h"
+#include <Eigen/Dense>
 #include "../constants/PhysicsConstants.h"
 
-// 测向定位结果结构体
+// 测向定位水平误差椭圆(由测向雅可比在目标真值处线性化解析计算)
+struct DFErrorEllipse {
+    Eigen::Matrix2d covariance = Eigen::Matrix2d::Zero();  // 东、北向误差协方差(米^2)
+    double biasEast = 0.0;     // 测向均值误差引起的东向定位偏差(米)
+    double biasNorth = 0.0;    // 测向均值误差引起的北向定位偏差(米)
+    double majorAxis = 0.0;    // 长半轴(1σ，米)
+    double minorAxis = 0.0;    // 短半轴(1σ，米)
+    double orientation = 0.0;  // 长轴方位角(度，正北起顺时针)
+    double cep = 0.0;          // 圆概率误差 0.59(σa+σb)(米)，不含偏差
+    bool valid = false;        // 测向线近似平行等几何退化时为false
+};
+
+// 测向误差圆的计算方式
+enum class DFErrorMode {
+    Analytic,  // 解析误差椭圆，误差点由椭圆分布生成，仅用于显示
+    Sampling   // 蒙特卡洛验证：逐次扰动测向值并用加权最小二乘重新定位，CEP取采样分位数
+};
+
+/**
+ * @brief 测向定位结果结构体
+ *
+ * 解析方式下 cepRadius = sqrt(r² + |b|²)：r 为零均值误差椭圆在给定置信度下的圆半径，
+ * b 为测向均值误差引起的定位偏差。偏差与随机误差按平方和(RSS)叠加只是近似：
+ * 均值误差为0时与解析分位半径一致，否则与偏移椭圆的真实分位半径有差别；
+ * 需要准确分位半径时使用 DFErrorMode::Sampling。
+ */
 struct DFResult {
-    std::vector<COORD3> estimatedPoints;  // 100个误差点(空间直角坐标)
-    double cepRadius;                     // 误差圆半径(米)
+    std::vector<COORD3> estimatedPoints;  // 用于显示的误差点(空间直角坐标)
+    double cepRadius;                     // 误差圆半径(米)，即给定置信度下的径向误差(解析方式含偏差的RSS近似)
+    MonteCarloStats stats;                // 蒙特卡洛统计信息
+    DFErrorEllipse ellipse;               // 解析误差椭圆(两种计算方式都会给出)
     DFResult() : cepRadius(0.0) {}
     DFResult(const std::vector<COORD3>& points, double radius)
         : estimatedPoints(points), cepRadius(radius) {}
@@ -15,14 +44,16 @@ struct DFResult {
 
 // 时差定位结果结构体
 struct TDOAResult {
-    std::vector<COORD3> estimatedPoints;  // 100个误差点(空间直角坐标)
-    double cepRadius;                     // 误差圆半径(米)
+    std::vector<COORD3> estimatedPoints;  // 用于显示的误差点(空间直角坐标)
+    double cepRadius;                     // 误差圆半径(米)，即给定置信度下的径向误差
+    MonteCarloStats stats;                // 蒙特卡洛统计信息
     TDOAResult() : cepRadius(0.0) {}
     TDOAResult(const std::vector<COORD3>& points, double radius)
         : estimatedPoints(points), cepRadius(radius) {}
 };
 
-// 测向体制误差圆计算函数
+// 测向体制误差圆计算函数(默认参数的蒙特卡洛仿真)
+// 按名称查询全部侦察站；前两站分别使用 esm1/esm2 参数，第三站起沿用 esm2 参数并输出警告日志
 DFResult calculateDFErrorCircle(
     const std::vector<std::string>& deviceNames,
     const std::string& sourceName,
@@ -33,7 +64,59 @@ DFResult calculateDFErrorCircle(
     unsigned int seed = 0
 );
 
-// 时差体制误差圆计算函数
+// 测向体制误差圆计算函数(指定试验次数、置信度和时间预算；误差参数分配同上)
+DFResult calculateDFErrorCircle(
+    const std::vector<std::string>& deviceNames,
+    const std::string& sourceName,
+    double esm1ErrorMean,
+    double esm1ErrorSigma,
+    double esm2ErrorMean,
+    double esm2ErrorSigma,
+    const MonteCarloConfig& config
+);
+
+// 测向体制误差圆计算函数(直接给定空间直角坐标，不访问数据库)
+DFResult calculateDFErrorCircle(
+    const COORD3& esm1Cart,
+    const COORD3& esm2Cart,
+    const COORD3& targetCart,
+    double esm1ErrorMean,
+    double esm1ErrorSigma,
+    double esm2ErrorMean,
+    double esm2ErrorSigma,
+    const MonteCarloConfig& config,
+    DFErrorMode mode = DFErrorMode::Analytic
+);
+
+// 测向体制误差圆计算函数(N站，各站误差参数单位为度；参数个数少于站数时其余站沿用最后一个，并输出警告日志)
+DFResult calculateDFErrorCircle(
+    const std::vector<COORD3>& stationPos_xyz,
+    const COORD3& targetCart,
+    const std::vector<double>& errorMeans,
+    const std::vector<double>& errorSigmas,
+    const MonteCarloConfig& config,
+    DFErrorMode mode = DFErrorMode::Analytic
+);
+
+/**
+ * @brief 测向定位水平误差椭圆的解析计算
+ *
+ * 各站方位角在侦察站当地东-北-天坐标系中定义，对目标东、北向位移求雅可比 J，
+ * 协方差为 (J^T W J)^-1，W 为各站 1/σ²；均值误差经 (J^T W J)^-1 J^T W 映射为定位偏差。
+ * 每个目标点的计算量与站数成正比。
+ * @param stationPos_xyz 侦察站空间直角坐标，至少2站
+ * @param targetCart 目标真值(空间直角坐标)
+ * @param errorMeans 各站测向均值误差(度)，个数少于站数时其余站沿用最后一个
+ * @param errorSigmas 各站测向标准差(度)，个数少于站数时其余站沿用最后一个
+ */
+DFErrorEllipse calculateDFErrorEllipse(
+    const std::vector<COORD3>& stationPos_xyz,
+    const COORD3& targetCart,
+    const std::vector<double>& errorMeans,
+    const std::vector<double>& errorSigmas
+);
+
+// 时差体制误差圆计算函数(默认参数的蒙特卡洛仿真)
 TDOAResult calculateTDOAErrorCircle(
     const std::vector<std::string>& deviceNames,
     const std::string& sourceName,
@@ -41,3 +124,28 @@ TDOAResult calculateTDOAErrorCircle(
     double esmToaError,
     unsigned int seed = 0
 );
+
+// 时差体制误差圆计算函数(指定试验次数、置信度和时间预算)
+TDOAResult calculateTDOAErrorCircle(
+    const std::vector<std::string>& deviceNames,
+    const std::string& sourceName,
+    double tdoaRmsError,
+    double esmToaError,
+    const MonteCarloConfig& config
+);
+
+// 时差体制误差圆计算函数(由定位协方差解析计算CEP，采样点仅用于显示和验证)
+TDOAResult calculateTDOAErrorCircle(
+    const COORD3& positionXyz,
+    const Eigen::Matrix3d& covarianceXyz,
+    const MonteCarloConfig& config
+);
+
+// 时差体制误差圆计算函数(直接给定空间直角坐标，不访问数据库)
+TDOAResult calculateTDOAErrorCircle(
+    const std::vector<COORD3>& stationPos_xyz,
+    const COORD3& targetCart,
+    double tdoaRmsError,
+    double esmToaError,
+    const MonteCarloConfig& config
+);
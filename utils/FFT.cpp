@@ -0,0 +1,107 @@
+#include "FFT.h"
+#include <cmath>
+#include <list>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+std::size_t FFTPlan::nextPowerOfTwo(std::size_t n) {
+    std::size_t size = 1;
+    while (size < n) size <<= 1;
+    return size;
+}
+
+namespace {
+
+// 缓存的计划数：实际使用的长度只有少数几种2的幂，超出时淘汰最久未用的计划
+const std::size_t PLAN_CACHE_CAPACITY = 8;
+
+} // namespace
+
+std::shared_ptr<const FFTPlan> FFTPlan::get(std::size_t n) {
+    typedef std::list<std::pair<std::size_t, std::shared_ptr<const FFTPlan>>> PlanList;
+    static std::mutex cacheMutex;
+    static PlanList plans;  // 按最近使用排序，表头最新
+    static std::map<std::size_t, PlanList::iterator> index;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = index.find(n);
+    if (it != index.end()) {
+        plans.splice(plans.begin(), plans, it->second);
+        return it->second->second;
+    }
+    auto plan = std::make_shared<const FFTPlan>(n);
+    plans.emplace_front(n, plan);
+    index[n] = plans.begin();
+    // 被淘汰的计划由仍持有它的调用方继续使用，最后一个引用释放时销毁
+    while (plans.size() > PLAN_CACHE_CAPACITY) {
+        index.erase(plans.back().first);
+        plans.pop_back();
+    }
+    return plan;
+}
+
+FFTPlan::FFTPlan(std::size_t n) : m_size(n) {
+    if (n == 0 || (n & (n - 1)) != 0) {
+        throw std::invalid_argument("FFTPlan: 变换长度必须是2的幂");
+    }
+    // 按级存放旋转因子：第 len 级的 len/2 个因子连续存放在偏移 len/2-1 处，
+    // 蝶形内层循环顺序访问，大长度时不再跨步读取。直接由三角函数计算，避免递推累积误差
+    const double PI = 3.14159265358979323846;
+    m_twiddles.resize(n > 1 ? n - 1 : 0);
+    for (std::size_t half = 1; half < n; half <<= 1) {
+        std::complex<double>* stage = m_twiddles.data() + half - 1;
+        for (std::size_t k = 0; k < half; ++k) {
+            const double angle = -PI * static_cast<double>(k) / static_cast<double>(half);
+            stage[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+    }
+}
+
+void FFTPlan::forward(std::complex<double>* data) const {
+    transform(data, false);
+}
+
+void FFTPlan::inverse(std::complex<double>* data) const {
+    transform(data, true);
+    const double scale = 1.0 / static_cast<double>(m_size);
+    for (std::size_t i = 0; i < m_size; ++i) {
+        data[i] *= scale;
+    }
+}
+
+void FFTPlan::transform(std::complex<double>* data, bool inverse) const {
+    const std::size_t n = m_size;
+    if (n < 2) return;
+
+    // 位反转重排
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+
+    // 迭代蝶形运算；逆变换使用共轭旋转因子
+    const double sign = inverse ? -1.0 : 1.0;
+    for (std::size_t half = 1; half < n; half <<= 1) {
+        const std::complex<double>* stage = m_twiddles.data() + half - 1;
+        for (std::size_t start = 0; start < n; start += 2 * half) {
+            std::complex<double>* a = data + start;
+            std::complex<double>* b = a + half;
+            for (std::size_t k = 0; k < half; ++k) {
+                const double wr = stage[k].real();
+                const double wi = sign * stage[k].imag();
+                // 手工展开复数乘法，避免 std::complex 乘法的NaN/Inf检查开销
+                const double re = b[k].real() * wr - b[k].imag() * wi;
+                const double im = b[k].real() * wi + b[k].imag() * wr;
+                const std::complex<double> t(re, im);
+                b[k] = a[k] - t;
+                a[k] += t;
+            }
+        }
+    }
+}
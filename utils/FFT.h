@@ -0,0 +1,54 @@
+/**
+ * @file FFT.h
+ * @brief 基2快速傅里叶变换，变换计划(旋转因子)按长度缓存复用
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief 固定长度的FFT计划
+ *
+ * 长度必须是2的幂。计划创建后只读，可被多个线程同时使用。
+ * 通过 FFTPlan::get() 获取，最近使用的几种长度的计划缓存在进程内(LRU)，不会随长度种类无限增长。
+ */
+class FFTPlan {
+public:
+    /**
+     * @brief 获取指定长度的计划(线程安全，按长度做LRU缓存，最多保留8个)
+     * @param n 变换长度，必须是2的幂
+     */
+    static std::shared_ptr<const FFTPlan> get(std::size_t n);
+
+    /**
+     * @brief 不小于 n 的最小2的幂
+     */
+    static std::size_t nextPowerOfTwo(std::size_t n);
+
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief 原地正变换 X[k] = sum x[n] e^{-j2πkn/N}
+     */
+    void forward(std::complex<double>* data) const;
+
+    /**
+     * @brief 原地逆变换，结果已除以N
+     */
+    void inverse(std::complex<double>* data) const;
+
+    explicit FFTPlan(std::size_t n);
+
+private:
+    void transform(std::complex<double>* data, bool inverse) const;
+
+    std::size_t m_size;
+    std::vector<std::complex<double>> m_twiddles;  // 各级旋转因子 e^{-jπk/half}，共 N-1 个
+};
+
+#endif // FFT_H
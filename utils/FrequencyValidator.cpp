@@ -11,19 +11,16 @@
  */
 bool validateFrequency(const std::vector<int>& deviceIds, int sourceId, std::string& failMessage) {
     // 获取辐射源信息
-    RadiationSourceDAO& radiationSourceDAO = RadiationSourceDAO::getInstance();
-    RadiationSource source = radiationSourceDAO.getRadiationSourceById(sourceId);
+    ModelRepository& repository = ModelRepository::getInstance();
+    RadiationSource source = repository.getRadiationSourceById(sourceId);
     
     // 获取辐射源的载波频率
     double sourceFrequency = source.getCarrierFrequency();
     
-    // 获取侦察设备DAO实例
-    ReconnaissanceDeviceDAO& deviceDAO = ReconnaissanceDeviceDAO::getInstance();
-    
     // 遍历所有侦察设备
     for (int deviceId : deviceIds) {
         // 获取设备信息
-        ReconnaissanceDevice device = deviceDAO.getReconnaissanceDeviceById(deviceId);
+        ReconnaissanceDevice device = repository.getReconnaissanceDeviceById(deviceId);
         
         // 获取侦察设备的频率范围
         double minFreq = device.getFreqRangeMin();
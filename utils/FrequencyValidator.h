@@ -8,8 +8,7 @@
 
 #include <vector>
 #include <string>
-#include "../models/RadiationSourceDAO.h"
-#include "../models/ReconnaissanceDeviceDAO.h"
+#include "../models/ModelRepository.h"
 
 /**
  * @brief 验证频率是否满足要求
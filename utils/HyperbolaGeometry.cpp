@@ -0,0 +1,142 @@
+#include "HyperbolaGeometry.h"
+#include "Instrumentation.h"
+#include "Log.h"
+#include "../constants/PhysicsConstants.h"
+#include <algorithm>
+#include <cmath>
+
+// 地球半径（米）
+const double EARTH_RADIUS = 6378137.0;
+
+// 辅助函数：将大地坐标（经纬度，度）转换为局部二维平面坐标（米）
+// 以参考点（refLon, refLat）为原点，x轴向东，y轴向北
+std::pair<double, double> lonLatToXY(double lon, double lat, double refLon, double refLat) {
+    // 转换为弧度
+    double lonRad = lon * M_PI / 180.0;
+    double latRad = lat * M_PI / 180.0;
+    double refLonRad = refLon * M_PI / 180.0;
+    double refLatRad = refLat * M_PI / 180.0;
+
+    // 计算局部平面坐标（米）
+    double x = EARTH_RADIUS * (lonRad - refLonRad) * cos(refLatRad);
+    double y = EARTH_RADIUS * (latRad - refLatRad);
+    return {x, y};
+}
+
+// 辅助函数：将局部二维平面坐标（米）转换为大地坐标（经纬度，度）
+std::pair<double, double> xyToLonLat(double x, double y, double refLon, double refLat) {
+    // 转换为弧度
+    double refLonRad = refLon * M_PI / 180.0;
+    double refLatRad = refLat * M_PI / 180.0;
+
+    // 计算经纬度（弧度）
+    double lonRad = refLonRad + x / (EARTH_RADIUS * cos(refLatRad));
+    double latRad = refLatRad + y / EARTH_RADIUS;
+
+    // 转换为度
+    return {lonRad * 180.0 / M_PI, latRad * 180.0 / M_PI};
+}
+
+// 二维双曲线点计算
+std::vector<COORD3> computeHyperbolaPoints(
+    const COORD3& focus1Lbh,  // 焦点1大地坐标（经纬度，度）
+    const COORD3& focus2Lbh,  // 焦点2大地坐标（经纬度，度）
+    double tdoa,              // TDOA（秒）
+    double planeHeight,       // 平面高度（米）
+    double refLon,            // 参考点经度（度）
+    double refLat) {          // 参考点纬度（度）
+    PL_TRACE_SCOPE("Hyperbola.points");
+    
+    std::vector<COORD3> points;
+    const double PRECISION_FACTOR = 1e-10;
+    
+    // 1. 将焦点转换为二维平面坐标（以参考点为原点）
+    auto [x1, y1] = lonLatToXY(focus1Lbh.p1, focus1Lbh.p2, refLon, refLat);
+    auto [x2, y2] = lonLatToXY(focus2Lbh.p1, focus2Lbh.p2, refLon, refLat);
+    
+    // 2. 计算二维焦距（焦点间距离）
+    double focusDistance = std::sqrt((x2-x1)*(x2-x1) + (y2-y1)*(y2-y1));
+    PL_LOG_TRACE("焦点间平面距离: %g 米\n", focusDistance);
+    
+    // 3. 距离差（常数）
+    double constantA = std::abs(tdoa) * Constants::c;
+    PL_LOG_TRACE("距离差: %g 米\n", constantA);
+    
+    // 检查双曲线可行性
+    if (constantA >= focusDistance - PRECISION_FACTOR) {
+        PL_LOG_WARN("调整距离差以形成双曲线: %g -> %g\n", constantA, focusDistance - 1e-3);
+        constantA = focusDistance - 1e-3;  // 确保小于焦距
+    }
+    
+    // 4. 双曲线参数（二维）
+    double c = focusDistance / 2.0;  // 半焦距
+    double a = constantA / 2.0;      // 半距离差
+    double b = std::sqrt(std::max(c*c - a*a, PRECISION_FACTOR));  // 避免负数
+    
+    // 5. 焦点中点（二维）
+    double midX = (x1 + x2) / 2.0;
+    double midY = (y1 + y2) / 2.0;
+    
+    // 6. 焦点连线方向向量（二维单位向量）
+    double dirX = (x2 - x1) / focusDistance;
+    double dirY = (y2 - y1) / focusDistance;
+    
+    // 7. 垂直方向向量（二维，垂直于焦点连线）
+    double perpX = -dirY;  // 垂直向量
+    double perpY = dirX;
+    
+    // 8. 确定双曲线分支（靠近哪个焦点）
+    bool closerToFocus1 = (tdoa > 0);  // TDOA>0: 信号先到焦点1
+    
+    // 9. 生成双曲线上的点（参数方程）
+    const int numPoints = 500;
+    double angleRange = M_PI * 0.95;  // 角度范围（接近180度）
+    double angleStep = angleRange / (numPoints - 1);
+    std::vector<double> lons(numPoints), lats(numPoints), heights(numPoints, planeHeight);
+    
+    for (int i = 0; i < numPoints; ++i) {
+        double angle = -angleRange/2 + i * angleStep;
+        double secTheta = 1.0 / std::cos(angle);
+        double tanTheta = std::tan(angle);
+        
+        // 二维参数方程
+        double paramX = a * secTheta;
+        double paramY = b * tanTheta;
+        
+        // 计算点坐标（二维）
+        double x, y;
+        if (closerToFocus1) {
+            // 靠近焦点1的分支
+            x = midX - paramX * dirX + paramY * perpX;
+            y = midY - paramX * dirY + paramY * perpY;
+        } else {
+            // 靠近焦点2的分支
+            x = midX + paramX * dirX + paramY * perpX;
+            y = midY + paramX * dirY + paramY * perpY;
+        }
+        
+        // 转换回大地坐标（经纬度）
+        auto [lon, lat] = xyToLonLat(x, y, refLon, refLat);
+        lons[i] = lon;
+        lats[i] = lat;
+    }
+    
+    // 批量转换为空间直角坐标（用于返回）
+    std::vector<double> xs(numPoints), ys(numPoints), zs(numPoints);
+    lbh2xyzBatch(lons.data(), lats.data(), heights.data(), xs.data(), ys.data(), zs.data(), numPoints);
+    points.reserve(numPoints);
+    for (int i = 0; i < numPoints; ++i) {
+        points.push_back(COORD3(xs[i], ys[i], zs[i]));
+    }
+    
+    // 输出参数
+    PL_LOG_TRACE("双曲线参数:\n");
+    PL_LOG_TRACE("  半焦距(c): %g 米\n", c);
+    PL_LOG_TRACE("  半距离差(a): %g 米\n", a);
+    PL_LOG_TRACE("  半轴长(b): %g 米\n", b);
+    PL_LOG_TRACE("  偏心率(e): %g\n", c/a);
+    PL_LOG_TRACE("  生成点数: %zu\n", points.size());
+    PL_LOG_TRACE("  弯曲方向: %s\n", closerToFocus1 ? "朝向焦点1(参考站)" : "朝向焦点2");
+    
+    return points;
+}
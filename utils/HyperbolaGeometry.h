@@ -0,0 +1,42 @@
+/**
+ * @file HyperbolaGeometry.h
+ * @brief TDOA双曲线的几何计算(不依赖地图视图)，绘制见 HyperbolaLines
+ */
+
+#ifndef HYPERBOLA_GEOMETRY_H
+#define HYPERBOLA_GEOMETRY_H
+
+#include <utility>
+#include <vector>
+#include "CoordinateTransform.h"
+
+/**
+ * @brief 大地坐标转换为局部平面坐标(米)，以参考点为原点，x轴向东，y轴向北
+ */
+std::pair<double, double> lonLatToXY(double lon, double lat, double refLon, double refLat);
+
+/**
+ * @brief 局部平面坐标(米)转换为大地坐标(经度,纬度，度)
+ */
+std::pair<double, double> xyToLonLat(double x, double y, double refLon, double refLat);
+
+/**
+ * @brief 在参考点的局部平面内计算双曲线上的点
+ * @param focus1Lbh 焦点1（大地坐标）
+ * @param focus2Lbh 焦点2（大地坐标）
+ * @param tdoa 时差（秒），大于0时取靠近焦点1的分支
+ * @param planeHeight 平面高度（米）
+ * @param refLon 参考经度（度）
+ * @param refLat 参考纬度（度）
+ * @return 双曲线上的点数组（空间直角坐标）
+ */
+std::vector<COORD3> computeHyperbolaPoints(
+    const COORD3& focus1Lbh,
+    const COORD3& focus2Lbh,
+    double tdoa,
+    double planeHeight,
+    double refLon,
+    double refLat
+);
+
+#endif // HYPERBOLA_GEOMETRY_H
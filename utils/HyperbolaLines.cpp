@@ -1,45 +1,15 @@
 #include "HyperbolaLines.h"
+#include "HyperbolaGeometry.h"
 #include "../views/components/MapView.h"
 #include "../constants/PhysicsConstants.h"
+#include "Instrumentation.h"
+#include "Log.h"
 #include <sstream>
 #include <cmath>
 #include <iostream>
 #include <algorithm>
 #include <random>
 #include <limits>
-#include <iomanip>
-
-// 地球半径（米）
-const double EARTH_RADIUS = 6378137.0;
-
-// 辅助函数：将大地坐标（经纬度，度）转换为局部二维平面坐标（米）
-// 以参考点（refLon, refLat）为原点，x轴向东，y轴向北
-std::pair<double, double> lonLatToXY(double lon, double lat, double refLon, double refLat) {
-    // 转换为弧度
-    double lonRad = lon * M_PI / 180.0;
-    double latRad = lat * M_PI / 180.0;
-    double refLonRad = refLon * M_PI / 180.0;
-    double refLatRad = refLat * M_PI / 180.0;
-
-    // 计算局部平面坐标（米）
-    double x = EARTH_RADIUS * (lonRad - refLonRad) * cos(refLatRad);
-    double y = EARTH_RADIUS * (latRad - refLatRad);
-    return {x, y};
-}
-
-// 辅助函数：将局部二维平面坐标（米）转换为大地坐标（经纬度，度）
-std::pair<double, double> xyToLonLat(double x, double y, double refLon, double refLat) {
-    // 转换为弧度
-    double refLonRad = refLon * M_PI / 180.0;
-    double refLatRad = refLat * M_PI / 180.0;
-
-    // 计算经纬度（弧度）
-    double lonRad = refLonRad + x / (EARTH_RADIUS * cos(refLatRad));
-    double latRad = refLatRad + y / EARTH_RADIUS;
-
-    // 转换为度
-    return {lonRad * 180.0 / M_PI, latRad * 180.0 / M_PI};
-}
 
 bool HyperbolaLines::drawTDOAHyperbolas(
     MapView* mapView,
@@ -49,6 +19,7 @@ bool HyperbolaLines::drawTDOAHyperbolas(
     const std::vector<std::string>& colors,
     double tdoaRmsErrorNs,
     double esmToaErrorNs) {
+    PL_TRACE_SCOPE("Hyperbola.draw");
     
     if (!mapView) {
         std::cerr << "MapView对象为空，无法绘制双曲线" << std::endl;
@@ -66,18 +37,17 @@ bool HyperbolaLines::drawTDOAHyperbolas(
     double esmToaError = esmToaErrorNs * 1e-9;
 
     
-    std::cout << "绘制双曲线，TDOA RMS误差: " << tdoaRmsError * 1e9 << " ns, ESM TOA误差: " << esmToaError * 1e9 << " ns" << std::endl;
-    std::cout << "侦察站数量: " << stationPositions.size() << std::endl;
-    std::cout << "TDOA数量: " << tdoas.size() << std::endl;
+    PL_LOG_DEBUG("绘制双曲线，TDOA RMS误差: %g ns, ESM TOA误差: %g ns，侦察站 %zu 个，TDOA %zu 个\n",
+                 tdoaRmsError * 1e9, esmToaError * 1e9, stationPositions.size(), tdoas.size());
     
     // 确定绘制平面高度（辐射源高度）
     COORD3 sourcePos_lbh = xyz2lbh(sourcePos.p1, sourcePos.p2, sourcePos.p3);
     double planeHeight = sourcePos_lbh.p3;
     if (planeHeight < 0) planeHeight = 0;
     
-    std::cout << "双曲线绘制平面高度: " << planeHeight << " m" << std::endl;
-    std::cout << "辐射源空间直角坐标: (" << sourcePos.p1 << ", " << sourcePos.p2 << ", " << sourcePos.p3 << ") m" << std::endl;
-    std::cout << "辐射源大地坐标: (" << sourcePos_lbh.p1 << "°, " << sourcePos_lbh.p2 << "°, " << sourcePos_lbh.p3 << " m)" << std::endl;
+    PL_LOG_DEBUG("双曲线绘制平面高度: %g m\n", planeHeight);
+    PL_LOG_DEBUG("辐射源空间直角坐标: (%g, %g, %g) m\n", sourcePos.p1, sourcePos.p2, sourcePos.p3);
+    PL_LOG_DEBUG("辐射源大地坐标: (%g°, %g°, %g m)\n", sourcePos_lbh.p1, sourcePos_lbh.p2, sourcePos_lbh.p3);
     
     // 转换所有站点到大地坐标并投影到平面
     std::vector<COORD3> stationsOnPlaneLbh;
@@ -85,17 +55,16 @@ bool HyperbolaLines::drawTDOAHyperbolas(
         COORD3 station_lbh = xyz2lbh(station.p1, station.p2, station.p3);
         station_lbh.p3 = planeHeight; // 固定高度
         stationsOnPlaneLbh.push_back(station_lbh);
-        std::cout << "站点投影大地坐标: (" << station_lbh.p1 << "°, " << station_lbh.p2 << "°, " << planeHeight << " m)" << std::endl;
+        PL_LOG_TRACE("站点投影大地坐标: (%g°, %g°, %g m)\n", station_lbh.p1, station_lbh.p2, planeHeight);
     }
     
     // 辐射源投影坐标
     COORD3 sourcePos_plane_lbh = sourcePos_lbh;
     sourcePos_plane_lbh.p3 = planeHeight;
-    std::cout << "辐射源投影坐标: (" << sourcePos_plane_lbh.p1 << "°, " << sourcePos_plane_lbh.p2 << "°, " << planeHeight << " m)" << std::endl;
+    PL_LOG_TRACE("辐射源投影坐标: (%g°, %g°, %g m)\n", sourcePos_plane_lbh.p1, sourcePos_plane_lbh.p2, planeHeight);
     
     // 计算站点到辐射源的平面距离（二维）
     std::vector<double> stationToSourceDistances;
-    std::cout << "\n--- 站点到辐射源平面距离 ---" << std::endl;
     // 以辐射源为参考点转换二维坐标
     double refLon = sourcePos_plane_lbh.p1;
     double refLat = sourcePos_plane_lbh.p2;
@@ -104,7 +73,7 @@ bool HyperbolaLines::drawTDOAHyperbolas(
         // 辐射源在二维坐标中为(0,0)
         double distance = std::sqrt(x*x + y*y);
         stationToSourceDistances.push_back(distance);
-        std::cout << "站点" << i << "到辐射源距离: " << std::fixed << std::setprecision(6) << distance << " 米" << std::endl;
+        PL_LOG_TRACE("站点%zu到辐射源平面距离: %.6f 米\n", i, distance);
     }
     
     // 绘制各双曲线
@@ -117,23 +86,19 @@ bool HyperbolaLines::drawTDOAHyperbolas(
         double distanceDiff = stationToSourceDistances[i] - stationToSourceDistances[0];
         double tdoaDistanceDiff = tdoa * Constants::c;
         
-        std::cout << std::scientific << std::setprecision(6);
-        std::cout << "绘制双曲线 " << i << "，参考站与站点" << i << "之间的TDOA: " << tdoa << " 秒" << std::endl;
-        std::cout << "理论距离差: " << distanceDiff << " 米" << std::endl;
-        std::cout << "TDOA距离差: " << tdoaDistanceDiff << " 米" << std::endl;
-        std::cout << "距离差误差: " << (tdoaDistanceDiff - distanceDiff) << " 米" << std::endl;
+        PL_LOG_DEBUG("绘制双曲线 %zu，TDOA: %.6e 秒，理论距离差: %.6e 米，TDOA距离差: %.6e 米，误差: %.6e 米\n",
+                     i, tdoa, distanceDiff, tdoaDistanceDiff, tdoaDistanceDiff - distanceDiff);
         
         // 应用系统误差
         double tdoa_with_system_error = tdoa;
         if (esmToaError != 0.0) {
             tdoa_with_system_error = tdoa - esmToaError;
-            std::cout << "应用ESM TOA系统误差后的TDOA: " << tdoa_with_system_error << " s" << std::endl;
+            PL_LOG_DEBUG("应用ESM TOA系统误差后的TDOA: %.6e s\n", tdoa_with_system_error);
         }
         
         // 颜色选择
         std::vector<std::string> defaultColors = {"#FFFF00", "#00FFFF", "#FF00FF", "#0000FF", "#FF0000"};
         std::string color = (i - 1 < colors.size()) ? colors[i - 1] : defaultColors[(i - 1) % defaultColors.size()];
-        std::cout << "双曲线" << i << "颜色: " << color << std::endl;
         
         // 计算双曲线点（二维）
         std::vector<COORD3> centerPoints = calculateHyperbolaPoints(
@@ -158,21 +123,23 @@ bool HyperbolaLines::drawTDOAHyperbolas(
             
             // 填充误差带
             if (upperPoints.size() > 10 && lowerPoints.size() > 10) {
+                std::vector<COORD3> upperLbh = xyz2lbhBatch(upperPoints);
+                std::vector<COORD3> lowerLbh = xyz2lbhBatch(lowerPoints);
                 std::stringstream fillScript;
                 fillScript << "var fillPositions = [];\n";
                 int skip = std::max(1, (int)upperPoints.size() / 20);
                 for (size_t j = 0; j < upperPoints.size(); j += skip) {
-                    COORD3 lbh = xyz2lbh(upperPoints[j].p1, upperPoints[j].p2, upperPoints[j].p3);
+                    const COORD3& lbh = upperLbh[j];
                     fillScript << "fillPositions.push(Cesium.Cartesian3.fromDegrees("
                         << lbh.p1 << ", " << lbh.p2 << ", " << planeHeight << "));\n";
                 }
                 for (int j = lowerPoints.size() - 1; j >= 0; j -= skip) {
-                    COORD3 lbh = xyz2lbh(lowerPoints[j].p1, lowerPoints[j].p2, lowerPoints[j].p3);
+                    const COORD3& lbh = lowerLbh[j];
                     fillScript << "fillPositions.push(Cesium.Cartesian3.fromDegrees("
                         << lbh.p1 << ", " << lbh.p2 << ", " << planeHeight << "));\n";
                 }
                 if (!upperPoints.empty()) {
-                    COORD3 lbh = xyz2lbh(upperPoints[0].p1, upperPoints[0].p2, upperPoints[0].p3);
+                    const COORD3& lbh = upperLbh[0];
                     fillScript << "fillPositions.push(Cesium.Cartesian3.fromDegrees("
                         << lbh.p1 << ", " << lbh.p2 << ", " << planeHeight << "));\n";
                 }
@@ -185,9 +152,8 @@ bool HyperbolaLines::drawTDOAHyperbolas(
                     << "  }\n"
                     << "});\n";
                 mapView->executeScript(fillScript.str());
-                std::cout << "已添加误差带填充区域" << std::endl;
             }
-            std::cout << "已绘制第 " << i << " 条双曲线的误差带" << std::endl;
+            PL_LOG_TRACE("已绘制第 %zu 条双曲线的误差带\n", i);
         }
     }
     
@@ -209,8 +175,7 @@ bool HyperbolaLines::drawTDOAHyperbolas(
     std::string script = scriptStream.str();
     mapView->executeScript(script);
     
-    std::cout << "双曲线绘制结果: 成功" << std::endl;
-    std::cout << "========= 结束绘制双曲线 =========" << std::endl;
+    PL_LOG_DEBUG("双曲线绘制完成\n");
     
     return true;
 }
@@ -223,99 +188,15 @@ void HyperbolaLines::clearHyperbolaLines(MapView* mapView) {
     mapView->executeScript(script);
 }
 
-// 二维双曲线点计算
+// 二维双曲线点计算(几何计算见 HyperbolaGeometry)
 std::vector<COORD3> HyperbolaLines::calculateHyperbolaPoints(
-    const COORD3& focus1Lbh,  // 焦点1大地坐标（经纬度，度）
-    const COORD3& focus2Lbh,  // 焦点2大地坐标（经纬度，度）
-    double tdoa,              // TDOA（秒）
-    double planeHeight,       // 平面高度（米）
-    double refLon,            // 参考点经度（度）
-    double refLat) {          // 参考点纬度（度）
-    
-    std::vector<COORD3> points;
-    const double PRECISION_FACTOR = 1e-10;
-    
-    // 1. 将焦点转换为二维平面坐标（以参考点为原点）
-    auto [x1, y1] = lonLatToXY(focus1Lbh.p1, focus1Lbh.p2, refLon, refLat);
-    auto [x2, y2] = lonLatToXY(focus2Lbh.p1, focus2Lbh.p2, refLon, refLat);
-    
-    // 2. 计算二维焦距（焦点间距离）
-    double focusDistance = std::sqrt((x2-x1)*(x2-x1) + (y2-y1)*(y2-y1));
-    std::cout << "焦点间平面距离: " << focusDistance << " 米" << std::endl;
-    
-    // 3. 距离差（常数）
-    double constantA = std::abs(tdoa) * Constants::c;
-    std::cout << "距离差: " << constantA << " 米" << std::endl;
-    
-    // 检查双曲线可行性
-    if (constantA >= focusDistance - PRECISION_FACTOR) {
-        std::cout << "调整距离差以形成双曲线: " << constantA << " -> " << (focusDistance - 1e-3) << std::endl;
-        constantA = focusDistance - 1e-3;  // 确保小于焦距
-    }
-    
-    // 4. 双曲线参数（二维）
-    double c = focusDistance / 2.0;  // 半焦距
-    double a = constantA / 2.0;      // 半距离差
-    double b = std::sqrt(std::max(c*c - a*a, PRECISION_FACTOR));  // 避免负数
-    
-    // 5. 焦点中点（二维）
-    double midX = (x1 + x2) / 2.0;
-    double midY = (y1 + y2) / 2.0;
-    
-    // 6. 焦点连线方向向量（二维单位向量）
-    double dirX = (x2 - x1) / focusDistance;
-    double dirY = (y2 - y1) / focusDistance;
-    
-    // 7. 垂直方向向量（二维，垂直于焦点连线）
-    double perpX = -dirY;  // 垂直向量
-    double perpY = dirX;
-    
-    // 8. 确定双曲线分支（靠近哪个焦点）
-    bool closerToFocus1 = (tdoa > 0);  // TDOA>0: 信号先到焦点1
-    
-    // 9. 生成双曲线上的点（参数方程）
-    const int numPoints = 500;
-    double angleRange = M_PI * 0.95;  // 角度范围（接近180度）
-    double angleStep = angleRange / (numPoints - 1);
-    
-    for (int i = 0; i < numPoints; ++i) {
-        double angle = -angleRange/2 + i * angleStep;
-        double secTheta = 1.0 / std::cos(angle);
-        double tanTheta = std::tan(angle);
-        
-        // 二维参数方程
-        double paramX = a * secTheta;
-        double paramY = b * tanTheta;
-        
-        // 计算点坐标（二维）
-        double x, y;
-        if (closerToFocus1) {
-            // 靠近焦点1的分支
-            x = midX - paramX * dirX + paramY * perpX;
-            y = midY - paramX * dirY + paramY * perpY;
-        } else {
-            // 靠近焦点2的分支
-            x = midX + paramX * dirX + paramY * perpX;
-            y = midY + paramX * dirY + paramY * perpY;
-        }
-        
-        // 转换回大地坐标（经纬度）
-        auto [lon, lat] = xyToLonLat(x, y, refLon, refLat);
-        // 转换为空间直角坐标（用于返回）
-        COORD3 xyz = lbh2xyz(lon, lat, planeHeight);
-        points.push_back(xyz);
-    }
-    
-    // 输出参数
-    std::cout << "双曲线参数:" << std::endl;
-    std::cout << "  半焦距(c): " << c << " 米" << std::endl;
-    std::cout << "  半距离差(a): " << a << " 米" << std::endl;
-    std::cout << "  半轴长(b): " << b << " 米" << std::endl;
-    std::cout << "  偏心率(e): " << c/a << std::endl;
-    std::cout << "  生成点数: " << points.size() << std::endl;
-    std::cout << "  弯曲方向: " << (closerToFocus1 ? "朝向焦点1(参考站)" : "朝向焦点2") << std::endl;
-    
-    return points;
+    const COORD3& focus1Lbh,
+    const COORD3& focus2Lbh,
+    double tdoa,
+    double planeHeight,
+    double refLon,
+    double refLat) {
+    return computeHyperbolaPoints(focus1Lbh, focus2Lbh, tdoa, planeHeight, refLon, refLat);
 }
 
 bool HyperbolaLines::drawHyperbolaLine(
@@ -330,10 +211,7 @@ bool HyperbolaLines::drawHyperbolaLine(
         return false;
     }
     
-    std::vector<COORD3> lbhPoints;
-    for (const auto& point : points) {
-        lbhPoints.push_back(xyz2lbh(point.p1, point.p2, point.p3));
-    }
+    std::vector<COORD3> lbhPoints = xyz2lbhBatch(points);
     
     std::stringstream script;
     script << "var hyperbolaContainer = viewer.entities.getById('tdoa-hyperbolas');\n"
@@ -375,6 +253,7 @@ bool HyperbolaLines::drawHyperbolaLine(
 
 
 // #include "HyperbolaLines.h"
+#include "HyperbolaGeometry.h"
 // #include "../views/components/MapView.h"
 // #include "../constants/PhysicsConstants.h"
 // #include <sstream>
@@ -0,0 +1,137 @@
+#include "IQSignalGenerator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// 每隔多少个样本更新一次扫描包络(包络变化远慢于采样率)
+const std::size_t ENVELOPE_STRIDE = 256;
+
+// 单位功率复高斯样本每个分量的标准差
+const double HALF_SIGMA = 0.70710678118654752440;
+
+// 截止频率 cutoff(相对采样率)、中心偏移 shift 样本的Blackman窗sinc低通滤波器
+std::vector<double> designLowpass(std::size_t taps, double cutoff, double shift) {
+    std::vector<double> h(taps);
+    const double center = (static_cast<double>(taps) - 1.0) / 2.0 + shift;
+    for (std::size_t k = 0; k < taps; ++k) {
+        const double x = static_cast<double>(k) - center;
+        const double sinc = std::fabs(x) < 1e-12 ? 1.0 : std::sin(2.0 * PI * cutoff * x) / (2.0 * PI * cutoff * x);
+        const double w = (static_cast<double>(k) - shift) / (static_cast<double>(taps) - 1.0);
+        const double window = w < 0.0 || w > 1.0 ? 0.0
+            : 0.42 - 0.5 * std::cos(2.0 * PI * w) + 0.08 * std::cos(4.0 * PI * w);
+        h[k] = 2.0 * cutoff * sinc * window;
+    }
+    return h;
+}
+
+} // namespace
+
+IQSignalGenerator::IQSignalGenerator(const IQSignalConfig& config)
+    : m_config(config), m_generator(RandomService::streamFromSeed(config.seed, RandomPurpose::SignalNoise)), m_normal(0.0, 1.0),
+      m_historyPos(0), m_sampleIndex(0) {
+    std::size_t taps = std::max<std::size_t>(config.filterTaps, 3);
+    if (taps % 2 == 0) ++taps;
+
+    const double bandwidth = config.bandwidth > 0.0 ? config.bandwidth : config.sampleRate / 4.0;
+    const double cutoff = std::min(0.5, bandwidth / (2.0 * config.sampleRate));
+
+    // 时延拆成整数延迟线和 [0,1) 的分数部分，分数部分并入滤波器
+    const double delaySamples = std::fabs(config.delay) * config.sampleRate;
+    m_integerDelay = static_cast<std::size_t>(std::floor(delaySamples));
+    const double fraction = delaySamples - static_cast<double>(m_integerDelay);
+    m_channel2Leads = config.delay < 0.0;
+
+    m_filter1 = designLowpass(taps, cutoff, 0.0);
+    m_filter2 = designLowpass(taps, cutoff, fraction);
+
+    // 归一化为单位功率增益，两路使用同一系数保持幅度一致
+    double energy = 0.0;
+    for (double h : m_filter1) energy += h * h;
+    const double scale = energy > 0.0 ? 1.0 / std::sqrt(energy) : 1.0;
+    for (double& h : m_filter1) h *= scale;
+    for (double& h : m_filter2) h *= scale;
+
+    m_carrierRotation = std::polar(1.0, -2.0 * PI * config.carrierFrequency * config.delay);
+    m_signalAmplitude = std::sqrt(std::max(config.receivedPower, 0.0));
+    const double noisePsdW = std::pow(10.0, (config.noisePsd - 30.0) / 10.0);
+    m_noiseSigma = std::sqrt(noisePsdW * config.sampleRate / 2.0);
+
+    // 双倍长度存放历史，任意时刻最近的 H 个样本在内存中连续
+    m_history.assign(2 * (m_integerDelay + taps), std::complex<double>(0.0, 0.0));
+}
+
+double IQSignalGenerator::scanEnvelope(double time) const {
+    const double period = m_config.scanPeriod;
+    if (period <= 0.0) return 1.0;
+    double phase = std::fmod(time, period);
+    if (phase > period / 2.0) phase -= period;
+    // 主瓣按高斯包络，半功率宽度为驻留时间
+    const double sigma = std::max(m_config.dwellFraction, 1e-9) * period / 2.3548;
+    const double mainLobe = std::exp(-phase * phase / (2.0 * sigma * sigma));
+    return std::max(m_config.sidelobeLevel, mainLobe);
+}
+
+void IQSignalGenerator::generate(IQBlock& block, std::size_t count) {
+    if (block.channel1.size() < count || block.channel2.size() < count) {
+        block.reserve(count);
+    }
+    block.count = count;
+    block.startSample = m_sampleIndex;
+
+    const std::size_t taps = m_filter1.size();
+    const std::size_t length = m_history.size() / 2;
+    const double* h1 = m_filter1.data();
+    const double* h2 = m_filter2.data();
+
+    double amplitude = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % ENVELOPE_STRIDE == 0) {
+            const double time = static_cast<double>(m_sampleIndex + i) / m_config.sampleRate;
+            amplitude = m_signalAmplitude * scanEnvelope(time);
+        }
+
+        // 写入新的白噪声样本，recent[m] 为 m 个样本之前的值
+        // 复高斯白噪声，单位功率
+        const double sourceI = HALF_SIGMA * m_normal(m_generator);
+        const double sourceQ = HALF_SIGMA * m_normal(m_generator);
+        const std::complex<double> source(sourceI, sourceQ);
+        m_historyPos = m_historyPos == 0 ? length - 1 : m_historyPos - 1;
+        m_history[m_historyPos] = source;
+        m_history[m_historyPos + length] = source;
+        const std::complex<double>* recent = m_history.data() + m_historyPos;
+
+        // 早到通道用原始滤波器，晚到通道先经过整数延迟线再用分数时延滤波器
+        const std::complex<double>* delayed = recent + m_integerDelay;
+        double earlyRe = 0.0, earlyIm = 0.0, lateRe = 0.0, lateIm = 0.0;
+        for (std::size_t k = 0; k < taps; ++k) {
+            earlyRe += h1[k] * recent[k].real();
+            earlyIm += h1[k] * recent[k].imag();
+            lateRe += h2[k] * delayed[k].real();
+            lateIm += h2[k] * delayed[k].imag();
+        }
+        std::complex<double> s1(earlyRe, earlyIm);
+        std::complex<double> s2(lateRe, lateIm);
+        if (m_channel2Leads) std::swap(s1, s2);
+        s1 *= amplitude;
+        s2 *= amplitude * m_carrierRotation;
+
+        // 逐个语句取噪声，保证取数顺序与编译器无关
+        const double noise1I = m_noiseSigma * m_normal(m_generator);
+        const double noise1Q = m_noiseSigma * m_normal(m_generator);
+        const double noise2I = m_noiseSigma * m_normal(m_generator);
+        const double noise2Q = m_noiseSigma * m_normal(m_generator);
+        block.channel1[i] = std::complex<float>(static_cast<float>(s1.real() + noise1I),
+                                                static_cast<float>(s1.imag() + noise1Q));
+        block.channel2[i] = std::complex<float>(static_cast<float>(s2.real() + noise2I),
+                                                static_cast<float>(s2.imag() + noise2Q));
+    }
+    m_sampleIndex += count;
+}
+
+std::size_t IQSignalGenerator::memoryBytes() const {
+    return m_history.size() * sizeof(std::complex<double>)
+         + (m_filter1.size() + m_filter2.size()) * sizeof(double);
+}
@@ -0,0 +1,103 @@
+/**
+ * @file IQSignalGenerator.h
+ * @brief 双通道带限IQ信号生成器：按块流式生成，内存占用与观测时长无关
+ */
+
+#ifndef IQ_SIGNAL_GENERATOR_H
+#define IQ_SIGNAL_GENERATOR_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "RandomStream.h"
+
+/**
+ * @brief 信号生成参数(均为国际单位)
+ */
+struct IQSignalConfig {
+    double sampleRate = 20.0e9;         // 采样率(Hz)
+    double carrierFrequency = 8.0e9;    // 载波频率(Hz)，决定通道2的载波相位旋转
+    double bandwidth = 0.0;             // 信号带宽(Hz)，0 表示取采样率的1/4
+    double noisePsd = -174.0;           // 噪声功率谱密度(dBm/Hz)
+    double receivedPower = 1.0e-9;      // 主瓣照射时的接收信号功率(W)
+    double scanPeriod = 0.0;            // 辐射源天线扫描周期(秒)，0 表示不扫描
+    double dwellFraction = 0.05;        // 主瓣驻留时间占扫描周期的比例
+    double sidelobeLevel = 0.1;         // 旁瓣幅度(相对主瓣)
+    double delay = 0.0;                 // 通道2相对通道1的时延(秒)，可为负
+    std::size_t filterTaps = 31;        // 带限/分数时延滤波器阶数(奇数)
+    std::uint64_t seed = 0;             // 随机种子
+};
+
+/**
+ * @brief 一块双通道IQ数据
+ */
+struct IQBlock {
+    std::vector<std::complex<float>> channel1;
+    std::vector<std::complex<float>> channel2;
+    std::size_t count = 0;              // 有效样本数
+    std::uint64_t startSample = 0;      // 首个样本的全局序号
+
+    void reserve(std::size_t capacity) {
+        channel1.resize(capacity);
+        channel2.resize(capacity);
+    }
+};
+
+/**
+ * @brief 双通道IQ信号生成器
+ *
+ * 以复高斯白噪声经低通FIR得到带限信号作为辐射源波形，
+ * 通道1直接接收，通道2经过 delay 的整数样本延迟线和分数时延滤波器，
+ * 并乘以载波相位 e^{-j2πf_c·delay}。两通道再各自叠加按 noisePsd·sampleRate 计算的
+ * 热噪声。扫描周期内主瓣按高斯包络照射，其余时间为旁瓣电平。
+ * 观测从主瓣中心开始。
+ * 延迟线长度只取决于时延，生成任意长度的数据都不会增加内存。
+ */
+class IQSignalGenerator {
+public:
+    explicit IQSignalGenerator(const IQSignalConfig& config);
+
+    /**
+     * @brief 生成下一块数据
+     * @param block 输出块，容量不足时自动扩展
+     * @param count 本块样本数
+     */
+    void generate(IQBlock& block, std::size_t count);
+
+    /**
+     * @brief 已生成的样本总数
+     */
+    std::uint64_t generatedSamples() const { return m_sampleIndex; }
+
+    /**
+     * @brief 生成器内部状态占用的内存(字节)
+     */
+    std::size_t memoryBytes() const;
+
+    const IQSignalConfig& config() const { return m_config; }
+
+private:
+    // 指定时刻的扫描包络幅度
+    double scanEnvelope(double time) const;
+
+    IQSignalConfig m_config;
+    RandomStream m_generator;
+    std::normal_distribution<double> m_normal;
+
+    std::vector<double> m_filter1;      // 通道1带限滤波器
+    std::vector<double> m_filter2;      // 通道2带限+分数时延滤波器
+    std::size_t m_integerDelay;         // 通道2整数样本延迟(相对滤波器中心)
+    bool m_channel2Leads;               // 时延为负时通道1反向延迟
+    std::complex<double> m_carrierRotation;
+    double m_signalAmplitude;
+    double m_noiseSigma;                // 噪声每个分量的标准差
+
+    // 白噪声源的循环历史，长度为整数延迟加滤波器阶数
+    std::vector<std::complex<double>> m_history;
+    std::size_t m_historyPos;
+    std::uint64_t m_sampleIndex;
+};
+
+#endif // IQ_SIGNAL_GENERATOR_H
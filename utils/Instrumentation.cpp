@@ -0,0 +1,286 @@
+#include "Instrumentation.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+namespace Instrumentation {
+namespace detail {
+std::atomic<bool> g_tracingEnabled(false);
+}
+}
+
+namespace {
+
+// 环形缓冲容量(事件数)，必须是2的幂
+const std::uint64_t RING_CAPACITY = 1 << 16;
+const std::uint64_t RING_MASK = RING_CAPACITY - 1;
+
+// 每个槽位用序号做顺序锁：写入前清零，写完置为 写入序号+1，读者前后两次读到相同序号才采用
+struct Slot {
+    std::atomic<std::uint64_t> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<std::uint64_t> timestampNs{0};
+    std::atomic<std::uint64_t> durationNs{0};
+    std::atomic<std::uint32_t> threadId{0};
+    std::atomic<char> phase{0};
+};
+
+Slot g_ring[RING_CAPACITY];
+std::atomic<std::uint64_t> g_writeIndex(0);
+std::atomic<std::uint64_t> g_clearedBefore(0);  // clear() 时的写入位置，之前的事件不再导出
+std::atomic<std::uint32_t> g_nextThreadId(0);
+
+std::uint32_t currentThreadId() {
+    thread_local std::uint32_t id = 0;
+    if (id == 0) id = g_nextThreadId.fetch_add(1, std::memory_order_relaxed) + 1;
+    return id;
+}
+
+void record(const char* name, const char* category, char phase, std::uint64_t startNs, std::uint64_t durationNs) {
+    const std::uint64_t index = g_writeIndex.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = g_ring[index & RING_MASK];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.category.store(category, std::memory_order_relaxed);
+    slot.timestampNs.store(startNs, std::memory_order_relaxed);
+    slot.durationNs.store(durationNs, std::memory_order_relaxed);
+    slot.threadId.store(currentThreadId(), std::memory_order_relaxed);
+    slot.phase.store(phase, std::memory_order_relaxed);
+    slot.sequence.store(index + 1, std::memory_order_release);
+}
+
+struct CounterRegistry {
+    std::mutex mutex;
+    std::vector<Instrumentation::Counter*> counters;
+};
+
+CounterRegistry& counterRegistry() {
+    static CounterRegistry registry;
+    return registry;
+}
+
+std::string& traceOutputPath() {
+    static std::string path;
+    return path;
+}
+
+void writeJsonString(std::ostream& os, const char* text) {
+    os << '"';
+    for (const char* p = text ? text : ""; *p; ++p) {
+        const char ch = *p;
+        if (ch == '"' || ch == '\\') {
+            os << '\\' << ch;
+        } else if (static_cast<unsigned char>(ch) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+            os << buffer;
+        } else {
+            os << ch;
+        }
+    }
+    os << '"';
+}
+
+} // namespace
+
+namespace Instrumentation {
+
+void setTracingEnabled(bool enabled) {
+    detail::g_tracingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::uint64_t nowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void recordComplete(const char* name, const char* category, std::uint64_t startNs, std::uint64_t durationNs) {
+    record(name, category, 'X', startNs, durationNs);
+}
+
+void recordInstant(const char* name, const char* category) {
+    record(name, category, 'i', nowNs(), 0);
+}
+
+Counter::Counter(const char* name) : m_name(name), m_value(0) {
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.counters.push_back(this);
+}
+
+Counter::~Counter() {
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.counters.erase(std::remove(registry.counters.begin(), registry.counters.end(), this),
+                            registry.counters.end());
+}
+
+std::vector<CounterValue> counters() {
+    std::map<std::string, std::int64_t> merged;
+    {
+        CounterRegistry& registry = counterRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const Counter* counter : registry.counters) {
+            merged[counter->name()] += counter->value();
+        }
+    }
+    std::vector<CounterValue> result;
+    for (const auto& entry : merged) {
+        CounterValue value;
+        value.name = entry.first;
+        value.value = entry.second;
+        result.push_back(value);
+    }
+    return result;
+}
+
+std::vector<Event> snapshot() {
+    const std::uint64_t end = g_writeIndex.load(std::memory_order_acquire);
+    std::uint64_t begin = end > RING_CAPACITY ? end - RING_CAPACITY : 0;
+    begin = std::max(begin, g_clearedBefore.load(std::memory_order_relaxed));
+
+    std::vector<Event> events;
+    events.reserve(end - begin);
+    for (std::uint64_t index = begin; index < end; ++index) {
+        const Slot& slot = g_ring[index & RING_MASK];
+        const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != index + 1) continue;  // 仍在写入或已被覆盖
+        Event e;
+        e.name = slot.name.load(std::memory_order_relaxed);
+        e.category = slot.category.load(std::memory_order_relaxed);
+        e.timestampNs = slot.timestampNs.load(std::memory_order_relaxed);
+        e.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+        e.threadId = slot.threadId.load(std::memory_order_relaxed);
+        e.phase = slot.phase.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) continue;
+        events.push_back(e);
+    }
+    std::sort(events.begin(), events.end(),
+              [](const Event& a, const Event& b) { return a.timestampNs < b.timestampNs; });
+    return events;
+}
+
+std::vector<StageStats> stageSummary() {
+    std::map<std::string, StageStats> stats;
+    for (const Event& e : snapshot()) {
+        if (e.phase != 'X') continue;
+        const double ms = e.durationNs * 1e-6;
+        StageStats& s = stats[e.name];
+        if (s.count == 0) {
+            s.name = e.name;
+            s.minMs = ms;
+            s.maxMs = ms;
+        }
+        ++s.count;
+        s.totalMs += ms;
+        s.minMs = std::min(s.minMs, ms);
+        s.maxMs = std::max(s.maxMs, ms);
+    }
+    std::vector<StageStats> result;
+    for (const auto& entry : stats) result.push_back(entry.second);
+    std::sort(result.begin(), result.end(),
+              [](const StageStats& a, const StageStats& b) { return a.totalMs > b.totalMs; });
+    return result;
+}
+
+std::uint64_t droppedEvents() {
+    const std::uint64_t recorded = g_writeIndex.load(std::memory_order_relaxed) -
+                                   g_clearedBefore.load(std::memory_order_relaxed);
+    return recorded > RING_CAPACITY ? recorded - RING_CAPACITY : 0;
+}
+
+void clear() {
+    g_clearedBefore.store(g_writeIndex.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (Counter* counter : registry.counters) counter->reset();
+}
+
+void writeChromeTrace(std::ostream& os) {
+    const std::vector<Event> events = snapshot();
+    const std::uint64_t origin = events.empty() ? nowNs() : events.front().timestampNs;
+    std::uint64_t last = origin;
+
+    char number[64];
+    os << "{\"traceEvents\":[\n"
+       << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"passivelocation\"}}";
+    for (const Event& e : events) {
+        os << ",\n{\"name\":";
+        writeJsonString(os, e.name);
+        os << ",\"cat\":";
+        writeJsonString(os, e.category);
+        std::snprintf(number, sizeof(number), "%.3f", (e.timestampNs - origin) * 1e-3);
+        os << ",\"ph\":\"" << e.phase << "\",\"ts\":" << number;
+        if (e.phase == 'X') {
+            std::snprintf(number, sizeof(number), "%.3f", e.durationNs * 1e-3);
+            os << ",\"dur\":" << number;
+        } else {
+            os << ",\"s\":\"t\"";
+        }
+        os << ",\"pid\":1,\"tid\":" << e.threadId << "}";
+        last = std::max(last, e.timestampNs + e.durationNs);
+    }
+
+    // 计数器只保存累计值，在时间轴末尾输出一次
+    const std::vector<CounterValue> values = counters();
+    if (!values.empty()) {
+        std::snprintf(number, sizeof(number), "%.3f", (last - origin) * 1e-3);
+        os << ",\n{\"name\":\"counters\",\"ph\":\"C\",\"ts\":" << number << ",\"pid\":1,\"args\":{";
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (i) os << ",";
+            writeJsonString(os, values[i].name.c_str());
+            os << ":" << values[i].value;
+        }
+        os << "}}";
+    }
+    os << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << droppedEvents() << "}}\n";
+}
+
+bool writeChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "无法写入trace文件: " << path << std::endl;
+        return false;
+    }
+    writeChromeTrace(out);
+    return static_cast<bool>(out);
+}
+
+void configureFromEnvironment() {
+    if (const char* levelName = std::getenv("PASSIVELOCATION_LOG_LEVEL")) {
+        Log::Level level;
+        if (Log::parseLevel(levelName, level)) {
+            Log::setLevel(level);
+        } else {
+            std::cerr << "无效的日志级别 PASSIVELOCATION_LOG_LEVEL=" << levelName << std::endl;
+        }
+    }
+    if (const char* path = std::getenv("PASSIVELOCATION_TRACE")) {
+        setTraceOutput(path);
+    }
+}
+
+void setTraceOutput(const std::string& path) {
+    traceOutputPath() = path;
+    setTracingEnabled(!path.empty());
+}
+
+void finish() {
+    const std::string& path = traceOutputPath();
+    if (path.empty()) return;
+    if (writeChromeTrace(path)) {
+        PL_LOG_INFO("阶段耗时已写入 %s (%llu 个事件被覆盖)\n", path.c_str(),
+                    static_cast<unsigned long long>(droppedEvents()));
+    }
+}
+
+} // namespace Instrumentation
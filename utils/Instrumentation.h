@@ -0,0 +1,225 @@
+/**
+ * @file Instrumentation.h
+ * @brief 热路径埋点：作用域计时、计数器、无锁环形事件缓冲，阶段耗时可导出为 Chrome trace JSON
+ *
+ * 计时默认关闭，关闭时 PL_TRACE_SCOPE 只有一次原子读；开启后每个作用域写一条事件到
+ * 固定容量的环形缓冲(写满后覆盖最旧的事件)，不加锁、不分配内存。
+ * 导出的JSON可在 chrome://tracing 或 https://ui.perfetto.dev 中查看。
+ * 编译时定义 PASSIVELOCATION_NO_INSTRUMENTATION 时所有 PL_TRACE_* / PL_COUNTER_* 宏展开为空。
+ *
+ * 用法:
+ *   void TDOAalgorithm::calculate() {
+ *       PL_TRACE_SCOPE("TDOA.calculate");
+ *       ...
+ *       PL_COUNTER_ADD("tdoa.solves", 1);
+ *   }
+ * 事件名和分类必须是字符串字面量(缓冲区只保存指针)。
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Instrumentation {
+
+namespace detail {
+extern std::atomic<bool> g_tracingEnabled;
+}
+
+/**
+ * @brief 是否记录计时事件
+ */
+inline bool tracingEnabled() {
+    return detail::g_tracingEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 开启或关闭计时事件记录(计数器不受影响)
+ */
+void setTracingEnabled(bool enabled);
+
+/**
+ * @brief 单调时钟(纳秒)，只用于求时间差
+ */
+std::uint64_t nowNs();
+
+/**
+ * @brief 缓冲区中的一条事件
+ */
+struct Event {
+    const char* name = nullptr;      // 事件名(字符串字面量)
+    const char* category = nullptr;  // 分类(字符串字面量)
+    char phase = 'X';                // 'X' 带持续时间的阶段，'i' 瞬时事件
+    std::uint32_t threadId = 0;      // 线程序号(从1开始，按首次记录的顺序分配)
+    std::uint64_t timestampNs = 0;   // 开始时刻(纳秒)
+    std::uint64_t durationNs = 0;    // 持续时间(纳秒)，瞬时事件为0
+};
+
+/**
+ * @brief 记录一个已结束的阶段
+ */
+void recordComplete(const char* name, const char* category, std::uint64_t startNs, std::uint64_t durationNs);
+
+/**
+ * @brief 记录一个瞬时事件
+ */
+void recordInstant(const char* name, const char* category);
+
+/**
+ * @brief 作用域计时：构造时记下开始时刻，析构时写入一条阶段事件
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char* name, const char* category = "stage")
+        : m_name(name), m_category(category), m_start(tracingEnabled() ? nowNs() : 0) {}
+
+    ~ScopedTimer() {
+        if (m_start != 0) {
+            recordComplete(m_name, m_category, m_start, nowNs() - m_start);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* m_name;
+    const char* m_category;
+    std::uint64_t m_start;  // 0 表示构造时未开启计时
+};
+
+/**
+ * @brief 命名计数器，必须是静态存储期对象(通常由 PL_COUNTER_ADD 在调用点定义)
+ *
+ * 构造时登记到全局列表，累加为一次relaxed原子加法。
+ */
+class Counter {
+public:
+    explicit Counter(const char* name);
+    ~Counter();
+
+    void add(std::int64_t delta) { m_value.fetch_add(delta, std::memory_order_relaxed); }
+    std::int64_t value() const { return m_value.load(std::memory_order_relaxed); }
+    void reset() { m_value.store(0, std::memory_order_relaxed); }
+    const char* name() const { return m_name; }
+
+    Counter(const Counter&) = delete;
+    Counter& operator=(const Counter&) = delete;
+
+private:
+    const char* m_name;
+    std::atomic<std::int64_t> m_value;
+};
+
+/**
+ * @brief 计数器当前值
+ */
+struct CounterValue {
+    std::string name;
+    std::int64_t value = 0;
+};
+
+/**
+ * @brief 所有已登记计数器的当前值(按名称排序，同名计数器合并)
+ */
+std::vector<CounterValue> counters();
+
+/**
+ * @brief 单个阶段的耗时统计
+ */
+struct StageStats {
+    std::string name;
+    std::size_t count = 0;
+    double totalMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+};
+
+/**
+ * @brief 缓冲区中的事件，按开始时刻排序
+ */
+std::vector<Event> snapshot();
+
+/**
+ * @brief 按阶段名汇总缓冲区中的耗时，按总耗时从大到小排序
+ */
+std::vector<StageStats> stageSummary();
+
+/**
+ * @brief 因缓冲区写满而被覆盖的事件数
+ */
+std::uint64_t droppedEvents();
+
+/**
+ * @brief 清空事件缓冲并将计数器归零
+ */
+void clear();
+
+/**
+ * @brief 把缓冲区中的事件和计数器写成 Chrome trace JSON
+ */
+void writeChromeTrace(std::ostream& os);
+
+/**
+ * @brief 把Chrome trace JSON写入文件
+ * @return 文件无法写入时返回false
+ */
+bool writeChromeTrace(const std::string& path);
+
+/**
+ * @brief 按环境变量配置日志级别和计时
+ *
+ * PASSIVELOCATION_LOG_LEVEL=trace|debug|info|warn|error|off 设置日志级别；
+ * PASSIVELOCATION_TRACE=<文件> 开启计时，finish() 时写出trace文件。
+ */
+void configureFromEnvironment();
+
+/**
+ * @brief 设置finish()时写出的trace文件并开启计时，传入空字符串关闭
+ */
+void setTraceOutput(const std::string& path);
+
+/**
+ * @brief 程序退出前调用：若设置了trace文件则写出
+ */
+void finish();
+
+} // namespace Instrumentation
+
+#define PL_INSTR_CONCAT_IMPL(a, b) a##b
+#define PL_INSTR_CONCAT(a, b) PL_INSTR_CONCAT_IMPL(a, b)
+
+#ifndef PASSIVELOCATION_NO_INSTRUMENTATION
+
+#define PL_TRACE_SCOPE(name) \
+    ::Instrumentation::ScopedTimer PL_INSTR_CONCAT(plTraceScope_, __LINE__)(name)
+
+#define PL_TRACE_SCOPE_CAT(name, category) \
+    ::Instrumentation::ScopedTimer PL_INSTR_CONCAT(plTraceScope_, __LINE__)(name, category)
+
+#define PL_TRACE_INSTANT(name) \
+    do { \
+        if (::Instrumentation::tracingEnabled()) ::Instrumentation::recordInstant(name, "event"); \
+    } while (0)
+
+#define PL_COUNTER_ADD(name, delta) \
+    do { \
+        static ::Instrumentation::Counter plCounter_(name); \
+        plCounter_.add(delta); \
+    } while (0)
+
+#else
+
+#define PL_TRACE_SCOPE(name) ((void)0)
+#define PL_TRACE_SCOPE_CAT(name, category) ((void)0)
+#define PL_TRACE_INSTANT(name) ((void)0)
+#define PL_COUNTER_ADD(name, delta) ((void)0)
+
+#endif
+
+#endif // INSTRUMENTATION_H
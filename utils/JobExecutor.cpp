@@ -0,0 +1,195 @@
+#include "JobExecutor.h"
+#include "RandomStream.h"
+#include "Log.h"
+#include <glib.h>
+#include <algorithm>
+#include <exception>
+
+// 进度合并：工作线程只更新最新值，主线程上同一时刻最多挂起一个进度回调
+struct JobContext::ProgressState {
+    std::mutex mutex;
+    double fraction = 0.0;
+    std::string message;
+    bool pending = false;
+    std::function<void(int, double, const std::string&)> callback;
+};
+
+namespace {
+
+gboolean invokeOnMainThread(gpointer data) {
+    auto* fn = static_cast<std::function<void()>*>(data);
+    (*fn)();
+    return G_SOURCE_REMOVE;
+}
+
+void destroyMainThreadCall(gpointer data) {
+    delete static_cast<std::function<void()>*>(data);
+}
+
+} // namespace
+
+void JobContext::setProgress(double fraction, const std::string& message) {
+    if (!m_progress || !m_progress->callback) return;
+    fraction = std::min(std::max(fraction, 0.0), 1.0);
+
+    {
+        std::lock_guard<std::mutex> lock(m_progress->mutex);
+        m_progress->fraction = fraction;
+        m_progress->message = message;
+        if (m_progress->pending) return;
+        m_progress->pending = true;
+    }
+
+    const int id = m_id;
+    std::shared_ptr<ProgressState> progress = m_progress;
+    JobExecutor::runOnMainThread([id, progress]() {
+        double latestFraction;
+        std::string latestMessage;
+        {
+            std::lock_guard<std::mutex> lock(progress->mutex);
+            latestFraction = progress->fraction;
+            latestMessage = progress->message;
+            progress->pending = false;
+        }
+        progress->callback(id, latestFraction, latestMessage);
+    });
+}
+
+JobExecutor& JobExecutor::getInstance() {
+    static JobExecutor instance;
+    return instance;
+}
+
+JobExecutor::JobExecutor() : m_nextId(1), m_stopping(false) {
+    // 单个仿真内部的蒙特卡洛已经并行，执行器只需少量线程让多个仿真交错推进
+    unsigned int hardware = std::thread::hardware_concurrency();
+    unsigned int count = std::min(std::max(hardware / 4, 2u), 4u);
+    m_workers.reserve(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        m_workers.emplace_back(&JobExecutor::workerLoop, this);
+    }
+}
+
+JobExecutor::~JobExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        for (auto& entry : m_active) {
+            entry.second->cancelled->store(true);
+        }
+        m_queue.clear();
+    }
+    m_cond.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void JobExecutor::runOnMainThread(std::function<void()> fn) {
+    if (!fn) return;
+    g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, invokeOnMainThread,
+                    new std::function<void()>(std::move(fn)), destroyMainThreadCall);
+}
+
+int JobExecutor::submit(const std::string& name, Work work, JobCallbacks callbacks) {
+    auto job = std::make_shared<Job>();
+    job->name = name;
+    job->work = std::move(work);
+    job->callbacks = std::move(callbacks);
+    job->cancelled = std::make_shared<std::atomic<bool>>(false);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        job->id = m_nextId++;
+        m_active[job->id] = job;
+        m_queue.push_back(job);
+    }
+    m_cond.notify_one();
+    PL_LOG_DEBUG("[JobExecutor] 提交任务 #%d: %s\n", job->id, name.c_str());
+    return job->id;
+}
+
+bool JobExecutor::cancel(int jobId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_active.find(jobId);
+    if (it == m_active.end()) return false;
+    it->second->cancelled->store(true);
+    return true;
+}
+
+void JobExecutor::cancelAll() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_active) {
+        entry.second->cancelled->store(true);
+    }
+}
+
+std::size_t JobExecutor::activeJobCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_active.size();
+}
+
+void JobExecutor::workerLoop() {
+    for (;;) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) return;
+            job = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        if (job->cancelled->load()) {
+            finishJob(job, JobStatus::Cancelled, Completion(), std::string());
+            continue;
+        }
+
+        auto progress = std::make_shared<JobContext::ProgressState>();
+        progress->callback = job->callbacks.onProgress;
+        JobContext context(job->id, job->name, job->cancelled, progress);
+        // 任务中的随机流按任务编号派生，同一主种子下重复提交相同任务序列可复现
+        RandomService::JobScope randomScope(static_cast<std::uint64_t>(job->id));
+
+        try {
+            Completion completion = job->work(context);
+            finishJob(job, job->cancelled->load() ? JobStatus::Cancelled : JobStatus::Completed,
+                      std::move(completion), std::string());
+        } catch (const std::exception& e) {
+            PL_LOG_ERROR("[JobExecutor] 任务 #%d 失败: %s\n", job->id, e.what());
+            finishJob(job, JobStatus::Failed, Completion(), e.what());
+        } catch (...) {
+            PL_LOG_ERROR("[JobExecutor] 任务 #%d 失败: 未知异常\n", job->id);
+            finishJob(job, JobStatus::Failed, Completion(), "未知异常");
+        }
+    }
+}
+
+void JobExecutor::finishJob(const std::shared_ptr<Job>& job, JobStatus status, Completion completion,
+                            const std::string& error) {
+    // 完成回调与结束回调一起投递，排在该任务之前投递的进度回调之后执行；
+    // 任务在主线程执行完成回调前仍计为活动任务，期间请求的取消同样生效
+    runOnMainThread([this, job, status, completion, error]() {
+        JobStatus finalStatus = status;
+        std::string finalError = error;
+        if (finalStatus == JobStatus::Completed && job->cancelled->load()) {
+            finalStatus = JobStatus::Cancelled;
+        }
+        if (finalStatus == JobStatus::Completed && completion) {
+            try {
+                completion();
+            } catch (const std::exception& e) {
+                PL_LOG_ERROR("[JobExecutor] 任务 #%d 完成回调失败: %s\n", job->id, e.what());
+                finalStatus = JobStatus::Failed;
+                finalError = e.what();
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_active.erase(job->id);
+        }
+        if (job->callbacks.onFinished) {
+            job->callbacks.onFinished(job->id, finalStatus, finalError);
+        }
+    });
+}
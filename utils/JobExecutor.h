@@ -0,0 +1,162 @@
+/**
+ * @file JobExecutor.h
+ * @brief 后台任务执行器：在工作线程中运行仿真，结果通过 g_idle_add 投递回GTK主线程
+ */
+
+#ifndef JOB_EXECUTOR_H
+#define JOB_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 后台任务的结束状态
+ */
+enum class JobStatus {
+    Completed,  // 正常完成，完成回调已在主线程执行
+    Cancelled,  // 被取消，完成回调不会执行
+    Failed      // 任务函数抛出异常
+};
+
+class JobExecutor;
+
+/**
+ * @brief 任务上下文，由工作线程传给任务函数
+ *
+ * 任务函数应在各阶段之间调用 isCancelled() 检查取消请求(协作式取消)，
+ * 并通过 setProgress() 报告进度。进度回调被合并后在主线程执行，可以放心频繁调用。
+ */
+class JobContext {
+public:
+    int jobId() const { return m_id; }
+    const std::string& name() const { return m_name; }
+
+    /**
+     * @brief 是否已请求取消
+     */
+    bool isCancelled() const { return m_cancelled->load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 取消标志，可直接传给 MonteCarloConfig::cancelFlag 等长时间运行的计算
+     */
+    const std::atomic<bool>* cancelFlag() const { return m_cancelled.get(); }
+
+    /**
+     * @brief 报告进度
+     * @param fraction 完成比例[0, 1]
+     * @param message 当前阶段说明
+     */
+    void setProgress(double fraction, const std::string& message);
+
+private:
+    friend class JobExecutor;
+    struct ProgressState;
+
+    JobContext(int id, const std::string& name, std::shared_ptr<std::atomic<bool>> cancelled,
+               std::shared_ptr<ProgressState> progress)
+        : m_id(id), m_name(name), m_cancelled(std::move(cancelled)), m_progress(std::move(progress)) {}
+
+    int m_id;
+    std::string m_name;
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+    std::shared_ptr<ProgressState> m_progress;
+};
+
+/**
+ * @brief 任务回调，均在GTK主线程执行
+ */
+struct JobCallbacks {
+    std::function<void(int jobId, double fraction, const std::string& message)> onProgress;
+    std::function<void(int jobId, JobStatus status, const std::string& error)> onFinished;
+};
+
+/**
+ * @brief 后台任务执行器(单例)
+ *
+ * 固定数量的工作线程按提交顺序领取任务，多个仿真可以同时排队和并发执行。
+ * 任务函数在工作线程中完成数据库读写和算法计算，返回的完成回调在主线程执行，
+ * 所有界面和地图(WebKit)操作都必须放在完成回调中。
+ * 任务之间不应共享可变状态：算法对象应在任务函数内部创建，而不是使用全局单例。
+ */
+class JobExecutor {
+public:
+    // 在主线程执行的完成回调，可为空
+    using Completion = std::function<void()>;
+    // 在工作线程执行的任务函数
+    using Work = std::function<Completion(JobContext& context)>;
+
+    static JobExecutor& getInstance();
+
+    /**
+     * @brief 提交任务
+     * @param name 任务名称(用于日志和界面显示)
+     * @param work 任务函数
+     * @param callbacks 进度与结束回调
+     * @return 任务编号
+     */
+    int submit(const std::string& name, Work work, JobCallbacks callbacks = JobCallbacks());
+
+    /**
+     * @brief 请求取消任务：排队中的任务不再执行，运行中的任务在下一个检查点结束
+     * @return 任务存在且尚未结束时返回 true
+     */
+    bool cancel(int jobId);
+
+    /**
+     * @brief 请求取消全部排队和运行中的任务
+     */
+    void cancelAll();
+
+    /**
+     * @brief 排队和运行中的任务数
+     */
+    std::size_t activeJobCount() const;
+
+    /**
+     * @brief 工作线程数
+     */
+    unsigned int workerCount() const { return static_cast<unsigned int>(m_workers.size()); }
+
+    /**
+     * @brief 把函数投递到GTK主线程执行(g_idle_add)，可在任意线程调用
+     */
+    static void runOnMainThread(std::function<void()> fn);
+
+private:
+    JobExecutor();
+    ~JobExecutor();
+
+    JobExecutor(const JobExecutor&) = delete;
+    JobExecutor& operator=(const JobExecutor&) = delete;
+
+    struct Job {
+        int id;
+        std::string name;
+        Work work;
+        JobCallbacks callbacks;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    void workerLoop();
+    void finishJob(const std::shared_ptr<Job>& job, JobStatus status, Completion completion,
+                   const std::string& error);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<std::shared_ptr<Job>> m_queue;
+    std::map<int, std::shared_ptr<Job>> m_active;  // 排队和运行中的任务
+    std::vector<std::thread> m_workers;
+    int m_nextId;
+    bool m_stopping;
+};
+
+#endif // JOB_EXECUTOR_H
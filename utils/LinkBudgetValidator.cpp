@@ -0,0 +1,302 @@
+/**
+ * @file LinkBudgetValidator.cpp
+ * @brief 批量链路预算与可见性筛查的实现
+ */
+
+#include "LinkBudgetValidator.h"
+#include "CoordinateTransform.h"
+#include "Instrumentation.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 每个并行块处理的辐射源数
+const std::size_t SOURCE_GRAIN = 8;
+
+/**
+ * 伪角：把方位角 atan2(east, north)∈[0°,360°) 单调映射到 [0, 4)，只用除法。
+ * 第一象限为 r，其余象限按 2-r、2+r、4-r 依次拼接，r = |east| / (|east| + |north|)。
+ * 写成条件选择而非分支，内层循环可以向量化。
+ */
+inline double pseudoAzimuth(double east, double north) {
+    const double ae = std::fabs(east);
+    const double an = std::fabs(north);
+    const double sum = ae + an;
+    const double r = ae / (sum > 0.0 ? sum : 1.0);
+    const double eastHalf = north >= 0.0 ? r : 2.0 - r;
+    const double westHalf = north < 0.0 ? 2.0 + r : 4.0 - r;
+    return east >= 0.0 ? eastHalf : westHalf;
+}
+
+// 方位边界(度)对应的伪角，范围外的边界保持与角度比较相同的结果
+double pseudoAzimuthBound(double degrees) {
+    if (degrees < 0.0) return -1.0;
+    if (degrees >= 360.0) return 4.0;
+    const double rad = degrees * Constants::DEG2RAD;
+    return pseudoAzimuth(std::sin(rad), std::cos(rad));
+}
+
+/**
+ * 俯仰边界 e：dz·cos e - h·sin e = R·sin(el - e)，其符号给出 el 与 e 的大小关系；
+ * |e| > 90° 时用常数 ±1 表示恒成立或恒不成立。
+ */
+struct ElevationBound {
+    double c = 0.0;
+    double s = 0.0;
+    double k = 0.0;
+};
+
+ElevationBound elevationBound(double degrees) {
+    ElevationBound bound;
+    if (degrees < -90.0) {
+        bound.k = 1.0;
+    } else if (degrees > 90.0) {
+        bound.k = -1.0;
+    } else {
+        bound.c = std::cos(degrees * Constants::DEG2RAD);
+        bound.s = std::sin(degrees * Constants::DEG2RAD);
+    }
+    return bound;
+}
+
+/**
+ * 判定结果在内层循环中用 0.0/1.0 表示：与 double 同宽，比较结果只需按位与即可得到，
+ * 不需要整数窄化转换，基线 SSE2 指令集下也能向量化。与、或分别用乘法和 max 表示。
+ */
+inline double flag(bool condition) {
+    return condition ? 1.0 : 0.0;
+}
+
+// 与 isAngleInRange 相同：下限大于上限(wrap 为1)时表示跨越区间
+inline double inRange(double aboveMin, double belowMax, double wrap) {
+    return std::max(aboveMin * belowMax, wrap * std::max(aboveMin, belowMax));
+}
+
+// 扇区参数(结构数组)
+struct SectorArrays {
+    std::vector<double> azMin, azMax;                  // 伪角
+    std::vector<double> azWrap;                        // 跨越区间为1
+    std::vector<double> elMinC, elMinS, elMinK;
+    std::vector<double> elMaxC, elMaxS, elMaxK;
+    std::vector<double> elWrap;
+
+    void resize(std::size_t n) {
+        azMin.resize(n); azMax.resize(n); azWrap.resize(n);
+        elMinC.resize(n); elMinS.resize(n); elMinK.resize(n);
+        elMaxC.resize(n); elMaxS.resize(n); elMaxK.resize(n);
+        elWrap.resize(n);
+    }
+
+    void set(std::size_t i, double azimuthMin, double azimuthMax, double elevationMin, double elevationMax) {
+        azMin[i] = pseudoAzimuthBound(azimuthMin);
+        azMax[i] = pseudoAzimuthBound(azimuthMax);
+        azWrap[i] = azimuthMin > azimuthMax ? 1.0 : 0.0;
+        const ElevationBound lo = elevationBound(elevationMin);
+        const ElevationBound hi = elevationBound(elevationMax);
+        elMinC[i] = lo.c; elMinS[i] = lo.s; elMinK[i] = lo.k;
+        elMaxC[i] = hi.c; elMaxS[i] = hi.s; elMaxK[i] = hi.k;
+        elWrap[i] = elevationMin > elevationMax ? 1.0 : 0.0;
+    }
+};
+
+// 侦察设备参数(结构数组)
+struct DeviceArrays {
+    std::vector<double> x, y, z;            // 空间直角坐标(米)
+    std::vector<double> noiseDb;            // -10·log10(噪声功率 W)
+    std::vector<double> rangeScale;         // 1/sqrt(噪声功率)
+    std::vector<double> freqMin, freqMax;   // 侦收频率范围(GHz)
+    SectorArrays sector;
+};
+
+// 单个辐射源的参数
+struct SourceParams {
+    double x, y, z;
+    double freq;
+    double rangeScale;
+    double azMin, azMax, azWrap;
+    double elMinC, elMinS, elMinK;
+    double elMaxC, elMaxS, elMaxK;
+    double elWrap;
+};
+
+// 筛查标志位
+const int FLAG_BAND = 1;
+const int FLAG_SNR = 2;
+const int FLAG_VISIBLE = 4;
+
+/**
+ * 一个辐射源对全部设备的筛查内核：输出距离平方、最大可探测距离和标志位。
+ * 所有判定写成比较和 0/1 乘法，循环体无分支，便于编译器向量化。
+ */
+void screenSourceKernel(const SourceParams& src,
+                        const double* __restrict x, const double* __restrict y, const double* __restrict z,
+                        const double* __restrict rangeScale,
+                        const double* __restrict freqMin, const double* __restrict freqMax,
+                        const double* __restrict azMin, const double* __restrict azMax,
+                        const double* __restrict azWrap,
+                        const double* __restrict elMinC, const double* __restrict elMinS,
+                        const double* __restrict elMinK,
+                        const double* __restrict elMaxC, const double* __restrict elMaxS,
+                        const double* __restrict elMaxK,
+                        const double* __restrict elWrap,
+                        double* __restrict distance2, float* __restrict range,
+                        double* __restrict flags, std::size_t n) {
+    const double sx = src.x, sy = src.y, sz = src.z;
+    const double freq = src.freq, sourceRangeScale = src.rangeScale;
+    const double eAzMin = src.azMin, eAzMax = src.azMax;
+    const double eLoC = src.elMinC, eLoS = src.elMinS, eLoK = src.elMinK;
+    const double eHiC = src.elMaxC, eHiS = src.elMaxS, eHiK = src.elMaxK;
+    const double eAzWrap = src.azWrap, eElWrap = src.elWrap;
+    for (std::size_t d = 0; d < n; ++d) {
+        // 设备指向辐射源的向量(与 calculateAzimuthElevation 相同，直接使用直角坐标分量)
+        const double dx = sx - x[d];
+        const double dy = sy - y[d];
+        const double dz = sz - z[d];
+        const double horizontal2 = dx * dx + dy * dy;
+        const double d2 = horizontal2 + dz * dz;
+        const double h = std::sqrt(horizontal2);
+
+        // 设备侦收扇区覆盖辐射源
+        const double pr = pseudoAzimuth(dx, dy);
+        const double rAz = inRange(flag(pr >= azMin[d]), flag(pr <= azMax[d]), azWrap[d]);
+        const double rLo = dz * elMinC[d] - h * elMinS[d] + elMinK[d];
+        const double rHi = dz * elMaxC[d] - h * elMaxS[d] + elMaxK[d];
+        const double rEl = inRange(flag(rLo >= 0.0), flag(rHi <= 0.0), elWrap[d]);
+
+        // 辐射源工作扇区覆盖设备(反向向量)
+        const double pe = pseudoAzimuth(-dx, -dy);
+        const double eAz = inRange(flag(pe >= eAzMin), flag(pe <= eAzMax), eAzWrap);
+        const double eLo = -dz * eLoC - h * eLoS + eLoK;
+        const double eHi = -dz * eHiC - h * eHiS + eHiK;
+        const double eEl = inRange(flag(eLo >= 0.0), flag(eHi <= 0.0), eElWrap);
+
+        // 信噪比不低于门限 <=> 距离不超过最大可探测距离
+        const double maxRange = sourceRangeScale * rangeScale[d];
+        const double snrOk = flag(d2 <= maxRange * maxRange);
+        const double bandOk = flag(freq >= freqMin[d]) * flag(freq <= freqMax[d]);
+        const double visibleOk = rAz * rEl * eAz * eEl;
+
+        distance2[d] = d2;
+        range[d] = static_cast<float>(maxRange);
+        flags[d] = bandOk * FLAG_BAND + snrOk * FLAG_SNR + visibleOk * FLAG_VISIBLE;
+    }
+}
+
+} // namespace
+
+LinkBudgetMatrix validateLinkBudgetBatch(const std::vector<ReconnaissanceDevice>& devices,
+                                         const std::vector<RadiationSource>& sources,
+                                         const LinkBudgetOptions& options) {
+    PL_TRACE_SCOPE("LinkBudget.validateBatch");
+    LinkBudgetMatrix result;
+    const std::size_t M = devices.size();
+    const std::size_t N = sources.size();
+    result.deviceCount = M;
+    result.sourceCount = N;
+    result.snrDb.resize(M * N);
+    result.detectionRange.resize(M * N);
+    result.inBand.resize(M * N);
+    result.snrPass.resize(M * N);
+    result.visible.resize(M * N);
+    result.receivable.resize(M * N);
+    result.receivableCount.assign(N, 0);
+    if (M == 0 || N == 0) {
+        return result;
+    }
+
+    // 设备参数整理为结构数组
+    DeviceArrays dev;
+    dev.x.resize(M); dev.y.resize(M); dev.z.resize(M);
+    dev.noiseDb.resize(M); dev.rangeScale.resize(M);
+    dev.freqMin.resize(M); dev.freqMax.resize(M);
+    dev.sector.resize(M);
+    for (std::size_t d = 0; d < M; ++d) {
+        const ReconnaissanceDevice& device = devices[d];
+        const COORD3 xyz = lbh2xyz(device.getLongitude(), device.getLatitude(), device.getAltitude());
+        dev.x[d] = xyz.p1;
+        dev.y[d] = xyz.p2;
+        dev.z[d] = xyz.p3;
+        dev.freqMin[d] = device.getFreqRangeMin();
+        dev.freqMax[d] = device.getFreqRangeMax();
+        const double bandwidthGHz = options.bandwidthGHz > 0.0 ? options.bandwidthGHz : dev.freqMax[d] - dev.freqMin[d];
+        // 噪声功率 Pn = N0(W/Hz)·B(Hz)
+        const double noisePower = std::pow(10.0, device.getNoisePsd() / 10.0) / 1000.0 * bandwidthGHz * 1e9;
+        dev.noiseDb[d] = -10.0 * std::log10(noisePower);
+        dev.rangeScale[d] = 1.0 / std::sqrt(noisePower);
+        dev.sector.set(d, device.getAngleAzimuthMin(), device.getAngleAzimuthMax(),
+                       device.getAngleElevationMin(), device.getAngleElevationMax());
+    }
+
+    // 辐射源参数：Pr = Pt·(λ/4π)²/d²，与距离无关的部分 G = Pt·(λ/4π)²
+    std::vector<SourceParams> src(N);
+    std::vector<double> srcGainDb(N);
+    const double thresholdLinear = std::pow(10.0, options.snrThresholdDb / 10.0);
+    SectorArrays srcSector;
+    srcSector.resize(N);
+    for (std::size_t s = 0; s < N; ++s) {
+        const RadiationSource& source = sources[s];
+        const COORD3 xyz = lbh2xyz(source.getLongitude(), source.getLatitude(), source.getAltitude());
+        const double lambda = Constants::c / (source.getCarrierFrequency() * 1e9);
+        const double gain = source.getTransmitPower() * 1000.0 * std::pow(lambda / (4.0 * Constants::PI), 2);
+        srcGainDb[s] = 10.0 * std::log10(gain);
+        srcSector.set(s, source.getAzimuthStart(), source.getAzimuthEnd(),
+                      source.getElevationStart(), source.getElevationEnd());
+
+        SourceParams& p = src[s];
+        p.x = xyz.p1;
+        p.y = xyz.p2;
+        p.z = xyz.p3;
+        p.freq = source.getCarrierFrequency();
+        // 最大可探测距离 = sqrt(G / (Pn·SNRmin))
+        p.rangeScale = std::sqrt(gain / thresholdLinear);
+        p.azMin = srcSector.azMin[s];
+        p.azMax = srcSector.azMax[s];
+        p.azWrap = srcSector.azWrap[s];
+        p.elMinC = srcSector.elMinC[s]; p.elMinS = srcSector.elMinS[s]; p.elMinK = srcSector.elMinK[s];
+        p.elMaxC = srcSector.elMaxC[s]; p.elMaxS = srcSector.elMaxS[s]; p.elMaxK = srcSector.elMaxK[s];
+        p.elWrap = srcSector.elWrap[s];
+    }
+
+    const SectorArrays& ds = dev.sector;
+    parallelFor(N, options.threadCount, SOURCE_GRAIN, [&](std::size_t begin, std::size_t end) {
+        std::vector<double> distance2(M);
+        std::vector<double> flags(M);
+        for (std::size_t s = begin; s < end; ++s) {
+            const std::size_t row = s * M;
+            screenSourceKernel(src[s], dev.x.data(), dev.y.data(), dev.z.data(), dev.rangeScale.data(),
+                               dev.freqMin.data(), dev.freqMax.data(),
+                               ds.azMin.data(), ds.azMax.data(), ds.azWrap.data(),
+                               ds.elMinC.data(), ds.elMinS.data(), ds.elMinK.data(),
+                               ds.elMaxC.data(), ds.elMaxS.data(), ds.elMaxK.data(), ds.elWrap.data(),
+                               distance2.data(), result.detectionRange.data() + row, flags.data(), M);
+
+            // 展开标志位并统计
+            std::uint8_t* inBandRow = result.inBand.data() + row;
+            std::uint8_t* snrPassRow = result.snrPass.data() + row;
+            std::uint8_t* visibleRow = result.visible.data() + row;
+            std::uint8_t* receivableRow = result.receivable.data() + row;
+            std::uint32_t count = 0;
+            for (std::size_t d = 0; d < M; ++d) {
+                const int f = static_cast<int>(flags[d]);
+                const std::uint8_t ok = f == (FLAG_BAND | FLAG_SNR | FLAG_VISIBLE);
+                inBandRow[d] = (f & FLAG_BAND) != 0;
+                snrPassRow[d] = (f & FLAG_SNR) != 0;
+                visibleRow[d] = (f & FLAG_VISIBLE) != 0;
+                receivableRow[d] = ok;
+                count += ok;
+            }
+            result.receivableCount[s] = count;
+
+            // 信噪比(dB) = 10·log10(G) - 10·log10(Pn) - 10·log10(d²)
+            float* snrRow = result.snrDb.data() + row;
+            const double gainDb = srcGainDb[s];
+            for (std::size_t d = 0; d < M; ++d) {
+                snrRow[d] = static_cast<float>(gainDb + dev.noiseDb[d] - 10.0 * std::log10(distance2[d]));
+            }
+        }
+    });
+    PL_COUNTER_ADD("linkBudget.pairs", static_cast<std::int64_t>(M * N));
+    return result;
+}
@@ -0,0 +1,61 @@
+/**
+ * @file LinkBudgetValidator.h
+ * @brief 批量链路预算与可见性筛查：M个侦察设备 × N个辐射源一次计算
+ *
+ * 判定规则与 validateFrequency、validateSNR、validateAngle 相同，但直接使用内存中的设备和辐射源列表，
+ * 不按ID逐个查询数据库。设备参数整理为结构数组(SoA)，按辐射源并行、按设备顺序做无分支内层循环：
+ * 信噪比判定比较距离平方与最大可探测距离平方，扇区判定用伪角和正弦差代替 atan2，
+ * 内层循环不调用 pow/log10/atan2，信噪比(dB)在单独的循环中补算。
+ */
+
+#ifndef LINK_BUDGET_VALIDATOR_H
+#define LINK_BUDGET_VALIDATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../constants/PhysicsConstants.h"
+#include "../models/ReconnaissanceDeviceModel.h"
+#include "../models/RadiationSourceModel.h"
+
+/**
+ * @brief 批量筛查参数
+ */
+struct LinkBudgetOptions {
+    double bandwidthGHz = 0.0;                          // 计算噪声功率的带宽(GHz)，0 表示取各设备自身的频率范围宽度
+    double snrThresholdDb = Constants::SNR_THRESHOLD;   // 最小可接收信噪比(dB)
+    unsigned int threadCount = 0;                       // 线程数，0 表示使用全部硬件线程
+};
+
+/**
+ * @brief 批量筛查结果，各矩阵按辐射源行存储：第 s 行第 d 列为辐射源 s 与设备 d
+ */
+struct LinkBudgetMatrix {
+    std::size_t deviceCount = 0;
+    std::size_t sourceCount = 0;
+    std::vector<float> snrDb;                   // 信噪比(dB)
+    std::vector<float> detectionRange;          // 最大可探测距离(米)
+    std::vector<std::uint8_t> inBand;           // 辐射源载频在设备侦收频率范围内
+    std::vector<std::uint8_t> snrPass;          // 信噪比不低于门限(距离不超过最大可探测距离)
+    std::vector<std::uint8_t> visible;          // 设备侦收扇区覆盖辐射源，且辐射源工作扇区覆盖设备
+    std::vector<std::uint8_t> receivable;       // 以上三项均满足
+    std::vector<std::uint32_t> receivableCount; // 每个辐射源可接收其信号的设备数
+
+    std::size_t index(std::size_t source, std::size_t device) const { return source * deviceCount + device; }
+};
+
+/**
+ * @brief 计算设备 × 辐射源的信噪比、最大可探测距离和扇区可见性矩阵
+ *
+ * 位置取设备和辐射源的初始位置(与单对验证函数相同)。
+ * 如需复现 validateSNR 对一组设备的判定，将 options.bandwidthGHz 设为这组设备频率范围交集的宽度。
+ * @param devices 侦察设备列表
+ * @param sources 辐射源列表
+ * @param options 筛查参数
+ * @return 结果矩阵
+ */
+LinkBudgetMatrix validateLinkBudgetBatch(const std::vector<ReconnaissanceDevice>& devices,
+                                         const std::vector<RadiationSource>& sources,
+                                         const LinkBudgetOptions& options = LinkBudgetOptions());
+
+#endif // LINK_BUDGET_VALIDATOR_H
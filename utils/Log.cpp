@@ -0,0 +1,106 @@
+#include "Log.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace Log {
+namespace detail {
+std::atomic<int> g_minimumLevel(static_cast<int>(Level::Info));
+}
+}
+
+namespace {
+
+std::mutex& logMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+Log::Sink& logSink() {
+    static Log::Sink sink;
+    return sink;
+}
+
+std::atomic<bool> g_logEnabled(true);
+
+void vprint(const char* format, va_list args) {
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    const int length = std::vsnprintf(nullptr, 0, format, argsCopy);
+    va_end(argsCopy);
+    if (length < 0) {
+        return;
+    }
+    std::vector<char> buffer(static_cast<std::size_t>(length) + 1);
+    std::vsnprintf(buffer.data(), buffer.size(), format, args);
+
+    const std::string message(buffer.data(), static_cast<std::size_t>(length));
+    std::lock_guard<std::mutex> lock(logMutex());
+    if (logSink()) {
+        logSink()(message);
+    } else {
+        std::fputs(message.c_str(), stdout);
+        std::fflush(stdout);
+    }
+}
+
+} // namespace
+
+namespace Log {
+
+void print(const char* format, ...) {
+    if (!g_logEnabled.load(std::memory_order_relaxed) || !isEnabled(Level::Info)) return;
+
+    va_list args;
+    va_start(args, format);
+    vprint(format, args);
+    va_end(args);
+}
+
+void print(Level level, const char* format, ...) {
+    if (!g_logEnabled.load(std::memory_order_relaxed) || !isEnabled(level)) return;
+
+    va_list args;
+    va_start(args, format);
+    vprint(format, args);
+    va_end(args);
+}
+
+void setSink(Sink sink) {
+    std::lock_guard<std::mutex> lock(logMutex());
+    logSink() = std::move(sink);
+}
+
+void setEnabled(bool enabled) {
+    g_logEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void setLevel(Level level) {
+    detail::g_minimumLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+Level level() {
+    return static_cast<Level>(detail::g_minimumLevel.load(std::memory_order_relaxed));
+}
+
+bool parseLevel(const std::string& name, Level& level) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+    static const struct { const char* name; Level level; } levels[] = {
+        {"trace", Level::Trace}, {"debug", Level::Debug}, {"info", Level::Info},
+        {"warn", Level::Warn}, {"error", Level::Error}, {"off", Level::Off},
+    };
+    for (const auto& entry : levels) {
+        if (lower == entry.name) {
+            level = entry.level;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Log
@@ -0,0 +1,134 @@
+/**
+ * @file Log.h
+ * @brief 分级控制台日志，替代 g_print，使算法库不依赖glib
+ *
+ * 算法中的逐步打印使用 PL_LOG_DEBUG 等宏：级别在运行时可调，低于当前级别时不做格式化；
+ * 编译时定义 PASSIVELOCATION_LOG_MIN_LEVEL(0=trace ... 4=error)可以把更低级别的调用整体去掉。
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <functional>
+#include <string>
+
+// 编译期保留的最低日志级别，低于该级别的 PL_LOG_* 调用展开为空
+#ifndef PASSIVELOCATION_LOG_MIN_LEVEL
+#define PASSIVELOCATION_LOG_MIN_LEVEL 0
+#endif
+
+namespace Log {
+
+/**
+ * @brief 日志级别，数值与 PASSIVELOCATION_LOG_MIN_LEVEL 对应
+ */
+enum class Level {
+    Trace = 0,  // 迭代过程等逐步细节
+    Debug = 1,  // 各阶段的中间量(坐标、时差表等)
+    Info = 2,   // 仿真开始和最终结果，默认级别
+    Warn = 3,
+    Error = 4,
+    Off = 5
+};
+
+namespace detail {
+extern std::atomic<int> g_minimumLevel;
+}
+
+/**
+ * @brief 当前级别下是否输出该级别的日志，供宏在格式化之前判断
+ */
+inline bool isEnabled(Level level) {
+    return static_cast<int>(level) >= detail::g_minimumLevel.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 设置运行时日志级别，低于该级别的日志被丢弃
+ */
+void setLevel(Level level);
+
+/**
+ * @brief 当前运行时日志级别
+ */
+Level level();
+
+/**
+ * @brief 由名称(trace/debug/info/warn/error/off，不区分大小写)解析日志级别
+ * @return 名称无效时返回false
+ */
+bool parseLevel(const std::string& name, Level& level);
+
+/**
+ * @brief 日志输出目标，参数为格式化后的完整文本(含换行)
+ */
+typedef std::function<void(const std::string&)> Sink;
+
+/**
+ * @brief 按printf格式输出一条日志，默认写到标准输出(与g_print一致)
+ *
+ * 可在任意线程调用，同一条日志不会与其他线程的输出交错。
+ */
+void print(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief 按指定级别输出一条日志，低于当前级别时直接返回
+ */
+void print(Level level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief 设置日志输出目标
+ * @param sink 输出函数，传入空函数恢复为标准输出
+ */
+void setSink(Sink sink);
+
+/**
+ * @brief 关闭或恢复日志输出(批量仿真时关闭算法的逐步打印)
+ */
+void setEnabled(bool enabled);
+
+} // namespace Log
+
+// 先判断级别再求值参数和格式化，关闭时只有一次原子读
+#define PL_LOG_AT(level, ...) \
+    do { \
+        if (::Log::isEnabled(level)) ::Log::print(level, __VA_ARGS__); \
+    } while (0)
+
+// 编译期移除的级别：参数仍做类型检查，但不求值、不生成代码
+#define PL_LOG_DISCARD(...) \
+    do { \
+        if (false) ::Log::print(::Log::Level::Off, __VA_ARGS__); \
+    } while (0)
+
+#if PASSIVELOCATION_LOG_MIN_LEVEL <= 0
+#define PL_LOG_TRACE(...) PL_LOG_AT(::Log::Level::Trace, __VA_ARGS__)
+#else
+#define PL_LOG_TRACE(...) PL_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if PASSIVELOCATION_LOG_MIN_LEVEL <= 1
+#define PL_LOG_DEBUG(...) PL_LOG_AT(::Log::Level::Debug, __VA_ARGS__)
+#else
+#define PL_LOG_DEBUG(...) PL_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if PASSIVELOCATION_LOG_MIN_LEVEL <= 2
+#define PL_LOG_INFO(...) PL_LOG_AT(::Log::Level::Info, __VA_ARGS__)
+#else
+#define PL_LOG_INFO(...) PL_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if PASSIVELOCATION_LOG_MIN_LEVEL <= 3
+#define PL_LOG_WARN(...) PL_LOG_AT(::Log::Level::Warn, __VA_ARGS__)
+#else
+#define PL_LOG_WARN(...) PL_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if PASSIVELOCATION_LOG_MIN_LEVEL <= 4
+#define PL_LOG_ERROR(...) PL_LOG_AT(::Log::Level::Error, __VA_ARGS__)
+#else
+#define PL_LOG_ERROR(...) PL_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#endif // LOG_H
@@ -0,0 +1,169 @@
+#include "MonteCarloEngine.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace {
+
+// 单个试验块的局部统计量
+struct BlockAccumulator {
+    std::size_t valid = 0;
+    double sumX = 0.0, sumY = 0.0;
+    double sumXX = 0.0, sumXY = 0.0, sumYY = 0.0;
+};
+
+} // namespace
+
+MonteCarloStats MonteCarloEngine::run(const MonteCarloConfig& config, const TrialFunction& trial) {
+    MonteCarloStats stats;
+    stats.requestedSamples = config.sampleCount;
+    if (config.sampleCount == 0 || !trial) {
+        return stats;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const bool hasBudget = config.timeBudgetMs > 0.0;
+    const auto deadline = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double, std::milli>(config.timeBudgetMs));
+
+    // 在调用线程取基准流，工作线程中的当前任务编号与调用方无关
+    const RandomStream baseStream = config.seed
+        ? RandomService::streamFromSeed(config.seed, RandomPurpose::MonteCarlo)
+        : RandomService::getInstance().stream(RandomPurpose::MonteCarlo);
+    const std::size_t blockCount = (config.sampleCount + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    unsigned int threadCount = config.threadCount ? config.threadCount : std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+    threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, blockCount));
+
+    // 按试验序号存放径向误差，分位数计算与调度顺序无关
+    std::vector<float> radii(config.sampleCount, std::numeric_limits<float>::quiet_NaN());
+    std::vector<BlockAccumulator> blocks(blockCount);
+    std::vector<char> blockDone(blockCount, 0);
+    const std::size_t keep = std::min(config.keepSamples, config.sampleCount);
+    std::vector<COORD3> kept(keep);
+    std::vector<char> keptValid(keep, 0);
+
+    std::atomic<std::size_t> nextBlock(0);
+    std::atomic<bool> budgetExceeded(false);
+    std::atomic<bool> cancelled(false);
+
+    auto worker = [&]() {
+        for (;;) {
+            const std::size_t b = nextBlock.fetch_add(1, std::memory_order_relaxed);
+            if (b >= blockCount) return;
+            // 第0块总是执行，保证超时或取消时也有可用的统计结果
+            if (b > 0 && hasBudget && std::chrono::steady_clock::now() >= deadline) {
+                budgetExceeded.store(true, std::memory_order_relaxed);
+                return;
+            }
+            if (b > 0 && config.cancelFlag && config.cancelFlag->load(std::memory_order_relaxed)) {
+                cancelled.store(true, std::memory_order_relaxed);
+                return;
+            }
+
+            BlockAccumulator acc;
+            const std::size_t begin = b * BLOCK_SIZE;
+            const std::size_t end = std::min(begin + BLOCK_SIZE, config.sampleCount);
+            for (std::size_t i = begin; i < end; ++i) {
+                RandomStream gen = baseStream.substream(i);
+                double dx = 0.0, dy = 0.0;
+                if (!trial(gen, dx, dy) || !std::isfinite(dx) || !std::isfinite(dy)) {
+                    continue;
+                }
+                ++acc.valid;
+                acc.sumX += dx;
+                acc.sumY += dy;
+                acc.sumXX += dx * dx;
+                acc.sumXY += dx * dy;
+                acc.sumYY += dy * dy;
+                radii[i] = static_cast<float>(std::sqrt(dx * dx + dy * dy));
+                if (i < keep) {
+                    kept[i] = COORD3(dx, dy, 0.0);
+                    keptValid[i] = 1;
+                }
+            }
+            blocks[b] = acc;
+            blockDone[b] = 1;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (unsigned int t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    // 只统计从第0块开始连续完成的块，超时截断后结果仍只取决于完成的试验数
+    std::size_t completedBlocks = 0;
+    while (completedBlocks < blockCount && blockDone[completedBlocks]) {
+        ++completedBlocks;
+    }
+    const std::size_t completedSamples = std::min(completedBlocks * BLOCK_SIZE, config.sampleCount);
+
+    // 按块序号合并，保证浮点求和顺序固定
+    BlockAccumulator total;
+    for (std::size_t b = 0; b < completedBlocks; ++b) {
+        total.valid += blocks[b].valid;
+        total.sumX += blocks[b].sumX;
+        total.sumY += blocks[b].sumY;
+        total.sumXX += blocks[b].sumXX;
+        total.sumXY += blocks[b].sumXY;
+        total.sumYY += blocks[b].sumYY;
+    }
+
+    stats.completedSamples = completedSamples;
+    stats.validSamples = total.valid;
+    stats.budgetExceeded = budgetExceeded.load() && completedSamples < config.sampleCount;
+    stats.cancelled = cancelled.load() && completedSamples < config.sampleCount;
+    stats.threadsUsed = threadCount;
+
+    if (total.valid > 0) {
+        const double n = static_cast<double>(total.valid);
+        stats.meanX = total.sumX / n;
+        stats.meanY = total.sumY / n;
+        if (total.valid > 1) {
+            stats.cov00 = (total.sumXX - n * stats.meanX * stats.meanX) / (n - 1.0);
+            stats.cov11 = (total.sumYY - n * stats.meanY * stats.meanY) / (n - 1.0);
+            stats.cov01 = (total.sumXY - n * stats.meanX * stats.meanY) / (n - 1.0);
+        }
+
+        // 2x2协方差矩阵特征值 -> 误差椭圆半轴
+        const double trace = stats.cov00 + stats.cov11;
+        const double det = stats.cov00 * stats.cov11 - stats.cov01 * stats.cov01;
+        const double disc = std::sqrt(std::max(0.0, trace * trace / 4.0 - det));
+        stats.majorAxis = std::sqrt(std::max(0.0, trace / 2.0 + disc));
+        stats.minorAxis = std::sqrt(std::max(0.0, trace / 2.0 - disc));
+
+        // 径向误差的置信度分位数
+        radii.resize(completedSamples);
+        radii.erase(std::remove_if(radii.begin(), radii.end(),
+                                   [](float r) { return std::isnan(r); }),
+                    radii.end());
+        if (!radii.empty()) {
+            const double q = std::min(std::max(config.confidence, 0.0), 1.0);
+            const std::size_t k = std::min(radii.size() - 1,
+                static_cast<std::size_t>(std::ceil(q * radii.size())) - (q > 0.0 ? 1 : 0));
+            std::nth_element(radii.begin(), radii.begin() + k, radii.end());
+            stats.confidenceRadius = radii[k];
+        }
+    }
+
+    stats.samples.reserve(keep);
+    for (std::size_t i = 0; i < keep && i < completedSamples; ++i) {
+        if (keptValid[i]) {
+            stats.samples.push_back(kept[i]);
+        }
+    }
+
+    stats.elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return stats;
+}
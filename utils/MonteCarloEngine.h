@@ -0,0 +1,79 @@
+/**
+ * @file MonteCarloEngine.h
+ * @brief 并行蒙特卡洛仿真引擎，用于误差圆(CEP)等统计量的估计
+ */
+
+#ifndef MONTE_CARLO_ENGINE_H
+#define MONTE_CARLO_ENGINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "CoordinateTransform.h"
+#include "RandomStream.h"
+
+/**
+ * @brief 蒙特卡洛仿真参数
+ */
+struct MonteCarloConfig {
+    std::size_t sampleCount = 100000;  // 试验次数
+    double confidence = 0.5;           // 置信度(0.5 即 CEP)
+    double timeBudgetMs = 0.0;         // 墙钟时间预算(毫秒)，0 表示不限制
+    unsigned int threadCount = 0;      // 线程数，0 表示使用全部硬件线程
+    std::uint64_t seed = 0;            // 随机种子，0 表示取 RandomService 中当前任务的随机流
+    std::size_t keepSamples = 100;     // 保留用于地图显示的样本点数量
+    const std::atomic<bool>* cancelFlag = nullptr;  // 取消标志(可选)，置位后在块边界提前结束
+};
+
+/**
+ * @brief 蒙特卡洛仿真统计结果(水平面二维偏差)
+ */
+struct MonteCarloStats {
+    std::size_t requestedSamples = 0;  // 请求的试验次数
+    std::size_t completedSamples = 0;  // 实际完成的试验次数
+    std::size_t validSamples = 0;      // 有效试验次数(剔除无解的试验)
+    bool budgetExceeded = false;       // 是否因时间预算提前结束
+    bool cancelled = false;            // 是否因取消标志提前结束
+    double meanX = 0.0, meanY = 0.0;   // 偏差均值(米)
+    double cov00 = 0.0, cov01 = 0.0, cov11 = 0.0;  // 偏差协方差(米^2)
+    double majorAxis = 0.0;            // 误差椭圆长半轴(1σ，米)
+    double minorAxis = 0.0;            // 误差椭圆短半轴(1σ，米)
+    double confidenceRadius = 0.0;     // 给定置信度下的径向误差分位数(米)
+    double elapsedMs = 0.0;            // 耗时(毫秒)
+    unsigned int threadsUsed = 0;      // 使用的线程数
+    std::vector<COORD3> samples;       // 前 keepSamples 个试验的偏差(dx, dy, 0)
+};
+
+/**
+ * @brief 并行蒙特卡洛仿真引擎
+ *
+ * 每次试验使用由(种子, 试验序号)派生的独立计数器型随机流，试验按固定大小分块并行执行，
+ * 各块统计量按块序号顺序合并，因此对给定种子结果与线程数、调度顺序无关。
+ */
+class MonteCarloEngine {
+public:
+    /**
+     * @brief 单次试验函数
+     * @param gen 本次试验的随机流
+     * @param dx 输出：水平偏差 x 分量(米)
+     * @param dy 输出：水平偏差 y 分量(米)
+     * @return 试验是否有效(例如测向线平行无交点时返回 false)
+     */
+    using TrialFunction = std::function<bool(RandomStream& gen, double& dx, double& dy)>;
+
+    /**
+     * @brief 执行蒙特卡洛仿真
+     * @param config 仿真参数
+     * @param trial 单次试验函数，需为线程安全(只读共享数据)
+     * @return 统计结果
+     */
+    static MonteCarloStats run(const MonteCarloConfig& config, const TrialFunction& trial);
+
+private:
+    // 每块试验次数，固定值保证结果与线程数无关
+    static constexpr std::size_t BLOCK_SIZE = 4096;
+};
+
+#endif // MONTE_CARLO_ENGINE_H
@@ -0,0 +1,60 @@
+/**
+ * @file ParallelFor.h
+ * @brief 简单的并行循环工具，把 [0, count) 按块分配给多个线程
+ */
+
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 解析线程数：0 表示使用全部硬件线程，且不超过任务数
+ */
+inline unsigned int resolveThreadCount(unsigned int requested, std::size_t taskCount) {
+    unsigned int threads = requested ? requested : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (taskCount < threads) threads = static_cast<unsigned int>(std::max<std::size_t>(taskCount, 1));
+    return threads;
+}
+
+/**
+ * @brief 并行执行 body(begin, end)，各线程动态领取固定大小的块
+ * @param count 任务总数
+ * @param threadCount 线程数，0 表示使用全部硬件线程
+ * @param grainSize 每块任务数
+ * @param body 处理 [begin, end) 的函数，需线程安全
+ */
+template <typename Body>
+void parallelFor(std::size_t count, unsigned int threadCount, std::size_t grainSize, const Body& body) {
+    if (count == 0) return;
+    if (grainSize == 0) grainSize = 1;
+    const std::size_t blockCount = (count + grainSize - 1) / grainSize;
+    const unsigned int threads = resolveThreadCount(threadCount, blockCount);
+
+    std::atomic<std::size_t> nextBlock(0);
+    auto worker = [&]() {
+        for (;;) {
+            const std::size_t b = nextBlock.fetch_add(1, std::memory_order_relaxed);
+            if (b >= blockCount) return;
+            const std::size_t begin = b * grainSize;
+            body(begin, std::min(begin + grainSize, count));
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned int t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : pool) {
+        th.join();
+    }
+}
+
+#endif // PARALLEL_FOR_H
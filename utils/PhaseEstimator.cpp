@@ -0,0 +1,236 @@
+#include "PhaseEstimator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// 相位缠绕到 (-π, π]
+double wrapPhase(double phase) {
+    phase = std::fmod(phase, 2.0 * PI);
+    if (phase > PI) phase -= 2.0 * PI;
+    if (phase <= -PI) phase += 2.0 * PI;
+    return phase;
+}
+
+// Goertzel递推内核：G 个等长相邻块、两路通道共用同一频点系数，在一次递推中推进。
+// 逐频点扫描数据块，每个频点的 2·G 条递推链在整个块内保留在寄存器中，G 为编译期常量以便展开和向量化。
+// 状态下标 [频点][通道][块]，块维步长为 S，块 g 的输入起点为 g·length
+template <std::size_t G, std::size_t S>
+void goertzelKernel(const double* __restrict x1, const double* __restrict x2, std::size_t length,
+                    std::size_t tones, const double* __restrict coeff,
+                    double* __restrict sa, double* __restrict sb) {
+    for (std::size_t k = 0; k < tones; ++k) {
+        const double c = coeff[k];
+        double a[2 * G] = {};
+        double b[2 * G] = {};
+        for (std::size_t n = 0; n < length; ++n) {
+            double in[2 * G];
+            for (std::size_t g = 0; g < G; ++g) {
+                in[g] = x1[g * length + n];
+                in[G + g] = x2[g * length + n];
+            }
+            for (std::size_t j = 0; j < 2 * G; ++j) {
+                const double next = in[j] + c * a[j] - b[j];
+                b[j] = a[j];
+                a[j] = next;
+            }
+        }
+        for (std::size_t ch = 0; ch < 2; ++ch) {
+            for (std::size_t g = 0; g < G; ++g) {
+                sa[k * 2 * S + ch * S + g] = a[ch * G + g];
+                sb[k * 2 * S + ch * S + g] = b[ch * G + g];
+            }
+        }
+    }
+}
+
+} // namespace
+
+MultiTonePhaseEstimator::MultiTonePhaseEstimator(const std::vector<double>& frequencies, double samplingRate)
+    : m_frequencies(frequencies), m_processed(0) {
+    const std::size_t tones = frequencies.size();
+    m_omega.resize(tones);
+    m_coeff.resize(tones);
+    for (std::size_t k = 0; k < tones; ++k) {
+        m_omega[k] = samplingRate > 0.0 ? 2.0 * PI * frequencies[k] / samplingRate : 0.0;
+        m_coeff[k] = 2.0 * std::cos(m_omega[k]);
+    }
+    m_sum1.resize(tones);
+    m_sum2.resize(tones);
+    m_stateA.resize(2 * GROUP * tones);
+    m_stateB.resize(2 * GROUP * tones);
+}
+
+std::vector<TonePhase> MultiTonePhaseEstimator::estimate(const std::vector<double>& signal1,
+                                                         const std::vector<double>& signal2) {
+    const std::size_t length = std::min(signal1.size(), signal2.size());
+    return estimate(signal1.data(), signal2.data(), length);
+}
+
+std::vector<TonePhase> MultiTonePhaseEstimator::estimate(const double* signal1, const double* signal2,
+                                                         std::size_t length) {
+    reset();
+    process(signal1, signal2, length);
+    return result();
+}
+
+void MultiTonePhaseEstimator::reset() {
+    std::fill(m_sum1.begin(), m_sum1.end(), std::complex<double>(0.0, 0.0));
+    std::fill(m_sum2.begin(), m_sum2.end(), std::complex<double>(0.0, 0.0));
+    m_processed = 0;
+}
+
+void MultiTonePhaseEstimator::process(const double* signal1, const double* signal2, std::size_t length) {
+    processChannels(signal1, signal2, length, std::complex<double>(1.0, 0.0));
+    m_processed += length;
+}
+
+// 复信号的DFT = DFT(I) + j·DFT(Q)，I、Q 分量各做一遍实数递推
+void MultiTonePhaseEstimator::process(const std::complex<float>* signal1, const std::complex<float>* signal2,
+                                      std::size_t length) {
+    m_real1.resize(length);
+    m_real2.resize(length);
+    m_imag1.resize(length);
+    m_imag2.resize(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        m_real1[i] = signal1[i].real();
+        m_imag1[i] = signal1[i].imag();
+        m_real2[i] = signal2[i].real();
+        m_imag2[i] = signal2[i].imag();
+    }
+    processChannels(m_real1.data(), m_real2.data(), length, std::complex<double>(1.0, 0.0));
+    processChannels(m_imag1.data(), m_imag2.data(), length, std::complex<double>(0.0, 1.0));
+    m_processed += length;
+}
+
+std::vector<TonePhase> MultiTonePhaseEstimator::result() const {
+    const std::size_t tones = m_frequencies.size();
+    std::vector<TonePhase> result(tones);
+    for (std::size_t k = 0; k < tones; ++k) {
+        result[k].frequency = m_frequencies[k];
+        result[k].spectrum1 = m_sum1[k];
+        result[k].spectrum2 = m_sum2[k];
+        result[k].phaseDiff = std::arg(m_sum1[k] * std::conj(m_sum2[k]));
+    }
+    return result;
+}
+
+// 整块按 GROUP 个一组并行递推，不足一组的整块和末尾残块单独处理
+void MultiTonePhaseEstimator::processChannels(const double* signal1, const double* signal2,
+                                              std::size_t length, std::complex<double> weight) {
+    const std::size_t fullBlocks = length / BLOCK;
+    std::size_t block = 0;
+    for (; block + GROUP <= fullBlocks; block += GROUP) {
+        runGroup(signal1, signal2, block * BLOCK, BLOCK, GROUP, weight);
+    }
+    if (block < fullBlocks) {
+        runGroup(signal1, signal2, block * BLOCK, BLOCK, fullBlocks - block, weight);
+    }
+    if (length % BLOCK != 0) {
+        runGroup(signal1, signal2, fullBlocks * BLOCK, length % BLOCK, 1, weight);
+    }
+}
+
+// 对 groupSize 个相邻、等长的数据块同时做Goertzel递推，结果旋转到全局时间原点后累加
+void MultiTonePhaseEstimator::runGroup(const double* signal1, const double* signal2,
+                                       std::size_t start, std::size_t blockLength, std::size_t groupSize,
+                                       std::complex<double> weight) {
+    const std::size_t tones = m_frequencies.size();
+    const double* coeff = m_coeff.data();
+    double* sa = m_stateA.data();
+    double* sb = m_stateB.data();
+
+    // s[n] = x[n] + 2cos(ω)·s[n-1] - s[n-2]；各块、各频点、两通道的递推相互独立
+    if (groupSize == GROUP) {
+        goertzelKernel<GROUP, GROUP>(signal1 + start, signal2 + start, blockLength, tones, coeff, sa, sb);
+    } else {
+        for (std::size_t g = 0; g < groupSize; ++g) {
+            const std::size_t offset = start + g * blockLength;
+            goertzelKernel<1, GROUP>(signal1 + offset, signal2 + offset, blockLength, tones, coeff, sa + g, sb + g);
+        }
+    }
+
+    // 块内 sum x[n]e^{-jωn} = e^{-jω(L-1)}·(s[L-1] - e^{-jω}·s[L-2])，
+    // 再乘 e^{-jω·块起点} 对齐到全局时间原点。长时间流式处理时样本序号很大，
+    // 相位先以 long double 计算并取模，避免 ω·n 的舍入误差随观测时长增长
+    for (std::size_t g = 0; g < groupSize; ++g) {
+        const std::uint64_t lastSample = m_processed + start + g * blockLength + blockLength - 1;
+        for (std::size_t k = 0; k < tones; ++k) {
+            const double omega = m_omega[k];
+            const std::complex<double> step = std::polar(1.0, -omega);
+            const long double phase = std::fmod(static_cast<long double>(omega) * static_cast<long double>(lastSample),
+                                                2.0L * static_cast<long double>(PI));
+            const std::complex<double> rotate = weight * std::polar(1.0, -static_cast<double>(phase));
+            const std::size_t lane1 = k * 2 * GROUP + g;
+            const std::size_t lane2 = lane1 + GROUP;
+            m_sum1[k] += rotate * (sa[lane1] - step * sb[lane1]);
+            m_sum2[k] += rotate * (sa[lane2] - step * sb[lane2]);
+        }
+    }
+}
+
+double MultiTonePhaseEstimator::resolveDelay(const std::vector<TonePhase>& tones) {
+    std::vector<TonePhase> sorted;
+    for (const TonePhase& tone : tones) {
+        if (tone.frequency > 0.0) sorted.push_back(tone);
+    }
+    if (sorted.empty()) return 0.0;
+    std::sort(sorted.begin(), sorted.end(),
+              [](const TonePhase& a, const TonePhase& b) { return a.frequency < b.frequency; });
+
+    if (sorted.size() == 1) {
+        return sorted[0].phaseDiff / (2.0 * PI * sorted[0].frequency);
+    }
+
+    // 粗估计：最小频差的相邻频点对，相位差之差对应的无模糊范围最大
+    std::size_t coarse = 0;
+    double minSpacing = sorted[1].frequency - sorted[0].frequency;
+    for (std::size_t i = 1; i + 1 < sorted.size(); ++i) {
+        const double spacing = sorted[i + 1].frequency - sorted[i].frequency;
+        if (spacing < minSpacing) {
+            minSpacing = spacing;
+            coarse = i;
+        }
+    }
+    if (minSpacing <= 0.0) {
+        return sorted[0].phaseDiff / (2.0 * PI * sorted[0].frequency);
+    }
+    double delay = wrapPhase(sorted[coarse + 1].phaseDiff - sorted[coarse].phaseDiff)
+                   / (2.0 * PI * minSpacing);
+
+    // 精化：用当前估计解缠绕每个频点的相位，最小二乘拟合过原点的直线 φ = ωτ
+    double sumWPhi = 0.0, sumWW = 0.0;
+    for (const TonePhase& tone : sorted) {
+        const double omega = 2.0 * PI * tone.frequency;
+        const double cycles = std::round((omega * delay - tone.phaseDiff) / (2.0 * PI));
+        const double unwrapped = tone.phaseDiff + 2.0 * PI * cycles;
+        sumWPhi += omega * unwrapped;
+        sumWW += omega * omega;
+        delay = sumWPhi / sumWW;
+    }
+    return delay;
+}
+
+double MultiTonePhaseEstimator::resolveGroupDelay(const std::vector<TonePhase>& tones, double coarseDelay) {
+    if (tones.size() < 2) return coarseDelay;
+
+    // 扣除粗时延对应的线性相位后，残差 ≈ φ0 + 2πf·δ，其中 φ0 为载波等引入的公共相位；
+    // 以第一个频点为参考缠绕各残差，再拟合带截距的直线求斜率 δ
+    const double reference = wrapPhase(tones[0].phaseDiff - 2.0 * PI * tones[0].frequency * coarseDelay);
+    double sumF = 0.0, sumR = 0.0, sumFF = 0.0, sumFR = 0.0;
+    for (const TonePhase& tone : tones) {
+        const double residual = wrapPhase(tone.phaseDiff - 2.0 * PI * tone.frequency * coarseDelay);
+        const double unwrapped = reference + wrapPhase(residual - reference);
+        sumF += tone.frequency;
+        sumR += unwrapped;
+        sumFF += tone.frequency * tone.frequency;
+        sumFR += tone.frequency * unwrapped;
+    }
+    const double count = static_cast<double>(tones.size());
+    const double denom = count * sumFF - sumF * sumF;
+    if (denom <= 0.0) return coarseDelay;
+    const double slope = (count * sumFR - sumF * sumR) / denom;
+    return coarseDelay + slope / (2.0 * PI);
+}
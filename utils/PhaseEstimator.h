@@ -0,0 +1,118 @@
+/**
+ * @file PhaseEstimator.h
+ * @brief 多频点双通道相位估计(分块Goertzel)，及基于多频点相位差的时延解模糊
+ */
+
+#ifndef PHASE_ESTIMATOR_H
+#define PHASE_ESTIMATOR_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 单个频点的估计结果
+ */
+struct TonePhase {
+    double frequency = 0.0;              // 频率(Hz)
+    std::complex<double> spectrum1;      // 通道1在该频点的DFT  sum x1[n]·e^{-jωn}
+    std::complex<double> spectrum2;      // 通道2在该频点的DFT
+    double phaseDiff = 0.0;              // arg(X1·conj(X2))，范围(-π, π]；通道2滞后τ时为 2πfτ
+};
+
+/**
+ * @brief 多频点相位估计器
+ *
+ * 以二阶Goertzel递推代替逐点 cos/sin：每个采样点每个频点每个通道只需
+ * 一次乘法和两次加减。两路通道和若干相邻数据块共用同一频点系数，
+ * 逐频点在一次递推中并行推进，状态保留在寄存器中，编译器可将其映射为SIMD指令。
+ * 信号按固定长度分块递推后再按块起点旋转相位累加，限制长序列上的舍入误差增长。
+ * 单个估计器不可在多个线程间共享。
+ */
+class MultiTonePhaseEstimator {
+public:
+    /**
+     * @param frequencies 待估计的频点(Hz)
+     * @param samplingRate 采样率(Hz)
+     */
+    MultiTonePhaseEstimator(const std::vector<double>& frequencies, double samplingRate);
+
+    /**
+     * @brief 估计两路信号在各频点的频谱和相位差
+     * @param length 参与计算的样本数(两路取相同长度)
+     * @return 与构造时频点顺序一致的结果
+     */
+    std::vector<TonePhase> estimate(const double* signal1, const double* signal2, std::size_t length);
+
+    std::vector<TonePhase> estimate(const std::vector<double>& signal1, const std::vector<double>& signal2);
+
+    /**
+     * @brief 流式处理：清空累加结果，从样本序号0重新开始
+     */
+    void reset();
+
+    /**
+     * @brief 流式处理：追加一段实数样本，相位以 reset() 后的首个样本为时间原点
+     */
+    void process(const double* signal1, const double* signal2, std::size_t length);
+
+    /**
+     * @brief 流式处理：追加一段复基带(IQ)样本，频点可为负
+     */
+    void process(const std::complex<float>* signal1, const std::complex<float>* signal2, std::size_t length);
+
+    /**
+     * @brief 流式处理：当前累加的各频点结果
+     */
+    std::vector<TonePhase> result() const;
+
+    /**
+     * @brief 已处理的样本数
+     */
+    std::uint64_t processedSamples() const { return m_processed; }
+
+    /**
+     * @brief 由多频点相位差解算通道2相对通道1的时延(秒)
+     *
+     * 单频点时直接取 φ/(2πf)，无模糊范围为 ±1/(2f)。
+     * 多频点时先由最小频差的一对频点得到粗估计(无模糊范围 ±1/(2Δf))，
+     * 再按频率从低到高逐个解缠绕相位，以最小二乘 τ = Σωφ/Σω² 逐步精化。
+     */
+    static double resolveDelay(const std::vector<TonePhase>& tones);
+
+    /**
+     * @brief 由相位差随频率的斜率(群时延)精化粗时延
+     *
+     * 适用于复基带信号：各频点相位差含有载波引入的公共相位，只有斜率与时延有关。
+     * 粗时延误差需小于 1/(2Δf)，Δf 为相邻频点间隔。
+     * @param coarseDelay 粗时延(秒)，如GCC的估计结果
+     * @return 通道2相对通道1的时延(秒)
+     */
+    static double resolveGroupDelay(const std::vector<TonePhase>& tones, double coarseDelay);
+
+private:
+    // 同时推进的数据块数，为每个频点提供互不相关的递推链
+    static const std::size_t GROUP = 4;
+    // 单次递推的最大长度
+    static const std::size_t BLOCK = 4096;
+
+    void processChannels(const double* signal1, const double* signal2,
+                         std::size_t length, std::complex<double> weight);
+    void runGroup(const double* signal1, const double* signal2,
+                  std::size_t start, std::size_t blockLength, std::size_t groupSize,
+                  std::complex<double> weight);
+
+    std::vector<double> m_frequencies;
+    std::vector<double> m_omega;         // 归一化角频率 2πf/fs
+    std::vector<double> m_coeff;         // 2cos(ω)
+    std::vector<std::complex<double>> m_sum1;
+    std::vector<std::complex<double>> m_sum2;
+    // 各块递推结束时的 s[L-1]、s[L-2]，下标 [频点][通道][块]
+    std::vector<double> m_stateA, m_stateB;
+    // IQ 输入拆分出的实部、虚部
+    std::vector<double> m_real1, m_real2, m_imag1, m_imag2;
+    std::uint64_t m_processed;           // reset() 以来已处理的样本数
+};
+
+#endif // PHASE_ESTIMATOR_H
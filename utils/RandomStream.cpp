@@ -0,0 +1,67 @@
+#include "RandomStream.h"
+#include "Log.h"
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+// 当前线程所在的任务编号
+thread_local std::uint64_t t_currentJob = 0;
+
+// 系统时间派生的种子，保证非0
+std::uint64_t timeSeed() {
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    const std::uint64_t seed = RandomStream::mix(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+    return seed ? seed : 1;
+}
+
+} // namespace
+
+double RandomStream::normal() {
+    // 1-u 落在 (0, 1]，避免 log(0)
+    const double u1 = 1.0 - uniform();
+    const double u2 = uniform();
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+}
+
+RandomService& RandomService::getInstance() {
+    static RandomService instance;
+    return instance;
+}
+
+RandomService::RandomService() : m_seed(timeSeed()) {
+    PL_LOG_INFO("随机数主种子: %llu\n", static_cast<unsigned long long>(seed()));
+}
+
+void RandomService::setSeed(std::uint64_t seed) {
+    if (seed == 0) {
+        seed = timeSeed();
+    }
+    m_seed.store(seed, std::memory_order_relaxed);
+    PL_LOG_INFO("随机数主种子: %llu\n", static_cast<unsigned long long>(seed));
+}
+
+RandomStream RandomService::stream(std::uint64_t job, RandomPurpose purpose,
+                                   std::uint64_t trial, std::uint64_t station) const {
+    return streamFromSeed(RandomStream::deriveKey(seed(), job), purpose, trial, station);
+}
+
+RandomStream RandomService::streamFromSeed(std::uint64_t seed, RandomPurpose purpose,
+                                           std::uint64_t trial, std::uint64_t station) {
+    std::uint64_t key = RandomStream::deriveKey(seed, static_cast<std::uint64_t>(purpose));
+    key = RandomStream::deriveKey(key, trial);
+    return RandomStream(RandomStream::deriveKey(key, station));
+}
+
+std::uint64_t RandomService::currentJob() {
+    return t_currentJob;
+}
+
+RandomService::JobScope::JobScope(std::uint64_t job) : m_previous(t_currentJob) {
+    t_currentJob = job;
+}
+
+RandomService::JobScope::~JobScope() {
+    t_currentJob = m_previous;
+}
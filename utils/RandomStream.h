@@ -0,0 +1,156 @@
+/**
+ * @file RandomStream.h
+ * @brief 计数器型随机数服务：按(主种子, 任务, 用途, 试验, 侦察站)派生互不相关的随机流
+ *
+ * 第 n 个输出是 SplitMix64 混合函数作用于 (流密钥 + n·γ) 的结果，只取决于流密钥和计数器，
+ * 与调用线程、调度顺序无关。各模型按自己的 (用途, 试验序号, 侦察站序号) 取流，
+ * 并行仿真不需要加锁，对给定主种子逐位可复现。
+ */
+
+#ifndef RANDOM_STREAM_H
+#define RANDOM_STREAM_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief 随机流的用途，不同用途的流互不相关
+ */
+enum class RandomPurpose : std::uint64_t {
+    MonteCarlo = 1,       // 误差圆蒙特卡洛试验
+    BearingError,         // 测向误差
+    TimeDifferenceError,  // 时差测量误差
+    FrequencyNoise,       // 频差(多普勒)测量噪声
+    InitialGuess,         // 迭代初值扰动
+    SignalNoise           // IQ信号与热噪声
+};
+
+/**
+ * @brief 计数器型随机流，满足 UniformRandomBitGenerator，可直接用于 <random> 中的分布
+ *
+ * 对象只有两个64位整数，按值传递和复制都很廉价；同一流复制后各自独立前进。
+ */
+class RandomStream {
+public:
+    using result_type = std::uint64_t;
+
+    explicit RandomStream(std::uint64_t key = 0, std::uint64_t counter = 0)
+        : m_key(key), m_counter(counter) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~static_cast<result_type>(0); }
+
+    result_type operator()() { return mix(m_key + (++m_counter) * GAMMA); }
+
+    /**
+     * @brief [0, 1) 均匀分布(53位精度)
+     */
+    double uniform() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+    /**
+     * @brief 标准正态分布(Box-Muller，每次消耗两个输出，不缓存，结果与标准库实现无关)
+     */
+    double normal();
+
+    /**
+     * @brief 正态分布 N(mean, sigma²)，sigma<=0 时返回 mean 且不消耗输出
+     */
+    double normal(double mean, double sigma) { return sigma > 0.0 ? mean + sigma * normal() : mean; }
+
+    /**
+     * @brief 由当前流派生第 index 个子流
+     */
+    RandomStream substream(std::uint64_t index) const { return RandomStream(deriveKey(m_key, index)); }
+
+    std::uint64_t key() const { return m_key; }
+    std::uint64_t counter() const { return m_counter; }
+
+    /**
+     * @brief SplitMix64 混合函数
+     */
+    static std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief 由(密钥, 序号)派生互不相关的密钥
+     */
+    static std::uint64_t deriveKey(std::uint64_t key, std::uint64_t index) {
+        return mix(key + (index + 1) * GAMMA);
+    }
+
+private:
+    static constexpr std::uint64_t GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    std::uint64_t m_key;
+    std::uint64_t m_counter;
+};
+
+/**
+ * @brief 随机数服务(单例)：保存主种子，按任务派生随机流
+ *
+ * 任务编号默认取当前线程所在的后台任务(JobExecutor 执行任务时设置)，
+ * 未在任务中运行时为0。在并行循环中取流时应先在调用线程取出任务编号，
+ * 再用显式任务编号的重载，以免工作线程取到错误的任务编号。
+ */
+class RandomService {
+public:
+    static RandomService& getInstance();
+
+    /**
+     * @brief 设置主种子，0 表示使用系统当前时间(启动时默认)
+     */
+    void setSeed(std::uint64_t seed);
+    std::uint64_t seed() const { return m_seed.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 取当前任务的随机流
+     * @param purpose 用途
+     * @param trial 试验(或观测时刻、候选位置)序号
+     * @param station 侦察站序号
+     */
+    RandomStream stream(RandomPurpose purpose, std::uint64_t trial = 0, std::uint64_t station = 0) const {
+        return stream(currentJob(), purpose, trial, station);
+    }
+
+    /**
+     * @brief 取指定任务的随机流
+     */
+    RandomStream stream(std::uint64_t job, RandomPurpose purpose,
+                        std::uint64_t trial = 0, std::uint64_t station = 0) const;
+
+    /**
+     * @brief 由显式种子派生随机流，不依赖主种子(用于调用方自带种子的计算)
+     */
+    static RandomStream streamFromSeed(std::uint64_t seed, RandomPurpose purpose,
+                                       std::uint64_t trial = 0, std::uint64_t station = 0);
+
+    /**
+     * @brief 当前线程所在的任务编号
+     */
+    static std::uint64_t currentJob();
+
+    /**
+     * @brief 在作用域内把当前线程的任务编号设为 job，析构时恢复
+     */
+    class JobScope {
+    public:
+        explicit JobScope(std::uint64_t job);
+        ~JobScope();
+        JobScope(const JobScope&) = delete;
+        JobScope& operator=(const JobScope&) = delete;
+    private:
+        std::uint64_t m_previous;
+    };
+
+private:
+    RandomService();
+    RandomService(const RandomService&) = delete;
+    RandomService& operator=(const RandomService&) = delete;
+
+    std::atomic<std::uint64_t> m_seed;
+};
+
+#endif // RANDOM_STREAM_H
@@ -0,0 +1,127 @@
+/**
+ * @file RingBuffer.h
+ * @brief 有界环形缓冲区：固定数量的预分配槽位在生产者和消费者之间循环使用
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief 单生产者单消费者的有界块缓冲区
+ *
+ * 槽位在构造时一次性分配，之后只在生产者和消费者之间交接所有权，
+ * 不随数据总量增长。缓冲区满时生产者阻塞，空时消费者阻塞(背压)。
+ *
+ * 生产者: acquireWrite() -> 填充 -> commitWrite()，结束时 close()
+ * 消费者: acquireRead() -> 处理 -> releaseRead()，返回 nullptr 表示数据已取完
+ */
+template <typename T>
+class BlockRingBuffer {
+public:
+    explicit BlockRingBuffer(std::size_t capacity)
+        : m_slots(capacity > 0 ? capacity : 1), m_head(0), m_tail(0), m_count(0),
+          m_closed(false), m_producerWaits(0), m_consumerWaits(0) {}
+
+    BlockRingBuffer(const BlockRingBuffer&) = delete;
+    BlockRingBuffer& operator=(const BlockRingBuffer&) = delete;
+
+    std::size_t capacity() const { return m_slots.size(); }
+
+    /**
+     * @brief 逐个访问槽位(在启动生产者之前预分配槽位内存)
+     */
+    T& slot(std::size_t index) { return m_slots[index]; }
+
+    /**
+     * @brief 等待一个空闲槽位
+     * @return 已关闭时返回 nullptr
+     */
+    T* acquireWrite() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_count == m_slots.size() && !m_closed) ++m_producerWaits;
+        m_notFull.wait(lock, [this]() { return m_count < m_slots.size() || m_closed; });
+        if (m_closed) return nullptr;
+        return &m_slots[m_tail];
+    }
+
+    /**
+     * @brief 提交 acquireWrite() 取得的槽位
+     */
+    void commitWrite() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tail = (m_tail + 1) % m_slots.size();
+            ++m_count;
+        }
+        m_notEmpty.notify_one();
+    }
+
+    /**
+     * @brief 等待一个已填充的槽位
+     * @return 已关闭且数据取完时返回 nullptr
+     */
+    T* acquireRead() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_count == 0 && !m_closed) ++m_consumerWaits;
+        m_notEmpty.wait(lock, [this]() { return m_count > 0 || m_closed; });
+        if (m_count == 0) return nullptr;
+        return &m_slots[m_head];
+    }
+
+    /**
+     * @brief 归还 acquireRead() 取得的槽位
+     */
+    void releaseRead() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_head = (m_head + 1) % m_slots.size();
+            --m_count;
+        }
+        m_notFull.notify_one();
+    }
+
+    /**
+     * @brief 关闭缓冲区：生产者不再写入，消费者取完剩余数据后结束
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+    // 因缓冲区满而等待的次数(消费者是瓶颈)
+    std::size_t producerWaits() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_producerWaits;
+    }
+
+    // 因缓冲区空而等待的次数(生产者是瓶颈)
+    std::size_t consumerWaits() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_consumerWaits;
+    }
+
+private:
+    std::vector<T> m_slots;
+    std::size_t m_head;   // 下一个待读槽位
+    std::size_t m_tail;   // 下一个待写槽位
+    std::size_t m_count;  // 已填充槽位数
+    bool m_closed;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+
+    std::size_t m_producerWaits;
+    std::size_t m_consumerWaits;
+};
+
+#endif // RING_BUFFER_H
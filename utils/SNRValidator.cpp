@@ -85,8 +85,8 @@ double calculateMaxDetectionRange(double pt, double fc, double N0_dBm, double B_
  */
 bool validateSNR(const std::vector<int>& deviceIds, int sourceId, std::string& failMessage) {
     // 获取辐射源信息
-    RadiationSourceDAO& radiationSourceDAO = RadiationSourceDAO::getInstance();
-    RadiationSource source = radiationSourceDAO.getRadiationSourceById(sourceId);
+    ModelRepository& repository = ModelRepository::getInstance();
+    RadiationSource source = repository.getRadiationSourceById(sourceId);
     
     // 获取辐射源的位置、发射功率和载波频率
     double sourceLongitude = source.getLongitude();
@@ -95,19 +95,19 @@ bool validateSNR(const std::vector<int>& deviceIds, int sourceId, std::string& f
     double sourcePower = source.getTransmitPower();   
     double sourceFrequency = source.getCarrierFrequency(); 
     
-    // 获取侦察设备DAO实例
-    ReconnaissanceDeviceDAO& deviceDAO = ReconnaissanceDeviceDAO::getInstance();
-    
     // 计算所有侦察设备的频率范围交集
     double intersectFreqMin = -std::numeric_limits<double>::infinity();
     double intersectFreqMax = std::numeric_limits<double>::infinity();
     
-    // 遍历所有侦察设备，计算侦收频率范围交集
+    // 获取设备信息(两轮遍历共用)
+    std::vector<ReconnaissanceDevice> devices;
+    devices.reserve(deviceIds.size());
     for (int deviceId : deviceIds) {
-        // 获取设备信息
-        ReconnaissanceDevice device = deviceDAO.getReconnaissanceDeviceById(deviceId);
-        
-        
+        devices.push_back(repository.getReconnaissanceDeviceById(deviceId));
+    }
+    
+    // 遍历所有侦察设备，计算侦收频率范围交集
+    for (const ReconnaissanceDevice& device : devices) {
         // 更新频率范围交集
         intersectFreqMin = std::max(intersectFreqMin, static_cast<double>(device.getFreqRangeMin()));
         intersectFreqMax = std::min(intersectFreqMax, static_cast<double>(device.getFreqRangeMax()));
@@ -125,10 +125,7 @@ bool validateSNR(const std::vector<int>& deviceIds, int sourceId, std::string& f
     double commonBandwidth = intersectFreqMax - intersectFreqMin;
     
     // 遍历所有侦察设备
-    for (int deviceId : deviceIds) {
-        // 获取设备信息
-        ReconnaissanceDevice device = deviceDAO.getReconnaissanceDeviceById(deviceId);
-        
+    for (const ReconnaissanceDevice& device : devices) {
         // 获取设备的位置，噪声功率谱密度
         double deviceLongitude = device.getLongitude();
         double deviceLatitude = device.getLatitude();
@@ -10,8 +10,7 @@
 #include <string>
 #include <cmath>
 #include "../constants/PhysicsConstants.h"
-#include "../models/RadiationSourceDAO.h"
-#include "../models/ReconnaissanceDeviceDAO.h"
+#include "../models/ModelRepository.h"
 
 /**
  * @brief 计算辐射源到侦察站的信噪比(SNR)
@@ -0,0 +1,133 @@
+#include "SignalPipeline.h"
+#include "FFT.h"
+#include "PhaseEstimator.h"
+#include "RingBuffer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+SignalPipelineResult SignalPipeline::run(const SignalPipelineConfig& config) {
+    SignalPipelineResult result;
+    const double sampleRate = config.signal.sampleRate;
+    if (sampleRate <= 0.0 || config.observationSamples == 0 || config.blockSize == 0) {
+        return result;
+    }
+
+    // 帧长至少为最大时延的4倍，使时延落在帧内重叠较多的区域
+    const double maxDelay = config.maxDelay > 0.0 ? config.maxDelay : std::fabs(config.signal.delay);
+    const double delaySamples = std::ceil(maxDelay * sampleRate);
+    std::size_t frameLength = std::max<std::size_t>(config.minFrameLength, 2);
+    frameLength = std::max(frameLength, FFTPlan::nextPowerOfTwo(static_cast<std::size_t>(4.0 * delaySamples) + 1));
+    if (frameLength > config.maxFrameLength) {
+        std::cerr << "信号管线: 最大时延 " << maxDelay << " s 需要帧长 " << frameLength
+                  << "，超过上限 " << config.maxFrameLength << std::endl;
+        return result;
+    }
+
+    const double bandwidth = config.signal.bandwidth > 0.0 ? config.signal.bandwidth : sampleRate / 4.0;
+
+    GccOptions gccOptions;
+    gccOptions.weighting = config.weighting;
+    gccOptions.maxLag = std::min(frameLength / 2, static_cast<std::size_t>(delaySamples) + 16);
+    gccOptions.passband = bandwidth / sampleRate;
+    GccStreamEstimator gcc(frameLength, gccOptions);
+
+    // 相位斜率法频点均布于带宽中部80%
+    const std::size_t toneCount = std::max<std::size_t>(config.toneCount, 2);
+    std::vector<double> tones(toneCount);
+    for (std::size_t k = 0; k < toneCount; ++k) {
+        tones[k] = 0.8 * bandwidth * (static_cast<double>(k) / static_cast<double>(toneCount - 1) - 0.5);
+    }
+    MultiTonePhaseEstimator phase(tones, sampleRate);
+
+    // 相位估计按GCC帧长分段，各段互谱 X1·conj(X2) 累加后取相位(Welch平均)，
+    // 公共的段起点相位在互谱中抵消
+    std::vector<std::complex<double>> toneCross(toneCount, std::complex<double>(0.0, 0.0));
+    std::size_t segmentFill = 0;
+    auto finishSegment = [&]() {
+        const std::vector<TonePhase> segment = phase.result();
+        for (std::size_t k = 0; k < toneCount; ++k) {
+            toneCross[k] += segment[k].spectrum1 * std::conj(segment[k].spectrum2);
+        }
+        phase.reset();
+        segmentFill = 0;
+    };
+    auto feedPhase = [&](const std::complex<float>* signal1, const std::complex<float>* signal2, std::size_t count) {
+        while (count > 0) {
+            const std::size_t take = std::min(count, frameLength - segmentFill);
+            phase.process(signal1, signal2, take);
+            signal1 += take;
+            signal2 += take;
+            count -= take;
+            segmentFill += take;
+            if (segmentFill == frameLength) finishSegment();
+        }
+    };
+
+    IQSignalGenerator generator(config.signal);
+    BlockRingBuffer<IQBlock> ring(config.ringCapacity);
+    for (std::size_t i = 0; i < ring.capacity(); ++i) {
+        ring.slot(i).reserve(config.blockSize);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // 生成线程
+    std::thread producer([&]() {
+        std::uint64_t remaining = config.observationSamples;
+        while (remaining > 0) {
+            IQBlock* block = ring.acquireWrite();
+            if (!block) return;  // 消费端已结束
+            const std::size_t count = static_cast<std::size_t>(
+                std::min<std::uint64_t>(remaining, config.blockSize));
+            generator.generate(*block, count);
+            ring.commitWrite();
+            remaining -= count;
+        }
+        ring.close();
+    });
+
+    // 估计(调用线程)
+    while (IQBlock* block = ring.acquireRead()) {
+        if (config.cancelFlag && config.cancelFlag->load(std::memory_order_relaxed)) {
+            result.cancelled = true;
+            ring.releaseRead();
+            ring.close();
+            break;
+        }
+        gcc.push(block->channel1.data(), block->channel2.data(), block->count);
+        feedPhase(block->channel1.data(), block->channel2.data(), block->count);
+        result.samples += block->count;
+        ring.releaseRead();
+    }
+    producer.join();
+
+    GccResult gccResult = gcc.result(sampleRate);
+    result.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.throughputMsps = result.elapsedSeconds > 0.0
+        ? static_cast<double>(result.samples) / result.elapsedSeconds / 1e6 : 0.0;
+
+    // GCC时延为通道1相对通道2的滞后量，取反得到通道2相对通道1的时延
+    result.gccDelay = -gccResult.delaySeconds;
+    result.gccPeak = gccResult.peakValue;
+    if (segmentFill > 0) finishSegment();
+    std::vector<TonePhase> averaged(toneCount);
+    for (std::size_t k = 0; k < toneCount; ++k) {
+        averaged[k].frequency = tones[k];
+        averaged[k].phaseDiff = std::arg(toneCross[k]);
+    }
+    result.phaseDelay = MultiTonePhaseEstimator::resolveGroupDelay(averaged, result.gccDelay);
+    result.valid = gccResult.valid && !result.cancelled;
+
+    result.frameLength = frameLength;
+    result.memoryBytes = ring.capacity() * config.blockSize * 2 * sizeof(std::complex<float>)
+                       + generator.memoryBytes() + gcc.memoryBytes()
+                       + 4 * std::min(config.blockSize, frameLength) * sizeof(double);  // Goertzel的IQ拆分缓冲
+    result.producerWaits = ring.producerWaits();
+    result.consumerWaits = ring.consumerWaits();
+    return result;
+}
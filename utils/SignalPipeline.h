@@ -0,0 +1,63 @@
+/**
+ * @file SignalPipeline.h
+ * @brief 流式接收处理管线：IQ生成线程 -> 有界环形缓冲区 -> 时延估计
+ */
+
+#ifndef SIGNAL_PIPELINE_H
+#define SIGNAL_PIPELINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "CrossCorrelation.h"
+#include "IQSignalGenerator.h"
+
+/**
+ * @brief 管线参数
+ */
+struct SignalPipelineConfig {
+    IQSignalConfig signal;                  // 信号生成参数(含真实时延)
+    std::uint64_t observationSamples = 1 << 22;  // 观测样本数
+    std::size_t blockSize = 1 << 16;        // 每块样本数
+    std::size_t ringCapacity = 4;           // 环形缓冲区块数
+    double maxDelay = 0.0;                  // 预期最大时延(秒)，决定GCC帧长；0 表示按 |signal.delay| 取
+    std::size_t minFrameLength = 4096;      // GCC最小帧长
+    std::size_t maxFrameLength = 1 << 20;   // GCC最大帧长，所需帧长超出时不做估计
+    GccWeighting weighting = GccWeighting::PHAT;
+    std::size_t toneCount = 16;             // 相位斜率法使用的频点数(均布于信号带宽内)
+    const std::atomic<bool>* cancelFlag = nullptr;  // 非空且置位时提前结束
+};
+
+/**
+ * @brief 管线运行结果
+ *
+ * 时延均为通道2相对通道1的时延(秒)，与 IQSignalConfig::delay 同号。
+ */
+struct SignalPipelineResult {
+    bool valid = false;
+    bool cancelled = false;
+    std::uint64_t samples = 0;              // 实际处理的样本数(每通道)
+    double elapsedSeconds = 0.0;
+    double throughputMsps = 0.0;            // 吞吐量(百万样本/秒，每通道)
+    double gccDelay = 0.0;                  // 帧平均GCC估计
+    double gccPeak = 0.0;
+    double phaseDelay = 0.0;                // 以GCC为粗值的相位斜率(群时延)估计
+    std::size_t frameLength = 0;            // GCC帧长
+    std::size_t memoryBytes = 0;            // 缓冲区、生成器和估计器工作区总内存
+    std::size_t producerWaits = 0;          // 生成线程因缓冲区满而等待的次数
+    std::size_t consumerWaits = 0;          // 估计线程因缓冲区空而等待的次数
+};
+
+/**
+ * @brief 流式接收处理管线
+ *
+ * 生成线程按块产生双通道IQ数据写入有界环形缓冲区，调用线程取出后依次送入
+ * 帧平均GCC(粗时延)和多频点Goertzel(相位斜率精化)。缓冲区满时生成线程阻塞，
+ * 总内存由块大小、缓冲区块数和GCC帧长决定，与观测样本数无关。
+ */
+class SignalPipeline {
+public:
+    static SignalPipelineResult run(const SignalPipelineConfig& config);
+};
+
+#endif // SIGNAL_PIPELINE_H
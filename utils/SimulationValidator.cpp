@@ -8,8 +8,7 @@
 #include "CoordinateTransform.h"
 #include "AngleValidator.h"
 #include "../constants/PhysicsConstants.h"
-#include "../models/RadiationSourceDAO.h"
-#include "../models/ReconnaissanceDeviceDAO.h"
+#include "../models/ModelRepository.h"
 #include <sstream>
 #include <iomanip>
 #include <limits>
@@ -23,11 +22,10 @@ SimulationValidator::~SimulationValidator() {
 //所有验证
 bool SimulationValidator::validateAll(const std::vector<int>& deviceIds, int sourceId, std::string& failMessage) {
     // 一次性获取所有需要的数据
-    RadiationSourceDAO& radiationSourceDAO = RadiationSourceDAO::getInstance();
-    ReconnaissanceDeviceDAO& deviceDAO = ReconnaissanceDeviceDAO::getInstance();
+    ModelRepository& repository = ModelRepository::getInstance();
     
     // 获取辐射源信息
-    RadiationSource source = radiationSourceDAO.getRadiationSourceById(sourceId);
+    RadiationSource source = repository.getRadiationSourceById(sourceId);
     
     // 获取辐射源的各项参数
     double sourceFrequency = source.getCarrierFrequency();  // 载波频率(GHz)
@@ -50,7 +48,7 @@ bool SimulationValidator::validateAll(const std::vector<int>& deviceIds, int sou
     // 遍历所有侦察设备，计算侦收频率范围交集
     for (int deviceId : deviceIds) {
         // 获取设备信息
-        ReconnaissanceDevice device = deviceDAO.getReconnaissanceDeviceById(deviceId);
+        ReconnaissanceDevice device = repository.getReconnaissanceDeviceById(deviceId);
         
         // 更新频率范围交集
         intersectFreqMin = std::max(intersectFreqMin, static_cast<double>(device.getFreqRangeMin()));
@@ -71,7 +69,7 @@ bool SimulationValidator::validateAll(const std::vector<int>& deviceIds, int sou
     // 遍历所有侦察设备
     for (int deviceId : deviceIds) {
         // 获取设备信息
-        ReconnaissanceDevice device = deviceDAO.getReconnaissanceDeviceById(deviceId);
+        ReconnaissanceDevice device = repository.getReconnaissanceDeviceById(deviceId);
         
         // 获取设备的各项参数
         double minFreq = device.getFreqRangeMin();           // 侦收频率范围下限
@@ -172,4 +170,49 @@ bool SimulationValidator::validateAll(const std::vector<int>& deviceIds, int sou
     
     // 所有验证都通过，返回true
     return true;
-}
\ No newline at end of file
+}
+
+//整个仿真时段的验证
+bool SimulationValidator::validateTimeline(const std::vector<int>& deviceIds, int sourceId, double simulationTime,
+                                           VisibilityTimeline& timeline, std::string& failMessage,
+                                           const VisibilityTimelineOptions& options) {
+    ModelRepository& repository = ModelRepository::getInstance();
+    RadiationSource source = repository.getRadiationSourceById(sourceId);
+    std::vector<ReconnaissanceDevice> devices;
+    for (int deviceId : deviceIds) {
+        devices.push_back(repository.getReconnaissanceDeviceById(deviceId));
+    }
+
+    timeline = computeVisibilityTimeline(devices, source, simulationTime, options);
+
+    // 每个设备至少要有一段可接收时段
+    for (size_t i = 0; i < devices.size(); ++i) {
+        const DeviceTimeline& deviceTimeline = timeline.devices[i];
+        if (!deviceTimeline.intervals.empty()) {
+            continue;
+        }
+        std::stringstream ss;
+        if (!deviceTimeline.inBand) {
+            ss << "频率验证失败：侦察设备 " << devices[i].getDeviceName()
+               << "的接收频率范围为 " << devices[i].getFreqRangeMin() << "~" << devices[i].getFreqRangeMax() << " GHz，"
+               << "无法接收辐射源 " << source.getRadiationName()
+               << "的频率 " << source.getCarrierFrequency() << " GHz";
+        } else {
+            ss << "时间线验证失败：仿真时间 " << simulationTime << " 秒内，侦察设备 " << devices[i].getDeviceName()
+               << "在任何时刻都不能接收辐射源 " << source.getRadiationName() << "的信号(角度或信噪比不满足)";
+        }
+        failMessage = ss.str();
+        return false;
+    }
+
+    // 需要所有设备同时可接收的时刻
+    if (timeline.commonIntervals.empty()) {
+        std::stringstream ss;
+        ss << "时间线验证失败：仿真时间 " << simulationTime << " 秒内，不存在所有侦察设备都能接收辐射源 "
+           << source.getRadiationName() << "信号的时刻";
+        failMessage = ss.str();
+        return false;
+    }
+
+    return true;
+}
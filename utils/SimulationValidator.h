@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include "VisibilityTimeline.h"
 
 /**
  * @brief 仿真前条件验证类
@@ -29,6 +30,22 @@ public:
      * @return bool 验证结果，成功返回true，失败返回false
      */
     bool validateAll(const std::vector<int>& deviceIds, int sourceId, std::string& failMessage);
+
+    /**
+     * @brief 在整个仿真时段内验证
+     * 设备和辐射源按运动参数移动，按 options.step 扫描可接收时段；
+     * 每个设备至少有一段可接收时段、且存在全部设备都能接收的时刻时通过
+     * @param deviceIds 侦察设备ID列表
+     * @param sourceId 辐射源ID
+     * @param simulationTime 仿真时间（秒）
+     * @param timeline 可见性时间线输出参数
+     * @param failMessage 失败信息输出参数
+     * @param options 扫描参数
+     * @return bool 验证结果，成功返回true，失败返回false
+     */
+    bool validateTimeline(const std::vector<int>& deviceIds, int sourceId, double simulationTime,
+                          VisibilityTimeline& timeline, std::string& failMessage,
+                          const VisibilityTimelineOptions& options = VisibilityTimelineOptions());
 };
 
 #endif // SIMULATION_VALIDATOR_H 
\ No newline at end of file
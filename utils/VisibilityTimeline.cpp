@@ -0,0 +1,282 @@
+/**
+ * @file VisibilityTimeline.cpp
+ * @brief 可见性与信噪比时间线的实现
+ */
+
+#include "VisibilityTimeline.h"
+#include "AngleValidator.h"
+#include "CoordinateTransform.h"
+#include "Instrumentation.h"
+#include "SNRValidator.h"
+#include "../constants/PhysicsConstants.h"
+#include "../models/Trajectory.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+
+// 余量换算出的时长打折使用，避免边界处的舍入误差
+const double MARGIN_SAFETY = 0.999;
+
+// 两个方向角(度)在圆周上的角距离
+double circularDistance(double a, double b) {
+    const double d = std::fmod(std::fabs(a - b), 360.0);
+    return std::min(d, 360.0 - d);
+}
+
+/**
+ * 方位角(度，[0,360))到扇区边界的最小角距离，扇区规则与 isAngleInRange 相同；
+ * 判定结果在方位角改变该角距离之前不会变化(扇区内外均适用)。
+ * 不跨越的扇区在 0°/360° 处也有边界(除非覆盖整圈)；无法给出余量的扇区返回0，即不跳过。
+ */
+double azimuthMargin(double azimuth, double minAngle, double maxAngle) {
+    if (minAngle > maxAngle) {
+        if (maxAngle < 0.0 || minAngle > 360.0) return 0.0;
+        return std::min(circularDistance(azimuth, minAngle), circularDistance(azimuth, maxAngle));
+    }
+    if (minAngle <= 0.0 && maxAngle >= 360.0) return INF;
+    return std::min(circularDistance(azimuth, std::min(std::max(minAngle, 0.0), 360.0)),
+                    circularDistance(azimuth, std::min(std::max(maxAngle, 0.0), 360.0)));
+}
+
+// 俯仰角(度，[-90,90])到扇区边界的最小角距离
+double elevationMargin(double elevation, double minAngle, double maxAngle) {
+    if (minAngle <= maxAngle && minAngle <= -90.0 && maxAngle >= 90.0) return INF;
+    return std::min(std::fabs(elevation - minAngle), std::fabs(elevation - maxAngle));
+}
+
+/**
+ * 指向角改变 θ 至少需要 |r|·sin θ 的相对位移(θ ≤ 90°)，由此得到角度余量对应的时长。
+ * 方位角用水平分量的距离和速度，俯仰角用三维距离和速度。
+ */
+double angleTime(double marginDeg, double range, double speed) {
+    if (marginDeg == INF || speed <= 0.0) return INF;
+    return range * std::sin(std::min(marginDeg, 90.0) * Constants::DEG2RAD) / speed;
+}
+
+// 扇区(度)
+struct Sector {
+    double azimuthMin, azimuthMax, elevationMin, elevationMax;
+};
+
+// 单个侦察设备在时间线上与时刻无关的参数
+struct DeviceParams {
+    Sector sector;
+    double noisePsd;
+    double maxRange;
+};
+
+// 辐射源参数
+struct SourceParams {
+    Sector sector;
+    double power;
+    double frequency;
+};
+
+// 单项判定及其结果保证不变的时长(秒)
+struct Condition {
+    bool ok;
+    double hold;
+};
+
+/**
+ * 判定 (device, source) 在给定几何下能否接收，hold 为该结论保证不变的时长(秒)：
+ * 能接收时取各项条件不变时长的最小值，不能接收时取不满足的各项中的最大值。
+ * relVelocity 为辐射源相对设备的速度(空间直角坐标)。
+ */
+bool evaluate(const DeviceParams& device, const SourceParams& source, double bandwidthGHz,
+              const COORD3& devicePos, const COORD3& sourcePos, const COORD3& relVelocity,
+              double& hold) {
+    auto [azimuthToEmitter, elevationToEmitter] = calculateAzimuthElevation(
+        devicePos.p1, devicePos.p2, devicePos.p3, sourcePos.p1, sourcePos.p2, sourcePos.p3);
+    auto [azimuthToReceiver, elevationToReceiver] = calculateAzimuthElevation(
+        sourcePos.p1, sourcePos.p2, sourcePos.p3, devicePos.p1, devicePos.p2, devicePos.p3);
+
+    const double dx = sourcePos.p1 - devicePos.p1;
+    const double dy = sourcePos.p2 - devicePos.p2;
+    const double dz = sourcePos.p3 - devicePos.p3;
+    const double horizontal = std::sqrt(dx * dx + dy * dy);
+    const double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const double snr = calculateSNR(distance, source.power, source.frequency, device.noisePsd, bandwidthGHz);
+
+    const double vx = relVelocity.p1, vy = relVelocity.p2, vz = relVelocity.p3;
+    const double speedHorizontal = std::sqrt(vx * vx + vy * vy);
+    const double speed = std::sqrt(vx * vx + vy * vy + vz * vz);
+
+    const Sector& rx = device.sector;
+    const Sector& tx = source.sector;
+    const Condition conditions[] = {
+        // 侦察站的侦收范围覆盖辐射源
+        {isAngleInRange(azimuthToEmitter, rx.azimuthMin, rx.azimuthMax),
+         angleTime(azimuthMargin(azimuthToEmitter, rx.azimuthMin, rx.azimuthMax), horizontal, speedHorizontal)},
+        {isAngleInRange(elevationToEmitter, rx.elevationMin, rx.elevationMax),
+         angleTime(elevationMargin(elevationToEmitter, rx.elevationMin, rx.elevationMax), distance, speed)},
+        // 辐射源的工作扇区覆盖侦察站
+        {isAngleInRange(azimuthToReceiver, tx.azimuthMin, tx.azimuthMax),
+         angleTime(azimuthMargin(azimuthToReceiver, tx.azimuthMin, tx.azimuthMax), horizontal, speedHorizontal)},
+        {isAngleInRange(elevationToReceiver, tx.elevationMin, tx.elevationMax),
+         angleTime(elevationMargin(elevationToReceiver, tx.elevationMin, tx.elevationMax), distance, speed)},
+        // 信噪比不低于门限，即距离不超过最大可探测距离
+        {snr >= Constants::SNR_THRESHOLD,
+         speed > 0.0 ? std::fabs(device.maxRange - distance) / speed : INF},
+    };
+
+    bool ok = true;
+    for (const Condition& condition : conditions) {
+        ok = ok && condition.ok;
+    }
+    hold = ok ? INF : 0.0;
+    for (const Condition& condition : conditions) {
+        if (ok) {
+            hold = std::min(hold, condition.hold);
+        } else if (!condition.ok) {
+            hold = std::max(hold, condition.hold);
+        }
+    }
+    hold *= MARGIN_SAFETY;
+    return ok;
+}
+
+// 把逐采样点的标志合并为连续时段
+std::vector<ReceptionInterval> toIntervals(const std::vector<double>& times, const std::vector<std::uint8_t>& flags) {
+    std::vector<ReceptionInterval> intervals;
+    for (std::size_t k = 0; k < flags.size(); ++k) {
+        if (!flags[k]) continue;
+        if (k > 0 && flags[k - 1]) {
+            intervals.back().end = times[k];
+        } else {
+            ReceptionInterval interval;
+            interval.start = interval.end = times[k];
+            intervals.push_back(interval);
+        }
+    }
+    return intervals;
+}
+
+} // namespace
+
+std::vector<double> VisibilityTimeline::commonEpochs() const {
+    std::vector<double> epochs;
+    for (std::size_t k = 0; k < times.size(); ++k) {
+        if (allReceivable[k]) epochs.push_back(times[k]);
+    }
+    return epochs;
+}
+
+bool VisibilityTimeline::isCommonlyReceivable(double t) const {
+    for (const ReceptionInterval& interval : commonIntervals) {
+        if (t >= interval.start && t <= interval.end) return true;
+    }
+    return false;
+}
+
+std::vector<double> VisibilityTimeline::selectEpochs(const std::vector<double>& nominal) const {
+    if (std::all_of(nominal.begin(), nominal.end(), [this](double t) { return isCommonlyReceivable(t); })) {
+        return nominal;
+    }
+    const std::vector<double> candidates = commonEpochs();
+    const std::size_t count = nominal.size();
+    if (candidates.size() <= count || count == 0) {
+        return candidates;
+    }
+    std::vector<double> epochs;
+    epochs.reserve(count);
+    if (count == 1) {
+        epochs.push_back(candidates.front());
+        return epochs;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t index = (i * (candidates.size() - 1) + (count - 1) / 2) / (count - 1);
+        epochs.push_back(candidates[index]);
+    }
+    return epochs;
+}
+
+VisibilityTimeline computeVisibilityTimeline(const std::vector<ReconnaissanceDevice>& devices,
+                                             const RadiationSource& source,
+                                             double simulationTime,
+                                             const VisibilityTimelineOptions& options) {
+    PL_TRACE_SCOPE("Visibility.timeline");
+    VisibilityTimeline timeline;
+    timeline.simulationTime = std::max(0.0, simulationTime);
+    timeline.step = options.step > 0.0 ? options.step : (timeline.simulationTime > 0.0 ? timeline.simulationTime : 1.0);
+
+    // 采样时刻与 Trajectory::sampleUniform 相同：k·step，末尾补上仿真时间
+    const std::size_t count = static_cast<std::size_t>(std::floor(timeline.simulationTime / timeline.step));
+    for (std::size_t k = 0; k <= count; ++k) {
+        timeline.times.push_back(k * timeline.step);
+    }
+    if (timeline.times.back() < timeline.simulationTime) {
+        timeline.times.push_back(timeline.simulationTime);
+    }
+    const std::size_t sampleCount = timeline.times.size();
+    timeline.allReceivable.assign(sampleCount, devices.empty() ? 0 : 1);
+
+    // 噪声带宽默认取全部设备频率范围的交集
+    double bandwidthGHz = options.bandwidthGHz;
+    if (bandwidthGHz <= 0.0 && !devices.empty()) {
+        double low = -INF, high = INF;
+        for (const ReconnaissanceDevice& device : devices) {
+            low = std::max(low, static_cast<double>(device.getFreqRangeMin()));
+            high = std::min(high, static_cast<double>(device.getFreqRangeMax()));
+        }
+        bandwidthGHz = high - low;
+    }
+
+    SourceParams src;
+    src.sector = {source.getAzimuthStart(), source.getAzimuthEnd(), source.getElevationStart(), source.getElevationEnd()};
+    src.power = source.getTransmitPower();
+    src.frequency = source.getCarrierFrequency();
+    const Trajectory sourceTrajectory = Trajectory::fromSource(source, timeline.simulationTime);
+
+    timeline.devices.resize(devices.size());
+    for (std::size_t d = 0; d < devices.size(); ++d) {
+        const ReconnaissanceDevice& device = devices[d];
+        DeviceTimeline& result = timeline.devices[d];
+        result.deviceId = device.getDeviceId();
+        result.receivable.assign(sampleCount, 0);
+        result.inBand = src.frequency >= device.getFreqRangeMin() && src.frequency <= device.getFreqRangeMax();
+
+        // 频段不符或频率范围无交集时全程不可接收
+        if (result.inBand && bandwidthGHz > 0.0) {
+            DeviceParams params;
+            params.sector = {device.getAngleAzimuthMin(), device.getAngleAzimuthMax(),
+                             device.getAngleElevationMin(), device.getAngleElevationMax()};
+            params.noisePsd = device.getNoisePsd();
+            params.maxRange = calculateMaxDetectionRange(src.power, src.frequency, params.noisePsd, bandwidthGHz);
+
+            const Trajectory deviceTrajectory = Trajectory::fromDevice(device, timeline.simulationTime);
+            const COORD3& vs = sourceTrajectory.velocityXyz();
+            const COORD3& vd = deviceTrajectory.velocityXyz();
+            const COORD3 relVelocity(vs.p1 - vd.p1, vs.p2 - vd.p2, vs.p3 - vd.p3);
+
+            std::size_t k = 0;
+            while (k < sampleCount) {
+                const double t = timeline.times[k];
+                double hold = 0.0;
+                const bool ok = evaluate(params, src, bandwidthGHz, deviceTrajectory.positionXyzAt(t),
+                                         sourceTrajectory.positionXyzAt(t), relVelocity, hold);
+                ++timeline.evaluatedSamples;
+                result.receivable[k++] = ok;
+                if (!options.skipProvenSpans) continue;
+                // 结论保证不变的时长内，采样点直接沿用本次结果
+                while (k < sampleCount && timeline.times[k] - t < hold) {
+                    result.receivable[k++] = ok;
+                    ++timeline.skippedSamples;
+                }
+            }
+        }
+
+        result.intervals = toIntervals(timeline.times, result.receivable);
+        for (std::size_t k = 0; k < sampleCount; ++k) {
+            timeline.allReceivable[k] &= result.receivable[k];
+        }
+    }
+    timeline.commonIntervals = toIntervals(timeline.times, timeline.allReceivable);
+    PL_COUNTER_ADD("visibility.evaluated", static_cast<std::int64_t>(timeline.evaluatedSamples));
+    PL_COUNTER_ADD("visibility.skipped", static_cast<std::int64_t>(timeline.skippedSamples));
+    return timeline;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file VisibilityTimeline.h
+ * @brief 整个仿真时段内的可见性与信噪比时间线
+ *
+ * validateAll 只检查初始位置；这里按 Trajectory 的运动模型在 [0, 仿真时间] 内按固定步长扫描，
+ * 给出每个侦察设备能够接收辐射源信号的时段。判定规则与 validateAll 相同(频段、双向扇区、信噪比)。
+ * 由相对速度和各条件到判定边界的余量，可以求出某一时刻的结论(可接收或不可接收)保证不变的时长，
+ * 这段时间内的采样点不再逐点计算；平台静止或可见性长时间不变时只需计算很少的采样点。
+ */
+
+#ifndef VISIBILITY_TIMELINE_H
+#define VISIBILITY_TIMELINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../models/ReconnaissanceDeviceModel.h"
+#include "../models/RadiationSourceModel.h"
+
+/**
+ * @brief 时间线扫描参数
+ */
+struct VisibilityTimelineOptions {
+    double step = 1.0;              // 采样步长(秒)
+    double bandwidthGHz = 0.0;      // 计算噪声功率的带宽(GHz)，0 表示取全部设备频率范围交集的宽度(与 validateAll 相同)
+    bool skipProvenSpans = true;    // 跳过可证明结论不变的时段，false 时逐点计算
+};
+
+/**
+ * @brief 可接收时段，两端为采样时刻(秒)
+ */
+struct ReceptionInterval {
+    double start = 0.0;
+    double end = 0.0;
+};
+
+/**
+ * @brief 单个侦察设备的时间线
+ */
+struct DeviceTimeline {
+    int deviceId = 0;
+    bool inBand = false;                        // 辐射源载频在侦收频率范围内(与时刻无关)
+    std::vector<std::uint8_t> receivable;       // 各采样时刻能否接收
+    std::vector<ReceptionInterval> intervals;   // 连续可接收的时段
+};
+
+/**
+ * @brief 可见性时间线
+ */
+struct VisibilityTimeline {
+    double simulationTime = 0.0;
+    double step = 0.0;
+    std::vector<double> times;                  // 采样时刻，包含 0 和仿真时间
+    std::vector<DeviceTimeline> devices;        // 与输入设备顺序相同
+    std::vector<std::uint8_t> allReceivable;    // 各采样时刻全部设备都能接收
+    std::vector<ReceptionInterval> commonIntervals;  // 全部设备都能接收的时段
+    std::size_t evaluatedSamples = 0;           // 逐点计算的(设备, 时刻)数
+    std::size_t skippedSamples = 0;             // 由余量直接判定的(设备, 时刻)数
+
+    /**
+     * @brief 全部设备都能接收的采样时刻
+     */
+    std::vector<double> commonEpochs() const;
+
+    /**
+     * @brief t 是否落在全部设备都能接收的时段内
+     */
+    bool isCommonlyReceivable(double t) const;
+
+    /**
+     * @brief 观测时刻选择：nominal 中的时刻都可接收时原样返回，
+     * 否则在全部设备都能接收的采样时刻中按序号均匀选取同样个数(不足时全部返回)
+     * @param nominal 期望的观测时刻
+     * @return 观测时刻；没有共同可接收时刻时为空
+     */
+    std::vector<double> selectEpochs(const std::vector<double>& nominal) const;
+};
+
+/**
+ * @brief 计算侦察设备对辐射源的可接收时间线
+ *
+ * 设备和辐射源均按各自的初始位置和运动参数做匀速直线运动(与 TrajectorySimulator 相同)。
+ * @param devices 侦察设备列表
+ * @param source 辐射源
+ * @param simulationTime 仿真时间(秒)
+ * @param options 扫描参数
+ * @return 时间线
+ */
+VisibilityTimeline computeVisibilityTimeline(const std::vector<ReconnaissanceDevice>& devices,
+                                             const RadiationSource& source,
+                                             double simulationTime,
+                                             const VisibilityTimelineOptions& options = VisibilityTimelineOptions());
+
+#endif // VISIBILITY_TIMELINE_H
@@ -29,6 +29,9 @@ public:
     // 更新仿真结果显示（经度、纬度、高度和定位误差）
     void updateResult(const std::string& result);
     
+    // 更新仿真进度显示(后台仿真任务的进度回调)
+    void updateProgress(double fraction, const std::string& message);
+    
     // 保留接口以兼容现有代码，但功能已合并到updateResult
     void updateError(const std::string& error);
     
@@ -56,6 +59,9 @@ public:
     // 获取TDOA误差参数
     double getTDOARmsError() const;
     double getESMToaError() const;
+    
+    // 是否叠加定位精度热力图
+    bool isCoverageOverlayEnabled() const;
 
 private:
     MultiPlatformController* m_controller;
@@ -77,6 +83,12 @@ private:
     GtkWidget* m_tdoaRmsError;     // TDOA rms Error输入框
     GtkWidget* m_esmToaError;      // ESM toa Error输入框
     
+    GtkWidget* m_coverageCheck;    // 叠加精度热力图复选框
+    
+    // 后台仿真进度
+    GtkWidget* m_progressBar;      // 仿真进度条
+    GtkWidget* m_cancelButton;     // 取消仿真按钮
+    
     std::vector<ReconnaissanceDevice> m_devices; // 设备数据
     std::vector<RadiationSource> m_sources;      // 辐射源数据
     MapView* m_mapView = nullptr; // 地图对象
@@ -101,6 +113,7 @@ private:
     // 开始仿真按钮回调
     static void onStartSimulationCallback(GtkWidget* widget, gpointer data);
     void onStartSimulation(); // 开始仿真处理
+    static void onCancelSimulationCallback(GtkWidget* widget, gpointer data); // 取消仿真按钮回调
     bool checkRadarModels(); // 检查雷达侦察模型是否有效
     
     // 创建测向误差参数UI
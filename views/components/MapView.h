@@ -2,7 +2,9 @@
 
 #include <gtk/gtk.h>
 #include <webkit2/webkit2.h>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 /**
  * @brief MapView类 - 封装地图视图的创建和操作
@@ -70,6 +72,42 @@ public:
      */
     void executeScript(const std::string& script);
 
+    /**
+     * @brief 以二进制分块方式向地图传输轨迹采样点
+     *
+     * 采样点按 [t(秒), 经度, 纬度, 高度] 打包为 Float64Array 并 base64 编码，
+     * 逐块调用 JS 端 TrajectoryStream.append 写入 SampledPositionProperty。
+     * 第一块立即发送，其余各块在 GTK 空闲回调中逐块发送，长轨迹不会阻塞界面。
+     * 调用前需在 JS 端执行 TrajectoryStream.create(trackId)。
+     * @param trackId 轨迹ID
+     * @param samples 打包后的采样数据，长度为4的倍数
+     * @param samplesPerChunk 每块采样点数
+     */
+    void streamTrajectory(const std::string& trackId, std::vector<double> samples,
+                          std::size_t samplesPerChunk = 2048);
+
+    /**
+     * @brief 在地图上叠加一幅覆盖指定经纬度范围的RGBA图像(如精度热力图)
+     *
+     * 图像编码为PNG后以data URL传给 JS 端 ImageOverlay.show，同ID的旧图层会被替换。
+     * @param layerId 图层ID
+     * @param west 西边界经度(度)
+     * @param south 南边界纬度(度)
+     * @param east 东边界经度(度)
+     * @param north 北边界纬度(度)
+     * @param width 图像宽度(像素)
+     * @param height 图像高度(像素)
+     * @param rgba 按行存储的RGBA像素，第0行为最北一行，长度为 width×height×4
+     */
+    void showImageOverlay(const std::string& layerId, double west, double south, double east, double north,
+                          int width, int height, const std::vector<unsigned char>& rgba);
+
+    /**
+     * @brief 移除图像叠加图层
+     * @param layerId 图层ID
+     */
+    void removeImageOverlay(const std::string& layerId);
+
 private:
     WebKitWebView* m_webView;
     std::string m_htmlPath;
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../../models/ReconnaissanceDeviceModel.h"
+#include "../../models/RadiationSourceModel.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+class MapView;
+
+/**
+ * @brief 轨迹动画：把平台运动轨迹转换为Cesium场景脚本并推送到地图视图
+ *
+ * 轨迹点由 TrajectorySimulator / Trajectory 计算，此类只负责显示。
+ */
+class TrajectoryAnimator {
+public:
+    /**
+     * @brief 获取单例实例
+     * @return 返回TrajectoryAnimator单例
+     */
+    static TrajectoryAnimator& getInstance();
+
+    /**
+     * @brief 执行设备移动动画
+     * @param mapView 地图视图
+     * @param device 侦察设备
+     * @param trajectoryPoints 轨迹点
+     * @param simulationTime 仿真时间（秒）
+     * @param calculatedLongitude 计算得到的经度
+     * @param calculatedLatitude 计算得到的纬度
+     * @param calculatedAltitude 计算得到的高度
+     * @param sourceName 辐射源名称
+     * @param radiationSourceLongitude 辐射源经度
+     * @param radiationSourceLatitude 辐射源纬度
+     * @param radiationSourceAltitude 辐射源高度
+     */
+    void animateDeviceMovement(
+        MapView* mapView,
+        const ReconnaissanceDevice& device,
+        const std::vector<std::pair<double, double>>& trajectoryPoints,
+        int simulationTime,
+        double calculatedLongitude,
+        double calculatedLatitude,
+        double calculatedAltitude,
+        const std::string& sourceName,
+        double radiationSourceLongitude,
+        double radiationSourceLatitude,
+        double radiationSourceAltitude
+    );
+
+    /**
+     * @brief 执行多设备移动动画
+     * @param mapView 地图视图
+     * @param devices 侦察设备列表
+     * @param source 辐射源
+     * @param simulationTime 仿真时间（秒）
+     * @param calculatedLongitude 计算得到的经度
+     * @param calculatedLatitude 计算得到的纬度
+     * @param calculatedAltitude 计算得到的高度
+     */
+    void animateMultipleDevicesMovement(
+        MapView* mapView,
+        const std::vector<ReconnaissanceDevice>& devices,
+        const RadiationSource& source,
+        int simulationTime,
+        double calculatedLongitude,
+        double calculatedLatitude,
+        double calculatedAltitude
+    );
+
+private:
+    TrajectoryAnimator() = default;
+    ~TrajectoryAnimator() = default;
+
+    // 禁止拷贝
+    TrajectoryAnimator(const TrajectoryAnimator&) = delete;
+    TrajectoryAnimator& operator=(const TrajectoryAnimator&) = delete;
+};
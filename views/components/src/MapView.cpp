@@ -1,7 +1,9 @@
 #include "../MapView.h"
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <sstream>
+#include <utility>
 
 namespace fs = std::filesystem;
 // 构造函数
@@ -207,6 +209,115 @@ void MapView::executeScript(const std::string& script) {
     webkit_web_view_run_javascript(m_webView, script.c_str(), nullptr, nullptr, nullptr);
 }
 
+namespace {
+
+// 每个采样点的分量数：t, 经度, 纬度, 高度
+const std::size_t TRAJECTORY_SAMPLE_STRIDE = 4;
+
+// 一次轨迹传输的状态，持有 WebView 引用，与 MapView 对象生命周期无关
+struct TrajectoryStreamJob {
+    WebKitWebView* webView;
+    std::string trackId;
+    std::vector<double> samples;
+    std::size_t offset;      // 已发送的 double 个数
+    std::size_t chunkSize;   // 每块 double 个数
+};
+
+// 发送下一块数据，全部发送完毕时返回 false
+bool sendTrajectoryChunk(TrajectoryStreamJob* job) {
+    if (job->offset >= job->samples.size()) {
+        std::string script = "TrajectoryStream.finish('" + job->trackId + "');";
+        webkit_web_view_run_javascript(job->webView, script.c_str(), nullptr, nullptr, nullptr);
+        return false;
+    }
+
+    const std::size_t count = std::min(job->chunkSize, job->samples.size() - job->offset);
+    gchar* encoded = g_base64_encode(reinterpret_cast<const guchar*>(job->samples.data() + job->offset),
+                                     count * sizeof(double));
+    std::string script = "TrajectoryStream.append('" + job->trackId + "','" + encoded + "');";
+    g_free(encoded);
+    webkit_web_view_run_javascript(job->webView, script.c_str(), nullptr, nullptr, nullptr);
+    job->offset += count;
+    return true;
+}
+
+gboolean onTrajectoryStreamIdle(gpointer data) {
+    return sendTrajectoryChunk(static_cast<TrajectoryStreamJob*>(data)) ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+}
+
+void destroyTrajectoryStreamJob(gpointer data) {
+    auto* job = static_cast<TrajectoryStreamJob*>(data);
+    g_object_unref(job->webView);
+    delete job;
+}
+
+} // namespace
+
+// 分块传输轨迹采样点
+void MapView::streamTrajectory(const std::string& trackId, std::vector<double> samples,
+                               std::size_t samplesPerChunk) {
+    if (!m_webView) return;
+
+    if (samples.size() % TRAJECTORY_SAMPLE_STRIDE != 0) {
+        std::cerr << "轨迹数据长度不是" << TRAJECTORY_SAMPLE_STRIDE << "的倍数: " << trackId << std::endl;
+        return;
+    }
+
+    auto* job = new TrajectoryStreamJob;
+    job->webView = WEBKIT_WEB_VIEW(g_object_ref(m_webView));
+    job->trackId = trackId;
+    job->samples = std::move(samples);
+    job->offset = 0;
+    job->chunkSize = std::max<std::size_t>(samplesPerChunk, 1) * TRAJECTORY_SAMPLE_STRIDE;
+
+    // 第一块立即发送，动画无需等待整条轨迹
+    if (!sendTrajectoryChunk(job)) {
+        destroyTrajectoryStreamJob(job);
+        return;
+    }
+    g_idle_add_full(G_PRIORITY_DEFAULT_IDLE, onTrajectoryStreamIdle, job, destroyTrajectoryStreamJob);
+}
+
+// 叠加RGBA图像
+void MapView::showImageOverlay(const std::string& layerId, double west, double south, double east, double north,
+                               int width, int height, const std::vector<unsigned char>& rgba) {
+    if (!m_webView) return;
+
+    if (width <= 0 || height <= 0 || rgba.size() != static_cast<std::size_t>(width) * height * 4) {
+        std::cerr << "叠加图像尺寸与像素数据不一致: " << layerId << std::endl;
+        return;
+    }
+
+    // 像素数据只在本函数内使用，无需由 GdkPixbuf 释放
+    GdkPixbuf* pixbuf = gdk_pixbuf_new_from_data(rgba.data(), GDK_COLORSPACE_RGB, TRUE, 8,
+                                                 width, height, width * 4, nullptr, nullptr);
+    gchar* png = nullptr;
+    gsize pngSize = 0;
+    GError* error = nullptr;
+    gboolean saved = gdk_pixbuf_save_to_buffer(pixbuf, &png, &pngSize, "png", &error, nullptr);
+    g_object_unref(pixbuf);
+    if (!saved) {
+        std::cerr << "叠加图像编码失败: " << (error ? error->message : "未知错误") << std::endl;
+        if (error) g_error_free(error);
+        return;
+    }
+
+    gchar* encoded = g_base64_encode(reinterpret_cast<const guchar*>(png), pngSize);
+    g_free(png);
+
+    std::ostringstream script;
+    script.precision(10);
+    script << "ImageOverlay.show('" << layerId << "','data:image/png;base64," << encoded << "',"
+           << west << "," << south << "," << east << "," << north << ");";
+    g_free(encoded);
+    executeScript(script.str());
+}
+
+// 移除图像叠加图层
+void MapView::removeImageOverlay(const std::string& layerId) {
+    executeScript("ImageOverlay.remove('" + layerId + "');");
+}
+
 // 加载地图HTML文件
 void MapView::loadMap() {
     if (!m_webView) return;
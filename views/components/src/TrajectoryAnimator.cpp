@@ -0,0 +1,347 @@
+#include "../TrajectoryAnimator.h"
+#include "../MapView.h"
+#include "../../../models/Trajectory.h"
+#include "../../../utils/Log.h"
+#include <iomanip>
+#include <sstream>
+
+// 单例实现
+TrajectoryAnimator& TrajectoryAnimator::getInstance() {
+    static TrajectoryAnimator instance;
+    return instance;
+}
+
+// 执行设备移动动画
+void TrajectoryAnimator::animateDeviceMovement(
+    MapView* mapView,
+    const ReconnaissanceDevice& device,
+    const std::vector<std::pair<double, double>>& trajectoryPoints,
+    int simulationTime,
+    double calculatedLongitude,
+    double calculatedLatitude,
+    double calculatedAltitude,
+    const std::string& sourceName,
+    double radiationSourceLongitude,
+    double radiationSourceLatitude,
+    double radiationSourceAltitude) {
+    
+    if (!mapView || trajectoryPoints.empty()) return;
+    
+    
+    // 不再移除所有实体，而是只移除动画相关的实体，保留侦察设备和辐射源标记
+    std::string cleanupScript = 
+        "// 只移除动画相关的实体，保留地图上的其他标记 \n"
+        "var entitiesToRemove = []; \n"
+        "viewer.entities.values.forEach(function(entity) { \n"
+        "  if (entity.id && (entity.id.indexOf('device-trail') !== -1 || \n"
+        "      entity.id.indexOf('device-entity') !== -1 || \n"
+        "      entity.id.indexOf('start-point') !== -1 || \n"
+        "      entity.id.indexOf('final-position') !== -1)) { \n"
+        "    entitiesToRemove.push(entity); \n"
+        "  } \n"
+        "}); \n"
+        "for (var i = 0; i < entitiesToRemove.length; i++) { \n"
+        "  viewer.entities.remove(entitiesToRemove[i]); \n"
+        "}";
+    mapView->executeScript(cleanupScript);
+    
+    // 轨迹点在仿真时间内均匀分布，打包为 [t, 经度, 纬度, 高度]；高度随俯仰运动变化，按时刻从轨迹取
+    const Trajectory trajectory = Trajectory::fromDevice(device, simulationTime);
+    const double deviceAltitude = device.getAltitude();
+    const size_t pointCount = trajectoryPoints.size();
+    const double timeStep = pointCount > 1 ? static_cast<double>(simulationTime) / (pointCount - 1) : 0.0;
+    std::vector<double> samples;
+    samples.reserve(pointCount * 4);
+    for (size_t i = 0; i < pointCount; i++) {
+        samples.push_back(i * timeStep);
+        samples.push_back(trajectoryPoints[i].first);
+        samples.push_back(trajectoryPoints[i].second);
+        samples.push_back(trajectory.positionAt(i * timeStep).p3);
+    }
+    const std::pair<double, double>& startPoint = trajectoryPoints.front();
+    const std::pair<double, double>& finalPoint = trajectoryPoints.back();
+    const double finalAltitude = samples.back();
+    
+    // 构建动画场景JavaScript代码，轨迹点本身通过数据通道传输
+    std::stringstream script;
+    script << std::setprecision(12);
+    
+    script << "// 启动时钟并创建轨迹位置属性\n"
+           << "console.log('轨迹点数量: " << pointCount << "');\n"
+           << "TrajectoryStream.startClock(" << simulationTime << ");\n"
+           << "var devicePositions = TrajectoryStream.create('device-track');\n";
+    
+    // 轨迹线实体：随时钟绘制已经走过的路径
+    script << "// 创建轨迹线实体\n"
+           << "var trailEntity = viewer.entities.add({\n"
+           << "  id: 'device-trail',\n"
+           << "  position: devicePositions,\n"
+           << "  path: {\n"
+           << "    leadTime: 0,\n"
+           << "    trailTime: " << simulationTime + 1 << ",\n"
+           << "    resolution: 1,\n"
+           << "    width: 3,\n"
+           << "    material: new Cesium.PolylineGlowMaterialProperty({\n"
+           << "      glowPower: 0.2,\n"
+           << "      color: Cesium.Color.YELLOW\n"
+           << "    })\n"
+           << "  }\n"
+           << "});\n";
+           
+    // 添加起始点标记 - 只显示标识点，不显示具体信息
+    script << "// 添加起始位置标记 - 只显示标识点\n"
+           << "viewer.entities.add({\n"
+           << "  id: 'start-point',\n"
+           << "  position: Cesium.Cartesian3.fromDegrees(" << startPoint.first << ", " << startPoint.second << ", " << deviceAltitude << "),\n"
+           << "  point: {\n"
+           << "    pixelSize: 10,\n"
+           << "    color: Cesium.Color.RED,\n"
+           << "    outlineColor: Cesium.Color.WHITE,\n"
+           << "    outlineWidth: 2\n"
+           << "  }\n"
+           << "});\n";
+           
+    // 设备实体位置绑定到采样位置属性，由Cesium时钟插值驱动
+    script << "// 设备移动动画 - 使用SampledPositionProperty\n"
+           << "var deviceEntity = viewer.entities.add({\n"
+           << "  id: 'device-entity',\n"
+           << "  position: devicePositions,\n"
+           << "  point: {\n"
+           << "    pixelSize: 15,\n"
+           << "    color: Cesium.Color.RED,\n"
+           << "    outlineColor: Cesium.Color.WHITE,\n"
+           << "    outlineWidth: 2\n"
+           << "  },\n"
+           << "  label: {\n"
+           << "    text: '" << device.getDeviceName() << "',\n"
+           << "    font: '14pt sans-serif',\n"
+           << "    style: Cesium.LabelStyle.FILL_AND_OUTLINE,\n"
+           << "    outlineWidth: 2,\n"
+           << "    verticalOrigin: Cesium.VerticalOrigin.BOTTOM,\n"
+           << "    pixelOffset: new Cesium.Cartesian2(0, -20),\n"
+           << "    showBackground: true,\n"
+           << "    backgroundColor: new Cesium.Color(0.165, 0.165, 0.165, 0.7)\n"
+           << "  },\n"
+           << "  billboard: {\n"
+           << "    image: 'data:image/svg+xml;base64,PHN2ZyB4bWxucz0iaHR0cDovL3d3dy53My5vcmcvMjAwMC9zdmciIHZpZXdCb3g9IjAgMCAyNCAyNCIgd2lkdGg9IjI0IiBoZWlnaHQ9IjI0Ij48Y2lyY2xlIGN4PSIxMiIgY3k9IjEyIiByPSIxMCIgZmlsbD0icmVkIi8+PC9zdmc+',\n"
+           << "    width: 32,\n"
+           << "    height: 32,\n"
+           << "    verticalOrigin: Cesium.VerticalOrigin.BOTTOM,\n"
+           << "    color: Cesium.Color.RED\n"
+           << "  }\n"
+           << "});\n";
+           
+    // 预定义辐射源位置
+    script << "// 定义辐射源位置\n"
+           << "var radiationSourceLongitude = " << radiationSourceLongitude << ";\n"
+           << "var radiationSourceLatitude = " << radiationSourceLatitude << ";\n"
+           << "var radiationSourceAltitude = " << radiationSourceAltitude << ";\n";
+           
+    // 动画结束时隐藏设备实体，在最终位置显示绿色标记点
+    script << "// 显示最终结果\n"
+           << "TrajectoryStream.onFinished(function() {\n"
+           << "  console.log('动画完成');\n"
+           << "  deviceEntity.show = false;\n"
+           << "  viewer.entities.add({\n"
+           << "    id: 'final-position',\n"
+           << "    position: Cesium.Cartesian3.fromDegrees(" << finalPoint.first << ", " << finalPoint.second << ", " << finalAltitude << "),\n"
+           << "    point: {\n"
+           << "      pixelSize: 12,\n"
+           << "      color: Cesium.Color.GREEN,\n"
+           << "      outlineColor: Cesium.Color.WHITE,\n"
+           << "      outlineWidth: 2\n"
+           << "    },\n"
+           << "    label: {\n"
+           << "      text: '" << device.getDeviceName() << "',\n"
+           << "      font: '14pt sans-serif',\n"
+           << "      style: Cesium.LabelStyle.FILL_AND_OUTLINE,\n"
+           << "      outlineWidth: 2,\n"
+           << "      verticalOrigin: Cesium.VerticalOrigin.BOTTOM,\n"
+           << "      pixelOffset: new Cesium.Cartesian2(0, -9),\n"
+           << "      showBackground: true,\n"
+           << "      backgroundColor: new Cesium.Color(0.165, 0.165, 0.165, 0.7)\n"
+           << "    }\n"
+           << "  });\n"
+           << "});\n";
+    
+    // 执行场景脚本，随后分块传输轨迹数据
+    mapView->executeScript(script.str());
+    mapView->streamTrajectory("device-track", std::move(samples));
+    
+    PL_LOG_INFO("设备移动仿真已启动，仿真时间: %d秒\n", simulationTime);
+}
+
+// 执行多设备移动动画
+void TrajectoryAnimator::animateMultipleDevicesMovement(
+    MapView* mapView,
+    const std::vector<ReconnaissanceDevice>& devices,
+    const RadiationSource& source,
+    int simulationTime,
+    double calculatedLongitude,
+    double calculatedLatitude,
+    double calculatedAltitude) {
+    
+    if (!mapView || devices.empty()) return;
+    
+    
+    // 修改为移除所有实体，确保地图上不会有重复标记
+    std::string cleanupScript = 
+        "// 移除所有实体 \n"
+        "var entitiesToRemove = []; \n"
+        "viewer.entities.values.forEach(function(entity) { \n"
+        "  if (entity.id) { \n"
+        "    entitiesToRemove.push(entity); \n"
+        "  } \n"
+        "}); \n"
+        "for (var i = 0; i < entitiesToRemove.length; i++) { \n"
+        "  viewer.entities.remove(entitiesToRemove[i]); \n"
+        "}";
+    mapView->executeScript(cleanupScript);
+    
+    // 构建动画场景JavaScript代码，轨迹点本身通过数据通道传输
+    std::stringstream script;
+    script << std::setprecision(12);
+    
+    script << "// 启动时钟\n"
+           << "TrajectoryStream.startClock(" << simulationTime << ");\n"
+           << "var deviceEntities = [];\n";
+    
+    // 按误差受限抽稀生成各设备轨迹（只包含地图折线需要的点）
+    std::vector<std::vector<double>> deviceSamples(devices.size());
+    std::vector<TrajectorySample> finalSamples(devices.size());
+    for (size_t deviceIdx = 0; deviceIdx < devices.size(); deviceIdx++) {
+        const ReconnaissanceDevice& device = devices[deviceIdx];
+        
+        Trajectory trajectory = Trajectory::fromDevice(device, simulationTime);
+        TrajectoryIterator it = trajectory.samples();
+        TrajectorySample sample;
+        while (it.next(sample)) {
+            deviceSamples[deviceIdx].push_back(sample.time);
+            deviceSamples[deviceIdx].push_back(sample.longitude);
+            deviceSamples[deviceIdx].push_back(sample.latitude);
+            deviceSamples[deviceIdx].push_back(sample.altitude);
+            finalSamples[deviceIdx] = sample;
+        }
+        
+        script << "// 设备" << deviceIdx << "轨迹\n"
+               << "console.log('设备" << deviceIdx << "轨迹点数量: " << deviceSamples[deviceIdx].size() / 4 << "');\n"
+               << "var devicePositions" << deviceIdx << " = TrajectoryStream.create('device-track-" << deviceIdx << "');\n";
+        
+        script << "// 创建设备" << deviceIdx << "实体\n"
+               << "var deviceEntity" << deviceIdx << " = viewer.entities.add({\n"
+               << "  id: 'device-entity-" << deviceIdx << "',\n"
+               << "  position: devicePositions" << deviceIdx << ",\n"
+               << "  point: {\n"
+               << "    pixelSize: 15,\n"
+               << "    color: Cesium.Color.RED,\n"
+               << "    outlineColor: Cesium.Color.WHITE,\n"
+               << "    outlineWidth: 2\n"
+               << "  },\n"
+               << "  label: {\n"
+               << "    text: '" << device.getDeviceName() << "',\n"
+               << "    font: '14pt sans-serif',\n"
+               << "    style: Cesium.LabelStyle.FILL_AND_OUTLINE,\n"
+               << "    outlineWidth: 2,\n"
+               << "    verticalOrigin: Cesium.VerticalOrigin.BOTTOM,\n"
+               << "    pixelOffset: new Cesium.Cartesian2(0, -20),\n"
+               << "    showBackground: true,\n"
+               << "    backgroundColor: new Cesium.Color(0.165, 0.165, 0.165, 0.7)\n"
+               << "  },\n"
+               << "  billboard: {\n"
+               << "    image: 'data:image/svg+xml;base64,PHN2ZyB4bWxucz0iaHR0cDovL3d3dy53My5vcmcvMjAwMC9zdmciIHZpZXdCb3g9IjAgMCAyNCAyNCIgd2lkdGg9IjI0IiBoZWlnaHQ9IjI0Ij48Y2lyY2xlIGN4PSIxMiIgY3k9IjEyIiByPSIxMCIgZmlsbD0icmVkIi8+PC9zdmc+',\n"
+               << "    width: 32,\n"
+               << "    height: 32,\n"
+               << "    verticalOrigin: Cesium.VerticalOrigin.BOTTOM,\n"
+               << "    color: Cesium.Color.RED\n"
+               << "  }\n"
+               << "});\n"
+               << "deviceEntities.push(deviceEntity" << deviceIdx << ");\n";
+               
+        // 创建轨迹线实体
+        script << "// 创建设备" << deviceIdx << "轨迹线实体\n"
+               << "viewer.entities.add({\n"
+               << "  id: 'device-trail-" << deviceIdx << "',\n"
+               << "  position: devicePositions" << deviceIdx << ",\n"
+               << "  path: {\n"
+               << "    leadTime: 0,\n"
+               << "    trailTime: " << simulationTime + 1 << ",\n"
+               << "    resolution: 1,\n"
+               << "    width: 3,\n"
+               << "    material: new Cesium.PolylineGlowMaterialProperty({\n"
+               << "      glowPower: 0.2,\n"
+               << "      color: Cesium.Color.YELLOW\n"
+               << "    })\n"
+               << "  }\n"
+               << "});\n";
+    }
+    
+    // 创建计算位置实体（目标辐射源）
+    if (calculatedLongitude != 0 && calculatedLatitude != 0) {
+        script << "// 创建计算位置实体（目标辐射源）\n"
+               << "var calculatedEntity = viewer.entities.add({\n"
+               << "  id: 'calculated-entity',\n"
+               << "  position: Cesium.Cartesian3.fromDegrees(" << calculatedLongitude << ", " << calculatedLatitude << ", " << calculatedAltitude << "),\n"
+               << "  point: {\n"
+               << "    pixelSize: 15,\n"
+               << "    color: Cesium.Color.BLUE,\n"
+               << "    outlineColor: Cesium.Color.WHITE,\n"
+               << "    outlineWidth: 2\n"
+               << "  },\n"
+               << "  label: {\n"
+               << "    text: '" << source.getRadiationName() << "',\n"
+               << "    font: '14pt sans-serif',\n"
+               << "    style: Cesium.LabelStyle.FILL_AND_OUTLINE,\n"
+               << "    outlineWidth: 2,\n"
+               << "    verticalOrigin: Cesium.VerticalOrigin.BOTTOM,\n"
+               << "    pixelOffset: new Cesium.Cartesian2(0, -20),\n"
+               << "    showBackground: true,\n"
+               << "    backgroundColor: new Cesium.Color(0.165, 0.165, 0.165, 0.7)\n"
+               << "  },\n"
+               << "  billboard: {\n"
+               << "    image: 'data:image/svg+xml;base64,PHN2ZyB4bWxucz0iaHR0cDovL3d3dy53My5vcmcvMjAwMC9zdmciIHZpZXdCb3g9IjAgMCAyNCAyNCIgd2lkdGg9IjI0IiBoZWlnaHQ9IjI0Ij48Y2lyY2xlIGN4PSIxMiIgY3k9IjEyIiByPSIxMCIgZmlsbD0iYmx1ZSIvPjwvc3ZnPg==',\n"
+               << "    width: 32,\n"
+               << "    height: 32,\n"
+               << "    verticalOrigin: Cesium.VerticalOrigin.BOTTOM,\n"
+               << "    color: Cesium.Color.BLUE\n"
+               << "  }\n"
+               << "});\n";
+    }
+    
+    // 动画结束时隐藏设备实体，在最终位置添加设备标记点；计算位置实体保持可见
+    script << "// 显示最终结果\n"
+           << "TrajectoryStream.onFinished(function() {\n"
+           << "  console.log('动画完成');\n"
+           << "  for (var i = 0; i < deviceEntities.length; i++) {\n"
+           << "    deviceEntities[i].show = false;\n"
+           << "  }\n";
+    for (size_t deviceIdx = 0; deviceIdx < devices.size(); deviceIdx++) {
+        const TrajectorySample& finalSample = finalSamples[deviceIdx];
+        script << "  viewer.entities.add({\n"
+               << "    id: 'final-device-position-" << deviceIdx << "',\n"
+               << "    position: Cesium.Cartesian3.fromDegrees(" << finalSample.longitude << ", " << finalSample.latitude << ", " << finalSample.altitude << "),\n"
+               << "    point: {\n"
+               << "      pixelSize: 12,\n"
+               << "      color: Cesium.Color.RED,\n"
+               << "      outlineColor: Cesium.Color.WHITE,\n"
+               << "      outlineWidth: 2\n"
+               << "    },\n"
+               << "    label: {\n"
+               << "      text: '" << devices[deviceIdx].getDeviceName() << "',\n"
+               << "      font: '14pt sans-serif',\n"
+               << "      style: Cesium.LabelStyle.FILL_AND_OUTLINE,\n"
+               << "      outlineWidth: 2,\n"
+               << "      verticalOrigin: Cesium.VerticalOrigin.BOTTOM,\n"
+               << "      pixelOffset: new Cesium.Cartesian2(0, -9),\n"
+               << "      showBackground: true,\n"
+               << "      backgroundColor: new Cesium.Color(0.165, 0.165, 0.165, 0.7)\n"
+               << "    }\n"
+               << "  });\n";
+    }
+    script << "});\n";
+    
+    // 执行场景脚本，随后分块传输各设备轨迹数据
+    mapView->executeScript(script.str());
+    for (size_t deviceIdx = 0; deviceIdx < devices.size(); deviceIdx++) {
+        mapView->streamTrajectory("device-track-" + std::to_string(deviceIdx), std::move(deviceSamples[deviceIdx]));
+    }
+}
@@ -11,7 +11,8 @@
 // 实现MultiPlatformView类
 MultiPlatformView::MultiPlatformView() : m_view(nullptr), m_algoCombo(nullptr), 
     m_resultLabel(nullptr), m_timeEntry(nullptr), m_dfParamsFrame(nullptr), m_tdoaParamsFrame(nullptr), 
-    m_tdoaRmsError(nullptr), m_esmToaError(nullptr), m_mapView(nullptr), m_sourceMarker(-1) {
+    m_tdoaRmsError(nullptr), m_esmToaError(nullptr), m_coverageCheck(nullptr), m_progressBar(nullptr), m_cancelButton(nullptr),
+    m_mapView(nullptr), m_sourceMarker(-1) {
     // 初始化数组
     for (int i = 0; i < 4; ++i) {
         m_radarMarkers[i] = -1;
@@ -137,6 +138,11 @@ GtkWidget* MultiPlatformView::createView() {
         gtk_widget_hide(m_tdoaParamsFrame);
     }
     
+    // 叠加精度热力图(按所选侦察站布局计算GDOP/CRLB)
+    m_coverageCheck = gtk_check_button_new_with_label("叠加精度热力图");
+    gtk_widget_set_tooltip_text(m_coverageCheck, "按所选侦察站布局和误差参数计算定位精度(CEP)分布并叠加到地图");
+    gtk_box_pack_start(GTK_BOX(rightBox), m_coverageCheck, FALSE, FALSE, 0);
+    
     // 开始按钮
     GtkWidget* startButton = gtk_button_new_with_label("开始");
     gtk_widget_set_size_request(startButton, -1, 40);
@@ -162,6 +168,21 @@ GtkWidget* MultiPlatformView::createView() {
                                  GTK_STYLE_PROVIDER_PRIORITY_APPLICATION);
     g_object_unref(provider);
     
+    // 仿真进度与取消按钮：仿真在后台执行，可同时排队多个
+    GtkWidget* progressBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+    gtk_box_pack_start(GTK_BOX(rightBox), progressBox, FALSE, FALSE, 0);
+    
+    m_progressBar = gtk_progress_bar_new();
+    gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(m_progressBar), TRUE);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(m_progressBar), "就绪");
+    gtk_widget_set_valign(m_progressBar, GTK_ALIGN_CENTER);
+    gtk_box_pack_start(GTK_BOX(progressBox), m_progressBar, TRUE, TRUE, 0);
+    
+    m_cancelButton = gtk_button_new_with_label("取消");
+    gtk_widget_set_sensitive(m_cancelButton, FALSE);
+    gtk_box_pack_start(GTK_BOX(progressBox), m_cancelButton, FALSE, FALSE, 0);
+    g_signal_connect(m_cancelButton, "clicked", G_CALLBACK(onCancelSimulationCallback), this);
+    
     // 结果区域
     GtkWidget* resultFrame = gtk_frame_new("仿真结果");
     gtk_box_pack_start(GTK_BOX(rightBox), resultFrame, TRUE, TRUE, 0);
@@ -378,6 +399,15 @@ void MultiPlatformView::onStartSimulationCallback(GtkWidget* widget, gpointer da
     if (self) self->onStartSimulation();
 }
 
+// 取消仿真按钮回调
+void MultiPlatformView::onCancelSimulationCallback(GtkWidget* widget, gpointer data) {
+    MultiPlatformView* self = static_cast<MultiPlatformView*>(data);
+    if (self) {
+        MultiPlatformController::getInstance().cancelSimulation();
+        self->updateProgress(0.0, "正在取消...");
+    }
+}
+
 // 开始仿真处理
 void MultiPlatformView::onStartSimulation() {
     // 清除之前的测向误差线
@@ -593,6 +623,18 @@ void MultiPlatformView::updateResult(const std::string& result) {
     }
 }
 
+// 更新仿真进度显示
+void MultiPlatformView::updateProgress(double fraction, const std::string& message) {
+    if (m_progressBar) {
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(m_progressBar), fraction);
+        gtk_progress_bar_set_text(GTK_PROGRESS_BAR(m_progressBar), message.c_str());
+    }
+    if (m_cancelButton) {
+        gtk_widget_set_sensitive(m_cancelButton,
+                                 MultiPlatformController::getInstance().runningSimulationCount() > 0);
+    }
+}
+
 // 更新误差显示 - 由于已经删除误差标签，这个函数现在可以留空或者合并到updateResult中
 void MultiPlatformView::updateError(const std::string& error) {
     // 不再需要单独的误差显示
@@ -846,6 +888,11 @@ void MultiPlatformView::toggleTDOAParamsUI(bool show) {
     }
 }
 
+// 是否叠加定位精度热力图
+bool MultiPlatformView::isCoverageOverlayEnabled() const {
+    return m_coverageCheck && gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_coverageCheck));
+}
+
 // 获取TDOA rms Error参数
 double MultiPlatformView::getTDOARmsError() const {
     if (m_tdoaRmsError) {
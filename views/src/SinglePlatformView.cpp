@@ -1,5 +1,6 @@
 #include "../SinglePlatformView.h"
 #include "../components/MapView.h"
+#include "../components/TrajectoryAnimator.h"
 #include "../../controllers/SinglePlatformController.h"
 #include "../../models/ReconnaissanceDeviceDAO.h"
 #include "../../models/RadiationSourceDAO.h"
@@ -665,9 +666,9 @@ void SinglePlatformView::animateDeviceMovement(const ReconnaissanceDevice& devic
         g_print("警告：未找到辐射源位置，使用默认值\n");
     }
     
-    // 使用TrajectorySimulator执行动画，并在动画结束时回调显示参数
+    // 使用TrajectoryAnimator执行动画，并在动画结束时回调显示参数
     auto self = this;
-    TrajectorySimulator::getInstance().animateDeviceMovement(
+    TrajectoryAnimator::getInstance().animateDeviceMovement(
         m_mapView,
         device,
         trajectoryPoints,